@@ -0,0 +1,127 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file main.c
+ * @brief Offline mixer benchmark.
+ *
+ * Usage: demo [budget_ms]
+ * Renders 512-frame blocks to memory while doubling, then bisecting, the
+ * voice count to find how many voices fit in the budget (default 5 ms).
+ */
+#include "audio/chaos_mixer.h"
+#include "core/chaos_math.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_SAMPLE_RATE 48000u
+#define BENCH_SOUND_FRAMES 48000u
+#define BENCH_BLOCKS       32u
+#define BENCH_MAX_VOICES   65536u
+
+static ce_f32 g_tone[BENCH_SOUND_FRAMES];
+static ce_f32 g_out[CE_MIXER_BLOCK_FRAMES * 2u];
+
+/**
+ * @brief Median block render time with `voices` looping voices.
+ */
+static ce_u64 measure(ce_u32 voices)
+{
+    ce_mixer_desc desc;
+    ce_voice_params params;
+    ce_sound sound;
+    ce_mixer* mixer;
+    ce_u64 samples[BENCH_BLOCKS];
+    ce_u64 t;
+    ce_u32 i;
+    ce_u32 j;
+
+    desc.sample_rate      = BENCH_SAMPLE_RATE;
+    desc.max_voices       = voices;
+    desc.command_capacity = voices;
+    if (ce_mixer_create(&desc, &mixer) != CE_OK) {
+        return ~0ull;
+    }
+
+    sound.channels[0]   = g_tone;
+    sound.channels[1]   = CE_NULL;
+    sound.channel_count = 1u;
+    sound.frame_count   = BENCH_SOUND_FRAMES;
+    sound.sample_rate   = BENCH_SAMPLE_RATE;
+
+    for (i = 0u; i < voices; i++) {
+        params.volume         = 1.0f / (ce_f32)voices;
+        params.pan            = ((ce_f32)(i % 17u) / 8.0f) - 1.0f;
+        params.loop           = CE_TRUE;
+        params.fade_in_frames = CE_MIXER_RAMP_FRAMES;
+        params.quality        = CE_RESAMPLE_LINEAR;
+        (void)ce_mixer_play(mixer, &sound, &params);
+    }
+
+    for (i = 0u; i < BENCH_BLOCKS; i++) {
+        t = ce_time_now_ns();
+        ce_mixer_render(mixer, g_out, CE_MIXER_BLOCK_FRAMES);
+        samples[i] = ce_time_now_ns() - t;
+    }
+    ce_mixer_destroy(mixer);
+
+    for (i = 1u; i < BENCH_BLOCKS; i++) {
+        t = samples[i];
+        for (j = i; (j > 0u) && (samples[j - 1u] > t); j--) {
+            samples[j] = samples[j - 1u];
+        }
+        samples[j] = t;
+    }
+
+    return samples[BENCH_BLOCKS / 2u];
+}
+
+int main(int argc, char** argv)
+{
+    ce_u64 budget;
+    ce_u32 lo;
+    ce_u32 hi;
+    ce_u32 mid;
+    ce_u32 i;
+
+    budget = (ce_u64)(((argc > 1) ? atof(argv[1]) : 5.0) * (ce_f64)CE_NS_PER_MS);
+
+    for (i = 0u; i < BENCH_SOUND_FRAMES; i++) {
+        g_tone[i] = 0.5f * sinf((2.0f * CE_PI_F * 440.0f * (ce_f32)i) / (ce_f32)BENCH_SAMPLE_RATE);
+    }
+
+    lo = 0u;
+    hi = 64u;
+    while ((hi < BENCH_MAX_VOICES) && (measure(hi) <= budget)) {
+        lo = hi;
+        hi *= 2u;
+    }
+    while ((hi - lo) > (lo / 32u) && (hi - lo) > 1u) {
+        mid = lo + ((hi - lo) / 2u);
+        if (measure(mid) <= budget) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    printf("block             : %u frames @ %u Hz (%.2f ms of audio)\n", CE_MIXER_BLOCK_FRAMES, BENCH_SAMPLE_RATE,
+           (1000.0 * (ce_f64)CE_MIXER_BLOCK_FRAMES) / (ce_f64)BENCH_SAMPLE_RATE);
+    printf("budget            : %.2f ms\n", (ce_f64)budget / (ce_f64)CE_NS_PER_MS);
+    printf("voices in budget  : %u\n", lo);
+    if (lo != 0u) {
+        printf("ns per voice-frame: %.3f\n", (ce_f64)measure(lo) / ((ce_f64)lo * (ce_f64)CE_MIXER_BLOCK_FRAMES));
+    }
+
+    return 0;
+}
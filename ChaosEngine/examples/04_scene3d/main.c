@@ -0,0 +1,213 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file main.c
+ * @brief Headless software 3D scene: frustum culling + depth-buffered raster.
+ *
+ * Usage: demo [frames] [out.ppm]
+ * Renders a field of spheres from an orbiting camera and reports triangle
+ * throughput and how much work hierarchical-Z rejected.
+ */
+#include "core/chaos_math.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "gfx/chaos_draw.h"
+#include "gfx/chaos_sw_raster.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SCENE_WIDTH   1280u
+#define SCENE_HEIGHT  720u
+#define SPHERE_SLICES 32u
+#define SPHERE_STACKS 16u
+#define GRID_SIZE     24u
+#define GRID_SPACING  2.5f
+
+typedef struct scene_mesh_s {
+    ce_f32*   x;
+    ce_f32*   y;
+    ce_f32*   z;
+    ce_color* colors;
+    ce_u32*   indices;
+    ce_u32    vertex_count;
+    ce_u32    index_count;
+} scene_mesh;
+
+static void build_sphere(scene_mesh* mesh)
+{
+    ce_u32 s;
+    ce_u32 t;
+    ce_u32 v;
+    ce_u32 n;
+    ce_f32 theta;
+    ce_f32 phi;
+
+    mesh->vertex_count = (SPHERE_SLICES + 1u) * (SPHERE_STACKS + 1u);
+    mesh->index_count  = SPHERE_SLICES * SPHERE_STACKS * 6u;
+    mesh->x            = (ce_f32*)ce_mem_alloc(mesh->vertex_count * sizeof(ce_f32), 0u, CE_MEM_TAG_GENERAL);
+    mesh->y            = (ce_f32*)ce_mem_alloc(mesh->vertex_count * sizeof(ce_f32), 0u, CE_MEM_TAG_GENERAL);
+    mesh->z            = (ce_f32*)ce_mem_alloc(mesh->vertex_count * sizeof(ce_f32), 0u, CE_MEM_TAG_GENERAL);
+    mesh->colors       = (ce_color*)ce_mem_alloc(mesh->vertex_count * sizeof(ce_color), 0u, CE_MEM_TAG_GENERAL);
+    mesh->indices      = (ce_u32*)ce_mem_alloc(mesh->index_count * sizeof(ce_u32), 0u, CE_MEM_TAG_GENERAL);
+
+    for (t = 0u; t <= SPHERE_STACKS; t++) {
+        phi = CE_PI_F * (ce_f32)t / (ce_f32)SPHERE_STACKS;
+        for (s = 0u; s <= SPHERE_SLICES; s++) {
+            theta           = 2.0f * CE_PI_F * (ce_f32)s / (ce_f32)SPHERE_SLICES;
+            v               = (t * (SPHERE_SLICES + 1u)) + s;
+            mesh->x[v]      = sinf(phi) * cosf(theta);
+            mesh->y[v]      = cosf(phi);
+            mesh->z[v]      = sinf(phi) * sinf(theta);
+            mesh->colors[v] = CE_RGBA((ce_u32)(127.0f + (mesh->x[v] * 127.0f)), (ce_u32)(127.0f + (mesh->y[v] * 127.0f)),
+                                      (ce_u32)(127.0f + (mesh->z[v] * 127.0f)), 255u);
+        }
+    }
+
+    /* Counter-clockwise seen from outside. */
+    n = 0u;
+    for (t = 0u; t < SPHERE_STACKS; t++) {
+        for (s = 0u; s < SPHERE_SLICES; s++) {
+            v                   = (t * (SPHERE_SLICES + 1u)) + s;
+            mesh->indices[n++]  = v;
+            mesh->indices[n++]  = v + 1u;
+            mesh->indices[n++]  = v + SPHERE_SLICES + 1u;
+            mesh->indices[n++]  = v + 1u;
+            mesh->indices[n++]  = v + SPHERE_SLICES + 2u;
+            mesh->indices[n++]  = v + SPHERE_SLICES + 1u;
+        }
+    }
+}
+
+static void write_ppm(const char* path, const ce_sw_target* target)
+{
+    FILE* f;
+    ce_u32 x;
+    ce_u32 y;
+    ce_color c;
+    unsigned char rgb[3];
+
+    f = fopen(path, "wb");
+    if (f != NULL) {
+        fprintf(f, "P6\n%u %u\n255\n", target->width, target->height);
+        for (y = 0u; y < target->height; y++) {
+            for (x = 0u; x < target->width; x++) {
+                c      = target->color[(y * target->stride) + x];
+                rgb[0] = CE_COLOR_R(c);
+                rgb[1] = CE_COLOR_G(c);
+                rgb[2] = CE_COLOR_B(c);
+                (void)fwrite(rgb, 1u, 3u, f);
+            }
+        }
+        (void)fclose(f);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ce_sw_target target;
+    scene_mesh sphere;
+    ce_sw_mesh mesh;
+    ce_bounds3d bounds;
+    ce_frustum frustum;
+    ce_mat4f proj;
+    ce_mat4f view;
+    ce_mat4f view_proj;
+    ce_mat4f model;
+    ce_mat4f mvp;
+    ce_u32* visible;
+    ce_u32 visible_count;
+    ce_u32 frames;
+    ce_u32 frame;
+    ce_u32 i;
+    ce_u32 gx;
+    ce_u32 gz;
+    ce_f32 angle;
+    ce_f32 half;
+    ce_u64 start;
+    ce_u64 elapsed;
+    ce_f64 seconds;
+
+    frames = (argc > 1) ? (ce_u32)atoi(argv[1]) : 60u;
+    frames = (frames == 0u) ? 1u : frames;
+
+    if (ce_sw_target_init(&target, SCENE_WIDTH, SCENE_HEIGHT) != CE_OK) {
+        fprintf(stderr, "failed to create render target\n");
+        return 1;
+    }
+
+    build_sphere(&sphere);
+    mesh.x            = sphere.x;
+    mesh.y            = sphere.y;
+    mesh.z            = sphere.z;
+    mesh.colors       = sphere.colors;
+    mesh.indices      = sphere.indices;
+    mesh.vertex_count = sphere.vertex_count;
+    mesh.index_count  = sphere.index_count;
+
+    half = 0.5f * GRID_SPACING * (ce_f32)(GRID_SIZE - 1u);
+    (void)ce_bounds3d_init(&bounds, GRID_SIZE * GRID_SIZE);
+    for (gz = 0u; gz < GRID_SIZE; gz++) {
+        for (gx = 0u; gx < GRID_SIZE; gx++) {
+            (void)ce_bounds3d_push(&bounds, ((ce_f32)gx * GRID_SPACING) - half, 0.0f, ((ce_f32)gz * GRID_SPACING) - half, 1.0f);
+        }
+    }
+    visible = (ce_u32*)ce_mem_alloc(CE_CULL_OUT_CAPACITY(bounds.count) * sizeof(ce_u32), 0u, CE_MEM_TAG_GENERAL);
+
+    ce_mat4f_perspective(&proj, CE_PI_F / 3.0f, (ce_f32)SCENE_WIDTH / (ce_f32)SCENE_HEIGHT, 0.1f, 200.0f);
+    ce_sw_target_reset_stats(&target);
+
+    start = ce_time_now_ns();
+    for (frame = 0u; frame < frames; frame++) {
+        angle = (2.0f * CE_PI_F * (ce_f32)frame) / (ce_f32)frames;
+        ce_mat4f_look_at(&view, ce_vec3f_make(cosf(angle) * 30.0f, 8.0f, sinf(angle) * 30.0f), ce_vec3f_make(0.0f, 0.0f, 0.0f),
+                         ce_vec3f_make(0.0f, 1.0f, 0.0f));
+        ce_mat4f_mul(&view_proj, &proj, &view);
+        ce_frustum_from_matrix(&frustum, view_proj.m);
+        visible_count = ce_cull_frustum(&bounds, &frustum, visible);
+
+        ce_sw_target_clear(&target, CE_RGBA(24u, 24u, 32u, 255u), 1.0f);
+        for (i = 0u; i < visible_count; i++) {
+            ce_mat4f_translation(&model, ce_vec3f_make(bounds.center_x[visible[i]], bounds.center_y[visible[i]],
+                                                       bounds.center_z[visible[i]]));
+            ce_mat4f_mul(&mvp, &view_proj, &model);
+            (void)ce_sw_draw_mesh(&target, &mesh, &mvp, CE_COLOR_WHITE, CE_SW_CULL_BACK);
+        }
+    }
+    elapsed = ce_time_now_ns() - start;
+    seconds = (ce_f64)elapsed / (ce_f64)CE_NS_PER_S;
+
+    printf("frames            : %u (%ux%u)\n", frames, SCENE_WIDTH, SCENE_HEIGHT);
+    printf("frame time        : %.3f ms\n", (seconds * 1000.0) / (ce_f64)frames);
+    printf("triangles/s       : %.2f M submitted, %.2f M rasterized\n",
+           ((ce_f64)target.stats.triangles_submitted / seconds) / 1e6,
+           ((ce_f64)target.stats.triangles_rasterized / seconds) / 1e6);
+    printf("culled / clipped  : %llu / %llu\n", target.stats.triangles_culled, target.stats.triangles_clipped);
+    printf("hi-z tile rejects : %.1f %% of %llu tiles\n",
+           (target.stats.tiles_tested != 0u)
+               ? (100.0 * (ce_f64)target.stats.tiles_hiz_rejected / (ce_f64)target.stats.tiles_tested) : 0.0,
+           target.stats.tiles_tested);
+    printf("pixels written    : %llu\n", target.stats.pixels_written);
+
+    if (argc > 2) {
+        write_ppm(argv[2], &target);
+    }
+
+    ce_mem_free(visible);
+    ce_bounds3d_shutdown(&bounds);
+    ce_mem_free(sphere.x);
+    ce_mem_free(sphere.y);
+    ce_mem_free(sphere.z);
+    ce_mem_free(sphere.colors);
+    ce_mem_free(sphere.indices);
+    ce_sw_target_shutdown(&target);
+    return 0;
+}
@@ -11,15 +11,113 @@
  * @file chaos_audio.h
  * @brief Audio device and playback API.
  * @author PapaPamplemousse
+ *
+ * A device pulls blocks from a ce_mixer. The null backend has no hardware:
+ * it renders when the engine pumps it with its own clock (or on demand) and
+ * sends the frames to a WAV file, a memory buffer or nowhere, timing every
+ * block. The same commands at the same clock values give bit-identical
+ * output, which makes golden files and audio perf runs possible in CI.
  */
 #ifndef CHAOS_AUDIO_H
 #define CHAOS_AUDIO_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "audio/chaos_mixer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/**
+ * @brief Device implementation.
+ */
+typedef enum ce_audio_backend_e {
+    CE_AUDIO_BACKEND_NULL = 0, /**< No hardware; driven by ce_audio_device_pump / render. */
+    CE_AUDIO_BACKEND_LIVE      /**< System output (miniaudio; CE_ERR_UNSUPPORTED until available). */
+} ce_audio_backend;
+
+/**
+ * @brief Where the null backend sends rendered frames.
+ */
+typedef enum ce_audio_sink_e {
+    CE_AUDIO_SINK_DISCARD = 0, /**< Render and time only. */
+    CE_AUDIO_SINK_MEMORY,      /**< Interleaved stereo float into a caller buffer. */
+    CE_AUDIO_SINK_WAV          /**< 32-bit float stereo WAV file. */
+} ce_audio_sink;
+
+/**
+ * @brief Device configuration.
+ */
+typedef struct ce_audio_device_desc_s {
+    ce_audio_backend backend;
+    ce_mixer*        mixer;             /**< Rendered by the device; the rate is the mixer's. */
+    ce_u32           block_frames;      /**< Frames per callback (0 = CE_MIXER_BLOCK_FRAMES). */
+    ce_audio_sink    sink;
+    const ce_char*   wav_path;          /**< CE_AUDIO_SINK_WAV. */
+    ce_f32*          memory;            /**< CE_AUDIO_SINK_MEMORY: 2 * memory_frames floats. */
+    ce_u32           memory_frames;
+    ce_u64*          block_ns;          /**< Optional: callback time of each block, in order. */
+    ce_u32           block_ns_capacity;
+} ce_audio_device_desc;
+
+/**
+ * @brief Device counters.
+ */
+typedef struct ce_audio_device_stats_s {
+    ce_u64 blocks;
+    ce_u64 frames;
+    ce_u64 frames_dropped;   /**< Memory sink full or WAV write failed. */
+    ce_u64 deadline_misses;  /**< Blocks whose callback took longer than their own duration. */
+    ce_u64 callback_ns_last;
+    ce_u64 callback_ns_min;
+    ce_u64 callback_ns_max;
+    ce_u64 callback_ns_total;
+} ce_audio_device_stats;
+
+typedef struct ce_audio_device_s ce_audio_device;
+
+/**
+ * @brief Opens a device (the WAV sink creates its file here).
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_IO, CE_ERR_OUT_OF_MEMORY or CE_ERR_UNSUPPORTED.
+ */
+ce_result ce_audio_device_open(const ce_audio_device_desc* desc, ce_audio_device** out_device);
+
+/**
+ * @brief Closes the device; finalizes the WAV header.
+ */
+void ce_audio_device_close(ce_audio_device* device);
+
+/**
+ * @brief Sets the clock origin for ce_audio_device_pump().
+ * @param now_ns Engine clock (ce_time_now_ns() or a simulated fixed-step clock).
+ */
+void ce_audio_device_start(ce_audio_device* device, ce_u64 now_ns);
+
+/**
+ * @brief Renders every whole block due between the origin and `now_ns`.
+ *
+ * Time going backwards is ignored: a `now_ns` earlier than a previous pump,
+ * or not after the origin, renders nothing, and rendering resumes once the
+ * clock passes the frames already output.
+ *
+ * @return Frames rendered by this call.
+ */
+ce_u32 ce_audio_device_pump(ce_audio_device* device, ce_u64 now_ns);
+
+/**
+ * @brief Renders exactly `frames` frames now, regardless of the clock.
+ *
+ * Frames are rendered in device blocks; the last one may be shorter.
+ */
+void ce_audio_device_render(ce_audio_device* device, ce_u32 frames);
+
+/**
+ * @brief Frames delivered to the memory sink so far.
+ */
+ce_u32 ce_audio_device_memory_frames(const ce_audio_device* device);
+
+void ce_audio_device_get_stats(const ce_audio_device* device, ce_audio_device_stats* out_stats);
 
 #ifdef __cplusplus
 }
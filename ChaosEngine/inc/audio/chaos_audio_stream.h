@@ -0,0 +1,213 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_audio_stream.h
+ * @brief Streaming audio: decoders and worker-fed ring buffers.
+ * @author PapaPamplemousse
+ *
+ * A streamer owns one worker thread that decodes fixed-size chunks into the
+ * ring of every open stream, hungriest stream first. The mixer consumes a
+ * stream from the audio thread without locking, so memory per track is the
+ * ring size whatever the track length. Resampling to the mixer rate, when
+ * needed, also happens on the worker.
+ *
+ * Threading: open / close / seek / set_loop / stats are control-thread
+ * calls; apply_seek / acquire / release / finished / underrun belong to the
+ * single consumer (the mixer's audio thread).
+ */
+#ifndef CHAOS_AUDIO_STREAM_H
+#define CHAOS_AUDIO_STREAM_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "audio/chaos_resample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ************************************************************************** */
+/* DECODERS                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Incremental PCM decoder (WAV always; OGG Vorbis with CE_HAVE_STB_VORBIS).
+ */
+typedef struct ce_audio_decoder_s ce_audio_decoder;
+
+/**
+ * @brief Format of an opened decoder.
+ */
+typedef struct ce_audio_info_s {
+    ce_u32 channel_count; /**< 1 or 2. */
+    ce_u32 sample_rate;
+    ce_u64 frame_count;   /**< 0 when unknown. */
+} ce_audio_info;
+
+/**
+ * @brief Opens a file; only the header is parsed.
+ * @return CE_OK, CE_ERR_IO, CE_ERR_FORMAT, CE_ERR_UNSUPPORTED or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_audio_decoder_open_file(const ce_char* path, ce_audio_decoder** out_decoder);
+
+/**
+ * @brief Opens an in-memory file image (must outlive the decoder).
+ */
+ce_result ce_audio_decoder_open_memory(const void* data, ce_size size, ce_audio_decoder** out_decoder);
+
+void ce_audio_decoder_close(ce_audio_decoder* decoder);
+
+void ce_audio_decoder_get_info(const ce_audio_decoder* decoder, ce_audio_info* out_info);
+
+/**
+ * @brief Decodes up to `frames` frames as planar float.
+ * @param channels channels[c] receives `frames` samples (channels[1] unused for mono).
+ * @return Frames decoded; less than `frames` only at the end of the data or on error.
+ */
+ce_u32 ce_audio_decoder_read(ce_audio_decoder* decoder, ce_f32* const channels[2], ce_u32 frames);
+
+/**
+ * @brief Repositions the decoder at `frame`.
+ */
+ce_result ce_audio_decoder_seek(ce_audio_decoder* decoder, ce_u64 frame);
+
+/* ************************************************************************** */
+/* STREAMER                                                                   */
+/* ************************************************************************** */
+
+typedef struct ce_audio_streamer_s ce_audio_streamer;
+typedef struct ce_audio_stream_s   ce_audio_stream;
+
+/**
+ * @brief Streamer configuration (zero fields take defaults).
+ */
+typedef struct ce_audio_streamer_desc_s {
+    ce_u32 chunk_frames; /**< Frames decoded per worker step (0 = 4096). */
+    ce_u32 poll_ms;      /**< Worker sleep when every ring is full (0 = 2). */
+} ce_audio_streamer_desc;
+
+/**
+ * @brief Stream source and buffering (zero fields take defaults).
+ */
+typedef struct ce_audio_stream_desc_s {
+    const ce_char*      path;            /**< File to stream, or CE_NULL to use data/size. */
+    const void*         data;
+    ce_size             size;
+    ce_u32              buffer_frames;   /**< Ring capacity, rounded to a power of two (0 = 4 chunks). */
+    ce_u32              prefetch_frames; /**< Frames buffered before the stream reports ready (0 = half the ring). */
+    ce_bool             loop;
+    ce_u32              output_rate;     /**< Worker resamples to this rate (0 = source rate). */
+    ce_resample_quality quality;         /**< Resampling kernel when output_rate differs. */
+} ce_audio_stream_desc;
+
+/**
+ * @brief Stream counters.
+ */
+typedef struct ce_audio_stream_stats_s {
+    ce_audio_info info;            /**< Source format. */
+    ce_u64        decoded_frames;  /**< Total frames written by the worker (output rate). */
+    ce_u64        consumed_frames; /**< Total frames released by the consumer. */
+    ce_u32        buffered_frames;
+    ce_u32        underruns;       /**< Render calls that found the ring empty. */
+    ce_u64        underrun_frames; /**< Frames output as silence because of underruns. */
+} ce_audio_stream_stats;
+
+/**
+ * @brief Starts the worker thread.
+ */
+ce_result ce_audio_streamer_create(const ce_audio_streamer_desc* desc, ce_audio_streamer** out_streamer);
+
+/**
+ * @brief Stops the worker; every stream must be closed first.
+ */
+void ce_audio_streamer_destroy(ce_audio_streamer* streamer);
+
+/**
+ * @brief Opens a stream; decoding starts in the background immediately.
+ */
+ce_result ce_audio_stream_open(ce_audio_streamer* streamer, const ce_audio_stream_desc* desc,
+                               ce_audio_stream** out_stream);
+
+/**
+ * @brief Closes a stream (no voice may still be playing it).
+ */
+void ce_audio_stream_close(ce_audio_stream* stream);
+
+/**
+ * @brief Restarts decoding at `frame`; buffered frames are dropped.
+ */
+ce_result ce_audio_stream_seek(ce_audio_stream* stream, ce_u64 frame);
+
+/**
+ * @brief Enables or disables wrapping to frame 0 at the end of the data.
+ */
+void ce_audio_stream_set_loop(ce_audio_stream* stream, ce_bool loop);
+
+/**
+ * @brief CE_TRUE once the prefetch is buffered (or the data ended).
+ */
+ce_bool ce_audio_stream_ready(const ce_audio_stream* stream);
+
+void ce_audio_stream_get_stats(const ce_audio_stream* stream, ce_audio_stream_stats* out_stats);
+
+/* ************************************************************************** */
+/* CONSUMER                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Skips the frames a seek discarded, letting the worker reuse them.
+ *
+ * ce_audio_stream_acquire() does this itself. A consumer waiting for
+ * ce_audio_stream_ready() without acquiring must call it meanwhile, or a
+ * seek on a full ring never frees room for the new prefetch.
+ */
+void ce_audio_stream_apply_seek(ce_audio_stream* stream);
+
+/**
+ * @brief Contiguous run of buffered frames.
+ * @param out_right Receives the left pointer again for mono streams.
+ * @return Frames readable at the pointers (0 when empty), at most `max_frames`.
+ */
+ce_u32 ce_audio_stream_acquire(ce_audio_stream* stream, ce_u32 max_frames, const ce_f32** out_left,
+                               const ce_f32** out_right);
+
+/**
+ * @brief Consumes `frames` frames returned by ce_audio_stream_acquire().
+ */
+void ce_audio_stream_release(ce_audio_stream* stream, ce_u32 frames);
+
+/**
+ * @brief CE_TRUE when a non-looping stream has been fully consumed.
+ */
+ce_bool ce_audio_stream_finished(const ce_audio_stream* stream);
+
+/**
+ * @brief Records `frames` frames of silence output because the ring was empty.
+ *
+ * Ignored until the stream has become ready, so a voice started on a
+ * still-prefetching stream waits silently rather than counting underruns.
+ */
+void ce_audio_stream_underrun(ce_audio_stream* stream, ce_u32 frames);
+
+/**
+ * @brief Channel count, readable from any thread.
+ */
+ce_u32 ce_audio_stream_channels(const ce_audio_stream* stream);
+
+/**
+ * @brief Rate of the frames in the ring (the output rate), readable from any thread.
+ */
+ce_u32 ce_audio_stream_sample_rate(const ce_audio_stream* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_AUDIO_STREAM_H */
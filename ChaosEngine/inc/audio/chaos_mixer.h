@@ -11,15 +11,182 @@
  * @file chaos_mixer.h
  * @brief Software mixer API.
  * @author PapaPamplemousse
+ *
+ * Threading: one control thread (usually the game thread) calls the
+ * ce_mixer_play / stop / set_* / update functions; one audio thread calls
+ * ce_mixer_render(). Control changes travel over a single-producer /
+ * single-consumer ring, so the render path never locks or allocates.
+ *
+ * Sounds at another sample rate are resampled per voice (linear or
+ * polyphase, see chaos_resample.h). Above the real-voice limit the
+ * quietest voices go virtual: they advance their cursor and ramps without
+ * being mixed and fade back in where they would have been.
  */
 #ifndef CHAOS_MIXER_H
 #define CHAOS_MIXER_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "audio/chaos_audio_stream.h"
+#include "audio/chaos_resample.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/** @brief Frames mixed per internal block (multiple of 8). */
+#define CE_MIXER_BLOCK_FRAMES    512u
+/** @brief Default click-free gain ramp length in frames. */
+#define CE_MIXER_RAMP_FRAMES     256u
+/** @brief Fade-in applied when a virtual voice becomes audible again. */
+#define CE_MIXER_RESUME_FRAMES   64u
+/** @brief Distinct source rates with a cached polyphase table. */
+#define CE_MIXER_MAX_RATE_TABLES 8u
+
+/**
+ * @brief Immutable PCM data, planar 32-bit float.
+ *
+ * Planar channels keep 8 consecutive samples contiguous for SIMD loads.
+ * Must outlive every voice playing it.
+ */
+typedef struct ce_sound_s {
+    const ce_f32* channels[2];  /**< channels[1] is ignored for mono. */
+    ce_u32        channel_count; /**< 1 or 2. */
+    ce_u32        frame_count;
+    ce_u32        sample_rate;
+} ce_sound;
+
+/**
+ * @brief Voice identifier (a 32-bit ce_handle); CE_VOICE_NONE is never valid.
+ */
+typedef ce_u32 ce_voice_id;
+
+#define CE_VOICE_NONE ((ce_voice_id)0u)
+
+/**
+ * @brief Playback parameters for ce_mixer_play().
+ */
+typedef struct ce_voice_params_s {
+    ce_f32              volume;         /**< Linear gain. */
+    ce_f32              pan;            /**< -1 (left) .. 1 (right); balance for stereo sounds. */
+    ce_bool             loop;           /**< Ignored for streams (see ce_audio_stream_set_loop). */
+    ce_u32              fade_in_frames; /**< 0 starts at full volume. */
+    ce_resample_quality quality;        /**< Used when the sound's rate differs from the mixer's. */
+} ce_voice_params;
+
+/**
+ * @brief Mixer configuration.
+ */
+typedef struct ce_mixer_desc_s {
+    ce_u32 sample_rate;      /**< Output rate (Hz). */
+    ce_u32 max_voices;       /**< Size of the preallocated voice pool. */
+    ce_u32 command_capacity; /**< Control ring size (0 = 1024). */
+    ce_u32 real_voice_limit; /**< Voices actually mixed per block (0 = max_voices). */
+} ce_mixer_desc;
+
+/**
+ * @brief Counters (read from any thread; written by the audio thread).
+ */
+typedef struct ce_mixer_stats_s {
+    ce_u32 active_voices;     /**< Real + virtual. */
+    ce_u32 virtual_voices;
+    ce_u64 frames_rendered;
+    ce_u64 commands_dropped;  /**< Control calls rejected because the ring was full. */
+    ce_u64 render_ns_last;    /**< Wall time of the last ce_mixer_render() call. */
+    ce_u64 render_ns_max;
+} ce_mixer_stats;
+
+typedef struct ce_mixer_s ce_mixer;
+
+/**
+ * @brief Creates a mixer; every buffer it will ever use is allocated here.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_mixer_create(const ce_mixer_desc* desc, ce_mixer** out_mixer);
+
+/**
+ * @brief Destroys the mixer (no render may be running).
+ */
+void ce_mixer_destroy(ce_mixer* mixer);
+
+/* ************************************************************************** */
+/* CONTROL THREAD                                                             */
+/* ************************************************************************** */
+
+/**
+ * @brief Starts a voice.
+ * @return Voice id, or CE_VOICE_NONE when the pool or command ring is full.
+ */
+ce_voice_id ce_mixer_play(ce_mixer* mixer, const ce_sound* sound, const ce_voice_params* params);
+
+/**
+ * @brief Starts a voice consuming a stream.
+ *
+ * A stream feeds one voice at a time and must already be at the mixer's
+ * rate (ce_audio_stream_desc::output_rate). The voice stays silent until the
+ * stream's prefetch is buffered, counts underruns afterwards and ends when
+ * a non-looping stream is drained.
+ *
+ * @return Voice id, or CE_VOICE_NONE when the pool or command ring is full
+ *         or the stream's rate does not match.
+ */
+ce_voice_id ce_mixer_play_stream(ce_mixer* mixer, ce_audio_stream* stream, const ce_voice_params* params);
+
+/**
+ * @brief Fades a voice out over `fade_frames` (0 = one default ramp) and frees it.
+ * @return CE_OK, CE_ERR_NOT_FOUND for a stale id, CE_ERR_FULL when the ring is full.
+ */
+ce_result ce_mixer_stop(ce_mixer* mixer, ce_voice_id voice, ce_u32 fade_frames);
+
+/**
+ * @brief Ramps a voice's volume to `volume`.
+ */
+ce_result ce_mixer_set_volume(ce_mixer* mixer, ce_voice_id voice, ce_f32 volume);
+
+/**
+ * @brief Ramps a voice's pan to `pan`.
+ */
+ce_result ce_mixer_set_pan(ce_mixer* mixer, ce_voice_id voice, ce_f32 pan);
+
+/**
+ * @brief Sets the output gain applied after summing.
+ */
+ce_result ce_mixer_set_master_volume(ce_mixer* mixer, ce_f32 volume);
+
+/**
+ * @brief Reclaims voices the audio thread finished; call once per frame.
+ */
+void ce_mixer_update(ce_mixer* mixer);
+
+/**
+ * @brief CE_TRUE while the voice has not been reclaimed by ce_mixer_update().
+ */
+ce_bool ce_mixer_is_playing(const ce_mixer* mixer, ce_voice_id voice);
+
+/**
+ * @brief Output rate the mixer was created with (Hz).
+ */
+ce_u32 ce_mixer_sample_rate(const ce_mixer* mixer);
+
+/**
+ * @brief Snapshot of the counters.
+ */
+void ce_mixer_get_stats(const ce_mixer* mixer, ce_mixer_stats* out_stats);
+
+/* ************************************************************************** */
+/* AUDIO THREAD                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Applies pending commands and mixes `frames` interleaved stereo frames.
+ *
+ * Real-time safe: no locks, no allocation, no system calls besides the
+ * clock read used for the timing counters. Also the offline path: call it
+ * from any single thread to render into a buffer without a device.
+ *
+ * @param out Interleaved L/R output, 2 * frames floats, clipped to [-1, 1].
+ */
+void ce_mixer_render(ce_mixer* mixer, ce_f32* out, ce_u32 frames);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,103 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_resample.h
+ * @brief Sample-rate conversion kernels.
+ * @author PapaPamplemousse
+ *
+ * Source positions are 32.32 fixed point frames, so a cursor advances by
+ * an exact integer step per output frame and never drifts. Interior
+ * kernels read only [idx - CE_RESAMPLE_BEFORE(q), idx + CE_RESAMPLE_AFTER(q)]
+ * and run 8 frames (linear) or 16 taps (polyphase) per SIMD step; the edge
+ * helper handles the few frames near the ends of a buffer.
+ */
+#ifndef CHAOS_RESAMPLE_H
+#define CHAOS_RESAMPLE_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-voice quality tier.
+ */
+typedef enum ce_resample_quality_e {
+    CE_RESAMPLE_LINEAR = 0,  /**< 2-point interpolation, cheapest. */
+    CE_RESAMPLE_POLYPHASE    /**< 16-tap Kaiser-windowed sinc, band-limited. */
+} ce_resample_quality;
+
+/** @brief 1.0 in 32.32 fixed point. */
+#define CE_RESAMPLE_ONE    (1ull << 32u)
+#define CE_RESAMPLE_TAPS   16u
+#define CE_RESAMPLE_PHASES 128u
+
+/** @brief Source frames needed before / after the integer position. */
+#define CE_RESAMPLE_BEFORE(q) (((q) == CE_RESAMPLE_POLYPHASE) ? 7u : 0u)
+#define CE_RESAMPLE_AFTER(q)  (((q) == CE_RESAMPLE_POLYPHASE) ? 8u : 1u)
+
+/**
+ * @brief Polyphase coefficients for one rate pair.
+ *
+ * (CE_RESAMPLE_PHASES + 1) rows of CE_RESAMPLE_TAPS; adjacent rows are
+ * interpolated. The cutoff follows the lower of the two Nyquist rates so
+ * downsampling is anti-aliased.
+ */
+typedef struct ce_resample_table_s {
+    ce_f32* coefs;
+    ce_u32  in_rate;
+    ce_u32  out_rate;
+} ce_resample_table;
+
+/**
+ * @brief Fixed-point source step per output frame.
+ */
+ce_u64 ce_resample_step(ce_u32 in_rate, ce_u32 out_rate);
+
+/**
+ * @brief Builds the coefficient table (allocates; not for the audio thread).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_resample_table_init(ce_resample_table* table, ce_u32 in_rate, ce_u32 out_rate);
+
+void ce_resample_table_shutdown(ce_resample_table* table);
+
+/**
+ * @brief Output frames from `pos` whose whole kernel footprint lies inside [0, count).
+ * @return Interior frames, at most `max_frames` (0 means use ce_resample_edge next).
+ */
+ce_u32 ce_resample_interior_frames(ce_resample_quality quality, ce_u64 pos, ce_u64 step, ce_u32 count,
+                                   ce_u32 max_frames);
+
+/**
+ * @brief Linear interpolation of `frames` frames starting at `pos`.
+ */
+void ce_resample_linear(const ce_f32* src, ce_u64 pos, ce_u64 step, ce_f32* out, ce_u32 frames);
+
+/**
+ * @brief Polyphase filtering of `frames` frames starting at `pos`.
+ */
+void ce_resample_polyphase(const ce_resample_table* table, const ce_f32* src, ce_u64 pos, ce_u64 step, ce_f32* out,
+                           ce_u32 frames);
+
+/**
+ * @brief One frame anywhere in [0, count): reads outside wrap when `loop`, else are silent.
+ * @param table Required for CE_RESAMPLE_POLYPHASE.
+ */
+ce_f32 ce_resample_edge(ce_resample_quality quality, const ce_resample_table* table, const ce_f32* src, ce_u32 count,
+                        ce_bool loop, ce_u64 pos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_RESAMPLE_H */
@@ -0,0 +1,53 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_compress.h
+ * @brief Block compression (LZ4 block format).
+ * @author PapaPamplemousse
+ *
+ * Self-contained implementation of the LZ4 block format: streams written
+ * here decode with the reference library and vice versa. The compressor is
+ * the greedy single-probe variant (fast, modest ratio); the decompressor
+ * validates every length and offset, so corrupt input fails cleanly.
+ */
+#ifndef CHAOS_COMPRESS_H
+#define CHAOS_COMPRESS_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Worst-case compressed size of `size` input bytes.
+ */
+ce_size ce_lz4_compress_bound(ce_size size);
+
+/**
+ * @brief Compresses one block.
+ * @param dst Output buffer of `capacity` bytes (ce_lz4_compress_bound() always suffices).
+ * @return Compressed size, or 0 when it does not fit in `capacity`.
+ */
+ce_size ce_lz4_compress(const void* src, ce_size size, void* dst, ce_size capacity);
+
+/**
+ * @brief Decompresses one block whose decompressed size is known.
+ * @return CE_OK, or CE_ERR_FORMAT when the block is corrupt or does not
+ *         decode to exactly `dst_size` bytes.
+ */
+ce_result ce_lz4_decompress(const void* src, ce_size size, void* dst, ce_size dst_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_COMPRESS_H */
@@ -9,17 +9,220 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_containers.h
- * @brief Dynamic array & hashmap API.
+ * @brief Dynamic array, hashmap & lock-free ring API.
  * @author PapaPamplemousse
  */
 #ifndef CHAOS_CONTAINERS_H
 #define CHAOS_CONTAINERS_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_error.h"
+#include "core/chaos_memory.h"
+#include "platform/chaos_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* HASHING                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief 64-bit FNV-1a hash of a byte range.
+ * @param data Bytes to hash (may be CE_NULL when size is 0).
+ * @param size Number of bytes.
+ * @return Hash value, never 0 (0 is the hashmap's empty key).
+ */
+ce_u64 ce_hash_bytes(const void* data, ce_size size);
+
+/**
+ * @brief 64-bit FNV-1a hash of a NUL-terminated string.
+ * @param str C-string (CE_NULL hashes like "").
+ * @return Hash value, never 0.
+ */
+ce_u64 ce_hash_str(const ce_char* str);
+
+/**
+ * @brief Mixes two hashes into one (order-dependent).
+ * @return Combined hash, never 0.
+ */
+ce_u64 ce_hash_combine(ce_u64 a, ce_u64 b);
+
+/* ************************************************************************** */
+/* DYNAMIC ARRAY                                                              */
+/* ************************************************************************** */
+
+/**
+ * @brief Growable array of fixed-size elements.
+ */
+typedef struct ce_dynarray_s {
+    void*      data;
+    ce_size    count;
+    ce_size    capacity;
+    ce_size    elem_size;
+    ce_mem_tag tag;
+} ce_dynarray;
+
+/** @brief Typed element access (no bounds check). */
+#define CE_DYNARRAY_AT(arr, type, index) (((type*)(arr)->data)[(index)])
+
+/**
+ * @brief Initializes an empty array.
+ * @param arr Array to initialize.
+ * @param elem_size Size of one element in bytes (> 0).
+ * @param initial_capacity Elements to reserve up front (may be 0).
+ * @param tag Memory tag for the backing storage.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_dynarray_init(ce_dynarray* arr, ce_size elem_size, ce_size initial_capacity, ce_mem_tag tag);
+
+/**
+ * @brief Releases the backing storage.
+ */
+void ce_dynarray_shutdown(ce_dynarray* arr);
+
+/**
+ * @brief Ensures capacity for at least `capacity` elements.
+ * @return CE_OK or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_dynarray_reserve(ce_dynarray* arr, ce_size capacity);
+
+/**
+ * @brief Resizes the array (new elements are zero-filled).
+ * @return CE_OK or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_dynarray_resize(ce_dynarray* arr, ce_size count);
+
+/**
+ * @brief Appends one element (copied from elem, or zero-filled if CE_NULL).
+ * @return Pointer to the stored element, or CE_NULL on allocation failure.
+ */
+void* ce_dynarray_push(ce_dynarray* arr, const void* elem);
+
+/**
+ * @brief Appends n uninitialized elements.
+ * @return Pointer to the first new element, or CE_NULL on failure.
+ */
+void* ce_dynarray_push_n(ce_dynarray* arr, ce_size n);
+
+/**
+ * @brief Removes an element by moving the last one into its slot (O(1)).
+ */
+void ce_dynarray_remove_swap(ce_dynarray* arr, ce_size index);
+
+/**
+ * @brief Empties the array without releasing memory.
+ */
+void ce_dynarray_clear(ce_dynarray* arr);
+
+/**
+ * @brief Returns a pointer to element `index` (CE_NULL when out of range).
+ */
+void* ce_dynarray_at(const ce_dynarray* arr, ce_size index);
+
+/* ************************************************************************** */
+/* HASHMAP (u64 -> u64)                                                       */
+/* ************************************************************************** */
+
+/**
+ * @brief Open-addressing hashmap with linear probing.
+ *
+ * Keys are 64-bit hashes; key 0 is reserved as the empty marker.
+ * Values are opaque 64-bit payloads (indices, packed handles...).
+ */
+typedef struct ce_hashmap_s {
+    ce_u64*    keys;
+    ce_u64*    values;
+    ce_u32     capacity;  /**< Power of two (0 when unallocated). */
+    ce_u32     count;
+    ce_mem_tag tag;
+} ce_hashmap;
+
+/**
+ * @brief Initializes a map able to hold `initial_capacity` keys before growing.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_hashmap_init(ce_hashmap* map, ce_u32 initial_capacity, ce_mem_tag tag);
+
+/**
+ * @brief Releases the map storage.
+ */
+void ce_hashmap_shutdown(ce_hashmap* map);
+
+/**
+ * @brief Inserts or overwrites a key.
+ * @return CE_OK, CE_ERR_INVALID_ARG for key 0, or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_hashmap_put(ce_hashmap* map, ce_u64 key, ce_u64 value);
+
+/**
+ * @brief Looks up a key.
+ * @param out_value Receives the value when found (may be CE_NULL).
+ * @return CE_TRUE when found.
+ */
+ce_bool ce_hashmap_get(const ce_hashmap* map, ce_u64 key, ce_u64* out_value);
+
+/**
+ * @brief Removes a key (backward-shift deletion, no tombstones).
+ * @return CE_TRUE when the key was present.
+ */
+ce_bool ce_hashmap_remove(ce_hashmap* map, ce_u64 key);
+
+/**
+ * @brief Removes every key without releasing memory.
+ */
+void ce_hashmap_clear(ce_hashmap* map);
+
+/* ************************************************************************** */
+/* SPSC RING                                                                  */
+/* ************************************************************************** */
+
+/**
+ * @brief Bounded single-producer / single-consumer queue of fixed-size items.
+ *
+ * Wait-free on both sides: one thread pushes, one other thread pops, no
+ * locks and no allocation after init. Head and tail live on separate cache
+ * lines so producer and consumer do not false-share.
+ */
+typedef struct ce_spsc_ring_s {
+    CE_CACHE_ALIGNED ce_atomic_u32 head;  /**< Next slot to pop (written by the consumer). */
+    CE_CACHE_ALIGNED ce_atomic_u32 tail;  /**< Next slot to push (written by the producer). */
+    CE_CACHE_ALIGNED ce_u8* data;
+    ce_size elem_size;
+    ce_u32  mask;
+    ce_mem_tag tag;
+} ce_spsc_ring;
+
+/**
+ * @brief Allocates a ring.
+ * @param capacity Rounded up to a power of two.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_spsc_ring_init(ce_spsc_ring* ring, ce_size elem_size, ce_u32 capacity, ce_mem_tag tag);
+
+/**
+ * @brief Releases the ring storage.
+ */
+void ce_spsc_ring_shutdown(ce_spsc_ring* ring);
+
+/**
+ * @brief Copies one item in (producer thread only).
+ * @return CE_FALSE when the ring is full.
+ */
+ce_bool ce_spsc_ring_push(ce_spsc_ring* ring, const void* item);
+
+/**
+ * @brief Copies the oldest item out (consumer thread only).
+ * @return CE_FALSE when the ring is empty.
+ */
+ce_bool ce_spsc_ring_pop(ce_spsc_ring* ring, void* item);
+
+/**
+ * @brief Items currently queued (approximate while the other side runs).
+ */
+ce_u32 ce_spsc_ring_count(const ce_spsc_ring* ring);
 
 #ifdef __cplusplus
 }
@@ -11,15 +11,174 @@
  * @file chaos_defs.h
  * @brief Global macros, attributes, hints.
  * @author PapaPamplemousse
+ *
+ * Compiler hints (branch weights, inlining, aliasing, alignment, prefetch),
+ * cache-line layout macros and runtime CPU feature detection.
+ *
+ * Kernels keep the compile-time ce_f32x8 path (chaos_simd.h) as their
+ * baseline. Where the compiler can emit code for a wider ISA than the build
+ * targets, a module adds variants compiled with CE_TARGET() and lists them,
+ * best first, in a ce_cpu_variant table; ce_cpu_select() picks the first one
+ * the running CPU supports. Hot paths keep that choice in a ce_cpu_dispatch,
+ * resolved on first use and again only after ce_cpu_set_mask(). Building
+ * with -DCE_NO_CPU_DISPATCH keeps only the baseline.
  */
 #ifndef CHAOS_DEFS_H
 #define CHAOS_DEFS_H
 
+#include "core/chaos_types.h"
+#include "platform/chaos_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* COMPILER & ARCHITECTURE                                                    */
+/* ************************************************************************** */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CE_COMPILER_GNU 1
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CE_ARCH_X64 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CE_ARCH_ARM64 1
+#endif
+
+/* ************************************************************************** */
+/* HINTS                                                                      */
+/* ************************************************************************** */
+
+#if defined(CE_COMPILER_GNU)
+#define CE_LIKELY(x)              __builtin_expect(!!(x), 1)
+#define CE_UNLIKELY(x)            __builtin_expect(!!(x), 0)
+#define CE_FORCE_INLINE           static inline __attribute__((always_inline))
+#define CE_NOINLINE               __attribute__((noinline))
+#define CE_ASSUME_ALIGNED(p, a)   __builtin_assume_aligned((p), (a))
+#define CE_PREFETCH(p)            __builtin_prefetch((p), 0, 3)
+#define CE_PREFETCH_WRITE(p)      __builtin_prefetch((p), 1, 3)
+#else
+#define CE_LIKELY(x)              (x)
+#define CE_UNLIKELY(x)            (x)
+#define CE_FORCE_INLINE           static inline
+#define CE_NOINLINE
+#define CE_ASSUME_ALIGNED(p, a)   (p)
+#define CE_PREFETCH(p)            ((void)(p))
+#define CE_PREFETCH_WRITE(p)      ((void)(p))
+#endif
+
+/** @brief No-alias qualifier: `ce_f32* CE_RESTRICT dst`. */
+#if defined(__cplusplus)
+#define CE_RESTRICT __restrict
+#else
+#define CE_RESTRICT restrict
+#endif
+
+/* ************************************************************************** */
+/* CACHE LAYOUT                                                               */
+/* ************************************************************************** */
+
+/** @brief Destructive-interference size; override with -DCE_CACHE_LINE_SIZE=n. */
+#ifndef CE_CACHE_LINE_SIZE
+#if defined(__APPLE__) && defined(CE_ARCH_ARM64)
+#define CE_CACHE_LINE_SIZE 128
+#else
+#define CE_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+/** @brief Starts a member or object on its own cache line (keeps writers apart). */
+#define CE_CACHE_ALIGNED _Alignas(CE_CACHE_LINE_SIZE)
+#define CE_ALIGNED(n)    _Alignas(n)
+
+/* ************************************************************************** */
+/* CPU FEATURES                                                               */
+/* ************************************************************************** */
+
+#define CE_CPU_SSE2  (1u << 0)
+#define CE_CPU_SSE41 (1u << 1)
+#define CE_CPU_SSE42 (1u << 2)  /**< Reported only: PCMPxSTRx loses to SSE2/AVX2 compares here. */
+#define CE_CPU_AVX   (1u << 3)  /**< Set only when the OS saves the YMM state. */
+#define CE_CPU_AVX2  (1u << 4)
+#define CE_CPU_FMA   (1u << 5)
+#define CE_CPU_NEON  (1u << 6)
+
+/*
+ * CE_TARGET("avx2") compiles one function for an ISA the build does not
+ * assume; it may only run after ce_cpu_select() chose it.
+ */
+#if defined(CE_COMPILER_GNU) && defined(CE_ARCH_X64) && !defined(CE_NO_CPU_DISPATCH)
+#define CE_CPU_DISPATCH_X64 1
+#define CE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CE_TARGET(isa)
+#endif
+
+/**
+ * @brief One entry of a dispatch table: a kernel table and what it needs.
+ */
+typedef struct ce_cpu_variant_s {
+    ce_u32      features;  /**< CE_CPU_* bits required (0 for the baseline). */
+    const void* table;
+} ce_cpu_variant;
+
+/**
+ * @brief Features of the running CPU, minus any masked by ce_cpu_set_mask().
+ *
+ * Detected on first use; later calls are one relaxed load.
+ */
+ce_u32 ce_cpu_features(void);
+
+/**
+ * A module's cached choice among its variants. The chosen index and the mask
+ * generation it was resolved under share one atomic word, so readers never
+ * pair a stale table with a new mask.
+ */
+typedef struct ce_cpu_dispatch_s {
+    const ce_cpu_variant* variants;
+    ce_u32                count;
+    ce_atomic_u32         state;  /**< Private: (generation << 8) | (index + 1), 0 = unresolved. */
+} ce_cpu_dispatch;
+
+#define CE_CPU_DISPATCH_INIT(variants) { (variants), (ce_u32)CE_ARRAY_COUNT(variants), { 0u } }
+
+/**
+ * @brief Restricts dispatch to `allowed` features (~0u restores everything).
+ *
+ * Every ce_cpu_dispatch re-resolves at its next use, so each kernel call
+ * that starts afterwards sees the new mask; calls already running finish on
+ * the old variant. Meant for testing fallbacks and for steering a fleet away
+ * from a misbehaving ISA.
+ */
+void ce_cpu_set_mask(ce_u32 allowed);
+
+/**
+ * @brief First variant whose features are all available.
+ * @param variants Best first; the last one should need no features.
+ * @return Its table, or CE_NULL when none qualifies.
+ */
+const void* ce_cpu_select(const ce_cpu_variant* variants, ce_u32 count);
+
+/**
+ * @brief Cached ce_cpu_select() over `dispatch`'s variants.
+ *
+ * Two relaxed loads and a compare once resolved.
+ *
+ * @return The chosen table, or CE_NULL when none qualifies.
+ */
+const void* ce_cpu_dispatch_table(ce_cpu_dispatch* dispatch);
+
+/**
+ * @brief Name of one CE_CPU_* bit ("avx2", ...), "unknown" otherwise.
+ */
+const ce_char* ce_cpu_feature_name(ce_u32 feature);
+
+static inline ce_bool ce_cpu_has(ce_u32 features)
+{
+    return ((ce_cpu_features() & features) == features) ? CE_TRUE : CE_FALSE;
+}
 
 #ifdef __cplusplus
 }
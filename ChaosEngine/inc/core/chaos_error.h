@@ -15,11 +15,39 @@
 #ifndef CHAOS_ERROR_H
 #define CHAOS_ERROR_H
 
+#include "core/chaos_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* RESULT CODES                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Status code returned by every fallible engine call.
+ *
+ * CE_OK is always 0 so callers can test `if (res != CE_OK)`.
+ */
+typedef enum ce_result_e {
+    CE_OK = 0,
+    CE_ERR_INVALID_ARG,
+    CE_ERR_OUT_OF_MEMORY,
+    CE_ERR_NOT_FOUND,
+    CE_ERR_FULL,
+    CE_ERR_FORMAT,
+    CE_ERR_IO,
+    CE_ERR_UNSUPPORTED,
+    CE_ERR_COUNT
+} ce_result;
+
+/**
+ * @brief Returns a static, human-readable name for a result code.
+ * @param res Result code.
+ * @return NUL-terminated string (never CE_NULL).
+ */
+const ce_char* ce_result_str(ce_result res);
 
 #ifdef __cplusplus
 }
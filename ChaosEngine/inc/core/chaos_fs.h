@@ -15,11 +15,276 @@
 #ifndef CHAOS_FS_H
 #define CHAOS_FS_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "core/chaos_memory.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* FILE MAPPING                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Read-only view of a whole file.
+ */
+typedef struct ce_fs_mapping_s {
+    const ce_u8* data;  /**< CE_NULL for an empty file. */
+    ce_size      size;
+} ce_fs_mapping;
+
+/**
+ * @brief Maps a file read-only (pages are faulted in on first touch).
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_NOT_FOUND, CE_ERR_IO or CE_ERR_UNSUPPORTED.
+ */
+ce_result ce_fs_map(const ce_char* path, ce_fs_mapping* out_mapping);
+
+void ce_fs_unmap(ce_fs_mapping* mapping);
+
+/* ************************************************************************** */
+/* FILES                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Native read-only file handle.
+ */
+typedef struct ce_fs_file_s {
+    ce_s64 handle;
+} ce_fs_file;
+
+/**
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_NOT_FOUND or CE_ERR_IO.
+ */
+ce_result ce_fs_open(const ce_char* path, ce_fs_file* out_file);
+
+void ce_fs_close(ce_fs_file* file);
+
+ce_result ce_fs_size(ce_fs_file file, ce_u64* out_size);
+
+/**
+ * @brief Blocking positional read; retries short reads until `size` bytes or end of file.
+ * @param out_read Bytes read (may be CE_NULL).
+ * @return CE_OK when `size` bytes were read, CE_ERR_IO otherwise.
+ */
+ce_result ce_fs_read_at(ce_fs_file file, ce_u64 offset, void* dst, ce_size size, ce_size* out_read);
+
+/**
+ * @brief Reads a whole file into the arena, NUL-terminated (not counted in `out_size`).
+ *
+ * On failure the arena is rewound to where it was.
+ * @return CE_OK, a ce_fs_open() error, CE_ERR_OUT_OF_MEMORY or CE_ERR_IO.
+ */
+ce_result ce_fs_read_file(const ce_char* path, ce_arena* arena, void** out_data, ce_size* out_size);
+
+/* ************************************************************************** */
+/* ASYNC READS                                                                */
+/* ************************************************************************** */
+
+#define CE_FS_IO_MAX_WORKERS 16u
+
+typedef enum ce_fs_io_backend_e {
+    CE_FS_IO_BACKEND_AUTO = 0, /**< io_uring when the kernel allows it, else threads. */
+    CE_FS_IO_BACKEND_URING,
+    CE_FS_IO_BACKEND_THREADS   /**< Worker threads doing blocking preads. */
+} ce_fs_io_backend;
+
+/**
+ * @brief Completion callback, run on the thread calling ce_fs_io_poll() / ce_fs_io_wait().
+ * @param result CE_OK when every byte was read, CE_ERR_IO otherwise (`bytes` = what arrived).
+ */
+typedef void (*ce_fs_read_fn)(void* user, ce_result result, ce_size bytes);
+
+typedef struct ce_fs_read_request_s {
+    ce_fs_file    file;
+    ce_u64        offset;
+    void*         dst;
+    ce_size       size;
+    ce_fs_read_fn done;   /**< May be CE_NULL; may submit further requests. */
+    void*         user;
+} ce_fs_read_request;
+
+typedef struct ce_fs_io_desc_s {
+    ce_fs_io_backend backend;
+    ce_u32           queue_depth;   /**< Requests in flight (0 = 64). */
+    ce_u32           worker_count;  /**< Thread backend (0 = 4, at most CE_FS_IO_MAX_WORKERS). */
+} ce_fs_io_desc;
+
+typedef struct ce_fs_io_stats_s {
+    ce_u64 submitted;
+    ce_u64 completed;
+    ce_u64 failed;
+    ce_u64 bytes;
+    ce_u64 resubmits;      /**< Short reads continued. */
+    ce_u32 in_flight;
+    ce_u32 max_in_flight;
+} ce_fs_io_stats;
+
+/**
+ * @brief Async read queue. Submission, polling and waiting belong to one thread.
+ */
+typedef struct ce_fs_io_s ce_fs_io;
+
+ce_result ce_fs_io_create(const ce_fs_io_desc* desc, ce_fs_io** out_io);
+
+/**
+ * @brief Waits for every request in flight (running their callbacks), then releases the queue.
+ */
+void ce_fs_io_destroy(ce_fs_io* io);
+
+ce_fs_io_backend ce_fs_io_get_backend(const ce_fs_io* io);
+
+/**
+ * @brief Queues a batch with a single kernel transition on io_uring.
+ * @return CE_OK, or CE_ERR_FULL when the batch does not fit in the free
+ *         queue depth (nothing is queued then).
+ */
+ce_result ce_fs_io_submit(ce_fs_io* io, const ce_fs_read_request* requests, ce_u32 count);
+
+/**
+ * @brief Runs the callbacks of finished requests without blocking.
+ * @return Number of callbacks run.
+ */
+ce_u32 ce_fs_io_poll(ce_fs_io* io);
+
+/**
+ * @brief Blocks until nothing is in flight, running callbacks as requests finish.
+ */
+void ce_fs_io_wait(ce_fs_io* io);
+
+void ce_fs_io_get_stats(const ce_fs_io* io, ce_fs_io_stats* out_stats);
+
+/* ************************************************************************** */
+/* DIRECTORY WATCHING                                                         */
+/* ************************************************************************** */
+
+/**
+ * @brief Called once per changed file: `path` is the watched directory
+ *        joined with the path below it ("assets" + "/tex/a.png").
+ */
+typedef void (*ce_fs_change_fn)(void* user, const ce_char* path);
+
+/**
+ * @brief Recursive directory watcher (inotify on Linux).
+ *
+ * Reports files finished writing or moved into place, which covers editors
+ * saving through a temporary file. Directories created later are watched
+ * as they appear. Not thread-safe; poll from one thread.
+ */
+typedef struct ce_fs_watcher_s ce_fs_watcher;
+
+ce_result ce_fs_watcher_create(ce_fs_watcher** out_watcher);
+
+void ce_fs_watcher_destroy(ce_fs_watcher* watcher);
+
+/**
+ * @brief Watches `directory` and everything below it.
+ * @return CE_OK, CE_ERR_NOT_FOUND, CE_ERR_FULL (kernel watch limit) or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_fs_watcher_add(ce_fs_watcher* watcher, const ce_char* directory);
+
+/**
+ * @brief Reports pending changes without blocking.
+ * @return Number of callbacks made.
+ */
+ce_u32 ce_fs_watcher_poll(ce_fs_watcher* watcher, ce_fs_change_fn fn, void* user);
+
+/* ************************************************************************** */
+/* PACKED ARCHIVE FORMAT (.cpak, produced by tools/asset_packer)              */
+/* ************************************************************************** */
+
+#define CE_PAK_MAGIC   0x4B415043u /* "CPAK" little-endian */
+#define CE_PAK_VERSION 1u
+
+/** @brief Entry flag: data is one LZ4 block of `raw_size` bytes. */
+#define CE_PAK_FLAG_LZ4 0x1u
+
+/**
+ * @brief File header. Followed by entries[entry_count] sorted by hash, the
+ *        bucket index, the NUL-terminated names, then the entry data, each
+ *        entry starting on an `alignment` boundary.
+ *
+ * Names are hashed with ce_hash_str(). Bucket b covers the entries whose
+ * top `bucket_bits` hash bits equal b: entries [buckets[b], buckets[b + 1]).
+ */
+typedef struct ce_pak_header_s {
+    ce_u32 magic;
+    ce_u32 version;
+    ce_u32 entry_count;
+    ce_u32 bucket_bits;    /**< The index holds (1 << bucket_bits) + 1 u32. */
+    ce_u32 alignment;      /**< Power of two, 4096 (page) by default. */
+    ce_u32 reserved;
+    ce_u64 toc_offset;
+    ce_u64 buckets_offset;
+    ce_u64 names_offset;
+    ce_u64 names_size;
+    ce_u64 data_offset;
+} ce_pak_header;
+
+/**
+ * @brief Table-of-contents record.
+ */
+typedef struct ce_pak_entry_s {
+    ce_u64 hash;
+    ce_u64 offset;       /**< From the start of the file. */
+    ce_u64 size;         /**< Stored bytes. */
+    ce_u64 raw_size;     /**< Bytes once decompressed (== size when stored). */
+    ce_u32 name_offset;  /**< Into the names block. */
+    ce_u32 flags;
+} ce_pak_entry;
+
+CE_STATIC_ASSERT(sizeof(ce_pak_header) == 64, pak_header_must_be_64_bytes);
+CE_STATIC_ASSERT(sizeof(ce_pak_entry) == 40, pak_entry_must_be_40_bytes);
+
+/* ************************************************************************** */
+/* PACKED ARCHIVES                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Runtime view of an archive. Points into the mapping (no copy).
+ */
+typedef struct ce_pak_s {
+    ce_fs_mapping        mapping;  /**< Owned when opened from a path. */
+    const ce_pak_header* header;
+    const ce_pak_entry*  entries;
+    const ce_u32*        buckets;
+    const ce_char*       names;
+    ce_bool              owns_mapping;
+} ce_pak;
+
+/**
+ * @brief Maps and validates an archive.
+ * @return CE_OK, a ce_fs_map() error, or CE_ERR_FORMAT.
+ */
+ce_result ce_pak_open(ce_pak* pak, const ce_char* path);
+
+/**
+ * @brief Validates an archive already in memory (8-byte aligned). The blob must outlive the pak.
+ */
+ce_result ce_pak_bind(ce_pak* pak, const void* data, ce_size size);
+
+void ce_pak_close(ce_pak* pak);
+
+/**
+ * @brief O(1) expected lookup by name ('/'-separated, relative to the packed root).
+ * @return The entry, or CE_NULL.
+ */
+const ce_pak_entry* ce_pak_find(const ce_pak* pak, const ce_char* name);
+
+const ce_char* ce_pak_name(const ce_pak* pak, const ce_pak_entry* entry);
+
+/**
+ * @brief Stored bytes, in place in the mapping.
+ * @return CE_NULL for compressed entries (use ce_pak_read()).
+ */
+const void* ce_pak_data(const ce_pak* pak, const ce_pak_entry* entry);
+
+/**
+ * @brief Copies or decompresses an entry into `dst` (at least raw_size bytes).
+ * @return CE_OK, CE_ERR_INVALID_ARG (buffer too small) or CE_ERR_FORMAT.
+ */
+ce_result ce_pak_read(const ce_pak* pak, const ce_pak_entry* entry, void* dst, ce_size dst_size);
 
 #ifdef __cplusplus
 }
@@ -11,15 +11,214 @@
  * @file chaos_log.h
  * @brief Logging API.
  * @author PapaPamplemousse
+ *
+ * Each CE_LOG_* call site owns a static ce_log_site holding its format
+ * string, so a message travels as the site pointer (the format ID), a
+ * timestamp and the raw argument bytes. They are copied into a lock-free
+ * ring private to the calling thread. A writer thread formats the records
+ * and hands finished lines to the sinks, keeping printf and I/O out of the
+ * frame. When a ring is full the message is dropped and counted; the
+ * caller never blocks.
+ *
+ * Levels below CE_LOG_COMPILE_LEVEL compile to nothing (their arguments are
+ * not evaluated). Sites may be rate limited to N messages per second; the
+ * next line that gets through reports how many were suppressed.
+ *
+ * Before ce_log_init() (and after ce_log_shutdown()) messages are formatted
+ * synchronously on the caller, which suits tools and tests.
  */
 #ifndef CHAOS_LOG_H
 #define CHAOS_LOG_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "platform/chaos_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* LEVELS                                                                     */
+/* ************************************************************************** */
+
+/* Plain integers so they can be compared by the preprocessor. */
+#define CE_LOG_LEVEL_TRACE 0u
+#define CE_LOG_LEVEL_DEBUG 1u
+#define CE_LOG_LEVEL_INFO  2u
+#define CE_LOG_LEVEL_WARN  3u
+#define CE_LOG_LEVEL_ERROR 4u
+#define CE_LOG_LEVEL_FATAL 5u
+#define CE_LOG_LEVEL_OFF   6u
+
+typedef ce_u32 ce_log_level;
+
+/** @brief Calls below this level are removed at compile time. */
+#ifndef CE_LOG_COMPILE_LEVEL
+#if defined(NDEBUG)
+#define CE_LOG_COMPILE_LEVEL CE_LOG_LEVEL_INFO
+#else
+#define CE_LOG_COMPILE_LEVEL CE_LOG_LEVEL_TRACE
+#endif
+#endif
+
+#define CE_LOG_MAX_SINKS   8u
+#define CE_LOG_MAX_THREADS 64u   /**< Threads with a ring; later threads' messages are dropped. */
+#define CE_LOG_MAX_ARGS    16u   /**< Conversions per format string (a '*' counts as one). */
+#define CE_LOG_MAX_STRING  256u  /**< Bytes of a %s argument captured. */
+#define CE_LOG_MAX_LINE    1024u /**< Formatted line, truncated beyond. */
+
+/* ************************************************************************** */
+/* CALL SITES                                                                 */
+/* ************************************************************************** */
+
+/**
+ * @brief Static per-call-site record (declared by the CE_LOG_* macros).
+ */
+typedef struct ce_log_site_s {
+    ce_log_level   level;
+    ce_u32         rate;        /**< Messages per second (0 = ce_log_desc::default_rate). */
+    const ce_char* file;
+    ce_u32         line;
+    const ce_char* fmt;
+
+    /* Runtime state, zero-initialized. */
+    ce_atomic_u32  parsed;      /**< 2 once `args` describes `fmt`. */
+    ce_u32         arg_count;
+    ce_u8          args[CE_LOG_MAX_ARGS];
+    ce_atomic_u64  window_ns;   /**< Start of the current one-second window. */
+    ce_atomic_u32  in_window;
+    ce_atomic_u32  suppressed;
+} ce_log_site;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CE__LOG_PRINTF(f, a) __attribute__((format(printf, f, a)))
+#else
+#define CE__LOG_PRINTF(f, a)
+#endif
+
+/**
+ * @brief Hot path behind the macros: captures the arguments of `site`.
+ *
+ * `fmt` must be site->fmt; it is repeated so the compiler checks the
+ * arguments against it.
+ */
+void ce_log_write(ce_log_site* site, const ce_char* fmt, ...) CE__LOG_PRINTF(2, 3);
+
+/** @brief Runtime minimum level (internal; use ce_log_set_level()). */
+extern ce_atomic_u32 ce__log_level;
+
+/* First variadic argument, without the "at least one argument" pedantry. */
+#define CE__LOG_FMT(...)       CE__LOG_FMT_(__VA_ARGS__, 0)
+#define CE__LOG_FMT_(fmt, ...) fmt
+
+#define CE__LOG_SITE(lvl, per_second, ...)                                                                  \
+    do {                                                                                                    \
+        static ce_log_site ce__log_site = { .level = (lvl), .rate = (per_second), .file = __FILE__,         \
+                                            .line = (ce_u32)__LINE__, .fmt = CE__LOG_FMT(__VA_ARGS__) };    \
+        if (((lvl) >= CE_LOG_COMPILE_LEVEL) && ((lvl) >= ce_atomic_load_relaxed_u32(&ce__log_level))) {     \
+            ce_log_write(&ce__log_site, __VA_ARGS__);                                                       \
+        }                                                                                                   \
+    } while (0)
+
+/** @brief Logs at a constant `level`: CE_LOG(CE_LOG_LEVEL_INFO, "x=%d", x). */
+#define CE_LOG(level, ...)                 CE__LOG_SITE((level), 0u, __VA_ARGS__)
+/** @brief Same, at most `per_second` messages per second from this site. */
+#define CE_LOG_RATE(level, per_second, ...) CE__LOG_SITE((level), (per_second), __VA_ARGS__)
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_TRACE
+#define CE_LOG_TRACE(...) CE__LOG_SITE(CE_LOG_LEVEL_TRACE, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_TRACE(...) ((void)0)
+#endif
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_DEBUG
+#define CE_LOG_DEBUG(...) CE__LOG_SITE(CE_LOG_LEVEL_DEBUG, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_INFO
+#define CE_LOG_INFO(...) CE__LOG_SITE(CE_LOG_LEVEL_INFO, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_INFO(...) ((void)0)
+#endif
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_WARN
+#define CE_LOG_WARN(...) CE__LOG_SITE(CE_LOG_LEVEL_WARN, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_WARN(...) ((void)0)
+#endif
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_ERROR
+#define CE_LOG_ERROR(...) CE__LOG_SITE(CE_LOG_LEVEL_ERROR, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_ERROR(...) ((void)0)
+#endif
+
+#if CE_LOG_COMPILE_LEVEL <= CE_LOG_LEVEL_FATAL
+#define CE_LOG_FATAL(...) CE__LOG_SITE(CE_LOG_LEVEL_FATAL, 0u, __VA_ARGS__)
+#else
+#define CE_LOG_FATAL(...) ((void)0)
+#endif
+
+/* ************************************************************************** */
+/* LOGGER                                                                     */
+/* ************************************************************************** */
+
+/**
+ * @brief Receives one formatted line (newline included, not NUL-counted).
+ *
+ * Called on the writer thread, or on the logging thread in synchronous mode.
+ */
+typedef void (*ce_log_sink_fn)(void* user, ce_log_level level, const ce_char* line, ce_size length);
+
+typedef struct ce_log_desc_s {
+    ce_u32       ring_bytes;   /**< Per-thread ring, rounded up to a power of two (0 = 64 KiB). */
+    ce_u32       flush_ms;     /**< Writer wake-up period (0 = 5). */
+    ce_log_level level;        /**< Runtime minimum level. */
+    ce_u32       default_rate; /**< Per-site limit for sites without one (0 = unlimited). */
+} ce_log_desc;
+
+typedef struct ce_log_stats_s {
+    ce_u64 written;    /**< Lines handed to the sinks. */
+    ce_u64 dropped;    /**< Ring full or too many threads. */
+    ce_u64 suppressed; /**< Rate limited. */
+} ce_log_stats;
+
+/**
+ * @brief Starts the writer thread.
+ * @return CE_OK, CE_ERR_INVALID_ARG (already running) or a thread error.
+ */
+ce_result ce_log_init(const ce_log_desc* desc);
+
+/**
+ * @brief Writes every pending message and stops the writer.
+ *
+ * Other threads must have stopped logging.
+ */
+void ce_log_shutdown(void);
+
+/**
+ * @brief Adds a sink (stderr is used while none is registered).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FULL.
+ */
+ce_result ce_log_add_sink(ce_log_sink_fn fn, void* user);
+
+void ce_log_set_level(ce_log_level level);
+
+/**
+ * @brief Blocks until every message logged before the call is written.
+ */
+void ce_log_flush(void);
+
+void ce_log_get_stats(ce_log_stats* out_stats);
+
+/** @brief Sink writing to stderr (`user` unused). */
+void ce_log_sink_stderr(void* user, ce_log_level level, const ce_char* line, ce_size length);
+
+/** @brief Sink appending to a stdio FILE* passed as `user`. */
+void ce_log_sink_file(void* user, ce_log_level level, const ce_char* line, ce_size length);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,200 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_math.h
+ * @brief Float vector / matrix math with SoA batch transforms.
+ * @author PapaPamplemousse
+ *
+ * Matrices are column-major (m[col * 4 + row]) and multiply column vectors,
+ * matching the clip-space convention of the GL3 and software backends.
+ * ce_mat4 in chaos_types.h stays the double-precision storage type; this
+ * header is the float path used by rendering and simulation.
+ */
+#ifndef CHAOS_MATH_H
+#define CHAOS_MATH_H
+
+#include "core/chaos_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CE_PI_F 3.14159265358979323846f
+
+/* ************************************************************************** */
+/* TYPES                                                                      */
+/* ************************************************************************** */
+
+typedef struct ce_vec2f_s {
+    ce_f32 x;
+    ce_f32 y;
+} ce_vec2f;
+
+typedef struct ce_vec3f_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+} ce_vec3f;
+
+typedef struct ce_vec4f_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+    ce_f32 w;
+} ce_vec4f;
+
+/** @brief Rotation quaternion (x, y, z = axis * sin(a/2), w = cos(a/2)). */
+typedef struct ce_quatf_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+    ce_f32 w;
+} ce_quatf;
+
+typedef struct ce_mat4f_s {
+    _Alignas(16) ce_f32 m[16];
+} ce_mat4f;
+
+/* ************************************************************************** */
+/* VEC3 / VEC4                                                                */
+/* ************************************************************************** */
+
+static inline ce_vec3f ce_vec3f_make(ce_f32 x, ce_f32 y, ce_f32 z)
+{
+    ce_vec3f r;
+    r.x = x;
+    r.y = y;
+    r.z = z;
+    return r;
+}
+
+static inline ce_vec3f ce_vec3f_add(ce_vec3f a, ce_vec3f b)
+{
+    return ce_vec3f_make(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+static inline ce_vec3f ce_vec3f_sub(ce_vec3f a, ce_vec3f b)
+{
+    return ce_vec3f_make(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+static inline ce_vec3f ce_vec3f_scale(ce_vec3f a, ce_f32 s)
+{
+    return ce_vec3f_make(a.x * s, a.y * s, a.z * s);
+}
+
+static inline ce_f32 ce_vec3f_dot(ce_vec3f a, ce_vec3f b)
+{
+    return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+}
+
+static inline ce_vec3f ce_vec3f_cross(ce_vec3f a, ce_vec3f b)
+{
+    return ce_vec3f_make((a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z), (a.x * b.y) - (a.y * b.x));
+}
+
+/** @brief Unit-length copy of `a` (returns `a` unchanged when its length is 0). */
+ce_vec3f ce_vec3f_normalize(ce_vec3f a);
+
+ce_f32 ce_vec3f_length(ce_vec3f a);
+
+static inline ce_vec4f ce_vec4f_make(ce_f32 x, ce_f32 y, ce_f32 z, ce_f32 w)
+{
+    ce_vec4f r;
+    r.x = x;
+    r.y = y;
+    r.z = z;
+    r.w = w;
+    return r;
+}
+
+static inline ce_f32 ce_vec4f_dot(ce_vec4f a, ce_vec4f b)
+{
+    return (a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w);
+}
+
+/* ************************************************************************** */
+/* QUATERNIONS                                                                */
+/* ************************************************************************** */
+
+static inline ce_quatf ce_quatf_identity(void)
+{
+    ce_quatf q;
+    q.x = 0.0f;
+    q.y = 0.0f;
+    q.z = 0.0f;
+    q.w = 1.0f;
+    return q;
+}
+
+/** @brief Rotation of `radians` around a unit `axis`. */
+ce_quatf ce_quatf_axis_angle(ce_vec3f axis, ce_f32 radians);
+
+/** @brief Hamilton product (apply b, then a). */
+ce_quatf ce_quatf_mul(ce_quatf a, ce_quatf b);
+
+/* ************************************************************************** */
+/* MAT4                                                                       */
+/* ************************************************************************** */
+
+void ce_mat4f_identity(ce_mat4f* out);
+
+/** @brief out = a * b (out may alias a or b). */
+void ce_mat4f_mul(ce_mat4f* out, const ce_mat4f* a, const ce_mat4f* b);
+
+void ce_mat4f_translation(ce_mat4f* out, ce_vec3f t);
+
+void ce_mat4f_scaling(ce_mat4f* out, ce_vec3f s);
+
+/** @brief Rotation of `radians` around a unit `axis`. */
+void ce_mat4f_rotation(ce_mat4f* out, ce_vec3f axis, ce_f32 radians);
+
+/** @brief Translation * rotation * scale. */
+void ce_mat4f_from_trs(ce_mat4f* out, ce_vec3f t, ce_quatf r, ce_vec3f s);
+
+/**
+ * @brief Right-handed perspective projection, clip z in [-w, w].
+ * @param fov_y Vertical field of view, radians.
+ */
+void ce_mat4f_perspective(ce_mat4f* out, ce_f32 fov_y, ce_f32 aspect, ce_f32 z_near, ce_f32 z_far);
+
+/** @brief Right-handed view matrix looking from `eye` towards `target`. */
+void ce_mat4f_look_at(ce_mat4f* out, ce_vec3f eye, ce_vec3f target, ce_vec3f up);
+
+/** @brief out = m * v. */
+ce_vec4f ce_mat4f_transform(const ce_mat4f* m, ce_vec4f v);
+
+/* ************************************************************************** */
+/* SOA BATCH TRANSFORMS                                                       */
+/* ************************************************************************** */
+
+/**
+ * @brief Transforms points (w = 1) stored as SoA streams, 8 per SIMD step.
+ * @param m Matrix.
+ * @param x Input streams (count elements each).
+ * @param y
+ * @param z
+ * @param out_x Output streams; out_w may be CE_NULL for affine matrices.
+ * @param out_y
+ * @param out_z
+ * @param out_w
+ * @param count Number of points. Inputs/outputs are read/written in groups
+ *              of 8, so streams must be padded to CE_ALIGN_UP(count, 8).
+ */
+void ce_mat4f_transform_points_soa(const ce_mat4f* m,
+                                   const ce_f32* x, const ce_f32* y, const ce_f32* z,
+                                   ce_f32* out_x, ce_f32* out_y, ce_f32* out_z, ce_f32* out_w,
+                                   ce_u32 count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_MATH_H */
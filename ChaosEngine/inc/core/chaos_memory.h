@@ -9,17 +9,296 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_memory.h
- * @brief Allocators (arena/pool) public API.
+ * @brief Allocators (heap/arena/pool) public API.
  * @author PapaPamplemousse
+ *
+ * Built with CE_MEM_TRACKING, every allocator reports to a central tracker:
+ * per-tag live and peak bytes, allocations per frame, size histograms,
+ * budgets, and a table of allocation callsites. The allocating macros
+ * below then record __FILE__ / __LINE__ of each call. Without the flag
+ * the allocators carry no bookkeeping and the tracker reads all zeros.
  */
 #ifndef CHAOS_MEMORY_H
 #define CHAOS_MEMORY_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* MEMORY TAGS                                                                */
+/* ************************************************************************** */
+
+/**
+ * @brief Subsystem owning an allocation (used for accounting).
+ */
+typedef enum ce_mem_tag_e {
+    CE_MEM_TAG_GENERAL = 0,
+    CE_MEM_TAG_CORE,
+    CE_MEM_TAG_GFX,
+    CE_MEM_TAG_AUDIO,
+    CE_MEM_TAG_PHYSICS,
+    CE_MEM_TAG_ASSETS,
+    CE_MEM_TAG_RUNTIME,
+    CE_MEM_TAG_COUNT
+} ce_mem_tag;
+
+/** @brief Default alignment of heap blocks (covers every scalar and SIMD type). */
+#define CE_MEM_DEFAULT_ALIGN ((ce_size)16)
+
+/* ************************************************************************** */
+/* GENERAL HEAP                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Allocates an aligned block from the general heap.
+ * @param size Number of bytes (0 returns CE_NULL).
+ * @param align Power-of-two alignment (0 selects CE_MEM_DEFAULT_ALIGN).
+ * @param tag Owning subsystem.
+ * @return Pointer to the block, or CE_NULL on failure.
+ */
+void* ce_mem_alloc(ce_size size, ce_size align, ce_mem_tag tag);
+
+/**
+ * @brief Allocates a zero-filled block from the general heap.
+ * @param size Number of bytes.
+ * @param align Power-of-two alignment (0 selects CE_MEM_DEFAULT_ALIGN).
+ * @param tag Owning subsystem.
+ * @return Pointer to the block, or CE_NULL on failure.
+ */
+void* ce_mem_calloc(ce_size size, ce_size align, ce_mem_tag tag);
+
+/**
+ * @brief Resizes a heap block, preserving its alignment and tag.
+ * @param ptr Block from ce_mem_alloc (CE_NULL behaves like ce_mem_alloc).
+ * @param size New size in bytes.
+ * @param align Alignment used when ptr is CE_NULL.
+ * @param tag Tag used when ptr is CE_NULL.
+ * @return Pointer to the resized block, or CE_NULL on failure (ptr stays valid).
+ */
+void* ce_mem_realloc(void* ptr, ce_size size, ce_size align, ce_mem_tag tag);
+
+/**
+ * @brief Releases a heap block (CE_NULL is ignored).
+ * @param ptr Block from ce_mem_alloc/ce_mem_calloc/ce_mem_realloc.
+ */
+void ce_mem_free(void* ptr);
+
+/**
+ * @brief Returns the usable size of a heap block.
+ * @param ptr Block from the heap (CE_NULL returns 0).
+ * @return Size requested at allocation time.
+ */
+ce_size ce_mem_size(const void* ptr);
+
+/* ************************************************************************** */
+/* ARENA (LINEAR) ALLOCATOR                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Bump allocator over one contiguous block; freed all at once.
+ */
+typedef struct ce_arena_s {
+    ce_u8*     base;
+    ce_size    size;
+    ce_size    offset;
+    ce_size    peak;    /**< Highest offset reached since init. */
+    ce_bool    owns;    /**< CE_TRUE when `base` came from the heap. */
+    ce_mem_tag tag;
+} ce_arena;
+
+/**
+ * @brief Creates an arena backed by a heap block of `size` bytes.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_arena_init(ce_arena* arena, ce_size size, ce_mem_tag tag);
+
+/**
+ * @brief Creates an arena over caller-owned memory (never freed by the arena).
+ */
+void ce_arena_init_buffer(ce_arena* arena, void* buffer, ce_size size, ce_mem_tag tag);
+
+/**
+ * @brief Releases the backing block if the arena owns it.
+ */
+void ce_arena_shutdown(ce_arena* arena);
+
+/**
+ * @brief Bumps an aligned block out of the arena.
+ * @param align Power-of-two alignment (0 selects CE_MEM_DEFAULT_ALIGN).
+ * @return Pointer, or CE_NULL when the arena is exhausted.
+ */
+void* ce_arena_alloc(ce_arena* arena, ce_size size, ce_size align);
+
+/**
+ * @brief Frees every allocation at once.
+ */
+void ce_arena_reset(ce_arena* arena);
+
+/**
+ * @brief Current offset, to be passed to ce_arena_rewind() later.
+ */
+ce_size ce_arena_mark(const ce_arena* arena);
+
+/**
+ * @brief Frees every allocation made after `mark`.
+ */
+void ce_arena_rewind(ce_arena* arena, ce_size mark);
+
+/* ************************************************************************** */
+/* POOL (FIXED-SIZE) ALLOCATOR                                                */
+/* ************************************************************************** */
+
+/**
+ * @brief Fixed-size blocks from one heap block, recycled through a free list.
+ */
+typedef struct ce_pool_s {
+    ce_u8*     base;
+    void*      free_list;   /**< Each free block starts with the next one's address. */
+    ce_size    block_size;  /**< Requested size rounded up to the alignment. */
+    ce_u32     capacity;
+    ce_u32     used;
+    ce_u32     peak;
+    ce_mem_tag tag;
+} ce_pool;
+
+/**
+ * @brief Creates a pool of `block_count` blocks of at least `block_size` bytes.
+ * @param align Power-of-two block alignment (0 selects CE_MEM_DEFAULT_ALIGN).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_pool_init(ce_pool* pool, ce_size block_size, ce_u32 block_count, ce_size align, ce_mem_tag tag);
+
+/**
+ * @brief Releases the backing block; outstanding blocks become invalid.
+ */
+void ce_pool_shutdown(ce_pool* pool);
+
+/**
+ * @return A block, or CE_NULL when every block is in use.
+ */
+void* ce_pool_alloc(ce_pool* pool);
+
+/**
+ * @brief Returns a block obtained from this pool (CE_NULL is ignored).
+ */
+void ce_pool_free(ce_pool* pool, void* ptr);
+
+/* ************************************************************************** */
+/* TRACKING                                                                   */
+/* ************************************************************************** */
+
+#define CE_MEM_MAX_SITES    1024u /**< Distinct callsites; later ones share site 0. */
+#define CE_MEM_SIZE_CLASSES 16u   /**< Class i holds sizes up to 16 << i bytes; the last takes the rest. */
+
+/**
+ * @brief Per-tag counters.
+ *
+ * Arena and pool backing blocks come from the heap, so they are part of
+ * live_bytes; arena_bytes and pool_bytes say how much of them is in use.
+ */
+typedef struct ce_mem_tag_stats_s {
+    ce_u64 live_bytes;
+    ce_u64 peak_bytes;
+    ce_u64 live_blocks;
+    ce_u64 allocs;         /**< Heap allocations since start. */
+    ce_u64 frees;
+    ce_u64 frame_allocs;   /**< Heap allocations during the last completed frame. */
+    ce_u64 frame_bytes;
+    ce_u64 arena_bytes;
+    ce_u64 pool_bytes;
+    ce_u64 budget_bytes;   /**< 0 = no budget. */
+    ce_u64 size_histogram[CE_MEM_SIZE_CLASSES];
+} ce_mem_tag_stats;
+
+/**
+ * @brief One allocating line of code (site 0 gathers untracked calls and overflow).
+ */
+typedef struct ce_mem_site_stats_s {
+    const ce_char* file;   /**< CE_NULL for site 0. */
+    ce_u32         line;
+    ce_mem_tag     tag;    /**< Tag of the first allocation seen there. */
+    ce_u64         live_bytes;
+    ce_u64         peak_bytes;
+    ce_u64         live_blocks;
+    ce_u64         allocs;
+    ce_u64         total_bytes;
+} ce_mem_site_stats;
+
+/** @brief Budget alert, raised from ce_mem_track_frame() once per crossing. */
+typedef void (*ce_mem_budget_fn)(void* user, ce_mem_tag tag, ce_u64 live_bytes, ce_u64 budget_bytes);
+
+/**
+ * @brief CE_TRUE when the engine was built with CE_MEM_TRACKING.
+ */
+ce_bool ce_mem_tracking_enabled(void);
+
+/**
+ * @brief Lower-case tag name ("gfx", "audio", ...).
+ */
+const ce_char* ce_mem_tag_name(ce_mem_tag tag);
+
+/**
+ * @brief Live heap bytes above which `tag` raises an alert (0 removes the budget).
+ */
+void ce_mem_set_budget(ce_mem_tag tag, ce_u64 bytes);
+
+/**
+ * @brief Replaces the alert handler (CE_NULL logs a warning instead).
+ */
+void ce_mem_set_budget_callback(ce_mem_budget_fn fn, void* user);
+
+/**
+ * @brief Closes a frame: latches the per-frame rates and raises budget alerts.
+ *
+ * Call once per frame from one thread; alerts run on that thread, never
+ * inside an allocation.
+ */
+void ce_mem_track_frame(void);
+
+void ce_mem_get_tag_stats(ce_mem_tag tag, ce_mem_tag_stats* out_stats);
+
+/**
+ * @brief Callsites ordered by live bytes, largest first.
+ * @return Sites written (at most `max_sites`).
+ */
+ce_u32 ce_mem_get_top_sites(ce_mem_site_stats* out_sites, ce_u32 max_sites);
+
+/* ************************************************************************** */
+/* CALLSITES                                                                  */
+/* ************************************************************************** */
+
+/*
+ * The *_at variants take the callsite explicitly; wrappers that allocate on
+ * behalf of their caller pass their own caller's site through. The plain
+ * names record no site.
+ */
+void*     ce_mem_alloc_at(ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file, ce_u32 line);
+void*     ce_mem_calloc_at(ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file, ce_u32 line);
+void*     ce_mem_realloc_at(void* ptr, ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file,
+                            ce_u32 line);
+ce_result ce_arena_init_at(ce_arena* arena, ce_size size, ce_mem_tag tag, const ce_char* file, ce_u32 line);
+ce_result ce_pool_init_at(ce_pool* pool, ce_size block_size, ce_u32 block_count, ce_size align, ce_mem_tag tag,
+                          const ce_char* file, ce_u32 line);
+
+/* Allocator-to-tracker hooks (internal). */
+ce_u32 ce__mem_track_alloc(ce_mem_tag tag, ce_size size, const ce_char* file, ce_u32 line);
+void   ce__mem_track_release(ce_mem_tag tag, ce_u32 site, ce_size size, ce_bool whole_block);
+void   ce__mem_track_arena(ce_mem_tag tag, ce_s64 delta);
+void   ce__mem_track_pool(ce_mem_tag tag, ce_s64 delta);
+
+#if defined(CE_MEM_TRACKING) && !defined(CE__MEM_IMPLEMENTATION)
+#define ce_mem_alloc(size, align, tag)   ce_mem_alloc_at((size), (align), (tag), __FILE__, (ce_u32)__LINE__)
+#define ce_mem_calloc(size, align, tag)  ce_mem_calloc_at((size), (align), (tag), __FILE__, (ce_u32)__LINE__)
+#define ce_mem_realloc(ptr, size, align, tag) \
+    ce_mem_realloc_at((ptr), (size), (align), (tag), __FILE__, (ce_u32)__LINE__)
+#define ce_arena_init(arena, size, tag)  ce_arena_init_at((arena), (size), (tag), __FILE__, (ce_u32)__LINE__)
+#define ce_pool_init(pool, block_size, block_count, align, tag) \
+    ce_pool_init_at((pool), (block_size), (block_count), (align), (tag), __FILE__, (ce_u32)__LINE__)
+#endif
 
 #ifdef __cplusplus
 }
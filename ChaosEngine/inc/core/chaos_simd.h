@@ -0,0 +1,489 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_simd.h
+ * @brief Portable 8-wide float SIMD wrapper (SSE2 / NEON / scalar).
+ * @author PapaPamplemousse
+ *
+ * ce_f32x8 always holds 8 lanes so kernels are written once; each backend
+ * maps it onto whatever registers the target has. Comparisons return lane
+ * masks (all bits set or clear) usable with and/or/select/movemask.
+ */
+#ifndef CHAOS_SIMD_H
+#define CHAOS_SIMD_H
+
+#include "core/chaos_types.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define CE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define CE_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define CE_SIMD_SCALAR 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CE_SIMD_WIDTH 8u
+
+/* ************************************************************************** */
+/* TYPE                                                                       */
+/* ************************************************************************** */
+
+#if defined(CE_SIMD_SSE2)
+typedef struct ce_f32x8_s {
+    __m128 lo;
+    __m128 hi;
+} ce_f32x8;
+#elif defined(CE_SIMD_NEON)
+typedef struct ce_f32x8_s {
+    float32x4_t lo;
+    float32x4_t hi;
+} ce_f32x8;
+#else
+typedef struct ce_f32x8_s {
+    ce_f32 v[8];
+} ce_f32x8;
+#endif
+
+/* ************************************************************************** */
+/* SSE2                                                                       */
+/* ************************************************************************** */
+#if defined(CE_SIMD_SSE2)
+
+static inline ce_f32x8 ce_f32x8_load(const ce_f32* p)
+{
+    ce_f32x8 r;
+    r.lo = _mm_loadu_ps(p);
+    r.hi = _mm_loadu_ps(p + 4);
+    return r;
+}
+
+static inline void ce_f32x8_store(ce_f32* p, ce_f32x8 a)
+{
+    _mm_storeu_ps(p, a.lo);
+    _mm_storeu_ps(p + 4, a.hi);
+}
+
+static inline ce_f32x8 ce_f32x8_set1(ce_f32 v)
+{
+    ce_f32x8 r;
+    r.lo = _mm_set1_ps(v);
+    r.hi = r.lo;
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_add(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_add_ps(a.lo, b.lo);
+    r.hi = _mm_add_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_sub(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_sub_ps(a.lo, b.lo);
+    r.hi = _mm_sub_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_mul(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_mul_ps(a.lo, b.lo);
+    r.hi = _mm_mul_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_div(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_div_ps(a.lo, b.lo);
+    r.hi = _mm_div_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_min(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_min_ps(a.lo, b.lo);
+    r.hi = _mm_min_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_max(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_max_ps(a.lo, b.lo);
+    r.hi = _mm_max_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_cmplt(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_cmplt_ps(a.lo, b.lo);
+    r.hi = _mm_cmplt_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_cmple(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_cmple_ps(a.lo, b.lo);
+    r.hi = _mm_cmple_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_and(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_and_ps(a.lo, b.lo);
+    r.hi = _mm_and_ps(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_or(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_or_ps(a.lo, b.lo);
+    r.hi = _mm_or_ps(a.hi, b.hi);
+    return r;
+}
+
+/** @brief Per lane: mask ? a : b. */
+static inline ce_f32x8 ce_f32x8_select(ce_f32x8 mask, ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = _mm_or_ps(_mm_and_ps(mask.lo, a.lo), _mm_andnot_ps(mask.lo, b.lo));
+    r.hi = _mm_or_ps(_mm_and_ps(mask.hi, a.hi), _mm_andnot_ps(mask.hi, b.hi));
+    return r;
+}
+
+/** @brief Bit i set when lane i's sign bit (mask) is set. */
+static inline ce_u32 ce_f32x8_movemask(ce_f32x8 mask)
+{
+    return (ce_u32)_mm_movemask_ps(mask.lo) | ((ce_u32)_mm_movemask_ps(mask.hi) << 4);
+}
+
+/* ************************************************************************** */
+/* NEON                                                                       */
+/* ************************************************************************** */
+#elif defined(CE_SIMD_NEON)
+
+static inline ce_f32x8 ce_f32x8_load(const ce_f32* p)
+{
+    ce_f32x8 r;
+    r.lo = vld1q_f32(p);
+    r.hi = vld1q_f32(p + 4);
+    return r;
+}
+
+static inline void ce_f32x8_store(ce_f32* p, ce_f32x8 a)
+{
+    vst1q_f32(p, a.lo);
+    vst1q_f32(p + 4, a.hi);
+}
+
+static inline ce_f32x8 ce_f32x8_set1(ce_f32 v)
+{
+    ce_f32x8 r;
+    r.lo = vdupq_n_f32(v);
+    r.hi = r.lo;
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_add(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vaddq_f32(a.lo, b.lo);
+    r.hi = vaddq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_sub(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vsubq_f32(a.lo, b.lo);
+    r.hi = vsubq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_mul(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vmulq_f32(a.lo, b.lo);
+    r.hi = vmulq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_div(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vdivq_f32(a.lo, b.lo);
+    r.hi = vdivq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_min(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vminq_f32(a.lo, b.lo);
+    r.hi = vminq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_max(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vmaxq_f32(a.lo, b.lo);
+    r.hi = vmaxq_f32(a.hi, b.hi);
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_cmplt(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vreinterpretq_f32_u32(vcltq_f32(a.lo, b.lo));
+    r.hi = vreinterpretq_f32_u32(vcltq_f32(a.hi, b.hi));
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_cmple(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vreinterpretq_f32_u32(vcleq_f32(a.lo, b.lo));
+    r.hi = vreinterpretq_f32_u32(vcleq_f32(a.hi, b.hi));
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_and(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.lo), vreinterpretq_u32_f32(b.lo)));
+    r.hi = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.hi), vreinterpretq_u32_f32(b.hi)));
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_or(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.lo), vreinterpretq_u32_f32(b.lo)));
+    r.hi = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.hi), vreinterpretq_u32_f32(b.hi)));
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_select(ce_f32x8 mask, ce_f32x8 a, ce_f32x8 b)
+{
+    ce_f32x8 r;
+    r.lo = vbslq_f32(vreinterpretq_u32_f32(mask.lo), a.lo, b.lo);
+    r.hi = vbslq_f32(vreinterpretq_u32_f32(mask.hi), a.hi, b.hi);
+    return r;
+}
+
+static inline ce_u32 ce_f32x8_movemask(ce_f32x8 mask)
+{
+    static const ce_u32 weights_lo[4] = { 1u, 2u, 4u, 8u };
+    static const ce_u32 weights_hi[4] = { 16u, 32u, 64u, 128u };
+    uint32x4_t lo;
+    uint32x4_t hi;
+
+    lo = vandq_u32(vshrq_n_u32(vreinterpretq_u32_f32(mask.lo), 31), vdupq_n_u32(1u));
+    hi = vandq_u32(vshrq_n_u32(vreinterpretq_u32_f32(mask.hi), 31), vdupq_n_u32(1u));
+
+    return vaddvq_u32(vmulq_u32(lo, vld1q_u32(weights_lo))) + vaddvq_u32(vmulq_u32(hi, vld1q_u32(weights_hi)));
+}
+
+/* ************************************************************************** */
+/* SCALAR FALLBACK                                                            */
+/* ************************************************************************** */
+#else
+
+static inline ce_f32x8 ce_f32x8_load(const ce_f32* p)
+{
+    ce_f32x8 r;
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { r.v[i] = p[i]; }
+    return r;
+}
+
+static inline void ce_f32x8_store(ce_f32* p, ce_f32x8 a)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { p[i] = a.v[i]; }
+}
+
+static inline ce_f32x8 ce_f32x8_set1(ce_f32 v)
+{
+    ce_f32x8 r;
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { r.v[i] = v; }
+    return r;
+}
+
+static inline ce_f32x8 ce_f32x8_add(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] += b.v[i]; }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_sub(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] -= b.v[i]; }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_mul(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] *= b.v[i]; }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_div(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] /= b.v[i]; }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_min(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = (a.v[i] < b.v[i]) ? a.v[i] : b.v[i]; }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_max(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = (a.v[i] > b.v[i]) ? a.v[i] : b.v[i]; }
+    return a;
+}
+
+/* Masks are stored as floats whose bit pattern is all ones / all zeros. */
+static inline ce_f32 ce__f32x8_mask_lane(ce_bool on)
+{
+    union { ce_u32 u; ce_f32 f; } bits;
+    bits.u = (on == CE_TRUE) ? 0xFFFFFFFFu : 0u;
+    return bits.f;
+}
+
+static inline ce_u32 ce__f32x8_bits(ce_f32 f)
+{
+    union { ce_u32 u; ce_f32 f; } bits;
+    bits.f = f;
+    return bits.u;
+}
+
+static inline ce_f32 ce__f32x8_from_bits(ce_u32 u)
+{
+    union { ce_u32 u; ce_f32 f; } bits;
+    bits.u = u;
+    return bits.f;
+}
+
+static inline ce_f32x8 ce_f32x8_cmplt(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = ce__f32x8_mask_lane((a.v[i] < b.v[i]) ? CE_TRUE : CE_FALSE); }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_cmple(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = ce__f32x8_mask_lane((a.v[i] <= b.v[i]) ? CE_TRUE : CE_FALSE); }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_and(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = ce__f32x8_from_bits(ce__f32x8_bits(a.v[i]) & ce__f32x8_bits(b.v[i])); }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_or(ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = ce__f32x8_from_bits(ce__f32x8_bits(a.v[i]) | ce__f32x8_bits(b.v[i])); }
+    return a;
+}
+
+static inline ce_f32x8 ce_f32x8_select(ce_f32x8 mask, ce_f32x8 a, ce_f32x8 b)
+{
+    ce_u32 i;
+    for (i = 0u; i < 8u; i++) { a.v[i] = ((ce__f32x8_bits(mask.v[i]) >> 31) != 0u) ? a.v[i] : b.v[i]; }
+    return a;
+}
+
+static inline ce_u32 ce_f32x8_movemask(ce_f32x8 mask)
+{
+    ce_u32 m;
+    ce_u32 i;
+    m = 0u;
+    for (i = 0u; i < 8u; i++) { m |= (ce__f32x8_bits(mask.v[i]) >> 31) << i; }
+    return m;
+}
+
+#endif
+
+/* ************************************************************************** */
+/* DERIVED OPERATIONS                                                         */
+/* ************************************************************************** */
+
+/** @brief a * b + c (not fused on every target). */
+static inline ce_f32x8 ce_f32x8_madd(ce_f32x8 a, ce_f32x8 b, ce_f32x8 c)
+{
+    return ce_f32x8_add(ce_f32x8_mul(a, b), c);
+}
+
+static inline ce_f32x8 ce_f32x8_cmpgt(ce_f32x8 a, ce_f32x8 b)
+{
+    return ce_f32x8_cmplt(b, a);
+}
+
+static inline ce_f32x8 ce_f32x8_cmpge(ce_f32x8 a, ce_f32x8 b)
+{
+    return ce_f32x8_cmple(b, a);
+}
+
+/**
+ * @brief Appends base+i to `out` for every set bit i of `mask` (branch-free).
+ * @return Number of indices written (popcount of the low 8 bits).
+ */
+static inline ce_u32 ce_simd_compact_indices(ce_u32 mask, ce_u32 base, ce_u32* out)
+{
+    ce_u32 n;
+    ce_u32 lane;
+
+    n = 0u;
+    for (lane = 0u; lane < 8u; lane++) {
+        out[n] = base + lane;
+        n += (mask >> lane) & 1u;
+    }
+
+    return n;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_SIMD_H */
@@ -11,15 +11,93 @@
  * @file chaos_time.h
  * @brief High-resolution timing API.
  * @author PapaPamplemousse
+ *
+ * Timestamps are raw ticks: the invariant TSC on x86 when the CPU has one
+ * (calibrated against CLOCK_MONOTONIC_RAW), the OS monotonic clock in
+ * nanoseconds otherwise. Reading ticks costs a few nanoseconds; hot paths
+ * (profiler zones, job timings) store ticks and convert deltas later.
  */
 #ifndef CHAOS_TIME_H
 #define CHAOS_TIME_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+#define CE_NS_PER_US 1000ull
+#define CE_NS_PER_MS 1000000ull
+#define CE_NS_PER_S  1000000000ull
+
+typedef enum ce_time_source_e {
+    CE_TIME_SOURCE_MONOTONIC = 0, /**< clock_gettime / performance counter; ticks are nanoseconds. */
+    CE_TIME_SOURCE_TSC            /**< Invariant time-stamp counter. */
+} ce_time_source;
+
+/**
+ * @brief Selects and calibrates the clock (~10 ms when the TSC is used).
+ *
+ * Runs lazily on the first timestamp otherwise; calling it at startup keeps
+ * the calibration out of the first frame. Calling it again recalibrates and
+ * must not race with other threads reading the clock.
+ *
+ * @return CE_OK (a missing TSC is not an error: the fallback is used).
+ */
+ce_result ce_time_init(void);
+
+/**
+ * @brief Forces a source, e.g. the OS clock when comparing with other processes.
+ *
+ * Safe while other threads read the clock: each source's parameters are
+ * published as one block, so a reader sees the old or the new source, never
+ * a mix. Timestamps taken across a switch are not comparable. Calls to this
+ * function must not race with each other or with ce_time_init().
+ *
+ * @return CE_OK or CE_ERR_UNSUPPORTED (no invariant TSC).
+ */
+ce_result ce_time_set_source(ce_time_source source);
+
+ce_time_source ce_time_get_source(void);
+
+/**
+ * @brief Current tick count (monotonic, consistent across cores).
+ */
+ce_u64 ce_time_ticks(void);
+
+/** @brief Calibrated tick frequency. */
+ce_u64 ce_time_ticks_per_second(void);
+
+/** @brief Converts a tick duration to nanoseconds (fixed-point, no division). */
+ce_u64 ce_time_ticks_to_ns(ce_u64 ticks);
+
+/** @brief Converts nanoseconds to a tick duration. */
+ce_u64 ce_time_ns_to_ticks(ce_u64 ns);
+
+/**
+ * @brief Monotonic time in nanoseconds (arbitrary epoch, never goes back).
+ */
+ce_u64 ce_time_now_ns(void);
+
+/**
+ * @brief Sleeps until ce_time_now_ns() >= deadline_ns.
+ *
+ * The OS sleep stops short by a margin learned from its past oversleep; the
+ * rest is spun, so wake-up lands within a few microseconds of the deadline.
+ */
+void ce_time_sleep_until_ns(ce_u64 deadline_ns);
+
+/** @brief Precise relative sleep (see ce_time_sleep_until_ns). */
+void ce_time_sleep_ns(ce_u64 ns);
+
+/**
+ * @brief Converts nanoseconds to seconds.
+ */
+static inline ce_f64 ce_time_ns_to_s(ce_u64 ns)
+{
+    return (ce_f64)ns / (ce_f64)CE_NS_PER_S;
+}
 
 #ifdef __cplusplus
 }
@@ -88,6 +88,11 @@ typedef ce_u32 ce_uptr;
  */
 typedef ce_uptr ce_size;
 
+/**
+ * @brief Null pointer constant (no <stddef.h> dependency).
+ */
+#define CE_NULL ((void*)0)
+
 /* ************************************************************************** */
 /* CHARACTER TYPE                                                             */
 /* ************************************************************************** */
@@ -15,11 +15,540 @@
 #ifndef CHAOS_DRAW_H
 #define CHAOS_DRAW_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_error.h"
+#include "core/chaos_containers.h"
+#include "core/chaos_math.h"
+#include "platform/chaos_thread.h"
+#include "gfx/chaos_gfx_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* SPRITES                                                                    */
+/* ************************************************************************** */
+
+/** @brief Texture is a single-channel signed distance field (text). */
+#define CE_SPRITE_FLAG_SDF ((ce_u16)(1u << 0))
+
+/**
+ * @brief One textured, tinted quad in screen space.
+ */
+typedef struct ce_sprite_s {
+    ce_f32        x;       /**< Top-left corner, pixels. */
+    ce_f32        y;
+    ce_f32        w;       /**< Size, pixels. */
+    ce_f32        h;
+    ce_f32        u0;      /**< Normalized texture coordinates. */
+    ce_f32        v0;
+    ce_f32        u1;
+    ce_f32        v1;
+    ce_color      color;   /**< Tint (multiplied with the texel). */
+    ce_texture_id texture;
+    ce_u16        layer;   /**< Draw order: lower layers first. */
+    ce_u16        flags;   /**< CE_SPRITE_FLAG_* */
+} ce_sprite;
+
+/* ************************************************************************** */
+/* CULLING                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Screen-space AABBs in SoA layout (one stream per component).
+ *
+ * Streams are padded to a multiple of 8 so the culling kernels can always
+ * test full SIMD groups.
+ */
+typedef struct ce_bounds2d_s {
+    ce_f32* min_x;
+    ce_f32* min_y;
+    ce_f32* max_x;
+    ce_f32* max_y;
+    ce_u32  count;
+    ce_u32  capacity;  /**< Multiple of 8. */
+} ce_bounds2d;
+
+/**
+ * @brief World-space bounding spheres in SoA layout.
+ */
+typedef struct ce_bounds3d_s {
+    ce_f32* center_x;
+    ce_f32* center_y;
+    ce_f32* center_z;
+    ce_f32* radius;
+    ce_u32  count;
+    ce_u32  capacity;  /**< Multiple of 8. */
+} ce_bounds3d;
+
+/**
+ * @brief Plane n.p + d = 0; points with n.p + d >= 0 are inside.
+ */
+typedef struct ce_plane_s {
+    ce_f32 nx;
+    ce_f32 ny;
+    ce_f32 nz;
+    ce_f32 d;
+} ce_plane;
+
+/**
+ * @brief Six normalized planes: left, right, bottom, top, near, far.
+ */
+typedef struct ce_frustum_s {
+    ce_plane planes[6];
+} ce_frustum;
+
+/** @brief Output index arrays must hold CE_CULL_OUT_CAPACITY(count) entries. */
+#define CE_CULL_OUT_CAPACITY(count) CE_ALIGN_UP((ce_u32)(count), 8u)
+
+ce_result ce_bounds2d_init(ce_bounds2d* bounds, ce_u32 capacity);
+void      ce_bounds2d_shutdown(ce_bounds2d* bounds);
+/** @brief Sets the element count (growing storage as needed; new entries are undefined). */
+ce_result ce_bounds2d_resize(ce_bounds2d* bounds, ce_u32 count);
+/** @brief Appends one box. */
+ce_result ce_bounds2d_push(ce_bounds2d* bounds, ce_f32 min_x, ce_f32 min_y, ce_f32 max_x, ce_f32 max_y);
+
+ce_result ce_bounds3d_init(ce_bounds3d* bounds, ce_u32 capacity);
+void      ce_bounds3d_shutdown(ce_bounds3d* bounds);
+ce_result ce_bounds3d_resize(ce_bounds3d* bounds, ce_u32 count);
+ce_result ce_bounds3d_push(ce_bounds3d* bounds, ce_f32 cx, ce_f32 cy, ce_f32 cz, ce_f32 radius);
+
+/**
+ * @brief Extracts normalized frustum planes from a view-projection matrix.
+ * @param frustum Receives the planes.
+ * @param m Column-major matrix (m[col * 4 + row]), clip z in [-w, w].
+ */
+void ce_frustum_from_matrix(ce_frustum* frustum, const ce_f32 m[16]);
+
+/**
+ * @brief Collects the indices of boxes overlapping `view`.
+ *
+ * Tests 8 boxes per SIMD step, spread over the job system for large sets.
+ * @param bounds Boxes to test.
+ * @param view Visible rectangle.
+ * @param out_indices Receives ascending indices; needs CE_CULL_OUT_CAPACITY(count) slots.
+ * @return Number of visible boxes.
+ */
+ce_u32 ce_cull_rect(const ce_bounds2d* bounds, const ce_rectf* view, ce_u32* out_indices);
+
+/**
+ * @brief Collects the indices of spheres intersecting `frustum`.
+ * @param bounds Spheres to test.
+ * @param frustum Normalized planes.
+ * @param out_indices Receives ascending indices; needs CE_CULL_OUT_CAPACITY(count) slots.
+ * @return Number of visible spheres.
+ */
+ce_u32 ce_cull_frustum(const ce_bounds3d* bounds, const ce_frustum* frustum, ce_u32* out_indices);
+
+/* ************************************************************************** */
+/* SPRITE BATCH                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Per-frame list of sprites consumed by the active backend.
+ *
+ * Frame flow: push sprites, ce_sprite_batch_cull() to build the compact
+ * visible index list, ce_sprite_batch_sort() to order it for submission.
+ */
+typedef struct ce_sprite_batch_s {
+    ce_dynarray sprites;  /**< ce_sprite elements. */
+    ce_bounds2d bounds;   /**< Scratch SoA boxes rebuilt by the cull pass. */
+    ce_dynarray visible;  /**< ce_u32 sprite indices surviving the cull. */
+    ce_dynarray scratch;  /**< Sort keys. */
+    ce_u32      visible_count;
+} ce_sprite_batch;
+
+/**
+ * @brief Initializes an empty batch.
+ * @param batch Batch to initialize.
+ * @param initial_capacity Sprites to reserve up front.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_sprite_batch_init(ce_sprite_batch* batch, ce_u32 initial_capacity);
+
+/**
+ * @brief Releases the batch storage.
+ */
+void ce_sprite_batch_shutdown(ce_sprite_batch* batch);
+
+/**
+ * @brief Drops every queued sprite (call once per frame).
+ */
+void ce_sprite_batch_clear(ce_sprite_batch* batch);
+
+/**
+ * @brief Appends a sprite.
+ * @return CE_OK or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_sprite_batch_push(ce_sprite_batch* batch, const ce_sprite* sprite);
+
+/**
+ * @brief Appends `count` uninitialized sprites and returns them for filling.
+ * @return Pointer to the first new sprite, or CE_NULL on failure.
+ */
+ce_sprite* ce_sprite_batch_reserve(ce_sprite_batch* batch, ce_u32 count);
+
+/**
+ * @brief Number of queued sprites.
+ */
+ce_u32 ce_sprite_batch_count(const ce_sprite_batch* batch);
+
+/**
+ * @brief Pointer to the queued sprites (valid until the next push).
+ */
+const ce_sprite* ce_sprite_batch_sprites(const ce_sprite_batch* batch);
+
+/**
+ * @brief Culls queued sprites against a screen rectangle into the visible list.
+ * @param batch Batch to cull.
+ * @param view Visible rectangle (CE_NULL keeps every sprite).
+ * @return Number of visible sprites.
+ */
+ce_u32 ce_sprite_batch_cull(ce_sprite_batch* batch, const ce_rectf* view);
+
+/**
+ * @brief Stable-sorts the visible list by (layer, texture).
+ *
+ * Submission order is kept within a (layer, texture) run, so overlapping
+ * sprites that must stay ordered should use distinct layers.
+ * @return CE_OK or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_sprite_batch_sort(ce_sprite_batch* batch);
+
+/**
+ * @brief Visible sprite indices produced by the last cull/sort.
+ * @param count Receives the number of indices.
+ */
+const ce_u32* ce_sprite_batch_visible(const ce_sprite_batch* batch, ce_u32* count);
+
+/* ************************************************************************** */
+/* BAKED FONT FORMAT (.cfnt, produced by tools/font_baker)                    */
+/* ************************************************************************** */
+
+#define CE_FONT_MAGIC   0x544E4643u /* "CFNT" little-endian */
+#define CE_FONT_VERSION 1u
+
+/**
+ * @brief File header. Followed by glyphs[glyph_count] (sorted by codepoint),
+ *        kerns[kern_count] (sorted by left then right) and the R8 atlas.
+ *
+ * All metrics are in atlas pixels at `bake_size`; y grows downwards.
+ */
+typedef struct ce_font_file_header_s {
+    ce_u32 magic;
+    ce_u32 version;
+    ce_u32 glyph_count;
+    ce_u32 kern_count;
+    ce_u16 atlas_width;
+    ce_u16 atlas_height;
+    ce_f32 bake_size;   /**< Pixel height the glyphs were rasterized at. */
+    ce_f32 sdf_spread;  /**< Distance (atlas px) covered by the 0..255 ramp. */
+    ce_f32 ascent;      /**< Baseline to top (positive). */
+    ce_f32 descent;     /**< Baseline to bottom (negative). */
+    ce_f32 line_gap;
+} ce_font_file_header;
+
+/**
+ * @brief Glyph record: atlas rectangle plus placement metrics.
+ */
+typedef struct ce_font_glyph_s {
+    ce_u32 codepoint;
+    ce_u16 x;
+    ce_u16 y;
+    ce_u16 w;
+    ce_u16 h;
+    ce_f32 xoff;     /**< Pen to bitmap left edge. */
+    ce_f32 yoff;     /**< Baseline to bitmap top edge. */
+    ce_f32 advance;  /**< Horizontal pen advance. */
+} ce_font_glyph;
+
+/**
+ * @brief Kerning pair: adjust the pen between `left` and `right`.
+ */
+typedef struct ce_font_kern_s {
+    ce_u32 left;
+    ce_u32 right;
+    ce_f32 adjust;
+} ce_font_kern;
+
+CE_STATIC_ASSERT(sizeof(ce_font_file_header) == 40, font_header_must_be_40_bytes);
+CE_STATIC_ASSERT(sizeof(ce_font_glyph) == 24, font_glyph_must_be_24_bytes);
+CE_STATIC_ASSERT(sizeof(ce_font_kern) == 12, font_kern_must_be_12_bytes);
+
+/* ************************************************************************** */
+/* FONTS                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Runtime view of a baked font. Points into the caller's blob (no copy).
+ */
+typedef struct ce_font_s {
+    const ce_font_file_header* header;
+    const ce_font_glyph*       glyphs;
+    const ce_font_kern*        kerns;
+    const ce_u8*               atlas;          /**< R8, atlas_width * atlas_height. */
+    ce_texture_id              atlas_texture;  /**< Uploaded copy of `atlas`. */
+    ce_u16                     ascii[128];     /**< Glyph index + 1 for ASCII (0 = missing). */
+    ce_u32                     fallback;       /**< Glyph index + 1 used for missing codepoints. */
+} ce_font;
+
+/**
+ * @brief Binds a font to a .cfnt blob. The blob must outlive the font.
+ * @param font Font to initialize.
+ * @param data Blob contents (4-byte aligned).
+ * @param size Blob size in bytes.
+ * @param atlas_texture Texture holding the uploaded atlas (may be set later).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FORMAT.
+ */
+ce_result ce_font_init_memory(ce_font* font, const void* data, ce_size size, ce_texture_id atlas_texture);
+
+/**
+ * @brief Looks up a glyph (falls back to '?' when the font lacks it).
+ * @return Glyph record, or CE_NULL if neither the glyph nor a fallback exists.
+ */
+const ce_font_glyph* ce_font_find_glyph(const ce_font* font, ce_u32 codepoint);
+
+/**
+ * @brief Kerning adjustment between two codepoints, in atlas pixels.
+ */
+ce_f32 ce_font_kerning(const ce_font* font, ce_u32 left, ce_u32 right);
+
+/* ************************************************************************** */
+/* TEXT LAYOUT CACHE                                                          */
+/* ************************************************************************** */
+
+/**
+ * @brief Positioned glyph quad, relative to the layout origin (top-left).
+ */
+typedef struct ce_text_quad_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 w;
+    ce_f32 h;
+    ce_f32 u0;
+    ce_f32 v0;
+    ce_f32 u1;
+    ce_f32 v1;
+} ce_text_quad;
+
+/**
+ * @brief Laid-out string at a given pixel size.
+ */
+typedef struct ce_text_layout_s {
+    ce_u64        key;            /**< Hash of (text, size); 0 for a free entry. */
+    ce_char*      text;           /**< Owned copy used to confirm cache hits. */
+    ce_u32        text_len;
+    ce_u32        text_capacity;
+    ce_f32        size;
+    ce_text_quad* quads;
+    ce_u32        quad_count;
+    ce_u32        quad_capacity;
+    ce_f32        width;          /**< Widest line, pixels. */
+    ce_f32        height;         /**< Line count * line height, pixels. */
+    ce_u32        last_used;      /**< Frame stamp for LRU eviction. */
+} ce_text_layout;
+
+/**
+ * @brief Fixed-capacity LRU cache of text layouts for one font.
+ */
+typedef struct ce_text_cache_s {
+    const ce_font*  font;
+    ce_text_layout* entries;
+    ce_u32          capacity;
+    ce_u32          count;
+    ce_hashmap      index;   /**< layout key -> entry index. */
+    ce_u32          frame;
+    ce_u32          hits;    /**< Lookups served from the cache (since init). */
+    ce_u32          misses;  /**< Lookups that required a layout pass. */
+} ce_text_cache;
+
+/**
+ * @brief Initializes a cache holding up to `capacity` layouts.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_text_cache_init(ce_text_cache* cache, const ce_font* font, ce_u32 capacity);
+
+/**
+ * @brief Releases every cached layout.
+ */
+void ce_text_cache_shutdown(ce_text_cache* cache);
+
+/**
+ * @brief Advances the LRU clock; call once per frame.
+ */
+void ce_text_cache_begin_frame(ce_text_cache* cache);
+
+/**
+ * @brief Returns the layout of a UTF-8 string, computing it on a miss.
+ * @param cache Cache to query.
+ * @param text UTF-8 string ('\n' starts a new line).
+ * @param size_px Line pixel size.
+ * @return Layout (valid until evicted), or CE_NULL on allocation failure.
+ */
+const ce_text_layout* ce_text_cache_layout(ce_text_cache* cache, const ce_char* text, ce_f32 size_px);
+
+/**
+ * @brief Lays out (cached) and emits a string as SDF sprites.
+ * @param batch Destination batch.
+ * @param cache Layout cache (selects the font and atlas).
+ * @param text UTF-8 string.
+ * @param x Left edge, pixels.
+ * @param y Top edge, pixels.
+ * @param size_px Line pixel size.
+ * @param color Text color.
+ * @param layer Sprite layer.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_draw_text(ce_sprite_batch* batch, ce_text_cache* cache, const ce_char* text,
+                       ce_f32 x, ce_f32 y, ce_f32 size_px, ce_color color, ce_u16 layer);
+
+/* ************************************************************************** */
+/* DEBUG DRAW                                                                 */
+/* ************************************************************************** */
+
+/** @brief Distinct threads that may emit debug primitives over the process lifetime. */
+#define CE_DEBUG_DRAW_MAX_THREADS 128u
+/** @brief Line segments per debug circle. */
+#define CE_DEBUG_CIRCLE_SEGMENTS  32u
+
+/** @brief Draw on top of everything instead of depth testing. */
+#define CE_DEBUG_FLAG_NO_DEPTH ((ce_u16)(1u << 0))
+
+/**
+ * @brief Line-list vertex of the merged debug stream.
+ */
+typedef struct ce_debug_vertex_s {
+    ce_f32   x;
+    ce_f32   y;
+    ce_f32   z;
+    ce_color color;
+} ce_debug_vertex;
+
+/**
+ * @brief World-space text label produced by the merge.
+ */
+typedef struct ce_debug_label_s {
+    ce_vec3f       position;
+    ce_f32         size_px;
+    ce_color       color;
+    ce_u16         flags;
+    const ce_char* text;      /**< Valid until the next ce_debug_draw_end_frame(). */
+} ce_debug_label;
+
+/**
+ * @brief Queued primitive (internal layout, shared by every shape).
+ */
+typedef struct ce_debug_prim_s {
+    ce_vec3f a;          /**< Line start / box min / circle center / text position. */
+    ce_vec3f b;          /**< Line end / box max / circle normal. */
+    ce_f32   scalar;     /**< Circle radius / text size. */
+    ce_f32   lifetime;   /**< Seconds left; 0 draws for one frame. */
+    ce_color color;
+    ce_u16   type;
+    ce_u16   flags;
+    ce_u32   text;       /**< Offset into the owning char buffer. */
+} ce_debug_prim;
+
+/**
+ * @brief Per-thread queue, only ever written by its owning thread.
+ */
+typedef struct ce_debug_buffer_s {
+    CE_CACHE_ALIGNED ce_dynarray prims;  /**< ce_debug_prim. */
+    ce_dynarray chars;                   /**< NUL-terminated label strings. */
+} ce_debug_buffer;
+
+/**
+ * @brief Immediate-mode debug draw context.
+ *
+ * Any thread may emit at any time except while ce_debug_draw_end_frame()
+ * runs: each thread appends to its own buffer (slot claimed once with an
+ * atomic counter), so emitters never contend on a lock. The frame-end merge
+ * must happen after emitting jobs have been waited on.
+ */
+typedef struct ce_debug_draw_s {
+    ce_debug_buffer threads[CE_DEBUG_DRAW_MAX_THREADS];
+    ce_dynarray     live[2];        /**< ce_debug_prim: this frame + persistent survivors. */
+    ce_dynarray     live_chars[2];
+    ce_u32          live_index;
+    ce_dynarray     vertices;       /**< ce_debug_vertex, depth-tested lines first. */
+    ce_dynarray     labels;         /**< ce_debug_label. */
+    ce_u32          depth_vertex_count;
+    ce_atomic_u32   enabled;
+    ce_atomic_u32   dropped;        /**< Primitives lost to allocation failure or slot exhaustion. */
+    ce_f32          circle[CE_DEBUG_CIRCLE_SEGMENTS][2];
+} ce_debug_draw;
+
+/**
+ * @brief Initializes an (enabled) debug draw context.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_debug_draw_init(ce_debug_draw* dd);
+
+/**
+ * @brief Releases every buffer.
+ */
+void ce_debug_draw_shutdown(ce_debug_draw* dd);
+
+/**
+ * @brief Turns emission on or off (disabled emits return immediately).
+ */
+void ce_debug_draw_set_enabled(ce_debug_draw* dd, ce_bool enabled);
+
+/**
+ * @brief Queues a segment.
+ * @param lifetime Seconds to keep drawing it (0 = this frame only).
+ * @param flags CE_DEBUG_FLAG_* bits.
+ */
+void ce_debug_line(ce_debug_draw* dd, ce_vec3f a, ce_vec3f b, ce_color color, ce_f32 lifetime, ce_u16 flags);
+
+/**
+ * @brief Queues an axis-aligned box outline.
+ */
+void ce_debug_box(ce_debug_draw* dd, ce_vec3f min, ce_vec3f max, ce_color color, ce_f32 lifetime, ce_u16 flags);
+
+/**
+ * @brief Queues a circle outline in the plane orthogonal to `normal`.
+ */
+void ce_debug_circle(ce_debug_draw* dd, ce_vec3f center, ce_vec3f normal, ce_f32 radius, ce_color color,
+                     ce_f32 lifetime, ce_u16 flags);
+
+/**
+ * @brief Queues a text label anchored at a world position (string is copied).
+ */
+void ce_debug_text(ce_debug_draw* dd, ce_vec3f position, const ce_char* text, ce_f32 size_px, ce_color color,
+                   ce_f32 lifetime, ce_u16 flags);
+
+/**
+ * @brief Merges every thread buffer and the persistent primitives into one stream.
+ *
+ * Ages persistent primitives by `dt` and drops the expired ones afterwards.
+ * Call once per frame from the render thread.
+ */
+void ce_debug_draw_end_frame(ce_debug_draw* dd, ce_f32 dt);
+
+/**
+ * @brief Line-list vertices of the last merge.
+ * @param count Receives the total vertex count.
+ * @param depth_count Receives how many leading vertices are depth-tested.
+ */
+const ce_debug_vertex* ce_debug_draw_vertices(const ce_debug_draw* dd, ce_u32* count, ce_u32* depth_count);
+
+/**
+ * @brief Labels of the last merge.
+ */
+const ce_debug_label* ce_debug_draw_labels(const ce_debug_draw* dd, ce_u32* count);
+
+/**
+ * @brief Projects the labels and emits them as text sprites.
+ * @param view_proj World to clip matrix.
+ * @param width Viewport width in pixels.
+ * @param height Viewport height in pixels.
+ * @return CE_OK or the first text error.
+ */
+ce_result ce_debug_draw_emit_labels(const ce_debug_draw* dd, ce_sprite_batch* batch, ce_text_cache* cache,
+                                    const ce_mat4f* view_proj, ce_u32 width, ce_u32 height, ce_u16 layer);
 
 #ifdef __cplusplus
 }
@@ -15,11 +15,76 @@
 #ifndef CHAOS_GFX_TYPES_H
 #define CHAOS_GFX_TYPES_H
 
+#include "core/chaos_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* COLORS                                                                     */
+/* ************************************************************************** */
+
+/**
+ * @brief Packed 8-bit RGBA color (R in the lowest byte).
+ */
+typedef ce_u32 ce_color;
+
+#define CE_RGBA(r, g, b, a) \
+    ((ce_color)(((ce_u32)(r) & 0xFFu) | (((ce_u32)(g) & 0xFFu) << 8) | \
+                (((ce_u32)(b) & 0xFFu) << 16) | (((ce_u32)(a) & 0xFFu) << 24)))
+
+#define CE_COLOR_R(c) ((ce_u8)((c) & 0xFFu))
+#define CE_COLOR_G(c) ((ce_u8)(((c) >> 8) & 0xFFu))
+#define CE_COLOR_B(c) ((ce_u8)(((c) >> 16) & 0xFFu))
+#define CE_COLOR_A(c) ((ce_u8)(((c) >> 24) & 0xFFu))
+
+#define CE_COLOR_WHITE CE_RGBA(255, 255, 255, 255)
+#define CE_COLOR_BLACK CE_RGBA(0, 0, 0, 255)
+
+/* ************************************************************************** */
+/* TEXTURES                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Backend texture identifier (0 means "no texture").
+ */
+typedef ce_u32 ce_texture_id;
+
+#define CE_TEXTURE_NONE ((ce_texture_id)0u)
+
+/**
+ * @brief Texel layouts understood by the backends.
+ */
+typedef enum ce_pixel_format_e {
+    CE_PIXEL_FORMAT_R8 = 0,  /**< Single channel (SDF atlases, masks). */
+    CE_PIXEL_FORMAT_RGBA8,
+    CE_PIXEL_FORMAT_COUNT
+} ce_pixel_format;
+
+/* ************************************************************************** */
+/* GEOMETRY                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Axis-aligned rectangle in pixels (x,y = top-left).
+ */
+typedef struct ce_rectf_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 w;
+    ce_f32 h;
+} ce_rectf;
+
+/**
+ * @brief Integer pixel rectangle, half-open: [x0, x1) x [y0, y1).
+ */
+typedef struct ce_recti_s {
+    ce_s32 x0;
+    ce_s32 y0;
+    ce_s32 x1;
+    ce_s32 y1;
+} ce_recti;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,248 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_sw_raster.h
+ * @brief Software rasterizer: depth-buffered triangles with hierarchical-Z.
+ * @author PapaPamplemousse
+ *
+ * Renders into plain memory, so the 3D path runs headless (tests, servers,
+ * perf runs) and feeds the SW window backend when one is present.
+ */
+#ifndef CHAOS_SW_RASTER_H
+#define CHAOS_SW_RASTER_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "core/chaos_math.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_containers.h"
+#include "gfx/chaos_gfx_types.h"
+#include "gfx/chaos_draw.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Hierarchical-Z tile edge in pixels (one SIMD row per tile row). */
+#define CE_SW_TILE 8u
+
+/**
+ * @brief Counters accumulated since the last ce_sw_target_reset_stats().
+ */
+typedef struct ce_sw_stats_s {
+    ce_u64 triangles_submitted;
+    ce_u64 triangles_culled;      /**< Back-facing, degenerate or outside the frustum. */
+    ce_u64 triangles_clipped;     /**< Crossed a frustum plane and were clipped. */
+    ce_u64 triangles_rasterized;  /**< Reached the tile loop (after clipping). */
+    ce_u64 tiles_tested;
+    ce_u64 tiles_hiz_rejected;    /**< Skipped because the tile was already nearer. */
+    ce_u64 pixels_written;
+} ce_sw_stats;
+
+/**
+ * @brief Color + depth render target with a per-tile max-depth pyramid level.
+ */
+typedef struct ce_sw_target_s {
+    ce_color*   color;     /**< stride * padded height pixels. */
+    ce_f32*     depth;     /**< 0 = near plane, 1 = far plane. */
+    ce_f32*     hiz;       /**< Farthest depth per tile (tiles_x * tiles_y). */
+    ce_u32      width;
+    ce_u32      height;
+    ce_u32      stride;    /**< Row pitch in pixels (width rounded up to CE_SW_TILE). */
+    ce_u32      tiles_x;
+    ce_u32      tiles_y;
+    ce_arena    scratch;   /**< Per-draw transformed vertices. */
+    ce_sw_stats stats;
+} ce_sw_target;
+
+/**
+ * @brief Triangle face culling.
+ */
+typedef enum ce_sw_cull_e {
+    CE_SW_CULL_NONE = 0,
+    CE_SW_CULL_BACK        /**< Drop clockwise triangles (CCW is front-facing). */
+} ce_sw_cull;
+
+/**
+ * @brief Indexed triangle list with SoA positions.
+ */
+typedef struct ce_sw_mesh_s {
+    const ce_f32*   x;             /**< Position streams, vertex_count each (no padding needed). */
+    const ce_f32*   y;
+    const ce_f32*   z;
+    const ce_color* colors;        /**< Per-vertex colors (CE_NULL = white). */
+    const ce_u32*   indices;       /**< 3 per triangle. */
+    ce_u32          vertex_count;
+    ce_u32          index_count;
+} ce_sw_mesh;
+
+/**
+ * @brief Allocates a target.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_sw_target_init(ce_sw_target* target, ce_u32 width, ce_u32 height);
+
+/**
+ * @brief Releases the target buffers.
+ */
+void ce_sw_target_shutdown(ce_sw_target* target);
+
+/**
+ * @brief Fills color and depth (and resets the hierarchical-Z tiles).
+ */
+void ce_sw_target_clear(ce_sw_target* target, ce_color color, ce_f32 depth);
+
+/**
+ * @brief Zeroes the statistics counters.
+ */
+void ce_sw_target_reset_stats(ce_sw_target* target);
+
+/**
+ * @brief Transforms, clips and rasterizes an indexed mesh with depth testing.
+ * @param target Render target.
+ * @param mesh Geometry.
+ * @param mvp Model-view-projection matrix (clip z in [-w, w]).
+ * @param tint Multiplied with vertex colors.
+ * @param cull Face culling mode.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_sw_draw_mesh(ce_sw_target* target, const ce_sw_mesh* mesh, const ce_mat4f* mvp,
+                          ce_color tint, ce_sw_cull cull);
+
+/**
+ * @brief Draws a line list (e.g. the merged debug-draw stream), no depth writes.
+ * @param vertices Pairs of world-space vertices.
+ * @param count Vertex count (even).
+ * @param view_proj World to clip matrix.
+ * @param depth_test CE_TRUE to hide lines behind already drawn geometry.
+ * @param out_bounds Receives the touched pixel bounds (nullable); with partial
+ *        redraw, mark it dirty so the overlay is uploaded now and erased next frame.
+ * @return CE_OK or CE_ERR_INVALID_ARG.
+ */
+ce_result ce_sw_draw_lines(ce_sw_target* target, const ce_debug_vertex* vertices, ce_u32 count,
+                           const ce_mat4f* view_proj, ce_bool depth_test, ce_recti* out_bounds);
+
+/* ************************************************************************** */
+/* DIRTY REGIONS                                                              */
+/* ************************************************************************** */
+
+/** @brief Rectangles kept before new ones are merged into the cheapest union. */
+#define CE_DIRTY_MAX_RECTS 8u
+
+/**
+ * @brief Small set of disjoint-ish screen rectangles that need redrawing.
+ *
+ * Rectangles are snapped to CE_SW_TILE and merged when their union wastes
+ * little area, so presentation ends up with a handful of uploads.
+ */
+typedef struct ce_dirty_region_s {
+    ce_recti rects[CE_DIRTY_MAX_RECTS];
+    ce_u32   count;
+    ce_s32   width;
+    ce_s32   height;
+} ce_dirty_region;
+
+/**
+ * @brief Empties the region and sets the screen bounds rectangles are clamped to.
+ */
+void ce_dirty_reset(ce_dirty_region* region, ce_u32 width, ce_u32 height);
+
+/**
+ * @brief Adds a rectangle (clamped, tile-snapped, merged with overlapping ones).
+ */
+void ce_dirty_add(ce_dirty_region* region, const ce_recti* rect);
+
+/**
+ * @brief Marks the whole screen dirty.
+ */
+void ce_dirty_add_all(ce_dirty_region* region);
+
+/**
+ * @brief Total pixels covered by the region's rectangles.
+ */
+ce_u64 ce_dirty_area(const ce_dirty_region* region);
+
+/* ************************************************************************** */
+/* 2D CANVAS (PARTIAL REDRAW)                                                 */
+/* ************************************************************************** */
+
+/**
+ * @brief CPU-side texture read by the SW sprite path.
+ */
+typedef struct ce_sw_image_s {
+    const void*     pixels;
+    ce_u32          width;
+    ce_u32          height;
+    ce_u32          stride;    /**< Bytes per row. */
+    ce_pixel_format format;    /**< R8 is sampled as coverage (SDF when flagged). */
+} ce_sw_image;
+
+/**
+ * @brief Draws sprite batches into a SW target, re-rastering only what changed.
+ *
+ * Each render diffs the submitted sprites against the previous frame
+ * (content hash per draw slot) and redraws only the tile-snapped union of
+ * the old and new bounds of changed sprites plus any area marked through
+ * ce_sw_canvas_mark_dirty(). The resulting region is what the window has
+ * to upload.
+ */
+typedef struct ce_sw_canvas_s {
+    ce_sw_target*      target;
+    const ce_sw_image* images;        /**< Indexed by texture id - 1. */
+    ce_u32             image_count;
+    ce_color           clear_color;
+    ce_dynarray        keys;          /**< ce_u64 content hash per draw slot, last frame. */
+    ce_dynarray        rects;         /**< ce_recti bounds per draw slot, last frame. */
+    ce_dirty_region    pending;       /**< Marked between renders. */
+    ce_dirty_region    dirty;         /**< Region redrawn by the last render. */
+    ce_bool            full;          /**< Next render redraws the whole target. */
+    ce_u64             pixels_redrawn;
+} ce_sw_canvas;
+
+/**
+ * @brief Binds a canvas to a target; the first render is a full redraw.
+ * @return CE_OK or an error code.
+ */
+ce_result ce_sw_canvas_init(ce_sw_canvas* canvas, ce_sw_target* target, ce_color clear_color);
+
+/**
+ * @brief Releases the per-slot history.
+ */
+void ce_sw_canvas_shutdown(ce_sw_canvas* canvas);
+
+/**
+ * @brief Sets the texture table (forces a full redraw).
+ */
+void ce_sw_canvas_set_images(ce_sw_canvas* canvas, const ce_sw_image* images, ce_u32 count);
+
+/**
+ * @brief Forces a full redraw on the next render (resize, texture edits, ...).
+ */
+void ce_sw_canvas_invalidate(ce_sw_canvas* canvas);
+
+/**
+ * @brief Marks an area changed by something other than sprites (debug draws, overlays).
+ */
+void ce_sw_canvas_mark_dirty(ce_sw_canvas* canvas, const ce_rectf* rect);
+
+/**
+ * @brief Redraws the dirty part of the frame from the batch's visible list.
+ *
+ * Call after ce_sprite_batch_cull() / ce_sprite_batch_sort().
+ *
+ * @return Region that changed this frame (empty when nothing did).
+ */
+const ce_dirty_region* ce_sw_canvas_render(ce_sw_canvas* canvas, const ce_sprite_batch* batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_SW_RASTER_H */
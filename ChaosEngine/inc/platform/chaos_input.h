@@ -11,15 +11,249 @@
  * @file chaos_input.h
  * @brief Keyboard/mouse input API.
  * @author PapaPamplemousse
+ *
+ * Sources (the SDL event pump, a dedicated polling thread, a replay file)
+ * push timestamped events into a lock-free multi-producer queue. Once per
+ * frame ce_input_update folds the queue into a fresh state snapshot and
+ * publishes it; the simulation reads the snapshot without locks.
+ *
+ * Snapshots are double-buffered: the one returned stays valid until the
+ * second ce_input_update after it, so a reader has a full frame.
+ *
+ * Key codes are USB HID usage ids (the same values as SDL scancodes): they
+ * name physical positions, independent of the keyboard layout.
  */
 #ifndef CHAOS_INPUT_H
 #define CHAOS_INPUT_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+#define CE_INPUT_KEY_COUNT    256u
+#define CE_INPUT_KEY_WORDS    (CE_INPUT_KEY_COUNT / 64u)
+#define CE_INPUT_BUTTON_COUNT 32u
+
+/* ************************************************************************** */
+/* CODES                                                                      */
+/* ************************************************************************** */
+
+/** @brief Physical keys (HID usage ids); any code below CE_INPUT_KEY_COUNT is valid. */
+typedef enum ce_key_e {
+    CE_KEY_UNKNOWN   = 0,
+    CE_KEY_A         = 4,
+    CE_KEY_B, CE_KEY_C, CE_KEY_D, CE_KEY_E, CE_KEY_F, CE_KEY_G, CE_KEY_H, CE_KEY_I, CE_KEY_J, CE_KEY_K, CE_KEY_L,
+    CE_KEY_M, CE_KEY_N, CE_KEY_O, CE_KEY_P, CE_KEY_Q, CE_KEY_R, CE_KEY_S, CE_KEY_T, CE_KEY_U, CE_KEY_V, CE_KEY_W,
+    CE_KEY_X, CE_KEY_Y, CE_KEY_Z,
+    CE_KEY_1         = 30,
+    CE_KEY_2, CE_KEY_3, CE_KEY_4, CE_KEY_5, CE_KEY_6, CE_KEY_7, CE_KEY_8, CE_KEY_9, CE_KEY_0,
+    CE_KEY_ENTER     = 40,
+    CE_KEY_ESCAPE    = 41,
+    CE_KEY_BACKSPACE = 42,
+    CE_KEY_TAB       = 43,
+    CE_KEY_SPACE     = 44,
+    CE_KEY_F1        = 58,
+    CE_KEY_F2, CE_KEY_F3, CE_KEY_F4, CE_KEY_F5, CE_KEY_F6, CE_KEY_F7, CE_KEY_F8, CE_KEY_F9, CE_KEY_F10, CE_KEY_F11,
+    CE_KEY_F12,
+    CE_KEY_RIGHT     = 79,
+    CE_KEY_LEFT      = 80,
+    CE_KEY_DOWN      = 81,
+    CE_KEY_UP        = 82,
+    CE_KEY_LCTRL     = 224,
+    CE_KEY_LSHIFT    = 225,
+    CE_KEY_LALT      = 226,
+    CE_KEY_LGUI      = 227,
+    CE_KEY_RCTRL     = 228,
+    CE_KEY_RSHIFT    = 229,
+    CE_KEY_RALT      = 230,
+    CE_KEY_RGUI      = 231
+} ce_key;
+
+typedef enum ce_mouse_button_e {
+    CE_MOUSE_LEFT = 0,
+    CE_MOUSE_RIGHT,
+    CE_MOUSE_MIDDLE,
+    CE_MOUSE_X1,
+    CE_MOUSE_X2
+} ce_mouse_button;
+
+/* ************************************************************************** */
+/* EVENTS                                                                     */
+/* ************************************************************************** */
+
+typedef enum ce_input_event_type_e {
+    CE_INPUT_EVENT_NONE = 0,
+    CE_INPUT_EVENT_KEY_DOWN,    /**< code = ce_key; repeats are not events. */
+    CE_INPUT_EVENT_KEY_UP,
+    CE_INPUT_EVENT_BUTTON_DOWN, /**< code = ce_mouse_button, x/y = position. */
+    CE_INPUT_EVENT_BUTTON_UP,
+    CE_INPUT_EVENT_MOUSE_MOVE,  /**< x/y = absolute position in window pixels. */
+    CE_INPUT_EVENT_WHEEL,       /**< x/y = scroll steps. */
+    CE_INPUT_EVENT_QUIT,
+    CE_INPUT_EVENT_TYPE_COUNT
+} ce_input_event_type;
+
+typedef struct ce_input_event_s {
+    ce_u64 time_ns; /**< ce_time_now_ns() when it happened (0 = stamped on push). */
+    ce_u32 type;    /**< ce_input_event_type. */
+    ce_u32 code;
+    ce_s32 x;
+    ce_s32 y;
+} ce_input_event;
+
+/* ************************************************************************** */
+/* SNAPSHOT                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Input as of one ce_input_update.
+ *
+ * `pressed` and `released` hold the transitions folded by that update, so
+ * a tap shorter than a frame shows up as pressed and released, not held.
+ */
+typedef struct ce_input_state_s {
+    ce_u64  frame;                           /**< Updates so far (1 for the first). */
+    ce_u64  keys_held[CE_INPUT_KEY_WORDS];
+    ce_u64  keys_pressed[CE_INPUT_KEY_WORDS];
+    ce_u64  keys_released[CE_INPUT_KEY_WORDS];
+    ce_u32  buttons_held;
+    ce_u32  buttons_pressed;
+    ce_u32  buttons_released;
+    ce_s32  mouse_x;
+    ce_s32  mouse_y;
+    ce_s32  mouse_dx;
+    ce_s32  mouse_dy;
+    ce_s32  wheel_x;
+    ce_s32  wheel_y;
+    ce_u32  event_count;                     /**< Events folded by this update. */
+    ce_u64  oldest_event_ns;                 /**< Earliest timestamp folded (0 if none). */
+    ce_u64  newest_event_ns;                 /**< Latest timestamp folded (0 if none). */
+    ce_u64  update_ns;                       /**< When the snapshot was published. */
+    ce_bool quit;                            /**< Sticky once a QUIT event arrived. */
+} ce_input_state;
+
+static inline ce_bool ce__input_bit(const ce_u64* words, ce_u32 key)
+{
+    return ((key < CE_INPUT_KEY_COUNT) && (((words[key / 64u] >> (key % 64u)) & 1u) != 0u)) ? CE_TRUE : CE_FALSE;
+}
+
+static inline ce_bool ce_input_key_held(const ce_input_state* state, ce_key key)
+{
+    return ce__input_bit(state->keys_held, (ce_u32)key);
+}
+
+static inline ce_bool ce_input_key_pressed(const ce_input_state* state, ce_key key)
+{
+    return ce__input_bit(state->keys_pressed, (ce_u32)key);
+}
+
+static inline ce_bool ce_input_key_released(const ce_input_state* state, ce_key key)
+{
+    return ce__input_bit(state->keys_released, (ce_u32)key);
+}
+
+static inline ce_bool ce_input_button_held(const ce_input_state* state, ce_mouse_button button)
+{
+    return (((state->buttons_held >> (ce_u32)button) & 1u) != 0u) ? CE_TRUE : CE_FALSE;
+}
+
+static inline ce_bool ce_input_button_pressed(const ce_input_state* state, ce_mouse_button button)
+{
+    return (((state->buttons_pressed >> (ce_u32)button) & 1u) != 0u) ? CE_TRUE : CE_FALSE;
+}
+
+static inline ce_bool ce_input_button_released(const ce_input_state* state, ce_mouse_button button)
+{
+    return (((state->buttons_released >> (ce_u32)button) & 1u) != 0u) ? CE_TRUE : CE_FALSE;
+}
+
+/* ************************************************************************** */
+/* CONTEXT                                                                    */
+/* ************************************************************************** */
+
+typedef struct ce_input_s ce_input;
+
+typedef struct ce_input_desc_s {
+    ce_u32 queue_capacity; /**< Events in flight (rounded up to a power of two, 0 = 1024). */
+} ce_input_desc;
+
+typedef struct ce_input_stats_s {
+    ce_u64 pushed;
+    ce_u64 dropped;  /**< Pushes refused because the queue was full. */
+    ce_u64 recorded;
+    ce_u64 replayed;
+} ce_input_stats;
+
+/**
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_input_create(const ce_input_desc* desc, ce_input** out_input);
+
+void ce_input_destroy(ce_input* input);
+
+/**
+ * @brief Queues an event; lock-free and callable from any thread.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FULL (the event is dropped).
+ */
+ce_result ce_input_push(ce_input* input, const ce_input_event* event);
+
+/**
+ * @brief Moves pending window-system events into the queue.
+ *
+ * With SDL this drains SDL's event pump, so call it on the thread that
+ * created the window. Without a window backend it does nothing.
+ *
+ * @return Events queued.
+ */
+ce_u32 ce_input_pump(ce_input* input);
+
+/**
+ * @brief Folds every queued event (and the replay, if any) into a new
+ *        snapshot and publishes it. Call once per frame, from one thread.
+ * @return The new snapshot.
+ */
+const ce_input_state* ce_input_update(ce_input* input);
+
+/**
+ * @brief Latest published snapshot; lock-free, callable from any thread.
+ */
+const ce_input_state* ce_input_get_state(const ce_input* input);
+
+void ce_input_get_stats(const ce_input* input, ce_input_stats* out_stats);
+
+/* ************************************************************************** */
+/* RECORD / REPLAY                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Appends every folded event, tagged with its frame, to `path`.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_IO.
+ */
+ce_result ce_input_record_start(ce_input* input, const ce_char* path);
+
+void ce_input_record_stop(ce_input* input);
+
+/**
+ * @brief Feeds a recording back, frame by frame from the next update.
+ *
+ * Replay is tied to update count, not wall time, so a headless run sees
+ * the same input on the same frame every time. Live events are discarded
+ * while it runs (QUIT still gets through).
+ *
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_NOT_FOUND, CE_ERR_FORMAT,
+ *         CE_ERR_IO or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_input_replay_start(ce_input* input, const ce_char* path);
+
+void ce_input_replay_stop(ce_input* input);
+
+/**
+ * @brief CE_TRUE until every recorded frame has been replayed.
+ */
+ce_bool ce_input_replay_active(const ce_input* input);
 
 #ifdef __cplusplus
 }
@@ -15,11 +15,212 @@
 #ifndef CHAOS_THREAD_H
 #define CHAOS_THREAD_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/* ************************************************************************** */
+/* THREADS                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Thread entry point.
+ */
+typedef void (*ce_thread_fn)(void* user);
+
+/**
+ * @brief Opaque native thread.
+ */
+typedef struct ce_thread_s {
+    ce_u64 handle;
+} ce_thread;
+
+/**
+ * @brief Starts a thread.
+ * @param thread Receives the thread.
+ * @param fn Entry point.
+ * @param user Argument passed to fn.
+ * @param name Debug name (may be CE_NULL; truncated by the OS).
+ * @return CE_OK or CE_ERR_UNSUPPORTED / CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_thread_create(ce_thread* thread, ce_thread_fn fn, void* user, const ce_char* name);
+
+/**
+ * @brief Waits for a thread to finish.
+ */
+void ce_thread_join(ce_thread* thread);
+
+/**
+ * @brief Gives up the rest of the time slice.
+ */
+void ce_thread_yield(void);
+
+/**
+ * @brief Sleeps for at least `ms` milliseconds.
+ */
+void ce_thread_sleep_ms(ce_u32 ms);
+
+/**
+ * @brief Number of hardware threads available to the process (>= 1).
+ */
+ce_u32 ce_thread_hardware_concurrency(void);
+
+/* ************************************************************************** */
+/* MUTEX / CONDITION VARIABLE                                                 */
+/* ************************************************************************** */
+
+/**
+ * @brief Opaque mutex storage (large enough for the native type).
+ */
+typedef struct ce_mutex_s {
+    union {
+        ce_u64 align;
+        ce_u8  bytes[64];
+    } storage;
+} ce_mutex;
+
+/**
+ * @brief Opaque condition variable storage.
+ */
+typedef struct ce_cond_s {
+    union {
+        ce_u64 align;
+        ce_u8  bytes[64];
+    } storage;
+} ce_cond;
+
+ce_result ce_mutex_init(ce_mutex* mutex);
+void      ce_mutex_destroy(ce_mutex* mutex);
+void      ce_mutex_lock(ce_mutex* mutex);
+void      ce_mutex_unlock(ce_mutex* mutex);
+
+ce_result ce_cond_init(ce_cond* cond);
+void      ce_cond_destroy(ce_cond* cond);
+/** @brief Atomically releases `mutex` and waits; re-acquires before returning. */
+void      ce_cond_wait(ce_cond* cond, ce_mutex* mutex);
+void      ce_cond_signal(ce_cond* cond);
+void      ce_cond_broadcast(ce_cond* cond);
+
+/* ************************************************************************** */
+/* ATOMICS                                                                    */
+/* ************************************************************************** */
+
+/*
+ * Thin wrappers over the GCC/Clang __atomic builtins. Loads are acquire,
+ * stores are release and read-modify-write operations are acq_rel unless
+ * the name says "relaxed".
+ */
+
+typedef struct ce_atomic_u32_s {
+    volatile ce_u32 value;
+} ce_atomic_u32;
+
+typedef struct ce_atomic_u64_s {
+    volatile ce_u64 value;
+} ce_atomic_u64;
+
+static inline ce_u32 ce_atomic_load_u32(const ce_atomic_u32* a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_ACQUIRE);
+}
+
+static inline ce_u32 ce_atomic_load_relaxed_u32(const ce_atomic_u32* a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_RELAXED);
+}
+
+static inline void ce_atomic_store_u32(ce_atomic_u32* a, ce_u32 v)
+{
+    __atomic_store_n(&a->value, v, __ATOMIC_RELEASE);
+}
+
+static inline void ce_atomic_store_relaxed_u32(ce_atomic_u32* a, ce_u32 v)
+{
+    __atomic_store_n(&a->value, v, __ATOMIC_RELAXED);
+}
+
+/** @return Value before the addition. */
+static inline ce_u32 ce_atomic_fetch_add_u32(ce_atomic_u32* a, ce_u32 v)
+{
+    return __atomic_fetch_add(&a->value, v, __ATOMIC_ACQ_REL);
+}
+
+/** @return Value before the subtraction. */
+static inline ce_u32 ce_atomic_fetch_sub_u32(ce_atomic_u32* a, ce_u32 v)
+{
+    return __atomic_fetch_sub(&a->value, v, __ATOMIC_ACQ_REL);
+}
+
+/** @return Value before the exchange. */
+static inline ce_u32 ce_atomic_exchange_u32(ce_atomic_u32* a, ce_u32 v)
+{
+    return __atomic_exchange_n(&a->value, v, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief Strong compare-and-swap.
+ * @param expected In: expected value. Out: observed value on failure.
+ * @return CE_TRUE when the swap happened.
+ */
+static inline ce_bool ce_atomic_cas_u32(ce_atomic_u32* a, ce_u32* expected, ce_u32 desired)
+{
+    return __atomic_compare_exchange_n(&a->value, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+         ? CE_TRUE : CE_FALSE;
+}
+
+static inline ce_u64 ce_atomic_load_u64(const ce_atomic_u64* a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_ACQUIRE);
+}
+
+static inline ce_u64 ce_atomic_load_relaxed_u64(const ce_atomic_u64* a)
+{
+    return __atomic_load_n(&a->value, __ATOMIC_RELAXED);
+}
+
+static inline void ce_atomic_store_u64(ce_atomic_u64* a, ce_u64 v)
+{
+    __atomic_store_n(&a->value, v, __ATOMIC_RELEASE);
+}
+
+static inline ce_u64 ce_atomic_fetch_add_u64(ce_atomic_u64* a, ce_u64 v)
+{
+    return __atomic_fetch_add(&a->value, v, __ATOMIC_ACQ_REL);
+}
+
+static inline ce_u64 ce_atomic_fetch_sub_u64(ce_atomic_u64* a, ce_u64 v)
+{
+    return __atomic_fetch_sub(&a->value, v, __ATOMIC_ACQ_REL);
+}
+
+static inline ce_bool ce_atomic_cas_u64(ce_atomic_u64* a, ce_u64* expected, ce_u64 desired)
+{
+    return __atomic_compare_exchange_n(&a->value, expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+         ? CE_TRUE : CE_FALSE;
+}
+
+/**
+ * @brief Full memory barrier.
+ */
+static inline void ce_atomic_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Spin-wait hint for busy loops.
+ */
+static inline void ce_cpu_pause(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
 
 #ifdef __cplusplus
 }
@@ -9,17 +9,157 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_window.h
- * @brief Window creation and management.
+ * @brief Window creation, presentation control and latency metrics.
  * @author PapaPamplemousse
+ *
+ * An offscreen window has no OS window at all: presents land in a CPU
+ * framebuffer and vsync is emulated from the engine clock, so the same
+ * present loop runs (and is measured) in headless tests.
  */
 #ifndef CHAOS_WINDOW_H
 #define CHAOS_WINDOW_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "gfx/chaos_gfx_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+#define CE_WINDOW_HISTOGRAM_BUCKETS   128u
+#define CE_WINDOW_HISTOGRAM_BUCKET_NS 250000u /**< 0.25 ms; the last bucket also takes everything above. */
+
+/**
+ * @brief Opaque window (backend-defined).
+ */
+typedef struct ce_window_s ce_window;
+
+typedef enum ce_window_mode_e {
+    CE_WINDOW_MODE_SHOWN = 0,
+    CE_WINDOW_MODE_HIDDEN,    /**< Real window and renderer, never mapped. */
+    CE_WINDOW_MODE_OFFSCREEN  /**< No OS window; works without a window backend. */
+} ce_window_mode;
+
+typedef enum ce_present_mode_e {
+    CE_PRESENT_VSYNC = 0,     /**< Wait for the vertical blank. */
+    CE_PRESENT_ADAPTIVE,      /**< Vsync, but a frame that missed its blank is shown at once (tears). */
+    CE_PRESENT_IMMEDIATE      /**< Never wait; lowest latency, tears. */
+} ce_present_mode;
+
+/**
+ * @brief Creation parameters.
+ */
+typedef struct ce_window_desc_s {
+    const ce_char*  title;
+    ce_u32          width;
+    ce_u32          height;
+    ce_bool         resizable;
+    ce_window_mode  mode;
+    ce_present_mode present_mode;
+    /**
+     * Frames the GPU may queue behind the CPU. 0 keeps the driver default;
+     * 1 makes each present wait until the GPU has drawn the frame, so input
+     * is never sampled more than a frame ahead of the screen. The SDL
+     * renderer exposes no swap-chain depth, so larger values act like 0.
+     */
+    ce_u32          max_queued_frames;
+    ce_u32          refresh_hz; /**< Emulated refresh of offscreen windows (0 = 60). */
+} ce_window_desc;
+
+/**
+ * @brief Presentation counters since creation (or ce_window_reset_stats).
+ *
+ * Frame time is the interval between two presents returning. Latency runs
+ * from the time given to ce_window_set_input_time to the present returning
+ * after that frame, i.e. input-to-present: scan-out adds the rest of the
+ * way to the photons.
+ */
+typedef struct ce_window_stats_s {
+    ce_u64 presents;
+    ce_u64 pixels_uploaded;  /**< Texels sent to the presentation texture. */
+    ce_u64 missed_vblanks;   /**< Presents after their blank (estimated from frame time on screen). */
+    ce_u64 frame_ns_last;
+    ce_u64 frame_ns_max;
+    ce_u64 present_ns_last;  /**< Time spent inside the last present call (waits included). */
+    ce_u64 latency_samples;
+    ce_u64 latency_ns_last;
+    ce_u64 latency_ns_min;
+    ce_u64 latency_ns_max;
+    ce_u64 latency_ns_sum;
+    ce_u64 frame_histogram[CE_WINDOW_HISTOGRAM_BUCKETS];
+    ce_u64 latency_histogram[CE_WINDOW_HISTOGRAM_BUCKETS];
+} ce_window_stats;
+
+/**
+ * @brief Opens a window.
+ * @return CE_OK, CE_ERR_UNSUPPORTED when built without a window backend, or an error code.
+ */
+ce_result ce_window_create(const ce_window_desc* desc, ce_window** out_window);
+
+/**
+ * @brief Closes the window and releases its resources.
+ */
+void ce_window_destroy(ce_window* window);
+
+/**
+ * @brief Current client size in pixels.
+ */
+void ce_window_size(const ce_window* window, ce_u32* width, ce_u32* height);
+
+/**
+ * @brief Presents a CPU framebuffer, uploading only the given rectangles.
+ *
+ * Pass rect_count 0 for a full upload. Rectangles refer to the framebuffer
+ * and are clamped to it; the first present (and any size change) always
+ * uploads everything.
+ *
+ * @param pixels RGBA8 framebuffer (ce_color, R in the lowest byte).
+ * @param stride Row pitch in pixels.
+ */
+ce_result ce_window_present_pixels(ce_window* window, const ce_color* pixels, ce_u32 width, ce_u32 height,
+                                   ce_u32 stride, const ce_recti* rects, ce_u32 rect_count);
+
+/**
+ * @brief Switches the present mode of a live window.
+ * @return CE_OK, CE_ERR_INVALID_ARG, or CE_ERR_UNSUPPORTED when the backend
+ *         cannot change vsync after creation.
+ */
+ce_result ce_window_set_present_mode(ce_window* window, ce_present_mode mode);
+
+/**
+ * @brief Tags the next present with the time of the input it reflects.
+ *
+ * Pass the oldest input timestamp the frame consumed (for instance
+ * ce_input_state::oldest_event_ns); 0 means the frame carries no input and
+ * records no latency sample.
+ */
+void ce_window_set_input_time(ce_window* window, ce_u64 input_ns);
+
+/**
+ * @brief Last presented image of an offscreen window.
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_NOT_FOUND before the first
+ *         present, or CE_ERR_UNSUPPORTED for an on-screen window.
+ */
+ce_result ce_window_read_pixels(const ce_window* window, const ce_color** out_pixels, ce_u32* out_width,
+                                ce_u32* out_height);
+
+/**
+ * @brief Reads the presentation counters.
+ */
+void ce_window_get_stats(const ce_window* window, ce_window_stats* out_stats);
+
+/**
+ * @brief Clears the counters, e.g. once a benchmark has warmed up.
+ */
+void ce_window_reset_stats(ce_window* window);
+
+/**
+ * @brief Upper edge (ns) of the bucket holding the given fraction of samples.
+ * @param fraction 0.5 for the median, 0.99 for the 99th percentile.
+ * @return 0 for an empty histogram.
+ */
+ce_u64 ce_window_histogram_percentile(const ce_u64* histogram, ce_f64 fraction);
 
 #ifdef __cplusplus
 }
@@ -11,15 +11,202 @@
  * @file chaos_assets.h
  * @brief Asset manager API.
  * @author PapaPamplemousse
+ *
+ * Requests return a handle immediately; loads run on job-system workers,
+ * highest priority first, once every dependency is ready (an atlas before
+ * its sprites). Handles are reference counted. An unreferenced asset stays
+ * resident in an LRU cache until the memory budget needs the room, so a
+ * level reloading the same files hits the cache.
+ *
+ * Hot reload: once a source directory is watched, a saved file is
+ * re-imported on the workers after a quiet period (debounce), unless its
+ * content hash is unchanged. Assets built from it (dependents) are rebuilt
+ * after it. The new data of the whole batch replaces the old at one
+ * ce_asset_manager_update(), so handles stay valid and never observe a
+ * half-reloaded set.
  */
 #ifndef CHAOS_ASSETS_H
 #define CHAOS_ASSETS_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "resources/chaos_handles.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+#define CE_ASSET_MAX_TYPES 16u
+#define CE_ASSET_MAX_DEPS  8u
+
+/** @brief Asset handle (a 32-bit ce_handle); CE_ASSET_NONE is never valid. */
+typedef ce_handle ce_asset_id;
+
+#define CE_ASSET_NONE CE_HANDLE_NONE
+
+typedef enum ce_asset_state_e {
+    CE_ASSET_STATE_INVALID = 0, /**< Stale or unknown handle. */
+    CE_ASSET_STATE_QUEUED,
+    CE_ASSET_STATE_LOADING,
+    CE_ASSET_STATE_READY,
+    CE_ASSET_STATE_FAILED,      /**< Loader error, or a dependency failed. */
+    CE_ASSET_STATE_CANCELLED
+} ce_asset_state;
+
+typedef enum ce_asset_priority_e {
+    CE_ASSET_PRIORITY_LOW = 0,
+    CE_ASSET_PRIORITY_NORMAL,
+    CE_ASSET_PRIORITY_HIGH,
+    CE_ASSET_PRIORITY_CRITICAL,
+    CE_ASSET_PRIORITY_COUNT
+} ce_asset_priority;
+
+/**
+ * @brief What a loader receives on the worker.
+ */
+typedef struct ce_asset_load_ctx_s {
+    const ce_char*     path;
+    ce_u32             type;
+    const void* const* deps;      /**< Data of each dependency, in request order. */
+    ce_u32             dep_count;
+} ce_asset_load_ctx;
+
+/**
+ * @brief Per-type callbacks.
+ *
+ * `load` runs on a worker and reports the bytes charged to the budget.
+ * `unload` may run on the thread calling ce_asset_manager_update() or on a
+ * worker (result of a cancelled load).
+ */
+typedef struct ce_asset_loader_s {
+    ce_result (*load)(void* user, const ce_asset_load_ctx* ctx, void** out_data, ce_size* out_bytes);
+    void      (*unload)(void* user, void* data);
+    void*     user;
+} ce_asset_loader;
+
+typedef struct ce_asset_manager_desc_s {
+    ce_u32  max_assets;         /**< Handle table capacity. */
+    ce_u32  max_in_flight;      /**< Concurrent loads (0 = worker count, at least 1). */
+    ce_size budget_bytes;       /**< Resident target for unreferenced assets (0 = unlimited). */
+    ce_u32  reload_debounce_ms; /**< Quiet time after a file change before re-importing (0 = 100). */
+} ce_asset_manager_desc;
+
+typedef struct ce_asset_request_s {
+    ce_u32             type;
+    const ce_char*     path;
+    ce_asset_priority  priority;
+    const ce_asset_id* deps;      /**< Live handles; each gains a reference until this asset is gone. */
+    ce_u32             dep_count;
+} ce_asset_request;
+
+typedef struct ce_asset_manager_stats_s {
+    ce_u32  queued;
+    ce_u32  loading;
+    ce_u32  resident;         /**< READY assets. */
+    ce_u32  cached;           /**< READY and unreferenced (evictable). */
+    ce_size resident_bytes;
+    ce_u64  loads;
+    ce_u64  failures;
+    ce_u64  cancellations;
+    ce_u64  evictions;
+    ce_u64  cache_hits;
+    ce_u64  reloads;          /**< Hot reloads swapped in. */
+    ce_u64  reloads_skipped;  /**< Saves whose content hash had not changed. */
+    ce_u64  reload_failures;  /**< Re-imports that failed (the old data stays). */
+} ce_asset_manager_stats;
+
+typedef struct ce_asset_manager_s ce_asset_manager;
+
+/* ************************************************************************** */
+/* MANAGER                                                                    */
+/* ************************************************************************** */
+
+ce_result ce_asset_manager_create(const ce_asset_manager_desc* desc, ce_asset_manager** out_manager);
+
+/**
+ * @brief Cancels queued loads, waits for running ones and unloads everything.
+ */
+void ce_asset_manager_destroy(ce_asset_manager* manager);
+
+/**
+ * @return CE_OK or CE_ERR_INVALID_ARG (type out of range, no load callback).
+ */
+ce_result ce_asset_manager_register(ce_asset_manager* manager, ce_u32 type, const ce_asset_loader* loader);
+
+/**
+ * @brief Frame boundary: swaps in finished hot reloads, starts queued loads
+ *        and re-imports, and evicts cached assets, oldest first, while
+ *        resident bytes exceed the budget.
+ */
+void ce_asset_manager_update(ce_asset_manager* manager);
+
+/**
+ * @brief Evicts every unreferenced asset (level transitions).
+ */
+void ce_asset_manager_collect(ce_asset_manager* manager);
+
+void ce_asset_manager_get_stats(ce_asset_manager* manager, ce_asset_manager_stats* out_stats);
+
+/**
+ * @brief Enables hot reload for assets whose path lies under `directory`
+ *        (paths compare as given, so watch the prefix used in requests).
+ *
+ * Call from the thread running ce_asset_manager_update().
+ * @return CE_OK or a ce_fs_watcher_add() error.
+ */
+ce_result ce_asset_manager_watch(ce_asset_manager* manager, const ce_char* directory);
+
+/* ************************************************************************** */
+/* ASSETS                                                                     */
+/* ************************************************************************** */
+
+/**
+ * @brief Requests an asset; the same type and path share one entry.
+ * @return A handle holding one reference, or CE_ASSET_NONE (table full, bad request).
+ *
+ * Dependencies inherit the priority when it is higher than theirs.
+ */
+ce_asset_id ce_asset_load(ce_asset_manager* manager, const ce_asset_request* request);
+
+/** @brief Adds a reference. */
+ce_result ce_asset_acquire(ce_asset_manager* manager, ce_asset_id asset);
+
+/**
+ * @brief Drops a reference. At zero a pending load is dropped; a ready asset
+ *        moves to the cache and is unloaded later under budget pressure.
+ */
+ce_result ce_asset_release(ce_asset_manager* manager, ce_asset_id asset);
+
+/**
+ * @brief Cancels a queued or running load (a running result is discarded).
+ * @return CE_OK, CE_ERR_NOT_FOUND, or CE_ERR_INVALID_ARG when already finished.
+ */
+ce_result ce_asset_cancel(ce_asset_manager* manager, ce_asset_id asset);
+
+ce_result ce_asset_set_priority(ce_asset_manager* manager, ce_asset_id asset, ce_asset_priority priority);
+
+ce_asset_state ce_asset_get_state(ce_asset_manager* manager, ce_asset_id asset);
+
+/**
+ * @brief Loaded data, or CE_NULL unless READY.
+ *
+ * The pointer stays valid until the next ce_asset_manager_update(), which
+ * may swap in reloaded data.
+ */
+void* ce_asset_get(ce_asset_manager* manager, ce_asset_id asset);
+
+/**
+ * @brief Number of hot reloads swapped in so far (0 for the first load).
+ */
+ce_u32 ce_asset_get_version(ce_asset_manager* manager, ce_asset_id asset);
+
+/**
+ * @brief Raises the asset to CRITICAL and blocks until it leaves the queue.
+ *
+ * Must not be called from a loader.
+ * @return Final state.
+ */
+ce_asset_state ce_asset_wait(ce_asset_manager* manager, ce_asset_id asset);
 
 #ifdef __cplusplus
 }
@@ -11,15 +11,140 @@
  * @file chaos_handles.h
  * @brief Opaque resource handles API.
  * @author PapaPamplemousse
+ *
+ * A handle table hands out slot indices and stamps them with a per-slot
+ * generation. Handles are plain integers: 32-bit (20-bit index, 12-bit
+ * generation) or 64-bit (32-bit index, 32-bit generation). Freeing a slot
+ * bumps its generation, so stale handles fail to resolve.
+ *
+ * Storage is structure-of-arrays: resolving touches a single u32. Freed
+ * slots are recycled FIFO, which maximizes the time before a generation
+ * comes back. Live slots are also kept packed in `alive[0..alive_count)`
+ * for tight iteration; callers keep their own data in slot-indexed arrays.
  */
 #ifndef CHAOS_HANDLES_H
 #define CHAOS_HANDLES_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "core/chaos_memory.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+#define CE_HANDLE_INDEX_BITS   20u
+#define CE_HANDLE_INDEX_MASK   ((1u << CE_HANDLE_INDEX_BITS) - 1u)
+#define CE_HANDLE_GEN_MASK     0xFFFu
+#define CE_HANDLE_MAX_CAPACITY (1u << CE_HANDLE_INDEX_BITS)
+#define CE_HANDLE_INVALID      0xFFFFFFFFu  /**< Returned as a slot index on failure. */
+
+/** @brief 32-bit handle; CE_HANDLE_NONE is never issued. */
+typedef ce_u32 ce_handle;
+/** @brief 64-bit handle; CE_HANDLE_NONE is never issued. */
+typedef ce_u64 ce_handle64;
+
+#define CE_HANDLE_NONE 0u
+
+/**
+ * @brief Generational slot allocator.
+ *
+ * Not thread-safe; owned by one thread (see the mixer for the pattern of
+ * passing handles to another thread and freeing on the owner).
+ */
+typedef struct ce_handle_table_s {
+    ce_u32*    generations; /**< Per slot; low 12 bits never zero. */
+    ce_u32*    alive_pos;   /**< Slot -> position in `alive`, CE_HANDLE_INVALID when free. */
+    ce_u32*    alive;       /**< Packed live slots (order changes on free). */
+    ce_u32*    free_queue;  /**< FIFO of free slots. */
+    ce_u32     capacity;
+    ce_u32     alive_count;
+    ce_u32     free_head;
+    ce_u32     free_count;
+    ce_mem_tag tag;
+} ce_handle_table;
+
+/**
+ * @brief Allocates a table of `capacity` slots (at most CE_HANDLE_MAX_CAPACITY).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_handle_table_init(ce_handle_table* table, ce_u32 capacity, ce_mem_tag tag);
+
+void ce_handle_table_shutdown(ce_handle_table* table);
+
+/**
+ * @brief Takes the oldest free slot.
+ * @return Slot index, or CE_HANDLE_INVALID when the table is full.
+ */
+ce_u32 ce_handle_table_alloc(ce_handle_table* table);
+
+/**
+ * @brief Releases a live slot; its outstanding handles become stale.
+ *
+ * The last alive entry moves into the freed position.
+ */
+void ce_handle_table_free(ce_handle_table* table, ce_u32 slot);
+
+/**
+ * @brief Frees every slot at once.
+ */
+void ce_handle_table_clear(ce_handle_table* table);
+
+/* ************************************************************************** */
+/* ENCODING                                                                   */
+/* ************************************************************************** */
+
+static inline ce_u32 ce_handle_index(ce_handle handle)
+{
+    return handle & CE_HANDLE_INDEX_MASK;
+}
+
+static inline ce_u32 ce_handle64_index(ce_handle64 handle)
+{
+    return (ce_u32)(handle & 0xFFFFFFFFull);
+}
+
+/** @brief Current 32-bit handle of a live slot. */
+static inline ce_handle ce_handle_table_handle(const ce_handle_table* table, ce_u32 slot)
+{
+    return ((table->generations[slot] & CE_HANDLE_GEN_MASK) << CE_HANDLE_INDEX_BITS) | slot;
+}
+
+/** @brief Current 64-bit handle of a live slot. */
+static inline ce_handle64 ce_handle_table_handle64(const ce_handle_table* table, ce_u32 slot)
+{
+    return ((ce_u64)table->generations[slot] << 32u) | (ce_u64)slot;
+}
+
+/* ************************************************************************** */
+/* LOOKUP                                                                     */
+/* ************************************************************************** */
+
+/**
+ * @brief Slot of a live handle, or CE_HANDLE_INVALID if it is stale or forged.
+ *
+ * One bounds check and one load: suitable for inner loops.
+ */
+static inline ce_u32 ce_handle_table_resolve(const ce_handle_table* table, ce_handle handle)
+{
+    ce_u32 slot;
+
+    slot = handle & CE_HANDLE_INDEX_MASK;
+    return ((slot < table->capacity) &&
+            ((table->generations[slot] & CE_HANDLE_GEN_MASK) == (handle >> CE_HANDLE_INDEX_BITS)))
+               ? slot
+               : CE_HANDLE_INVALID;
+}
+
+static inline ce_u32 ce_handle_table_resolve64(const ce_handle_table* table, ce_handle64 handle)
+{
+    ce_u32 slot;
+
+    slot = (ce_u32)(handle & 0xFFFFFFFFull);
+    return ((slot < table->capacity) && (table->generations[slot] == (ce_u32)(handle >> 32u)))
+               ? slot
+               : CE_HANDLE_INVALID;
+}
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,110 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_image.h
+ * @brief Image decoding straight to GPU-ready RGBA8 / BGRA8 with mip chains.
+ * @author PapaPamplemousse
+ *
+ * TGA (true-colour / grey, raw or RLE) is parsed here; PNG, JPEG, BMP and
+ * friends go through stb_image when third_party/stb provides it
+ * (CE_HAVE_STB_IMAGE). Channel expansion, swizzle and alpha premultiply are
+ * one pass into the caller's memory, so the result can be memcpy'd into a
+ * staging buffer or uploaded as is. Level 0 is followed by every mip, each
+ * level tightly packed.
+ *
+ * Decoding is re-entrant: ce_image_decode_batch() spreads images over the
+ * job workers, and mip levels are split across workers by rows.
+ */
+#ifndef CHAOS_IMAGE_H
+#define CHAOS_IMAGE_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CE_IMAGE_MAX_MIPS 16u
+
+/** @brief Multiply colour by alpha (what the blend state expects). */
+#define CE_IMAGE_FLAG_PREMULTIPLY 0x1u
+/** @brief Append the full mip chain after level 0 (box filter). */
+#define CE_IMAGE_FLAG_MIPS        0x2u
+
+/**
+ * @brief Byte order of a decoded texel.
+ */
+typedef enum ce_image_layout_e {
+    CE_IMAGE_LAYOUT_RGBA8 = 0,
+    CE_IMAGE_LAYOUT_BGRA8
+} ce_image_layout;
+
+/**
+ * @brief Dimensions and memory footprint of a decoded image.
+ */
+typedef struct ce_image_info_s {
+    ce_u32  width;
+    ce_u32  height;
+    ce_u32  mip_count; /**< 1 without CE_IMAGE_FLAG_MIPS. */
+    ce_size bytes;     /**< Whole chain, 4 bytes per texel. */
+} ce_image_info;
+
+/**
+ * @brief Reads the header only, so callers can size the destination.
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_FORMAT or CE_ERR_UNSUPPORTED
+ *         (format needing stb_image in a build without it).
+ */
+ce_result ce_image_probe(const void* data, ce_size size, ce_u32 flags, ce_image_info* out_info);
+
+/**
+ * @brief Byte offset and size of mip `level` inside a decoded chain.
+ */
+ce_size ce_image_mip_offset(const ce_image_info* info, ce_u32 level, ce_u32* out_width, ce_u32* out_height);
+
+/**
+ * @brief Decodes into `dst` (at least the probed `bytes`, 4-byte aligned).
+ * @param out_info May be CE_NULL.
+ * @return CE_OK, a ce_image_probe() error, CE_ERR_FULL when `dst_size` is too
+ *         small or CE_ERR_OUT_OF_MEMORY (stb_image scratch).
+ */
+ce_result ce_image_decode(const void* data, ce_size size, ce_image_layout layout, ce_u32 flags, void* dst,
+                          ce_size dst_size, ce_image_info* out_info);
+
+/**
+ * @brief Rebuilds levels 1.. of a chain from level 0.
+ */
+void ce_image_build_mips(void* pixels, const ce_image_info* info);
+
+/**
+ * @brief One entry of a batch decode.
+ */
+typedef struct ce_image_load_s {
+    const void*     data;     /**< Encoded file image. */
+    ce_size         size;
+    void*           dst;      /**< Caller memory (arena, staging buffer...). */
+    ce_size         dst_size;
+    ce_image_layout layout;
+    ce_u32          flags;
+    ce_image_info   info;     /**< Out. */
+    ce_result       result;   /**< Out. */
+} ce_image_load;
+
+/**
+ * @brief Decodes every entry on the job workers (inline without a pool) and waits.
+ * @return CE_OK when every entry succeeded, else the first failure (see each `result`).
+ */
+ce_result ce_image_decode_batch(ce_image_load* loads, ce_u32 count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_IMAGE_H */
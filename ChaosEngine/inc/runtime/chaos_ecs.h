@@ -0,0 +1,230 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_ecs.h
+ * @brief Archetype entity-component-system API.
+ * @author PapaPamplemousse
+ *
+ * Entities are generational handles. Every distinct set of components is an
+ * archetype; its entities are packed into fixed CE_ECS_CHUNK_BYTES chunks,
+ * each chunk holding one column per component (structure-of-arrays). A
+ * query walks the chunks of the matching archetypes front to back, so a
+ * system sees contiguous arrays and never chases a pointer per entity.
+ *
+ * Systems declare the components they read and write. The scheduler orders
+ * conflicting systems by registration order and runs the others side by
+ * side on the job system. A zero-sized component can stand in for any
+ * other shared state a system touches (a physics world, an output list).
+ *
+ * Structural changes (create, destroy, add, remove) move rows between
+ * chunks and are refused while systems run: queue them with the deferred
+ * calls instead, they are applied when ce_ecs_run returns.
+ */
+#ifndef CHAOS_ECS_H
+#define CHAOS_ECS_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "resources/chaos_handles.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Component ids per world (one bit each in a ce_ecs_mask). */
+#define CE_ECS_MAX_COMPONENTS 64u
+/** @brief Systems per world. */
+#define CE_ECS_MAX_SYSTEMS    128u
+/** @brief Size of one archetype chunk. */
+#define CE_ECS_CHUNK_BYTES    16384u
+/** @brief Column offset of a component absent from a view. */
+#define CE_ECS_NO_COLUMN      0xFFFFFFFFu
+
+/** @brief Mask bit of a component id. */
+#define CE_ECS_BIT(id) ((ce_ecs_mask)1u << (id))
+
+/** @brief Entity handle (20-bit index, 12-bit generation); CE_HANDLE_NONE is never issued. */
+typedef ce_handle ce_entity;
+/** @brief Component set, one bit per component id. */
+typedef ce_u64 ce_ecs_mask;
+typedef ce_u32 ce_component_id;
+
+typedef struct ce_ecs_world_s ce_ecs_world;
+
+typedef struct ce_ecs_world_desc_s {
+    ce_u32 max_entities; /**< Live entities at once (at most CE_HANDLE_MAX_CAPACITY). */
+} ce_ecs_world_desc;
+
+/**
+ * @brief Archetype filter: matches when every `read` and `write` component
+ *        is present and no `exclude` component is.
+ */
+typedef struct ce_ecs_query_s {
+    ce_ecs_mask read;
+    ce_ecs_mask write;
+    ce_ecs_mask exclude;
+} ce_ecs_query;
+
+/**
+ * @brief One chunk of a matching archetype.
+ *
+ * Valid for the duration of the callback only.
+ */
+typedef struct ce_ecs_view_s {
+    const ce_entity* entities; /**< count entities, in column order. */
+    ce_u32           count;
+    ce_u8*           data;     /**< Chunk base. */
+    const ce_u32*    offsets;  /**< Column offset per component id, CE_ECS_NO_COLUMN when absent. */
+} ce_ecs_view;
+
+/**
+ * @brief Column of component `id` in a view: count elements of the
+ *        registered size, or CE_NULL when the archetype lacks it.
+ */
+static inline void* ce_ecs_column(const ce_ecs_view* view, ce_component_id id)
+{
+    ce_u32 offset;
+
+    offset = view->offsets[id];
+    return (offset != CE_ECS_NO_COLUMN) ? (void*)(view->data + offset) : CE_NULL;
+}
+
+/** @brief Per-chunk callback of queries and systems. */
+typedef void (*ce_ecs_chunk_fn)(void* user, const ce_ecs_view* view);
+
+typedef struct ce_ecs_system_desc_s {
+    const ce_char*  name;
+    ce_ecs_query    query;
+    ce_ecs_mask     extra_read;  /**< Components read outside the view (ce_ecs_entity_get). */
+    ce_ecs_mask     extra_write; /**< Components written outside the view. */
+    ce_ecs_chunk_fn fn;
+    void*           user;
+    ce_u32          chunk_batch; /**< Chunks per job (0 = one job walks every chunk in order). */
+} ce_ecs_system_desc;
+
+typedef struct ce_ecs_stats_s {
+    ce_u32 entities;
+    ce_u32 archetypes;
+    ce_u32 chunks;      /**< Chunks holding entities. */
+    ce_u32 free_chunks; /**< Empty chunks kept for reuse. */
+} ce_ecs_stats;
+
+/* ************************************************************************** */
+/* WORLD                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_ecs_world_create(const ce_ecs_world_desc* desc, ce_ecs_world** out_world);
+
+void ce_ecs_world_destroy(ce_ecs_world* world);
+
+/**
+ * @brief Registers a component type; ids are handed out from 0.
+ * @param name Kept by pointer (use a literal).
+ * @param size Bytes per entity (0 for tags).
+ * @param align Power of two up to 64 (0 = 1).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FULL.
+ */
+ce_result ce_ecs_component_register(ce_ecs_world* world, const ce_char* name, ce_u32 size, ce_u32 align,
+                                    ce_component_id* out_id);
+
+void ce_ecs_get_stats(const ce_ecs_world* world, ce_ecs_stats* out_stats);
+
+/* ************************************************************************** */
+/* ENTITIES                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Creates an entity holding `components`, zero-initialized.
+ * @return CE_OK, CE_ERR_INVALID_ARG (unknown component), CE_ERR_FULL,
+ *         CE_ERR_OUT_OF_MEMORY or CE_ERR_UNSUPPORTED (systems running).
+ */
+ce_result ce_ecs_entity_create(ce_ecs_world* world, ce_ecs_mask components, ce_entity* out_entity);
+
+/**
+ * @return CE_OK, CE_ERR_NOT_FOUND (stale handle) or CE_ERR_UNSUPPORTED.
+ */
+ce_result ce_ecs_entity_destroy(ce_ecs_world* world, ce_entity entity);
+
+ce_bool ce_ecs_entity_alive(const ce_ecs_world* world, ce_entity entity);
+
+/**
+ * @brief Adds a zero-initialized component (no-op when already present).
+ * @return Same codes as ce_ecs_entity_create, plus CE_ERR_NOT_FOUND.
+ */
+ce_result ce_ecs_entity_add(ce_ecs_world* world, ce_entity entity, ce_component_id id);
+
+/**
+ * @brief Drops a component (no-op when absent).
+ */
+ce_result ce_ecs_entity_remove(ce_ecs_world* world, ce_entity entity, ce_component_id id);
+
+/**
+ * @brief Address of an entity's component, valid until the next structural
+ *        change. CE_NULL for stale handles and absent components.
+ */
+void* ce_ecs_entity_get(const ce_ecs_world* world, ce_entity entity, ce_component_id id);
+
+/**
+ * @brief Component set of an entity (0 for stale handles).
+ */
+ce_ecs_mask ce_ecs_entity_mask(const ce_ecs_world* world, ce_entity entity);
+
+/* ************************************************************************** */
+/* DEFERRED CHANGES                                                           */
+/* ************************************************************************** */
+
+/**
+ * @brief Thread-safe; applied in call order by ce_ecs_flush. Stale handles
+ *        are skipped at that point.
+ * @return CE_OK or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_ecs_defer_destroy(ce_ecs_world* world, ce_entity entity);
+ce_result ce_ecs_defer_add(ce_ecs_world* world, ce_entity entity, ce_component_id id);
+ce_result ce_ecs_defer_remove(ce_ecs_world* world, ce_entity entity, ce_component_id id);
+
+/**
+ * @brief Applies the deferred changes (ce_ecs_run does it on return).
+ */
+void ce_ecs_flush(ce_ecs_world* world);
+
+/* ************************************************************************** */
+/* QUERIES AND SYSTEMS                                                        */
+/* ************************************************************************** */
+
+/**
+ * @brief Calls `fn` for every non-empty chunk matching `query`, on the caller.
+ */
+void ce_ecs_query_each(ce_ecs_world* world, const ce_ecs_query* query, ce_ecs_chunk_fn fn, void* user);
+
+/**
+ * @brief Entities matching `query`.
+ */
+ce_u32 ce_ecs_query_count(ce_ecs_world* world, const ce_ecs_query* query);
+
+/**
+ * @brief Appends a system; it runs after every earlier system it conflicts
+ *        with (one writes what the other reads or writes).
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FULL.
+ */
+ce_result ce_ecs_system_add(ce_ecs_world* world, const ce_ecs_system_desc* desc, ce_u32* out_index);
+
+/**
+ * @brief Runs every system once across the job pool, then ce_ecs_flush.
+ */
+void ce_ecs_run(ce_ecs_world* world);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_ECS_H */
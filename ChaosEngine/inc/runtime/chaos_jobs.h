@@ -15,11 +15,83 @@
 #ifndef CHAOS_JOBS_H
 #define CHAOS_JOBS_H
 
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "platform/chaos_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Public API skeleton */
+/** @brief Upper bound on job threads (workers + the submitting thread). */
+#define CE_JOBS_MAX_THREADS 64u
+
+/**
+ * @brief Job entry point.
+ */
+typedef void (*ce_job_fn)(void* user);
+
+/**
+ * @brief Range body for ce_jobs_parallel_for: processes [begin, end).
+ */
+typedef void (*ce_job_range_fn)(void* user, ce_u32 begin, ce_u32 end);
+
+/**
+ * @brief Completion counter shared by a group of jobs (zero-initialize).
+ */
+typedef struct ce_job_counter_s {
+    ce_atomic_u32 pending;
+} ce_job_counter;
+
+/**
+ * @brief Starts the worker pool.
+ * @param worker_count Worker threads (0 = hardware threads - 1).
+ * @return CE_OK or an error code.
+ *
+ * Without a pool every call below runs inline on the caller, so code using
+ * jobs works unchanged in single-threaded tools and tests.
+ */
+ce_result ce_jobs_init(ce_u32 worker_count);
+
+/**
+ * @brief Drains the queue and joins every worker.
+ */
+void ce_jobs_shutdown(void);
+
+/**
+ * @brief Number of worker threads (0 when the pool is not running).
+ */
+ce_u32 ce_jobs_worker_count(void);
+
+/**
+ * @brief Stable index of the calling thread: 0 for non-worker threads,
+ *        1..ce_jobs_worker_count() for workers.
+ */
+ce_u32 ce_jobs_thread_index(void);
+
+/**
+ * @brief Queues a job (runs it inline when the pool is absent or full).
+ * @param fn Job entry point.
+ * @param user Argument passed to fn.
+ * @param counter Incremented now, decremented when the job completes (may be CE_NULL).
+ * @return CE_OK or CE_ERR_INVALID_ARG.
+ */
+ce_result ce_jobs_submit(ce_job_fn fn, void* user, ce_job_counter* counter);
+
+/**
+ * @brief Blocks until `counter` reaches zero, running queued jobs meanwhile.
+ */
+void ce_jobs_wait(ce_job_counter* counter);
+
+/**
+ * @brief Splits [0, count) into batches of at least `min_batch` items and
+ *        runs them across the pool; returns when every batch is done.
+ * @param count Number of items.
+ * @param min_batch Smallest batch worth a job (0 treated as 1).
+ * @param fn Range body.
+ * @param user Argument passed to fn.
+ */
+void ce_jobs_parallel_for(ce_u32 count, ce_u32 min_batch, ce_job_range_fn fn, void* user);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,64 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_profiling.h
+ * @brief Profiling views: memory overlay and JSON dump of the allocation tracker.
+ * @author PapaPamplemousse
+ *
+ * Both read ce_mem_get_tag_stats() / ce_mem_get_top_sites(); in a build
+ * without CE_MEM_TRACKING they report zeros and say so.
+ */
+#ifndef CHAOS_PROFILING_H
+#define CHAOS_PROFILING_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "gfx/chaos_draw.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Callsites listed by the overlay. */
+#define CE_PROFILING_OVERLAY_SITES 8u
+/** @brief Longest overlay line, terminator included. */
+#define CE_PROFILING_LINE_MAX      160u
+
+/**
+ * @brief Writes per-tag stats and the `max_sites` largest callsites as JSON.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_IO.
+ */
+ce_result ce_profiling_memory_json(const ce_char* path, ce_u32 max_sites);
+
+/**
+ * @brief Formats line `index` of the memory overlay.
+ *
+ * Line 0 is the header, then one line per tag, then the top callsites.
+ *
+ * @param out_over CE_TRUE when the line is a tag over its budget (may be CE_NULL).
+ * @return CE_FALSE once `index` is past the last line.
+ */
+ce_bool ce_profiling_memory_line(ce_u32 index, ce_char* out, ce_size cap, ce_bool* out_over);
+
+/**
+ * @brief Draws the memory overlay as text, over-budget tags in red.
+ * @param x Left edge, pixels.
+ * @param y Top edge, pixels.
+ * @param size_px Line pixel size.
+ * @return CE_OK or the first ce_draw_text() error.
+ */
+ce_result ce_profiling_draw_memory(ce_sprite_batch* batch, ce_text_cache* cache, ce_f32 x, ce_f32 y,
+                                   ce_f32 size_px, ce_u16 layer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_PROFILING_H */
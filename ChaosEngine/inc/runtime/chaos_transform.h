@@ -0,0 +1,127 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_transform.h
+ * @brief Transform hierarchy with dirty-subtree world matrix updates.
+ * @author PapaPamplemousse
+ *
+ * Nodes are stored structure-of-arrays in breadth-first order: every node
+ * of depth d comes before every node of depth d + 1, so a parent is always
+ * final before its children are visited. ce_transform_update walks the
+ * levels in order, 8 nodes per SIMD step and each level split across the
+ * job pool, and skips any 8-node group with nothing dirty in it: moving a
+ * prop deep in the tree costs its own subtree, not the scene.
+ *
+ * Reparenting moves the subtree between levels with O(depth) swaps per
+ * node instead of re-sorting the whole array. Local transforms are SoA
+ * streams; world matrices are affine float matrices in the chaos_math.h
+ * convention, one contiguous row per node so a child's parent lookup is a
+ * single cache line.
+ */
+#ifndef CHAOS_TRANSFORM_H
+#define CHAOS_TRANSFORM_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+#include "core/chaos_math.h"
+#include "resources/chaos_handles.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Levels in a hierarchy (roots are depth 0). */
+#define CE_TRANSFORM_MAX_DEPTH 32u
+
+/** @brief Node handle; CE_HANDLE_NONE is never issued and means "no parent". */
+typedef ce_handle ce_transform_id;
+
+typedef struct ce_transform_hierarchy_s ce_transform_hierarchy;
+
+typedef struct ce_transform_hierarchy_desc_s {
+    ce_u32 max_nodes; /**< At most CE_HANDLE_MAX_CAPACITY. */
+} ce_transform_hierarchy_desc;
+
+typedef struct ce_transform_stats_s {
+    ce_u32 nodes;
+    ce_u32 levels;     /**< Depth of the deepest node + 1. */
+    ce_u32 recomputed; /**< World matrices computed by the last update (whole 8-node groups). */
+} ce_transform_stats;
+
+/* ************************************************************************** */
+/* HIERARCHY                                                                  */
+/* ************************************************************************** */
+
+/**
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_OUT_OF_MEMORY.
+ */
+ce_result ce_transform_hierarchy_create(const ce_transform_hierarchy_desc* desc, ce_transform_hierarchy** out_hierarchy);
+
+void ce_transform_hierarchy_destroy(ce_transform_hierarchy* hierarchy);
+
+/**
+ * @brief Recomputes the world matrix of every node whose local transform,
+ *        or an ancestor's, changed since the last update.
+ */
+void ce_transform_update(ce_transform_hierarchy* hierarchy);
+
+void ce_transform_get_stats(const ce_transform_hierarchy* hierarchy, ce_transform_stats* out_stats);
+
+/* ************************************************************************** */
+/* NODES                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Adds a node with an identity local transform.
+ * @param parent CE_HANDLE_NONE for a root.
+ * @return CE_OK, CE_ERR_INVALID_ARG, CE_ERR_NOT_FOUND (stale parent) or
+ *         CE_ERR_FULL (no free node, or deeper than CE_TRANSFORM_MAX_DEPTH).
+ */
+ce_result ce_transform_create(ce_transform_hierarchy* hierarchy, ce_transform_id parent, ce_transform_id* out_id);
+
+/**
+ * @brief Removes a node and all of its descendants.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_NOT_FOUND.
+ */
+ce_result ce_transform_destroy(ce_transform_hierarchy* hierarchy, ce_transform_id id);
+
+/**
+ * @brief Moves a node (with its subtree) under `parent`, keeping its local
+ *        transform.
+ * @param parent CE_HANDLE_NONE to make it a root.
+ * @return CE_OK, CE_ERR_INVALID_ARG (parent inside the subtree),
+ *         CE_ERR_NOT_FOUND or CE_ERR_FULL (too deep).
+ */
+ce_result ce_transform_set_parent(ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_transform_id parent);
+
+/**
+ * @return Parent handle, or CE_HANDLE_NONE for roots and stale handles.
+ */
+ce_transform_id ce_transform_get_parent(const ce_transform_hierarchy* hierarchy, ce_transform_id id);
+
+/**
+ * @brief Sets translation, rotation (unit quaternion) and scale relative to
+ *        the parent.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_NOT_FOUND.
+ */
+ce_result ce_transform_set_local(ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_vec3f t, ce_quatf r,
+                                 ce_vec3f s);
+
+/**
+ * @brief World matrix as of the last ce_transform_update.
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_NOT_FOUND.
+ */
+ce_result ce_transform_get_world(const ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_mat4f* out_world);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_TRANSFORM_H */
@@ -0,0 +1,94 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_conv.h
+ * @brief Number <-> text conversions (no allocation, caller buffers).
+ * @author PapaPamplemousse
+ *
+ * Integers are written two digits at a time from a pair table. Floats are
+ * written as the shortest decimal that parses back to the same value (Ryu),
+ * in fixed notation for moderate exponents and scientific otherwise.
+ * Parsers take explicit lengths so they work on slices of a text asset.
+ */
+#ifndef CHAOS_CONV_H
+#define CHAOS_CONV_H
+
+#include "core/chaos_types.h"
+#include "core/chaos_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Buffer sizes (terminating NUL included) that always fit the output. */
+#define CE_CONV_U64_CAP 21u  /* "18446744073709551615" */
+#define CE_CONV_I64_CAP 21u  /* "-9223372036854775808" */
+#define CE_CONV_F64_CAP 26u  /* "-0.000001234567890123456" */
+#define CE_CONV_F32_CAP 23u  /* "-123456790000000000000" */
+
+/* ************************************************************************** */
+/* FORMATTING                                                                 */
+/* ************************************************************************** */
+
+/**
+ * @brief Writes `value` in decimal and NUL-terminates it.
+ * @return Characters written (NUL excluded), or 0 when `cap` is too small
+ *         (dst is then set to "" if cap > 0).
+ */
+ce_size ce_u64_to_str(ce_u64 value, ce_char* dst, ce_size cap);
+ce_size ce_i64_to_str(ce_s64 value, ce_char* dst, ce_size cap);
+
+/**
+ * @brief Shortest round-trip decimal of `value`.
+ *
+ * Plain digits for 1e-6 <= |value| < 1e21 ("100", "0.1", "0.00025"),
+ * "d.ddde±x" otherwise ("1e+21", "2.5e-7"); "nan", "inf", "-inf" and
+ * "-0" for the special values. Same return contract as ce_u64_to_str().
+ */
+ce_size ce_f64_to_str(ce_f64 value, ce_char* dst, ce_size cap);
+
+/** @brief Shortest decimal that reads back as the same ce_f32. */
+ce_size ce_f32_to_str(ce_f32 value, ce_char* dst, ce_size cap);
+
+/* ************************************************************************** */
+/* PARSING                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Parses an optionally '+'-signed decimal integer at the start of s[0..len).
+ * @param out_used Optional, receives the characters consumed.
+ * @return CE_OK, CE_ERR_INVALID_ARG, or CE_ERR_FORMAT (no digit, out of range).
+ *         On CE_ERR_FORMAT, *out_value and *out_used are set to 0.
+ */
+ce_result ce_str_to_u64(const ce_char* s, ce_size len, ce_u64* out_value, ce_size* out_used);
+
+/** @brief Signed variant of ce_str_to_u64(), with the same zeroing on error. */
+ce_result ce_str_to_i64(const ce_char* s, ce_size len, ce_s64* out_value, ce_size* out_used);
+
+/**
+ * @brief Parses a decimal float ("-1.5e3", ".5", "inf", "nan") at the start of s[0..len).
+ *
+ * Correctly rounded. Values with at most 19 significant digits and a small
+ * exponent take an exact floating-point fast path; the others are rebuilt
+ * into a bounded stack buffer and handed to the C library. Overflow gives
+ * ±inf and CE_OK, as in IEEE arithmetic.
+ *
+ * @return CE_OK, CE_ERR_INVALID_ARG or CE_ERR_FORMAT (no digit).
+ */
+ce_result ce_str_to_f64(const ce_char* s, ce_size len, ce_f64* out_value, ce_size* out_used);
+
+/** @brief ce_f32 variant, rounded once (not through ce_f64). */
+ce_result ce_str_to_f32(const ce_char* s, ce_size len, ce_f32* out_value, ce_size* out_used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHAOS_CONV_H */
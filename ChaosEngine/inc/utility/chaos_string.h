@@ -16,7 +16,15 @@
 #define CHAOS_STRING_H
 
 #include "core/chaos_types.h"
+#include "core/chaos_defs.h"
 
+/** @brief Lengths from which ce__memcmp hands over to the dispatched SIMD kernel. */
+#define CE_STRING_BULK_MIN ((ce_size)64)
+
+/**
+ * @brief Out-of-line ce__memcmp for long ranges (CPU-dispatched, same result).
+ */
+ce_s32 ce__mem_compare_bulk(const void* a, const void* b, ce_size n);
 
 /**
 * @brief Copies exactly n bytes from src to dst (non-overlapping expected, like standard memcpy).
@@ -114,6 +122,8 @@ static inline ce_s32 ce__memcmp(const void* a, const void* b, ce_size n)
         if (n != (ce_size)0) {
             ret = 0; /* Defensive neutral value; alternatively: define an error policy. */
         }
+    } else if (CE_UNLIKELY(n >= CE_STRING_BULK_MIN)) {
+        ret = ce__mem_compare_bulk(a, b, n);
     } else {
         while ((i < n) && (ret == 0)) {
             av = aptr[i];
@@ -0,0 +1,255 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_audio_null.c
+ * @brief Headless audio device: engine-clocked rendering to WAV, memory or nothing.
+ */
+#include "audio/chaos_audio.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "utility/chaos_string.h"
+
+#include <stdio.h>
+
+#define CE__WAV_HEADER_BYTES 58u
+#define CE__WAV_FORMAT_FLOAT 3u
+
+struct ce_audio_device_s {
+    ce_mixer*     mixer;
+    ce_u32        sample_rate;
+    ce_u32        block_frames;
+    ce_f32*       block;          /* 2 * block_frames interleaved. */
+    ce_audio_sink sink;
+    FILE*         wav;
+    ce_u64        wav_frames;
+    ce_f32*       memory;
+    ce_u32        memory_frames;
+    ce_u32        memory_used;
+    ce_u64*       block_ns;
+    ce_u32        block_ns_capacity;
+    ce_u64        block_budget_ns;
+    ce_u64        origin_ns;
+    ce_u64        clock_frames;   /* Frames pumped since the origin. */
+    ce_audio_device_stats stats;
+};
+
+/* ************************************************************************** */
+/* WAV SINK                                                                   */
+/* ************************************************************************** */
+
+static void ce__put_u16(ce_u8* p, ce_u32 v)
+{
+    p[0] = (ce_u8)(v & 0xFFu);
+    p[1] = (ce_u8)((v >> 8) & 0xFFu);
+}
+
+static void ce__put_u32(ce_u8* p, ce_u32 v)
+{
+    ce__put_u16(p, v & 0xFFFFu);
+    ce__put_u16(p + 2, v >> 16);
+}
+
+/* WAVE_FORMAT_IEEE_FLOAT with the fact chunk non-PCM formats require. */
+static ce_bool ce__wav_write_header(FILE* f, ce_u32 sample_rate, ce_u64 frames)
+{
+    ce_u8 h[CE__WAV_HEADER_BYTES];
+    ce_u32 data_bytes;
+
+    data_bytes = (frames > 0x1FFFFFF0ull) ? 0xFFFFFF80u : (ce_u32)(frames * 8u);
+
+    ce__memcpy(h, "RIFF", 4u);
+    ce__put_u32(h + 4, data_bytes + CE__WAV_HEADER_BYTES - 8u);
+    ce__memcpy(h + 8, "WAVEfmt ", 8u);
+    ce__put_u32(h + 16, 18u);
+    ce__put_u16(h + 20, CE__WAV_FORMAT_FLOAT);
+    ce__put_u16(h + 22, 2u);
+    ce__put_u32(h + 24, sample_rate);
+    ce__put_u32(h + 28, sample_rate * 8u);
+    ce__put_u16(h + 32, 8u);
+    ce__put_u16(h + 34, 32u);
+    ce__put_u16(h + 36, 0u);
+    ce__memcpy(h + 38, "fact", 4u);
+    ce__put_u32(h + 42, 4u);
+    ce__put_u32(h + 46, data_bytes / 8u);
+    ce__memcpy(h + 50, "data", 4u);
+    ce__put_u32(h + 54, data_bytes);
+
+    return (fwrite(h, 1u, (size_t)CE__WAV_HEADER_BYTES, f) == (size_t)CE__WAV_HEADER_BYTES) ? CE_TRUE : CE_FALSE;
+}
+
+/* ************************************************************************** */
+/* DEVICE                                                                     */
+/* ************************************************************************** */
+
+ce_result ce_audio_device_open(const ce_audio_device_desc* desc, ce_audio_device** out_device)
+{
+    ce_result result;
+    ce_audio_device* dev;
+
+    result = CE_OK;
+    dev    = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_device == CE_NULL) || (desc->mixer == CE_NULL) ||
+        ((desc->sink == CE_AUDIO_SINK_WAV) && (desc->wav_path == CE_NULL)) ||
+        ((desc->sink == CE_AUDIO_SINK_MEMORY) && (desc->memory == CE_NULL)) ||
+        ((desc->block_ns == CE_NULL) && (desc->block_ns_capacity != 0u))) {
+        result = CE_ERR_INVALID_ARG;
+    } else if (desc->backend != CE_AUDIO_BACKEND_NULL) {
+        /* The live backend belongs to chaos_audio_miniaudio.c. */
+        result = CE_ERR_UNSUPPORTED;
+    } else {
+        dev = (ce_audio_device*)ce_mem_calloc(sizeof(ce_audio_device), 8u, CE_MEM_TAG_AUDIO);
+        if (dev == CE_NULL) {
+            result = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (result == CE_OK) {
+        dev->mixer             = desc->mixer;
+        dev->sample_rate       = ce_mixer_sample_rate(desc->mixer);
+        dev->block_frames      = (desc->block_frames != 0u) ? desc->block_frames : CE_MIXER_BLOCK_FRAMES;
+        dev->sink              = desc->sink;
+        dev->memory            = desc->memory;
+        dev->memory_frames     = desc->memory_frames;
+        dev->block_ns          = desc->block_ns;
+        dev->block_ns_capacity = desc->block_ns_capacity;
+        dev->block_budget_ns   = ((ce_u64)dev->block_frames * CE_NS_PER_S) / (ce_u64)dev->sample_rate;
+        dev->stats.callback_ns_min = ~0ull;
+
+        dev->block = (ce_f32*)ce_mem_alloc((ce_size)dev->block_frames * 2u * sizeof(ce_f32), 32u,
+                                           CE_MEM_TAG_AUDIO);
+        if (dev->block == CE_NULL) {
+            result = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if ((result == CE_OK) && (dev->sink == CE_AUDIO_SINK_WAV)) {
+        dev->wav = fopen(desc->wav_path, "wb");
+        if ((dev->wav == CE_NULL) || (ce__wav_write_header(dev->wav, dev->sample_rate, 0u) == CE_FALSE)) {
+            result = CE_ERR_IO;
+        }
+    }
+
+    if (result == CE_OK) {
+        *out_device = dev;
+    } else if (dev != CE_NULL) {
+        ce_audio_device_close(dev);
+    } else {
+        /* Nothing allocated. */
+    }
+    return result;
+}
+
+void ce_audio_device_close(ce_audio_device* device)
+{
+    if (device != CE_NULL) {
+        if (device->wav != CE_NULL) {
+            if (fseek(device->wav, 0L, SEEK_SET) == 0) {
+                (void)ce__wav_write_header(device->wav, device->sample_rate, device->wav_frames);
+            }
+            (void)fclose(device->wav);
+        }
+        ce_mem_free(device->block);
+        ce_mem_free(device);
+    }
+}
+
+/* One callback: mix, deliver, time the whole thing. */
+static void ce__audio_device_block(ce_audio_device* dev, ce_u32 frames)
+{
+    ce_u64 start;
+    ce_u64 elapsed;
+    ce_u32 n;
+
+    start = ce_time_now_ns();
+    ce_mixer_render(dev->mixer, dev->block, frames);
+
+    if (dev->sink == CE_AUDIO_SINK_MEMORY) {
+        n = dev->memory_frames - dev->memory_used;
+        n = (frames < n) ? frames : n;
+        ce__memcpy(dev->memory + ((ce_size)dev->memory_used * 2u), dev->block, (ce_size)n * 2u * sizeof(ce_f32));
+        dev->memory_used += n;
+        dev->stats.frames_dropped += (ce_u64)(frames - n);
+    } else if (dev->sink == CE_AUDIO_SINK_WAV) {
+        n = (ce_u32)fwrite(dev->block, sizeof(ce_f32) * 2u, (size_t)frames, dev->wav);
+        dev->wav_frames += (ce_u64)n;
+        dev->stats.frames_dropped += (ce_u64)(frames - n);
+    } else {
+        /* Discard. */
+    }
+    elapsed = ce_time_now_ns() - start;
+
+    if (dev->stats.blocks < (ce_u64)dev->block_ns_capacity) {
+        dev->block_ns[dev->stats.blocks] = elapsed;
+    }
+    dev->stats.blocks++;
+    dev->stats.frames += (ce_u64)frames;
+    dev->stats.callback_ns_last   = elapsed;
+    dev->stats.callback_ns_total += elapsed;
+    dev->stats.callback_ns_min    = (elapsed < dev->stats.callback_ns_min) ? elapsed : dev->stats.callback_ns_min;
+    dev->stats.callback_ns_max    = (elapsed > dev->stats.callback_ns_max) ? elapsed : dev->stats.callback_ns_max;
+    if (elapsed > dev->block_budget_ns) {
+        dev->stats.deadline_misses++;
+    }
+}
+
+void ce_audio_device_start(ce_audio_device* device, ce_u64 now_ns)
+{
+    device->origin_ns    = now_ns;
+    device->clock_frames = 0u;
+}
+
+ce_u32 ce_audio_device_pump(ce_audio_device* device, ce_u64 now_ns)
+{
+    ce_u64 elapsed;
+    ce_u64 due;
+    ce_u32 rendered;
+
+    rendered = 0u;
+    elapsed  = (now_ns > device->origin_ns) ? (now_ns - device->origin_ns) : 0u;
+
+    /* Split so the product cannot overflow however long the session runs. */
+    due = ((elapsed / CE_NS_PER_S) * (ce_u64)device->sample_rate) +
+          (((elapsed % CE_NS_PER_S) * (ce_u64)device->sample_rate) / CE_NS_PER_S);
+
+    /* A clock behind the frames already rendered (rewound, or before the origin) renders nothing. */
+    while ((due > device->clock_frames) && ((due - device->clock_frames) >= (ce_u64)device->block_frames)) {
+        ce__audio_device_block(device, device->block_frames);
+        device->clock_frames += (ce_u64)device->block_frames;
+        rendered += device->block_frames;
+    }
+    return rendered;
+}
+
+void ce_audio_device_render(ce_audio_device* device, ce_u32 frames)
+{
+    ce_u32 left;
+    ce_u32 n;
+
+    left = frames;
+    while (left > 0u) {
+        n = (left < device->block_frames) ? left : device->block_frames;
+        ce__audio_device_block(device, n);
+        left -= n;
+    }
+}
+
+ce_u32 ce_audio_device_memory_frames(const ce_audio_device* device)
+{
+    return device->memory_used;
+}
+
+void ce_audio_device_get_stats(const ce_audio_device* device, ce_audio_device_stats* out_stats)
+{
+    *out_stats = device->stats;
+    if (out_stats->blocks == 0u) {
+        out_stats->callback_ns_min = 0u;
+    }
+}
@@ -0,0 +1,626 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_audio_stream.c
+ * @brief Worker-fed streaming rings.
+ *
+ * Each stream is a planar float ring with free-running frame counters:
+ * the worker publishes decoded frames with a release store of `write`,
+ * the consumer frees them with a release store of `read`. A seek moves
+ * `discard` to the current write position so the consumer skips whatever
+ * was buffered before it; those frames stay reserved until the consumer has
+ * moved `read` past them, since it may still be reading them. Stream lists and seek / loop requests are guarded
+ * by the streamer mutex, which the audio thread never takes.
+ *
+ * Streams at a foreign rate decode into a staging buffer that keeps the
+ * kernel's history, and are resampled from there into the ring.
+ */
+#include "audio/chaos_audio_stream.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_memory.h"
+#include "platform/chaos_thread.h"
+#include "utility/chaos_string.h"
+
+#define CE_STREAM_DEFAULT_CHUNK 4096u
+#define CE_STREAM_DEFAULT_POLL  2u
+#define CE_STREAM_NO_EOF        (~0ull)
+
+struct ce_audio_stream_s {
+    CE_CACHE_ALIGNED ce_atomic_u64 write;
+    CE_CACHE_ALIGNED ce_atomic_u64 read;
+    CE_CACHE_ALIGNED ce_atomic_u64 discard;
+    ce_atomic_u64       eof_at;
+    ce_atomic_u32       ready;
+    ce_atomic_u32       underruns;
+    ce_atomic_u64       underrun_frames;
+
+    ce_f32*             ring[2];
+    ce_u32              capacity;
+    ce_u32              mask;
+    ce_u32              prefetch;
+    ce_u32              out_rate;
+    ce_audio_info       info;
+
+    /* Worker side, guarded by the streamer lock. */
+    ce_audio_decoder*   decoder;
+    ce_audio_streamer*  owner;
+    ce_audio_stream*    next;
+    ce_u64              seek_frame;
+    ce_bool             seek_pending;
+    ce_bool             loop;
+    ce_bool             decoder_done;
+    ce_bool             input_done;
+    ce_bool             rewound;
+
+    /* Resampling (stage[0] == CE_NULL at the source rate). */
+    ce_resample_quality quality;
+    ce_resample_table   table;
+    ce_f32*             stage[2];
+    ce_u32              stage_count;
+    ce_u32              stage_capacity;
+    ce_u64              stage_pos;
+    ce_u64              step;
+};
+
+struct ce_audio_streamer_s {
+    ce_thread        thread;
+    ce_mutex         lock;
+    ce_atomic_u32    running;
+    ce_audio_stream* streams;
+    ce_u32           chunk_frames;
+    ce_u32           poll_ms;
+};
+
+/* ************************************************************************** */
+/* WORKER                                                                     */
+/* ************************************************************************** */
+
+static inline ce_u64 ce__stream_consumer_pos(const ce_audio_stream* s)
+{
+    ce_u64 r;
+    ce_u64 d;
+
+    r = ce_atomic_load_u64(&s->read);
+    d = ce_atomic_load_u64(&s->discard);
+
+    return (r > d) ? r : d;
+}
+
+/**
+ * @brief Stream with the fewest buffered frames that has room for a chunk.
+ *
+ * Room is measured from `read`: frames behind a seek are not free until the
+ * consumer has stepped over them.
+ */
+static ce_audio_stream* ce__streamer_pick(ce_audio_streamer* streamer)
+{
+    ce_audio_stream* s;
+    ce_audio_stream* best;
+    ce_u64 w;
+    ce_u64 used;
+    ce_u64 buffered;
+    ce_u64 best_buffered;
+
+    best          = CE_NULL;
+    best_buffered = CE_STREAM_NO_EOF;
+
+    for (s = streamer->streams; s != CE_NULL; s = s->next) {
+        w        = ce_atomic_load_relaxed_u64(&s->write);
+        used     = w - ce_atomic_load_u64(&s->read);
+        buffered = w - ce__stream_consumer_pos(s);
+        if ((s->seek_pending == CE_TRUE) ||
+            ((s->decoder_done == CE_FALSE) &&
+             (((ce_u64)s->capacity - used) >= (ce_u64)streamer->chunk_frames) &&
+             (buffered < best_buffered))) {
+            best          = s;
+            best_buffered = (s->seek_pending == CE_TRUE) ? 0u : buffered;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief The source ran out: rewind for a loop, otherwise mark the input finished.
+ */
+static void ce__stream_input_end(ce_audio_stream* s)
+{
+    if ((s->loop == CE_TRUE) && (s->rewound == CE_FALSE) && (ce_audio_decoder_seek(s->decoder, 0u) == CE_OK)) {
+        s->rewound = CE_TRUE;
+    } else {
+        /* End of data, or a loop that rewound onto nothing. */
+        s->input_done = CE_TRUE;
+    }
+}
+
+/**
+ * @brief Empties the staging buffer down to the kernel's zeroed history.
+ */
+static void ce__stream_stage_reset(ce_audio_stream* s)
+{
+    ce_u32 before;
+    ce_u32 c;
+
+    before = CE_RESAMPLE_BEFORE(s->quality);
+    for (c = 0u; c < s->info.channel_count; c++) {
+        (void)ce__memset(s->stage[c], 0u, (ce_size)before * sizeof(ce_f32));
+    }
+    s->stage_count = before;
+    s->stage_pos   = (ce_u64)before << 32u;
+}
+
+/**
+ * @brief Tops up the staging buffer, then resamples up to `want` frames into `dst`.
+ * @return Frames written.
+ */
+static ce_u32 ce__stream_resample(ce_audio_stream* s, ce_f32* const dst[2], ce_u32 want, ce_u32 chunk)
+{
+    ce_f32* in[2];
+    ce_u32 before;
+    ce_u32 after;
+    ce_u32 room;
+    ce_u32 got;
+    ce_u32 keep;
+    ce_u32 n;
+    ce_u32 c;
+
+    before = CE_RESAMPLE_BEFORE(s->quality);
+    after  = CE_RESAMPLE_AFTER(s->quality);
+
+    /* `after` frames stay reserved for the zero tail that flushes the kernel. */
+    room = ((s->stage_count + after) < s->stage_capacity) ? (s->stage_capacity - s->stage_count - after) : 0u;
+    room = (room < chunk) ? room : chunk;
+    if ((s->input_done == CE_FALSE) && (room != 0u)) {
+        in[0] = &s->stage[0][s->stage_count];
+        in[1] = (s->stage[1] != CE_NULL) ? &s->stage[1][s->stage_count] : CE_NULL;
+        got   = ce_audio_decoder_read(s->decoder, in, room);
+        s->stage_count += got;
+        if (got != 0u) {
+            s->rewound = CE_FALSE;
+        }
+        if (got < room) {
+            ce__stream_input_end(s);
+            if (s->input_done == CE_TRUE) {
+                for (c = 0u; c < s->info.channel_count; c++) {
+                    (void)ce__memset(&s->stage[c][s->stage_count], 0u, (ce_size)after * sizeof(ce_f32));
+                }
+                s->stage_count += after;
+            }
+        }
+    }
+
+    n = ce_resample_interior_frames(s->quality, s->stage_pos, s->step, s->stage_count, want);
+    for (c = 0u; (c < s->info.channel_count) && (n != 0u); c++) {
+        if (s->quality == CE_RESAMPLE_POLYPHASE) {
+            ce_resample_polyphase(&s->table, s->stage[c], s->stage_pos, s->step, dst[c], n);
+        } else {
+            ce_resample_linear(s->stage[c], s->stage_pos, s->step, dst[c], n);
+        }
+    }
+    s->stage_pos += (ce_u64)n * s->step;
+
+    /* Slide the history the next output still needs to the front. */
+    keep = (ce_u32)(s->stage_pos >> 32u) - before;
+    if (keep != 0u) {
+        for (c = 0u; c < s->info.channel_count; c++) {
+            (void)ce__memmove(s->stage[c], &s->stage[c][keep], (ce_size)(s->stage_count - keep) * sizeof(ce_f32));
+        }
+        s->stage_count -= keep;
+        s->stage_pos   -= (ce_u64)keep << 32u;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Applies a pending seek, then decodes one chunk into the ring.
+ */
+static void ce__stream_service(ce_audio_stream* s, ce_u32 chunk)
+{
+    ce_f32* dst[2];
+    ce_u64 w;
+    ce_u32 at;
+    ce_u32 want;
+    ce_u32 got;
+
+    w = ce_atomic_load_relaxed_u64(&s->write);
+
+    if (s->seek_pending == CE_TRUE) {
+        (void)ce_audio_decoder_seek(s->decoder, s->seek_frame);
+        ce_atomic_store_u32(&s->ready, 0u);
+        ce_atomic_store_u64(&s->eof_at, CE_STREAM_NO_EOF);
+        ce_atomic_store_u64(&s->discard, w);
+        s->seek_pending = CE_FALSE;
+        s->decoder_done = CE_FALSE;
+        s->input_done   = CE_FALSE;
+        s->rewound      = CE_FALSE;
+        if (s->stage[0] != CE_NULL) {
+            ce__stream_stage_reset(s);
+        }
+    }
+
+    /*
+     * Stay within the free space and before the physical end of the ring.
+     * Frames below `discard` are not free yet: the consumer may still hold
+     * them from an acquire, and releases them once it has applied the seek.
+     */
+    at   = (ce_u32)(w & s->mask);
+    want = s->capacity - (ce_u32)(w - ce_atomic_load_u64(&s->read));
+    want = (want < chunk) ? want : chunk;
+    want = (want < (s->capacity - at)) ? want : (s->capacity - at);
+
+    dst[0] = &s->ring[0][at];
+    dst[1] = (s->ring[1] != CE_NULL) ? &s->ring[1][at] : CE_NULL;
+
+    if (want == 0u) {
+        got = 0u;
+    } else if (s->stage[0] != CE_NULL) {
+        got = ce__stream_resample(s, dst, want, chunk);
+        /* Input finished and the stage can no longer produce a frame. */
+        s->decoder_done = ((got == 0u) && (s->input_done == CE_TRUE)) ? CE_TRUE : CE_FALSE;
+    } else {
+        got = ce_audio_decoder_read(s->decoder, dst, want);
+        if (got != 0u) {
+            s->rewound = CE_FALSE;
+        }
+        if (got < want) {
+            ce__stream_input_end(s);
+            s->decoder_done = s->input_done;
+        }
+    }
+
+    if (got != 0u) {
+        w += got;
+        ce_atomic_store_u64(&s->write, w);
+    }
+
+    if (s->decoder_done == CE_TRUE) {
+        ce_atomic_store_u64(&s->eof_at, w);
+        ce_atomic_store_u32(&s->ready, 1u);
+    }
+    if ((w - ce__stream_consumer_pos(s)) >= (ce_u64)s->prefetch) {
+        ce_atomic_store_u32(&s->ready, 1u);
+    }
+}
+
+static void ce__streamer_main(void* user)
+{
+    ce_audio_streamer* streamer;
+    ce_audio_stream* s;
+
+    streamer = (ce_audio_streamer*)user;
+
+    while (ce_atomic_load_u32(&streamer->running) != 0u) {
+        /* One chunk per lock hold keeps open / close / seek responsive. */
+        ce_mutex_lock(&streamer->lock);
+        s = ce__streamer_pick(streamer);
+        if (s != CE_NULL) {
+            ce__stream_service(s, streamer->chunk_frames);
+        }
+        ce_mutex_unlock(&streamer->lock);
+
+        if (s == CE_NULL) {
+            ce_thread_sleep_ms(streamer->poll_ms);
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* STREAMER                                                                   */
+/* ************************************************************************** */
+
+ce_result ce_audio_streamer_create(const ce_audio_streamer_desc* desc, ce_audio_streamer** out_streamer)
+{
+    ce_audio_streamer* streamer;
+    ce_result res;
+
+    streamer = CE_NULL;
+    res      = CE_OK;
+
+    if (out_streamer == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        streamer = (ce_audio_streamer*)ce_mem_calloc(sizeof(ce_audio_streamer), 0u, CE_MEM_TAG_AUDIO);
+        res      = (streamer != CE_NULL) ? ce_mutex_init(&streamer->lock) : CE_ERR_OUT_OF_MEMORY;
+    }
+
+    if (res == CE_OK) {
+        streamer->chunk_frames = ((desc != CE_NULL) && (desc->chunk_frames != 0u)) ? desc->chunk_frames
+                                                                                    : CE_STREAM_DEFAULT_CHUNK;
+        streamer->poll_ms      = ((desc != CE_NULL) && (desc->poll_ms != 0u)) ? desc->poll_ms : CE_STREAM_DEFAULT_POLL;
+        ce_atomic_store_u32(&streamer->running, 1u);
+        res = ce_thread_create(&streamer->thread, ce__streamer_main, streamer, "ce_audio_io");
+        if (res != CE_OK) {
+            ce_mutex_destroy(&streamer->lock);
+        }
+    }
+
+    if ((res != CE_OK) && (streamer != CE_NULL)) {
+        ce_mem_free(streamer);
+        streamer = CE_NULL;
+    }
+    if (out_streamer != CE_NULL) {
+        *out_streamer = streamer;
+    }
+
+    return res;
+}
+
+void ce_audio_streamer_destroy(ce_audio_streamer* streamer)
+{
+    if (streamer != CE_NULL) {
+        ce_atomic_store_u32(&streamer->running, 0u);
+        ce_thread_join(&streamer->thread);
+        ce_mutex_destroy(&streamer->lock);
+        ce_mem_free(streamer);
+    }
+}
+
+/* ************************************************************************** */
+/* STREAMS                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Staging buffers and polyphase table for a stream resampled on the worker.
+ */
+static ce_result ce__stream_stage_init(ce_audio_stream* s, ce_u32 chunk)
+{
+    ce_result res;
+    ce_u32 c;
+
+    res = CE_OK;
+    if (s->quality == CE_RESAMPLE_POLYPHASE) {
+        res = ce_resample_table_init(&s->table, s->info.sample_rate, s->out_rate);
+    }
+
+    s->stage_capacity = chunk + (CE_RESAMPLE_TAPS * 2u);
+    for (c = 0u; (c < s->info.channel_count) && (res == CE_OK); c++) {
+        s->stage[c] = (ce_f32*)ce_mem_alloc((ce_size)s->stage_capacity * sizeof(ce_f32), (ce_size)64,
+                                            CE_MEM_TAG_AUDIO);
+        res         = (s->stage[c] != CE_NULL) ? CE_OK : CE_ERR_OUT_OF_MEMORY;
+    }
+
+    if (res == CE_OK) {
+        ce__stream_stage_reset(s);
+    }
+
+    return res;
+}
+
+static void ce__stream_free(ce_audio_stream* s)
+{
+    ce_audio_decoder_close(s->decoder);
+    ce_resample_table_shutdown(&s->table);
+    ce_mem_free(s->stage[0]);
+    ce_mem_free(s->stage[1]);
+    ce_mem_free(s->ring[0]);
+    ce_mem_free(s->ring[1]);
+    ce_mem_free(s);
+}
+
+ce_result ce_audio_stream_open(ce_audio_streamer* streamer, const ce_audio_stream_desc* desc,
+                               ce_audio_stream** out_stream)
+{
+    ce_audio_stream* s;
+    ce_result res;
+    ce_u32 cap;
+    ce_u32 want;
+
+    s   = CE_NULL;
+    res = CE_OK;
+
+    if ((streamer == CE_NULL) || (desc == CE_NULL) || (out_stream == CE_NULL) ||
+        (desc->buffer_frames > 0x10000000u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        s = (ce_audio_stream*)ce_mem_calloc(sizeof(ce_audio_stream), (ce_size)64, CE_MEM_TAG_AUDIO);
+        if (s == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = (desc->path != CE_NULL) ? ce_audio_decoder_open_file(desc->path, &s->decoder)
+                                      : ce_audio_decoder_open_memory(desc->data, desc->size, &s->decoder);
+    }
+
+    if (res == CE_OK) {
+        ce_audio_decoder_get_info(s->decoder, &s->info);
+
+        /* At least two chunks so the worker can refill while one is played. */
+        want = (desc->buffer_frames != 0u) ? desc->buffer_frames : (streamer->chunk_frames * 4u);
+        want = (want > (streamer->chunk_frames * 2u)) ? want : (streamer->chunk_frames * 2u);
+        cap  = 1u;
+        while (cap < want) {
+            cap <<= 1u;
+        }
+
+        s->capacity = cap;
+        s->mask     = cap - 1u;
+        s->prefetch = ((desc->prefetch_frames != 0u) && (desc->prefetch_frames <= cap)) ? desc->prefetch_frames
+                                                                                         : (cap / 2u);
+        s->loop     = desc->loop;
+        s->out_rate = (desc->output_rate != 0u) ? desc->output_rate : s->info.sample_rate;
+        s->quality  = desc->quality;
+        s->step     = ce_resample_step(s->info.sample_rate, s->out_rate);
+        s->owner    = streamer;
+        s->ring[0]  = (ce_f32*)ce_mem_alloc((ce_size)cap * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO);
+        s->ring[1]  = (s->info.channel_count == 2u)
+                          ? (ce_f32*)ce_mem_alloc((ce_size)cap * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO)
+                          : CE_NULL;
+        if ((s->ring[0] == CE_NULL) || ((s->info.channel_count == 2u) && (s->ring[1] == CE_NULL))) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if ((res == CE_OK) && (s->out_rate != s->info.sample_rate)) {
+        res = ce__stream_stage_init(s, streamer->chunk_frames);
+    }
+
+    if (res == CE_OK) {
+        ce_atomic_store_u64(&s->eof_at, CE_STREAM_NO_EOF);
+        ce_mutex_lock(&streamer->lock);
+        s->next           = streamer->streams;
+        streamer->streams = s;
+        ce_mutex_unlock(&streamer->lock);
+    } else if (s != CE_NULL) {
+        ce__stream_free(s);
+        s = CE_NULL;
+    } else {
+        /* Nothing allocated. */
+    }
+
+    if (out_stream != CE_NULL) {
+        *out_stream = s;
+    }
+
+    return res;
+}
+
+void ce_audio_stream_close(ce_audio_stream* stream)
+{
+    ce_audio_stream** link;
+
+    if (stream != CE_NULL) {
+        ce_mutex_lock(&stream->owner->lock);
+        for (link = &stream->owner->streams; *link != CE_NULL; link = &(*link)->next) {
+            if (*link == stream) {
+                *link = stream->next;
+                break;
+            }
+        }
+        ce_mutex_unlock(&stream->owner->lock);
+
+        ce__stream_free(stream);
+    }
+}
+
+ce_result ce_audio_stream_seek(ce_audio_stream* stream, ce_u64 frame)
+{
+    ce_result res;
+
+    res = CE_OK;
+    if ((stream == CE_NULL) || ((stream->info.frame_count != 0u) && (frame > stream->info.frame_count))) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_mutex_lock(&stream->owner->lock);
+        stream->seek_frame   = frame;
+        stream->seek_pending = CE_TRUE;
+        ce_mutex_unlock(&stream->owner->lock);
+    }
+
+    return res;
+}
+
+void ce_audio_stream_set_loop(ce_audio_stream* stream, ce_bool loop)
+{
+    ce_mutex_lock(&stream->owner->lock);
+    stream->loop = loop;
+    ce_mutex_unlock(&stream->owner->lock);
+}
+
+ce_bool ce_audio_stream_ready(const ce_audio_stream* stream)
+{
+    return (ce_atomic_load_u32(&stream->ready) != 0u) ? CE_TRUE : CE_FALSE;
+}
+
+void ce_audio_stream_get_stats(const ce_audio_stream* stream, ce_audio_stream_stats* out_stats)
+{
+    ce_u64 w;
+
+    w                          = ce_atomic_load_u64(&stream->write);
+    out_stats->info            = stream->info;
+    out_stats->decoded_frames  = w;
+    out_stats->consumed_frames = ce_atomic_load_u64(&stream->read);
+    out_stats->buffered_frames = (ce_u32)(w - ce__stream_consumer_pos(stream));
+    out_stats->underruns       = ce_atomic_load_u32(&stream->underruns);
+    out_stats->underrun_frames = ce_atomic_load_u64(&stream->underrun_frames);
+}
+
+ce_u32 ce_audio_stream_channels(const ce_audio_stream* stream)
+{
+    return stream->info.channel_count;
+}
+
+ce_u32 ce_audio_stream_sample_rate(const ce_audio_stream* stream)
+{
+    return stream->out_rate;
+}
+
+/* ************************************************************************** */
+/* CONSUMER                                                                   */
+/* ************************************************************************** */
+
+/**
+ * @brief Steps `read` over the frames a seek discarded.
+ * @return The consumer's read position.
+ */
+static ce_u64 ce__stream_apply_seek(ce_audio_stream* stream)
+{
+    ce_u64 r;
+    ce_u64 d;
+
+    r = ce_atomic_load_relaxed_u64(&stream->read);
+    d = ce_atomic_load_u64(&stream->discard);
+    if (r < d) {
+        /* A seek happened: drop what was buffered before it. */
+        r = d;
+        ce_atomic_store_u64(&stream->read, r);
+    }
+
+    return r;
+}
+
+void ce_audio_stream_apply_seek(ce_audio_stream* stream)
+{
+    (void)ce__stream_apply_seek(stream);
+}
+
+ce_u32 ce_audio_stream_acquire(ce_audio_stream* stream, ce_u32 max_frames, const ce_f32** out_left,
+                               const ce_f32** out_right)
+{
+    ce_u64 r;
+    ce_u64 avail;
+    ce_u32 at;
+    ce_u32 n;
+
+    r     = ce__stream_apply_seek(stream);
+    avail = ce_atomic_load_u64(&stream->write) - r;
+    at    = (ce_u32)(r & stream->mask);
+    n     = (avail < (ce_u64)max_frames) ? (ce_u32)avail : max_frames;
+    n     = (n < (stream->capacity - at)) ? n : (stream->capacity - at);
+
+    *out_left  = &stream->ring[0][at];
+    *out_right = (stream->ring[1] != CE_NULL) ? &stream->ring[1][at] : *out_left;
+
+    return n;
+}
+
+void ce_audio_stream_release(ce_audio_stream* stream, ce_u32 frames)
+{
+    ce_atomic_store_u64(&stream->read, ce_atomic_load_relaxed_u64(&stream->read) + frames);
+}
+
+ce_bool ce_audio_stream_finished(const ce_audio_stream* stream)
+{
+    ce_u64 eof;
+
+    eof = ce_atomic_load_u64(&stream->eof_at);
+
+    return ((eof != CE_STREAM_NO_EOF) && (ce_atomic_load_relaxed_u64(&stream->read) >= eof)) ? CE_TRUE : CE_FALSE;
+}
+
+void ce_audio_stream_underrun(ce_audio_stream* stream, ce_u32 frames)
+{
+    if (ce_atomic_load_u32(&stream->ready) != 0u) {
+        (void)ce_atomic_fetch_add_u32(&stream->underruns, 1u);
+        (void)ce_atomic_fetch_add_u64(&stream->underrun_frames, (ce_u64)frames);
+    }
+}
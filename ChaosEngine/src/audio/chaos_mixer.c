@@ -9,8 +9,1020 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_mixer.c
- * @brief Implementation skeleton.
+ * @brief Lock-free real-time software mixer.
+ *
+ * Control thread -> audio thread: ce_spsc_ring of commands.
+ * Audio thread -> control thread: ce_spsc_ring of finished voice ids, so
+ * slots are only recycled by the thread that hands them out. Voice ids are
+ * 32-bit handles from a ce_handle_table owned by the control thread; the
+ * audio thread only decodes their index.
+ *
+ * Voices are summed into planar block buffers 8 frames at a time; gain
+ * ramps are evaluated per lane, so volume and pan changes never click.
+ * Streamed voices read contiguous runs straight out of the stream ring.
+ *
+ * Sound cursors are 32.32 fixed point; voices at the mixer rate take the
+ * direct path, others are resampled into a scratch block first. When more
+ * voices are active than the real-voice limit, a quickselect on loudness
+ * picks the voices to mix; the rest only advance.
+ *
+ * The constant-gain accumulate and the master/clip/interleave pass go
+ * through a kernel table chosen at creation (chaos_defs.h dispatch).
  */
 #include "audio/chaos_mixer.h"
+#include "core/chaos_containers.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_math.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_simd.h"
+#include "core/chaos_time.h"
+#include "platform/chaos_thread.h"
+#include "resources/chaos_handles.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#include <math.h>
+#if defined(CE_CPU_DISPATCH_X64)
+#include <immintrin.h>
+#endif
+
+#define CE_MIXER_DEFAULT_RING  1024u
+
+typedef enum ce_mixer_cmd_type_e {
+    CE_MIXER_CMD_PLAY = 0,
+    CE_MIXER_CMD_STOP,
+    CE_MIXER_CMD_VOLUME,
+    CE_MIXER_CMD_PAN,
+    CE_MIXER_CMD_MASTER
+} ce_mixer_cmd_type;
+
+/** @brief Block kernels; spans are whole groups of 8 frames. */
+typedef struct ce__mixer_kernels_s {
+    /** mix += src * gain, per channel. */
+    void (*mix)(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, const ce_f32* src_l, const ce_f32* src_r,
+                ce_u32 n, ce_f32 gain_l, ce_f32 gain_r);
+    /** Gain ramping from `master` by `step` per frame, clip to [-1, 1], interleave `frames` into out. */
+    void (*output)(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, ce_f32* CE_RESTRICT out, ce_u32 frames,
+                   ce_f32 master, ce_f32 step);
+} ce__mixer_kernels;
+
+typedef struct ce__mixer_cmd_s {
+    ce_u32                   type;
+    ce_voice_id              voice;
+    const ce_sound*          sound;
+    ce_audio_stream*         stream;
+    ce_f32                   value;
+    ce_f32                   pan;
+    ce_u32                   frames;
+    ce_bool                  loop;
+    const ce_resample_table* table;
+    ce_u64                   step;
+} ce__mixer_cmd;
+
+/** @brief Voice state, owned by the audio thread. */
+typedef struct ce__voice_s {
+    const ce_sound*          sound;
+    ce_audio_stream*         stream;
+    ce_u32                   channel_count;
+    ce_voice_id              id;
+    const ce_resample_table* table;  /**< CE_NULL: linear when resampling. */
+    ce_u64                   cursor; /**< 32.32 source frame. */
+    ce_u64                   step;   /**< CE_RESAMPLE_ONE at the mixer rate. */
+    ce_f32                   volume;
+    ce_f32                   pan;
+    ce_f32                   gain[2];
+    ce_f32                   target[2];
+    ce_f32                   slope[2];
+    ce_u32                   ramp_left;
+    ce_bool                  loop;
+    ce_bool                  stopping;
+    ce_bool                  active;
+    ce_bool                  is_virtual;
+} ce__voice;
+
+struct ce_mixer_s {
+    ce_spsc_ring      commands;
+    ce_spsc_ring      finished;
+
+    /* Control thread. */
+    ce_handle_table   handles;
+    ce_resample_table tables[CE_MIXER_MAX_RATE_TABLES];
+    ce_u32            table_count;
+
+    /* Audio thread. */
+    const ce__mixer_kernels* kernels;  /* Re-resolved each render. */
+    ce__voice*        voices;
+    ce_u32*           active;
+    ce_u32            active_count;
+    ce_f32*           mix[2];
+    ce_f32*           scratch[2];
+    ce_f32*           loudness;
+    ce_f32            master;
+    ce_f32            master_target;
+
+    ce_u32            sample_rate;
+    ce_u32            max_voices;
+    ce_u32            real_limit;
+
+    ce_atomic_u32     stat_active;
+    ce_atomic_u32     stat_virtual;
+    ce_atomic_u64     stat_frames;
+    ce_atomic_u64     stat_dropped;
+    ce_atomic_u64     stat_ns_last;
+    ce_atomic_u64     stat_ns_max;
+};
+
+/* ************************************************************************** */
+/* KERNELS                                                                    */
+/* ************************************************************************** */
+
+/*
+ * Variants are bit-identical to the ce_f32x8 baseline (mul + add, no FMA),
+ * so the output does not depend on the machine.
+ */
+
+static const ce_f32 ce__mixer_lane_index[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+static void ce__mixer_mix_f32x8(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, const ce_f32* src_l,
+                                const ce_f32* src_r, ce_u32 n, ce_f32 gain_l, ce_f32 gain_r)
+{
+    ce_f32x8 gl;
+    ce_f32x8 gr;
+    ce_u32 i;
+
+    gl = ce_f32x8_set1(gain_l);
+    gr = ce_f32x8_set1(gain_r);
+    for (i = 0u; i < n; i += 8u) {
+        ce_f32x8_store(&mix_l[i], ce_f32x8_madd(ce_f32x8_load(&src_l[i]), gl, ce_f32x8_load(&mix_l[i])));
+        ce_f32x8_store(&mix_r[i], ce_f32x8_madd(ce_f32x8_load(&src_r[i]), gr, ce_f32x8_load(&mix_r[i])));
+    }
+}
+
+static void ce__mixer_output_f32x8(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, ce_f32* CE_RESTRICT out,
+                                   ce_u32 frames, ce_f32 master, ce_f32 step)
+{
+    ce_f32x8 g;
+    ce_f32x8 lo;
+    ce_f32x8 hi;
+    ce_f32x8 step8;
+    ce_u32 i;
+
+    step8 = ce_f32x8_set1(step);
+    lo    = ce_f32x8_set1(-1.0f);
+    hi    = ce_f32x8_set1(1.0f);
+
+    /* The block buffers are CE_MIXER_BLOCK_FRAMES long, so a partial last group stays in bounds. */
+    for (i = 0u; i < frames; i += 8u) {
+        g = ce_f32x8_madd(ce_f32x8_add(ce_f32x8_load(ce__mixer_lane_index), ce_f32x8_set1((ce_f32)i)), step8,
+                          ce_f32x8_set1(master));
+        ce_f32x8_store(&mix_l[i], ce_f32x8_min(hi, ce_f32x8_max(lo, ce_f32x8_mul(ce_f32x8_load(&mix_l[i]), g))));
+        ce_f32x8_store(&mix_r[i], ce_f32x8_min(hi, ce_f32x8_max(lo, ce_f32x8_mul(ce_f32x8_load(&mix_r[i]), g))));
+    }
+
+    for (i = 0u; i < frames; i++) {
+        out[i * 2u]        = mix_l[i];
+        out[(i * 2u) + 1u] = mix_r[i];
+    }
+}
+
+#if defined(CE_CPU_DISPATCH_X64)
+CE_TARGET("avx")
+static void ce__mixer_mix_avx(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, const ce_f32* src_l,
+                              const ce_f32* src_r, ce_u32 n, ce_f32 gain_l, ce_f32 gain_r)
+{
+    __m256 gl;
+    __m256 gr;
+    ce_u32 i;
+
+    gl = _mm256_set1_ps(gain_l);
+    gr = _mm256_set1_ps(gain_r);
+    for (i = 0u; i < n; i += 8u) {
+        _mm256_storeu_ps(&mix_l[i], _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&src_l[i]), gl),
+                                                  _mm256_loadu_ps(&mix_l[i])));
+        _mm256_storeu_ps(&mix_r[i], _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&src_r[i]), gr),
+                                                  _mm256_loadu_ps(&mix_r[i])));
+    }
+}
+
+/* Interleaves in registers: two unpacks and two lane shuffles per 8 frames. */
+CE_TARGET("avx")
+static void ce__mixer_output_avx(ce_f32* CE_RESTRICT mix_l, ce_f32* CE_RESTRICT mix_r, ce_f32* CE_RESTRICT out,
+                                 ce_u32 frames, ce_f32 master, ce_f32 step)
+{
+    __m256 g;
+    __m256 l;
+    __m256 r;
+    __m256 lo;
+    __m256 hi;
+    __m256 ab;
+    __m256 cd;
+    ce_u32 i;
+
+    lo = _mm256_set1_ps(-1.0f);
+    hi = _mm256_set1_ps(1.0f);
+
+    for (i = 0u; i < frames; i += 8u) {
+        g = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(ce__mixer_lane_index), _mm256_set1_ps((ce_f32)i)),
+                                        _mm256_set1_ps(step)),
+                          _mm256_set1_ps(master));
+        l = _mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_mul_ps(_mm256_loadu_ps(&mix_l[i]), g)));
+        r = _mm256_min_ps(hi, _mm256_max_ps(lo, _mm256_mul_ps(_mm256_loadu_ps(&mix_r[i]), g)));
+        if ((i + 8u) <= frames) {
+            ab = _mm256_unpacklo_ps(l, r);
+            cd = _mm256_unpackhi_ps(l, r);
+            _mm256_storeu_ps(&out[i * 2u], _mm256_permute2f128_ps(ab, cd, 0x20));
+            _mm256_storeu_ps(&out[(i * 2u) + 8u], _mm256_permute2f128_ps(ab, cd, 0x31));
+        } else {
+            _mm256_storeu_ps(&mix_l[i], l);
+            _mm256_storeu_ps(&mix_r[i], r);
+            for (; i < frames; i++) {
+                out[i * 2u]        = mix_l[i];
+                out[(i * 2u) + 1u] = mix_r[i];
+            }
+        }
+    }
+}
+
+static const ce__mixer_kernels ce__mixer_kernels_avx = { ce__mixer_mix_avx, ce__mixer_output_avx };
+#endif
+
+static const ce__mixer_kernels ce__mixer_kernels_base = { ce__mixer_mix_f32x8, ce__mixer_output_f32x8 };
+
+static const ce_cpu_variant ce__mixer_variants[] = {
+#if defined(CE_CPU_DISPATCH_X64)
+    { CE_CPU_AVX, &ce__mixer_kernels_avx },
+#endif
+    { 0u, &ce__mixer_kernels_base },
+};
+
+static ce_cpu_dispatch ce__mixer_dispatch = CE_CPU_DISPATCH_INIT(ce__mixer_variants);
+
+/* ************************************************************************** */
+/* LIFECYCLE                                                                  */
+/* ************************************************************************** */
+
+ce_result ce_mixer_create(const ce_mixer_desc* desc, ce_mixer** out_mixer)
+{
+    ce_result res;
+    ce_mixer* m;
+
+    res = CE_OK;
+    m   = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_mixer == CE_NULL) || (desc->sample_rate == 0u) || (desc->max_voices == 0u) ||
+        (desc->max_voices > CE_HANDLE_MAX_CAPACITY)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        m = (ce_mixer*)ce_mem_calloc(sizeof(ce_mixer), (ce_size)64, CE_MEM_TAG_AUDIO);
+        if (m == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        m->sample_rate   = desc->sample_rate;
+        m->max_voices    = desc->max_voices;
+        m->real_limit    = ((desc->real_voice_limit != 0u) && (desc->real_voice_limit < desc->max_voices))
+                               ? desc->real_voice_limit
+                               : desc->max_voices;
+        m->master        = 1.0f;
+        m->master_target = 1.0f;
+        m->voices        = (ce__voice*)ce_mem_calloc((ce_size)desc->max_voices * sizeof(ce__voice), (ce_size)64,
+                                                     CE_MEM_TAG_AUDIO);
+        m->active        = (ce_u32*)ce_mem_alloc((ce_size)desc->max_voices * sizeof(ce_u32), 0u, CE_MEM_TAG_AUDIO);
+        m->mix[0]        = (ce_f32*)ce_mem_alloc(CE_MIXER_BLOCK_FRAMES * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO);
+        m->mix[1]        = (ce_f32*)ce_mem_alloc(CE_MIXER_BLOCK_FRAMES * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO);
+        m->scratch[0]    = (ce_f32*)ce_mem_alloc(CE_MIXER_BLOCK_FRAMES * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO);
+        m->scratch[1]    = (ce_f32*)ce_mem_alloc(CE_MIXER_BLOCK_FRAMES * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_AUDIO);
+        m->loudness      = (ce_f32*)ce_mem_alloc((ce_size)desc->max_voices * sizeof(ce_f32), 0u, CE_MEM_TAG_AUDIO);
+
+        if ((m->voices == CE_NULL) || (m->active == CE_NULL) || (m->mix[0] == CE_NULL) || (m->mix[1] == CE_NULL) ||
+            (m->scratch[0] == CE_NULL) || (m->scratch[1] == CE_NULL) || (m->loudness == CE_NULL)) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = ce_handle_table_init(&m->handles, desc->max_voices, CE_MEM_TAG_AUDIO);
+    }
+
+    if (res == CE_OK) {
+        res = ce_spsc_ring_init(&m->commands, sizeof(ce__mixer_cmd),
+                                (desc->command_capacity != 0u) ? desc->command_capacity : CE_MIXER_DEFAULT_RING,
+                                CE_MEM_TAG_AUDIO);
+    }
+    if (res == CE_OK) {
+        /* Every allocated slot finishes at most once before it is reclaimed: this ring never fills. */
+        res = ce_spsc_ring_init(&m->finished, sizeof(ce_voice_id), desc->max_voices, CE_MEM_TAG_AUDIO);
+    }
+
+    if ((res != CE_OK) && (m != CE_NULL)) {
+        ce_mixer_destroy(m);
+        m = CE_NULL;
+    }
+
+    if (out_mixer != CE_NULL) {
+        *out_mixer = m;
+    }
+
+    return res;
+}
+
+void ce_mixer_destroy(ce_mixer* mixer)
+{
+    ce_u32 i;
+
+    if (mixer != CE_NULL) {
+        for (i = 0u; i < mixer->table_count; i++) {
+            ce_resample_table_shutdown(&mixer->tables[i]);
+        }
+        ce_spsc_ring_shutdown(&mixer->commands);
+        ce_spsc_ring_shutdown(&mixer->finished);
+        ce_handle_table_shutdown(&mixer->handles);
+        ce_mem_free(mixer->voices);
+        ce_mem_free(mixer->active);
+        ce_mem_free(mixer->mix[0]);
+        ce_mem_free(mixer->mix[1]);
+        ce_mem_free(mixer->scratch[0]);
+        ce_mem_free(mixer->scratch[1]);
+        ce_mem_free(mixer->loudness);
+        ce_mem_free(mixer);
+    }
+}
+
+/* ************************************************************************** */
+/* CONTROL THREAD                                                             */
+/* ************************************************************************** */
+
+static ce_result ce__mixer_send(ce_mixer* mixer, const ce__mixer_cmd* cmd)
+{
+    ce_result res;
+
+    res = CE_OK;
+    if (ce_spsc_ring_push(&mixer->commands, cmd) == CE_FALSE) {
+        (void)ce_atomic_fetch_add_u64(&mixer->stat_dropped, 1u);
+        res = CE_ERR_FULL;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Polyphase table for `in_rate`, built on first use (control thread).
+ * @return CE_NULL when the cache is full or allocation fails; the voice then resamples linearly.
+ */
+static const ce_resample_table* ce__mixer_table(ce_mixer* mixer, ce_u32 in_rate)
+{
+    const ce_resample_table* table;
+    ce_u32 i;
+
+    table = CE_NULL;
+    for (i = 0u; (i < mixer->table_count) && (table == CE_NULL); i++) {
+        if (mixer->tables[i].in_rate == in_rate) {
+            table = &mixer->tables[i];
+        }
+    }
+
+    if ((table == CE_NULL) && (mixer->table_count < CE_MIXER_MAX_RATE_TABLES) &&
+        (ce_resample_table_init(&mixer->tables[mixer->table_count], in_rate, mixer->sample_rate) == CE_OK)) {
+        table               = &mixer->tables[mixer->table_count];
+        mixer->table_count += 1u;
+    }
+
+    return table;
+}
+
+/**
+ * @brief Allocates a slot and queues the PLAY command (exactly one of sound / stream is set).
+ */
+static ce_voice_id ce__mixer_start(ce_mixer* mixer, const ce_sound* sound, ce_audio_stream* stream,
+                                   const ce_voice_params* params)
+{
+    ce_voice_id id;
+    ce__mixer_cmd cmd;
+    ce_u32 slot;
+
+    id = CE_VOICE_NONE;
+
+    slot = (params != CE_NULL) ? ce_handle_table_alloc(&mixer->handles) : CE_HANDLE_INVALID;
+    if (slot != CE_HANDLE_INVALID) {
+        cmd.type   = (ce_u32)CE_MIXER_CMD_PLAY;
+        cmd.voice  = ce_handle_table_handle(&mixer->handles, slot);
+        cmd.sound  = sound;
+        cmd.stream = stream;
+        cmd.table  = CE_NULL;
+        cmd.step   = CE_RESAMPLE_ONE;
+        if ((sound != CE_NULL) && (sound->sample_rate != 0u) && (sound->sample_rate != mixer->sample_rate)) {
+            cmd.step  = ce_resample_step(sound->sample_rate, mixer->sample_rate);
+            cmd.table = (params->quality == CE_RESAMPLE_POLYPHASE) ? ce__mixer_table(mixer, sound->sample_rate)
+                                                                   : CE_NULL;
+        }
+        cmd.value  = params->volume;
+        cmd.pan    = params->pan;
+        cmd.frames = params->fade_in_frames;
+        cmd.loop   = params->loop;
+
+        if (ce__mixer_send(mixer, &cmd) == CE_OK) {
+            id = cmd.voice;
+        } else {
+            ce_handle_table_free(&mixer->handles, slot);
+        }
+    }
+
+    return id;
+}
+
+ce_voice_id ce_mixer_play(ce_mixer* mixer, const ce_sound* sound, const ce_voice_params* params)
+{
+    ce_voice_id id;
+
+    id = CE_VOICE_NONE;
+    if ((mixer != CE_NULL) && (sound != CE_NULL) && (sound->channels[0] != CE_NULL) &&
+        ((sound->channel_count == 1u) || ((sound->channel_count == 2u) && (sound->channels[1] != CE_NULL)))) {
+        id = ce__mixer_start(mixer, sound, CE_NULL, params);
+    }
+
+    return id;
+}
+
+ce_voice_id ce_mixer_play_stream(ce_mixer* mixer, ce_audio_stream* stream, const ce_voice_params* params)
+{
+    ce_voice_id id;
+
+    id = CE_VOICE_NONE;
+    if ((mixer != CE_NULL) && (stream != CE_NULL) && (ce_audio_stream_sample_rate(stream) == mixer->sample_rate)) {
+        id = ce__mixer_start(mixer, CE_NULL, stream, params);
+    }
+
+    return id;
+}
+
+ce_bool ce_mixer_is_playing(const ce_mixer* mixer, ce_voice_id voice)
+{
+    return (ce_handle_table_resolve(&mixer->handles, voice) != CE_HANDLE_INVALID) ? CE_TRUE : CE_FALSE;
+}
+
+static ce_result ce__mixer_voice_cmd(ce_mixer* mixer, ce_voice_id voice, ce_mixer_cmd_type type, ce_f32 value,
+                                     ce_u32 frames)
+{
+    ce_result res;
+    ce__mixer_cmd cmd;
+
+    if ((mixer == CE_NULL) || (ce_mixer_is_playing(mixer, voice) == CE_FALSE)) {
+        res = CE_ERR_NOT_FOUND;
+    } else {
+        (void)ce__memset(&cmd, 0u, sizeof(cmd));
+        cmd.type   = (ce_u32)type;
+        cmd.voice  = voice;
+        cmd.value  = value;
+        cmd.frames = frames;
+        res        = ce__mixer_send(mixer, &cmd);
+    }
+
+    return res;
+}
+
+ce_result ce_mixer_stop(ce_mixer* mixer, ce_voice_id voice, ce_u32 fade_frames)
+{
+    return ce__mixer_voice_cmd(mixer, voice, CE_MIXER_CMD_STOP, 0.0f, fade_frames);
+}
+
+ce_result ce_mixer_set_volume(ce_mixer* mixer, ce_voice_id voice, ce_f32 volume)
+{
+    return ce__mixer_voice_cmd(mixer, voice, CE_MIXER_CMD_VOLUME, volume, 0u);
+}
+
+ce_result ce_mixer_set_pan(ce_mixer* mixer, ce_voice_id voice, ce_f32 pan)
+{
+    return ce__mixer_voice_cmd(mixer, voice, CE_MIXER_CMD_PAN, pan, 0u);
+}
+
+ce_result ce_mixer_set_master_volume(ce_mixer* mixer, ce_f32 volume)
+{
+    ce_result res;
+    ce__mixer_cmd cmd;
+
+    if (mixer == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        (void)ce__memset(&cmd, 0u, sizeof(cmd));
+        cmd.type  = (ce_u32)CE_MIXER_CMD_MASTER;
+        cmd.value = volume;
+        res       = ce__mixer_send(mixer, &cmd);
+    }
+
+    return res;
+}
+
+void ce_mixer_update(ce_mixer* mixer)
+{
+    ce_voice_id voice;
+
+    while (ce_spsc_ring_pop(&mixer->finished, &voice) == CE_TRUE) {
+        ce_handle_table_free(&mixer->handles, ce_handle_index(voice));
+    }
+}
+
+ce_u32 ce_mixer_sample_rate(const ce_mixer* mixer)
+{
+    return mixer->sample_rate;
+}
+
+void ce_mixer_get_stats(const ce_mixer* mixer, ce_mixer_stats* out_stats)
+{
+    out_stats->active_voices    = ce_atomic_load_u32(&mixer->stat_active);
+    out_stats->virtual_voices   = ce_atomic_load_u32(&mixer->stat_virtual);
+    out_stats->frames_rendered  = ce_atomic_load_u64(&mixer->stat_frames);
+    out_stats->commands_dropped = ce_atomic_load_u64(&mixer->stat_dropped);
+    out_stats->render_ns_last   = ce_atomic_load_u64(&mixer->stat_ns_last);
+    out_stats->render_ns_max    = ce_atomic_load_u64(&mixer->stat_ns_max);
+}
+
+/* ************************************************************************** */
+/* AUDIO THREAD                                                               */
+/* ************************************************************************** */
+
+/**
+ * @brief Starts a linear ramp of both channel gains towards the voice's volume / pan.
+ */
+static void ce__voice_ramp(ce__voice* v, ce_u32 frames)
+{
+    ce_f32 theta;
+    ce_u32 c;
+
+    if (v->channel_count == 2u) {
+        /* Balance: attenuate the opposite side only. */
+        v->target[0] = v->volume * ((v->pan > 0.0f) ? (1.0f - v->pan) : 1.0f);
+        v->target[1] = v->volume * ((v->pan < 0.0f) ? (1.0f + v->pan) : 1.0f);
+    } else {
+        /* Constant-power pan. */
+        theta        = (v->pan + 1.0f) * (CE_PI_F * 0.25f);
+        v->target[0] = v->volume * cosf(theta);
+        v->target[1] = v->volume * sinf(theta);
+    }
+
+    for (c = 0u; c < 2u; c++) {
+        if (frames == 0u) {
+            v->gain[c] = v->target[c];
+            v->slope[c] = 0.0f;
+        } else {
+            v->slope[c] = (v->target[c] - v->gain[c]) / (ce_f32)frames;
+        }
+    }
+    v->ramp_left = frames;
+}
+
+static void ce__mixer_apply(ce_mixer* mixer, const ce__mixer_cmd* cmd)
+{
+    ce__voice* v;
+    ce_u32 slot;
+
+    if (cmd->type == (ce_u32)CE_MIXER_CMD_MASTER) {
+        mixer->master_target = cmd->value;
+        return;
+    }
+
+    slot = ce_handle_index(cmd->voice);
+    if (slot >= mixer->max_voices) {
+        return;
+    }
+    v = &mixer->voices[slot];
+
+    if (cmd->type == (ce_u32)CE_MIXER_CMD_PLAY) {
+        v->sound         = cmd->sound;
+        v->stream        = cmd->stream;
+        v->channel_count = (cmd->stream != CE_NULL) ? ce_audio_stream_channels(cmd->stream) : cmd->sound->channel_count;
+        v->id            = cmd->voice;
+        v->table         = cmd->table;
+        v->cursor        = 0u;
+        v->step          = cmd->step;
+        v->is_virtual    = CE_FALSE;
+        v->volume        = cmd->value;
+        v->pan           = (cmd->pan < -1.0f) ? -1.0f : ((cmd->pan > 1.0f) ? 1.0f : cmd->pan);
+        v->loop          = cmd->loop;
+        v->stopping      = CE_FALSE;
+        v->active        = CE_TRUE;
+        v->gain[0]       = 0.0f;
+        v->gain[1]       = 0.0f;
+        ce__voice_ramp(v, cmd->frames);
+        mixer->active[mixer->active_count] = slot;
+        mixer->active_count += 1u;
+    } else if ((v->active == CE_TRUE) && (v->id == cmd->voice) && (v->stopping == CE_FALSE)) {
+        if (cmd->type == (ce_u32)CE_MIXER_CMD_STOP) {
+            v->volume   = 0.0f;
+            v->stopping = CE_TRUE;
+            ce__voice_ramp(v, (cmd->frames != 0u) ? cmd->frames : CE_MIXER_RAMP_FRAMES);
+        } else if (cmd->type == (ce_u32)CE_MIXER_CMD_VOLUME) {
+            v->volume = cmd->value;
+            ce__voice_ramp(v, CE_MIXER_RAMP_FRAMES);
+        } else {
+            v->pan = (cmd->value < -1.0f) ? -1.0f : ((cmd->value > 1.0f) ? 1.0f : cmd->value);
+            ce__voice_ramp(v, CE_MIXER_RAMP_FRAMES);
+        }
+    } else {
+        /* Stale id (voice already finished) or already fading out. */
+    }
+}
+
+/**
+ * @brief Accumulates `n` frames of one voice into the block.
+ *
+ * Groups of 8 under a gain ramp are evaluated per lane; once the ramp is
+ * over, the rest of the whole groups is one constant-gain kernel call.
+ */
+static void ce__mix_span(const ce__mixer_kernels* k, ce_f32* mix_l, ce_f32* mix_r, const ce_f32* src_l,
+                         const ce_f32* src_r, ce_u32 n, ce__voice* v)
+{
+    ce_f32 lanes[2][8];
+    ce_f32x8 lane;
+    ce_f32x8 gl;
+    ce_f32x8 gr;
+    ce_u32 whole;
+    ce_u32 i;
+    ce_u32 k8;
+
+    lane  = ce_f32x8_load(ce__mixer_lane_index);
+    whole = n & ~7u;
+
+    for (i = 0u; (i < whole) && (v->ramp_left != 0u); i += 8u) {
+        if (v->ramp_left >= 8u) {
+            gl            = ce_f32x8_madd(lane, ce_f32x8_set1(v->slope[0]), ce_f32x8_set1(v->gain[0]));
+            gr            = ce_f32x8_madd(lane, ce_f32x8_set1(v->slope[1]), ce_f32x8_set1(v->gain[1]));
+            v->gain[0]   += 8.0f * v->slope[0];
+            v->gain[1]   += 8.0f * v->slope[1];
+            v->ramp_left -= 8u;
+            if (v->ramp_left == 0u) {
+                v->gain[0] = v->target[0];
+                v->gain[1] = v->target[1];
+            }
+        } else {
+            /* Ramp ends inside this group. */
+            for (k8 = 0u; k8 < 8u; k8++) {
+                lanes[0][k8] = (k8 < v->ramp_left) ? (v->gain[0] + ((ce_f32)k8 * v->slope[0])) : v->target[0];
+                lanes[1][k8] = (k8 < v->ramp_left) ? (v->gain[1] + ((ce_f32)k8 * v->slope[1])) : v->target[1];
+            }
+            gl           = ce_f32x8_load(lanes[0]);
+            gr           = ce_f32x8_load(lanes[1]);
+            v->gain[0]   = v->target[0];
+            v->gain[1]   = v->target[1];
+            v->ramp_left = 0u;
+        }
+
+        ce_f32x8_store(&mix_l[i], ce_f32x8_madd(ce_f32x8_load(&src_l[i]), gl, ce_f32x8_load(&mix_l[i])));
+        ce_f32x8_store(&mix_r[i], ce_f32x8_madd(ce_f32x8_load(&src_r[i]), gr, ce_f32x8_load(&mix_r[i])));
+    }
+
+    if (i < whole) {
+        k->mix(&mix_l[i], &mix_r[i], &src_l[i], &src_r[i], whole - i, v->gain[0], v->gain[1]);
+        i = whole;
+    }
+
+    for (; i < n; i++) {
+        mix_l[i] += src_l[i] * v->gain[0];
+        mix_r[i] += src_r[i] * v->gain[1];
+        if (v->ramp_left != 0u) {
+            v->ramp_left -= 1u;
+            v->gain[0]    = (v->ramp_left == 0u) ? v->target[0] : (v->gain[0] + v->slope[0]);
+            v->gain[1]    = (v->ramp_left == 0u) ? v->target[1] : (v->gain[1] + v->slope[1]);
+        }
+    }
+}
+
+/**
+ * @brief Mixes a streamed voice: contiguous runs from the ring, silence on underrun.
+ */
+static ce_bool ce__mix_stream_voice(ce_mixer* mixer, ce__voice* v, ce_u32 frames)
+{
+    const ce_f32* left;
+    const ce_f32* right;
+    ce_u32 done;
+    ce_u32 seg;
+    ce_bool alive;
+
+    done  = 0u;
+    alive = CE_TRUE;
+
+    if (ce_audio_stream_ready(v->stream) == CE_FALSE) {
+        /* Started or seeked: silent until the prefetch is buffered, without reading the ring. */
+        ce_audio_stream_apply_seek(v->stream);
+        done  = frames;
+        alive = (v->stopping == CE_TRUE) ? CE_FALSE : CE_TRUE;
+    }
+
+    while ((done < frames) && (alive == CE_TRUE)) {
+        seg = ce_audio_stream_acquire(v->stream, frames - done, &left, &right);
+        if (seg == 0u) {
+            if ((ce_audio_stream_finished(v->stream) == CE_TRUE) || (v->stopping == CE_TRUE)) {
+                alive = CE_FALSE;
+            } else {
+                ce_audio_stream_underrun(v->stream, frames - done);
+            }
+            break;
+        }
+
+        ce__mix_span(mixer->kernels, &mixer->mix[0][done], &mixer->mix[1][done], left, right, seg, v);
+        ce_audio_stream_release(v->stream, seg);
+        done += seg;
+
+        if ((v->stopping == CE_TRUE) && (v->ramp_left == 0u)) {
+            alive = CE_FALSE;
+        }
+    }
+
+    return alive;
+}
+
+/**
+ * @brief Resamples `frames` frames of every channel of a sound voice into the scratch block.
+ */
+static void ce__resample_voice(ce_mixer* mixer, const ce__voice* v, ce_u32 frames)
+{
+    const ce_sound* s;
+    ce_resample_quality q;
+    ce_f32* out;
+    ce_u64 pos;
+    ce_u32 c;
+    ce_u32 k;
+    ce_u32 m;
+
+    s = v->sound;
+    q = (v->table != CE_NULL) ? CE_RESAMPLE_POLYPHASE : CE_RESAMPLE_LINEAR;
+
+    for (c = 0u; c < s->channel_count; c++) {
+        out = mixer->scratch[c];
+        pos = v->cursor;
+        k   = 0u;
+        while (k < frames) {
+            m = ce_resample_interior_frames(q, pos, v->step, s->frame_count, frames - k);
+            if (m == 0u) {
+                /* Kernel footprint crosses an end of the sound. */
+                out[k] = ce_resample_edge(q, v->table, s->channels[c], s->frame_count, v->loop, pos);
+                pos   += v->step;
+                k     += 1u;
+            } else {
+                if (q == CE_RESAMPLE_POLYPHASE) {
+                    ce_resample_polyphase(v->table, s->channels[c], pos, v->step, &out[k], m);
+                } else {
+                    ce_resample_linear(s->channels[c], pos, v->step, &out[k], m);
+                }
+                pos += (ce_u64)m * v->step;
+                k   += m;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Mixes one voice into the block.
+ * @return CE_FALSE once the voice has ended.
+ */
+static ce_bool ce__mix_voice(ce_mixer* mixer, ce__voice* v, ce_u32 frames)
+{
+    const ce_sound* s;
+    const ce_f32* left;
+    const ce_f32* right;
+    ce_u64 end;
+    ce_u64 left_frames;
+    ce_u32 done;
+    ce_u32 seg;
+    ce_bool alive;
+
+    s     = v->sound;
+    end   = (ce_u64)s->frame_count << 32u;
+    done  = 0u;
+    alive = (s->frame_count != 0u) ? CE_TRUE : CE_FALSE;
+
+    while ((done < frames) && (alive == CE_TRUE)) {
+        /* Output frames until the cursor passes the end of the sound. */
+        left_frames = ((end - v->cursor) + v->step - 1u) / v->step;
+        seg         = (left_frames < (ce_u64)(frames - done)) ? (ce_u32)left_frames : (frames - done);
+
+        if (v->step == CE_RESAMPLE_ONE) {
+            left  = &s->channels[0][v->cursor >> 32u];
+            right = (s->channel_count == 2u) ? &s->channels[1][v->cursor >> 32u] : left;
+        } else {
+            ce__resample_voice(mixer, v, seg);
+            left  = mixer->scratch[0];
+            right = (s->channel_count == 2u) ? mixer->scratch[1] : left;
+        }
+        ce__mix_span(mixer->kernels, &mixer->mix[0][done], &mixer->mix[1][done], left, right, seg, v);
+        v->cursor += (ce_u64)seg * v->step;
+        done      += seg;
+
+        if (v->cursor >= end) {
+            if (v->loop == CE_TRUE) {
+                v->cursor %= end;
+            } else {
+                alive = CE_FALSE;
+            }
+        }
+        if ((v->stopping == CE_TRUE) && (v->ramp_left == 0u)) {
+            alive = CE_FALSE;
+        }
+    }
+
+    return alive;
+}
+
+/**
+ * @brief Advances a virtual voice by `frames` frames without mixing it.
+ * @return CE_FALSE once the voice has ended.
+ */
+static ce_bool ce__skip_voice(ce__voice* v, ce_u32 frames)
+{
+    const ce_f32* left;
+    const ce_f32* right;
+    ce_u64 end;
+    ce_u32 m;
+    ce_u32 done;
+    ce_bool alive;
+
+    alive = CE_TRUE;
+
+    if (v->ramp_left != 0u) {
+        m             = (frames < v->ramp_left) ? frames : v->ramp_left;
+        v->ramp_left -= m;
+        v->gain[0]    = (v->ramp_left == 0u) ? v->target[0] : (v->gain[0] + ((ce_f32)m * v->slope[0]));
+        v->gain[1]    = (v->ramp_left == 0u) ? v->target[1] : (v->gain[1] + ((ce_f32)m * v->slope[1]));
+    }
+    if ((v->stopping == CE_TRUE) && (v->ramp_left == 0u)) {
+        alive = CE_FALSE;
+    } else if ((v->stream != CE_NULL) && (ce_audio_stream_ready(v->stream) == CE_FALSE)) {
+        /* Same wait as an audible voice, so both resume from the prefetch. */
+        ce_audio_stream_apply_seek(v->stream);
+    } else if (v->stream != CE_NULL) {
+        for (done = 0u; done < frames; done += m) {
+            m = ce_audio_stream_acquire(v->stream, frames - done, &left, &right);
+            if (m == 0u) {
+                alive = (ce_audio_stream_finished(v->stream) == CE_TRUE) ? CE_FALSE : CE_TRUE;
+                break;
+            }
+            ce_audio_stream_release(v->stream, m);
+        }
+    } else {
+        end        = (ce_u64)v->sound->frame_count << 32u;
+        v->cursor += (ce_u64)frames * v->step;
+        if (v->cursor >= end) {
+            if ((v->loop == CE_TRUE) && (end != 0u)) {
+                v->cursor %= end;
+            } else {
+                alive = CE_FALSE;
+            }
+        }
+    }
+
+    return alive;
+}
+
+/**
+ * @brief Moves the `keep` loudest active voices to the front of the active list (quickselect).
+ *
+ * Voices already audible get a 25 % bonus so voices near the threshold do
+ * not flip between real and virtual every block.
+ */
+static void ce__mixer_rank(ce_mixer* mixer, ce_u32 keep)
+{
+    const ce__voice* v;
+    ce_f32* key;
+    ce_u32* ids;
+    ce_f32 loud;
+    ce_f32 pivot;
+    ce_f32 tk;
+    ce_u32 ti;
+    ce_u32 a;
+    ce_s32 lo;
+    ce_s32 hi;
+    ce_s32 i;
+    ce_s32 j;
+
+    key = mixer->loudness;
+    ids = mixer->active;
+
+    for (a = 0u; a < mixer->active_count; a++) {
+        v    = &mixer->voices[ids[a]];
+        loud = (v->gain[0] > v->gain[1]) ? v->gain[0] : v->gain[1];
+        loud = (v->target[0] > loud) ? v->target[0] : loud;
+        loud = (v->target[1] > loud) ? v->target[1] : loud;
+        key[a] = (v->is_virtual == CE_TRUE) ? loud : (loud * 1.25f);
+    }
+
+    /* Hoare selection, descending, until position keep - 1 is settled. */
+    lo = 0;
+    hi = (ce_s32)mixer->active_count - 1;
+    while (lo < hi) {
+        pivot = key[lo + ((hi - lo) / 2)];
+        i     = lo;
+        j     = hi;
+        while (i <= j) {
+            while (key[i] > pivot) {
+                i++;
+            }
+            while (key[j] < pivot) {
+                j--;
+            }
+            if (i <= j) {
+                tk     = key[i];
+                key[i] = key[j];
+                key[j] = tk;
+                ti     = ids[i];
+                ids[i] = ids[j];
+                ids[j] = ti;
+                i++;
+                j--;
+            }
+        }
+        if (((ce_s32)keep - 1) <= j) {
+            hi = j;
+        } else if (((ce_s32)keep - 1) >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Master gain (ramped across the block), clip and interleave.
+ */
+static void ce__mixer_output(ce_mixer* mixer, ce_f32* out, ce_u32 frames)
+{
+    ce_f32 step;
+
+    step = (mixer->master_target - mixer->master) / (ce_f32)frames;
+    mixer->kernels->output(mixer->mix[0], mixer->mix[1], out, frames, mixer->master, step);
+    mixer->master = mixer->master_target;
+}
+
+void ce_mixer_render(ce_mixer* mixer, ce_f32* out, ce_u32 frames)
+{
+    ce__mixer_cmd cmd;
+    ce__voice* v;
+    ce_f32x8 zero;
+    ce_bool alive;
+    ce_u32 virtuals;
+    ce_u64 start;
+    ce_u64 elapsed;
+    ce_u32 done;
+    ce_u32 n;
+    ce_u32 a;
+    ce_u32 i;
+
+    start    = ce_time_now_ns();
+    zero     = ce_f32x8_set1(0.0f);
+    virtuals = 0u;
+
+    mixer->kernels = (const ce__mixer_kernels*)ce_cpu_dispatch_table(&ce__mixer_dispatch);
+    while (ce_spsc_ring_pop(&mixer->commands, &cmd) == CE_TRUE) {
+        ce__mixer_apply(mixer, &cmd);
+    }
+
+    for (done = 0u; done < frames; done += n) {
+        n = ((frames - done) < CE_MIXER_BLOCK_FRAMES) ? (frames - done) : CE_MIXER_BLOCK_FRAMES;
+        for (i = 0u; i < n; i += 8u) {
+            ce_f32x8_store(&mixer->mix[0][i], zero);
+            ce_f32x8_store(&mixer->mix[1][i], zero);
+        }
+
+        if (mixer->active_count > mixer->real_limit) {
+            ce__mixer_rank(mixer, mixer->real_limit);
+        }
+
+        a        = 0u;
+        virtuals = 0u;
+        while (a < mixer->active_count) {
+            v = &mixer->voices[mixer->active[a]];
+            if (a < mixer->real_limit) {
+                if ((v->is_virtual == CE_TRUE) && (v->stopping == CE_FALSE)) {
+                    /* Audible again: same cursor, short fade from silence. */
+                    v->gain[0] = 0.0f;
+                    v->gain[1] = 0.0f;
+                    ce__voice_ramp(v, (v->ramp_left > CE_MIXER_RESUME_FRAMES) ? v->ramp_left : CE_MIXER_RESUME_FRAMES);
+                }
+                v->is_virtual = CE_FALSE;
+                alive = (v->stream != CE_NULL) ? ce__mix_stream_voice(mixer, v, n) : ce__mix_voice(mixer, v, n);
+            } else {
+                v->is_virtual = CE_TRUE;
+                virtuals     += 1u;
+                alive         = ce__skip_voice(v, n);
+            }
+            if (alive == CE_TRUE) {
+                a++;
+            } else {
+                v->active = CE_FALSE;
+                (void)ce_spsc_ring_push(&mixer->finished, &v->id);
+                mixer->active[a] = mixer->active[mixer->active_count - 1u];
+                mixer->active_count -= 1u;
+            }
+        }
+
+        ce__mixer_output(mixer, &out[done * 2u], n);
+    }
+
+    elapsed = ce_time_now_ns() - start;
+    ce_atomic_store_u32(&mixer->stat_active, mixer->active_count);
+    ce_atomic_store_u32(&mixer->stat_virtual, virtuals);
+    (void)ce_atomic_fetch_add_u64(&mixer->stat_frames, (ce_u64)frames);
+    ce_atomic_store_u64(&mixer->stat_ns_last, elapsed);
+    if (elapsed > ce_atomic_load_relaxed_u64(&mixer->stat_ns_max)) {
+        ce_atomic_store_u64(&mixer->stat_ns_max, elapsed);
+    }
+}
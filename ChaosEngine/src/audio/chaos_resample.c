@@ -0,0 +1,259 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_resample.c
+ * @brief Linear and polyphase sample-rate conversion.
+ *
+ * The polyphase filter is a 16-tap Kaiser-windowed sinc sampled at
+ * CE_RESAMPLE_PHASES fractional offsets; the two rows around the exact
+ * offset are blended, so phase quantization stays below the filter's own
+ * stop-band. Taps map onto two ce_f32x8 registers per output frame.
+ */
+#include "audio/chaos_resample.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_simd.h"
+
+#include <math.h>
+
+#define CE_RESAMPLE_KAISER_BETA 7.0
+/** @brief Cutoff as a fraction of the lower Nyquist rate (leaves room for the transition band). */
+#define CE_RESAMPLE_CUTOFF      0.92
+#define CE_RESAMPLE_FRAC_SCALE  (1.0f / 4294967296.0f)
+#define CE_RESAMPLE_PI          3.14159265358979323846
+
+/* ************************************************************************** */
+/* TABLE                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Zeroth-order modified Bessel function (power series).
+ */
+static ce_f64 ce__bessel_i0(ce_f64 x)
+{
+    ce_f64 sum;
+    ce_f64 term;
+    ce_f64 k;
+
+    sum  = 1.0;
+    term = 1.0;
+    for (k = 1.0; k < 32.0; k += 1.0) {
+        term *= (x * x) / (4.0 * k * k);
+        sum  += term;
+    }
+
+    return sum;
+}
+
+ce_u64 ce_resample_step(ce_u32 in_rate, ce_u32 out_rate)
+{
+    return (((ce_u64)in_rate << 32u) + ((ce_u64)out_rate / 2u)) / (ce_u64)out_rate;
+}
+
+ce_result ce_resample_table_init(ce_resample_table* table, ce_u32 in_rate, ce_u32 out_rate)
+{
+    ce_result res;
+    ce_f32* row;
+    ce_f64 fc;
+    ce_f64 t;
+    ce_f64 r;
+    ce_f64 h;
+    ce_f64 sum;
+    ce_f64 taps[CE_RESAMPLE_TAPS];
+    ce_u32 p;
+    ce_u32 j;
+
+    res = CE_OK;
+
+    if ((table == CE_NULL) || (in_rate == 0u) || (out_rate == 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        table->in_rate  = in_rate;
+        table->out_rate = out_rate;
+        table->coefs    = (ce_f32*)ce_mem_alloc((ce_size)(CE_RESAMPLE_PHASES + 1u) * CE_RESAMPLE_TAPS * sizeof(ce_f32),
+                                                (ce_size)64, CE_MEM_TAG_AUDIO);
+        if (table->coefs == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        fc = CE_RESAMPLE_CUTOFF * ((out_rate < in_rate) ? ((ce_f64)out_rate / (ce_f64)in_rate) : 1.0);
+
+        for (p = 0u; p <= CE_RESAMPLE_PHASES; p++) {
+            sum = 0.0;
+            for (j = 0u; j < CE_RESAMPLE_TAPS; j++) {
+                /* Tap j sits at source offset (j - 7) from the integer position. */
+                t = ((ce_f64)j - 7.0) - ((ce_f64)p / (ce_f64)CE_RESAMPLE_PHASES);
+                r = t / 8.0;
+                h = (fabs(t) < 1e-9) ? fc : (sin(CE_RESAMPLE_PI * fc * t) / (CE_RESAMPLE_PI * t));
+                h *= (fabs(r) < 1.0) ? (ce__bessel_i0(CE_RESAMPLE_KAISER_BETA * sqrt(1.0 - (r * r))) /
+                                        ce__bessel_i0(CE_RESAMPLE_KAISER_BETA))
+                                     : 0.0;
+                taps[j] = h;
+                sum    += h;
+            }
+
+            /* Unity DC gain for every phase. */
+            row = &table->coefs[p * CE_RESAMPLE_TAPS];
+            for (j = 0u; j < CE_RESAMPLE_TAPS; j++) {
+                row[j] = (ce_f32)(taps[j] / sum);
+            }
+        }
+    }
+
+    return res;
+}
+
+void ce_resample_table_shutdown(ce_resample_table* table)
+{
+    if (table != CE_NULL) {
+        ce_mem_free(table->coefs);
+        table->coefs = CE_NULL;
+    }
+}
+
+/* ************************************************************************** */
+/* KERNELS                                                                    */
+/* ************************************************************************** */
+
+ce_u32 ce_resample_interior_frames(ce_resample_quality quality, ce_u64 pos, ce_u64 step, ce_u32 count,
+                                   ce_u32 max_frames)
+{
+    ce_u64 idx;
+    ce_u64 last;
+    ce_u64 n;
+
+    idx = pos >> 32u;
+    n   = 0u;
+
+    if ((idx >= (ce_u64)CE_RESAMPLE_BEFORE(quality)) && ((ce_u64)count > (ce_u64)CE_RESAMPLE_AFTER(quality))) {
+        last = (ce_u64)count - 1u - (ce_u64)CE_RESAMPLE_AFTER(quality);
+        if (idx <= last) {
+            /* Frames k with pos + k * step still below (last + 1) << 32. */
+            n = ((((last + 1u) << 32u) - 1u - pos) / step) + 1u;
+        }
+    }
+
+    return (n < (ce_u64)max_frames) ? (ce_u32)n : max_frames;
+}
+
+void ce_resample_linear(const ce_f32* src, ce_u64 pos, ce_u64 step, ce_f32* out, ce_u32 frames)
+{
+    ce_f32 a[8];
+    ce_f32 b[8];
+    ce_f32 f[8];
+    ce_f32x8 va;
+    ce_u64 idx;
+    ce_u32 i;
+    ce_u32 k;
+
+    for (i = 0u; (i + 8u) <= frames; i += 8u) {
+        /* Scalar gather, vector blend. */
+        for (k = 0u; k < 8u; k++) {
+            idx  = pos >> 32u;
+            a[k] = src[idx];
+            b[k] = src[idx + 1u];
+            f[k] = (ce_f32)(pos & 0xFFFFFFFFull) * CE_RESAMPLE_FRAC_SCALE;
+            pos += step;
+        }
+        va = ce_f32x8_load(a);
+        ce_f32x8_store(&out[i], ce_f32x8_madd(ce_f32x8_load(f), ce_f32x8_sub(ce_f32x8_load(b), va), va));
+    }
+
+    for (; i < frames; i++) {
+        idx    = pos >> 32u;
+        out[i] = src[idx] + (((ce_f32)(pos & 0xFFFFFFFFull) * CE_RESAMPLE_FRAC_SCALE) * (src[idx + 1u] - src[idx]));
+        pos   += step;
+    }
+}
+
+void ce_resample_polyphase(const ce_resample_table* table, const ce_f32* src, ce_u64 pos, ce_u64 step, ce_f32* out,
+                           ce_u32 frames)
+{
+    const ce_f32* c0;
+    const ce_f32* s;
+    ce_f32 lanes[8];
+    ce_f32x8 blend;
+    ce_f32x8 k0;
+    ce_f32x8 k1;
+    ce_f32 phase;
+    ce_u32 p;
+    ce_u32 i;
+
+    for (i = 0u; i < frames; i++) {
+        phase = (ce_f32)(pos & 0xFFFFFFFFull) * (CE_RESAMPLE_FRAC_SCALE * (ce_f32)CE_RESAMPLE_PHASES);
+        p     = (ce_u32)phase;
+        p     = (p < CE_RESAMPLE_PHASES) ? p : (CE_RESAMPLE_PHASES - 1u);
+        blend = ce_f32x8_set1(phase - (ce_f32)p);
+        c0    = &table->coefs[p * CE_RESAMPLE_TAPS];
+        s     = &src[(pos >> 32u) - 7u];
+
+        k0 = ce_f32x8_madd(blend, ce_f32x8_sub(ce_f32x8_load(&c0[CE_RESAMPLE_TAPS]), ce_f32x8_load(c0)),
+                           ce_f32x8_load(c0));
+        k1 = ce_f32x8_madd(blend, ce_f32x8_sub(ce_f32x8_load(&c0[CE_RESAMPLE_TAPS + 8u]), ce_f32x8_load(&c0[8])),
+                           ce_f32x8_load(&c0[8]));
+        ce_f32x8_store(lanes, ce_f32x8_madd(ce_f32x8_load(s), k0, ce_f32x8_mul(ce_f32x8_load(&s[8]), k1)));
+
+        out[i] = ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5])) + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+        pos   += step;
+    }
+}
+
+static inline ce_f32 ce__resample_fetch(const ce_f32* src, ce_u32 count, ce_bool loop, ce_s64 i)
+{
+    ce_f32 v;
+
+    if ((i >= 0) && (i < (ce_s64)count)) {
+        v = src[i];
+    } else if ((loop == CE_TRUE) && (count != 0u)) {
+        v = src[((i % (ce_s64)count) + (ce_s64)count) % (ce_s64)count];
+    } else {
+        v = 0.0f;
+    }
+
+    return v;
+}
+
+ce_f32 ce_resample_edge(ce_resample_quality quality, const ce_resample_table* table, const ce_f32* src, ce_u32 count,
+                        ce_bool loop, ce_u64 pos)
+{
+    const ce_f32* c0;
+    ce_f32 frac;
+    ce_f32 phase;
+    ce_f32 blend;
+    ce_f32 a;
+    ce_f32 b;
+    ce_f32 v;
+    ce_s64 idx;
+    ce_u32 p;
+    ce_u32 j;
+
+    idx  = (ce_s64)(pos >> 32u);
+    frac = (ce_f32)(pos & 0xFFFFFFFFull) * CE_RESAMPLE_FRAC_SCALE;
+    v    = 0.0f;
+
+    if (quality == CE_RESAMPLE_POLYPHASE) {
+        phase = frac * (ce_f32)CE_RESAMPLE_PHASES;
+        p     = (ce_u32)phase;
+        p     = (p < CE_RESAMPLE_PHASES) ? p : (CE_RESAMPLE_PHASES - 1u);
+        blend = phase - (ce_f32)p;
+        c0    = &table->coefs[p * CE_RESAMPLE_TAPS];
+        for (j = 0u; j < CE_RESAMPLE_TAPS; j++) {
+            v += ce__resample_fetch(src, count, loop, (idx - 7) + (ce_s64)j) *
+                 (c0[j] + (blend * (c0[CE_RESAMPLE_TAPS + j] - c0[j])));
+        }
+    } else {
+        a = ce__resample_fetch(src, count, loop, idx);
+        b = ce__resample_fetch(src, count, loop, idx + 1);
+        v = a + (frac * (b - a));
+    }
+
+    return v;
+}
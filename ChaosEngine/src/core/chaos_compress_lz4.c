@@ -0,0 +1,248 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_compress_lz4.c
+ * @brief LZ4 block compressor and safe decompressor.
+ */
+#include "core/chaos_compress.h"
+#include "utility/chaos_string.h"
+
+#define CE__LZ4_MIN_MATCH     4u
+#define CE__LZ4_LAST_LITERALS 5u   /* The block always ends with literals. */
+#define CE__LZ4_MFLIMIT       12u  /* No match starts in the last 12 bytes. */
+#define CE__LZ4_MAX_OFFSET    65535u
+#define CE__LZ4_HASH_LOG      12u
+
+static inline ce_u32 ce__lz4_read32(const ce_u8* p)
+{
+    return (ce_u32)p[0] | ((ce_u32)p[1] << 8u) | ((ce_u32)p[2] << 16u) | ((ce_u32)p[3] << 24u);
+}
+
+static inline ce_u32 ce__lz4_hash(ce_u32 seq)
+{
+    return (seq * 2654435761u) >> (32u - CE__LZ4_HASH_LOG);
+}
+
+/* Writes the 255-run extension of a length whose nibble saturated at 15. */
+static ce_size ce__lz4_put_length(ce_u8* op, ce_size len)
+{
+    ce_size n;
+
+    n = 0u;
+    while (len >= 255u) {
+        op[n] = 255u;
+        n += 1u;
+        len -= 255u;
+    }
+    op[n] = (ce_u8)len;
+    return n + 1u;
+}
+
+/**
+ * @brief Emits one sequence: literals [lit, lit + lit_len) then an optional match.
+ * @return Bytes written, or 0 when they do not fit.
+ */
+static ce_size ce__lz4_emit(ce_u8* op, ce_size room, const ce_u8* lit, ce_size lit_len, ce_u32 offset,
+                            ce_size match_len)
+{
+    ce_u8* token;
+    ce_size need;
+    ce_size n;
+    ce_size ml;
+
+    ml   = (match_len != 0u) ? (match_len - CE__LZ4_MIN_MATCH) : 0u;
+    need = 1u + lit_len + (lit_len / 255u) + 1u + ((match_len != 0u) ? (2u + (ml / 255u) + 1u) : 0u);
+    n    = 0u;
+
+    if (need <= room) {
+        token = op;
+        n     = 1u;
+        *token = (ce_u8)(((lit_len >= 15u) ? 15u : lit_len) << 4u);
+        if (lit_len >= 15u) {
+            n += ce__lz4_put_length(op + n, lit_len - 15u);
+        }
+        (void)ce__memcpy(op + n, lit, lit_len);
+        n += lit_len;
+
+        if (match_len != 0u) {
+            op[n]      = (ce_u8)(offset & 0xFFu);
+            op[n + 1u] = (ce_u8)(offset >> 8u);
+            n += 2u;
+            *token |= (ce_u8)((ml >= 15u) ? 15u : ml);
+            if (ml >= 15u) {
+                n += ce__lz4_put_length(op + n, ml - 15u);
+            }
+        }
+    }
+
+    return n;
+}
+
+ce_size ce_lz4_compress_bound(ce_size size)
+{
+    return size + (size / 255u) + 16u;
+}
+
+ce_size ce_lz4_compress(const void* src, ce_size size, void* dst, ce_size capacity)
+{
+    ce_u32 table[1u << CE__LZ4_HASH_LOG];
+    const ce_u8* in;
+    ce_u8* out;
+    ce_size ip;
+    ce_size ref;
+    ce_size anchor;
+    ce_size op;
+    ce_size len;
+    ce_size n;
+    ce_size match_limit;
+    ce_u32 seq;
+    ce_u32 h;
+    ce_bool ok;
+
+    in     = (const ce_u8*)src;
+    out    = (ce_u8*)dst;
+    ip     = 1u;
+    anchor = 0u;
+    op     = 0u;
+    ok     = CE_TRUE;
+    (void)ce__memset(table, 0u, sizeof(table));
+
+    if (size > CE__LZ4_MFLIMIT) {
+        match_limit = size - CE__LZ4_LAST_LITERALS;
+        while ((ok == CE_TRUE) && (ip < (size - CE__LZ4_MFLIMIT))) {
+            seq      = ce__lz4_read32(in + ip);
+            h        = ce__lz4_hash(seq);
+            ref      = (ce_size)table[h];
+            table[h] = (ce_u32)ip;
+
+            if ((ref < ip) && ((ip - ref) <= CE__LZ4_MAX_OFFSET) && (ce__lz4_read32(in + ref) == seq)) {
+                while ((ip > anchor) && (ref > 0u) && (in[ip - 1u] == in[ref - 1u])) {
+                    ip -= 1u;
+                    ref -= 1u;
+                }
+                len = CE__LZ4_MIN_MATCH;
+                while (((ip + len) < match_limit) && (in[ref + len] == in[ip + len])) {
+                    len += 1u;
+                }
+
+                n = ce__lz4_emit(out + op, capacity - op, in + anchor, ip - anchor, (ce_u32)(ip - ref), len);
+                ok = (n != 0u) ? CE_TRUE : CE_FALSE;
+                op += n;
+                ip += len;
+                anchor = ip;
+                /* Seed the table inside the match so the next one chains. */
+                if ((ip - 2u) < (size - CE__LZ4_MFLIMIT)) {
+                    table[ce__lz4_hash(ce__lz4_read32(in + ip - 2u))] = (ce_u32)(ip - 2u);
+                }
+            } else {
+                ip += 1u;
+            }
+        }
+    }
+
+    if (ok == CE_TRUE) {
+        n  = ce__lz4_emit(out + op, capacity - op, in + anchor, size - anchor, 0u, 0u);
+        ok = (n != 0u) ? CE_TRUE : CE_FALSE;
+        op += n;
+    }
+
+    return (ok == CE_TRUE) ? op : 0u;
+}
+
+/* Reads a 255-run length extension; CE_FALSE when it runs off the input. */
+static ce_bool ce__lz4_get_length(const ce_u8* in, ce_size size, ce_size* ip, ce_size* len)
+{
+    ce_bool ok;
+    ce_u8 b;
+
+    ok = CE_TRUE;
+    b  = 255u;
+    while ((ok == CE_TRUE) && (b == 255u)) {
+        if (*ip >= size) {
+            ok = CE_FALSE;
+        } else {
+            b = in[*ip];
+            *ip += 1u;
+            *len += (ce_size)b;
+        }
+    }
+    return ok;
+}
+
+ce_result ce_lz4_decompress(const void* src, ce_size size, void* dst, ce_size dst_size)
+{
+    const ce_u8* in;
+    ce_u8* out;
+    ce_size ip;
+    ce_size op;
+    ce_size lit;
+    ce_size ml;
+    ce_size offset;
+    ce_size i;
+    ce_u8 token;
+    ce_bool ok;
+    ce_bool done;
+
+    in   = (const ce_u8*)src;
+    out  = (ce_u8*)dst;
+    ip   = 0u;
+    op   = 0u;
+    ok   = (size != 0u) ? CE_TRUE : CE_FALSE;
+    done = CE_FALSE;
+
+    while ((ok == CE_TRUE) && (done == CE_FALSE)) {
+        token = in[ip];
+        ip += 1u;
+
+        lit = (ce_size)(token >> 4u);
+        if (lit == 15u) {
+            ok = ce__lz4_get_length(in, size, &ip, &lit);
+        }
+        if ((ok == CE_TRUE) && ((lit > (size - ip)) || (lit > (dst_size - op)))) {
+            ok = CE_FALSE;
+        }
+        if (ok == CE_TRUE) {
+            (void)ce__memcpy(out + op, in + ip, lit);
+            ip += lit;
+            op += lit;
+            done = (ip == size) ? CE_TRUE : CE_FALSE;
+        }
+
+        if ((ok == CE_TRUE) && (done == CE_FALSE)) {
+            if ((size - ip) < 2u) {
+                ok = CE_FALSE;
+            } else {
+                offset = (ce_size)in[ip] | ((ce_size)in[ip + 1u] << 8u);
+                ip += 2u;
+                ml = (ce_size)(token & 15u);
+                if (ml == 15u) {
+                    ok = ce__lz4_get_length(in, size, &ip, &ml);
+                }
+                ml += CE__LZ4_MIN_MATCH;
+                if ((offset == 0u) || (offset > op) || (ml > (dst_size - op)) || (ip >= size)) {
+                    ok = CE_FALSE;
+                }
+            }
+            if (ok == CE_TRUE) {
+                if (offset >= ml) {
+                    (void)ce__memcpy(out + op, out + op - offset, ml);
+                } else {
+                    /* Overlapping copy replicates the last `offset` bytes. */
+                    for (i = 0u; i < ml; i++) {
+                        out[op + i] = out[op + i - offset];
+                    }
+                }
+                op += ml;
+            }
+        }
+    }
+
+    return ((ok == CE_TRUE) && (op == dst_size)) ? CE_OK : CE_ERR_FORMAT;
+}
@@ -9,8 +9,158 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_containers_dynarray.c
- * @brief Implementation skeleton.
+ * @brief Growable array of fixed-size elements.
  */
 #include "core/chaos_containers.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+ce_result ce_dynarray_init(ce_dynarray* arr, ce_size elem_size, ce_size initial_capacity, ce_mem_tag tag)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((arr == CE_NULL) || (elem_size == (ce_size)0)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        arr->data      = CE_NULL;
+        arr->count     = (ce_size)0;
+        arr->capacity  = (ce_size)0;
+        arr->elem_size = elem_size;
+        arr->tag       = tag;
+        if (initial_capacity != (ce_size)0) {
+            res = ce_dynarray_reserve(arr, initial_capacity);
+        }
+    }
+
+    return res;
+}
+
+void ce_dynarray_shutdown(ce_dynarray* arr)
+{
+    if (arr != CE_NULL) {
+        ce_mem_free(arr->data);
+        arr->data     = CE_NULL;
+        arr->count    = (ce_size)0;
+        arr->capacity = (ce_size)0;
+    }
+}
+
+ce_result ce_dynarray_reserve(ce_dynarray* arr, ce_size capacity)
+{
+    ce_result res;
+    void* grown;
+
+    res = CE_OK;
+
+    if (capacity > arr->capacity) {
+        grown = ce_mem_realloc(arr->data, capacity * arr->elem_size, CE_MEM_DEFAULT_ALIGN, arr->tag);
+        if (grown == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            arr->data     = grown;
+            arr->capacity = capacity;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief Grows geometrically so that `needed` elements fit.
+ */
+static ce_result ce__dynarray_grow(ce_dynarray* arr, ce_size needed)
+{
+    ce_result res;
+    ce_size cap;
+
+    res = CE_OK;
+
+    if (needed > arr->capacity) {
+        cap = (arr->capacity < (ce_size)8) ? (ce_size)8 : arr->capacity;
+        while (cap < needed) {
+            cap += cap >> 1;
+        }
+        res = ce_dynarray_reserve(arr, cap);
+    }
+
+    return res;
+}
+
+ce_result ce_dynarray_resize(ce_dynarray* arr, ce_size count)
+{
+    ce_result res;
+
+    res = ce__dynarray_grow(arr, count);
+    if (res == CE_OK) {
+        if (count > arr->count) {
+            (void)ce__memset((ce_u8*)arr->data + (arr->count * arr->elem_size), 0u,
+                             (count - arr->count) * arr->elem_size);
+        }
+        arr->count = count;
+    }
+
+    return res;
+}
+
+void* ce_dynarray_push(ce_dynarray* arr, const void* elem)
+{
+    void* slot;
+
+    slot = ce_dynarray_push_n(arr, (ce_size)1);
+    if (slot != CE_NULL) {
+        if (elem != CE_NULL) {
+            (void)ce__memcpy(slot, elem, arr->elem_size);
+        } else {
+            (void)ce__memset(slot, 0u, arr->elem_size);
+        }
+    }
+
+    return slot;
+}
+
+void* ce_dynarray_push_n(ce_dynarray* arr, ce_size n)
+{
+    void* slot;
+
+    slot = CE_NULL;
+
+    if (ce__dynarray_grow(arr, arr->count + n) == CE_OK) {
+        slot = (ce_u8*)arr->data + (arr->count * arr->elem_size);
+        arr->count += n;
+    }
+
+    return slot;
+}
+
+void ce_dynarray_remove_swap(ce_dynarray* arr, ce_size index)
+{
+    ce_size last;
+
+    if (index < arr->count) {
+        last = arr->count - (ce_size)1;
+        if (index != last) {
+            (void)ce__memcpy((ce_u8*)arr->data + (index * arr->elem_size),
+                             (ce_u8*)arr->data + (last * arr->elem_size),
+                             arr->elem_size);
+        }
+        arr->count = last;
+    }
+}
+
+void ce_dynarray_clear(ce_dynarray* arr)
+{
+    arr->count = (ce_size)0;
+}
+
+void* ce_dynarray_at(const ce_dynarray* arr, ce_size index)
+{
+    void* ptr;
+
+    ptr = CE_NULL;
+    if (index < arr->count) {
+        ptr = (ce_u8*)arr->data + (index * arr->elem_size);
+    }
+
+    return ptr;
+}
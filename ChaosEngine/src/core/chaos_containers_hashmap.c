@@ -9,8 +9,251 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_containers_hashmap.c
- * @brief Implementation skeleton.
+ * @brief Open-addressing u64 -> u64 hashmap and hashing helpers.
  */
 #include "core/chaos_containers.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#define CE_FNV64_OFFSET 0xcbf29ce484222325ull
+#define CE_FNV64_PRIME  0x100000001b3ull
+
+/* ************************************************************************** */
+/* HASHING                                                                    */
+/* ************************************************************************** */
+
+ce_u64 ce_hash_bytes(const void* data, ce_size size)
+{
+    ce_u64 h;
+    const ce_u8* p;
+    ce_size i;
+
+    h = CE_FNV64_OFFSET;
+    p = (const ce_u8*)data;
+
+    for (i = (ce_size)0; i < size; i++) {
+        h ^= (ce_u64)p[i];
+        h *= CE_FNV64_PRIME;
+    }
+
+    return (h == 0ull) ? 1ull : h;
+}
+
+ce_u64 ce_hash_str(const ce_char* str)
+{
+    return ce_hash_bytes(str, ce__strlen(str));
+}
+
+ce_u64 ce_hash_combine(ce_u64 a, ce_u64 b)
+{
+    ce_u64 h;
+
+    h = a ^ (b + 0x9e3779b97f4a7c15ull + (a << 6) + (a >> 2));
+
+    return (h == 0ull) ? 1ull : h;
+}
+
+/* ************************************************************************** */
+/* HASHMAP                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Finalizer spreading key bits over the slot index (splitmix64).
+ */
+static ce_u32 ce__hashmap_slot(ce_u64 key, ce_u32 mask)
+{
+    ce_u64 z;
+
+    z = key;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z = z ^ (z >> 31);
+
+    return (ce_u32)z & mask;
+}
+
+/**
+ * @brief Rehashes into a table of `capacity` slots (power of two).
+ */
+static ce_result ce__hashmap_rehash(ce_hashmap* map, ce_u32 capacity)
+{
+    ce_result res;
+    ce_u64* keys;
+    ce_u64* values;
+    ce_u32 i;
+    ce_u32 slot;
+    ce_u32 mask;
+
+    res    = CE_OK;
+    keys   = (ce_u64*)ce_mem_calloc((ce_size)capacity * sizeof(ce_u64), CE_MEM_DEFAULT_ALIGN, map->tag);
+    values = (ce_u64*)ce_mem_alloc((ce_size)capacity * sizeof(ce_u64), CE_MEM_DEFAULT_ALIGN, map->tag);
+
+    if ((keys == CE_NULL) || (values == CE_NULL)) {
+        ce_mem_free(keys);
+        ce_mem_free(values);
+        res = CE_ERR_OUT_OF_MEMORY;
+    } else {
+        mask = capacity - 1u;
+        for (i = 0u; i < map->capacity; i++) {
+            if (map->keys[i] != 0ull) {
+                slot = ce__hashmap_slot(map->keys[i], mask);
+                while (keys[slot] != 0ull) {
+                    slot = (slot + 1u) & mask;
+                }
+                keys[slot]   = map->keys[i];
+                values[slot] = map->values[i];
+            }
+        }
+        ce_mem_free(map->keys);
+        ce_mem_free(map->values);
+        map->keys     = keys;
+        map->values   = values;
+        map->capacity = capacity;
+    }
+
+    return res;
+}
+
+ce_result ce_hashmap_init(ce_hashmap* map, ce_u32 initial_capacity, ce_mem_tag tag)
+{
+    ce_result res;
+    ce_u32 cap;
+
+    res = CE_OK;
+
+    if (map == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        map->keys     = CE_NULL;
+        map->values   = CE_NULL;
+        map->capacity = 0u;
+        map->count    = 0u;
+        map->tag      = tag;
+
+        /* Keep the load factor under 3/4. */
+        cap = 16u;
+        while ((cap - (cap >> 2)) < initial_capacity) {
+            cap <<= 1;
+        }
+        res = ce__hashmap_rehash(map, cap);
+    }
+
+    return res;
+}
+
+void ce_hashmap_shutdown(ce_hashmap* map)
+{
+    if (map != CE_NULL) {
+        ce_mem_free(map->keys);
+        ce_mem_free(map->values);
+        map->keys     = CE_NULL;
+        map->values   = CE_NULL;
+        map->capacity = 0u;
+        map->count    = 0u;
+    }
+}
+
+ce_result ce_hashmap_put(ce_hashmap* map, ce_u64 key, ce_u64 value)
+{
+    ce_result res;
+    ce_u32 slot;
+    ce_u32 mask;
+
+    res = CE_OK;
+
+    if (key == 0ull) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        if (((map->count + 1u) * 4u) > (map->capacity * 3u)) {
+            res = ce__hashmap_rehash(map, (map->capacity == 0u) ? 16u : (map->capacity << 1));
+        }
+        if (res == CE_OK) {
+            mask = map->capacity - 1u;
+            slot = ce__hashmap_slot(key, mask);
+            while ((map->keys[slot] != 0ull) && (map->keys[slot] != key)) {
+                slot = (slot + 1u) & mask;
+            }
+            if (map->keys[slot] == 0ull) {
+                map->keys[slot] = key;
+                map->count++;
+            }
+            map->values[slot] = value;
+        }
+    }
+
+    return res;
+}
+
+ce_bool ce_hashmap_get(const ce_hashmap* map, ce_u64 key, ce_u64* out_value)
+{
+    ce_bool found;
+    ce_u32 slot;
+    ce_u32 mask;
+
+    found = CE_FALSE;
+
+    if ((key != 0ull) && (map->capacity != 0u)) {
+        mask = map->capacity - 1u;
+        slot = ce__hashmap_slot(key, mask);
+        while ((found == CE_FALSE) && (map->keys[slot] != 0ull)) {
+            if (map->keys[slot] == key) {
+                found = CE_TRUE;
+                if (out_value != CE_NULL) {
+                    *out_value = map->values[slot];
+                }
+            } else {
+                slot = (slot + 1u) & mask;
+            }
+        }
+    }
+
+    return found;
+}
+
+ce_bool ce_hashmap_remove(ce_hashmap* map, ce_u64 key)
+{
+    ce_bool found;
+    ce_u32 slot;
+    ce_u32 next;
+    ce_u32 home;
+    ce_u32 mask;
+
+    found = CE_FALSE;
+
+    if ((key != 0ull) && (map->capacity != 0u)) {
+        mask = map->capacity - 1u;
+        slot = ce__hashmap_slot(key, mask);
+        while ((found == CE_FALSE) && (map->keys[slot] != 0ull)) {
+            if (map->keys[slot] == key) {
+                found = CE_TRUE;
+            } else {
+                slot = (slot + 1u) & mask;
+            }
+        }
+
+        if (found == CE_TRUE) {
+            /* Backward-shift: pull later entries of the cluster into the hole. */
+            next = (slot + 1u) & mask;
+            while (map->keys[next] != 0ull) {
+                home = ce__hashmap_slot(map->keys[next], mask);
+                if (((next - home) & mask) >= ((next - slot) & mask)) {
+                    map->keys[slot]   = map->keys[next];
+                    map->values[slot] = map->values[next];
+                    slot              = next;
+                }
+                next = (next + 1u) & mask;
+            }
+            map->keys[slot] = 0ull;
+            map->count--;
+        }
+    }
+
+    return found;
+}
+
+void ce_hashmap_clear(ce_hashmap* map)
+{
+    if (map->capacity != 0u) {
+        (void)ce__memset(map->keys, 0u, (ce_size)map->capacity * sizeof(ce_u64));
+    }
+    map->count = 0u;
+}
@@ -0,0 +1,99 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_containers_ring.c
+ * @brief Bounded single-producer / single-consumer ring.
+ *
+ * head and tail are free-running counters; the slot is counter & mask. The
+ * producer publishes an item with a release store of tail, the consumer
+ * frees its slot with a release store of head.
+ */
+#include "core/chaos_containers.h"
+#include "utility/chaos_string.h"
+
+ce_result ce_spsc_ring_init(ce_spsc_ring* ring, ce_size elem_size, ce_u32 capacity, ce_mem_tag tag)
+{
+    ce_result res;
+    ce_u32 cap;
+
+    res = CE_OK;
+
+    if ((ring == CE_NULL) || (elem_size == (ce_size)0) || (capacity == 0u) || (capacity > 0x80000000u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        cap = 1u;
+        while (cap < capacity) {
+            cap <<= 1u;
+        }
+
+        (void)ce__memset(ring, 0u, sizeof(*ring));
+        ring->elem_size = elem_size;
+        ring->mask      = cap - 1u;
+        ring->tag       = tag;
+        ring->data      = (ce_u8*)ce_mem_alloc((ce_size)cap * elem_size, (ce_size)64, tag);
+        if (ring->data == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    return res;
+}
+
+void ce_spsc_ring_shutdown(ce_spsc_ring* ring)
+{
+    if (ring != CE_NULL) {
+        ce_mem_free(ring->data);
+        ring->data = CE_NULL;
+        ring->mask = 0u;
+    }
+}
+
+ce_bool ce_spsc_ring_push(ce_spsc_ring* ring, const void* item)
+{
+    ce_bool ok;
+    ce_u32 tail;
+    ce_u32 head;
+
+    ok   = CE_FALSE;
+    tail = ce_atomic_load_relaxed_u32(&ring->tail);
+    head = ce_atomic_load_u32(&ring->head);
+
+    if ((tail - head) <= ring->mask) {
+        (void)ce__memcpy(ring->data + ((ce_size)(tail & ring->mask) * ring->elem_size), item, ring->elem_size);
+        ce_atomic_store_u32(&ring->tail, tail + 1u);
+        ok = CE_TRUE;
+    }
+
+    return ok;
+}
+
+ce_bool ce_spsc_ring_pop(ce_spsc_ring* ring, void* item)
+{
+    ce_bool ok;
+    ce_u32 head;
+    ce_u32 tail;
+
+    ok   = CE_FALSE;
+    head = ce_atomic_load_relaxed_u32(&ring->head);
+    tail = ce_atomic_load_u32(&ring->tail);
+
+    if (head != tail) {
+        (void)ce__memcpy(item, ring->data + ((ce_size)(head & ring->mask) * ring->elem_size), ring->elem_size);
+        ce_atomic_store_u32(&ring->head, head + 1u);
+        ok = CE_TRUE;
+    }
+
+    return ok;
+}
+
+ce_u32 ce_spsc_ring_count(const ce_spsc_ring* ring)
+{
+    return ce_atomic_load_u32(&ring->tail) - ce_atomic_load_u32(&ring->head);
+}
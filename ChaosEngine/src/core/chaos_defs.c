@@ -9,8 +9,162 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_defs.c
- * @brief Implementation skeleton.
+ * @brief Runtime CPU feature detection and dispatch-table selection.
  */
+#include "core/chaos_defs.h"
+#include "platform/chaos_thread.h"
 
+#if defined(CE_CPU_DISPATCH_X64)
+#include <cpuid.h>
+#endif
 
-/* TODO: implement */
+/* Marks ce__cpu_detected as filled in; never a feature bit. */
+#define CE__CPU_VALID (1u << 31)
+
+/* ce_cpu_dispatch state: 24-bit mask generation over an 8-bit index + 1. */
+#define CE__CPU_GEN_SHIFT 8u
+#define CE__CPU_GEN_MASK  0xFFFFFFu
+#define CE__CPU_INDEX_MAX 0xFFu
+
+static ce_atomic_u32 ce__cpu_detected;
+static ce_atomic_u32 ce__cpu_disabled;
+static ce_atomic_u32 ce__cpu_generation;
+
+static const ce_char* const ce__cpu_names[] = {
+    "sse2", "sse4.1", "sse4.2", "avx", "avx2", "fma", "neon"
+};
+
+/* ************************************************************************** */
+/* DETECTION                                                                  */
+/* ************************************************************************** */
+
+#if defined(CE_CPU_DISPATCH_X64)
+/* XCR0: which register files the OS saves on a context switch. */
+static ce_u64 ce__cpu_xgetbv(void)
+{
+    ce_u32 lo;
+    ce_u32 hi;
+
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0u));
+
+    return ((ce_u64)hi << 32u) | (ce_u64)lo;
+}
+#endif
+
+static ce_u32 ce__cpu_detect(void)
+{
+    ce_u32 features;
+#if defined(CE_CPU_DISPATCH_X64)
+    ce_u32 a;
+    ce_u32 b;
+    ce_u32 c;
+    ce_u32 d;
+    ce_bool ymm;
+
+    features = CE_CPU_SSE2;
+    if (__get_cpuid(1u, &a, &b, &c, &d) != 0) {
+        features |= ((c & (1u << 19)) != 0u) ? CE_CPU_SSE41 : 0u;
+        features |= ((c & (1u << 20)) != 0u) ? CE_CPU_SSE42 : 0u;
+
+        /* AVX needs both the CPU bit and OSXSAVE with XMM+YMM enabled in XCR0. */
+        ymm = (((c & (1u << 27)) != 0u) && ((ce__cpu_xgetbv() & 6u) == 6u)) ? CE_TRUE : CE_FALSE;
+        if ((ymm == CE_TRUE) && ((c & (1u << 28)) != 0u)) {
+            features |= CE_CPU_AVX;
+            features |= ((c & (1u << 12)) != 0u) ? CE_CPU_FMA : 0u;
+            if ((__get_cpuid_count(7u, 0u, &a, &b, &c, &d) != 0) && ((b & (1u << 5)) != 0u)) {
+                features |= CE_CPU_AVX2;
+            }
+        }
+    }
+#elif defined(CE_ARCH_X64) || defined(__SSE2__)
+    features = CE_CPU_SSE2;
+#elif defined(CE_ARCH_ARM64) || defined(__ARM_NEON)
+    /* Mandatory on AArch64, and a build-time choice on 32-bit ARM. */
+    features = CE_CPU_NEON;
+#else
+    features = 0u;
+#endif
+
+    return features;
+}
+
+/* Index of the first variant `features` covers, `count` when none does. */
+static ce_u32 ce__cpu_select_index(const ce_cpu_variant* variants, ce_u32 count, ce_u32 features)
+{
+    ce_u32 i;
+
+    i = 0u;
+    while ((i < count) && ((variants[i].features & features) != variants[i].features)) {
+        i++;
+    }
+
+    return i;
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_u32 ce_cpu_features(void)
+{
+    ce_u32 features;
+
+    features = ce_atomic_load_relaxed_u32(&ce__cpu_detected);
+    if (CE_UNLIKELY(features == 0u)) {
+        /* Racing first calls detect the same value; storing it twice is harmless. */
+        features = ce__cpu_detect() | CE__CPU_VALID;
+        ce_atomic_store_relaxed_u32(&ce__cpu_detected, features);
+    }
+
+    return features & ~(CE__CPU_VALID | ce_atomic_load_relaxed_u32(&ce__cpu_disabled));
+}
+
+void ce_cpu_set_mask(ce_u32 allowed)
+{
+    ce_atomic_store_relaxed_u32(&ce__cpu_disabled, ~allowed);
+    /* Release: a reader that sees the new generation also sees the new mask. */
+    (void)ce_atomic_fetch_add_u32(&ce__cpu_generation, 1u);
+}
+
+const void* ce_cpu_select(const ce_cpu_variant* variants, ce_u32 count)
+{
+    ce_u32 i;
+
+    i = ce__cpu_select_index(variants, count, ce_cpu_features());
+
+    return (i < count) ? variants[i].table : CE_NULL;
+}
+
+const void* ce_cpu_dispatch_table(ce_cpu_dispatch* dispatch)
+{
+    ce_u32 generation;
+    ce_u32 state;
+    ce_u32 i;
+
+    generation = ce_atomic_load_u32(&ce__cpu_generation) & CE__CPU_GEN_MASK;
+    state      = ce_atomic_load_relaxed_u32(&dispatch->state);
+    if (CE_UNLIKELY((state == 0u) || ((state >> CE__CPU_GEN_SHIFT) != generation))) {
+        /* Racing resolvers compute the same index; storing it twice is harmless. */
+        i     = ce__cpu_select_index(dispatch->variants, dispatch->count, ce_cpu_features());
+        state = ((i < dispatch->count) && (i < CE__CPU_INDEX_MAX)) ? ((generation << CE__CPU_GEN_SHIFT) | (i + 1u))
+                                                                   : 0u;
+        ce_atomic_store_relaxed_u32(&dispatch->state, state);
+    }
+
+    return (state != 0u) ? dispatch->variants[(state & CE__CPU_INDEX_MAX) - 1u].table : CE_NULL;
+}
+
+const ce_char* ce_cpu_feature_name(ce_u32 feature)
+{
+    const ce_char* name;
+    ce_u32 i;
+
+    name = "unknown";
+    for (i = 0u; i < (ce_u32)CE_ARRAY_COUNT(ce__cpu_names); i++) {
+        if (feature == (1u << i)) {
+            name = ce__cpu_names[i];
+        }
+    }
+
+    return name;
+}
@@ -9,8 +9,29 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_error.c
- * @brief Implementation skeleton.
+ * @brief Result code helpers.
  */
 #include "core/chaos_error.h"
 
-/* TODO: implement */
+static const ce_char* const ce__result_names[CE_ERR_COUNT] = {
+    "CE_OK",
+    "CE_ERR_INVALID_ARG",
+    "CE_ERR_OUT_OF_MEMORY",
+    "CE_ERR_NOT_FOUND",
+    "CE_ERR_FULL",
+    "CE_ERR_FORMAT",
+    "CE_ERR_IO",
+    "CE_ERR_UNSUPPORTED"
+};
+
+const ce_char* ce_result_str(ce_result res)
+{
+    const ce_char* name;
+
+    name = "CE_ERR_UNKNOWN";
+    if (((ce_u32)res) < (ce_u32)CE_ERR_COUNT) {
+        name = ce__result_names[res];
+    }
+
+    return name;
+}
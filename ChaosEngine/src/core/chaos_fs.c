@@ -9,8 +9,765 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_fs.c
- * @brief Implementation skeleton.
+ * @brief Whole-file reads, async read queue and packed archive (.cpak) runtime.
+ *
+ * Native file primitives and mapping live in the platform layer. The async
+ * queue talks to io_uring through raw syscalls (no liburing): requests go
+ * into the submission ring and a single io_uring_enter() hands a whole
+ * batch to the kernel. Where io_uring is missing or forbidden, worker
+ * threads run blocking preads instead. Either way callbacks only run on
+ * the owner thread, from ce_fs_io_poll() / ce_fs_io_wait().
  */
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
 #include "core/chaos_fs.h"
+#include "core/chaos_compress.h"
+#include "core/chaos_containers.h"
+#include "platform/chaos_thread.h"
+#include "utility/chaos_string.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define CE__FS_HAVE_URING 1
+#endif
+#endif
+
+#if defined(CE__FS_HAVE_URING)
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define CE__FS_DEFAULT_DEPTH   64u
+#define CE__FS_DEFAULT_WORKERS 4u
+#define CE__FS_MAX_CHUNK       0x7FFFF000u /* Largest single read Linux performs. */
+
+/* ************************************************************************** */
+/* WHOLE FILES                                                                */
+/* ************************************************************************** */
+
+ce_result ce_fs_read_file(const ce_char* path, ce_arena* arena, void** out_data, ce_size* out_size)
+{
+    ce_result res;
+    ce_fs_file file;
+    ce_u64 size;
+    ce_size mark;
+    ce_u8* data;
+
+    data = CE_NULL;
+    size = 0u;
+    if ((arena == CE_NULL) || (out_data == CE_NULL) || (out_size == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        mark = ce_arena_mark(arena);
+        res  = ce_fs_open(path, &file);
+        if (res == CE_OK) {
+            res = ce_fs_size(file, &size);
+            if ((res == CE_OK) && (size >= (ce_u64)(~(ce_size)0))) {
+                res = CE_ERR_OUT_OF_MEMORY;
+            }
+            if (res == CE_OK) {
+                data = (ce_u8*)ce_arena_alloc(arena, (ce_size)size + 1u, CE_MEM_DEFAULT_ALIGN);
+                res  = (data != CE_NULL) ? ce_fs_read_at(file, 0u, data, (ce_size)size, CE_NULL)
+                                         : CE_ERR_OUT_OF_MEMORY;
+            }
+            ce_fs_close(&file);
+        }
+        if (res == CE_OK) {
+            data[size] = 0u;
+            *out_data  = data;
+            *out_size  = (ce_size)size;
+        } else {
+            ce_arena_rewind(arena, mark);
+        }
+    }
+
+    return res;
+}
+
+/* ************************************************************************** */
+/* ASYNC READS                                                                */
+/* ************************************************************************** */
+
+typedef struct ce__fs_op_s {
+    ce_fs_read_request req;
+    ce_size            done;   /* Bytes read so far. */
+    ce_result          result; /* Thread backend. */
+} ce__fs_op;
+
+/** @brief Fixed ring of op indices (never holds more than the queue depth). */
+typedef struct ce__fs_fifo_s {
+    ce_u32* items;
+    ce_u32  head;
+    ce_u32  count;
+} ce__fs_fifo;
+
+#if defined(CE__FS_HAVE_URING)
+typedef struct ce__fs_uring_s {
+    int                  fd;
+    void*                sq_ptr;
+    size_t               sq_size;
+    void*                cq_ptr;
+    size_t               cq_size;
+    struct io_uring_sqe* sqes;
+    size_t               sqes_size;
+    ce_atomic_u32*       sq_tail;
+    ce_u32*              sq_array;
+    ce_u32               sq_mask;
+    ce_atomic_u32*       cq_head;
+    ce_atomic_u32*       cq_tail;
+    ce_u32               cq_mask;
+    struct io_uring_cqe* cqes;
+    ce_u32               unsubmitted;
+} ce__fs_uring;
+#endif
+
+struct ce_fs_io_s {
+    ce_fs_io_backend backend;
+    ce_u32           capacity;
+    ce__fs_op*       ops;
+    ce_u32*          free_ops;   /* Stack; owner thread only. */
+    ce_u32           free_count;
+    ce_fs_io_stats   stats;
+
+    /* Thread backend. */
+    ce_mutex         mutex;
+    ce_cond          work;
+    ce_cond          finished;
+    ce__fs_fifo      queued;
+    ce__fs_fifo      done;
+    ce_bool          stop;
+    ce_thread        workers[CE_FS_IO_MAX_WORKERS];
+    ce_u32           worker_count;
+
+#if defined(CE__FS_HAVE_URING)
+    ce__fs_uring     ring;
+#endif
+};
+
+static void ce__fs_fifo_push(ce__fs_fifo* f, ce_u32 capacity, ce_u32 v)
+{
+    ce_u32 at;
+
+    at = f->head + f->count;
+    at = (at >= capacity) ? (at - capacity) : at;
+    f->items[at] = v;
+    f->count += 1u;
+}
+
+static ce_u32 ce__fs_fifo_pop(ce__fs_fifo* f, ce_u32 capacity)
+{
+    ce_u32 v;
+
+    v       = f->items[f->head];
+    f->head = (f->head + 1u == capacity) ? 0u : (f->head + 1u);
+    f->count -= 1u;
+    return v;
+}
+
+/* Releases the op slot first so the callback may submit again. */
+static void ce__fs_complete(ce_fs_io* io, ce_u32 index, ce_result result)
+{
+    ce_fs_read_request req;
+    ce_size bytes;
+
+    req   = io->ops[index].req;
+    bytes = io->ops[index].done;
+    io->free_ops[io->free_count] = index;
+    io->free_count += 1u;
+
+    io->stats.in_flight -= 1u;
+    io->stats.completed += 1u;
+    io->stats.bytes     += (ce_u64)bytes;
+    if (result != CE_OK) {
+        io->stats.failed += 1u;
+    }
+    if (req.done != CE_NULL) {
+        req.done(req.user, result, bytes);
+    }
+}
+
+/* ---------------------------------------------------------------- threads */
+
+static void ce__fs_worker(void* user)
+{
+    ce_fs_io* io;
+    ce__fs_op* op;
+    ce_u32 index;
+
+    io = (ce_fs_io*)user;
+    ce_mutex_lock(&io->mutex);
+    while (io->stop == CE_FALSE) {
+        if (io->queued.count == 0u) {
+            ce_cond_wait(&io->work, &io->mutex);
+        } else {
+            index = ce__fs_fifo_pop(&io->queued, io->capacity);
+            ce_mutex_unlock(&io->mutex);
+
+            op         = &io->ops[index];
+            op->result = ce_fs_read_at(op->req.file, op->req.offset, op->req.dst, op->req.size, &op->done);
+
+            ce_mutex_lock(&io->mutex);
+            ce__fs_fifo_push(&io->done, io->capacity, index);
+            ce_cond_signal(&io->finished);
+        }
+    }
+    ce_mutex_unlock(&io->mutex);
+}
+
+static ce_u32 ce__fs_threads_poll(ce_fs_io* io)
+{
+    ce_u32 index;
+    ce_u32 n;
+
+    n = 0u;
+    ce_mutex_lock(&io->mutex);
+    while (io->done.count != 0u) {
+        index = ce__fs_fifo_pop(&io->done, io->capacity);
+        ce_mutex_unlock(&io->mutex);
+        ce__fs_complete(io, index, io->ops[index].result);
+        n += 1u;
+        ce_mutex_lock(&io->mutex);
+    }
+    ce_mutex_unlock(&io->mutex);
+
+    return n;
+}
+
+static void ce__fs_threads_block(ce_fs_io* io)
+{
+    ce_mutex_lock(&io->mutex);
+    while (io->done.count == 0u) {
+        ce_cond_wait(&io->finished, &io->mutex);
+    }
+    ce_mutex_unlock(&io->mutex);
+}
+
+/* ---------------------------------------------------------------- io_uring */
+
+#if defined(CE__FS_HAVE_URING)
+
+static ce_result ce__fs_uring_init(ce__fs_uring* r, ce_u32 entries)
+{
+    struct io_uring_params p;
+    ce_result res;
+    ce_u8* sq;
+    ce_u8* cq;
+
+    res = CE_OK;
+    (void)ce__memset(r, 0u, sizeof(*r));
+    (void)ce__memset(&p, 0u, sizeof(p));
+    r->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+
+    /* IORING_OP_READ arrived with RW_CUR_POS (5.6): older rings are no use. */
+    if ((r->fd < 0) || ((p.features & IORING_FEAT_RW_CUR_POS) == 0u)) {
+        res = CE_ERR_UNSUPPORTED;
+    } else {
+        r->sq_size   = (size_t)p.sq_off.array + ((size_t)p.sq_entries * sizeof(ce_u32));
+        r->cq_size   = (size_t)p.cq_off.cqes + ((size_t)p.cq_entries * sizeof(struct io_uring_cqe));
+        r->sqes_size = (size_t)p.sq_entries * sizeof(struct io_uring_sqe);
+        if ((p.features & IORING_FEAT_SINGLE_MMAP) != 0u) {
+            r->sq_size = (r->cq_size > r->sq_size) ? r->cq_size : r->sq_size;
+        }
+        r->sq_ptr = mmap(CE_NULL, r->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd,
+                         (off_t)IORING_OFF_SQ_RING);
+        if ((p.features & IORING_FEAT_SINGLE_MMAP) != 0u) {
+            r->cq_ptr = r->sq_ptr;
+        } else {
+            r->cq_ptr = mmap(CE_NULL, r->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd,
+                             (off_t)IORING_OFF_CQ_RING);
+        }
+        r->sqes = (struct io_uring_sqe*)mmap(CE_NULL, r->sqes_size, PROT_READ | PROT_WRITE,
+                                             MAP_SHARED | MAP_POPULATE, r->fd, (off_t)IORING_OFF_SQES);
+        if ((r->sq_ptr == MAP_FAILED) || (r->cq_ptr == MAP_FAILED) || ((void*)r->sqes == MAP_FAILED)) {
+            res = CE_ERR_UNSUPPORTED;
+        }
+    }
+
+    if (res == CE_OK) {
+        sq          = (ce_u8*)r->sq_ptr;
+        cq          = (ce_u8*)r->cq_ptr;
+        r->sq_tail  = (ce_atomic_u32*)(void*)(sq + p.sq_off.tail);
+        r->sq_mask  = *(const ce_u32*)(const void*)(sq + p.sq_off.ring_mask);
+        r->sq_array = (ce_u32*)(void*)(sq + p.sq_off.array);
+        r->cq_head  = (ce_atomic_u32*)(void*)(cq + p.cq_off.head);
+        r->cq_tail  = (ce_atomic_u32*)(void*)(cq + p.cq_off.tail);
+        r->cq_mask  = *(const ce_u32*)(const void*)(cq + p.cq_off.ring_mask);
+        r->cqes     = (struct io_uring_cqe*)(void*)(cq + p.cq_off.cqes);
+    }
+
+    return res;
+}
+
+static void ce__fs_uring_shutdown(ce__fs_uring* r)
+{
+    if ((r->sqes != CE_NULL) && ((void*)r->sqes != MAP_FAILED)) {
+        (void)munmap(r->sqes, r->sqes_size);
+    }
+    if ((r->cq_ptr != CE_NULL) && (r->cq_ptr != MAP_FAILED) && (r->cq_ptr != r->sq_ptr)) {
+        (void)munmap(r->cq_ptr, r->cq_size);
+    }
+    if ((r->sq_ptr != CE_NULL) && (r->sq_ptr != MAP_FAILED)) {
+        (void)munmap(r->sq_ptr, r->sq_size);
+    }
+    if (r->fd >= 0) {
+        (void)close(r->fd);
+    }
+}
+
+/* Writes the SQE for the unread remainder of an op (not yet visible to the kernel). */
+static void ce__fs_uring_queue(ce__fs_uring* r, ce_u32 index, const ce__fs_op* op)
+{
+    struct io_uring_sqe* sqe;
+    ce_size left;
+    ce_u32 tail;
+    ce_u32 slot;
+
+    tail = ce_atomic_load_relaxed_u32(r->sq_tail);
+    slot = tail & r->sq_mask;
+    sqe  = &r->sqes[slot];
+    left = op->req.size - op->done;
+
+    (void)ce__memset(sqe, 0u, sizeof(*sqe));
+    sqe->opcode    = (ce_u8)IORING_OP_READ;
+    sqe->fd        = (ce_s32)op->req.file.handle;
+    sqe->addr      = (ce_u64)(ce_uptr)((ce_u8*)op->req.dst + op->done);
+    sqe->len       = (left > (ce_size)CE__FS_MAX_CHUNK) ? CE__FS_MAX_CHUNK : (ce_u32)left;
+    sqe->off       = op->req.offset + (ce_u64)op->done;
+    sqe->user_data = (ce_u64)index;
+    r->sq_array[slot] = slot;
+
+    ce_atomic_store_u32(r->sq_tail, tail + 1u);
+    r->unsubmitted += 1u;
+}
+
+/* Submits every queued SQE and optionally waits for `min_complete` completions. */
+static void ce__fs_uring_enter(ce__fs_uring* r, ce_u32 min_complete)
+{
+    long ret;
+
+    do {
+        ret = syscall(__NR_io_uring_enter, r->fd, r->unsubmitted, min_complete,
+                      (min_complete != 0u) ? IORING_ENTER_GETEVENTS : 0u, CE_NULL, 0);
+    } while ((ret < 0) && (errno == EINTR));
+
+    if (ret > 0) {
+        r->unsubmitted -= (ce_u32)ret;
+    }
+}
+
+static ce_u32 ce__fs_uring_poll(ce_fs_io* io)
+{
+    ce__fs_uring* r;
+    ce__fs_op* op;
+    struct io_uring_cqe* cqe;
+    ce_u32 head;
+    ce_u32 index;
+    ce_s32 res;
+    ce_u32 n;
+
+    r = &io->ring;
+    n = 0u;
+    if (r->unsubmitted != 0u) {
+        ce__fs_uring_enter(r, 0u);
+    }
+
+    head = ce_atomic_load_relaxed_u32(r->cq_head);
+    while (head != ce_atomic_load_u32(r->cq_tail)) {
+        cqe   = &r->cqes[head & r->cq_mask];
+        index = (ce_u32)cqe->user_data;
+        res   = cqe->res;
+        head += 1u;
+        ce_atomic_store_u32(r->cq_head, head);
+
+        op = &io->ops[index];
+        if (res > 0) {
+            op->done += (ce_size)res;
+        }
+        if (op->done == op->req.size) {
+            ce__fs_complete(io, index, CE_OK);
+            n += 1u;
+        } else if ((res > 0) || (res == -EINTR) || (res == -EAGAIN)) {
+            /* Short read: continue where it stopped. */
+            io->stats.resubmits += 1u;
+            ce__fs_uring_queue(r, index, op);
+        } else {
+            ce__fs_complete(io, index, CE_ERR_IO);
+            n += 1u;
+        }
+        /* A callback may have reaped or submitted: re-read our cursor. */
+        head = ce_atomic_load_relaxed_u32(r->cq_head);
+    }
+
+    if (r->unsubmitted != 0u) {
+        ce__fs_uring_enter(r, 0u);
+    }
+    return n;
+}
+
+#endif /* CE__FS_HAVE_URING */
+
+/* ----------------------------------------------------------------- public */
+
+ce_result ce_fs_io_create(const ce_fs_io_desc* desc, ce_fs_io** out_io)
+{
+    ce_result res;
+    ce_fs_io* io;
+    ce_u32* block;
+    ce_u32 depth;
+    ce_u32 i;
+
+    res = CE_OK;
+    io  = CE_NULL;
+    if ((desc == CE_NULL) || (out_io == CE_NULL) || (desc->worker_count > CE_FS_IO_MAX_WORKERS)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        io = (ce_fs_io*)ce_mem_calloc(sizeof(ce_fs_io), 0u, CE_MEM_TAG_CORE);
+        res = (io == CE_NULL) ? CE_ERR_OUT_OF_MEMORY : CE_OK;
+    }
+
+    if (res == CE_OK) {
+        depth        = (desc->queue_depth != 0u) ? desc->queue_depth : CE__FS_DEFAULT_DEPTH;
+        io->capacity = depth;
+        io->ops      = (ce__fs_op*)ce_mem_calloc((ce_size)depth * sizeof(ce__fs_op), 0u, CE_MEM_TAG_CORE);
+        block        = (ce_u32*)ce_mem_alloc((ce_size)depth * 3u * sizeof(ce_u32), 0u, CE_MEM_TAG_CORE);
+        if ((io->ops == CE_NULL) || (block == CE_NULL)) {
+            ce_mem_free(block);
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            io->free_ops     = block;
+            io->queued.items = block + depth;
+            io->done.items   = block + ((ce_size)depth * 2u);
+            for (i = 0u; i < depth; i++) {
+                io->free_ops[i] = depth - 1u - i;
+            }
+            io->free_count = depth;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = CE_ERR_UNSUPPORTED;
+#if defined(CE__FS_HAVE_URING)
+        io->ring.fd = -1;
+        if (desc->backend != CE_FS_IO_BACKEND_THREADS) {
+            res = ce__fs_uring_init(&io->ring, depth);
+            if (res == CE_OK) {
+                io->backend = CE_FS_IO_BACKEND_URING;
+            } else {
+                ce__fs_uring_shutdown(&io->ring);
+                io->ring.fd = -1;
+            }
+        }
+#endif
+        if ((res != CE_OK) && (desc->backend != CE_FS_IO_BACKEND_URING)) {
+            io->backend      = CE_FS_IO_BACKEND_THREADS;
+            io->worker_count = (desc->worker_count != 0u) ? desc->worker_count : CE__FS_DEFAULT_WORKERS;
+            res              = ce_mutex_init(&io->mutex);
+            if (res == CE_OK) {
+                (void)ce_cond_init(&io->work);
+                (void)ce_cond_init(&io->finished);
+            }
+            for (i = 0u; (res == CE_OK) && (i < io->worker_count); i++) {
+                res = ce_thread_create(&io->workers[i], ce__fs_worker, io, "ce_io");
+                if (res != CE_OK) {
+                    io->worker_count = i;
+                }
+            }
+        }
+    }
+
+    if (res == CE_OK) {
+        *out_io = io;
+    } else if (io != CE_NULL) {
+        ce_fs_io_destroy(io);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_fs_io_destroy(ce_fs_io* io)
+{
+    ce_u32 i;
+
+    if (io != CE_NULL) {
+        if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+            ce_fs_io_wait(io);
+            ce_mutex_lock(&io->mutex);
+            io->stop = CE_TRUE;
+            ce_cond_broadcast(&io->work);
+            ce_mutex_unlock(&io->mutex);
+            for (i = 0u; i < io->worker_count; i++) {
+                ce_thread_join(&io->workers[i]);
+            }
+            ce_cond_destroy(&io->finished);
+            ce_cond_destroy(&io->work);
+            ce_mutex_destroy(&io->mutex);
+        }
+#if defined(CE__FS_HAVE_URING)
+        if (io->backend == CE_FS_IO_BACKEND_URING) {
+            ce_fs_io_wait(io);
+            ce__fs_uring_shutdown(&io->ring);
+        }
+#endif
+        ce_mem_free(io->free_ops);
+        ce_mem_free(io->ops);
+        ce_mem_free(io);
+    }
+}
+
+ce_fs_io_backend ce_fs_io_get_backend(const ce_fs_io* io)
+{
+    return io->backend;
+}
+
+ce_result ce_fs_io_submit(ce_fs_io* io, const ce_fs_read_request* requests, ce_u32 count)
+{
+    ce_result res;
+    ce_u32 index;
+    ce_u32 i;
+
+    res = CE_OK;
+    if ((io == CE_NULL) || ((requests == CE_NULL) && (count != 0u))) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (count > io->free_count) {
+        res = CE_ERR_FULL;
+    } else {
+        for (i = 0u; (res == CE_OK) && (i < count); i++) {
+            if ((requests[i].file.handle < 0) || ((requests[i].dst == CE_NULL) && (requests[i].size != 0u))) {
+                res = CE_ERR_INVALID_ARG;
+            }
+        }
+    }
+
+    if ((res == CE_OK) && (count != 0u)) {
+        if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+            ce_mutex_lock(&io->mutex);
+        }
+        for (i = 0u; i < count; i++) {
+            io->free_count -= 1u;
+            index = io->free_ops[io->free_count];
+            io->ops[index].req    = requests[i];
+            io->ops[index].done   = 0u;
+            io->ops[index].result = CE_OK;
+#if defined(CE__FS_HAVE_URING)
+            if (io->backend == CE_FS_IO_BACKEND_URING) {
+                ce__fs_uring_queue(&io->ring, index, &io->ops[index]);
+            }
+#endif
+            if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+                ce__fs_fifo_push(&io->queued, io->capacity, index);
+            }
+        }
+        io->stats.submitted += (ce_u64)count;
+        io->stats.in_flight += count;
+        if (io->stats.in_flight > io->stats.max_in_flight) {
+            io->stats.max_in_flight = io->stats.in_flight;
+        }
+
+        if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+            ce_cond_broadcast(&io->work);
+            ce_mutex_unlock(&io->mutex);
+        }
+#if defined(CE__FS_HAVE_URING)
+        if (io->backend == CE_FS_IO_BACKEND_URING) {
+            ce__fs_uring_enter(&io->ring, 0u);
+        }
+#endif
+    }
+
+    return res;
+}
+
+ce_u32 ce_fs_io_poll(ce_fs_io* io)
+{
+    ce_u32 n;
+
+    n = 0u;
+#if defined(CE__FS_HAVE_URING)
+    if (io->backend == CE_FS_IO_BACKEND_URING) {
+        n = ce__fs_uring_poll(io);
+    }
+#endif
+    if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+        n = ce__fs_threads_poll(io);
+    }
+
+    return n;
+}
+
+void ce_fs_io_wait(ce_fs_io* io)
+{
+    while (io->stats.in_flight != 0u) {
+        if ((ce_fs_io_poll(io) == 0u) && (io->stats.in_flight != 0u)) {
+#if defined(CE__FS_HAVE_URING)
+            if (io->backend == CE_FS_IO_BACKEND_URING) {
+                ce__fs_uring_enter(&io->ring, 1u);
+            }
+#endif
+            if (io->backend == CE_FS_IO_BACKEND_THREADS) {
+                ce__fs_threads_block(io);
+            }
+        }
+    }
+}
+
+void ce_fs_io_get_stats(const ce_fs_io* io, ce_fs_io_stats* out_stats)
+{
+    *out_stats = io->stats;
+}
+
+/* ************************************************************************** */
+/* PACKED ARCHIVES                                                            */
+/* ************************************************************************** */
+
+static inline ce_bool ce__pak_range_ok(ce_u64 offset, ce_u64 size, ce_size total)
+{
+    return ((offset <= (ce_u64)total) && (size <= ((ce_u64)total - offset))) ? CE_TRUE : CE_FALSE;
+}
+
+ce_result ce_pak_bind(ce_pak* pak, const void* data, ce_size size)
+{
+    const ce_pak_header* h;
+    const ce_pak_entry* e;
+    ce_u64 bucket_count;
+    ce_u32 i;
+    ce_bool ok;
+
+    ok = ((pak != CE_NULL) && (data != CE_NULL) && (size >= sizeof(ce_pak_header)) &&
+          ((((ce_uptr)data) & 7u) == 0u))
+             ? CE_TRUE
+             : CE_FALSE;
+
+    if (ok == CE_TRUE) {
+        (void)ce__memset(pak, 0u, sizeof(*pak));
+        h = (const ce_pak_header*)data;
+        bucket_count = (h->bucket_bits < 32u) ? ((1ull << h->bucket_bits) + 1u) : 0u;
+        ok = ((h->magic == CE_PAK_MAGIC) && (h->version == CE_PAK_VERSION) && (bucket_count != 0u) &&
+              ((h->toc_offset & 7u) == 0u) && ((h->buckets_offset & 3u) == 0u) &&
+              (ce__pak_range_ok(h->toc_offset, (ce_u64)h->entry_count * sizeof(ce_pak_entry), size) == CE_TRUE) &&
+              (ce__pak_range_ok(h->buckets_offset, bucket_count * sizeof(ce_u32), size) == CE_TRUE) &&
+              (ce__pak_range_ok(h->names_offset, h->names_size, size) == CE_TRUE) && (h->names_size != 0u))
+                 ? CE_TRUE
+                 : CE_FALSE;
+    }
+
+    if (ok == CE_TRUE) {
+        pak->header  = h;
+        pak->entries = (const ce_pak_entry*)(const void*)((const ce_u8*)data + h->toc_offset);
+        pak->buckets = (const ce_u32*)(const void*)((const ce_u8*)data + h->buckets_offset);
+        pak->names   = (const ce_char*)data + h->names_offset;
+        ok = ((pak->names[h->names_size - 1u] == (ce_char)'\0') && (pak->buckets[bucket_count - 1u] == h->entry_count))
+                 ? CE_TRUE
+                 : CE_FALSE;
+
+        /* Checked once here so lookups and reads never bounds-check again. */
+        for (i = 0u; (ok == CE_TRUE) && (i < (ce_u32)(bucket_count - 1u)); i++) {
+            ok = (pak->buckets[i] <= pak->buckets[i + 1u]) ? CE_TRUE : CE_FALSE;
+        }
+        for (i = 0u; (ok == CE_TRUE) && (i < h->entry_count); i++) {
+            e  = &pak->entries[i];
+            ok = ((ce__pak_range_ok(e->offset, e->size, size) == CE_TRUE) && ((ce_u64)e->name_offset < h->names_size) &&
+                  (((e->flags & CE_PAK_FLAG_LZ4) != 0u) || (e->size == e->raw_size)) &&
+                  ((i == 0u) || (pak->entries[i - 1u].hash <= e->hash)))
+                     ? CE_TRUE
+                     : CE_FALSE;
+        }
+    }
+
+    if ((ok == CE_FALSE) && (pak != CE_NULL)) {
+        (void)ce__memset(pak, 0u, sizeof(*pak));
+    }
+    return (ok == CE_TRUE) ? CE_OK : (((pak == CE_NULL) || (data == CE_NULL)) ? CE_ERR_INVALID_ARG : CE_ERR_FORMAT);
+}
+
+ce_result ce_pak_open(ce_pak* pak, const ce_char* path)
+{
+    ce_result res;
+    ce_fs_mapping mapping;
+
+    res = (pak == CE_NULL) ? CE_ERR_INVALID_ARG : ce_fs_map(path, &mapping);
+    if (res == CE_OK) {
+        res = (mapping.data != CE_NULL) ? ce_pak_bind(pak, mapping.data, mapping.size) : CE_ERR_FORMAT;
+        if (res == CE_OK) {
+            pak->mapping      = mapping;
+            pak->owns_mapping = CE_TRUE;
+        } else {
+            ce_fs_unmap(&mapping);
+        }
+    }
+
+    return res;
+}
+
+void ce_pak_close(ce_pak* pak)
+{
+    if (pak != CE_NULL) {
+        if (pak->owns_mapping == CE_TRUE) {
+            ce_fs_unmap(&pak->mapping);
+        }
+        (void)ce__memset(pak, 0u, sizeof(*pak));
+    }
+}
+
+const ce_pak_entry* ce_pak_find(const ce_pak* pak, const ce_char* name)
+{
+    const ce_pak_entry* found;
+    ce_u64 hash;
+    ce_u32 bucket;
+    ce_u32 i;
+    ce_u32 end;
+    ce_size len;
+
+    found  = CE_NULL;
+    hash   = ce_hash_str(name);
+    len    = ce__strlen(name);
+    bucket = (pak->header->bucket_bits != 0u) ? (ce_u32)(hash >> (64u - pak->header->bucket_bits)) : 0u;
+    end    = pak->buckets[bucket + 1u];
+
+    for (i = pak->buckets[bucket]; (found == CE_NULL) && (i < end) && (pak->entries[i].hash <= hash); i++) {
+        /* Names are compared only on a full hash match; the bound keeps a
+         * corrupt name offset from reading past the names block. */
+        if ((pak->entries[i].hash == hash) &&
+            ((ce_u64)len < (pak->header->names_size - (ce_u64)pak->entries[i].name_offset)) &&
+            (ce__memcmp(pak->names + pak->entries[i].name_offset, name, len + 1u) == 0)) {
+            found = &pak->entries[i];
+        }
+    }
+
+    return found;
+}
+
+const ce_char* ce_pak_name(const ce_pak* pak, const ce_pak_entry* entry)
+{
+    return pak->names + entry->name_offset;
+}
+
+const void* ce_pak_data(const ce_pak* pak, const ce_pak_entry* entry)
+{
+    return ((entry->flags & CE_PAK_FLAG_LZ4) == 0u) ? (const void*)((const ce_u8*)pak->header + entry->offset)
+                                                   : CE_NULL;
+}
+
+ce_result ce_pak_read(const ce_pak* pak, const ce_pak_entry* entry, void* dst, ce_size dst_size)
+{
+    ce_result res;
+    const ce_u8* src;
+
+    src = (const ce_u8*)pak->header + entry->offset;
+    if ((dst == CE_NULL) || ((ce_u64)dst_size < entry->raw_size)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if ((entry->flags & CE_PAK_FLAG_LZ4) != 0u) {
+        res = ce_lz4_decompress(src, (ce_size)entry->size, dst, (ce_size)entry->raw_size);
+    } else {
+        (void)ce__memcpy(dst, src, (ce_size)entry->size);
+        res = CE_OK;
+    }
 
-/* TODO: implement */
+    return res;
+}
@@ -9,8 +9,957 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_log.c
- * @brief Implementation skeleton.
+ * @brief Asynchronous binary logger: per-thread rings, deferred formatting.
+ *
+ * A record is { size, suppressed count, site pointer, timestamp } followed
+ * by the arguments in 8-byte slots, laid out by a type signature parsed
+ * once per site. Each thread owns a single-producer ring; the drain (writer
+ * thread or ce_log_flush()) is the single consumer, merges the rings by
+ * timestamp and re-walks the format string with snprintf per conversion.
  */
 #include "core/chaos_log.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define CE__LOG_RING_DEFAULT  65536u
+#define CE__LOG_RING_MIN      4096u
+#define CE__LOG_FLUSH_DEFAULT 5u
+#define CE__LOG_PAYLOAD_MAX   1024u
+#define CE__LOG_SLOT          8u
+#define CE__LOG_WRAP          0xFFFFFFFFu  /* Record size marking "continue at offset 0". */
+#define CE__LOG_SPEC_MAX      32u
+#define CE__LOG_NO_THREAD     0xFFFFFFFFu
+
+/* Site parse states. */
+#define CE__LOG_PARSE_NONE     0u
+#define CE__LOG_PARSE_BUSY     1u
+#define CE__LOG_PARSE_READY    2u
+#define CE__LOG_PARSE_VERBATIM 3u  /* Unsupported format: printed as is, no arguments. */
+
+/* Argument classes, named after the type va_arg() must read. */
+typedef enum ce__log_arg_e {
+    CE__LOG_ARG_INT = 0,
+    CE__LOG_ARG_LONG,
+    CE__LOG_ARG_LLONG,
+    CE__LOG_ARG_INTMAX,
+    CE__LOG_ARG_SIZE,
+    CE__LOG_ARG_PTRDIFF,
+    CE__LOG_ARG_DOUBLE,
+    CE__LOG_ARG_LDOUBLE,
+    CE__LOG_ARG_STRING,
+    CE__LOG_ARG_POINTER,
+    CE__LOG_ARG_PERCENT,  /* "%%": no argument */
+    CE__LOG_ARG_INVALID
+} ce__log_arg;
+
+typedef struct ce__log_spec_s {
+    ce_u32  length;    /* '%' through the conversion character */
+    ce_u32  modifier;  /* Index of the length modifier (or conversion) */
+    ce_bool star_width;
+    ce_bool star_precision;
+    ce_u32  arg;
+} ce__log_spec;
+
+typedef struct ce__log_record_s {
+    ce_u32             size;  /* Header and payload, multiple of CE__LOG_SLOT. */
+    ce_u32             suppressed;
+    const ce_log_site* site;
+    ce_u64             time_ns;
+} ce__log_record;
+
+#define CE__LOG_RECORD_BYTES ((ce_u32)CE_ALIGN_UP(sizeof(ce__log_record), CE__LOG_SLOT))
+
+/* Head and tail on separate cache lines: one is written by the producer only,
+ * the other by the drain only. */
+typedef struct ce__log_ring_s {
+    ce_atomic_u32                  head;
+    CE_CACHE_ALIGNED ce_atomic_u32 tail;
+    CE_CACHE_ALIGNED ce_u8*        data;
+    ce_u32                         mask;
+    ce_u32                         index;
+} ce__log_ring;
+
+typedef struct ce__log_state_s {
+    ce_atomic_u32  running;
+    ce_atomic_u32  stop;
+    ce_atomic_u32  epoch;
+    ce_atomic_u32  ring_count;
+    ce__log_ring*  rings[CE_LOG_MAX_THREADS];
+    ce_mutex       register_lock;
+    ce_mutex       drain_lock;
+    ce_thread      writer;
+    ce_u32         ring_bytes;
+    ce_u32         flush_ms;
+    ce_u32         default_rate;
+    ce_atomic_u64  start_ns;
+
+    ce_log_sink_fn sinks[CE_LOG_MAX_SINKS];
+    void*          sink_users[CE_LOG_MAX_SINKS];
+    ce_atomic_u32  sink_count;
+
+    ce_atomic_u64  written;
+    ce_atomic_u64  dropped;
+    ce_atomic_u64  suppressed;
+} ce__log_state;
+
+static ce__log_state ce__log;
+
+ce_atomic_u32 ce__log_level;
+
+/* Ring of the calling thread; only trusted while the epoch matches. */
+static _Thread_local ce__log_ring* ce__log_tls_ring;
+static _Thread_local ce_u32        ce__log_tls_epoch;
+
+static const ce_char* const ce__log_level_names[] = {
+    "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"
+};
+
+/* ************************************************************************** */
+/* FORMAT SIGNATURES                                                          */
+/* ************************************************************************** */
+
+/* Parses the conversion starting at s[0] == '%'. */
+static void ce__log_parse_spec(const ce_char* s, ce__log_spec* spec)
+{
+    ce_u32 i;
+    ce_u32 mod;  /* 0 none, 1 l, 2 ll, 3 j, 4 z, 5 t, 6 L */
+    ce_u32 arg;
+
+    i                    = 1u;
+    mod                  = 0u;
+    spec->star_width     = CE_FALSE;
+    spec->star_precision = CE_FALSE;
+
+    while ((s[i] == '-') || (s[i] == '+') || (s[i] == ' ') || (s[i] == '#') || (s[i] == '0')) {
+        i++;
+    }
+    if (s[i] == '*') {
+        spec->star_width = CE_TRUE;
+        i++;
+    } else {
+        while ((s[i] >= '0') && (s[i] <= '9')) {
+            i++;
+        }
+    }
+    if (s[i] == '.') {
+        i++;
+        if (s[i] == '*') {
+            spec->star_precision = CE_TRUE;
+            i++;
+        } else {
+            while ((s[i] >= '0') && (s[i] <= '9')) {
+                i++;
+            }
+        }
+    }
+
+    spec->modifier = i;
+    switch (s[i]) {
+    case 'h':
+        i += (s[i + 1u] == 'h') ? 2u : 1u;
+        break;
+    case 'l':
+        mod = (s[i + 1u] == 'l') ? 2u : 1u;
+        i  += mod;
+        break;
+    case 'j':
+        mod = 3u;
+        i++;
+        break;
+    case 'z':
+        mod = 4u;
+        i++;
+        break;
+    case 't':
+        mod = 5u;
+        i++;
+        break;
+    case 'L':
+        mod = 6u;
+        i++;
+        break;
+    default:
+        break;
+    }
+
+    switch (s[i]) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        switch (mod) {
+        case 0u: arg = (ce_u32)CE__LOG_ARG_INT;     break;
+        case 1u: arg = (ce_u32)CE__LOG_ARG_LONG;    break;
+        case 2u: arg = (ce_u32)CE__LOG_ARG_LLONG;   break;
+        case 3u: arg = (ce_u32)CE__LOG_ARG_INTMAX;  break;
+        case 4u: arg = (ce_u32)CE__LOG_ARG_SIZE;    break;
+        case 5u: arg = (ce_u32)CE__LOG_ARG_PTRDIFF; break;
+        default: arg = (ce_u32)CE__LOG_ARG_INVALID; break;
+        }
+        break;
+    case 'c':
+        arg = (mod == 0u) ? (ce_u32)CE__LOG_ARG_INT : (ce_u32)CE__LOG_ARG_INVALID;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        arg = (mod == 6u) ? (ce_u32)CE__LOG_ARG_LDOUBLE
+            : ((mod <= 1u) ? (ce_u32)CE__LOG_ARG_DOUBLE : (ce_u32)CE__LOG_ARG_INVALID);
+        break;
+    case 's':
+        /* %ls would need the wide string copied. */
+        arg = (mod == 0u) ? (ce_u32)CE__LOG_ARG_STRING : (ce_u32)CE__LOG_ARG_INVALID;
+        break;
+    case 'p':
+        arg = (ce_u32)CE__LOG_ARG_POINTER;
+        break;
+    case '%':
+        arg = (i == 1u) ? (ce_u32)CE__LOG_ARG_PERCENT : (ce_u32)CE__LOG_ARG_INVALID;
+        break;
+    default:
+        /* %n, positional arguments, a trailing '%'... */
+        arg = (ce_u32)CE__LOG_ARG_INVALID;
+        break;
+    }
+
+    spec->arg    = arg;
+    spec->length = (s[i] != '\0') ? (i + 1u) : i;
+}
+
+/* Builds the argument signature of a site, once. */
+static void ce__log_prepare(ce_log_site* site)
+{
+    ce__log_spec spec;
+    const ce_char* p;
+    ce_u32 expected;
+    ce_u32 count;
+    ce_u32 need;
+    ce_u32 state;
+
+    expected = CE__LOG_PARSE_NONE;
+    if (ce_atomic_cas_u32(&site->parsed, &expected, CE__LOG_PARSE_BUSY) == CE_TRUE) {
+        count = 0u;
+        state = CE__LOG_PARSE_READY;
+        p     = site->fmt;
+        while ((*p != '\0') && (state == CE__LOG_PARSE_READY)) {
+            if (*p != '%') {
+                p++;
+            } else {
+                ce__log_parse_spec(p, &spec);
+                /* Exact slots of this conversion: itself plus any '*' width / precision. */
+                need = (spec.arg == (ce_u32)CE__LOG_ARG_PERCENT)
+                           ? 0u
+                           : (1u + ((spec.star_width == CE_TRUE) ? 1u : 0u) +
+                              ((spec.star_precision == CE_TRUE) ? 1u : 0u));
+                if ((spec.arg == (ce_u32)CE__LOG_ARG_INVALID) || ((count + need) > CE_LOG_MAX_ARGS)) {
+                    state = CE__LOG_PARSE_VERBATIM;
+                } else if (spec.arg != (ce_u32)CE__LOG_ARG_PERCENT) {
+                    if (spec.star_width == CE_TRUE) {
+                        site->args[count++] = (ce_u8)CE__LOG_ARG_INT;
+                    }
+                    if (spec.star_precision == CE_TRUE) {
+                        site->args[count++] = (ce_u8)CE__LOG_ARG_INT;
+                    }
+                    site->args[count++] = (ce_u8)spec.arg;
+                }
+                p += spec.length;
+            }
+        }
+        site->arg_count = (state == CE__LOG_PARSE_READY) ? count : 0u;
+        ce_atomic_store_u32(&site->parsed, state);
+    } else {
+        while (ce_atomic_load_u32(&site->parsed) == CE__LOG_PARSE_BUSY) {
+            ce_cpu_pause();
+        }
+    }
+}
+
+/* Slot bytes taken by one argument of class `arg` (strings excluded). */
+static ce_u32 ce__log_slot_bytes(ce_u32 arg)
+{
+    return (arg == (ce_u32)CE__LOG_ARG_LDOUBLE) ? (ce_u32)CE_ALIGN_UP(sizeof(long double), CE__LOG_SLOT)
+                                                 : CE__LOG_SLOT;
+}
+
+/* Copies the raw arguments into `payload`; returns the bytes used. */
+static ce_u32 ce__log_capture(const ce_log_site* site, va_list* ap, ce_u8* payload)
+{
+    ce_u32 off;
+    ce_u32 i;
+    ce_u32 len;
+    ce_u32 room;
+    ce_u32 reserve;
+    const ce_char* str;
+    int v_int;
+    long v_long;
+    long long v_llong;
+    intmax_t v_intmax;
+    size_t v_size;
+    ptrdiff_t v_ptrdiff;
+    double v_double;
+    long double v_ldouble;
+    const void* v_ptr;
+
+    off = 0u;
+    for (i = 0u; i < site->arg_count; i++) {
+        switch ((ce__log_arg)site->args[i]) {
+        case CE__LOG_ARG_INT:
+            v_int = va_arg(*ap, int);
+            ce__memcpy(payload + off, &v_int, sizeof(v_int));
+            break;
+        case CE__LOG_ARG_LONG:
+            v_long = va_arg(*ap, long);
+            ce__memcpy(payload + off, &v_long, sizeof(v_long));
+            break;
+        case CE__LOG_ARG_LLONG:
+            v_llong = va_arg(*ap, long long);
+            ce__memcpy(payload + off, &v_llong, sizeof(v_llong));
+            break;
+        case CE__LOG_ARG_INTMAX:
+            v_intmax = va_arg(*ap, intmax_t);
+            ce__memcpy(payload + off, &v_intmax, sizeof(v_intmax));
+            break;
+        case CE__LOG_ARG_SIZE:
+            v_size = va_arg(*ap, size_t);
+            ce__memcpy(payload + off, &v_size, sizeof(v_size));
+            break;
+        case CE__LOG_ARG_PTRDIFF:
+            v_ptrdiff = va_arg(*ap, ptrdiff_t);
+            ce__memcpy(payload + off, &v_ptrdiff, sizeof(v_ptrdiff));
+            break;
+        case CE__LOG_ARG_DOUBLE:
+            v_double = va_arg(*ap, double);
+            ce__memcpy(payload + off, &v_double, sizeof(v_double));
+            break;
+        case CE__LOG_ARG_LDOUBLE:
+            v_ldouble = va_arg(*ap, long double);
+            ce__memcpy(payload + off, &v_ldouble, sizeof(v_ldouble));
+            break;
+        case CE__LOG_ARG_POINTER:
+            v_ptr = va_arg(*ap, const void*);
+            ce__memcpy(payload + off, &v_ptr, sizeof(v_ptr));
+            break;
+        case CE__LOG_ARG_STRING:
+        default:
+            /* Length-prefixed, truncated so the slots still to come fit. */
+            str     = va_arg(*ap, const ce_char*);
+            str     = (str != CE_NULL) ? str : "(null)";
+            reserve = (site->arg_count - i - 1u) * ce__log_slot_bytes((ce_u32)CE__LOG_ARG_LDOUBLE);
+            room    = CE__LOG_PAYLOAD_MAX - off - (CE__LOG_SLOT * 2u) - reserve;
+            room    = (room < CE_LOG_MAX_STRING) ? room : CE_LOG_MAX_STRING;
+            len     = 0u;
+            while ((len < room) && (str[len] != '\0')) {
+                len++;
+            }
+            ce__memcpy(payload + off, &len, sizeof(len));
+            ce__memcpy(payload + off + sizeof(len), str, (ce_size)len);
+            off += (ce_u32)CE_ALIGN_UP(len + (ce_u32)sizeof(len), CE__LOG_SLOT) - CE__LOG_SLOT;
+            break;
+        }
+        off += ce__log_slot_bytes(site->args[i]);
+    }
+
+    return off;
+}
+
+/* ************************************************************************** */
+/* FORMATTING                                                                 */
+/* ************************************************************************** */
+
+static void ce__log_append(ce_char* out, ce_size cap, ce_size* n, const ce_char* s, ce_size len)
+{
+    ce_size room;
+
+    room = cap - 1u - *n;
+    len  = (len < room) ? len : room;
+    ce__memcpy(out + *n, s, len);
+    *n += len;
+    out[*n] = '\0';
+}
+
+/* Accounts for an snprintf() result, which is the untruncated length. */
+static void ce__log_advance(ce_size cap, ce_size* n, int written)
+{
+    if (written > 0) {
+        *n += (ce_size)written;
+        *n  = (*n < (cap - 1u)) ? *n : (cap - 1u);
+    }
+}
+
+/* Copies the spec, replacing '*' by the captured values. A spec too long for
+ * the buffer loses its flags, width and precision. */
+static void ce__log_resolve_spec(const ce_char* s, const ce__log_spec* spec, const ce_u8* payload, ce_u32* off,
+                                 ce_char* out)
+{
+    ce_char digits[16];
+    ce_bool ok;
+    ce_u32 i;
+    ce_u32 n;
+    int star;
+    int len;
+
+    ok = CE_TRUE;
+    n  = 0u;
+    for (i = 0u; i < spec->length; i++) {
+        if (s[i] == '*') {
+            ce__memcpy(&star, payload + *off, sizeof(star));
+            *off += CE__LOG_SLOT;
+            if (ok == CE_FALSE) {
+                len = 0;
+            } else if ((star < 0) && (s[i - 1u] == '.')) {
+                /* A negative precision is "no precision". */
+                n--;
+                len = 0;
+            } else {
+                len = snprintf(digits, sizeof(digits), "%d", star);
+            }
+            if ((len < 0) || ((n + (ce_u32)len + 1u) >= CE__LOG_SPEC_MAX)) {
+                ok = CE_FALSE;
+            } else {
+                ce__memcpy(out + n, digits, (ce_size)len);
+                n += (ce_u32)len;
+            }
+        } else if ((n + 1u) < CE__LOG_SPEC_MAX) {
+            out[n++] = s[i];
+        } else {
+            ok = CE_FALSE;
+        }
+    }
+
+    if (ok == CE_FALSE) {
+        out[0] = '%';
+        n      = 1u;
+        for (i = spec->modifier; i < spec->length; i++) {
+            out[n++] = s[i];
+        }
+    }
+    out[n] = '\0';
+}
+
+/* Renders the message of `site` from its captured arguments. */
+static void ce__log_format(const ce_log_site* site, const ce_u8* payload, ce_char* out, ce_size cap, ce_size* n)
+{
+    ce_char str[CE_LOG_MAX_STRING + 1u];
+    ce_char fmt[CE__LOG_SPEC_MAX];
+    ce__log_spec spec;
+    const ce_char* p;
+    const ce_char* run;
+    ce_u32 off;
+    ce_u32 len;
+    int written;
+    int v_int;
+    long v_long;
+    long long v_llong;
+    intmax_t v_intmax;
+    size_t v_size;
+    ptrdiff_t v_ptrdiff;
+    double v_double;
+    long double v_ldouble;
+    const void* v_ptr;
+
+    if (ce_atomic_load_u32(&site->parsed) != CE__LOG_PARSE_READY) {
+        ce__log_append(out, cap, n, site->fmt, ce__strlen(site->fmt));
+    } else {
+        off = 0u;
+        p   = site->fmt;
+        while (*p != '\0') {
+            run = p;
+            while ((*p != '\0') && (*p != '%')) {
+                p++;
+            }
+            ce__log_append(out, cap, n, run, (ce_size)(p - run));
+            if (*p == '%') {
+                ce__log_parse_spec(p, &spec);
+                written = 0;
+                if (spec.arg == (ce_u32)CE__LOG_ARG_PERCENT) {
+                    ce__log_append(out, cap, n, "%", 1u);
+                } else {
+                    ce__log_resolve_spec(p, &spec, payload, &off, fmt);
+                    switch ((ce__log_arg)spec.arg) {
+                    case CE__LOG_ARG_INT:
+                        ce__memcpy(&v_int, payload + off, sizeof(v_int));
+                        written = snprintf(out + *n, cap - *n, fmt, v_int);
+                        break;
+                    case CE__LOG_ARG_LONG:
+                        ce__memcpy(&v_long, payload + off, sizeof(v_long));
+                        written = snprintf(out + *n, cap - *n, fmt, v_long);
+                        break;
+                    case CE__LOG_ARG_LLONG:
+                        ce__memcpy(&v_llong, payload + off, sizeof(v_llong));
+                        written = snprintf(out + *n, cap - *n, fmt, v_llong);
+                        break;
+                    case CE__LOG_ARG_INTMAX:
+                        ce__memcpy(&v_intmax, payload + off, sizeof(v_intmax));
+                        written = snprintf(out + *n, cap - *n, fmt, v_intmax);
+                        break;
+                    case CE__LOG_ARG_SIZE:
+                        ce__memcpy(&v_size, payload + off, sizeof(v_size));
+                        written = snprintf(out + *n, cap - *n, fmt, v_size);
+                        break;
+                    case CE__LOG_ARG_PTRDIFF:
+                        ce__memcpy(&v_ptrdiff, payload + off, sizeof(v_ptrdiff));
+                        written = snprintf(out + *n, cap - *n, fmt, v_ptrdiff);
+                        break;
+                    case CE__LOG_ARG_DOUBLE:
+                        ce__memcpy(&v_double, payload + off, sizeof(v_double));
+                        written = snprintf(out + *n, cap - *n, fmt, v_double);
+                        break;
+                    case CE__LOG_ARG_LDOUBLE:
+                        ce__memcpy(&v_ldouble, payload + off, sizeof(v_ldouble));
+                        written = snprintf(out + *n, cap - *n, fmt, v_ldouble);
+                        break;
+                    case CE__LOG_ARG_POINTER:
+                        ce__memcpy(&v_ptr, payload + off, sizeof(v_ptr));
+                        written = snprintf(out + *n, cap - *n, fmt, v_ptr);
+                        break;
+                    case CE__LOG_ARG_STRING:
+                    default:
+                        ce__memcpy(&len, payload + off, sizeof(len));
+                        ce__memcpy(str, payload + off + sizeof(len), (ce_size)len);
+                        str[len] = '\0';
+                        written  = snprintf(out + *n, cap - *n, fmt, str);
+                        off     += (ce_u32)CE_ALIGN_UP(len + (ce_u32)sizeof(len), CE__LOG_SLOT) - CE__LOG_SLOT;
+                        break;
+                    }
+                    off += ce__log_slot_bytes(spec.arg);
+                }
+                ce__log_advance(cap, n, written);
+                p += spec.length;
+            }
+        }
+    }
+}
+
+/* Formats a full line and hands it to the sinks. */
+static void ce__log_emit(const ce__log_record* rec, const ce_u8* payload, ce_u32 thread_index)
+{
+    ce_char line[CE_LOG_MAX_LINE + 1u];
+    const ce_char* file;
+    const ce_char* p;
+    ce_u64 start;
+    ce_u64 t;
+    ce_size n;
+    ce_u32 count;
+    ce_u32 level;
+    ce_u32 i;
+    int written;
+
+    file = rec->site->file;
+    for (p = file; *p != '\0'; p++) {
+        if ((*p == '/') || (*p == '\\')) {
+            file = p + 1;
+        }
+    }
+    start = ce_atomic_load_u64(&ce__log.start_ns);
+    t     = (rec->time_ns > start) ? (rec->time_ns - start) : 0u;
+    level = (rec->site->level <= CE_LOG_LEVEL_FATAL) ? rec->site->level : CE_LOG_LEVEL_FATAL;
+    n     = 0u;
+
+    if (thread_index != CE__LOG_NO_THREAD) {
+        written = snprintf(line, CE_LOG_MAX_LINE, "[%4llu.%06llu] %-5s t%u %s:%u: ",
+                           (unsigned long long)(t / CE_NS_PER_S),
+                           (unsigned long long)((t % CE_NS_PER_S) / CE_NS_PER_US), ce__log_level_names[level],
+                           thread_index, file, rec->site->line);
+    } else {
+        written = snprintf(line, CE_LOG_MAX_LINE, "[%4llu.%06llu] %-5s %s:%u: ",
+                           (unsigned long long)(t / CE_NS_PER_S),
+                           (unsigned long long)((t % CE_NS_PER_S) / CE_NS_PER_US), ce__log_level_names[level],
+                           file, rec->site->line);
+    }
+    ce__log_advance(CE_LOG_MAX_LINE, &n, written);
+    ce__log_format(rec->site, payload, line, CE_LOG_MAX_LINE, &n);
+    if (rec->suppressed != 0u) {
+        written = snprintf(line + n, CE_LOG_MAX_LINE - n, " (+%u suppressed)", rec->suppressed);
+        ce__log_advance(CE_LOG_MAX_LINE, &n, written);
+    }
+    line[n]      = '\n';
+    line[n + 1u] = '\0';
+    n           += 1u;
+
+    count = ce_atomic_load_u32(&ce__log.sink_count);
+    if (count == 0u) {
+        ce_log_sink_stderr(CE_NULL, level, line, n);
+    }
+    for (i = 0u; i < count; i++) {
+        ce__log.sinks[i](ce__log.sink_users[i], level, line, n);
+    }
+    (void)ce_atomic_fetch_add_u64(&ce__log.written, 1u);
+}
+
+/* ************************************************************************** */
+/* RINGS                                                                      */
+/* ************************************************************************** */
+
+static ce__log_ring* ce__log_register(void)
+{
+    ce__log_ring* ring;
+    ce_u32 count;
+
+    ring = CE_NULL;
+    ce_mutex_lock(&ce__log.register_lock);
+    count = ce_atomic_load_u32(&ce__log.ring_count);
+    if ((count < CE_LOG_MAX_THREADS) && (ce_atomic_load_u32(&ce__log.running) != 0u)) {
+        ring = (ce__log_ring*)ce_mem_calloc(sizeof(ce__log_ring), (ce_size)CE_CACHE_LINE_SIZE, CE_MEM_TAG_CORE);
+        if (ring != CE_NULL) {
+            ring->data = (ce_u8*)ce_mem_alloc((ce_size)ce__log.ring_bytes, CE_MEM_DEFAULT_ALIGN, CE_MEM_TAG_CORE);
+            if (ring->data == CE_NULL) {
+                ce_mem_free(ring);
+                ring = CE_NULL;
+            } else {
+                ring->mask          = ce__log.ring_bytes - 1u;
+                ring->index         = count;
+                ce__log.rings[count] = ring;
+                ce_atomic_store_u32(&ce__log.ring_count, count + 1u);
+            }
+        }
+    }
+    ce_mutex_unlock(&ce__log.register_lock);
+
+    return ring;
+}
+
+static ce__log_ring* ce__log_thread_ring(void)
+{
+    ce_u32 epoch;
+
+    epoch = ce_atomic_load_u32(&ce__log.epoch);
+    if (ce__log_tls_epoch != epoch) {
+        /* A failed registration is not retried until the next ce_log_init(). */
+        ce__log_tls_ring  = ce__log_register();
+        ce__log_tls_epoch = epoch;
+    }
+
+    return ce__log_tls_ring;
+}
+
+static ce_bool ce__log_ring_push(ce__log_ring* ring, const ce__log_record* rec, const ce_u8* payload,
+                                 ce_u32 payload_bytes)
+{
+    ce_bool pushed;
+    ce_u32 head;
+    ce_u32 tail;
+    ce_u32 offset;
+    ce_u32 contiguous;
+    ce_u32 skip;
+    ce_u32 marker;
+
+    head       = ce_atomic_load_relaxed_u32(&ring->head);
+    tail       = ce_atomic_load_u32(&ring->tail);
+    offset     = head & ring->mask;
+    contiguous = ring->mask + 1u - offset;
+    skip       = (contiguous < rec->size) ? contiguous : 0u;
+    pushed     = CE_FALSE;
+
+    if (((ring->mask + 1u) - (head - tail)) >= (rec->size + skip)) {
+        if (skip != 0u) {
+            marker = CE__LOG_WRAP;
+            ce__memcpy(ring->data + offset, &marker, sizeof(marker));
+            head  += skip;
+            offset = 0u;
+        }
+        ce__memcpy(ring->data + offset, rec, sizeof(*rec));
+        ce__memcpy(ring->data + offset + CE__LOG_RECORD_BYTES, payload, (ce_size)payload_bytes);
+        ce_atomic_store_u32(&ring->head, head + rec->size);
+        pushed = CE_TRUE;
+    }
+
+    return pushed;
+}
+
+/* Steps over a wrap marker; CE_TRUE when a record is available at the tail. */
+static ce_bool ce__log_ring_peek(ce__log_ring* ring, ce_u32 limit, ce__log_record* out_rec)
+{
+    ce_bool found;
+    ce_u32 tail;
+    ce_u32 offset;
+    ce_u32 size;
+
+    found = CE_FALSE;
+    size  = 0u;
+    tail  = ce_atomic_load_relaxed_u32(&ring->tail);
+    if (tail != limit) {
+        offset = tail & ring->mask;
+        ce__memcpy(&size, ring->data + offset, sizeof(size));
+        if (size == CE__LOG_WRAP) {
+            tail += ring->mask + 1u - offset;
+            ce_atomic_store_u32(&ring->tail, tail);
+            offset = 0u;
+        }
+        if (tail != limit) {
+            ce__memcpy(out_rec, ring->data + offset, sizeof(*out_rec));
+            found = CE_TRUE;
+        }
+    }
+
+    return found;
+}
+
+/* Writes everything published so far, oldest first; drain_lock held. */
+static void ce__log_drain(void)
+{
+    ce_u32 limits[CE_LOG_MAX_THREADS];
+    ce__log_record rec;
+    ce__log_record best_rec;
+    ce__log_ring* ring;
+    ce_u32 count;
+    ce_u32 best;
+    ce_u32 tail;
+    ce_u32 i;
+
+    ce__memset(&best_rec, 0u, sizeof(best_rec));
+    count = ce_atomic_load_u32(&ce__log.ring_count);
+    for (i = 0u; i < count; i++) {
+        limits[i] = ce_atomic_load_u32(&ce__log.rings[i]->head);
+    }
+
+    best = 0u;
+    while (best != CE__LOG_NO_THREAD) {
+        best = CE__LOG_NO_THREAD;
+        for (i = 0u; i < count; i++) {
+            if (ce__log_ring_peek(ce__log.rings[i], limits[i], &rec) == CE_TRUE) {
+                if ((best == CE__LOG_NO_THREAD) || (rec.time_ns < best_rec.time_ns)) {
+                    best     = i;
+                    best_rec = rec;
+                }
+            }
+        }
+        if (best != CE__LOG_NO_THREAD) {
+            ring = ce__log.rings[best];
+            tail = ce_atomic_load_relaxed_u32(&ring->tail);
+            ce__log_emit(&best_rec, ring->data + (tail & ring->mask) + CE__LOG_RECORD_BYTES, ring->index);
+            ce_atomic_store_u32(&ring->tail, tail + best_rec.size);
+        }
+    }
+}
+
+static void ce__log_writer(void* user)
+{
+    (void)user;
+    while (ce_atomic_load_u32(&ce__log.stop) == 0u) {
+        ce_mutex_lock(&ce__log.drain_lock);
+        ce__log_drain();
+        ce_mutex_unlock(&ce__log.drain_lock);
+        ce_thread_sleep_ms(ce__log.flush_ms);
+    }
+}
+
+/* ************************************************************************** */
+/* HOT PATH                                                                   */
+/* ************************************************************************** */
+
+/* Per-site one-second window; reports what was suppressed since the last pass. */
+static ce_bool ce__log_admit(ce_log_site* site, ce_u64 now, ce_u32* out_suppressed)
+{
+    ce_bool admit;
+    ce_u64 start;
+    ce_u32 rate;
+
+    admit           = CE_TRUE;
+    *out_suppressed = 0u;
+    rate            = (site->rate != 0u) ? site->rate : ce__log.default_rate;
+    if (rate != 0u) {
+        start = ce_atomic_load_relaxed_u64(&site->window_ns);
+        if ((start == 0u) || ((now - start) >= CE_NS_PER_S)) {
+            if (ce_atomic_cas_u64(&site->window_ns, &start, now) == CE_TRUE) {
+                ce_atomic_store_relaxed_u32(&site->in_window, 0u);
+            }
+        }
+        if (ce_atomic_fetch_add_u32(&site->in_window, 1u) >= rate) {
+            (void)ce_atomic_fetch_add_u32(&site->suppressed, 1u);
+            (void)ce_atomic_fetch_add_u64(&ce__log.suppressed, 1u);
+            admit = CE_FALSE;
+        } else {
+            *out_suppressed = ce_atomic_exchange_u32(&site->suppressed, 0u);
+        }
+    }
+
+    return admit;
+}
+
+void ce_log_write(ce_log_site* site, const ce_char* fmt, ...)
+{
+    ce_u8 payload[CE__LOG_PAYLOAD_MAX];
+    ce__log_record rec;
+    ce__log_ring* ring;
+    va_list ap;
+    ce_u64 expected;
+    ce_u32 bytes;
+
+    (void)fmt;
+    if (site != CE_NULL) {
+        rec.time_ns = ce_time_now_ns();
+        if (ce__log_admit(site, rec.time_ns, &rec.suppressed) == CE_TRUE) {
+            if (ce_atomic_load_u32(&site->parsed) < CE__LOG_PARSE_READY) {
+                ce__log_prepare(site);
+            }
+            va_start(ap, fmt);
+            bytes = ce__log_capture(site, &ap, payload);
+            va_end(ap);
+            rec.site = site;
+            rec.size = CE__LOG_RECORD_BYTES + bytes;
+
+            if (ce_atomic_load_u32(&ce__log.running) == 0u) {
+                expected = 0u;
+                (void)ce_atomic_cas_u64(&ce__log.start_ns, &expected, rec.time_ns);
+                ce__log_emit(&rec, payload, CE__LOG_NO_THREAD);
+            } else {
+                ring = ce__log_thread_ring();
+                if ((ring == CE_NULL) || (ce__log_ring_push(ring, &rec, payload, bytes) == CE_FALSE)) {
+                    (void)ce_atomic_fetch_add_u64(&ce__log.dropped, 1u);
+                }
+            }
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* LOGGER                                                                     */
+/* ************************************************************************** */
+
+ce_result ce_log_init(const ce_log_desc* desc)
+{
+    ce_result res;
+    ce_u32 bytes;
+
+    res = CE_OK;
+    if ((desc == CE_NULL) || (ce_atomic_load_u32(&ce__log.running) != 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        bytes = (desc->ring_bytes != 0u) ? desc->ring_bytes : CE__LOG_RING_DEFAULT;
+        bytes = (bytes > CE__LOG_RING_MIN) ? bytes : CE__LOG_RING_MIN;
+        ce__log.ring_bytes = CE__LOG_RING_MIN;
+        while ((ce__log.ring_bytes < bytes) && (ce__log.ring_bytes < 0x40000000u)) {
+            ce__log.ring_bytes <<= 1u;
+        }
+        ce__log.flush_ms     = (desc->flush_ms != 0u) ? desc->flush_ms : CE__LOG_FLUSH_DEFAULT;
+        ce__log.default_rate = desc->default_rate;
+        ce_atomic_store_u32(&ce__log_level, desc->level);
+        ce_atomic_store_u32(&ce__log.stop, 0u);
+        ce_atomic_store_u32(&ce__log.ring_count, 0u);
+        if (ce_atomic_load_u64(&ce__log.start_ns) == 0u) {
+            ce_atomic_store_u64(&ce__log.start_ns, ce_time_now_ns());
+        }
+
+        res = ce_mutex_init(&ce__log.register_lock);
+        if (res == CE_OK) {
+            res = ce_mutex_init(&ce__log.drain_lock);
+            if (res != CE_OK) {
+                ce_mutex_destroy(&ce__log.register_lock);
+            }
+        }
+        if (res == CE_OK) {
+            (void)ce_atomic_fetch_add_u32(&ce__log.epoch, 1u);
+            ce_atomic_store_u32(&ce__log.running, 1u);
+            res = ce_thread_create(&ce__log.writer, ce__log_writer, CE_NULL, "ce_log");
+            if (res != CE_OK) {
+                ce_atomic_store_u32(&ce__log.running, 0u);
+                ce_mutex_destroy(&ce__log.drain_lock);
+                ce_mutex_destroy(&ce__log.register_lock);
+            }
+        }
+    }
+
+    return res;
+}
+
+void ce_log_shutdown(void)
+{
+    ce_u32 count;
+    ce_u32 i;
+
+    if (ce_atomic_load_u32(&ce__log.running) != 0u) {
+        ce_atomic_store_u32(&ce__log.stop, 1u);
+        ce_thread_join(&ce__log.writer);
+
+        ce_mutex_lock(&ce__log.drain_lock);
+        ce__log_drain();
+        ce_mutex_unlock(&ce__log.drain_lock);
+
+        ce_atomic_store_u32(&ce__log.running, 0u);
+        count = ce_atomic_load_u32(&ce__log.ring_count);
+        for (i = 0u; i < count; i++) {
+            ce_mem_free(ce__log.rings[i]->data);
+            ce_mem_free(ce__log.rings[i]);
+            ce__log.rings[i] = CE_NULL;
+        }
+        ce_atomic_store_u32(&ce__log.ring_count, 0u);
+        ce_mutex_destroy(&ce__log.drain_lock);
+        ce_mutex_destroy(&ce__log.register_lock);
+    }
+}
+
+ce_result ce_log_add_sink(ce_log_sink_fn fn, void* user)
+{
+    ce_result res;
+    ce_u32 count;
+
+    res   = CE_OK;
+    count = ce_atomic_load_u32(&ce__log.sink_count);
+    if (fn == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (count >= CE_LOG_MAX_SINKS) {
+        res = CE_ERR_FULL;
+    } else {
+        ce__log.sinks[count]      = fn;
+        ce__log.sink_users[count] = user;
+        ce_atomic_store_u32(&ce__log.sink_count, count + 1u);
+    }
+
+    return res;
+}
+
+void ce_log_set_level(ce_log_level level)
+{
+    ce_atomic_store_u32(&ce__log_level, level);
+}
+
+void ce_log_flush(void)
+{
+    if (ce_atomic_load_u32(&ce__log.running) != 0u) {
+        ce_mutex_lock(&ce__log.drain_lock);
+        ce__log_drain();
+        ce_mutex_unlock(&ce__log.drain_lock);
+    }
+}
+
+void ce_log_get_stats(ce_log_stats* out_stats)
+{
+    if (out_stats != CE_NULL) {
+        out_stats->written    = ce_atomic_load_u64(&ce__log.written);
+        out_stats->dropped    = ce_atomic_load_u64(&ce__log.dropped);
+        out_stats->suppressed = ce_atomic_load_u64(&ce__log.suppressed);
+    }
+}
+
+/* ************************************************************************** */
+/* SINKS                                                                      */
+/* ************************************************************************** */
+
+void ce_log_sink_stderr(void* user, ce_log_level level, const ce_char* line, ce_size length)
+{
+    (void)user;
+    (void)level;
+    (void)fwrite(line, 1u, (size_t)length, stderr);
+}
+
+void ce_log_sink_file(void* user, ce_log_level level, const ce_char* line, ce_size length)
+{
+    (void)level;
+    if (user != CE_NULL) {
+        (void)fwrite(line, 1u, (size_t)length, (FILE*)user);
+    }
+}
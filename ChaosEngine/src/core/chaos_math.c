@@ -0,0 +1,323 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_math.c
+ * @brief Float math: matrices, quaternions and SoA batch transforms.
+ */
+#include "core/chaos_math.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_simd.h"
+
+#include <math.h>
+#if defined(CE_CPU_DISPATCH_X64)
+#include <immintrin.h>
+#endif
+
+/* ************************************************************************** */
+/* VECTORS / QUATERNIONS                                                      */
+/* ************************************************************************** */
+
+ce_f32 ce_vec3f_length(ce_vec3f a)
+{
+    return sqrtf(ce_vec3f_dot(a, a));
+}
+
+ce_vec3f ce_vec3f_normalize(ce_vec3f a)
+{
+    ce_vec3f r;
+    ce_f32 len;
+
+    r   = a;
+    len = ce_vec3f_length(a);
+    if (len > 0.0f) {
+        r = ce_vec3f_scale(a, 1.0f / len);
+    }
+
+    return r;
+}
+
+ce_quatf ce_quatf_axis_angle(ce_vec3f axis, ce_f32 radians)
+{
+    ce_quatf q;
+    ce_f32 s;
+
+    s   = sinf(radians * 0.5f);
+    q.x = axis.x * s;
+    q.y = axis.y * s;
+    q.z = axis.z * s;
+    q.w = cosf(radians * 0.5f);
+
+    return q;
+}
+
+ce_quatf ce_quatf_mul(ce_quatf a, ce_quatf b)
+{
+    ce_quatf q;
+
+    q.x = (a.w * b.x) + (a.x * b.w) + (a.y * b.z) - (a.z * b.y);
+    q.y = (a.w * b.y) - (a.x * b.z) + (a.y * b.w) + (a.z * b.x);
+    q.z = (a.w * b.z) + (a.x * b.y) - (a.y * b.x) + (a.z * b.w);
+    q.w = (a.w * b.w) - (a.x * b.x) - (a.y * b.y) - (a.z * b.z);
+
+    return q;
+}
+
+/* ************************************************************************** */
+/* MAT4                                                                       */
+/* ************************************************************************** */
+
+void ce_mat4f_identity(ce_mat4f* out)
+{
+    ce_u32 i;
+
+    for (i = 0u; i < 16u; i++) {
+        out->m[i] = ((i % 5u) == 0u) ? 1.0f : 0.0f;
+    }
+}
+
+void ce_mat4f_mul(ce_mat4f* out, const ce_mat4f* a, const ce_mat4f* b)
+{
+    ce_mat4f r;
+    ce_u32 col;
+    ce_u32 row;
+
+    /* r.col[j] = sum_k a.col[k] * b[k][j]: four independent column AXPYs. */
+    for (col = 0u; col < 4u; col++) {
+        for (row = 0u; row < 4u; row++) {
+            r.m[(col * 4u) + row] = (a->m[row]       * b->m[(col * 4u)])
+                                  + (a->m[4u + row]  * b->m[(col * 4u) + 1u])
+                                  + (a->m[8u + row]  * b->m[(col * 4u) + 2u])
+                                  + (a->m[12u + row] * b->m[(col * 4u) + 3u]);
+        }
+    }
+    *out = r;
+}
+
+void ce_mat4f_translation(ce_mat4f* out, ce_vec3f t)
+{
+    ce_mat4f_identity(out);
+    out->m[12] = t.x;
+    out->m[13] = t.y;
+    out->m[14] = t.z;
+}
+
+void ce_mat4f_scaling(ce_mat4f* out, ce_vec3f s)
+{
+    ce_mat4f_identity(out);
+    out->m[0]  = s.x;
+    out->m[5]  = s.y;
+    out->m[10] = s.z;
+}
+
+void ce_mat4f_rotation(ce_mat4f* out, ce_vec3f axis, ce_f32 radians)
+{
+    ce_mat4f_from_trs(out, ce_vec3f_make(0.0f, 0.0f, 0.0f), ce_quatf_axis_angle(axis, radians),
+                      ce_vec3f_make(1.0f, 1.0f, 1.0f));
+}
+
+void ce_mat4f_from_trs(ce_mat4f* out, ce_vec3f t, ce_quatf r, ce_vec3f s)
+{
+    ce_f32 xx;
+    ce_f32 yy;
+    ce_f32 zz;
+    ce_f32 xy;
+    ce_f32 xz;
+    ce_f32 yz;
+    ce_f32 wx;
+    ce_f32 wy;
+    ce_f32 wz;
+
+    xx = r.x * r.x;
+    yy = r.y * r.y;
+    zz = r.z * r.z;
+    xy = r.x * r.y;
+    xz = r.x * r.z;
+    yz = r.y * r.z;
+    wx = r.w * r.x;
+    wy = r.w * r.y;
+    wz = r.w * r.z;
+
+    out->m[0]  = (1.0f - (2.0f * (yy + zz))) * s.x;
+    out->m[1]  = (2.0f * (xy + wz)) * s.x;
+    out->m[2]  = (2.0f * (xz - wy)) * s.x;
+    out->m[3]  = 0.0f;
+    out->m[4]  = (2.0f * (xy - wz)) * s.y;
+    out->m[5]  = (1.0f - (2.0f * (xx + zz))) * s.y;
+    out->m[6]  = (2.0f * (yz + wx)) * s.y;
+    out->m[7]  = 0.0f;
+    out->m[8]  = (2.0f * (xz + wy)) * s.z;
+    out->m[9]  = (2.0f * (yz - wx)) * s.z;
+    out->m[10] = (1.0f - (2.0f * (xx + yy))) * s.z;
+    out->m[11] = 0.0f;
+    out->m[12] = t.x;
+    out->m[13] = t.y;
+    out->m[14] = t.z;
+    out->m[15] = 1.0f;
+}
+
+void ce_mat4f_perspective(ce_mat4f* out, ce_f32 fov_y, ce_f32 aspect, ce_f32 z_near, ce_f32 z_far)
+{
+    ce_f32 f;
+    ce_u32 i;
+
+    f = 1.0f / tanf(fov_y * 0.5f);
+    for (i = 0u; i < 16u; i++) {
+        out->m[i] = 0.0f;
+    }
+    out->m[0]  = f / aspect;
+    out->m[5]  = f;
+    out->m[10] = (z_far + z_near) / (z_near - z_far);
+    out->m[11] = -1.0f;
+    out->m[14] = (2.0f * z_far * z_near) / (z_near - z_far);
+}
+
+void ce_mat4f_look_at(ce_mat4f* out, ce_vec3f eye, ce_vec3f target, ce_vec3f up)
+{
+    ce_vec3f f;
+    ce_vec3f s;
+    ce_vec3f u;
+
+    f = ce_vec3f_normalize(ce_vec3f_sub(target, eye));
+    s = ce_vec3f_normalize(ce_vec3f_cross(f, up));
+    u = ce_vec3f_cross(s, f);
+
+    ce_mat4f_identity(out);
+    out->m[0]  = s.x;
+    out->m[4]  = s.y;
+    out->m[8]  = s.z;
+    out->m[1]  = u.x;
+    out->m[5]  = u.y;
+    out->m[9]  = u.z;
+    out->m[2]  = -f.x;
+    out->m[6]  = -f.y;
+    out->m[10] = -f.z;
+    out->m[12] = -ce_vec3f_dot(s, eye);
+    out->m[13] = -ce_vec3f_dot(u, eye);
+    out->m[14] = ce_vec3f_dot(f, eye);
+}
+
+ce_vec4f ce_mat4f_transform(const ce_mat4f* m, ce_vec4f v)
+{
+    ce_vec4f r;
+
+    r.x = (m->m[0] * v.x) + (m->m[4] * v.y) + (m->m[8]  * v.z) + (m->m[12] * v.w);
+    r.y = (m->m[1] * v.x) + (m->m[5] * v.y) + (m->m[9]  * v.z) + (m->m[13] * v.w);
+    r.z = (m->m[2] * v.x) + (m->m[6] * v.y) + (m->m[10] * v.z) + (m->m[14] * v.w);
+    r.w = (m->m[3] * v.x) + (m->m[7] * v.y) + (m->m[11] * v.z) + (m->m[15] * v.w);
+
+    return r;
+}
+
+/* ************************************************************************** */
+/* SOA BATCH TRANSFORMS                                                       */
+/* ************************************************************************** */
+
+/*
+ * Variants must stay bit-identical to the ce_f32x8 baseline: the software
+ * rasterizer's coverage depends on these values, and a fleet mixing CPUs
+ * has to render the same pixels. Hence mul + add, never FMA.
+ */
+typedef struct ce__math_kernels_s {
+    void (*transform_points_soa)(const ce_mat4f* m, const ce_f32* x, const ce_f32* y, const ce_f32* z,
+                                 ce_f32* out_x, ce_f32* out_y, ce_f32* out_z, ce_f32* out_w, ce_u32 count);
+} ce__math_kernels;
+
+static void ce__transform_points_soa_f32x8(const ce_mat4f* m,
+                                           const ce_f32* x, const ce_f32* y, const ce_f32* z,
+                                           ce_f32* out_x, ce_f32* out_y, ce_f32* out_z, ce_f32* out_w,
+                                           ce_u32 count)
+{
+    ce_f32x8 c[16];
+    ce_f32x8 vx;
+    ce_f32x8 vy;
+    ce_f32x8 vz;
+    ce_u32 i;
+
+    /* Broadcast every matrix element once; each row is then 3 madds per lane group. */
+    for (i = 0u; i < 16u; i++) {
+        c[i] = ce_f32x8_set1(m->m[i]);
+    }
+
+    for (i = 0u; i < count; i += 8u) {
+        vx = ce_f32x8_load(&x[i]);
+        vy = ce_f32x8_load(&y[i]);
+        vz = ce_f32x8_load(&z[i]);
+        ce_f32x8_store(&out_x[i], ce_f32x8_madd(vz, c[8], ce_f32x8_madd(vy, c[4], ce_f32x8_madd(vx, c[0], c[12]))));
+        ce_f32x8_store(&out_y[i], ce_f32x8_madd(vz, c[9], ce_f32x8_madd(vy, c[5], ce_f32x8_madd(vx, c[1], c[13]))));
+        ce_f32x8_store(&out_z[i], ce_f32x8_madd(vz, c[10], ce_f32x8_madd(vy, c[6], ce_f32x8_madd(vx, c[2], c[14]))));
+        if (out_w != CE_NULL) {
+            ce_f32x8_store(&out_w[i], ce_f32x8_madd(vz, c[11], ce_f32x8_madd(vy, c[7], ce_f32x8_madd(vx, c[3], c[15]))));
+        }
+    }
+}
+
+#if defined(CE_CPU_DISPATCH_X64)
+/* One 256-bit register per lane group instead of two 128-bit halves. */
+CE_TARGET("avx")
+static void ce__transform_points_soa_avx(const ce_mat4f* m,
+                                         const ce_f32* x, const ce_f32* y, const ce_f32* z,
+                                         ce_f32* out_x, ce_f32* out_y, ce_f32* out_z, ce_f32* out_w,
+                                         ce_u32 count)
+{
+    __m256 c[16];
+    __m256 vx;
+    __m256 vy;
+    __m256 vz;
+    ce_u32 i;
+
+    for (i = 0u; i < 16u; i++) {
+        c[i] = _mm256_set1_ps(m->m[i]);
+    }
+
+    for (i = 0u; i < count; i += 8u) {
+        vx = _mm256_loadu_ps(&x[i]);
+        vy = _mm256_loadu_ps(&y[i]);
+        vz = _mm256_loadu_ps(&z[i]);
+        _mm256_storeu_ps(&out_x[i], _mm256_add_ps(_mm256_mul_ps(vz, c[8]),
+                                                  _mm256_add_ps(_mm256_mul_ps(vy, c[4]),
+                                                                _mm256_add_ps(_mm256_mul_ps(vx, c[0]), c[12]))));
+        _mm256_storeu_ps(&out_y[i], _mm256_add_ps(_mm256_mul_ps(vz, c[9]),
+                                                  _mm256_add_ps(_mm256_mul_ps(vy, c[5]),
+                                                                _mm256_add_ps(_mm256_mul_ps(vx, c[1]), c[13]))));
+        _mm256_storeu_ps(&out_z[i], _mm256_add_ps(_mm256_mul_ps(vz, c[10]),
+                                                  _mm256_add_ps(_mm256_mul_ps(vy, c[6]),
+                                                                _mm256_add_ps(_mm256_mul_ps(vx, c[2]), c[14]))));
+        if (out_w != CE_NULL) {
+            _mm256_storeu_ps(&out_w[i], _mm256_add_ps(_mm256_mul_ps(vz, c[11]),
+                                                      _mm256_add_ps(_mm256_mul_ps(vy, c[7]),
+                                                                    _mm256_add_ps(_mm256_mul_ps(vx, c[3]), c[15]))));
+        }
+    }
+}
+
+static const ce__math_kernels ce__math_kernels_avx = { ce__transform_points_soa_avx };
+#endif
+
+static const ce__math_kernels ce__math_kernels_base = { ce__transform_points_soa_f32x8 };
+
+static const ce_cpu_variant ce__math_variants[] = {
+#if defined(CE_CPU_DISPATCH_X64)
+    { CE_CPU_AVX, &ce__math_kernels_avx },
+#endif
+    { 0u, &ce__math_kernels_base },
+};
+
+static ce_cpu_dispatch ce__math_dispatch = CE_CPU_DISPATCH_INIT(ce__math_variants);
+
+void ce_mat4f_transform_points_soa(const ce_mat4f* m,
+                                   const ce_f32* x, const ce_f32* y, const ce_f32* z,
+                                   ce_f32* out_x, ce_f32* out_y, ce_f32* out_z, ce_f32* out_w,
+                                   ce_u32 count)
+{
+    const ce__math_kernels* k;
+
+    k = (const ce__math_kernels*)ce_cpu_dispatch_table(&ce__math_dispatch);
+    k->transform_points_soa(m, x, y, z, out_x, out_y, out_z, out_w, count);
+}
@@ -9,8 +9,117 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_memory_arena.c
- * @brief Implementation skeleton.
+ * @brief Linear (bump) allocator.
+ *
+ * With tracking, the bytes in use are reported per tag as the offset moves.
  */
+#define CE__MEM_IMPLEMENTATION
+
 #include "core/chaos_memory.h"
 
-/* TODO: implement */
+/* Reports an offset change; compiles away without tracking. */
+static void ce__arena_track(const ce_arena* arena, ce_size from, ce_size to)
+{
+#if defined(CE_MEM_TRACKING)
+    ce__mem_track_arena(arena->tag, (ce_s64)to - (ce_s64)from);
+#else
+    (void)arena;
+    (void)from;
+    (void)to;
+#endif
+}
+
+ce_result ce_arena_init_at(ce_arena* arena, ce_size size, ce_mem_tag tag, const ce_char* file, ce_u32 line)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((arena == CE_NULL) || (size == (ce_size)0)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_arena_init_buffer(arena, ce_mem_alloc_at(size, (ce_size)64, tag, file, line), size, tag);
+        if (arena->base == CE_NULL) {
+            arena->size = (ce_size)0;
+            res         = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            arena->owns = CE_TRUE;
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_arena_init(ce_arena* arena, ce_size size, ce_mem_tag tag)
+{
+    return ce_arena_init_at(arena, size, tag, CE_NULL, 0u);
+}
+
+void ce_arena_init_buffer(ce_arena* arena, void* buffer, ce_size size, ce_mem_tag tag)
+{
+    arena->base   = (ce_u8*)buffer;
+    arena->size   = size;
+    arena->offset = (ce_size)0;
+    arena->peak   = (ce_size)0;
+    arena->owns   = CE_FALSE;
+    arena->tag    = tag;
+}
+
+void ce_arena_shutdown(ce_arena* arena)
+{
+    if (arena != CE_NULL) {
+        ce__arena_track(arena, arena->offset, 0u);
+        if (arena->owns == CE_TRUE) {
+            ce_mem_free(arena->base);
+        }
+        arena->base   = CE_NULL;
+        arena->size   = (ce_size)0;
+        arena->offset = (ce_size)0;
+        arena->owns   = CE_FALSE;
+    }
+}
+
+void* ce_arena_alloc(ce_arena* arena, ce_size size, ce_size align)
+{
+    void* ptr;
+    ce_size a;
+    ce_uptr start;
+    ce_size end;
+
+    ptr = CE_NULL;
+    a   = (align == (ce_size)0) ? CE_MEM_DEFAULT_ALIGN : align;
+
+    if ((arena->base != CE_NULL) && ((a & (a - (ce_size)1)) == (ce_size)0)) {
+        start = CE_ALIGN_UP((ce_uptr)arena->base + arena->offset, (ce_uptr)a);
+        end   = (ce_size)(start - (ce_uptr)arena->base) + size;
+        if (end <= arena->size) {
+            ce__arena_track(arena, arena->offset, end);
+            ptr           = (void*)start;
+            arena->offset = end;
+            if (end > arena->peak) {
+                arena->peak = end;
+            }
+        }
+    }
+
+    return ptr;
+}
+
+void ce_arena_reset(ce_arena* arena)
+{
+    ce__arena_track(arena, arena->offset, 0u);
+    arena->offset = (ce_size)0;
+}
+
+ce_size ce_arena_mark(const ce_arena* arena)
+{
+    return arena->offset;
+}
+
+void ce_arena_rewind(ce_arena* arena, ce_size mark)
+{
+    if (mark <= arena->offset) {
+        ce__arena_track(arena, arena->offset, mark);
+        arena->offset = mark;
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_memory_heap.c
+ * @brief General heap: aligned blocks on top of the host allocator.
+ *
+ * Each block is preceded by a small header recording the requested size,
+ * tag and the distance back to the raw host pointer (and, when tracking,
+ * the callsite, so a free is charged back to the line that allocated).
+ */
+#define CE__MEM_IMPLEMENTATION
+
+#include "core/chaos_memory.h"
+#include "utility/chaos_string.h"
+
+#include <stdlib.h>
+
+/* ************************************************************************** */
+/* BLOCK HEADER                                                               */
+/* ************************************************************************** */
+
+typedef struct ce_heap_header_s {
+    ce_size size;    /**< Requested size in bytes. */
+    ce_u32  offset;  /**< Distance from the raw host pointer to the user block. */
+    ce_u16  tag;     /**< ce_mem_tag. */
+    ce_u16  align;   /**< log2 of the alignment. */
+#if defined(CE_MEM_TRACKING)
+    ce_u32  site;    /**< Tracker callsite. */
+#endif
+} ce_heap_header;
+
+/**
+ * @brief Returns the header stored right before a user block.
+ */
+static ce_heap_header* ce__heap_header(const void* ptr)
+{
+    return (ce_heap_header*)((ce_u8*)(ce_uptr)ptr - sizeof(ce_heap_header));
+}
+
+/**
+ * @brief Normalizes an alignment request (power of two, >= header alignment).
+ */
+static ce_size ce__heap_align(ce_size align)
+{
+    ce_size a;
+
+    a = align;
+    if (a < CE_MEM_DEFAULT_ALIGN) {
+        a = CE_MEM_DEFAULT_ALIGN;
+    }
+    if ((a & (a - (ce_size)1)) != (ce_size)0) {
+        a = (ce_size)0;
+    }
+
+    return a;
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+void* ce_mem_alloc_at(ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file, ce_u32 line)
+{
+    void* ret;
+    ce_u8* raw;
+    ce_uptr user;
+    ce_size a;
+    ce_u16 shift;
+    ce_heap_header* hdr;
+
+    ret   = CE_NULL;
+    a     = ce__heap_align(align);
+    shift = 0u;
+
+    if ((size != (ce_size)0) && (a != (ce_size)0)) {
+        raw = (ce_u8*)malloc(size + a + sizeof(ce_heap_header));
+        if (raw != CE_NULL) {
+            user = CE_ALIGN_UP((ce_uptr)raw + sizeof(ce_heap_header), (ce_uptr)a);
+            while ((((ce_size)1) << shift) < a) {
+                shift++;
+            }
+            hdr         = ce__heap_header((void*)user);
+            hdr->size   = size;
+            hdr->offset = (ce_u32)(user - (ce_uptr)raw);
+            hdr->tag    = (ce_u16)tag;
+            hdr->align  = shift;
+#if defined(CE_MEM_TRACKING)
+            hdr->site   = ce__mem_track_alloc(tag, size, file, line);
+#else
+            (void)file;
+            (void)line;
+#endif
+            ret         = (void*)user;
+        }
+    }
+
+    return ret;
+}
+
+void* ce_mem_calloc_at(ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file, ce_u32 line)
+{
+    void* ret;
+
+    ret = ce_mem_alloc_at(size, align, tag, file, line);
+    if (ret != CE_NULL) {
+        (void)ce__memset(ret, 0u, size);
+    }
+
+    return ret;
+}
+
+void* ce_mem_realloc_at(void* ptr, ce_size size, ce_size align, ce_mem_tag tag, const ce_char* file, ce_u32 line)
+{
+    void* ret;
+    ce_heap_header* hdr;
+    ce_size keep;
+
+    ret = CE_NULL;
+
+    if (ptr == CE_NULL) {
+        ret = ce_mem_alloc_at(size, align, tag, file, line);
+    } else if (size == (ce_size)0) {
+        ce_mem_free(ptr);
+    } else {
+        hdr = ce__heap_header(ptr);
+        if (size <= hdr->size) {
+            /* Shrinking in place keeps the block; only the recorded size changes. */
+#if defined(CE_MEM_TRACKING)
+            ce__mem_track_release((ce_mem_tag)hdr->tag, hdr->site, hdr->size - size, CE_FALSE);
+#endif
+            hdr->size = size;
+            ret       = ptr;
+        } else {
+            ret = ce_mem_alloc_at(size, ((ce_size)1) << hdr->align, (ce_mem_tag)hdr->tag, file, line);
+            if (ret != CE_NULL) {
+                keep = hdr->size;
+                (void)ce__memcpy(ret, ptr, keep);
+                ce_mem_free(ptr);
+            }
+        }
+    }
+
+    return ret;
+}
+
+void* ce_mem_alloc(ce_size size, ce_size align, ce_mem_tag tag)
+{
+    return ce_mem_alloc_at(size, align, tag, CE_NULL, 0u);
+}
+
+void* ce_mem_calloc(ce_size size, ce_size align, ce_mem_tag tag)
+{
+    return ce_mem_calloc_at(size, align, tag, CE_NULL, 0u);
+}
+
+void* ce_mem_realloc(void* ptr, ce_size size, ce_size align, ce_mem_tag tag)
+{
+    return ce_mem_realloc_at(ptr, size, align, tag, CE_NULL, 0u);
+}
+
+void ce_mem_free(void* ptr)
+{
+    ce_heap_header* hdr;
+
+    if (ptr != CE_NULL) {
+        hdr = ce__heap_header(ptr);
+#if defined(CE_MEM_TRACKING)
+        ce__mem_track_release((ce_mem_tag)hdr->tag, hdr->site, hdr->size, CE_TRUE);
+#endif
+        free((ce_u8*)ptr - hdr->offset);
+    }
+}
+
+ce_size ce_mem_size(const void* ptr)
+{
+    ce_size size;
+
+    size = (ce_size)0;
+    if (ptr != CE_NULL) {
+        size = ce__heap_header(ptr)->size;
+    }
+
+    return size;
+}
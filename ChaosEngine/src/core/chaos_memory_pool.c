@@ -9,8 +9,95 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_memory_pool.c
- * @brief Implementation skeleton.
+ * @brief Fixed-size block allocator.
+ *
+ * Free blocks form an intrusive singly linked list, so allocation and
+ * release are a pointer swap each and the pool needs no side table.
  */
+#define CE__MEM_IMPLEMENTATION
+
 #include "core/chaos_memory.h"
 
-/* TODO: implement */
+ce_result ce_pool_init_at(ce_pool* pool, ce_size block_size, ce_u32 block_count, ce_size align, ce_mem_tag tag,
+                          const ce_char* file, ce_u32 line)
+{
+    ce_result res;
+    ce_size a;
+    ce_u32 i;
+
+    res = CE_OK;
+    a   = (align == (ce_size)0) ? CE_MEM_DEFAULT_ALIGN : align;
+    a   = (a < sizeof(void*)) ? sizeof(void*) : a;
+
+    if ((pool == CE_NULL) || (block_size == (ce_size)0) || (block_count == 0u) || ((a & (a - (ce_size)1)) != 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        pool->block_size = CE_ALIGN_UP(block_size, a);
+        pool->capacity   = block_count;
+        pool->used       = 0u;
+        pool->peak       = 0u;
+        pool->tag        = tag;
+        pool->free_list  = CE_NULL;
+        pool->base       = (ce_u8*)ce_mem_alloc_at(pool->block_size * (ce_size)block_count, a, tag, file, line);
+        if (pool->base == CE_NULL) {
+            pool->capacity = 0u;
+            res            = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            /* Threaded back to front so the first allocations come out in address order. */
+            for (i = block_count; i > 0u; i--) {
+                *(void**)(void*)(pool->base + ((ce_size)(i - 1u) * pool->block_size)) = pool->free_list;
+                pool->free_list = pool->base + ((ce_size)(i - 1u) * pool->block_size);
+            }
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_pool_init(ce_pool* pool, ce_size block_size, ce_u32 block_count, ce_size align, ce_mem_tag tag)
+{
+    return ce_pool_init_at(pool, block_size, block_count, align, tag, CE_NULL, 0u);
+}
+
+void ce_pool_shutdown(ce_pool* pool)
+{
+    if (pool != CE_NULL) {
+#if defined(CE_MEM_TRACKING)
+        ce__mem_track_pool(pool->tag, -(ce_s64)((ce_size)pool->used * pool->block_size));
+#endif
+        ce_mem_free(pool->base);
+        pool->base      = CE_NULL;
+        pool->free_list = CE_NULL;
+        pool->capacity  = 0u;
+        pool->used      = 0u;
+    }
+}
+
+void* ce_pool_alloc(ce_pool* pool)
+{
+    void* ptr;
+
+    ptr = pool->free_list;
+    if (ptr != CE_NULL) {
+        pool->free_list = *(void**)ptr;
+        pool->used     += 1u;
+        pool->peak      = (pool->used > pool->peak) ? pool->used : pool->peak;
+#if defined(CE_MEM_TRACKING)
+        ce__mem_track_pool(pool->tag, (ce_s64)pool->block_size);
+#endif
+    }
+
+    return ptr;
+}
+
+void ce_pool_free(ce_pool* pool, void* ptr)
+{
+    if (ptr != CE_NULL) {
+        *(void**)ptr    = pool->free_list;
+        pool->free_list = ptr;
+        pool->used     -= 1u;
+#if defined(CE_MEM_TRACKING)
+        ce__mem_track_pool(pool->tag, -(ce_s64)pool->block_size);
+#endif
+    }
+}
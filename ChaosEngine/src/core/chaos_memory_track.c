@@ -0,0 +1,330 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_memory_track.c
+ * @brief Central allocation tracker behind CE_MEM_TRACKING.
+ *
+ * Every counter is a relaxed-enough atomic, so allocators on any thread
+ * report without a lock. Callsites live in an open-addressed table whose
+ * slots are claimed once by CAS and never released; a probe that finds no
+ * slot charges the allocation to site 0.
+ */
+#define CE__MEM_IMPLEMENTATION
+
+#include "core/chaos_memory.h"
+#include "core/chaos_log.h"
+#include "platform/chaos_thread.h"
+
+#define CE__MEM_SITE_PROBES 64u
+
+typedef struct ce__mem_tag_counters_s {
+    ce_atomic_u64 live;
+    ce_atomic_u64 peak;
+    ce_atomic_u64 blocks;
+    ce_atomic_u64 allocs;
+    ce_atomic_u64 frees;
+    ce_atomic_u64 cur_allocs;   /**< Current frame, latched by ce_mem_track_frame. */
+    ce_atomic_u64 cur_bytes;
+    ce_atomic_u64 frame_allocs;
+    ce_atomic_u64 frame_bytes;
+    ce_atomic_u64 arena;
+    ce_atomic_u64 pool;
+    ce_atomic_u64 budget;
+    ce_atomic_u64 histogram[CE_MEM_SIZE_CLASSES];
+    ce_bool       over;         /**< Frame thread only. */
+} ce__mem_tag_counters;
+
+typedef struct ce__mem_site_s {
+    ce_atomic_u64 key;          /**< 0 = free; see ce__mem_site_key. */
+    ce_atomic_u64 file;         /**< Published after the key is claimed. */
+    ce_u32        line;
+    ce_atomic_u32 tag;
+    ce_atomic_u64 live;
+    ce_atomic_u64 peak;
+    ce_atomic_u64 blocks;
+    ce_atomic_u64 allocs;
+    ce_atomic_u64 total;
+} ce__mem_site;
+
+static ce__mem_tag_counters ce__mem_tags[CE_MEM_TAG_COUNT];
+static ce__mem_site         ce__mem_sites[CE_MEM_MAX_SITES];
+static ce_mem_budget_fn     ce__mem_budget_fn;
+static void*                ce__mem_budget_user;
+
+static const ce_char* const ce__mem_tag_names[CE_MEM_TAG_COUNT] = {
+    "general", "core", "gfx", "audio", "physics", "assets", "runtime"
+};
+
+/* ************************************************************************** */
+/* INTERNAL HELPERS                                                           */
+/* ************************************************************************** */
+
+static void ce__mem_raise_peak(ce_atomic_u64* peak, ce_u64 value)
+{
+    ce_u64 cur;
+
+    cur = ce_atomic_load_relaxed_u64(peak);
+    while ((value > cur) && (ce_atomic_cas_u64(peak, &cur, value) == CE_FALSE)) {
+        /* cur was refreshed by the failed CAS. */
+    }
+}
+
+static ce_u32 ce__mem_size_class(ce_size size)
+{
+    ce_u32 cls;
+    ce_size limit;
+
+    cls   = 0u;
+    limit = (ce_size)16;
+    while ((size > limit) && (cls < (CE_MEM_SIZE_CLASSES - 1u))) {
+        limit <<= 1u;
+        cls    += 1u;
+    }
+
+    return cls;
+}
+
+/*
+ * User-space addresses fit in 48 bits on every supported target, which
+ * leaves the top 16 for the line; longer files alias modulo 65536 lines.
+ */
+static ce_u64 ce__mem_site_key(const ce_char* file, ce_u32 line)
+{
+    return (ce_u64)(ce_uptr)file ^ ((ce_u64)line << 48u);
+}
+
+/* Finds or claims the slot of file:line; 0 when untracked or the table is full. */
+static ce_u32 ce__mem_site_lookup(const ce_char* file, ce_u32 line, ce_mem_tag tag)
+{
+    ce__mem_site* s;
+    ce_u64 key;
+    ce_u64 cur;
+    ce_u64 mix;
+    ce_u32 slot;
+    ce_u32 probe;
+    ce_u32 found;
+
+    found = 0u;
+    if (file != CE_NULL) {
+        key   = ce__mem_site_key(file, line);
+        mix   = key * 0x9E3779B97F4A7C15ull;
+        slot  = (ce_u32)(mix >> 32u) & (CE_MEM_MAX_SITES - 1u);
+        probe = 0u;
+        while ((found == 0u) && (probe < CE__MEM_SITE_PROBES)) {
+            slot = (slot == 0u) ? 1u : slot;
+            s    = &ce__mem_sites[slot];
+            cur  = ce_atomic_load_u64(&s->key);
+            if (cur == 0u) {
+                if (ce_atomic_cas_u64(&s->key, &cur, key) == CE_TRUE) {
+                    s->line = line;
+                    ce_atomic_store_u32(&s->tag, (ce_u32)tag);
+                    ce_atomic_store_u64(&s->file, (ce_u64)(ce_uptr)file);
+                    found = slot;
+                }
+            }
+            /* A lost race leaves the winner's key in cur. */
+            if ((found == 0u) && (cur == key)) {
+                found = slot;
+            }
+            slot   = (slot + 1u) & (CE_MEM_MAX_SITES - 1u);
+            probe += 1u;
+        }
+    }
+
+    return found;
+}
+
+/* ************************************************************************** */
+/* ALLOCATOR HOOKS                                                            */
+/* ************************************************************************** */
+
+ce_u32 ce__mem_track_alloc(ce_mem_tag tag, ce_size size, const ce_char* file, ce_u32 line)
+{
+    ce__mem_tag_counters* t;
+    ce__mem_site* s;
+    ce_u32 site;
+
+    t    = &ce__mem_tags[tag];
+    site = ce__mem_site_lookup(file, line, tag);
+    s    = &ce__mem_sites[site];
+
+    ce__mem_raise_peak(&t->peak, ce_atomic_fetch_add_u64(&t->live, (ce_u64)size) + (ce_u64)size);
+    (void)ce_atomic_fetch_add_u64(&t->blocks, 1u);
+    (void)ce_atomic_fetch_add_u64(&t->allocs, 1u);
+    (void)ce_atomic_fetch_add_u64(&t->cur_allocs, 1u);
+    (void)ce_atomic_fetch_add_u64(&t->cur_bytes, (ce_u64)size);
+    (void)ce_atomic_fetch_add_u64(&t->histogram[ce__mem_size_class(size)], 1u);
+
+    ce__mem_raise_peak(&s->peak, ce_atomic_fetch_add_u64(&s->live, (ce_u64)size) + (ce_u64)size);
+    (void)ce_atomic_fetch_add_u64(&s->blocks, 1u);
+    (void)ce_atomic_fetch_add_u64(&s->allocs, 1u);
+    (void)ce_atomic_fetch_add_u64(&s->total, (ce_u64)size);
+
+    return site;
+}
+
+void ce__mem_track_release(ce_mem_tag tag, ce_u32 site, ce_size size, ce_bool whole_block)
+{
+    ce__mem_tag_counters* t;
+    ce__mem_site* s;
+
+    t = &ce__mem_tags[tag];
+    s = &ce__mem_sites[site];
+
+    (void)ce_atomic_fetch_sub_u64(&t->live, (ce_u64)size);
+    (void)ce_atomic_fetch_sub_u64(&s->live, (ce_u64)size);
+    if (whole_block == CE_TRUE) {
+        (void)ce_atomic_fetch_sub_u64(&t->blocks, 1u);
+        (void)ce_atomic_fetch_add_u64(&t->frees, 1u);
+        (void)ce_atomic_fetch_sub_u64(&s->blocks, 1u);
+    }
+}
+
+void ce__mem_track_arena(ce_mem_tag tag, ce_s64 delta)
+{
+    (void)ce_atomic_fetch_add_u64(&ce__mem_tags[tag].arena, (ce_u64)delta);
+}
+
+void ce__mem_track_pool(ce_mem_tag tag, ce_s64 delta)
+{
+    (void)ce_atomic_fetch_add_u64(&ce__mem_tags[tag].pool, (ce_u64)delta);
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_bool ce_mem_tracking_enabled(void)
+{
+#if defined(CE_MEM_TRACKING)
+    return CE_TRUE;
+#else
+    return CE_FALSE;
+#endif
+}
+
+const ce_char* ce_mem_tag_name(ce_mem_tag tag)
+{
+    return ((ce_u32)tag < (ce_u32)CE_MEM_TAG_COUNT) ? ce__mem_tag_names[tag] : "unknown";
+}
+
+void ce_mem_set_budget(ce_mem_tag tag, ce_u64 bytes)
+{
+    if ((ce_u32)tag < (ce_u32)CE_MEM_TAG_COUNT) {
+        ce_atomic_store_u64(&ce__mem_tags[tag].budget, bytes);
+    }
+}
+
+void ce_mem_set_budget_callback(ce_mem_budget_fn fn, void* user)
+{
+    ce__mem_budget_fn   = fn;
+    ce__mem_budget_user = user;
+}
+
+void ce_mem_track_frame(void)
+{
+    ce__mem_tag_counters* t;
+    ce_u64 allocs;
+    ce_u64 bytes;
+    ce_u64 live;
+    ce_u64 budget;
+    ce_bool over;
+    ce_u32 i;
+
+    for (i = 0u; i < (ce_u32)CE_MEM_TAG_COUNT; i++) {
+        t = &ce__mem_tags[i];
+
+        /* Whatever lands between the load and the subtract counts next frame. */
+        allocs = ce_atomic_load_u64(&t->cur_allocs);
+        bytes  = ce_atomic_load_u64(&t->cur_bytes);
+        (void)ce_atomic_fetch_sub_u64(&t->cur_allocs, allocs);
+        (void)ce_atomic_fetch_sub_u64(&t->cur_bytes, bytes);
+        ce_atomic_store_u64(&t->frame_allocs, allocs);
+        ce_atomic_store_u64(&t->frame_bytes, bytes);
+
+        live   = ce_atomic_load_u64(&t->live);
+        budget = ce_atomic_load_u64(&t->budget);
+        over   = ((budget != 0u) && (live > budget)) ? CE_TRUE : CE_FALSE;
+        if ((over == CE_TRUE) && (t->over == CE_FALSE)) {
+            if (ce__mem_budget_fn != CE_NULL) {
+                ce__mem_budget_fn(ce__mem_budget_user, (ce_mem_tag)i, live, budget);
+            } else {
+                CE_LOG_WARN("memory budget exceeded for '%s': %llu / %llu bytes", ce__mem_tag_names[i],
+                            (unsigned long long)live, (unsigned long long)budget);
+            }
+        }
+        t->over = over;
+    }
+}
+
+void ce_mem_get_tag_stats(ce_mem_tag tag, ce_mem_tag_stats* out_stats)
+{
+    const ce__mem_tag_counters* t;
+    ce_u32 i;
+
+    if ((out_stats != CE_NULL) && ((ce_u32)tag < (ce_u32)CE_MEM_TAG_COUNT)) {
+        t = &ce__mem_tags[tag];
+        out_stats->live_bytes   = ce_atomic_load_u64(&t->live);
+        out_stats->peak_bytes   = ce_atomic_load_u64(&t->peak);
+        out_stats->live_blocks  = ce_atomic_load_u64(&t->blocks);
+        out_stats->allocs       = ce_atomic_load_u64(&t->allocs);
+        out_stats->frees        = ce_atomic_load_u64(&t->frees);
+        out_stats->frame_allocs = ce_atomic_load_u64(&t->frame_allocs);
+        out_stats->frame_bytes  = ce_atomic_load_u64(&t->frame_bytes);
+        out_stats->arena_bytes  = ce_atomic_load_u64(&t->arena);
+        out_stats->pool_bytes   = ce_atomic_load_u64(&t->pool);
+        out_stats->budget_bytes = ce_atomic_load_u64(&t->budget);
+        for (i = 0u; i < CE_MEM_SIZE_CLASSES; i++) {
+            out_stats->size_histogram[i] = ce_atomic_load_u64(&t->histogram[i]);
+        }
+    }
+}
+
+ce_u32 ce_mem_get_top_sites(ce_mem_site_stats* out_sites, ce_u32 max_sites)
+{
+    const ce__mem_site* s;
+    ce_mem_site_stats cand;
+    ce_u32 count;
+    ce_u32 i;
+    ce_u32 j;
+
+    count = 0u;
+    if ((out_sites != CE_NULL) && (max_sites > 0u)) {
+        for (i = 0u; i < CE_MEM_MAX_SITES; i++) {
+            s = &ce__mem_sites[i];
+            cand.file        = (const ce_char*)(ce_uptr)ce_atomic_load_u64(&s->file);
+            cand.line        = s->line;
+            cand.tag         = (ce_mem_tag)ce_atomic_load_u32(&s->tag);
+            cand.live_bytes  = ce_atomic_load_u64(&s->live);
+            cand.peak_bytes  = ce_atomic_load_u64(&s->peak);
+            cand.live_blocks = ce_atomic_load_u64(&s->blocks);
+            cand.allocs      = ce_atomic_load_u64(&s->allocs);
+            cand.total_bytes = ce_atomic_load_u64(&s->total);
+
+            /* Skips empty slots, and claimed ones whose file is not published yet. */
+            if ((cand.allocs != 0u) && ((i == 0u) || (cand.file != CE_NULL))) {
+                /* Insertion into the sorted prefix; the smallest falls off the end. */
+                j = (count < max_sites) ? count : max_sites;
+                while ((j > 0u) && (out_sites[j - 1u].live_bytes < cand.live_bytes)) {
+                    if (j < max_sites) {
+                        out_sites[j] = out_sites[j - 1u];
+                    }
+                    j -= 1u;
+                }
+                if (j < max_sites) {
+                    out_sites[j] = cand;
+                    count       += (count < max_sites) ? 1u : 0u;
+                }
+            }
+        }
+    }
+
+    return count;
+}
@@ -9,8 +9,351 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_time.c
- * @brief Implementation skeleton.
+ * @brief Native clock: calibrated invariant TSC, clock_gettime fallback.
+ *
+ * Conversions are 32.32 fixed-point multiplies split into 32-bit halves, so
+ * they never overflow and need neither division nor 128-bit integers.
+ * Platforms without POSIX clocks use chaos_time_sdl.c instead.
  */
+#define _POSIX_C_SOURCE 199309L
+
 #include "core/chaos_time.h"
+#include "platform/chaos_thread.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CE__TIME_HAVE_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#if defined(CLOCK_MONOTONIC_RAW)
+#define CE__TIME_CALIBRATION_CLOCK CLOCK_MONOTONIC_RAW
+#else
+#define CE__TIME_CALIBRATION_CLOCK CLOCK_MONOTONIC
+#endif
+
+#define CE__TIME_CALIBRATION_NS (10ull * CE_NS_PER_MS)
+#define CE__TIME_SAMPLE_TRIES   8u
+#define CE__TIME_ONE            4294967296.0  /* 1.0 in 32.32 */
+
+/* Spin margin of the precise sleep: twice the average oversleep, clamped. */
+#define CE__TIME_OVERSLEEP_INIT (100ull * CE_NS_PER_US)
+#define CE__TIME_SPIN_MIN       (20ull * CE_NS_PER_US)
+#define CE__TIME_SPIN_MAX       (2ull * CE_NS_PER_MS)
+
+#define CE__TIME_UNINIT      0u
+#define CE__TIME_CALIBRATING 1u
+#define CE__TIME_READY       2u
+
+/* Immutable once published: readers load one pointer, so a switch never tears. */
+typedef struct ce__time_params_s {
+    ce_u32 source;
+    ce_u64 tick_base;
+    ce_u64 ns_base;
+    ce_u64 to_ns;     /* Nanoseconds per tick, 32.32. */
+    ce_u64 to_ticks;  /* Ticks per nanosecond, 32.32. */
+    ce_u64 frequency;
+} ce__time_params;
+
+typedef struct ce__time_clock_s {
+    ce_atomic_u32   state;
+    ce_atomic_u64   params;  /* const ce__time_params*, published with release. */
+    ce__time_params tsc;     /* Written only while unpublished or by ce_time_init(). */
+    ce_atomic_u64   oversleep_ns;
+} ce__time_clock;
+
+static const ce__time_params ce__time_monotonic = {
+    (ce_u32)CE_TIME_SOURCE_MONOTONIC, 0u, 0u, (ce_u64)CE__TIME_ONE, (ce_u64)CE__TIME_ONE, CE_NS_PER_S,
+};
+
+static ce__time_clock ce__time;
+
+/* ************************************************************************** */
+/* SOURCES                                                                    */
+/* ************************************************************************** */
+
+static ce_u64 ce__time_os_ns(clockid_t clock)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(clock, &ts);
+
+    return ((ce_u64)ts.tv_sec * CE_NS_PER_S) + (ce_u64)ts.tv_nsec;
+}
+
+static void ce__time_os_sleep(ce_u64 ns)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = (time_t)(ns / CE_NS_PER_S);
+    ts.tv_nsec = (long)(ns % CE_NS_PER_S);
+    (void)nanosleep(&ts, CE_NULL);
+}
+
+#if defined(CE__TIME_HAVE_TSC)
+
+/* CPUID 0x80000007 EDX[8]: constant rate in every P/C-state, synchronized. */
+static ce_bool ce__time_tsc_invariant(void)
+{
+    unsigned int a;
+    unsigned int b;
+    unsigned int c;
+    unsigned int d;
+    ce_bool invariant;
+
+    invariant = CE_FALSE;
+    if ((__get_cpuid(0x80000000u, &a, &b, &c, &d) != 0) && (a >= 0x80000007u)) {
+        if ((__get_cpuid(0x80000007u, &a, &b, &c, &d) != 0) && ((d & (1u << 8)) != 0u)) {
+            invariant = CE_TRUE;
+        }
+    }
+
+    return invariant;
+}
+
+static ce_u64 ce__time_tsc(void)
+{
+    return (ce_u64)__rdtsc();
+}
+
+/* Pairs the TSC with `clock`, keeping the tightest of a few brackets. */
+static void ce__time_sample(clockid_t clock, ce_u64* out_tsc, ce_u64* out_ns)
+{
+    ce_u64 best;
+    ce_u64 t0;
+    ce_u64 t1;
+    ce_u64 ns;
+    ce_u32 i;
+
+    best     = ~0ull;
+    *out_tsc = 0u;
+    *out_ns  = 0u;
+    for (i = 0u; i < CE__TIME_SAMPLE_TRIES; i++) {
+        t0 = ce__time_tsc();
+        ns = ce__time_os_ns(clock);
+        t1 = ce__time_tsc();
+        if ((t1 - t0) < best) {
+            best     = t1 - t0;
+            *out_tsc = t0 + ((t1 - t0) / 2u);
+            *out_ns  = ns;
+        }
+    }
+}
+
+static ce_bool ce__time_calibrate_tsc(void)
+{
+    ce_bool ok;
+    ce_u64 tsc0;
+    ce_u64 tsc1;
+    ce_u64 ns0;
+    ce_u64 ns1;
+    ce_f64 dt;
+    ce_f64 dn;
+
+    ok = CE_FALSE;
+    if (ce__time_tsc_invariant() == CE_TRUE) {
+        ce__time_sample(CE__TIME_CALIBRATION_CLOCK, &tsc0, &ns0);
+        ce__time_os_sleep(CE__TIME_CALIBRATION_NS);
+        ce__time_sample(CE__TIME_CALIBRATION_CLOCK, &tsc1, &ns1);
+        if ((tsc1 > tsc0) && (ns1 > ns0)) {
+            dt = (ce_f64)(tsc1 - tsc0);
+            dn = (ce_f64)(ns1 - ns0);
+            ce__time.tsc.to_ns     = (ce_u64)(((dn * CE__TIME_ONE) / dt) + 0.5);
+            ce__time.tsc.to_ticks  = (ce_u64)(((dt * CE__TIME_ONE) / dn) + 0.5);
+            ce__time.tsc.frequency = (ce_u64)(((dt * (ce_f64)CE_NS_PER_S) / dn) + 0.5);
+            /* Anchored on CLOCK_MONOTONIC so timestamps keep its epoch. */
+            ce__time_sample(CLOCK_MONOTONIC, &ce__time.tsc.tick_base, &ce__time.tsc.ns_base);
+            ce__time.tsc.source = (ce_u32)CE_TIME_SOURCE_TSC;
+            ok                  = CE_TRUE;
+        }
+    }
+
+    return ok;
+}
+
+#endif /* CE__TIME_HAVE_TSC */
+
+static void ce__time_publish(const ce__time_params* params)
+{
+    ce_atomic_store_u64(&ce__time.params, (ce_u64)(ce_uptr)params);
+}
+
+/* (value * mult) >> 32 without overflow, for a 32.32 `mult`. */
+static ce_u64 ce__time_scale(ce_u64 value, ce_u64 mult)
+{
+    ce_u64 mult_hi;
+    ce_u64 mult_lo;
+
+    mult_hi = mult >> 32u;
+    mult_lo = mult & 0xFFFFFFFFull;
+
+    return (value * mult_hi) + ((value >> 32u) * mult_lo) + (((value & 0xFFFFFFFFull) * mult_lo) >> 32u);
+}
+
+static void ce__time_ensure(void)
+{
+    ce_u32 expected;
+
+    expected = CE__TIME_UNINIT;
+    if (ce_atomic_cas_u32(&ce__time.state, &expected, CE__TIME_CALIBRATING) == CE_TRUE) {
+        (void)ce_time_init();
+    } else {
+        while (ce_atomic_load_u32(&ce__time.state) != CE__TIME_READY) {
+            ce_cpu_pause();
+        }
+    }
+}
+
+static const ce__time_params* ce__time_get(void)
+{
+    if (ce_atomic_load_u32(&ce__time.state) != CE__TIME_READY) {
+        ce__time_ensure();
+    }
+
+    return (const ce__time_params*)(ce_uptr)ce_atomic_load_u64(&ce__time.params);
+}
+
+/* Reads the counter `params` describes, so ticks and parameters always match. */
+static ce_u64 ce__time_read(const ce__time_params* params)
+{
+    ce_u64 ticks;
+
+#if defined(CE__TIME_HAVE_TSC)
+    if (params->source == (ce_u32)CE_TIME_SOURCE_TSC) {
+        ticks = ce__time_tsc();
+    } else {
+        ticks = ce__time_os_ns(CLOCK_MONOTONIC);
+    }
+#else
+    (void)params;
+    ticks = ce__time_os_ns(CLOCK_MONOTONIC);
+#endif
+
+    return ticks;
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_result ce_time_init(void)
+{
+    ce_atomic_store_u32(&ce__time.state, CE__TIME_CALIBRATING);
+    if (ce_atomic_load_relaxed_u64(&ce__time.oversleep_ns) == 0u) {
+        ce_atomic_store_u64(&ce__time.oversleep_ns, CE__TIME_OVERSLEEP_INIT);
+    }
+#if defined(CE__TIME_HAVE_TSC)
+    ce__time_publish((ce__time_calibrate_tsc() == CE_TRUE) ? &ce__time.tsc : &ce__time_monotonic);
+#else
+    ce__time_publish(&ce__time_monotonic);
+#endif
+    ce_atomic_store_u32(&ce__time.state, CE__TIME_READY);
+
+    return CE_OK;
+}
+
+ce_result ce_time_set_source(ce_time_source source)
+{
+    ce_result res;
+
+    res = CE_OK;
+    ce__time_ensure();
+    if (source == CE_TIME_SOURCE_MONOTONIC) {
+        ce__time_publish(&ce__time_monotonic);
+    } else {
+#if defined(CE__TIME_HAVE_TSC)
+        /* The TSC block is calibrated once, then only republished. */
+        if ((ce__time.tsc.source == (ce_u32)CE_TIME_SOURCE_TSC) || (ce__time_calibrate_tsc() == CE_TRUE)) {
+            ce__time_publish(&ce__time.tsc);
+        } else {
+            res = CE_ERR_UNSUPPORTED;
+        }
+#else
+        res = CE_ERR_UNSUPPORTED;
+#endif
+    }
+
+    return res;
+}
+
+ce_time_source ce_time_get_source(void)
+{
+    return (ce_time_source)ce__time_get()->source;
+}
+
+ce_u64 ce_time_ticks(void)
+{
+    return ce__time_read(ce__time_get());
+}
+
+ce_u64 ce_time_ticks_per_second(void)
+{
+    return ce__time_get()->frequency;
+}
+
+ce_u64 ce_time_ticks_to_ns(ce_u64 ticks)
+{
+    return ce__time_scale(ticks, ce__time_get()->to_ns);
+}
+
+ce_u64 ce_time_ns_to_ticks(ce_u64 ns)
+{
+    return ce__time_scale(ns, ce__time_get()->to_ticks);
+}
+
+ce_u64 ce_time_now_ns(void)
+{
+    const ce__time_params* params;
+    ce_u64 ticks;
+
+    params = ce__time_get();
+    ticks  = ce__time_read(params);
+
+    return params->ns_base + ce__time_scale(ticks - params->tick_base, params->to_ns);
+}
+
+void ce_time_sleep_until_ns(ce_u64 deadline_ns)
+{
+    ce_u64 now;
+    ce_u64 after;
+    ce_u64 margin;
+    ce_u64 request;
+    ce_u64 over;
+    ce_u64 average;
+
+    now     = ce_time_now_ns();
+    average = ce_atomic_load_relaxed_u64(&ce__time.oversleep_ns);
+    margin  = (average * 2u) + CE__TIME_SPIN_MIN;
+    margin  = (margin < CE__TIME_SPIN_MAX) ? margin : CE__TIME_SPIN_MAX;
+
+    while ((now + margin) < deadline_ns) {
+        request = deadline_ns - now - margin;
+        ce__time_os_sleep(request);
+        after   = ce_time_now_ns();
+        over    = ((after - now) > request) ? ((after - now) - request) : 0u;
+        /* Moving average, 1/8 weight per sample. */
+        average = average - (average / 8u) + (over / 8u);
+        ce_atomic_store_u64(&ce__time.oversleep_ns, average);
+        now = after;
+    }
+    while (now < deadline_ns) {
+        ce_cpu_pause();
+        now = ce_time_now_ns();
+    }
+}
+
+void ce_time_sleep_ns(ce_u64 ns)
+{
+    ce_time_sleep_until_ns(ce_time_now_ns() + ns);
+}
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int ce_time_native_unused;
 
-/* TODO: implement */
+#endif /* __unix__ || __APPLE__ */
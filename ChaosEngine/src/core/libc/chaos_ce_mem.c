@@ -9,8 +9,122 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_ce_mem.c
- * @brief Implementation skeleton.
+ * @brief Out-of-line bulk kernels behind the chaos_string.h helpers.
+ *
+ * Only the comparison lives here: GCC and Clang already turn the copy, fill
+ * and move loops into calls to the host's own dispatched routines, while a
+ * byte-compare loop is left as is.
  */
+#include "utility/chaos_string.h"
+#include "core/chaos_defs.h"
 
+#if defined(CE_CPU_DISPATCH_X64)
+#include <immintrin.h>
+#endif
 
-/* TODO: implement */
+typedef struct ce__mem_kernels_s {
+    ce_s32 (*compare)(const ce_u8* a, const ce_u8* b, ce_size n);
+} ce__mem_kernels;
+
+/* ************************************************************************** */
+/* KERNELS                                                                    */
+/* ************************************************************************** */
+
+/* Same result as ce__memcmp: difference of the first differing bytes. */
+static ce_s32 ce__mem_compare_tail(const ce_u8* a, const ce_u8* b, ce_size n)
+{
+    ce_s32 ret;
+    ce_size i;
+
+    ret = 0;
+    for (i = (ce_size)0; (i < n) && (ret == 0); i++) {
+        ret = (ce_s32)a[i] - (ce_s32)b[i];
+    }
+
+    return ret;
+}
+
+/* Eight bytes per step; the copies compile to plain unaligned loads. */
+static ce_s32 ce__mem_compare_words(const ce_u8* a, const ce_u8* b, ce_size n)
+{
+    ce_u64 wa;
+    ce_u64 wb;
+    ce_size i;
+
+    i  = (ce_size)0;
+    wa = 0u;
+    wb = 0u;
+    while (((i + (ce_size)8) <= n) && (wa == wb)) {
+        (void)ce__memcpy(&wa, &a[i], (ce_size)8);
+        (void)ce__memcpy(&wb, &b[i], (ce_size)8);
+        i += (wa == wb) ? (ce_size)8 : (ce_size)0;
+    }
+
+    return ce__mem_compare_tail(&a[i], &b[i], n - i);
+}
+
+#if defined(CE_CPU_DISPATCH_X64)
+/* SSE2 is part of x86-64, so this one needs no target attribute. */
+static ce_s32 ce__mem_compare_sse2(const ce_u8* a, const ce_u8* b, ce_size n)
+{
+    ce_u32 diff;
+    ce_size i;
+
+    i    = (ce_size)0;
+    diff = 0u;
+    while (((i + (ce_size)16) <= n) && (diff == 0u)) {
+        diff = (ce_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(const void*)&a[i]),
+                                                        _mm_loadu_si128((const __m128i*)(const void*)&b[i])));
+        diff = ~diff & 0xFFFFu;
+        i   += (diff == 0u) ? (ce_size)16 : (ce_size)__builtin_ctz(diff);
+    }
+
+    return ce__mem_compare_tail(&a[i], &b[i], n - i);
+}
+
+CE_TARGET("avx2")
+static ce_s32 ce__mem_compare_avx2(const ce_u8* a, const ce_u8* b, ce_size n)
+{
+    ce_u32 diff;
+    ce_size i;
+
+    i    = (ce_size)0;
+    diff = 0u;
+    while (((i + (ce_size)32) <= n) && (diff == 0u)) {
+        diff = ~(ce_u32)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(const void*)&a[i]),
+                              _mm256_loadu_si256((const __m256i*)(const void*)&b[i])));
+        i   += (diff == 0u) ? (ce_size)32 : (ce_size)__builtin_ctz(diff);
+    }
+
+    return ce__mem_compare_tail(&a[i], &b[i], n - i);
+}
+
+static const ce__mem_kernels ce__mem_kernels_avx2 = { ce__mem_compare_avx2 };
+static const ce__mem_kernels ce__mem_kernels_sse2 = { ce__mem_compare_sse2 };
+#endif
+
+static const ce__mem_kernels ce__mem_kernels_base = { ce__mem_compare_words };
+
+static const ce_cpu_variant ce__mem_variants[] = {
+#if defined(CE_CPU_DISPATCH_X64)
+    { CE_CPU_AVX2, &ce__mem_kernels_avx2 },
+    { CE_CPU_SSE2, &ce__mem_kernels_sse2 },
+#endif
+    { 0u, &ce__mem_kernels_base },
+};
+
+static ce_cpu_dispatch ce__mem_dispatch = CE_CPU_DISPATCH_INIT(ce__mem_variants);
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_s32 ce__mem_compare_bulk(const void* a, const void* b, ce_size n)
+{
+    const ce__mem_kernels* k;
+
+    k = (const ce__mem_kernels*)ce_cpu_dispatch_table(&ce__mem_dispatch);
+
+    return k->compare((const ce_u8*)a, (const ce_u8*)b, n);
+}
@@ -0,0 +1,414 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_sw_canvas.c
+ * @brief Dirty-rectangle tracking and partial 2D redraw for the SW backend.
+ *
+ * Sprites are compared slot by slot with the previous frame through a
+ * content hash; a changed slot dirties both its old and new bounds. Only
+ * the merged dirty rectangles are cleared and re-rastered, and the same
+ * rectangles are what the window uploads.
+ */
+#include "gfx/chaos_sw_raster.h"
+#include "utility/chaos_string.h"
+
+#include <math.h>
+
+/* ************************************************************************** */
+/* DIRTY REGIONS                                                              */
+/* ************************************************************************** */
+
+static inline ce_u64 ce__recti_area(const ce_recti* r)
+{
+    return (ce_u64)(r->x1 - r->x0) * (ce_u64)(r->y1 - r->y0);
+}
+
+static inline ce_recti ce__recti_union(const ce_recti* a, const ce_recti* b)
+{
+    ce_recti u;
+
+    u.x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+    u.y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+    u.x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+    u.y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+    return u;
+}
+
+static inline ce_bool ce__recti_overlap(const ce_recti* a, const ce_recti* b)
+{
+    return ((a->x0 < b->x1) && (b->x0 < a->x1) && (a->y0 < b->y1) && (b->y0 < a->y1)) ? CE_TRUE : CE_FALSE;
+}
+
+void ce_dirty_reset(ce_dirty_region* region, ce_u32 width, ce_u32 height)
+{
+    region->count  = 0u;
+    region->width  = (ce_s32)width;
+    region->height = (ce_s32)height;
+}
+
+void ce_dirty_add_all(ce_dirty_region* region)
+{
+    region->rects[0].x0 = 0;
+    region->rects[0].y0 = 0;
+    region->rects[0].x1 = region->width;
+    region->rects[0].y1 = region->height;
+    region->count       = 1u;
+}
+
+void ce_dirty_add(ce_dirty_region* region, const ce_recti* rect)
+{
+    ce_recti r;
+    ce_recti u;
+    ce_u64 waste;
+    ce_u64 best_waste;
+    ce_u32 best;
+    ce_u32 i;
+    ce_bool merged;
+
+    /* Snap outwards to whole tiles: fewer, better aligned uploads. */
+    r.x0 = (rect->x0 < 0) ? 0 : (ce_s32)CE_ALIGN_DOWN((ce_u32)rect->x0, CE_SW_TILE);
+    r.y0 = (rect->y0 < 0) ? 0 : (ce_s32)CE_ALIGN_DOWN((ce_u32)rect->y0, CE_SW_TILE);
+    r.x1 = (rect->x1 <= 0) ? 0 : (ce_s32)CE_ALIGN_UP((ce_u32)rect->x1, CE_SW_TILE);
+    r.y1 = (rect->y1 <= 0) ? 0 : (ce_s32)CE_ALIGN_UP((ce_u32)rect->y1, CE_SW_TILE);
+    r.x1 = (r.x1 > region->width) ? region->width : r.x1;
+    r.y1 = (r.y1 > region->height) ? region->height : r.y1;
+    if ((r.x0 >= r.x1) || (r.y0 >= r.y1)) {
+        return;
+    }
+
+    /* Absorb every rectangle whose union with r wastes at most a quarter of the union. */
+    do {
+        merged = CE_FALSE;
+        for (i = 0u; i < region->count; i++) {
+            u = ce__recti_union(&region->rects[i], &r);
+            if ((ce__recti_overlap(&region->rects[i], &r) == CE_TRUE) ||
+                ((ce__recti_area(&u) * 3u) <= ((ce__recti_area(&region->rects[i]) + ce__recti_area(&r)) * 4u))) {
+                r                   = u;
+                region->rects[i]    = region->rects[region->count - 1u];
+                region->count      -= 1u;
+                merged              = CE_TRUE;
+                break;
+            }
+        }
+
+        if ((merged == CE_FALSE) && (region->count == CE_DIRTY_MAX_RECTS)) {
+            best       = 0u;
+            best_waste = ~(ce_u64)0;
+            for (i = 0u; i < region->count; i++) {
+                u     = ce__recti_union(&region->rects[i], &r);
+                waste = ce__recti_area(&u) - ce__recti_area(&region->rects[i]);
+                if (waste < best_waste) {
+                    best       = i;
+                    best_waste = waste;
+                }
+            }
+            r                     = ce__recti_union(&region->rects[best], &r);
+            region->rects[best]   = region->rects[region->count - 1u];
+            region->count        -= 1u;
+            merged                = CE_TRUE;
+        }
+    } while (merged == CE_TRUE);
+
+    region->rects[region->count] = r;
+    region->count += 1u;
+
+    /* Past half the screen one full upload beats several partial ones. */
+    if ((ce_dirty_area(region) * 2u) >= ((ce_u64)region->width * (ce_u64)region->height)) {
+        ce_dirty_add_all(region);
+    }
+}
+
+ce_u64 ce_dirty_area(const ce_dirty_region* region)
+{
+    ce_u64 area;
+    ce_u32 i;
+
+    area = 0u;
+    for (i = 0u; i < region->count; i++) {
+        area += ce__recti_area(&region->rects[i]);
+    }
+
+    return area;
+}
+
+/* ************************************************************************** */
+/* CANVAS                                                                     */
+/* ************************************************************************** */
+
+ce_result ce_sw_canvas_init(ce_sw_canvas* canvas, ce_sw_target* target, ce_color clear_color)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((canvas == CE_NULL) || (target == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        (void)ce__memset(canvas, 0u, sizeof(*canvas));
+        canvas->target      = target;
+        canvas->clear_color = clear_color;
+        canvas->full        = CE_TRUE;
+        ce_dirty_reset(&canvas->pending, target->width, target->height);
+        ce_dirty_reset(&canvas->dirty, target->width, target->height);
+
+        res = ce_dynarray_init(&canvas->keys, sizeof(ce_u64), (ce_size)256, CE_MEM_TAG_GFX);
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&canvas->rects, sizeof(ce_recti), (ce_size)256, CE_MEM_TAG_GFX);
+        }
+        if (res != CE_OK) {
+            ce_sw_canvas_shutdown(canvas);
+        }
+    }
+
+    return res;
+}
+
+void ce_sw_canvas_shutdown(ce_sw_canvas* canvas)
+{
+    if (canvas != CE_NULL) {
+        ce_dynarray_shutdown(&canvas->keys);
+        ce_dynarray_shutdown(&canvas->rects);
+        (void)ce__memset(canvas, 0u, sizeof(*canvas));
+    }
+}
+
+void ce_sw_canvas_set_images(ce_sw_canvas* canvas, const ce_sw_image* images, ce_u32 count)
+{
+    canvas->images      = images;
+    canvas->image_count = count;
+    canvas->full        = CE_TRUE;
+}
+
+void ce_sw_canvas_invalidate(ce_sw_canvas* canvas)
+{
+    canvas->full = CE_TRUE;
+}
+
+/**
+ * @brief Pixel bounds of a float rectangle (conservative).
+ */
+static ce_recti ce__sw_rect_bounds(ce_f32 x, ce_f32 y, ce_f32 w, ce_f32 h)
+{
+    ce_recti r;
+
+    r.x0 = (ce_s32)floorf(x);
+    r.y0 = (ce_s32)floorf(y);
+    r.x1 = (ce_s32)ceilf(x + w);
+    r.y1 = (ce_s32)ceilf(y + h);
+    return r;
+}
+
+void ce_sw_canvas_mark_dirty(ce_sw_canvas* canvas, const ce_rectf* rect)
+{
+    ce_recti r;
+
+    r = ce__sw_rect_bounds(rect->x, rect->y, rect->w, rect->h);
+    ce_dirty_add(&canvas->pending, &r);
+}
+
+static inline ce_u32 ce__sw_blend_channel(ce_u32 src, ce_u32 dst, ce_u32 a)
+{
+    return ((src * a) + (dst * (255u - a)) + 127u) / 255u;
+}
+
+/**
+ * @brief Samples the sprite's texture at normalized (u, v) and applies its tint.
+ */
+static ce_color ce__sw_sample(const ce_sw_canvas* canvas, const ce_sprite* s, ce_f32 u, ce_f32 v)
+{
+    const ce_sw_image* img;
+    const ce_u8* texel;
+    ce_color c;
+    ce_s32 tx;
+    ce_s32 ty;
+    ce_f32 d;
+    ce_u32 a;
+
+    c = s->color;
+    if ((s->texture != CE_TEXTURE_NONE) && (s->texture <= canvas->image_count)) {
+        img = &canvas->images[s->texture - 1u];
+        tx  = (ce_s32)(u * (ce_f32)img->width);
+        ty  = (ce_s32)(v * (ce_f32)img->height);
+        tx  = (tx < 0) ? 0 : ((tx >= (ce_s32)img->width) ? ((ce_s32)img->width - 1) : tx);
+        ty  = (ty < 0) ? 0 : ((ty >= (ce_s32)img->height) ? ((ce_s32)img->height - 1) : ty);
+
+        if (img->format == CE_PIXEL_FORMAT_R8) {
+            texel = (const ce_u8*)img->pixels + ((ce_size)ty * img->stride) + (ce_size)tx;
+            if ((s->flags & CE_SPRITE_FLAG_SDF) != 0u) {
+                /* Distance 0.5 is the outline; a fixed ramp keeps edges about one texel wide. */
+                d = (((ce_f32)texel[0] / 255.0f) - 0.5f) * 8.0f + 0.5f;
+                d = (d < 0.0f) ? 0.0f : ((d > 1.0f) ? 1.0f : d);
+                a = (ce_u32)(d * 255.0f + 0.5f);
+            } else {
+                a = texel[0];
+            }
+            c = CE_RGBA(CE_COLOR_R(c), CE_COLOR_G(c), CE_COLOR_B(c), ((ce_u32)CE_COLOR_A(c) * a) / 255u);
+        } else {
+            texel = (const ce_u8*)img->pixels + ((ce_size)ty * img->stride) + ((ce_size)tx * 4u);
+            c     = CE_RGBA(((ce_u32)texel[0] * CE_COLOR_R(c)) / 255u, ((ce_u32)texel[1] * CE_COLOR_G(c)) / 255u,
+                            ((ce_u32)texel[2] * CE_COLOR_B(c)) / 255u, ((ce_u32)texel[3] * CE_COLOR_A(c)) / 255u);
+        }
+    }
+
+    return c;
+}
+
+/**
+ * @brief Rasterizes one sprite restricted to `clip` (pixel centers inside the quad).
+ */
+static void ce__sw_draw_sprite(const ce_sw_canvas* canvas, const ce_sprite* s, const ce_recti* clip)
+{
+    ce_sw_target* target;
+    ce_color* row;
+    ce_color src;
+    ce_color dst;
+    ce_s32 x0;
+    ce_s32 y0;
+    ce_s32 x1;
+    ce_s32 y1;
+    ce_s32 px;
+    ce_s32 py;
+    ce_f32 u;
+    ce_f32 v;
+    ce_f32 du;
+    ce_f32 dv;
+    ce_u32 a;
+    ce_bool solid;
+
+    target = canvas->target;
+    x0     = (ce_s32)ceilf(s->x - 0.5f);
+    y0     = (ce_s32)ceilf(s->y - 0.5f);
+    x1     = (ce_s32)ceilf((s->x + s->w) - 0.5f);
+    y1     = (ce_s32)ceilf((s->y + s->h) - 0.5f);
+    x0     = (x0 < clip->x0) ? clip->x0 : x0;
+    y0     = (y0 < clip->y0) ? clip->y0 : y0;
+    x1     = (x1 > clip->x1) ? clip->x1 : x1;
+    y1     = (y1 > clip->y1) ? clip->y1 : y1;
+    if ((x0 >= x1) || (y0 >= y1) || (s->w <= 0.0f) || (s->h <= 0.0f)) {
+        return;
+    }
+
+    du    = (s->u1 - s->u0) / s->w;
+    dv    = (s->v1 - s->v0) / s->h;
+    solid = ((s->texture == CE_TEXTURE_NONE) || (s->texture > canvas->image_count)) ? CE_TRUE : CE_FALSE;
+
+    for (py = y0; py < y1; py++) {
+        row = &target->color[(ce_size)py * target->stride];
+        v   = s->v0 + ((((ce_f32)py + 0.5f) - s->y) * dv);
+        for (px = x0; px < x1; px++) {
+            if (solid == CE_TRUE) {
+                src = s->color;
+            } else {
+                u   = s->u0 + ((((ce_f32)px + 0.5f) - s->x) * du);
+                src = ce__sw_sample(canvas, s, u, v);
+            }
+            a = CE_COLOR_A(src);
+            if (a == 255u) {
+                row[px] = src;
+            } else if (a != 0u) {
+                dst     = row[px];
+                row[px] = CE_RGBA(ce__sw_blend_channel(CE_COLOR_R(src), CE_COLOR_R(dst), a),
+                                  ce__sw_blend_channel(CE_COLOR_G(src), CE_COLOR_G(dst), a),
+                                  ce__sw_blend_channel(CE_COLOR_B(src), CE_COLOR_B(dst), a),
+                                  a + (((ce_u32)CE_COLOR_A(dst) * (255u - a)) / 255u));
+            } else {
+                /* Fully transparent: keep the destination. */
+            }
+        }
+    }
+}
+
+const ce_dirty_region* ce_sw_canvas_render(ce_sw_canvas* canvas, const ce_sprite_batch* batch)
+{
+    ce_sw_target* target;
+    const ce_sprite* sprites;
+    const ce_sprite* s;
+    const ce_u32* visible;
+    ce_u64* keys;
+    ce_recti* rects;
+    ce_recti r;
+    ce_color* row;
+    ce_u32 count;
+    ce_u32 old_count;
+    ce_u32 slots;
+    ce_u32 i;
+    ce_u32 k;
+    ce_s32 x;
+    ce_s32 y;
+    ce_u64 key;
+
+    target  = canvas->target;
+    sprites = ce_sprite_batch_sprites(batch);
+    visible = ce_sprite_batch_visible(batch, &count);
+
+    canvas->dirty = canvas->pending;
+    ce_dirty_reset(&canvas->pending, target->width, target->height);
+    if ((canvas->dirty.width != (ce_s32)target->width) || (canvas->dirty.height != (ce_s32)target->height)) {
+        ce_dirty_reset(&canvas->dirty, target->width, target->height);
+        canvas->full = CE_TRUE;
+    }
+    if (canvas->full == CE_TRUE) {
+        ce_dirty_add_all(&canvas->dirty);
+        canvas->full = CE_FALSE;
+    }
+
+    /* 1. Diff draw slots against the previous frame. */
+    old_count = (ce_u32)canvas->keys.count;
+    slots     = (count > old_count) ? count : old_count;
+    if ((ce_dynarray_resize(&canvas->keys, (ce_size)slots) != CE_OK) ||
+        (ce_dynarray_resize(&canvas->rects, (ce_size)slots) != CE_OK)) {
+        /* No history: redraw everything and start over next frame. */
+        ce_dirty_add_all(&canvas->dirty);
+        canvas->full = CE_TRUE;
+        slots        = 0u;
+    }
+    keys  = (ce_u64*)canvas->keys.data;
+    rects = (ce_recti*)canvas->rects.data;
+
+    for (i = 0u; i < slots; i++) {
+        if (i < count) {
+            s   = &sprites[visible[i]];
+            key = ce_hash_bytes(s, sizeof(*s));
+            r   = ce__sw_rect_bounds(s->x, s->y, s->w, s->h);
+            if ((i >= old_count) || (keys[i] != key)) {
+                if (i < old_count) {
+                    ce_dirty_add(&canvas->dirty, &rects[i]);
+                }
+                ce_dirty_add(&canvas->dirty, &r);
+            }
+            keys[i]  = key;
+            rects[i] = r;
+        } else {
+            ce_dirty_add(&canvas->dirty, &rects[i]);
+        }
+    }
+    if (slots != 0u) {
+        (void)ce_dynarray_resize(&canvas->keys, (ce_size)count);
+        (void)ce_dynarray_resize(&canvas->rects, (ce_size)count);
+    }
+
+    /* 2. Clear and re-raster every sprite touching each dirty rectangle, in draw order. */
+    for (k = 0u; k < canvas->dirty.count; k++) {
+        r = canvas->dirty.rects[k];
+        for (y = r.y0; y < r.y1; y++) {
+            row = &target->color[(ce_size)y * target->stride];
+            for (x = r.x0; x < r.x1; x++) {
+                row[x] = canvas->clear_color;
+            }
+        }
+        for (i = 0u; i < count; i++) {
+            ce__sw_draw_sprite(canvas, &sprites[visible[i]], &r);
+        }
+    }
+
+    canvas->pixels_redrawn = ce_dirty_area(&canvas->dirty);
+
+    return &canvas->dirty;
+}
@@ -9,8 +9,947 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_sw_raster.c
- * @brief Implementation skeleton.
+ * @brief Software rasterizer: SoA transform, clipping, hierarchical-Z tiles.
+ *
+ * Pipeline per draw:
+ *  1. positions go through ce_mat4f_transform_points_soa, then an 8-wide
+ *     pass projects them and computes frustum outcodes;
+ *  2. triangles fully outside one plane are dropped, triangles crossing a
+ *     plane are clipped in homogeneous space (Sutherland-Hodgman) and fanned;
+ *  3. each triangle walks its 8x8 tiles: a tile whose farthest depth is
+ *     already nearer than the triangle is skipped, otherwise every tile row
+ *     is one ce_f32x8 edge / depth test.
+ *
+ * The transform and projection passes dispatch on the CPU (chaos_defs.h);
+ * every variant produces the same bits, so coverage never depends on it.
  */
-#include "gfx/chaos_device.h"
+#include "gfx/chaos_sw_raster.h"
+#include "core/chaos_defs.h"
+#include "core/chaos_simd.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#include <math.h>
+#if defined(CE_CPU_DISPATCH_X64)
+#include <immintrin.h>
+#endif
+
+/** @brief Initial scratch size; grows on demand for bigger meshes. */
+#define CE_SW_SCRATCH_MIN (1024u * 1024u)
+/** @brief Largest polygon Sutherland-Hodgman can produce from a triangle. */
+#define CE_SW_CLIP_MAX_VERTS 12u
+
+#define CE_SW_OUT_LEFT   0x01u
+#define CE_SW_OUT_RIGHT  0x02u
+#define CE_SW_OUT_BOTTOM 0x04u
+#define CE_SW_OUT_TOP    0x08u
+#define CE_SW_OUT_NEAR   0x10u
+#define CE_SW_OUT_FAR    0x20u
+
+/** @brief Clip-space vertex carried through polygon clipping. */
+typedef struct ce__sw_cvert_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+    ce_f32 w;
+    ce_f32 c[4];
+} ce__sw_cvert;
+
+/** @brief Screen-space vertex (pixels, depth in [0, 1], color 0..255). */
+typedef struct ce__sw_svert_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+    ce_f32 c[4];
+} ce__sw_svert;
+
+/** @brief Per-draw constants shared by every triangle. */
+typedef struct ce__sw_draw_s {
+    ce_sw_target* target;
+    ce_f32        half_w;
+    ce_f32        half_h;
+    ce_sw_cull    cull;
+    ce_f32        tint[4];
+} ce__sw_draw;
+
+/* ************************************************************************** */
+/* TARGET                                                                     */
+/* ************************************************************************** */
+
+ce_result ce_sw_target_init(ce_sw_target* target, ce_u32 width, ce_u32 height)
+{
+    ce_result res;
+    ce_size pixels;
+
+    res = CE_OK;
+
+    if ((target == CE_NULL) || (width == 0u) || (height == 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        (void)ce__memset(target, 0u, sizeof(*target));
+        target->width   = width;
+        target->height  = height;
+        target->stride  = CE_ALIGN_UP(width, CE_SW_TILE);
+        target->tiles_x = target->stride / CE_SW_TILE;
+        target->tiles_y = CE_ALIGN_UP(height, CE_SW_TILE) / CE_SW_TILE;
+
+        /* Storage is padded to whole tiles so a tile row is always 8 loadable lanes. */
+        pixels        = (ce_size)target->stride * (ce_size)(target->tiles_y * CE_SW_TILE);
+        target->color = (ce_color*)ce_mem_alloc(pixels * sizeof(ce_color), (ce_size)64, CE_MEM_TAG_GFX);
+        target->depth = (ce_f32*)ce_mem_alloc(pixels * sizeof(ce_f32), (ce_size)64, CE_MEM_TAG_GFX);
+        target->hiz   = (ce_f32*)ce_mem_alloc((ce_size)target->tiles_x * (ce_size)target->tiles_y * sizeof(ce_f32),
+                                              (ce_size)64, CE_MEM_TAG_GFX);
+        res = ce_arena_init(&target->scratch, (ce_size)CE_SW_SCRATCH_MIN, CE_MEM_TAG_GFX);
+
+        if ((target->color == CE_NULL) || (target->depth == CE_NULL) || (target->hiz == CE_NULL) || (res != CE_OK)) {
+            ce_sw_target_shutdown(target);
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            ce_sw_target_clear(target, CE_COLOR_BLACK, 1.0f);
+        }
+    }
+
+    return res;
+}
+
+void ce_sw_target_shutdown(ce_sw_target* target)
+{
+    if (target != CE_NULL) {
+        ce_mem_free(target->color);
+        ce_mem_free(target->depth);
+        ce_mem_free(target->hiz);
+        ce_arena_shutdown(&target->scratch);
+        (void)ce__memset(target, 0u, sizeof(*target));
+    }
+}
+
+void ce_sw_target_clear(ce_sw_target* target, ce_color color, ce_f32 depth)
+{
+    ce_size pixels;
+    ce_size tiles;
+    ce_size i;
+    ce_f32x8 d;
+
+    pixels = (ce_size)target->stride * (ce_size)(target->tiles_y * CE_SW_TILE);
+    tiles  = (ce_size)target->tiles_x * (ce_size)target->tiles_y;
+    d      = ce_f32x8_set1(depth);
+
+    for (i = (ce_size)0; i < pixels; i += (ce_size)8) {
+        ce_f32x8_store(&target->depth[i], d);
+    }
+    for (i = (ce_size)0; i < pixels; i++) {
+        target->color[i] = color;
+    }
+    for (i = (ce_size)0; i < tiles; i++) {
+        target->hiz[i] = depth;
+    }
+}
+
+void ce_sw_target_reset_stats(ce_sw_target* target)
+{
+    (void)ce__memset(&target->stats, 0u, sizeof(target->stats));
+}
+
+/* ************************************************************************** */
+/* TRIANGLE SETUP / TILE LOOP                                                 */
+/* ************************************************************************** */
+
+static inline ce_f32 ce__sw_min3(ce_f32 a, ce_f32 b, ce_f32 c)
+{
+    ce_f32 m;
+
+    m = (a < b) ? a : b;
+    return (m < c) ? m : c;
+}
+
+static inline ce_f32 ce__sw_max3(ce_f32 a, ce_f32 b, ce_f32 c)
+{
+    ce_f32 m;
+
+    m = (a > b) ? a : b;
+    return (m > c) ? m : c;
+}
+
+static inline ce_u32 ce__sw_channel(ce_f32 v)
+{
+    ce_f32 c;
+
+    c = (v < 0.0f) ? 0.0f : ((v > 255.0f) ? 255.0f : v);
+    return (ce_u32)(c + 0.5f);
+}
+
+static inline ce_color ce__sw_pack(const ce_f32 c[4])
+{
+    return (ce_color)CE_RGBA(ce__sw_channel(c[0]), ce__sw_channel(c[1]), ce__sw_channel(c[2]), ce__sw_channel(c[3]));
+}
+
+/**
+ * @brief Recomputes the farthest depth of one tile (valid pixels only).
+ */
+static void ce__sw_update_hiz(ce_sw_target* target, ce_u32 tx, ce_u32 ty, ce_u32 rows, ce_u32 cols)
+{
+    const ce_f32* row;
+    ce_f32x8 m;
+    ce_f32 lanes[8];
+    ce_f32 z;
+    ce_u32 r;
+
+    row = &target->depth[((ce_size)ty * CE_SW_TILE * target->stride) + ((ce_size)tx * CE_SW_TILE)];
+    m   = ce_f32x8_load(row);
+    for (r = 1u; r < rows; r++) {
+        m = ce_f32x8_max(m, ce_f32x8_load(row + ((ce_size)r * target->stride)));
+    }
+    ce_f32x8_store(lanes, m);
+
+    z = lanes[0];
+    for (r = 1u; r < cols; r++) {
+        z = (lanes[r] > z) ? lanes[r] : z;
+    }
+    target->hiz[(ty * target->tiles_x) + tx] = z;
+}
+
+/**
+ * @brief Rasterizes one screen-space triangle into the target.
+ */
+static void ce__sw_raster_tri(const ce__sw_draw* draw, const ce__sw_svert* v0, const ce__sw_svert* v1,
+                              const ce__sw_svert* v2)
+{
+    static const ce_f32 lane_index[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    ce_sw_target* target;
+    const ce__sw_svert* a;
+    const ce__sw_svert* b;
+    const ce__sw_svert* c;
+    const ce__sw_svert* tmp;
+    ce_f32 area;
+    ce_f32 inv_area;
+    ce_f32 ea[3];
+    ce_f32 eb[3];
+    ce_f32 ec[3];
+    ce_f32x8 e_lane[3];
+    ce_f32x8 e_tl[3];
+    ce_f32 za;
+    ce_f32 zb;
+    ce_f32 zc;
+    ce_f32x8 z_lane;
+    ce_f32 ca[4];
+    ce_f32 cb[4];
+    ce_f32 cc[4];
+    ce_f32 flat[4];
+    ce_bool is_flat;
+    ce_color flat_color;
+    ce_f32 z_min;
+    ce_s32 x_min;
+    ce_s32 x_max;
+    ce_s32 y_min;
+    ce_s32 y_max;
+    ce_u32 tx;
+    ce_u32 ty;
+    ce_u32 tile;
+    ce_u32 r;
+    ce_u32 r_begin;
+    ce_u32 r_end;
+    ce_u32 cols;
+    ce_u32 rows;
+    ce_u32 i;
+    ce_u32 k;
+    ce_u32 bits;
+    ce_u32 lane;
+    ce_u32 written;
+    ce_f32 px;
+    ce_f32 py;
+    ce_f32 cx;
+    ce_f32 cy;
+    ce_f32 e_max;
+    ce_bool reject;
+    ce_f32x8 zero;
+    ce_f32x8 ev;
+    ce_f32x8 in;
+    ce_f32x8 zv;
+    ce_f32x8 dv;
+    ce_f32x8 pass;
+    ce_f32x8 col_mask;
+    ce_f32* depth_row;
+    ce_color* color_row;
+    ce_f32 pc[4];
+
+    target = draw->target;
+    zero   = ce_f32x8_set1(0.0f);
+    a      = v0;
+    b      = v1;
+    c      = v2;
+
+    /* Screen y points down, so counter-clockwise (front) triangles have negative area here. */
+    area = ((b->x - a->x) * (c->y - a->y)) - ((c->x - a->x) * (b->y - a->y));
+    if ((area == 0.0f) || ((area > 0.0f) && (draw->cull == CE_SW_CULL_BACK))) {
+        target->stats.triangles_culled++;
+        return;
+    }
+    if (area < 0.0f) {
+        tmp  = b;
+        b    = c;
+        c    = tmp;
+        area = -area;
+    }
+
+    x_min = (ce_s32)floorf(ce__sw_min3(a->x, b->x, c->x));
+    x_max = (ce_s32)ceilf(ce__sw_max3(a->x, b->x, c->x));
+    y_min = (ce_s32)floorf(ce__sw_min3(a->y, b->y, c->y));
+    y_max = (ce_s32)ceilf(ce__sw_max3(a->y, b->y, c->y));
+    x_min = (x_min < 0) ? 0 : x_min;
+    y_min = (y_min < 0) ? 0 : y_min;
+    x_max = (x_max >= (ce_s32)target->width) ? ((ce_s32)target->width - 1) : x_max;
+    y_max = (y_max >= (ce_s32)target->height) ? ((ce_s32)target->height - 1) : y_max;
+    if ((x_min > x_max) || (y_min > y_max)) {
+        target->stats.triangles_culled++;
+        return;
+    }
+
+    target->stats.triangles_rasterized++;
+
+    /* Edge k is opposite vertex k: E(x, y) = ea*x + eb*y + ec, positive inside. */
+    {
+        const ce__sw_svert* p[3];
+        const ce__sw_svert* q[3];
+        ce_f32 dx;
+        ce_f32 dy;
+        ce_bool top_left;
+
+        p[0] = b; q[0] = c;
+        p[1] = c; q[1] = a;
+        p[2] = a; q[2] = b;
+        for (k = 0u; k < 3u; k++) {
+            dx    = q[k]->x - p[k]->x;
+            dy    = q[k]->y - p[k]->y;
+            ea[k] = -dy;
+            eb[k] = dx;
+            ec[k] = (dy * p[k]->x) - (dx * p[k]->y);
+            /* Top-left fill rule: pixels exactly on a top or left edge belong to the triangle. */
+            top_left  = ((dy < 0.0f) || ((dy == 0.0f) && (dx > 0.0f))) ? CE_TRUE : CE_FALSE;
+            e_lane[k] = ce_f32x8_mul(ce_f32x8_load(lane_index), ce_f32x8_set1(ea[k]));
+            e_tl[k]   = (top_left == CE_TRUE) ? ce_f32x8_cmple(zero, zero) : ce_f32x8_cmplt(zero, zero);
+        }
+    }
+
+    /* Attribute planes from barycentrics: attr = a + w1 * (b - a) + w2 * (c - a). */
+    inv_area = 1.0f / area;
+    za       = ((ea[1] * (b->z - a->z)) + (ea[2] * (c->z - a->z))) * inv_area;
+    zb       = ((eb[1] * (b->z - a->z)) + (eb[2] * (c->z - a->z))) * inv_area;
+    zc       = a->z + (((ec[1] * (b->z - a->z)) + (ec[2] * (c->z - a->z))) * inv_area);
+    z_lane   = ce_f32x8_mul(ce_f32x8_load(lane_index), ce_f32x8_set1(za));
+    z_min    = ce__sw_min3(a->z, b->z, c->z);
+
+    is_flat = CE_TRUE;
+    for (k = 0u; k < 4u; k++) {
+        ca[k]   = ((ea[1] * (b->c[k] - a->c[k])) + (ea[2] * (c->c[k] - a->c[k]))) * inv_area;
+        cb[k]   = ((eb[1] * (b->c[k] - a->c[k])) + (eb[2] * (c->c[k] - a->c[k]))) * inv_area;
+        cc[k]   = a->c[k] + (((ec[1] * (b->c[k] - a->c[k])) + (ec[2] * (c->c[k] - a->c[k]))) * inv_area);
+        flat[k] = a->c[k];
+        if ((a->c[k] != b->c[k]) || (a->c[k] != c->c[k])) {
+            is_flat = CE_FALSE;
+        }
+    }
+    flat_color = ce__sw_pack(flat);
+
+    for (ty = (ce_u32)y_min / CE_SW_TILE; ty <= (ce_u32)y_max / CE_SW_TILE; ty++) {
+        r_begin = ((ce_u32)y_min > (ty * CE_SW_TILE)) ? ((ce_u32)y_min - (ty * CE_SW_TILE)) : 0u;
+        r_end   = (((ce_u32)y_max - (ty * CE_SW_TILE)) < CE_SW_TILE) ? ((ce_u32)y_max - (ty * CE_SW_TILE) + 1u)
+                                                                      : CE_SW_TILE;
+        rows    = ((target->height - (ty * CE_SW_TILE)) < CE_SW_TILE) ? (target->height - (ty * CE_SW_TILE))
+                                                                      : CE_SW_TILE;
+
+        for (tx = (ce_u32)x_min / CE_SW_TILE; tx <= (ce_u32)x_max / CE_SW_TILE; tx++) {
+            tile = (ty * target->tiles_x) + tx;
+            target->stats.tiles_tested++;
+
+            if (z_min >= target->hiz[tile]) {
+                target->stats.tiles_hiz_rejected++;
+                continue;
+            }
+
+            /* Tile vs edge: if the best pixel center of the tile is outside one edge, skip it. */
+            reject = CE_FALSE;
+            for (k = 0u; k < 3u; k++) {
+                cx    = (ce_f32)(tx * CE_SW_TILE) + ((ea[k] > 0.0f) ? 7.5f : 0.5f);
+                cy    = (ce_f32)(ty * CE_SW_TILE) + ((eb[k] > 0.0f) ? 7.5f : 0.5f);
+                e_max = (ea[k] * cx) + (eb[k] * cy) + ec[k];
+                if (e_max < 0.0f) {
+                    reject = CE_TRUE;
+                }
+            }
+            if (reject == CE_TRUE) {
+                continue;
+            }
+
+            cols     = ((target->width - (tx * CE_SW_TILE)) < CE_SW_TILE) ? (target->width - (tx * CE_SW_TILE))
+                                                                         : CE_SW_TILE;
+            col_mask = ce_f32x8_cmplt(ce_f32x8_load(lane_index), ce_f32x8_set1((ce_f32)cols));
+            px       = (ce_f32)(tx * CE_SW_TILE) + 0.5f;
+            written  = 0u;
+
+            for (r = r_begin; r < r_end; r++) {
+                py = (ce_f32)((ty * CE_SW_TILE) + r) + 0.5f;
+                in = col_mask;
+                for (k = 0u; k < 3u; k++) {
+                    ev = ce_f32x8_add(ce_f32x8_set1((ea[k] * px) + (eb[k] * py) + ec[k]), e_lane[k]);
+                    /* E >= 0 on top-left edges, E > 0 on the others. */
+                    in = ce_f32x8_and(in, ce_f32x8_select(e_tl[k], ce_f32x8_cmpge(ev, zero), ce_f32x8_cmpgt(ev, zero)));
+                }
+                if (ce_f32x8_movemask(in) == 0u) {
+                    continue;
+                }
+
+                depth_row = &target->depth[((ce_size)((ty * CE_SW_TILE) + r) * target->stride) + ((ce_size)tx * CE_SW_TILE)];
+                color_row = &target->color[((ce_size)((ty * CE_SW_TILE) + r) * target->stride) + ((ce_size)tx * CE_SW_TILE)];
+                zv        = ce_f32x8_add(ce_f32x8_set1((za * px) + (zb * py) + zc), z_lane);
+                dv        = ce_f32x8_load(depth_row);
+                pass      = ce_f32x8_and(in, ce_f32x8_cmplt(zv, dv));
+                bits      = ce_f32x8_movemask(pass);
+                if (bits == 0u) {
+                    continue;
+                }
+
+                ce_f32x8_store(depth_row, ce_f32x8_select(pass, zv, dv));
+                for (lane = 0u; lane < 8u; lane++) {
+                    if (((bits >> lane) & 1u) != 0u) {
+                        if (is_flat == CE_TRUE) {
+                            color_row[lane] = flat_color;
+                        } else {
+                            cx = px + (ce_f32)lane;
+                            for (i = 0u; i < 4u; i++) {
+                                pc[i] = (ca[i] * cx) + (cb[i] * py) + cc[i];
+                            }
+                            color_row[lane] = ce__sw_pack(pc);
+                        }
+                        written++;
+                    }
+                }
+            }
+
+            if (written != 0u) {
+                target->stats.pixels_written += written;
+                ce__sw_update_hiz(target, tx, ty, rows, cols);
+            }
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* CLIPPING                                                                   */
+/* ************************************************************************** */
+
+static inline ce_f32 ce__sw_plane_dist(const ce__sw_cvert* v, ce_u32 plane)
+{
+    ce_f32 d;
+
+    switch (plane) {
+        case 0u:  d = v->w + v->x; break;
+        case 1u:  d = v->w - v->x; break;
+        case 2u:  d = v->w + v->y; break;
+        case 3u:  d = v->w - v->y; break;
+        case 4u:  d = v->w + v->z; break;
+        default:  d = v->w - v->z; break;
+    }
+
+    return d;
+}
+
+static void ce__sw_project(const ce__sw_draw* draw, const ce__sw_cvert* in, ce__sw_svert* out)
+{
+    ce_f32 inv_w;
+    ce_u32 k;
+
+    inv_w  = 1.0f / ((in->w > 1e-7f) ? in->w : 1e-7f);
+    out->x = ((in->x * inv_w) + 1.0f) * draw->half_w;
+    out->y = (1.0f - (in->y * inv_w)) * draw->half_h;
+    out->z = (in->z * inv_w * 0.5f) + 0.5f;
+    for (k = 0u; k < 4u; k++) {
+        out->c[k] = in->c[k];
+    }
+}
+
+/**
+ * @brief Clips a triangle against the planes in `planes` and rasterizes the fan.
+ */
+static void ce__sw_clip_tri(const ce__sw_draw* draw, const ce__sw_cvert tri[3], ce_u32 planes)
+{
+    ce__sw_cvert buf[2][CE_SW_CLIP_MAX_VERTS];
+    ce__sw_svert screen[CE_SW_CLIP_MAX_VERTS];
+    const ce__sw_cvert* cur;
+    const ce__sw_cvert* nxt;
+    ce__sw_cvert* out;
+    ce_u32 src;
+    ce_u32 count;
+    ce_u32 out_count;
+    ce_u32 plane;
+    ce_u32 i;
+    ce_u32 k;
+    ce_f32 dc;
+    ce_f32 dn;
+    ce_f32 t;
+
+    buf[0][0] = tri[0];
+    buf[0][1] = tri[1];
+    buf[0][2] = tri[2];
+    src       = 0u;
+    count     = 3u;
+
+    for (plane = 0u; (plane < 6u) && (count >= 3u); plane++) {
+        if ((planes & (1u << plane)) == 0u) {
+            continue;
+        }
+        out       = buf[src ^ 1u];
+        out_count = 0u;
+        for (i = 0u; i < count; i++) {
+            cur = &buf[src][i];
+            nxt = &buf[src][(i + 1u) % count];
+            dc  = ce__sw_plane_dist(cur, plane);
+            dn  = ce__sw_plane_dist(nxt, plane);
+            if (dc >= 0.0f) {
+                out[out_count++] = *cur;
+            }
+            if ((dc >= 0.0f) != (dn >= 0.0f)) {
+                t                = dc / (dc - dn);
+                out[out_count].x = cur->x + (t * (nxt->x - cur->x));
+                out[out_count].y = cur->y + (t * (nxt->y - cur->y));
+                out[out_count].z = cur->z + (t * (nxt->z - cur->z));
+                out[out_count].w = cur->w + (t * (nxt->w - cur->w));
+                for (k = 0u; k < 4u; k++) {
+                    out[out_count].c[k] = cur->c[k] + (t * (nxt->c[k] - cur->c[k]));
+                }
+                out_count++;
+            }
+        }
+        src   ^= 1u;
+        count  = out_count;
+    }
+
+    if (count >= 3u) {
+        for (i = 0u; i < count; i++) {
+            ce__sw_project(draw, &buf[src][i], &screen[i]);
+        }
+        for (i = 1u; (i + 1u) < count; i++) {
+            ce__sw_raster_tri(draw, &screen[0], &screen[i], &screen[i + 1u]);
+        }
+    } else {
+        draw->target->stats.triangles_culled++;
+    }
+}
+
+/* ************************************************************************** */
+/* PROJECTION KERNELS                                                         */
+/* ************************************************************************** */
+
+/** @brief Clip space -> pixels and depth, plus frustum outcodes; `count` is a multiple of 8. */
+typedef struct ce__sw_kernels_s {
+    void (*project)(const ce_f32* cx, const ce_f32* cy, const ce_f32* cz, const ce_f32* cw, ce_f32* CE_RESTRICT sx,
+                    ce_f32* CE_RESTRICT sy, ce_f32* CE_RESTRICT sz, ce_u8* CE_RESTRICT outcode, ce_u32 count,
+                    ce_f32 half_w, ce_f32 half_h);
+} ce__sw_kernels;
+
+/* Lane i of each plane mask becomes bit `plane` of outcode[i]. */
+static inline void ce__sw_pack_outcodes(const ce_u32 masks[6], ce_u8* outcode)
+{
+    ce_u32 lane;
+
+    for (lane = 0u; lane < 8u; lane++) {
+        outcode[lane] = (ce_u8)((((masks[0] >> lane) & 1u) << 0u) | (((masks[1] >> lane) & 1u) << 1u) |
+                                (((masks[2] >> lane) & 1u) << 2u) | (((masks[3] >> lane) & 1u) << 3u) |
+                                (((masks[4] >> lane) & 1u) << 4u) | (((masks[5] >> lane) & 1u) << 5u));
+    }
+}
+
+static void ce__sw_project_f32x8(const ce_f32* cx, const ce_f32* cy, const ce_f32* cz, const ce_f32* cw,
+                                 ce_f32* CE_RESTRICT sx, ce_f32* CE_RESTRICT sy, ce_f32* CE_RESTRICT sz,
+                                 ce_u8* CE_RESTRICT outcode, ce_u32 count, ce_f32 half_w, ce_f32 half_h)
+{
+    ce_f32x8 vx;
+    ce_f32x8 vy;
+    ce_f32x8 vz;
+    ce_f32x8 vw;
+    ce_f32x8 inv_w;
+    ce_f32x8 hw;
+    ce_f32x8 hh;
+    ce_f32x8 one;
+    ce_f32x8 half;
+    ce_f32x8 zero;
+    ce_f32x8 neg_w;
+    ce_u32 masks[6];
+    ce_u32 i;
+
+    hw   = ce_f32x8_set1(half_w);
+    hh   = ce_f32x8_set1(half_h);
+    one  = ce_f32x8_set1(1.0f);
+    half = ce_f32x8_set1(0.5f);
+    zero = ce_f32x8_set1(0.0f);
+    for (i = 0u; i < count; i += 8u) {
+        vx    = ce_f32x8_load(&cx[i]);
+        vy    = ce_f32x8_load(&cy[i]);
+        vz    = ce_f32x8_load(&cz[i]);
+        vw    = ce_f32x8_load(&cw[i]);
+        neg_w = ce_f32x8_sub(zero, vw);
+        inv_w = ce_f32x8_div(one, ce_f32x8_max(vw, ce_f32x8_set1(1e-7f)));
+        ce_f32x8_store(&sx[i], ce_f32x8_mul(ce_f32x8_madd(vx, inv_w, one), hw));
+        ce_f32x8_store(&sy[i], ce_f32x8_mul(ce_f32x8_sub(one, ce_f32x8_mul(vy, inv_w)), hh));
+        ce_f32x8_store(&sz[i], ce_f32x8_madd(ce_f32x8_mul(vz, inv_w), half, half));
+
+        masks[0] = ce_f32x8_movemask(ce_f32x8_cmplt(vx, neg_w));
+        masks[1] = ce_f32x8_movemask(ce_f32x8_cmpgt(vx, vw));
+        masks[2] = ce_f32x8_movemask(ce_f32x8_cmplt(vy, neg_w));
+        masks[3] = ce_f32x8_movemask(ce_f32x8_cmpgt(vy, vw));
+        masks[4] = ce_f32x8_movemask(ce_f32x8_or(ce_f32x8_cmplt(vz, neg_w), ce_f32x8_cmple(vw, zero)));
+        masks[5] = ce_f32x8_movemask(ce_f32x8_cmpgt(vz, vw));
+        ce__sw_pack_outcodes(masks, &outcode[i]);
+    }
+}
+
+#if defined(CE_CPU_DISPATCH_X64)
+/* Same operations and order as the baseline; the SSE predicates map to their _OS forms. */
+CE_TARGET("avx")
+static void ce__sw_project_avx(const ce_f32* cx, const ce_f32* cy, const ce_f32* cz, const ce_f32* cw,
+                               ce_f32* CE_RESTRICT sx, ce_f32* CE_RESTRICT sy, ce_f32* CE_RESTRICT sz,
+                               ce_u8* CE_RESTRICT outcode, ce_u32 count, ce_f32 half_w, ce_f32 half_h)
+{
+    __m256 vx;
+    __m256 vy;
+    __m256 vz;
+    __m256 vw;
+    __m256 inv_w;
+    __m256 hw;
+    __m256 hh;
+    __m256 one;
+    __m256 half;
+    __m256 zero;
+    __m256 neg_w;
+    ce_u32 masks[6];
+    ce_u32 i;
+
+    hw   = _mm256_set1_ps(half_w);
+    hh   = _mm256_set1_ps(half_h);
+    one  = _mm256_set1_ps(1.0f);
+    half = _mm256_set1_ps(0.5f);
+    zero = _mm256_setzero_ps();
+    for (i = 0u; i < count; i += 8u) {
+        vx    = _mm256_loadu_ps(&cx[i]);
+        vy    = _mm256_loadu_ps(&cy[i]);
+        vz    = _mm256_loadu_ps(&cz[i]);
+        vw    = _mm256_loadu_ps(&cw[i]);
+        neg_w = _mm256_sub_ps(zero, vw);
+        inv_w = _mm256_div_ps(one, _mm256_max_ps(vw, _mm256_set1_ps(1e-7f)));
+        _mm256_storeu_ps(&sx[i], _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(vx, inv_w), one), hw));
+        _mm256_storeu_ps(&sy[i], _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(vy, inv_w)), hh));
+        _mm256_storeu_ps(&sz[i], _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(vz, inv_w), half), half));
+
+        masks[0] = (ce_u32)_mm256_movemask_ps(_mm256_cmp_ps(vx, neg_w, _CMP_LT_OS));
+        masks[1] = (ce_u32)_mm256_movemask_ps(_mm256_cmp_ps(vw, vx, _CMP_LT_OS));
+        masks[2] = (ce_u32)_mm256_movemask_ps(_mm256_cmp_ps(vy, neg_w, _CMP_LT_OS));
+        masks[3] = (ce_u32)_mm256_movemask_ps(_mm256_cmp_ps(vw, vy, _CMP_LT_OS));
+        masks[4] = (ce_u32)_mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(vz, neg_w, _CMP_LT_OS),
+                                                           _mm256_cmp_ps(vw, zero, _CMP_LE_OS)));
+        masks[5] = (ce_u32)_mm256_movemask_ps(_mm256_cmp_ps(vw, vz, _CMP_LT_OS));
+        ce__sw_pack_outcodes(masks, &outcode[i]);
+    }
+}
+
+static const ce__sw_kernels ce__sw_kernels_avx = { ce__sw_project_avx };
+#endif
+
+static const ce__sw_kernels ce__sw_kernels_base = { ce__sw_project_f32x8 };
+
+static const ce_cpu_variant ce__sw_variants[] = {
+#if defined(CE_CPU_DISPATCH_X64)
+    { CE_CPU_AVX, &ce__sw_kernels_avx },
+#endif
+    { 0u, &ce__sw_kernels_base },
+};
+
+static ce_cpu_dispatch ce__sw_dispatch = CE_CPU_DISPATCH_INIT(ce__sw_variants);
+
+/* ************************************************************************** */
+/* DRAW                                                                       */
+/* ************************************************************************** */
+
+/**
+ * @brief Grows the scratch arena so one draw's vertex streams fit.
+ */
+static ce_result ce__sw_reserve_scratch(ce_sw_target* target, ce_size bytes)
+{
+    ce_result res;
+    ce_size size;
+
+    res = CE_OK;
+    ce_arena_reset(&target->scratch);
+
+    if (bytes > target->scratch.size) {
+        size = target->scratch.size;
+        while (size < bytes) {
+            size *= (ce_size)2;
+        }
+        ce_arena_shutdown(&target->scratch);
+        res = ce_arena_init(&target->scratch, size, CE_MEM_TAG_GFX);
+    }
+
+    return res;
+}
+
+static inline void ce__sw_vertex_color(const ce__sw_draw* draw, const ce_sw_mesh* mesh, ce_u32 index, ce_f32 out[4])
+{
+    ce_color c;
+
+    c      = (mesh->colors != CE_NULL) ? mesh->colors[index] : CE_COLOR_WHITE;
+    out[0] = (ce_f32)CE_COLOR_R(c) * draw->tint[0];
+    out[1] = (ce_f32)CE_COLOR_G(c) * draw->tint[1];
+    out[2] = (ce_f32)CE_COLOR_B(c) * draw->tint[2];
+    out[3] = (ce_f32)CE_COLOR_A(c) * draw->tint[3];
+}
+
+ce_result ce_sw_draw_mesh(ce_sw_target* target, const ce_sw_mesh* mesh, const ce_mat4f* mvp,
+                          ce_color tint, ce_sw_cull cull)
+{
+    ce_result res;
+    ce__sw_draw draw;
+    ce_u32 padded;
+    ce_u32 full;
+    ce_size stream;
+    ce_f32* cx;
+    ce_f32* cy;
+    ce_f32* cz;
+    ce_f32* cw;
+    ce_f32* sx;
+    ce_f32* sy;
+    ce_f32* sz;
+    ce_u8* outcode;
+    ce_f32 tail[3][8];
+    const ce__sw_kernels* kernels;
+    ce_u32 i;
+    ce_u32 k;
+    ce_u32 lane;
+    ce_u32 idx[3];
+    ce_u32 oc_and;
+    ce_u32 oc_or;
+    ce__sw_svert sv[3];
+    ce__sw_cvert cv[3];
+
+    res = CE_OK;
+
+    if ((target == CE_NULL) || (mesh == CE_NULL) || (mvp == CE_NULL) || (mesh->x == CE_NULL) || (mesh->y == CE_NULL) ||
+        (mesh->z == CE_NULL) || (mesh->indices == CE_NULL) || ((mesh->index_count % 3u) != 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (mesh->vertex_count == 0u) {
+        res = CE_OK;
+    } else {
+        padded = CE_ALIGN_UP(mesh->vertex_count, 8u);
+        stream = ((ce_size)padded * sizeof(ce_f32)) + (ce_size)64;
+        res    = ce__sw_reserve_scratch(target, (stream * (ce_size)7) + (ce_size)padded + (ce_size)64);
+    }
+
+    if ((res == CE_OK) && (mesh->vertex_count != 0u)) {
+        cx      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        cy      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        cz      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        cw      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        sx      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        sy      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        sz      = (ce_f32*)ce_arena_alloc(&target->scratch, stream, (ce_size)64);
+        outcode = (ce_u8*)ce_arena_alloc(&target->scratch, (ce_size)padded, (ce_size)64);
+
+        draw.target  = target;
+        draw.half_w  = (ce_f32)target->width * 0.5f;
+        draw.half_h  = (ce_f32)target->height * 0.5f;
+        draw.cull    = cull;
+        draw.tint[0] = (ce_f32)CE_COLOR_R(tint) / 255.0f;
+        draw.tint[1] = (ce_f32)CE_COLOR_G(tint) / 255.0f;
+        draw.tint[2] = (ce_f32)CE_COLOR_B(tint) / 255.0f;
+        draw.tint[3] = (ce_f32)CE_COLOR_A(tint) / 255.0f;
+
+        /* 1. Object -> clip space, whole groups straight from the mesh, the tail through a padded copy. */
+        full = mesh->vertex_count & ~7u;
+        ce_mat4f_transform_points_soa(mvp, mesh->x, mesh->y, mesh->z, cx, cy, cz, cw, full);
+        if (full != mesh->vertex_count) {
+            for (lane = 0u; lane < 8u; lane++) {
+                i             = ((full + lane) < mesh->vertex_count) ? (full + lane) : (mesh->vertex_count - 1u);
+                tail[0][lane] = mesh->x[i];
+                tail[1][lane] = mesh->y[i];
+                tail[2][lane] = mesh->z[i];
+            }
+            ce_mat4f_transform_points_soa(mvp, tail[0], tail[1], tail[2], &cx[full], &cy[full], &cz[full], &cw[full], 8u);
+        }
+
+        /* 2. Projection + outcodes, 8 vertices at a time. */
+        kernels = (const ce__sw_kernels*)ce_cpu_dispatch_table(&ce__sw_dispatch);
+        kernels->project(cx, cy, cz, cw, sx, sy, sz, outcode, padded, draw.half_w, draw.half_h);
+
+        /* 3. Triangles: trivial reject, fast path when fully inside, clipping otherwise. */
+        for (i = 0u; i < mesh->index_count; i += 3u) {
+            target->stats.triangles_submitted++;
+            idx[0] = mesh->indices[i];
+            idx[1] = mesh->indices[i + 1u];
+            idx[2] = mesh->indices[i + 2u];
+            if ((idx[0] >= mesh->vertex_count) || (idx[1] >= mesh->vertex_count) || (idx[2] >= mesh->vertex_count)) {
+                target->stats.triangles_culled++;
+                res = CE_ERR_INVALID_ARG;
+                continue;
+            }
+
+            oc_and = (ce_u32)outcode[idx[0]] & (ce_u32)outcode[idx[1]] & (ce_u32)outcode[idx[2]];
+            oc_or  = (ce_u32)outcode[idx[0]] | (ce_u32)outcode[idx[1]] | (ce_u32)outcode[idx[2]];
+            if (oc_and != 0u) {
+                target->stats.triangles_culled++;
+            } else if (oc_or == 0u) {
+                for (k = 0u; k < 3u; k++) {
+                    sv[k].x = sx[idx[k]];
+                    sv[k].y = sy[idx[k]];
+                    sv[k].z = sz[idx[k]];
+                    ce__sw_vertex_color(&draw, mesh, idx[k], sv[k].c);
+                }
+                ce__sw_raster_tri(&draw, &sv[0], &sv[1], &sv[2]);
+            } else {
+                target->stats.triangles_clipped++;
+                for (k = 0u; k < 3u; k++) {
+                    cv[k].x = cx[idx[k]];
+                    cv[k].y = cy[idx[k]];
+                    cv[k].z = cz[idx[k]];
+                    cv[k].w = cw[idx[k]];
+                    ce__sw_vertex_color(&draw, mesh, idx[k], cv[k].c);
+                }
+                ce__sw_clip_tri(&draw, cv, oc_or);
+            }
+        }
+    }
+
+    return res;
+}
+
+/* ************************************************************************** */
+/* LINES                                                                      */
+/* ************************************************************************** */
+
+ce_result ce_sw_draw_lines(ce_sw_target* target, const ce_debug_vertex* vertices, ce_u32 count,
+                           const ce_mat4f* view_proj, ce_bool depth_test, ce_recti* out_bounds)
+{
+    ce_result res;
+    ce__sw_cvert cv[2];
+    ce__sw_svert sv[2];
+    ce__sw_draw draw;
+    ce_vec4f p;
+    ce_recti bounds;
+    ce_f32 t0;
+    ce_f32 t1;
+    ce_f32 d0;
+    ce_f32 d1;
+    ce_f32 t;
+    ce_f32 steps;
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+    ce_s32 px;
+    ce_s32 py;
+    ce_u32 i;
+    ce_u32 k;
+    ce_u32 n;
+    ce_u32 s;
+    ce_size offset;
+    ce_bool visible;
+
+    res       = CE_OK;
+    bounds.x0 = 0x7FFFFFFF;
+    bounds.y0 = 0x7FFFFFFF;
+    bounds.x1 = 0;
+    bounds.y1 = 0;
+
+    if ((target == CE_NULL) || ((vertices == CE_NULL) && (count != 0u)) || (view_proj == CE_NULL)) {
+        res   = CE_ERR_INVALID_ARG;
+        count = 0u;
+    } else {
+        draw.target = target;
+        draw.half_w = (ce_f32)target->width * 0.5f;
+        draw.half_h = (ce_f32)target->height * 0.5f;
+    }
+
+    for (i = 0u; (i + 1u) < count; i += 2u) {
+        for (k = 0u; k < 2u; k++) {
+            p       = ce_mat4f_transform(view_proj, ce_vec4f_make(vertices[i + k].x, vertices[i + k].y,
+                                                                  vertices[i + k].z, 1.0f));
+            cv[k].x = p.x;
+            cv[k].y = p.y;
+            cv[k].z = p.z;
+            cv[k].w = p.w;
+        }
+
+        /* Parametric clip of the segment against the six frustum planes. */
+        t0      = 0.0f;
+        t1      = 1.0f;
+        visible = CE_TRUE;
+        for (k = 0u; (k < 6u) && (visible == CE_TRUE); k++) {
+            d0 = ce__sw_plane_dist(&cv[0], k);
+            d1 = ce__sw_plane_dist(&cv[1], k);
+            if ((d0 < 0.0f) && (d1 < 0.0f)) {
+                visible = CE_FALSE;
+            } else if (d0 < 0.0f) {
+                t  = d0 / (d0 - d1);
+                t0 = (t > t0) ? t : t0;
+            } else if (d1 < 0.0f) {
+                t  = d0 / (d0 - d1);
+                t1 = (t < t1) ? t : t1;
+            } else {
+                /* Both inside. */
+            }
+        }
+        if ((visible == CE_FALSE) || (t0 >= t1)) {
+            continue;
+        }
+
+        for (k = 0u; k < 2u; k++) {
+            t = (k == 0u) ? t0 : t1;
+            p = ce_vec4f_make(cv[0].x + (t * (cv[1].x - cv[0].x)), cv[0].y + (t * (cv[1].y - cv[0].y)),
+                              cv[0].z + (t * (cv[1].z - cv[0].z)), cv[0].w + (t * (cv[1].w - cv[0].w)));
+            {
+                ce__sw_cvert c;
+
+                c.x = p.x;
+                c.y = p.y;
+                c.z = p.z;
+                c.w = p.w;
+                for (n = 0u; n < 4u; n++) {
+                    c.c[n] = 0.0f;
+                }
+                ce__sw_project(&draw, &c, &sv[k]);
+            }
+        }
+
+        /* DDA at one sample per pixel step along the major axis. */
+        steps = fabsf(sv[1].x - sv[0].x);
+        steps = (fabsf(sv[1].y - sv[0].y) > steps) ? fabsf(sv[1].y - sv[0].y) : steps;
+        n     = (ce_u32)steps + 1u;
+        for (s = 0u; s <= n; s++) {
+            t  = (ce_f32)s / (ce_f32)n;
+            x  = sv[0].x + (t * (sv[1].x - sv[0].x));
+            y  = sv[0].y + (t * (sv[1].y - sv[0].y));
+            z  = sv[0].z + (t * (sv[1].z - sv[0].z));
+            px = (ce_s32)floorf(x);
+            py = (ce_s32)floorf(y);
+            if ((px < 0) || (py < 0) || (px >= (ce_s32)target->width) || (py >= (ce_s32)target->height)) {
+                continue;
+            }
+            offset = ((ce_size)py * target->stride) + (ce_size)px;
+            if ((depth_test == CE_TRUE) && (z > target->depth[offset])) {
+                continue;
+            }
+            target->color[offset] = vertices[i].color;
+            bounds.x0             = (px < bounds.x0) ? px : bounds.x0;
+            bounds.y0             = (py < bounds.y0) ? py : bounds.y0;
+            bounds.x1             = ((px + 1) > bounds.x1) ? (px + 1) : bounds.x1;
+            bounds.y1             = ((py + 1) > bounds.y1) ? (py + 1) : bounds.y1;
+        }
+    }
+
+    if (out_bounds != CE_NULL) {
+        if (bounds.x1 <= bounds.x0) {
+            bounds.x0 = 0;
+            bounds.y0 = 0;
+            bounds.x1 = 0;
+            bounds.y1 = 0;
+        }
+        *out_bounds = bounds;
+    }
+
+    return res;
+}
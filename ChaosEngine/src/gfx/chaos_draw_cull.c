@@ -0,0 +1,407 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_draw_cull.c
+ * @brief SoA bounds storage and SIMD rectangle / frustum culling.
+ *
+ * Large inputs are split into chunks run through ce_jobs_parallel_for.
+ * Each chunk compacts its survivors in place at its own offset of the
+ * output array; a final serial pass slides the chunks together.
+ */
+#include "gfx/chaos_draw.h"
+#include "core/chaos_simd.h"
+#include "runtime/chaos_jobs.h"
+#include "utility/chaos_string.h"
+
+#include <math.h>
+
+/** @brief Elements per cull chunk (multiple of 8). */
+#define CE_CULL_CHUNK      2048u
+/** @brief Most chunks a single cull call is split into. */
+#define CE_CULL_MAX_CHUNKS 256u
+
+/* ************************************************************************** */
+/* SOA STORAGE                                                                */
+/* ************************************************************************** */
+
+/**
+ * @brief Grows four parallel float streams stored in one block.
+ */
+static ce_result ce__soa4_reserve(ce_f32** streams[4], ce_u32 count, ce_u32* capacity)
+{
+    ce_result res;
+    ce_f32* block;
+    ce_u32 cap;
+    ce_u32 i;
+
+    res = CE_OK;
+
+    if (count > *capacity) {
+        cap = CE_ALIGN_UP(count, 8u);
+        if (cap < (*capacity * 2u)) {
+            cap = *capacity * 2u;
+        }
+        block = (ce_f32*)ce_mem_calloc((ce_size)cap * 4u * sizeof(ce_f32), 32u, CE_MEM_TAG_GFX);
+        if (block == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            for (i = 0u; i < 4u; i++) {
+                if (*streams[i] != CE_NULL) {
+                    (void)ce__memcpy(block + ((ce_size)cap * i), *streams[i], (ce_size)*capacity * sizeof(ce_f32));
+                }
+            }
+            ce_mem_free(*streams[0]);
+            for (i = 0u; i < 4u; i++) {
+                *streams[i] = block + ((ce_size)cap * i);
+            }
+            *capacity = cap;
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_bounds2d_init(ce_bounds2d* bounds, ce_u32 capacity)
+{
+    ce_result res;
+
+    res = CE_ERR_INVALID_ARG;
+    if (bounds != CE_NULL) {
+        (void)ce__memset(bounds, 0u, sizeof(*bounds));
+        res = ce_bounds2d_resize(bounds, capacity);
+        bounds->count = 0u;
+    }
+
+    return res;
+}
+
+void ce_bounds2d_shutdown(ce_bounds2d* bounds)
+{
+    if (bounds != CE_NULL) {
+        ce_mem_free(bounds->min_x);
+        (void)ce__memset(bounds, 0u, sizeof(*bounds));
+    }
+}
+
+ce_result ce_bounds2d_resize(ce_bounds2d* bounds, ce_u32 count)
+{
+    ce_result res;
+    ce_f32** streams[4];
+
+    streams[0] = &bounds->min_x;
+    streams[1] = &bounds->min_y;
+    streams[2] = &bounds->max_x;
+    streams[3] = &bounds->max_y;
+
+    res = ce__soa4_reserve(streams, count, &bounds->capacity);
+    if (res == CE_OK) {
+        bounds->count = count;
+    }
+
+    return res;
+}
+
+ce_result ce_bounds2d_push(ce_bounds2d* bounds, ce_f32 min_x, ce_f32 min_y, ce_f32 max_x, ce_f32 max_y)
+{
+    ce_result res;
+    ce_u32 i;
+
+    i   = bounds->count;
+    res = ce_bounds2d_resize(bounds, i + 1u);
+    if (res == CE_OK) {
+        bounds->min_x[i] = min_x;
+        bounds->min_y[i] = min_y;
+        bounds->max_x[i] = max_x;
+        bounds->max_y[i] = max_y;
+    }
+
+    return res;
+}
+
+ce_result ce_bounds3d_init(ce_bounds3d* bounds, ce_u32 capacity)
+{
+    ce_result res;
+
+    res = CE_ERR_INVALID_ARG;
+    if (bounds != CE_NULL) {
+        (void)ce__memset(bounds, 0u, sizeof(*bounds));
+        res = ce_bounds3d_resize(bounds, capacity);
+        bounds->count = 0u;
+    }
+
+    return res;
+}
+
+void ce_bounds3d_shutdown(ce_bounds3d* bounds)
+{
+    if (bounds != CE_NULL) {
+        ce_mem_free(bounds->center_x);
+        (void)ce__memset(bounds, 0u, sizeof(*bounds));
+    }
+}
+
+ce_result ce_bounds3d_resize(ce_bounds3d* bounds, ce_u32 count)
+{
+    ce_result res;
+    ce_f32** streams[4];
+
+    streams[0] = &bounds->center_x;
+    streams[1] = &bounds->center_y;
+    streams[2] = &bounds->center_z;
+    streams[3] = &bounds->radius;
+
+    res = ce__soa4_reserve(streams, count, &bounds->capacity);
+    if (res == CE_OK) {
+        bounds->count = count;
+    }
+
+    return res;
+}
+
+ce_result ce_bounds3d_push(ce_bounds3d* bounds, ce_f32 cx, ce_f32 cy, ce_f32 cz, ce_f32 radius)
+{
+    ce_result res;
+    ce_u32 i;
+
+    i   = bounds->count;
+    res = ce_bounds3d_resize(bounds, i + 1u);
+    if (res == CE_OK) {
+        bounds->center_x[i] = cx;
+        bounds->center_y[i] = cy;
+        bounds->center_z[i] = cz;
+        bounds->radius[i]   = radius;
+    }
+
+    return res;
+}
+
+/* ************************************************************************** */
+/* FRUSTUM                                                                    */
+/* ************************************************************************** */
+
+void ce_frustum_from_matrix(ce_frustum* frustum, const ce_f32 m[16])
+{
+    ce_plane* p;
+    ce_f32 len;
+    ce_f32 sign;
+    ce_u32 i;
+    ce_u32 row;
+
+    /* plane = row3 +/- row{0,1,2} (Gribb/Hartmann). */
+    for (i = 0u; i < 6u; i++) {
+        p    = &frustum->planes[i];
+        row  = i >> 1;
+        sign = ((i & 1u) == 0u) ? 1.0f : -1.0f;
+        p->nx = m[3]  + (sign * m[row]);
+        p->ny = m[7]  + (sign * m[4u + row]);
+        p->nz = m[11] + (sign * m[8u + row]);
+        p->d  = m[15] + (sign * m[12u + row]);
+        len   = sqrtf((p->nx * p->nx) + (p->ny * p->ny) + (p->nz * p->nz));
+        if (len > 0.0f) {
+            len    = 1.0f / len;
+            p->nx *= len;
+            p->ny *= len;
+            p->nz *= len;
+            p->d  *= len;
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* KERNELS                                                                    */
+/* ************************************************************************** */
+
+/**
+ * @brief Lane mask for group `base`, clearing lanes at or past `count`.
+ */
+static ce_u32 ce__cull_tail_mask(ce_u32 base, ce_u32 count)
+{
+    ce_u32 left;
+
+    left = count - base;
+
+    return (left >= 8u) ? 0xFFu : ((1u << left) - 1u);
+}
+
+/**
+ * @brief Rectangle test over [begin, end) (begin multiple of 8).
+ * @return Survivors written to out[0..].
+ */
+static ce_u32 ce__cull_rect_range(const ce_bounds2d* b, const ce_rectf* view, ce_u32 begin, ce_u32 end, ce_u32* out)
+{
+    ce_f32x8 vx0;
+    ce_f32x8 vy0;
+    ce_f32x8 vx1;
+    ce_f32x8 vy1;
+    ce_f32x8 in;
+    ce_u32 i;
+    ce_u32 n;
+    ce_u32 mask;
+
+    vx0 = ce_f32x8_set1(view->x);
+    vy0 = ce_f32x8_set1(view->y);
+    vx1 = ce_f32x8_set1(view->x + view->w);
+    vy1 = ce_f32x8_set1(view->y + view->h);
+    n   = 0u;
+
+    for (i = begin; i < end; i += 8u) {
+        in = ce_f32x8_and(ce_f32x8_cmpge(ce_f32x8_load(&b->max_x[i]), vx0),
+                          ce_f32x8_cmple(ce_f32x8_load(&b->min_x[i]), vx1));
+        in = ce_f32x8_and(in, ce_f32x8_cmpge(ce_f32x8_load(&b->max_y[i]), vy0));
+        in = ce_f32x8_and(in, ce_f32x8_cmple(ce_f32x8_load(&b->min_y[i]), vy1));
+        mask = ce_f32x8_movemask(in) & ce__cull_tail_mask(i, b->count);
+        n += ce_simd_compact_indices(mask, i, &out[n]);
+    }
+
+    return n;
+}
+
+/**
+ * @brief Sphere/frustum test over [begin, end) (begin multiple of 8).
+ * @return Survivors written to out[0..].
+ */
+static ce_u32 ce__cull_frustum_range(const ce_bounds3d* b, const ce_frustum* f, ce_u32 begin, ce_u32 end, ce_u32* out)
+{
+    ce_f32x8 cx;
+    ce_f32x8 cy;
+    ce_f32x8 cz;
+    ce_f32x8 neg_r;
+    ce_f32x8 dist;
+    ce_f32x8 in;
+    const ce_plane* p;
+    ce_u32 i;
+    ce_u32 k;
+    ce_u32 n;
+    ce_u32 mask;
+
+    n = 0u;
+
+    for (i = begin; i < end; i += 8u) {
+        cx    = ce_f32x8_load(&b->center_x[i]);
+        cy    = ce_f32x8_load(&b->center_y[i]);
+        cz    = ce_f32x8_load(&b->center_z[i]);
+        neg_r = ce_f32x8_sub(ce_f32x8_set1(0.0f), ce_f32x8_load(&b->radius[i]));
+        mask  = ce__cull_tail_mask(i, b->count);
+        for (k = 0u; (k < 6u) && (mask != 0u); k++) {
+            p    = &f->planes[k];
+            dist = ce_f32x8_madd(cx, ce_f32x8_set1(p->nx), ce_f32x8_set1(p->d));
+            dist = ce_f32x8_madd(cy, ce_f32x8_set1(p->ny), dist);
+            dist = ce_f32x8_madd(cz, ce_f32x8_set1(p->nz), dist);
+            in   = ce_f32x8_cmpge(dist, neg_r);
+            mask &= ce_f32x8_movemask(in);
+        }
+        n += ce_simd_compact_indices(mask, i, &out[n]);
+    }
+
+    return n;
+}
+
+/* ************************************************************************** */
+/* PARALLEL DRIVER                                                            */
+/* ************************************************************************** */
+
+typedef struct ce_cull_job_s {
+    const ce_bounds2d* rects;
+    const ce_rectf*    view;
+    const ce_bounds3d* spheres;
+    const ce_frustum*  frustum;
+    ce_u32*            out;
+    ce_u32             count;
+    ce_u32             chunk;
+    ce_u32             survivors[CE_CULL_MAX_CHUNKS];
+} ce_cull_job;
+
+/**
+ * @brief parallel_for body: culls chunks [begin, end) into their output slots.
+ */
+static void ce__cull_chunks(void* user, ce_u32 begin, ce_u32 end)
+{
+    ce_cull_job* job;
+    ce_u32 c;
+    ce_u32 first;
+    ce_u32 last;
+
+    job = (ce_cull_job*)user;
+
+    for (c = begin; c < end; c++) {
+        first = c * job->chunk;
+        last  = first + job->chunk;
+        if (last > job->count) {
+            last = CE_ALIGN_UP(job->count, 8u);
+        }
+        if (job->rects != CE_NULL) {
+            job->survivors[c] = ce__cull_rect_range(job->rects, job->view, first, last, &job->out[first]);
+        } else {
+            job->survivors[c] = ce__cull_frustum_range(job->spheres, job->frustum, first, last, &job->out[first]);
+        }
+    }
+}
+
+/**
+ * @brief Sizes the chunks, runs them and compacts the per-chunk survivors.
+ */
+static ce_u32 ce__cull_run(ce_cull_job* job)
+{
+    ce_u32 chunks;
+    ce_u32 total;
+    ce_u32 c;
+
+    total = 0u;
+
+    if (job->count != 0u) {
+        job->chunk = CE_CULL_CHUNK;
+        chunks     = (job->count + job->chunk - 1u) / job->chunk;
+        if (chunks > CE_CULL_MAX_CHUNKS) {
+            job->chunk = CE_ALIGN_UP((job->count + CE_CULL_MAX_CHUNKS - 1u) / CE_CULL_MAX_CHUNKS, 8u);
+            chunks     = (job->count + job->chunk - 1u) / job->chunk;
+        }
+
+        ce_jobs_parallel_for(chunks, 1u, ce__cull_chunks, job);
+
+        /* Chunk c's survivors start at c * chunk >= total, so moving forward is safe. */
+        for (c = 0u; c < chunks; c++) {
+            if ((c * job->chunk) != total) {
+                (void)ce__memmove(&job->out[total], &job->out[c * job->chunk],
+                                  (ce_size)job->survivors[c] * sizeof(ce_u32));
+            }
+            total += job->survivors[c];
+        }
+    }
+
+    return total;
+}
+
+ce_u32 ce_cull_rect(const ce_bounds2d* bounds, const ce_rectf* view, ce_u32* out_indices)
+{
+    ce_cull_job job;
+
+    job.rects   = bounds;
+    job.view    = view;
+    job.spheres = CE_NULL;
+    job.frustum = CE_NULL;
+    job.out     = out_indices;
+    job.count   = bounds->count;
+
+    return ce__cull_run(&job);
+}
+
+ce_u32 ce_cull_frustum(const ce_bounds3d* bounds, const ce_frustum* frustum, ce_u32* out_indices)
+{
+    ce_cull_job job;
+
+    job.rects   = CE_NULL;
+    job.view    = CE_NULL;
+    job.spheres = bounds;
+    job.frustum = frustum;
+    job.out     = out_indices;
+    job.count   = bounds->count;
+
+    return ce__cull_run(&job);
+}
@@ -0,0 +1,472 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_draw_debug.c
+ * @brief Immediate-mode debug primitives with lock-free per-thread queues.
+ *
+ * Every emitting thread claims a slot once (atomic counter kept in a
+ * thread-local) and only ever appends to that slot's buffers. The frame-end
+ * merge walks all slots, folds in persistent primitives from earlier frames
+ * and expands everything into one line-list stream: depth-tested lines
+ * first, overlay lines after.
+ */
+#include "gfx/chaos_draw.h"
+#include "utility/chaos_string.h"
+
+#include <math.h>
+
+typedef enum ce_debug_type_e {
+    CE_DEBUG_TYPE_LINE = 0,
+    CE_DEBUG_TYPE_BOX,
+    CE_DEBUG_TYPE_CIRCLE,
+    CE_DEBUG_TYPE_TEXT
+} ce_debug_type;
+
+/** @brief 1-based slot of the calling thread (0 = not claimed yet). */
+static _Thread_local ce_u32 ce__debug_slot;
+static ce_atomic_u32 ce__debug_next_slot;
+
+/* ************************************************************************** */
+/* LIFECYCLE                                                                  */
+/* ************************************************************************** */
+
+ce_result ce_debug_draw_init(ce_debug_draw* dd)
+{
+    ce_result res;
+    ce_u32 i;
+    ce_f32 angle;
+
+    res = CE_OK;
+
+    if (dd == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        (void)ce__memset(dd, 0u, sizeof(*dd));
+        for (i = 0u; (i < 2u) && (res == CE_OK); i++) {
+            res = ce_dynarray_init(&dd->live[i], sizeof(ce_debug_prim), (ce_size)256, CE_MEM_TAG_GFX);
+            if (res == CE_OK) {
+                res = ce_dynarray_init(&dd->live_chars[i], sizeof(ce_char), (ce_size)1024, CE_MEM_TAG_GFX);
+            }
+        }
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&dd->vertices, sizeof(ce_debug_vertex), (ce_size)1024, CE_MEM_TAG_GFX);
+        }
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&dd->labels, sizeof(ce_debug_label), (ce_size)64, CE_MEM_TAG_GFX);
+        }
+
+        for (i = 0u; i < CE_DEBUG_CIRCLE_SEGMENTS; i++) {
+            angle           = (2.0f * CE_PI_F * (ce_f32)i) / (ce_f32)CE_DEBUG_CIRCLE_SEGMENTS;
+            dd->circle[i][0] = cosf(angle);
+            dd->circle[i][1] = sinf(angle);
+        }
+        ce_atomic_store_u32(&dd->enabled, 1u);
+
+        if (res != CE_OK) {
+            ce_debug_draw_shutdown(dd);
+        }
+    }
+
+    return res;
+}
+
+void ce_debug_draw_shutdown(ce_debug_draw* dd)
+{
+    ce_u32 i;
+
+    if (dd != CE_NULL) {
+        for (i = 0u; i < CE_DEBUG_DRAW_MAX_THREADS; i++) {
+            ce_dynarray_shutdown(&dd->threads[i].prims);
+            ce_dynarray_shutdown(&dd->threads[i].chars);
+        }
+        for (i = 0u; i < 2u; i++) {
+            ce_dynarray_shutdown(&dd->live[i]);
+            ce_dynarray_shutdown(&dd->live_chars[i]);
+        }
+        ce_dynarray_shutdown(&dd->vertices);
+        ce_dynarray_shutdown(&dd->labels);
+        (void)ce__memset(dd, 0u, sizeof(*dd));
+    }
+}
+
+void ce_debug_draw_set_enabled(ce_debug_draw* dd, ce_bool enabled)
+{
+    ce_atomic_store_u32(&dd->enabled, (enabled == CE_TRUE) ? 1u : 0u);
+}
+
+/* ************************************************************************** */
+/* EMISSION (ANY THREAD)                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Returns the calling thread's buffer, creating it on first use.
+ */
+static ce_debug_buffer* ce__debug_buffer(ce_debug_draw* dd)
+{
+    ce_debug_buffer* buf;
+    ce_u32 slot;
+
+    buf = CE_NULL;
+
+    if (ce__debug_slot == 0u) {
+        ce__debug_slot = ce_atomic_fetch_add_u32(&ce__debug_next_slot, 1u) + 1u;
+    }
+    slot = ce__debug_slot - 1u;
+
+    if (slot < CE_DEBUG_DRAW_MAX_THREADS) {
+        buf = &dd->threads[slot];
+        if (buf->prims.elem_size == (ce_size)0) {
+            if ((ce_dynarray_init(&buf->prims, sizeof(ce_debug_prim), (ce_size)256, CE_MEM_TAG_GFX) != CE_OK) ||
+                (ce_dynarray_init(&buf->chars, sizeof(ce_char), (ce_size)256, CE_MEM_TAG_GFX) != CE_OK)) {
+                ce_dynarray_shutdown(&buf->prims);
+                buf = CE_NULL;
+            }
+        }
+    }
+
+    return buf;
+}
+
+static void ce__debug_emit(ce_debug_draw* dd, const ce_debug_prim* prim, const ce_char* text)
+{
+    ce_debug_buffer* buf;
+    ce_debug_prim* dst;
+    ce_char* chars;
+    ce_size len;
+
+    if (ce_atomic_load_relaxed_u32(&dd->enabled) == 0u) {
+        return;
+    }
+
+    buf = ce__debug_buffer(dd);
+    dst = (buf != CE_NULL) ? (ce_debug_prim*)ce_dynarray_push(&buf->prims, prim) : CE_NULL;
+
+    if ((dst != CE_NULL) && (text != CE_NULL)) {
+        len       = ce__strlen(text);
+        dst->text = (ce_u32)buf->chars.count;
+        chars     = (ce_char*)ce_dynarray_push_n(&buf->chars, len + (ce_size)1);
+        if (chars == CE_NULL) {
+            buf->prims.count -= (ce_size)1;
+            dst               = CE_NULL;
+        } else {
+            (void)ce__memcpy(chars, text, len + (ce_size)1);
+        }
+    }
+
+    if (dst == CE_NULL) {
+        (void)ce_atomic_fetch_add_u32(&dd->dropped, 1u);
+    }
+}
+
+static inline ce_debug_prim ce__debug_prim(ce_u16 type, ce_vec3f a, ce_vec3f b, ce_f32 scalar, ce_color color,
+                                           ce_f32 lifetime, ce_u16 flags)
+{
+    ce_debug_prim p;
+
+    p.a        = a;
+    p.b        = b;
+    p.scalar   = scalar;
+    p.lifetime = (lifetime > 0.0f) ? lifetime : 0.0f;
+    p.color    = color;
+    p.type     = type;
+    p.flags    = flags;
+    p.text     = 0u;
+    return p;
+}
+
+void ce_debug_line(ce_debug_draw* dd, ce_vec3f a, ce_vec3f b, ce_color color, ce_f32 lifetime, ce_u16 flags)
+{
+    ce_debug_prim p;
+
+    p = ce__debug_prim((ce_u16)CE_DEBUG_TYPE_LINE, a, b, 0.0f, color, lifetime, flags);
+    ce__debug_emit(dd, &p, CE_NULL);
+}
+
+void ce_debug_box(ce_debug_draw* dd, ce_vec3f min, ce_vec3f max, ce_color color, ce_f32 lifetime, ce_u16 flags)
+{
+    ce_debug_prim p;
+
+    p = ce__debug_prim((ce_u16)CE_DEBUG_TYPE_BOX, min, max, 0.0f, color, lifetime, flags);
+    ce__debug_emit(dd, &p, CE_NULL);
+}
+
+void ce_debug_circle(ce_debug_draw* dd, ce_vec3f center, ce_vec3f normal, ce_f32 radius, ce_color color,
+                     ce_f32 lifetime, ce_u16 flags)
+{
+    ce_debug_prim p;
+
+    p = ce__debug_prim((ce_u16)CE_DEBUG_TYPE_CIRCLE, center, normal, radius, color, lifetime, flags);
+    ce__debug_emit(dd, &p, CE_NULL);
+}
+
+void ce_debug_text(ce_debug_draw* dd, ce_vec3f position, const ce_char* text, ce_f32 size_px, ce_color color,
+                   ce_f32 lifetime, ce_u16 flags)
+{
+    ce_debug_prim p;
+
+    if (text != CE_NULL) {
+        p = ce__debug_prim((ce_u16)CE_DEBUG_TYPE_TEXT, position, position, size_px, color, lifetime, flags);
+        ce__debug_emit(dd, &p, text);
+    }
+}
+
+/* ************************************************************************** */
+/* FRAME-END MERGE                                                            */
+/* ************************************************************************** */
+
+/**
+ * @brief Appends a primitive (and its string) to a live list.
+ */
+static ce_bool ce__debug_append(ce_dynarray* prims, ce_dynarray* chars, const ce_debug_prim* prim,
+                                const ce_char* text)
+{
+    ce_debug_prim* dst;
+    ce_char* str;
+    ce_size len;
+    ce_bool ok;
+
+    ok  = CE_FALSE;
+    dst = (ce_debug_prim*)ce_dynarray_push(prims, prim);
+
+    if (dst != CE_NULL) {
+        ok = CE_TRUE;
+        if (prim->type == (ce_u16)CE_DEBUG_TYPE_TEXT) {
+            len       = ce__strlen(text);
+            dst->text = (ce_u32)chars->count;
+            str       = (ce_char*)ce_dynarray_push_n(chars, len + (ce_size)1);
+            if (str == CE_NULL) {
+                prims->count -= (ce_size)1;
+                ok            = CE_FALSE;
+            } else {
+                (void)ce__memcpy(str, text, len + (ce_size)1);
+            }
+        }
+    }
+
+    return ok;
+}
+
+static inline void ce__debug_vertex(ce_debug_vertex* v, ce_vec3f p, ce_color color)
+{
+    v->x     = p.x;
+    v->y     = p.y;
+    v->z     = p.z;
+    v->color = color;
+}
+
+/**
+ * @brief Expands one primitive into line-list vertices.
+ * @return CE_FALSE on allocation failure.
+ */
+static ce_bool ce__debug_expand(ce_debug_draw* dd, const ce_debug_prim* p)
+{
+    static const ce_u8 box_edges[12][2] = { { 0u, 1u }, { 1u, 3u }, { 3u, 2u }, { 2u, 0u }, { 4u, 5u }, { 5u, 7u },
+                                            { 7u, 6u }, { 6u, 4u }, { 0u, 4u }, { 1u, 5u }, { 2u, 6u }, { 3u, 7u } };
+    ce_debug_vertex* v;
+    ce_vec3f corners[8];
+    ce_vec3f n;
+    ce_vec3f t;
+    ce_vec3f u;
+    ce_vec3f w;
+    ce_vec3f pts[CE_DEBUG_CIRCLE_SEGMENTS];
+    ce_u32 i;
+    ce_bool ok;
+
+    ok = CE_TRUE;
+
+    if (p->type == (ce_u16)CE_DEBUG_TYPE_LINE) {
+        v = (ce_debug_vertex*)ce_dynarray_push_n(&dd->vertices, (ce_size)2);
+        if (v != CE_NULL) {
+            ce__debug_vertex(&v[0], p->a, p->color);
+            ce__debug_vertex(&v[1], p->b, p->color);
+        }
+    } else if (p->type == (ce_u16)CE_DEBUG_TYPE_BOX) {
+        v = (ce_debug_vertex*)ce_dynarray_push_n(&dd->vertices, (ce_size)24);
+        if (v != CE_NULL) {
+            for (i = 0u; i < 8u; i++) {
+                corners[i] = ce_vec3f_make(((i & 1u) != 0u) ? p->b.x : p->a.x, ((i & 2u) != 0u) ? p->b.y : p->a.y,
+                                           ((i & 4u) != 0u) ? p->b.z : p->a.z);
+            }
+            for (i = 0u; i < 12u; i++) {
+                ce__debug_vertex(&v[i * 2u], corners[box_edges[i][0]], p->color);
+                ce__debug_vertex(&v[(i * 2u) + 1u], corners[box_edges[i][1]], p->color);
+            }
+        }
+    } else if (p->type == (ce_u16)CE_DEBUG_TYPE_CIRCLE) {
+        v = (ce_debug_vertex*)ce_dynarray_push_n(&dd->vertices, (ce_size)(CE_DEBUG_CIRCLE_SEGMENTS * 2u));
+        if (v != CE_NULL) {
+            /* Orthonormal basis (u, w) of the circle plane. */
+            n = ce_vec3f_normalize(p->b);
+            t = (fabsf(n.x) < 0.9f) ? ce_vec3f_make(1.0f, 0.0f, 0.0f) : ce_vec3f_make(0.0f, 1.0f, 0.0f);
+            u = ce_vec3f_normalize(ce_vec3f_cross(n, t));
+            w = ce_vec3f_cross(n, u);
+            for (i = 0u; i < CE_DEBUG_CIRCLE_SEGMENTS; i++) {
+                pts[i] = ce_vec3f_add(p->a, ce_vec3f_add(ce_vec3f_scale(u, dd->circle[i][0] * p->scalar),
+                                                         ce_vec3f_scale(w, dd->circle[i][1] * p->scalar)));
+            }
+            for (i = 0u; i < CE_DEBUG_CIRCLE_SEGMENTS; i++) {
+                ce__debug_vertex(&v[i * 2u], pts[i], p->color);
+                ce__debug_vertex(&v[(i * 2u) + 1u], pts[(i + 1u) % CE_DEBUG_CIRCLE_SEGMENTS], p->color);
+            }
+        }
+    } else {
+        v = CE_NULL;
+        ok = CE_TRUE;
+    }
+
+    if ((p->type != (ce_u16)CE_DEBUG_TYPE_TEXT) && (v == CE_NULL)) {
+        ok = CE_FALSE;
+    }
+
+    return ok;
+}
+
+void ce_debug_draw_end_frame(ce_debug_draw* dd, ce_f32 dt)
+{
+    ce_dynarray* cur;
+    ce_dynarray* cur_chars;
+    ce_dynarray* next;
+    ce_dynarray* next_chars;
+    ce_debug_buffer* buf;
+    ce_debug_prim* prims;
+    ce_debug_prim prim;
+    ce_debug_label* label;
+    const ce_char* chars;
+    ce_u32 slots;
+    ce_u32 pass;
+    ce_u32 i;
+    ce_u32 k;
+    ce_u32 lost;
+
+    cur        = &dd->live[dd->live_index];
+    cur_chars  = &dd->live_chars[dd->live_index];
+    next       = &dd->live[dd->live_index ^ 1u];
+    next_chars = &dd->live_chars[dd->live_index ^ 1u];
+    lost       = 0u;
+
+    /* 1. Fold every thread queue into the live list (persistent survivors are already there). */
+    slots = ce_atomic_load_u32(&ce__debug_next_slot);
+    slots = (slots < CE_DEBUG_DRAW_MAX_THREADS) ? slots : CE_DEBUG_DRAW_MAX_THREADS;
+    for (k = 0u; k < slots; k++) {
+        buf = &dd->threads[k];
+        if (buf->prims.elem_size == (ce_size)0) {
+            continue;
+        }
+        prims = (ce_debug_prim*)buf->prims.data;
+        chars = (const ce_char*)buf->chars.data;
+        for (i = 0u; i < (ce_u32)buf->prims.count; i++) {
+            if (ce__debug_append(cur, cur_chars, &prims[i], &chars[prims[i].text]) == CE_FALSE) {
+                lost++;
+            }
+        }
+        ce_dynarray_clear(&buf->prims);
+        ce_dynarray_clear(&buf->chars);
+    }
+
+    /* 2. One vertex stream: depth-tested pass, then overlay pass; labels alongside. */
+    ce_dynarray_clear(&dd->vertices);
+    ce_dynarray_clear(&dd->labels);
+    prims = (ce_debug_prim*)cur->data;
+    chars = (const ce_char*)cur_chars->data;
+    for (pass = 0u; pass < 2u; pass++) {
+        for (i = 0u; i < (ce_u32)cur->count; i++) {
+            if ((((prims[i].flags & CE_DEBUG_FLAG_NO_DEPTH) != 0u) ? 1u : 0u) != pass) {
+                continue;
+            }
+            if (prims[i].type == (ce_u16)CE_DEBUG_TYPE_TEXT) {
+                label = (ce_debug_label*)ce_dynarray_push(&dd->labels, CE_NULL);
+                if (label != CE_NULL) {
+                    label->position = prims[i].a;
+                    label->size_px  = prims[i].scalar;
+                    label->color    = prims[i].color;
+                    label->flags    = prims[i].flags;
+                    label->text     = &chars[prims[i].text];
+                } else {
+                    lost++;
+                }
+            } else if (ce__debug_expand(dd, &prims[i]) == CE_FALSE) {
+                lost++;
+            } else {
+                /* Expanded. */
+            }
+        }
+        if (pass == 0u) {
+            dd->depth_vertex_count = (ce_u32)dd->vertices.count;
+        }
+    }
+
+    /* 3. Age primitives; survivors move to the other live list (labels keep pointing at this one). */
+    ce_dynarray_clear(next);
+    ce_dynarray_clear(next_chars);
+    for (i = 0u; i < (ce_u32)cur->count; i++) {
+        if (prims[i].lifetime > dt) {
+            prim          = prims[i];
+            prim.lifetime = prims[i].lifetime - dt;
+            if (ce__debug_append(next, next_chars, &prim, &chars[prims[i].text]) == CE_FALSE) {
+                lost++;
+            }
+        }
+    }
+    ce_dynarray_clear(cur);
+    dd->live_index ^= 1u;
+
+    if (lost != 0u) {
+        (void)ce_atomic_fetch_add_u32(&dd->dropped, lost);
+    }
+}
+
+const ce_debug_vertex* ce_debug_draw_vertices(const ce_debug_draw* dd, ce_u32* count, ce_u32* depth_count)
+{
+    *count = (ce_u32)dd->vertices.count;
+    if (depth_count != CE_NULL) {
+        *depth_count = dd->depth_vertex_count;
+    }
+
+    return (const ce_debug_vertex*)dd->vertices.data;
+}
+
+const ce_debug_label* ce_debug_draw_labels(const ce_debug_draw* dd, ce_u32* count)
+{
+    *count = (ce_u32)dd->labels.count;
+
+    return (const ce_debug_label*)dd->labels.data;
+}
+
+ce_result ce_debug_draw_emit_labels(const ce_debug_draw* dd, ce_sprite_batch* batch, ce_text_cache* cache,
+                                    const ce_mat4f* view_proj, ce_u32 width, ce_u32 height, ce_u16 layer)
+{
+    ce_result res;
+    ce_result r;
+    const ce_debug_label* labels;
+    ce_vec4f clip;
+    ce_u32 count;
+    ce_u32 i;
+    ce_f32 sx;
+    ce_f32 sy;
+
+    res    = CE_OK;
+    labels = ce_debug_draw_labels(dd, &count);
+
+    for (i = 0u; i < count; i++) {
+        clip = ce_mat4f_transform(view_proj, ce_vec4f_make(labels[i].position.x, labels[i].position.y,
+                                                           labels[i].position.z, 1.0f));
+        if ((clip.w <= 0.0f) || (clip.x < -clip.w) || (clip.x > clip.w) || (clip.y < -clip.w) || (clip.y > clip.w)) {
+            continue;
+        }
+        sx = ((clip.x / clip.w) + 1.0f) * 0.5f * (ce_f32)width;
+        sy = (1.0f - (clip.y / clip.w)) * 0.5f * (ce_f32)height;
+        r  = ce_draw_text(batch, cache, labels[i].text, sx, sy, labels[i].size_px, labels[i].color, layer);
+        if ((r != CE_OK) && (res == CE_OK)) {
+            res = r;
+        }
+    }
+
+    return res;
+}
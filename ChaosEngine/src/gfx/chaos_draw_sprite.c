@@ -0,0 +1,190 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_draw_sprite.c
+ * @brief Sprite batch storage, culling and submission ordering.
+ */
+#include "gfx/chaos_draw.h"
+
+/**
+ * @brief Sort record: 48-bit (layer, texture) key and sprite index.
+ */
+typedef struct ce_sprite_sort_key_s {
+    ce_u64 key;
+    ce_u32 index;
+    ce_u32 pad;
+} ce_sprite_sort_key;
+
+ce_result ce_sprite_batch_init(ce_sprite_batch* batch, ce_u32 initial_capacity)
+{
+    ce_result res;
+
+    res = CE_ERR_INVALID_ARG;
+    if (batch != CE_NULL) {
+        batch->visible_count = 0u;
+        res = ce_dynarray_init(&batch->sprites, sizeof(ce_sprite), (ce_size)initial_capacity, CE_MEM_TAG_GFX);
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&batch->visible, sizeof(ce_u32), (ce_size)0, CE_MEM_TAG_GFX);
+        }
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&batch->scratch, sizeof(ce_sprite_sort_key), (ce_size)0, CE_MEM_TAG_GFX);
+        }
+        if (res == CE_OK) {
+            res = ce_bounds2d_init(&batch->bounds, 0u);
+        }
+    }
+
+    return res;
+}
+
+void ce_sprite_batch_shutdown(ce_sprite_batch* batch)
+{
+    if (batch != CE_NULL) {
+        ce_dynarray_shutdown(&batch->sprites);
+        ce_dynarray_shutdown(&batch->visible);
+        ce_dynarray_shutdown(&batch->scratch);
+        ce_bounds2d_shutdown(&batch->bounds);
+        batch->visible_count = 0u;
+    }
+}
+
+void ce_sprite_batch_clear(ce_sprite_batch* batch)
+{
+    ce_dynarray_clear(&batch->sprites);
+    batch->visible_count = 0u;
+}
+
+ce_result ce_sprite_batch_push(ce_sprite_batch* batch, const ce_sprite* sprite)
+{
+    ce_result res;
+
+    res = CE_OK;
+    if (ce_dynarray_push(&batch->sprites, sprite) == CE_NULL) {
+        res = CE_ERR_OUT_OF_MEMORY;
+    }
+
+    return res;
+}
+
+ce_sprite* ce_sprite_batch_reserve(ce_sprite_batch* batch, ce_u32 count)
+{
+    return (ce_sprite*)ce_dynarray_push_n(&batch->sprites, (ce_size)count);
+}
+
+ce_u32 ce_sprite_batch_count(const ce_sprite_batch* batch)
+{
+    return (ce_u32)batch->sprites.count;
+}
+
+const ce_sprite* ce_sprite_batch_sprites(const ce_sprite_batch* batch)
+{
+    return (const ce_sprite*)batch->sprites.data;
+}
+
+ce_u32 ce_sprite_batch_cull(ce_sprite_batch* batch, const ce_rectf* view)
+{
+    const ce_sprite* sprites;
+    ce_u32* visible;
+    ce_u32 count;
+    ce_u32 i;
+
+    sprites              = (const ce_sprite*)batch->sprites.data;
+    count                = (ce_u32)batch->sprites.count;
+    batch->visible_count = 0u;
+
+    if ((ce_dynarray_resize(&batch->visible, (ce_size)CE_CULL_OUT_CAPACITY(count)) == CE_OK) &&
+        (ce_bounds2d_resize(&batch->bounds, count) == CE_OK)) {
+        visible = (ce_u32*)batch->visible.data;
+        if (view == CE_NULL) {
+            for (i = 0u; i < count; i++) {
+                visible[i] = i;
+            }
+            batch->visible_count = count;
+        } else {
+            /* AoS -> SoA so the kernel reads four dense streams. */
+            for (i = 0u; i < count; i++) {
+                batch->bounds.min_x[i] = sprites[i].x;
+                batch->bounds.min_y[i] = sprites[i].y;
+                batch->bounds.max_x[i] = sprites[i].x + sprites[i].w;
+                batch->bounds.max_y[i] = sprites[i].y + sprites[i].h;
+            }
+            batch->visible_count = ce_cull_rect(&batch->bounds, view, visible);
+        }
+    }
+
+    return batch->visible_count;
+}
+
+ce_result ce_sprite_batch_sort(ce_sprite_batch* batch)
+{
+    ce_result res;
+    const ce_sprite* sprites;
+    ce_sprite_sort_key* keys;
+    ce_sprite_sort_key* tmp;
+    ce_sprite_sort_key* swap;
+    ce_u32* visible;
+    ce_u32 hist[256];
+    ce_u32 count;
+    ce_u32 shift;
+    ce_u32 sum;
+    ce_u32 digit;
+    ce_u32 i;
+
+    count   = batch->visible_count;
+    sprites = (const ce_sprite*)batch->sprites.data;
+    visible = (ce_u32*)batch->visible.data;
+    res     = ce_dynarray_resize(&batch->scratch, (ce_size)count * (ce_size)2);
+
+    if ((res == CE_OK) && (count > 1u)) {
+        keys = (ce_sprite_sort_key*)batch->scratch.data;
+        tmp  = keys + count;
+        for (i = 0u; i < count; i++) {
+            keys[i].key   = ((ce_u64)sprites[visible[i]].layer << 32) | (ce_u64)sprites[visible[i]].texture;
+            keys[i].index = visible[i];
+        }
+
+        /* LSD radix sort, 8 bits per pass; passes where every key agrees are skipped. */
+        for (shift = 0u; shift < 48u; shift += 8u) {
+            for (i = 0u; i < 256u; i++) {
+                hist[i] = 0u;
+            }
+            for (i = 0u; i < count; i++) {
+                hist[(keys[i].key >> shift) & 0xFFu]++;
+            }
+            if (hist[(keys[0].key >> shift) & 0xFFu] != count) {
+                sum = 0u;
+                for (i = 0u; i < 256u; i++) {
+                    digit   = hist[i];
+                    hist[i] = sum;
+                    sum    += digit;
+                }
+                for (i = 0u; i < count; i++) {
+                    tmp[hist[(keys[i].key >> shift) & 0xFFu]++] = keys[i];
+                }
+                swap = keys;
+                keys = tmp;
+                tmp  = swap;
+            }
+        }
+
+        for (i = 0u; i < count; i++) {
+            visible[i] = keys[i].index;
+        }
+    }
+
+    return res;
+}
+
+const ce_u32* ce_sprite_batch_visible(const ce_sprite_batch* batch, ce_u32* count)
+{
+    *count = batch->visible_count;
+
+    return (const ce_u32*)batch->visible.data;
+}
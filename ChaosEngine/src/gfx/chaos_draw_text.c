@@ -0,0 +1,483 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_draw_text.c
+ * @brief Baked SDF fonts, cached text layout and text emission.
+ *
+ * Layouts are keyed by hash(text) combined with the pixel size, so a HUD
+ * string drawn every frame only pays for a hashmap probe and a quad copy.
+ */
+#include "gfx/chaos_draw.h"
+#include "utility/chaos_string.h"
+
+/* ************************************************************************** */
+/* FONT                                                                       */
+/* ************************************************************************** */
+
+ce_result ce_font_init_memory(ce_font* font, const void* data, ce_size size, ce_texture_id atlas_texture)
+{
+    ce_result res;
+    const ce_font_file_header* hdr;
+    ce_size needed;
+    ce_u32 i;
+    ce_u32 cp;
+
+    res = CE_OK;
+    hdr = (const ce_font_file_header*)data;
+
+    if ((font == CE_NULL) || (data == CE_NULL) || (size < sizeof(ce_font_file_header))) {
+        res = CE_ERR_INVALID_ARG;
+    } else if ((hdr->magic != CE_FONT_MAGIC) || (hdr->version != CE_FONT_VERSION)) {
+        res = CE_ERR_FORMAT;
+    } else {
+        needed = sizeof(ce_font_file_header)
+               + ((ce_size)hdr->glyph_count * sizeof(ce_font_glyph))
+               + ((ce_size)hdr->kern_count * sizeof(ce_font_kern))
+               + ((ce_size)hdr->atlas_width * (ce_size)hdr->atlas_height);
+        if (needed > size) {
+            res = CE_ERR_FORMAT;
+        }
+    }
+
+    if (res == CE_OK) {
+        (void)ce__memset(font, 0u, sizeof(*font));
+        font->header        = hdr;
+        font->glyphs        = (const ce_font_glyph*)(hdr + 1);
+        font->kerns         = (const ce_font_kern*)(font->glyphs + hdr->glyph_count);
+        font->atlas         = (const ce_u8*)(font->kerns + hdr->kern_count);
+        font->atlas_texture = atlas_texture;
+
+        for (i = 0u; i < hdr->glyph_count; i++) {
+            cp = font->glyphs[i].codepoint;
+            if (cp < 128u) {
+                font->ascii[cp] = (ce_u16)(i + 1u);
+            }
+        }
+        font->fallback = font->ascii['?'];
+    }
+
+    return res;
+}
+
+const ce_font_glyph* ce_font_find_glyph(const ce_font* font, ce_u32 codepoint)
+{
+    const ce_font_glyph* glyph;
+    ce_u32 lo;
+    ce_u32 hi;
+    ce_u32 mid;
+
+    glyph = CE_NULL;
+
+    if ((codepoint < 128u) && (font->ascii[codepoint] != 0u)) {
+        glyph = &font->glyphs[font->ascii[codepoint] - 1u];
+    } else if (codepoint >= 128u) {
+        /* Glyphs are sorted by codepoint: binary search the non-ASCII range. */
+        lo = 0u;
+        hi = font->header->glyph_count;
+        while ((lo < hi) && (glyph == CE_NULL)) {
+            mid = lo + ((hi - lo) >> 1);
+            if (font->glyphs[mid].codepoint == codepoint) {
+                glyph = &font->glyphs[mid];
+            } else if (font->glyphs[mid].codepoint < codepoint) {
+                lo = mid + 1u;
+            } else {
+                hi = mid;
+            }
+        }
+    } else {
+        /* ASCII codepoint missing from the font. */
+    }
+
+    if ((glyph == CE_NULL) && (font->fallback != 0u)) {
+        glyph = &font->glyphs[font->fallback - 1u];
+    }
+
+    return glyph;
+}
+
+ce_f32 ce_font_kerning(const ce_font* font, ce_u32 left, ce_u32 right)
+{
+    ce_f32 adjust;
+    ce_u64 key;
+    ce_u64 probe;
+    ce_u32 lo;
+    ce_u32 hi;
+    ce_u32 mid;
+    ce_bool done;
+
+    adjust = 0.0f;
+    key    = ((ce_u64)left << 32) | (ce_u64)right;
+    lo     = 0u;
+    hi     = font->header->kern_count;
+    done   = CE_FALSE;
+
+    while ((lo < hi) && (done == CE_FALSE)) {
+        mid   = lo + ((hi - lo) >> 1);
+        probe = ((ce_u64)font->kerns[mid].left << 32) | (ce_u64)font->kerns[mid].right;
+        if (probe == key) {
+            adjust = font->kerns[mid].adjust;
+            done   = CE_TRUE;
+        } else if (probe < key) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return adjust;
+}
+
+/* ************************************************************************** */
+/* LAYOUT                                                                     */
+/* ************************************************************************** */
+
+/**
+ * @brief Decodes one UTF-8 codepoint; malformed bytes decode as U+FFFD.
+ * @param s Cursor (advanced past the sequence).
+ * @return Codepoint.
+ */
+static ce_u32 ce__utf8_next(const ce_u8** s)
+{
+    const ce_u8* p;
+    ce_u32 cp;
+    ce_u32 extra;
+    ce_u32 i;
+
+    p     = *s;
+    cp    = (ce_u32)p[0];
+    extra = 0u;
+
+    if (cp >= 0xF0u) {
+        cp    &= 0x07u;
+        extra  = 3u;
+    } else if (cp >= 0xE0u) {
+        cp    &= 0x0Fu;
+        extra  = 2u;
+    } else if (cp >= 0xC0u) {
+        cp    &= 0x1Fu;
+        extra  = 1u;
+    } else if (cp >= 0x80u) {
+        cp = 0xFFFDu;
+    } else {
+        /* ASCII */
+    }
+
+    p++;
+    for (i = 0u; i < extra; i++) {
+        if ((*p & 0xC0u) != 0x80u) {
+            cp    = 0xFFFDu;
+            extra = i;
+        } else {
+            cp = (cp << 6) | ((ce_u32)*p & 0x3Fu);
+            p++;
+        }
+    }
+
+    *s = p;
+
+    return cp;
+}
+
+/**
+ * @brief Lays out `entry->text` at `entry->size` into entry->quads.
+ */
+static ce_result ce__text_layout_build(const ce_font* font, ce_text_layout* entry)
+{
+    ce_result res;
+    const ce_font_file_header* hdr;
+    const ce_u8* cursor;
+    const ce_u8* end;
+    const ce_font_glyph* glyph;
+    ce_text_quad* quad;
+    ce_f32 scale;
+    ce_f32 line_h;
+    ce_f32 pen_x;
+    ce_f32 baseline;
+    ce_f32 inv_w;
+    ce_f32 inv_h;
+    ce_u32 cp;
+    ce_u32 prev;
+    ce_u32 lines;
+    ce_u32 needed;
+    void* grown;
+
+    res      = CE_OK;
+    hdr      = font->header;
+    scale    = entry->size / hdr->bake_size;
+    line_h   = (hdr->ascent - hdr->descent + hdr->line_gap) * scale;
+    pen_x    = 0.0f;
+    baseline = hdr->ascent * scale;
+    inv_w    = 1.0f / (ce_f32)hdr->atlas_width;
+    inv_h    = 1.0f / (ce_f32)hdr->atlas_height;
+    prev     = 0u;
+    lines    = 1u;
+    cursor   = (const ce_u8*)entry->text;
+    end      = cursor + entry->text_len;
+
+    entry->quad_count = 0u;
+    entry->width      = 0.0f;
+
+    /* Worst case: one quad per byte. */
+    needed = entry->text_len;
+    if (needed > entry->quad_capacity) {
+        grown = ce_mem_realloc(entry->quads, (ce_size)needed * sizeof(ce_text_quad), CE_MEM_DEFAULT_ALIGN, CE_MEM_TAG_GFX);
+        if (grown == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            entry->quads         = (ce_text_quad*)grown;
+            entry->quad_capacity = needed;
+        }
+    }
+
+    while ((res == CE_OK) && (cursor < end)) {
+        cp = ce__utf8_next(&cursor);
+        if (cp == (ce_u32)'\n') {
+            if (pen_x > entry->width) {
+                entry->width = pen_x;
+            }
+            pen_x     = 0.0f;
+            baseline += line_h;
+            prev      = 0u;
+            lines++;
+        } else {
+            glyph = ce_font_find_glyph(font, cp);
+            if (glyph != CE_NULL) {
+                if (prev != 0u) {
+                    pen_x += ce_font_kerning(font, prev, glyph->codepoint) * scale;
+                }
+                if ((glyph->w != 0u) && (glyph->h != 0u)) {
+                    quad     = &entry->quads[entry->quad_count];
+                    quad->x  = pen_x + (glyph->xoff * scale);
+                    quad->y  = baseline + (glyph->yoff * scale);
+                    quad->w  = (ce_f32)glyph->w * scale;
+                    quad->h  = (ce_f32)glyph->h * scale;
+                    quad->u0 = (ce_f32)glyph->x * inv_w;
+                    quad->v0 = (ce_f32)glyph->y * inv_h;
+                    quad->u1 = (ce_f32)(glyph->x + glyph->w) * inv_w;
+                    quad->v1 = (ce_f32)(glyph->y + glyph->h) * inv_h;
+                    entry->quad_count++;
+                }
+                pen_x += glyph->advance * scale;
+                prev   = glyph->codepoint;
+            }
+        }
+    }
+
+    if (pen_x > entry->width) {
+        entry->width = pen_x;
+    }
+    entry->height = (ce_f32)lines * line_h;
+
+    return res;
+}
+
+/* ************************************************************************** */
+/* CACHE                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Cache key: string hash mixed with the exact size bits.
+ */
+static ce_u64 ce__text_key(const ce_char* text, ce_u32 len, ce_f32 size_px)
+{
+    union { ce_f32 f; ce_u32 u; } bits;
+
+    bits.f = size_px;
+
+    return ce_hash_combine(ce_hash_bytes(text, (ce_size)len), (ce_u64)bits.u);
+}
+
+/**
+ * @brief Picks an entry to (re)use: a free one, else the least recently used.
+ */
+static ce_u32 ce__text_cache_victim(ce_text_cache* cache)
+{
+    ce_u32 victim;
+    ce_u32 i;
+
+    victim = 0u;
+
+    if (cache->count < cache->capacity) {
+        victim = cache->count;
+        cache->count++;
+    } else {
+        for (i = 1u; i < cache->capacity; i++) {
+            if (cache->entries[i].last_used < cache->entries[victim].last_used) {
+                victim = i;
+            }
+        }
+        (void)ce_hashmap_remove(&cache->index, cache->entries[victim].key);
+        cache->entries[victim].key = 0ull;
+    }
+
+    return victim;
+}
+
+ce_result ce_text_cache_init(ce_text_cache* cache, const ce_font* font, ce_u32 capacity)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((cache == CE_NULL) || (font == CE_NULL) || (capacity == 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        (void)ce__memset(cache, 0u, sizeof(*cache));
+        cache->font     = font;
+        cache->capacity = capacity;
+        cache->entries  = (ce_text_layout*)ce_mem_calloc((ce_size)capacity * sizeof(ce_text_layout),
+                                                         CE_MEM_DEFAULT_ALIGN, CE_MEM_TAG_GFX);
+        if (cache->entries == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            res = ce_hashmap_init(&cache->index, capacity, CE_MEM_TAG_GFX);
+        }
+    }
+
+    return res;
+}
+
+void ce_text_cache_shutdown(ce_text_cache* cache)
+{
+    ce_u32 i;
+
+    if ((cache != CE_NULL) && (cache->entries != CE_NULL)) {
+        for (i = 0u; i < cache->count; i++) {
+            ce_mem_free(cache->entries[i].text);
+            ce_mem_free(cache->entries[i].quads);
+        }
+        ce_mem_free(cache->entries);
+        ce_hashmap_shutdown(&cache->index);
+        cache->entries = CE_NULL;
+        cache->count   = 0u;
+    }
+}
+
+void ce_text_cache_begin_frame(ce_text_cache* cache)
+{
+    cache->frame++;
+}
+
+const ce_text_layout* ce_text_cache_layout(ce_text_cache* cache, const ce_char* text, ce_f32 size_px)
+{
+    ce_text_layout* entry;
+    ce_u32 len;
+    ce_u64 key;
+    ce_u64 slot;
+    ce_bool hit;
+    void* grown;
+
+    entry = CE_NULL;
+    hit   = CE_FALSE;
+    len   = (ce_u32)ce__strlen(text);
+    key   = ce__text_key(text, len, size_px);
+
+    if (ce_hashmap_get(&cache->index, key, &slot) == CE_TRUE) {
+        entry = &cache->entries[slot];
+        if ((entry->text_len == len) && (entry->size == size_px) &&
+            (ce__memcmp(entry->text, text, (ce_size)len) == 0)) {
+            hit = CE_TRUE;
+        }
+    } else {
+        slot  = (ce_u64)ce__text_cache_victim(cache);
+        entry = &cache->entries[slot];
+    }
+
+    if (hit == CE_TRUE) {
+        cache->hits++;
+    } else {
+        /* Miss (or hash collision): rebuild the entry in place. */
+        cache->misses++;
+        if ((len + 1u) > entry->text_capacity) {
+            grown = ce_mem_realloc(entry->text, (ce_size)len + (ce_size)1, CE_MEM_DEFAULT_ALIGN, CE_MEM_TAG_GFX);
+            if (grown != CE_NULL) {
+                entry->text          = (ce_char*)grown;
+                entry->text_capacity = len + 1u;
+            }
+        }
+        if ((len + 1u) > entry->text_capacity) {
+            entry = CE_NULL;
+        } else {
+            (void)ce__memcpy(entry->text, text, (ce_size)len);
+            entry->text[len] = (ce_char)'\0';
+            entry->text_len  = len;
+            entry->size      = size_px;
+            if (ce__text_layout_build(cache->font, entry) != CE_OK) {
+                entry = CE_NULL;
+            }
+        }
+
+        if (entry == CE_NULL) {
+            (void)ce_hashmap_remove(&cache->index, key);
+            cache->entries[slot].key = 0ull;
+        } else {
+            entry->key = key;
+            if (ce_hashmap_put(&cache->index, key, slot) != CE_OK) {
+                entry->key = 0ull;
+            }
+        }
+    }
+
+    if (entry != CE_NULL) {
+        entry->last_used = cache->frame;
+    }
+
+    return entry;
+}
+
+/* ************************************************************************** */
+/* EMISSION                                                                   */
+/* ************************************************************************** */
+
+ce_result ce_draw_text(ce_sprite_batch* batch, ce_text_cache* cache, const ce_char* text,
+                       ce_f32 x, ce_f32 y, ce_f32 size_px, ce_color color, ce_u16 layer)
+{
+    ce_result res;
+    const ce_text_layout* layout;
+    const ce_text_quad* quad;
+    ce_sprite* out;
+    ce_u32 i;
+
+    res = CE_OK;
+
+    if ((batch == CE_NULL) || (cache == CE_NULL) || (text == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        layout = ce_text_cache_layout(cache, text, size_px);
+        if (layout == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else if (layout->quad_count != 0u) {
+            out = ce_sprite_batch_reserve(batch, layout->quad_count);
+            if (out == CE_NULL) {
+                res = CE_ERR_OUT_OF_MEMORY;
+            } else {
+                for (i = 0u; i < layout->quad_count; i++) {
+                    quad           = &layout->quads[i];
+                    out[i].x       = x + quad->x;
+                    out[i].y       = y + quad->y;
+                    out[i].w       = quad->w;
+                    out[i].h       = quad->h;
+                    out[i].u0      = quad->u0;
+                    out[i].v0      = quad->v0;
+                    out[i].u1      = quad->u1;
+                    out[i].v1      = quad->v1;
+                    out[i].color   = color;
+                    out[i].texture = cache->font->atlas_texture;
+                    out[i].layer   = layer;
+                    out[i].flags   = CE_SPRITE_FLAG_SDF;
+                }
+            }
+        } else {
+            /* Whitespace only: nothing to emit. */
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,489 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_input.c
+ * @brief Event queue, per-frame snapshots and record/replay.
+ *
+ * The queue is a bounded array of sequence-numbered cells (Vyukov): a
+ * producer claims a slot with one CAS on the tail and publishes it by
+ * bumping the cell's sequence, so pushes from several threads never take
+ * a lock and the single consumer never writes the tail.
+ */
+#include "platform/chaos_input.h"
+#include "platform/chaos_thread.h"
+#include "core/chaos_fs.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "utility/chaos_string.h"
+
+#include <stdio.h>
+
+#define CE__INPUT_DEFAULT_CAPACITY 1024u
+#define CE__INPUT_MAX_CAPACITY     (1u << 20)
+#define CE__INPUT_FILE_VERSION     1u
+#define CE__INPUT_HEADER_BYTES     8u
+#define CE__INPUT_RECORD_BYTES     16u
+
+typedef struct ce__input_cell_s {
+    ce_atomic_u32  seq;   /* == position: free; == position + 1: holds an event. */
+    ce_input_event event;
+} ce__input_cell;
+
+struct ce_input_s {
+    ce__input_cell* cells;
+    ce_u32          mask;
+    ce_u32          head;           /* Consumer only. */
+    ce_atomic_u32   tail;
+    ce_atomic_u32   front;          /* Index of the published snapshot. */
+    ce_atomic_u64   pushed;
+    ce_atomic_u64   dropped;
+    ce_input_state  states[2];
+    FILE*           record;
+    ce_u64          record_frame0;
+    ce_u8*          replay;         /* Whole file, header included. */
+    ce_u32          replay_count;
+    ce_u32          replay_next;
+    ce_u64          replay_frame0;
+    ce_u64          recorded;
+    ce_u64          replayed;
+};
+
+/* ************************************************************************** */
+/* FILE FORMAT                                                                */
+/* ************************************************************************** */
+
+/*
+ * "CEIN", u32 version, then one 16-byte little-endian record per event:
+ * u32 frame (relative to the recording start), u16 type, u16 code, s32 x,
+ * s32 y. Timestamps are not kept: replay is paced by frames.
+ */
+
+static void ce__input_put_u32(ce_u8* p, ce_u32 v)
+{
+    p[0] = (ce_u8)(v & 0xFFu);
+    p[1] = (ce_u8)((v >> 8) & 0xFFu);
+    p[2] = (ce_u8)((v >> 16) & 0xFFu);
+    p[3] = (ce_u8)((v >> 24) & 0xFFu);
+}
+
+static ce_u32 ce__input_get_u32(const ce_u8* p)
+{
+    return (ce_u32)p[0] | ((ce_u32)p[1] << 8) | ((ce_u32)p[2] << 16) | ((ce_u32)p[3] << 24);
+}
+
+static ce_u32 ce__input_get_u16(const ce_u8* p)
+{
+    return (ce_u32)p[0] | ((ce_u32)p[1] << 8);
+}
+
+static void ce__input_record(ce_input* input, ce_u64 frame, const ce_input_event* e)
+{
+    ce_u8 rec[CE__INPUT_RECORD_BYTES];
+
+    ce__input_put_u32(rec, (ce_u32)(frame - input->record_frame0 - 1u));
+    rec[4] = (ce_u8)(e->type & 0xFFu);
+    rec[5] = (ce_u8)((e->type >> 8) & 0xFFu);
+    rec[6] = (ce_u8)(e->code & 0xFFu);
+    rec[7] = (ce_u8)((e->code >> 8) & 0xFFu);
+    ce__input_put_u32(rec + 8, (ce_u32)e->x);
+    ce__input_put_u32(rec + 12, (ce_u32)e->y);
+    if (fwrite(rec, 1u, sizeof(rec), input->record) == sizeof(rec)) {
+        input->recorded += 1u;
+    }
+}
+
+/* ************************************************************************** */
+/* FOLDING                                                                    */
+/* ************************************************************************** */
+
+static void ce__input_fold(ce_input_state* s, const ce_input_event* e)
+{
+    ce_u64 bit;
+    ce_u32 word;
+    ce_u32 button;
+
+    word   = (e->code / 64u) % CE_INPUT_KEY_WORDS;
+    bit    = 1ull << (e->code % 64u);
+    button = 1u << (e->code % CE_INPUT_BUTTON_COUNT);
+
+    switch (e->type) {
+    case CE_INPUT_EVENT_KEY_DOWN:
+        if ((e->code < CE_INPUT_KEY_COUNT) && ((s->keys_held[word] & bit) == 0u)) {
+            s->keys_held[word]    |= bit;
+            s->keys_pressed[word] |= bit;
+        }
+        break;
+    case CE_INPUT_EVENT_KEY_UP:
+        if ((e->code < CE_INPUT_KEY_COUNT) && ((s->keys_held[word] & bit) != 0u)) {
+            s->keys_held[word]     &= ~bit;
+            s->keys_released[word] |= bit;
+        }
+        break;
+    case CE_INPUT_EVENT_BUTTON_DOWN:
+        if ((e->code < CE_INPUT_BUTTON_COUNT) && ((s->buttons_held & button) == 0u)) {
+            s->buttons_held    |= button;
+            s->buttons_pressed |= button;
+        }
+        break;
+    case CE_INPUT_EVENT_BUTTON_UP:
+        if ((e->code < CE_INPUT_BUTTON_COUNT) && ((s->buttons_held & button) != 0u)) {
+            s->buttons_held     &= ~button;
+            s->buttons_released |= button;
+        }
+        break;
+    case CE_INPUT_EVENT_MOUSE_MOVE:
+        s->mouse_dx += e->x - s->mouse_x;
+        s->mouse_dy += e->y - s->mouse_y;
+        s->mouse_x   = e->x;
+        s->mouse_y   = e->y;
+        break;
+    case CE_INPUT_EVENT_WHEEL:
+        s->wheel_x += e->x;
+        s->wheel_y += e->y;
+        break;
+    case CE_INPUT_EVENT_QUIT:
+        s->quit = CE_TRUE;
+        break;
+    default:
+        /* Unknown types are counted but change nothing. */
+        break;
+    }
+
+    s->event_count    += 1u;
+    s->oldest_event_ns = ((s->oldest_event_ns == 0u) || (e->time_ns < s->oldest_event_ns)) ? e->time_ns
+                                                                                           : s->oldest_event_ns;
+    s->newest_event_ns = (e->time_ns > s->newest_event_ns) ? e->time_ns : s->newest_event_ns;
+}
+
+/* Single consumer: only ce_input_update pops. */
+static ce_bool ce__input_pop(ce_input* input, ce_input_event* out_event)
+{
+    ce__input_cell* cell;
+    ce_bool popped;
+
+    cell   = &input->cells[input->head & input->mask];
+    popped = (ce_atomic_load_u32(&cell->seq) == (input->head + 1u)) ? CE_TRUE : CE_FALSE;
+    if (popped == CE_TRUE) {
+        *out_event = cell->event;
+        ce_atomic_store_u32(&cell->seq, input->head + input->mask + 1u);
+        input->head += 1u;
+    }
+
+    return popped;
+}
+
+/* Folds the recorded events of the frame being built; frees the file once done. */
+static void ce__input_replay_frame(ce_input* input, ce_input_state* s)
+{
+    const ce_u8* rec;
+    ce_input_event e;
+    ce_u64 frame;
+    ce_bool more;
+
+    frame = s->frame - input->replay_frame0 - 1u;
+    more  = CE_TRUE;
+    while ((more == CE_TRUE) && (input->replay_next < input->replay_count)) {
+        rec  = input->replay + CE__INPUT_HEADER_BYTES + ((ce_size)input->replay_next * CE__INPUT_RECORD_BYTES);
+        more = ((ce_u64)ce__input_get_u32(rec) <= frame) ? CE_TRUE : CE_FALSE;
+        if (more == CE_TRUE) {
+            e.time_ns = s->update_ns;
+            e.type    = ce__input_get_u16(rec + 4);
+            e.code    = ce__input_get_u16(rec + 6);
+            e.x       = (ce_s32)ce__input_get_u32(rec + 8);
+            e.y       = (ce_s32)ce__input_get_u32(rec + 12);
+            ce__input_fold(s, &e);
+            if (input->record != CE_NULL) {
+                ce__input_record(input, s->frame, &e);
+            }
+            input->replay_next += 1u;
+            input->replayed    += 1u;
+        }
+    }
+
+    if (input->replay_next >= input->replay_count) {
+        ce_input_replay_stop(input);
+    }
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_result ce_input_create(const ce_input_desc* desc, ce_input** out_input)
+{
+    ce_result res;
+    ce_input* input;
+    ce_u32 capacity;
+    ce_u32 i;
+
+    res   = CE_OK;
+    input = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_input == CE_NULL) || (desc->queue_capacity > CE__INPUT_MAX_CAPACITY)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        input = (ce_input*)ce_mem_calloc(sizeof(ce_input), 0u, CE_MEM_TAG_CORE);
+        if (input == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        capacity = 2u;
+        while (capacity < ((desc->queue_capacity != 0u) ? desc->queue_capacity : CE__INPUT_DEFAULT_CAPACITY)) {
+            capacity <<= 1;
+        }
+        input->cells = (ce__input_cell*)ce_mem_alloc((ce_size)capacity * sizeof(ce__input_cell), 64u, CE_MEM_TAG_CORE);
+        if (input->cells == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            for (i = 0u; i < capacity; i++) {
+                ce_atomic_store_relaxed_u32(&input->cells[i].seq, i);
+            }
+            input->mask = capacity - 1u;
+        }
+    }
+
+    if (res == CE_OK) {
+        *out_input = input;
+    } else if (input != CE_NULL) {
+        ce_mem_free(input);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_input_destroy(ce_input* input)
+{
+    if (input != CE_NULL) {
+        ce_input_record_stop(input);
+        ce_input_replay_stop(input);
+        ce_mem_free(input->cells);
+        ce_mem_free(input);
+    }
+}
+
+ce_result ce_input_push(ce_input* input, const ce_input_event* event)
+{
+    ce_result res;
+    ce__input_cell* cell;
+    ce_u32 pos;
+    ce_u32 seq;
+    ce_s32 diff;
+    ce_bool done;
+
+    res = CE_OK;
+
+    if ((input == CE_NULL) || (event == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        pos  = ce_atomic_load_relaxed_u32(&input->tail);
+        done = CE_FALSE;
+        while (done == CE_FALSE) {
+            cell = &input->cells[pos & input->mask];
+            seq  = ce_atomic_load_u32(&cell->seq);
+            diff = (ce_s32)(seq - pos);
+            if (diff == 0) {
+                /* On failure the CAS reloads pos and the loop retries. */
+                done = ce_atomic_cas_u32(&input->tail, &pos, pos + 1u);
+            } else if (diff < 0) {
+                /* The consumer has not freed this lap's cell yet. */
+                res  = CE_ERR_FULL;
+                done = CE_TRUE;
+            } else {
+                pos = ce_atomic_load_relaxed_u32(&input->tail);
+            }
+        }
+
+        if (res == CE_OK) {
+            cell->event         = *event;
+            cell->event.time_ns = (event->time_ns != 0u) ? event->time_ns : ce_time_now_ns();
+            ce_atomic_store_u32(&cell->seq, pos + 1u);
+            (void)ce_atomic_fetch_add_u64(&input->pushed, 1u);
+        } else {
+            (void)ce_atomic_fetch_add_u64(&input->dropped, 1u);
+        }
+    }
+
+    return res;
+}
+
+const ce_input_state* ce_input_update(ce_input* input)
+{
+    const ce_input_state* prev;
+    ce_input_state* s;
+    ce_input_event e;
+    ce_u32 back;
+    ce_u32 i;
+
+    s = CE_NULL;
+
+    if (input != CE_NULL) {
+        back = ce_atomic_load_relaxed_u32(&input->front) ^ 1u;
+        prev = &input->states[back ^ 1u];
+        s    = &input->states[back];
+
+        /* Held state and the cursor carry over; per-frame fields restart. */
+        *s = *prev;
+        for (i = 0u; i < CE_INPUT_KEY_WORDS; i++) {
+            s->keys_pressed[i]  = 0u;
+            s->keys_released[i] = 0u;
+        }
+        s->frame           += 1u;
+        s->buttons_pressed  = 0u;
+        s->buttons_released = 0u;
+        s->mouse_dx         = 0;
+        s->mouse_dy         = 0;
+        s->wheel_x          = 0;
+        s->wheel_y          = 0;
+        s->event_count      = 0u;
+        s->oldest_event_ns  = 0u;
+        s->newest_event_ns  = 0u;
+        s->update_ns        = ce_time_now_ns();
+
+        while (ce__input_pop(input, &e) == CE_TRUE) {
+            if ((input->replay == CE_NULL) || (e.type == (ce_u32)CE_INPUT_EVENT_QUIT)) {
+                ce__input_fold(s, &e);
+                if (input->record != CE_NULL) {
+                    ce__input_record(input, s->frame, &e);
+                }
+            }
+        }
+        if (input->replay != CE_NULL) {
+            ce__input_replay_frame(input, s);
+        }
+
+        ce_atomic_store_u32(&input->front, back);
+    }
+
+    return s;
+}
+
+const ce_input_state* ce_input_get_state(const ce_input* input)
+{
+    return (input != CE_NULL) ? &input->states[ce_atomic_load_u32(&input->front)] : CE_NULL;
+}
+
+void ce_input_get_stats(const ce_input* input, ce_input_stats* out_stats)
+{
+    if ((input != CE_NULL) && (out_stats != CE_NULL)) {
+        out_stats->pushed   = ce_atomic_load_relaxed_u64(&input->pushed);
+        out_stats->dropped  = ce_atomic_load_relaxed_u64(&input->dropped);
+        out_stats->recorded = input->recorded;
+        out_stats->replayed = input->replayed;
+    }
+}
+
+/* ************************************************************************** */
+/* RECORD / REPLAY                                                            */
+/* ************************************************************************** */
+
+ce_result ce_input_record_start(ce_input* input, const ce_char* path)
+{
+    ce_result res;
+    ce_u8 header[CE__INPUT_HEADER_BYTES];
+
+    res = CE_OK;
+
+    if ((input == CE_NULL) || (path == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_input_record_stop(input);
+        input->record = fopen(path, "wb");
+        ce__memcpy(header, "CEIN", 4u);
+        ce__input_put_u32(header + 4, CE__INPUT_FILE_VERSION);
+        if (input->record == CE_NULL) {
+            res = CE_ERR_IO;
+        } else if (fwrite(header, 1u, sizeof(header), input->record) != sizeof(header)) {
+            ce_input_record_stop(input);
+            res = CE_ERR_IO;
+        } else {
+            input->record_frame0 = ce_input_get_state(input)->frame;
+        }
+    }
+
+    return res;
+}
+
+void ce_input_record_stop(ce_input* input)
+{
+    if ((input != CE_NULL) && (input->record != CE_NULL)) {
+        (void)fclose(input->record);
+        input->record = CE_NULL;
+    }
+}
+
+ce_result ce_input_replay_start(ce_input* input, const ce_char* path)
+{
+    ce_result res;
+    ce_fs_file file;
+    ce_u64 size;
+    ce_size got;
+    ce_u8* data;
+
+    data = CE_NULL;
+    size = 0u;
+
+    if ((input == CE_NULL) || (path == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        res = ce_fs_open(path, &file);
+        if (res == CE_OK) {
+            res = ce_fs_size(file, &size);
+            if ((res == CE_OK) && ((size < CE__INPUT_HEADER_BYTES) ||
+                                   (((size - CE__INPUT_HEADER_BYTES) % CE__INPUT_RECORD_BYTES) != 0u) ||
+                                   (((size - CE__INPUT_HEADER_BYTES) / CE__INPUT_RECORD_BYTES) > 0xFFFFFFFFull))) {
+                res = CE_ERR_FORMAT;
+            }
+            if (res == CE_OK) {
+                data = (ce_u8*)ce_mem_alloc((ce_size)size, 0u, CE_MEM_TAG_CORE);
+                res  = (data == CE_NULL) ? CE_ERR_OUT_OF_MEMORY : CE_OK;
+            }
+            if (res == CE_OK) {
+                res = ce_fs_read_at(file, 0u, data, (ce_size)size, &got);
+            }
+            ce_fs_close(&file);
+        }
+    }
+
+    if ((res == CE_OK) && ((ce__memcmp(data, "CEIN", 4u) != 0) ||
+                           (ce__input_get_u32(data + 4) != CE__INPUT_FILE_VERSION))) {
+        res = CE_ERR_FORMAT;
+    }
+
+    if (res == CE_OK) {
+        ce_input_replay_stop(input);
+        input->replay        = data;
+        input->replay_count  = (ce_u32)((size - CE__INPUT_HEADER_BYTES) / CE__INPUT_RECORD_BYTES);
+        input->replay_next   = 0u;
+        input->replay_frame0 = ce_input_get_state(input)->frame;
+    } else {
+        ce_mem_free(data);
+    }
+
+    return res;
+}
+
+void ce_input_replay_stop(ce_input* input)
+{
+    if ((input != CE_NULL) && (input->replay != CE_NULL)) {
+        ce_mem_free(input->replay);
+        input->replay       = CE_NULL;
+        input->replay_count = 0u;
+        input->replay_next  = 0u;
+    }
+}
+
+ce_bool ce_input_replay_active(const ce_input* input)
+{
+    return ((input != CE_NULL) && (input->replay != CE_NULL)) ? CE_TRUE : CE_FALSE;
+}
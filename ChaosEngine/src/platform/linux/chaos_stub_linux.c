@@ -9,8 +9,542 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_stub_linux.c
- * @brief Implementation skeleton.
+ * @brief Native Linux platform layer (POSIX threads, sync primitives, files, inotify).
  */
+#if defined(__linux__)
 
+#define _GNU_SOURCE
 
-/* TODO: implement */
+#include "platform/chaos_thread.h"
+#include "core/chaos_containers.h"
+#include "core/chaos_fs.h"
+#include "utility/chaos_string.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+CE_STATIC_ASSERT(sizeof(pthread_mutex_t) <= sizeof(ce_mutex), mutex_storage_too_small);
+CE_STATIC_ASSERT(sizeof(pthread_cond_t) <= sizeof(ce_cond), cond_storage_too_small);
+CE_STATIC_ASSERT(sizeof(pthread_t) <= sizeof(ce_u64), thread_handle_too_small);
+
+/* ************************************************************************** */
+/* THREADS                                                                    */
+/* ************************************************************************** */
+
+typedef struct ce_thread_start_s {
+    ce_thread_fn fn;
+    void*        user;
+    ce_char      name[16];
+} ce_thread_start;
+
+/**
+ * @brief pthread trampoline: names the thread then runs the user entry.
+ */
+static void* ce__thread_main(void* arg)
+{
+    ce_thread_start start;
+
+    start = *(ce_thread_start*)arg;
+    free(arg);
+
+    if (start.name[0] != (ce_char)'\0') {
+        (void)pthread_setname_np(pthread_self(), start.name);
+    }
+    start.fn(start.user);
+
+    return CE_NULL;
+}
+
+ce_result ce_thread_create(ce_thread* thread, ce_thread_fn fn, void* user, const ce_char* name)
+{
+    ce_result res;
+    ce_thread_start* start;
+    pthread_t tid;
+    ce_u32 i;
+
+    res   = CE_OK;
+    start = (ce_thread_start*)malloc(sizeof(ce_thread_start));
+
+    if ((thread == CE_NULL) || (fn == CE_NULL)) {
+        free(start);
+        res = CE_ERR_INVALID_ARG;
+    } else if (start == CE_NULL) {
+        res = CE_ERR_OUT_OF_MEMORY;
+    } else {
+        start->fn   = fn;
+        start->user = user;
+        i           = 0u;
+        if (name != CE_NULL) {
+            while ((i < 15u) && (name[i] != (ce_char)'\0')) {
+                start->name[i] = name[i];
+                i++;
+            }
+        }
+        start->name[i] = (ce_char)'\0';
+
+        if (pthread_create(&tid, CE_NULL, ce__thread_main, start) != 0) {
+            free(start);
+            res = CE_ERR_UNSUPPORTED;
+        } else {
+            thread->handle = (ce_u64)tid;
+        }
+    }
+
+    return res;
+}
+
+void ce_thread_join(ce_thread* thread)
+{
+    (void)pthread_join((pthread_t)thread->handle, CE_NULL);
+}
+
+void ce_thread_yield(void)
+{
+    (void)sched_yield();
+}
+
+void ce_thread_sleep_ms(ce_u32 ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = (time_t)(ms / 1000u);
+    ts.tv_nsec = (long)(ms % 1000u) * 1000000L;
+    while (nanosleep(&ts, &ts) != 0) {
+        /* Interrupted: sleep for the remainder. */
+    }
+}
+
+ce_u32 ce_thread_hardware_concurrency(void)
+{
+    long n;
+
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (n > 0L) ? (ce_u32)n : 1u;
+}
+
+/* ************************************************************************** */
+/* MUTEX / CONDITION VARIABLE                                                 */
+/* ************************************************************************** */
+
+ce_result ce_mutex_init(ce_mutex* mutex)
+{
+    return (pthread_mutex_init((pthread_mutex_t*)(void*)mutex->storage.bytes, CE_NULL) == 0)
+         ? CE_OK : CE_ERR_UNSUPPORTED;
+}
+
+void ce_mutex_destroy(ce_mutex* mutex)
+{
+    (void)pthread_mutex_destroy((pthread_mutex_t*)(void*)mutex->storage.bytes);
+}
+
+void ce_mutex_lock(ce_mutex* mutex)
+{
+    (void)pthread_mutex_lock((pthread_mutex_t*)(void*)mutex->storage.bytes);
+}
+
+void ce_mutex_unlock(ce_mutex* mutex)
+{
+    (void)pthread_mutex_unlock((pthread_mutex_t*)(void*)mutex->storage.bytes);
+}
+
+ce_result ce_cond_init(ce_cond* cond)
+{
+    return (pthread_cond_init((pthread_cond_t*)(void*)cond->storage.bytes, CE_NULL) == 0)
+         ? CE_OK : CE_ERR_UNSUPPORTED;
+}
+
+void ce_cond_destroy(ce_cond* cond)
+{
+    (void)pthread_cond_destroy((pthread_cond_t*)(void*)cond->storage.bytes);
+}
+
+void ce_cond_wait(ce_cond* cond, ce_mutex* mutex)
+{
+    (void)pthread_cond_wait((pthread_cond_t*)(void*)cond->storage.bytes,
+                            (pthread_mutex_t*)(void*)mutex->storage.bytes);
+}
+
+void ce_cond_signal(ce_cond* cond)
+{
+    (void)pthread_cond_signal((pthread_cond_t*)(void*)cond->storage.bytes);
+}
+
+void ce_cond_broadcast(ce_cond* cond)
+{
+    (void)pthread_cond_broadcast((pthread_cond_t*)(void*)cond->storage.bytes);
+}
+
+/* ************************************************************************** */
+/* FILES                                                                      */
+/* ************************************************************************** */
+
+ce_result ce_fs_open(const ce_char* path, ce_fs_file* out_file)
+{
+    ce_result res;
+    int fd;
+
+    res = CE_OK;
+    if ((path == CE_NULL) || (out_file == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            res = (errno == ENOENT) ? CE_ERR_NOT_FOUND : CE_ERR_IO;
+        }
+        out_file->handle = (ce_s64)fd;
+    }
+
+    return res;
+}
+
+void ce_fs_close(ce_fs_file* file)
+{
+    if ((file != CE_NULL) && (file->handle >= 0)) {
+        (void)close((int)file->handle);
+        file->handle = -1;
+    }
+}
+
+ce_result ce_fs_size(ce_fs_file file, ce_u64* out_size)
+{
+    ce_result res;
+    struct stat st;
+
+    res = CE_ERR_IO;
+    if (fstat((int)file.handle, &st) == 0) {
+        *out_size = (ce_u64)st.st_size;
+        res       = CE_OK;
+    }
+
+    return res;
+}
+
+ce_result ce_fs_read_at(ce_fs_file file, ce_u64 offset, void* dst, ce_size size, ce_size* out_read)
+{
+    ce_size done;
+    ssize_t n;
+    ce_bool more;
+
+    done = 0u;
+    more = CE_TRUE;
+    while ((more == CE_TRUE) && (done < size)) {
+        n = pread((int)file.handle, (ce_u8*)dst + done, (size_t)(size - done), (off_t)(offset + (ce_u64)done));
+        if (n > 0) {
+            done += (ce_size)n;
+        } else if ((n < 0) && (errno == EINTR)) {
+            /* Interrupted before any byte: retry. */
+        } else {
+            more = CE_FALSE; /* End of file or error. */
+        }
+    }
+    if (out_read != CE_NULL) {
+        *out_read = done;
+    }
+
+    return (done == size) ? CE_OK : CE_ERR_IO;
+}
+
+/* ************************************************************************** */
+/* FILE MAPPING                                                               */
+/* ************************************************************************** */
+
+ce_result ce_fs_map(const ce_char* path, ce_fs_mapping* out_mapping)
+{
+    ce_result res;
+    struct stat st;
+    void* p;
+    int fd;
+
+    res = CE_OK;
+    fd  = -1;
+    if ((path == CE_NULL) || (out_mapping == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        out_mapping->data = CE_NULL;
+        out_mapping->size = 0u;
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            res = (errno == ENOENT) ? CE_ERR_NOT_FOUND : CE_ERR_IO;
+        } else if ((fstat(fd, &st) != 0) || (S_ISREG(st.st_mode) == 0)) {
+            res = CE_ERR_IO;
+        } else if (st.st_size > 0) {
+            p = mmap(CE_NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                res = CE_ERR_IO;
+            } else {
+                out_mapping->data = (const ce_u8*)p;
+                out_mapping->size = (ce_size)st.st_size;
+            }
+        } else {
+            /* Empty file: nothing to map. */
+        }
+    }
+
+    /* The mapping keeps the file alive on its own. */
+    if (fd >= 0) {
+        (void)close(fd);
+    }
+    return res;
+}
+
+void ce_fs_unmap(ce_fs_mapping* mapping)
+{
+    if ((mapping != CE_NULL) && (mapping->data != CE_NULL)) {
+        (void)munmap((void*)(ce_uptr)mapping->data, (size_t)mapping->size);
+        mapping->data = CE_NULL;
+        mapping->size = 0u;
+    }
+}
+
+/* ************************************************************************** */
+/* DIRECTORY WATCHING                                                         */
+/* ************************************************************************** */
+
+#define CE__WATCH_MASK (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR)
+
+typedef struct ce__watch_dir_s {
+    int      wd;
+    ce_char* path;
+} ce__watch_dir;
+
+struct ce_fs_watcher_s {
+    int         fd;
+    ce_dynarray dirs;  /* ce__watch_dir */
+    ce_hashmap  by_wd; /* wd -> index in dirs (wd is never 0) */
+};
+
+/* Writes "dir/name" into out; CE_FALSE when it does not fit. */
+static ce_bool ce__path_join(ce_char* out, ce_size capacity, const ce_char* dir, const ce_char* name)
+{
+    ce_size dir_len;
+    ce_size name_len;
+    ce_bool ok;
+
+    dir_len  = ce__strlen(dir);
+    name_len = ce__strlen(name);
+    ok       = ((dir_len + name_len + 2u) <= capacity) ? CE_TRUE : CE_FALSE;
+    if (ok == CE_TRUE) {
+        (void)ce__memcpy(out, dir, dir_len);
+        out[dir_len] = '/';
+        (void)ce__memcpy(&out[dir_len + 1u], name, name_len + 1u);
+    }
+
+    return ok;
+}
+
+static ce_result ce__watch_tree(ce_fs_watcher* w, const ce_char* path)
+{
+    ce_result res;
+    ce__watch_dir dir;
+    ce_u64 known;
+    ce_char* child;
+    struct dirent* entry;
+    struct stat st;
+    DIR* d;
+    ce_size len;
+    int wd;
+
+    res = CE_OK;
+    wd  = inotify_add_watch(w->fd, path, (uint32_t)CE__WATCH_MASK);
+    if (wd < 0) {
+        if ((errno == ENOENT) || (errno == ENOTDIR)) {
+            res = CE_ERR_NOT_FOUND;
+        } else if (errno == ENOSPC) {
+            res = CE_ERR_FULL;
+        } else {
+            res = (errno == ENOMEM) ? CE_ERR_OUT_OF_MEMORY : CE_ERR_IO;
+        }
+    } else if (ce_hashmap_get(&w->by_wd, (ce_u64)wd, &known) == CE_FALSE) {
+        /* The kernel hands back the same wd when a directory is added twice. */
+        len      = ce__strlen(path);
+        dir.wd   = wd;
+        dir.path = (ce_char*)ce_mem_alloc(len + 1u, 0u, CE_MEM_TAG_CORE);
+        if (dir.path == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            (void)ce__memcpy(dir.path, path, len + 1u);
+            res = (ce_dynarray_push(&w->dirs, &dir) != CE_NULL) ? CE_OK : CE_ERR_OUT_OF_MEMORY;
+        }
+        if (res == CE_OK) {
+            res = ce_hashmap_put(&w->by_wd, (ce_u64)wd, (ce_u64)(w->dirs.count - 1u));
+        } else {
+            ce_mem_free(dir.path);
+        }
+    } else {
+        /* Already watched. */
+    }
+
+    if (res == CE_OK) {
+        d     = opendir(path);
+        child = (ce_char*)ce_mem_alloc((ce_size)PATH_MAX, 0u, CE_MEM_TAG_CORE);
+        if ((d != CE_NULL) && (child != CE_NULL)) {
+            entry = readdir(d);
+            while ((res == CE_OK) && (entry != CE_NULL)) {
+                if ((entry->d_name[0] != '.') &&
+                    (ce__path_join(child, (ce_size)PATH_MAX, path, entry->d_name) == CE_TRUE) &&
+                    ((entry->d_type == DT_DIR) ||
+                     ((entry->d_type == DT_UNKNOWN) && (stat(child, &st) == 0) && S_ISDIR(st.st_mode)))) {
+                    res = ce__watch_tree(w, child);
+                    /* A subdirectory vanishing mid-scan is not an error. */
+                    res = (res == CE_ERR_NOT_FOUND) ? CE_OK : res;
+                }
+                entry = readdir(d);
+            }
+        }
+        ce_mem_free(child);
+        if (d != CE_NULL) {
+            (void)closedir(d);
+        }
+    }
+
+    return res;
+}
+
+/* IN_IGNORED: the directory went away; swap-remove its record. */
+static void ce__watch_forget(ce_fs_watcher* w, int wd)
+{
+    ce__watch_dir* dirs;
+    ce_u64 index;
+
+    if (ce_hashmap_get(&w->by_wd, (ce_u64)wd, &index) == CE_TRUE) {
+        dirs = (ce__watch_dir*)w->dirs.data;
+        ce_mem_free(dirs[index].path);
+        (void)ce_hashmap_remove(&w->by_wd, (ce_u64)wd);
+        ce_dynarray_remove_swap(&w->dirs, (ce_size)index);
+        if (index < (ce_u64)w->dirs.count) {
+            (void)ce_hashmap_put(&w->by_wd, (ce_u64)dirs[index].wd, index);
+        }
+    }
+}
+
+ce_result ce_fs_watcher_create(ce_fs_watcher** out_watcher)
+{
+    ce_result res;
+    ce_fs_watcher* w;
+
+    res = CE_OK;
+    w   = CE_NULL;
+    if (out_watcher == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        w = (ce_fs_watcher*)ce_mem_calloc(sizeof(ce_fs_watcher), 0u, CE_MEM_TAG_CORE);
+        res = (w == CE_NULL) ? CE_ERR_OUT_OF_MEMORY : CE_OK;
+    }
+    if (res == CE_OK) {
+        w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        res   = (w->fd < 0) ? CE_ERR_UNSUPPORTED : ce_dynarray_init(&w->dirs, sizeof(ce__watch_dir), 16u, CE_MEM_TAG_CORE);
+    }
+    if (res == CE_OK) {
+        res = ce_hashmap_init(&w->by_wd, 16u, CE_MEM_TAG_CORE);
+        if (res != CE_OK) {
+            ce_dynarray_shutdown(&w->dirs);
+        }
+    }
+
+    if (res == CE_OK) {
+        *out_watcher = w;
+    } else if (w != CE_NULL) {
+        if (w->fd >= 0) {
+            (void)close(w->fd);
+        }
+        ce_mem_free(w);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_fs_watcher_destroy(ce_fs_watcher* watcher)
+{
+    ce__watch_dir* dirs;
+    ce_size i;
+
+    if (watcher != CE_NULL) {
+        dirs = (ce__watch_dir*)watcher->dirs.data;
+        for (i = 0u; i < watcher->dirs.count; i++) {
+            ce_mem_free(dirs[i].path);
+        }
+        (void)close(watcher->fd);
+        ce_hashmap_shutdown(&watcher->by_wd);
+        ce_dynarray_shutdown(&watcher->dirs);
+        ce_mem_free(watcher);
+    }
+}
+
+ce_result ce_fs_watcher_add(ce_fs_watcher* watcher, const ce_char* directory)
+{
+    ce_result res;
+
+    if ((watcher == CE_NULL) || (directory == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        res = ce__watch_tree(watcher, directory);
+    }
+
+    return res;
+}
+
+ce_u32 ce_fs_watcher_poll(ce_fs_watcher* watcher, ce_fs_change_fn fn, void* user)
+{
+    union {
+        struct inotify_event event; /* Alignment. */
+        ce_u8                bytes[4096];
+    } buffer;
+    const struct inotify_event* ev;
+    const ce__watch_dir* dir;
+    ce_char path[PATH_MAX];
+    ce_u64 index;
+    ssize_t n;
+    ce_size at;
+    ce_u32 count;
+
+    count = 0u;
+    n     = read(watcher->fd, buffer.bytes, sizeof(buffer.bytes));
+    while (n > 0) {
+        at = 0u;
+        while ((at + sizeof(struct inotify_event)) <= (ce_size)n) {
+            ev  = (const struct inotify_event*)(const void*)&buffer.bytes[at];
+            at += sizeof(struct inotify_event) + (ce_size)ev->len;
+
+            if ((ev->mask & IN_IGNORED) != 0u) {
+                ce__watch_forget(watcher, ev->wd);
+            } else if ((ev->len != 0u) && (ce_hashmap_get(&watcher->by_wd, (ce_u64)ev->wd, &index) == CE_TRUE)) {
+                dir = (const ce__watch_dir*)ce_dynarray_at(&watcher->dirs, (ce_size)index);
+                if (ce__path_join(path, (ce_size)PATH_MAX, dir->path, ev->name) == CE_TRUE) {
+                    if ((ev->mask & IN_ISDIR) != 0u) {
+                        (void)ce__watch_tree(watcher, path);
+                    } else if ((ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0u) {
+                        fn(user, path);
+                        count += 1u;
+                    } else {
+                        /* IN_CREATE on a file: wait for its IN_CLOSE_WRITE. */
+                    }
+                }
+            } else {
+                /* Queue overflow (wd -1) or an event on a forgotten directory. */
+            }
+        }
+        n = read(watcher->fd, buffer.bytes, sizeof(buffer.bytes));
+    }
+
+    return count;
+}
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int ce_stub_linux_unused;
+
+#endif /* __linux__ */
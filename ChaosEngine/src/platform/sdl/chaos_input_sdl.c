@@ -9,8 +9,115 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_input_sdl.c
- * @brief Implementation skeleton.
+ * @brief SDL2 event pump feeding the input queue.
+ *
+ * SDL only delivers events on the thread that owns the video subsystem, so
+ * pumping stays on the caller's thread; other sources (a dedicated polling
+ * thread for a device, a network client) call ce_input_push directly.
  */
 #include "platform/chaos_input.h"
+#include "core/chaos_time.h"
 
-/* TODO: implement */
+#if defined(CE_HAVE_SDL2)
+
+#include <SDL2/SDL.h>
+
+static ce_u32 ce__input_sdl_button(Uint8 button)
+{
+    ce_u32 code;
+
+    switch (button) {
+    case SDL_BUTTON_LEFT:
+        code = (ce_u32)CE_MOUSE_LEFT;
+        break;
+    case SDL_BUTTON_MIDDLE:
+        code = (ce_u32)CE_MOUSE_MIDDLE;
+        break;
+    case SDL_BUTTON_RIGHT:
+        code = (ce_u32)CE_MOUSE_RIGHT;
+        break;
+    case SDL_BUTTON_X1:
+        code = (ce_u32)CE_MOUSE_X1;
+        break;
+    case SDL_BUTTON_X2:
+        code = (ce_u32)CE_MOUSE_X2;
+        break;
+    default:
+        code = (ce_u32)button - 1u;
+        break;
+    }
+
+    return code;
+}
+
+ce_u32 ce_input_pump(ce_input* input)
+{
+    SDL_Event sdl;
+    ce_input_event e;
+    ce_u32 queued;
+
+    queued = 0u;
+
+    while ((input != CE_NULL) && (SDL_PollEvent(&sdl) != 0)) {
+        /* SDL's own timestamps are milliseconds; stamp on the engine clock. */
+        e.time_ns = ce_time_now_ns();
+        e.type    = (ce_u32)CE_INPUT_EVENT_NONE;
+        e.code    = 0u;
+        e.x       = 0;
+        e.y       = 0;
+
+        switch (sdl.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            if (sdl.key.repeat == 0u) {
+                e.type = (sdl.type == SDL_KEYDOWN) ? (ce_u32)CE_INPUT_EVENT_KEY_DOWN : (ce_u32)CE_INPUT_EVENT_KEY_UP;
+                e.code = (ce_u32)sdl.key.keysym.scancode;
+            }
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            e.type = (sdl.type == SDL_MOUSEBUTTONDOWN) ? (ce_u32)CE_INPUT_EVENT_BUTTON_DOWN
+                                                       : (ce_u32)CE_INPUT_EVENT_BUTTON_UP;
+            e.code = ce__input_sdl_button(sdl.button.button);
+            e.x    = (ce_s32)sdl.button.x;
+            e.y    = (ce_s32)sdl.button.y;
+            break;
+        case SDL_MOUSEMOTION:
+            e.type = (ce_u32)CE_INPUT_EVENT_MOUSE_MOVE;
+            e.x    = (ce_s32)sdl.motion.x;
+            e.y    = (ce_s32)sdl.motion.y;
+            break;
+        case SDL_MOUSEWHEEL:
+            e.type = (ce_u32)CE_INPUT_EVENT_WHEEL;
+            e.x    = (ce_s32)sdl.wheel.x;
+            e.y    = (ce_s32)sdl.wheel.y;
+            if (sdl.wheel.direction == (Uint32)SDL_MOUSEWHEEL_FLIPPED) {
+                e.x = -e.x;
+                e.y = -e.y;
+            }
+            break;
+        case SDL_QUIT:
+            e.type = (ce_u32)CE_INPUT_EVENT_QUIT;
+            break;
+        default:
+            /* Window, text and controller events are not input here. */
+            break;
+        }
+
+        if ((e.type != (ce_u32)CE_INPUT_EVENT_NONE) && (ce_input_push(input, &e) == CE_OK)) {
+            queued += 1u;
+        }
+    }
+
+    return queued;
+}
+
+#else /* !CE_HAVE_SDL2 */
+
+ce_u32 ce_input_pump(ce_input* input)
+{
+    (void)input;
+    return 0u;
+}
+
+#endif /* CE_HAVE_SDL2 */
@@ -9,8 +9,146 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_time_sdl.c
- * @brief Implementation skeleton.
+ * @brief Clock over SDL's performance counter, for platforms without POSIX clocks.
+ *
+ * Same contract as the native clock in src/core/chaos_time.c: ticks are the
+ * counter, conversions are 32.32 fixed-point and the precise sleep ends in
+ * a spin. SDL_Delay() has millisecond granularity, so the margin is wider.
  */
 #include "core/chaos_time.h"
+#include "platform/chaos_thread.h"
 
-/* TODO: implement */
+#if defined(CE_HAVE_SDL2) && !(defined(__unix__) || defined(__APPLE__))
+
+#include <SDL2/SDL.h>
+
+#define CE__TIME_ONE      4294967296.0  /* 1.0 in 32.32 */
+#define CE__TIME_SPIN_MIN (1ull * CE_NS_PER_MS)
+#define CE__TIME_SPIN_MAX (4ull * CE_NS_PER_MS)
+
+typedef struct ce__time_clock_s {
+    ce_atomic_u32 ready;
+    ce_u64        to_ns;     /* Nanoseconds per tick, 32.32. */
+    ce_u64        to_ticks;  /* Ticks per nanosecond, 32.32. */
+    ce_u64        frequency;
+    ce_atomic_u64 oversleep_ns;
+} ce__time_clock;
+
+static ce__time_clock ce__time;
+
+/* (value * mult) >> 32 without overflow, for a 32.32 `mult`. */
+static ce_u64 ce__time_scale(ce_u64 value, ce_u64 mult)
+{
+    ce_u64 mult_hi;
+    ce_u64 mult_lo;
+
+    mult_hi = mult >> 32u;
+    mult_lo = mult & 0xFFFFFFFFull;
+
+    return (value * mult_hi) + ((value >> 32u) * mult_lo) + (((value & 0xFFFFFFFFull) * mult_lo) >> 32u);
+}
+
+static void ce__time_ensure(void)
+{
+    if (ce_atomic_load_u32(&ce__time.ready) == 0u) {
+        (void)ce_time_init();
+    }
+}
+
+ce_result ce_time_init(void)
+{
+    ce_f64 frequency;
+
+    /* Racing first calls compute the same values. */
+    frequency          = (ce_f64)SDL_GetPerformanceFrequency();
+    ce__time.frequency = (ce_u64)frequency;
+    ce__time.to_ns     = (ce_u64)((((ce_f64)CE_NS_PER_S * CE__TIME_ONE) / frequency) + 0.5);
+    ce__time.to_ticks  = (ce_u64)(((frequency * CE__TIME_ONE) / (ce_f64)CE_NS_PER_S) + 0.5);
+    ce_atomic_store_u32(&ce__time.ready, 1u);
+
+    return CE_OK;
+}
+
+/* Only one source here: nothing is rewritten, so readers never race a switch. */
+ce_result ce_time_set_source(ce_time_source source)
+{
+    return (source == CE_TIME_SOURCE_MONOTONIC) ? CE_OK : CE_ERR_UNSUPPORTED;
+}
+
+ce_time_source ce_time_get_source(void)
+{
+    return CE_TIME_SOURCE_MONOTONIC;
+}
+
+ce_u64 ce_time_ticks(void)
+{
+    return (ce_u64)SDL_GetPerformanceCounter();
+}
+
+ce_u64 ce_time_ticks_per_second(void)
+{
+    ce__time_ensure();
+
+    return ce__time.frequency;
+}
+
+ce_u64 ce_time_ticks_to_ns(ce_u64 ticks)
+{
+    ce__time_ensure();
+
+    return ce__time_scale(ticks, ce__time.to_ns);
+}
+
+ce_u64 ce_time_ns_to_ticks(ce_u64 ns)
+{
+    ce__time_ensure();
+
+    return ce__time_scale(ns, ce__time.to_ticks);
+}
+
+ce_u64 ce_time_now_ns(void)
+{
+    return ce_time_ticks_to_ns(ce_time_ticks());
+}
+
+void ce_time_sleep_until_ns(ce_u64 deadline_ns)
+{
+    ce_u64 now;
+    ce_u64 after;
+    ce_u64 margin;
+    ce_u64 request;
+    ce_u64 over;
+    ce_u64 average;
+
+    now     = ce_time_now_ns();
+    average = ce_atomic_load_relaxed_u64(&ce__time.oversleep_ns);
+    margin  = (average * 2u) + CE__TIME_SPIN_MIN;
+    margin  = (margin < CE__TIME_SPIN_MAX) ? margin : CE__TIME_SPIN_MAX;
+
+    while ((now + margin + CE_NS_PER_MS) < deadline_ns) {
+        request = (deadline_ns - now - margin) / CE_NS_PER_MS;
+        SDL_Delay((Uint32)request);
+        after   = ce_time_now_ns();
+        request = request * CE_NS_PER_MS;
+        over    = ((after - now) > request) ? ((after - now) - request) : 0u;
+        average = average - (average / 8u) + (over / 8u);
+        ce_atomic_store_u64(&ce__time.oversleep_ns, average);
+        now = after;
+    }
+    while (now < deadline_ns) {
+        ce_cpu_pause();
+        now = ce_time_now_ns();
+    }
+}
+
+void ce_time_sleep_ns(ce_u64 ns)
+{
+    ce_time_sleep_until_ns(ce_time_now_ns() + ns);
+}
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int ce_time_sdl_unused;
+
+#endif /* CE_HAVE_SDL2 && !POSIX */
@@ -9,8 +9,556 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_window_sdl.c
- * @brief Implementation skeleton.
+ * @brief SDL2 window with a streaming texture for CPU framebuffers.
+ *
+ * Only the dirty rectangles handed to ce_window_present_pixels() go through
+ * SDL_UpdateTexture; the texture keeps the rest of the previous frame, so
+ * the GPU-side copy to the back buffer stays a single full blit.
+ *
+ * Pacing, metrics and offscreen windows are shared with builds that have
+ * no SDL: only the ce__window_backend_* helpers touch the OS window.
  */
 #include "platform/chaos_window.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#if defined(CE_HAVE_SDL2)
+#include <SDL2/SDL.h>
+#endif
+
+#define CE__WINDOW_DEFAULT_HZ 60u
+
+struct ce_window_s {
+#if defined(CE_HAVE_SDL2)
+    SDL_Window*     window;
+    SDL_Renderer*   renderer;
+    SDL_Texture*    texture;
+#endif
+    ce_color*       pixels;         /* Offscreen framebuffer. */
+    ce_u32          width;
+    ce_u32          height;
+    ce_u32          tex_width;
+    ce_u32          tex_height;
+    ce_u32          mode;
+    ce_u32          present_mode;
+    ce_u32          max_queued_frames;
+    ce_bool         vsync;          /* What the backend currently does. */
+    ce_u64          refresh_ns;
+    ce_u64          next_vblank_ns; /* Emulated blank (offscreen), 0 until the first present. */
+    ce_u64          input_ns;
+    ce_u64          last_present_ns;
+    ce_window_stats stats;
+};
+
+/* ************************************************************************** */
+/* BACKEND                                                                    */
+/* ************************************************************************** */
+
+#if defined(CE_HAVE_SDL2)
+
+static ce_result ce__window_backend_open(ce_window* w, const ce_window_desc* desc)
+{
+    ce_result res;
+    SDL_DisplayMode display;
+    Uint32 flags;
+
+    res = CE_OK;
+
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
+        res = CE_ERR_UNSUPPORTED;
+    } else {
+        flags     = ((w->mode == (ce_u32)CE_WINDOW_MODE_HIDDEN) ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN) |
+                    ((desc->resizable == CE_TRUE) ? SDL_WINDOW_RESIZABLE : 0u);
+        w->window = SDL_CreateWindow((desc->title != CE_NULL) ? desc->title : "ChaosEngine", SDL_WINDOWPOS_CENTERED,
+                                     SDL_WINDOWPOS_CENTERED, (int)desc->width, (int)desc->height, flags);
+        if (w->window != CE_NULL) {
+            w->renderer = SDL_CreateRenderer(w->window, -1, (w->vsync == CE_TRUE) ? SDL_RENDERER_PRESENTVSYNC : 0u);
+        }
+        if ((w->window == CE_NULL) || (w->renderer == CE_NULL)) {
+            res = CE_ERR_UNSUPPORTED;
+        } else if ((SDL_GetWindowDisplayMode(w->window, &display) == 0) && (display.refresh_rate > 0)) {
+            w->refresh_ns = CE_NS_PER_S / (ce_u64)display.refresh_rate;
+        } else {
+            /* Unknown refresh: keep the default. */
+        }
+    }
+
+    return res;
+}
+
+static void ce__window_backend_close(ce_window* w)
+{
+    if (w->texture != CE_NULL) {
+        SDL_DestroyTexture(w->texture);
+    }
+    if (w->renderer != CE_NULL) {
+        SDL_DestroyRenderer(w->renderer);
+    }
+    if (w->window != CE_NULL) {
+        SDL_DestroyWindow(w->window);
+    }
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+}
+
+static void ce__window_backend_size(const ce_window* w, ce_u32* width, ce_u32* height)
+{
+    int sw;
+    int sh;
+
+    SDL_GetWindowSize(w->window, &sw, &sh);
+    *width  = (ce_u32)sw;
+    *height = (ce_u32)sh;
+}
+
+/* (Re)creates the streaming texture when the framebuffer size changes. */
+static ce_result ce__window_backend_resize(ce_window* w, ce_u32 width, ce_u32 height)
+{
+    if (w->texture != CE_NULL) {
+        SDL_DestroyTexture(w->texture);
+    }
+    /* RGBA32 is byte order R,G,B,A: ce_color's layout on every endianness. */
+    w->texture = SDL_CreateTexture(w->renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, (int)width,
+                                   (int)height);
+
+    return (w->texture != CE_NULL) ? CE_OK : CE_ERR_OUT_OF_MEMORY;
+}
+
+/* `rect` is already clamped to the framebuffer; NULL uploads everything. */
+static void ce__window_backend_upload(ce_window* w, const ce_color* pixels, ce_u32 stride, const ce_recti* rect)
+{
+    SDL_Rect r;
+
+    if (rect == CE_NULL) {
+        (void)SDL_UpdateTexture(w->texture, CE_NULL, pixels, (int)(stride * sizeof(ce_color)));
+    } else {
+        r.x = rect->x0;
+        r.y = rect->y0;
+        r.w = rect->x1 - rect->x0;
+        r.h = rect->y1 - rect->y0;
+        (void)SDL_UpdateTexture(w->texture, &r, &pixels[((ce_size)r.y * stride) + (ce_size)r.x],
+                                (int)(stride * sizeof(ce_color)));
+    }
+}
+
+static void ce__window_backend_present(ce_window* w)
+{
+    ce_color probe;
+
+    (void)SDL_RenderCopy(w->renderer, w->texture, CE_NULL, CE_NULL);
+    if (w->max_queued_frames == 1u) {
+        /* A readback cannot complete before the GPU has drawn the frame. */
+        (void)SDL_RenderReadPixels(w->renderer, CE_NULL, SDL_PIXELFORMAT_RGBA32, &probe, (int)sizeof(probe));
+    }
+    SDL_RenderPresent(w->renderer);
+}
+
+static ce_result ce__window_backend_set_vsync(ce_window* w, ce_bool vsync)
+{
+    ce_result res;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    res = (SDL_RenderSetVSync(w->renderer, (vsync == CE_TRUE) ? 1 : 0) == 0) ? CE_OK : CE_ERR_UNSUPPORTED;
+#else
+    res = (vsync == w->vsync) ? CE_OK : CE_ERR_UNSUPPORTED;
+#endif
+    if (res == CE_OK) {
+        w->vsync = vsync;
+    }
+
+    return res;
+}
+
+#else /* !CE_HAVE_SDL2 */
+
+static ce_result ce__window_backend_open(ce_window* w, const ce_window_desc* desc)
+{
+    (void)w;
+    (void)desc;
+
+    return CE_ERR_UNSUPPORTED;
+}
+
+static void ce__window_backend_close(ce_window* w)
+{
+    (void)w;
+}
+
+static void ce__window_backend_size(const ce_window* w, ce_u32* width, ce_u32* height)
+{
+    *width  = w->width;
+    *height = w->height;
+}
+
+static ce_result ce__window_backend_resize(ce_window* w, ce_u32 width, ce_u32 height)
+{
+    (void)w;
+    (void)width;
+    (void)height;
+
+    return CE_ERR_UNSUPPORTED;
+}
+
+static void ce__window_backend_upload(ce_window* w, const ce_color* pixels, ce_u32 stride, const ce_recti* rect)
+{
+    (void)w;
+    (void)pixels;
+    (void)stride;
+    (void)rect;
+}
+
+static void ce__window_backend_present(ce_window* w)
+{
+    (void)w;
+}
+
+static ce_result ce__window_backend_set_vsync(ce_window* w, ce_bool vsync)
+{
+    (void)w;
+    (void)vsync;
+
+    return CE_ERR_UNSUPPORTED;
+}
+
+#endif /* CE_HAVE_SDL2 */
+
+/* ************************************************************************** */
+/* OFFSCREEN                                                                  */
+/* ************************************************************************** */
+
+static ce_result ce__window_offscreen_resize(ce_window* w, ce_u32 width, ce_u32 height)
+{
+    ce_mem_free(w->pixels);
+    w->pixels = (ce_color*)ce_mem_alloc((ce_size)width * (ce_size)height * sizeof(ce_color), 0u, CE_MEM_TAG_CORE);
+
+    return (w->pixels != CE_NULL) ? CE_OK : CE_ERR_OUT_OF_MEMORY;
+}
+
+static void ce__window_offscreen_upload(ce_window* w, const ce_color* pixels, ce_u32 stride, const ce_recti* rect)
+{
+    ce_recti all;
+    const ce_recti* r;
+    ce_s32 y;
+
+    all.x0 = 0;
+    all.y0 = 0;
+    all.x1 = (ce_s32)w->tex_width;
+    all.y1 = (ce_s32)w->tex_height;
+    r      = (rect != CE_NULL) ? rect : &all;
+    for (y = r->y0; y < r->y1; y++) {
+        ce__memcpy(&w->pixels[((ce_size)y * w->tex_width) + (ce_size)r->x0],
+                   &pixels[((ce_size)y * stride) + (ce_size)r->x0], (ce_size)(r->x1 - r->x0) * sizeof(ce_color));
+    }
+}
+
+/* Stands in for the swap: waits for the next emulated blank unless immediate. */
+static void ce__window_offscreen_present(ce_window* w)
+{
+    ce_u64 now;
+    ce_u64 late;
+
+    now = ce_time_now_ns();
+    if (w->present_mode == (ce_u32)CE_PRESENT_IMMEDIATE) {
+        w->next_vblank_ns = 0u;
+    } else if (w->next_vblank_ns == 0u) {
+        /* The first present after start-up (or immediate mode) opens the cadence. */
+        w->next_vblank_ns = now + w->refresh_ns;
+    } else if (now <= w->next_vblank_ns) {
+        ce_time_sleep_until_ns(w->next_vblank_ns);
+        w->next_vblank_ns += w->refresh_ns;
+    } else {
+        late                    = ((now - w->next_vblank_ns) / w->refresh_ns) + 1u;
+        w->next_vblank_ns      += late * w->refresh_ns;
+        w->stats.missed_vblanks += 1u;
+        if (w->present_mode == (ce_u32)CE_PRESENT_VSYNC) {
+            ce_time_sleep_until_ns(w->next_vblank_ns);
+            w->next_vblank_ns += w->refresh_ns;
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* METRICS                                                                    */
+/* ************************************************************************** */
+
+static void ce__window_histogram_add(ce_u64* histogram, ce_u64 ns)
+{
+    ce_u64 bucket;
+
+    bucket = ns / CE_WINDOW_HISTOGRAM_BUCKET_NS;
+    histogram[(bucket < CE_WINDOW_HISTOGRAM_BUCKETS) ? bucket : (CE_WINDOW_HISTOGRAM_BUCKETS - 1u)] += 1u;
+}
+
+static void ce__window_account(ce_window* w, ce_u64 begin_ns, ce_u64 end_ns)
+{
+    ce_window_stats* s;
+    ce_u64 frame;
+    ce_u64 latency;
+
+    s                  = &w->stats;
+    s->presents       += 1u;
+    s->present_ns_last = end_ns - begin_ns;
+
+    if (w->last_present_ns != 0u) {
+        frame            = end_ns - w->last_present_ns;
+        s->frame_ns_last = frame;
+        s->frame_ns_max  = (frame > s->frame_ns_max) ? frame : s->frame_ns_max;
+        ce__window_histogram_add(s->frame_histogram, frame);
+
+        /* On screen the blank is not observable: a frame 1.5 periods long missed one. */
+        if ((w->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) && (w->present_mode != (ce_u32)CE_PRESENT_IMMEDIATE) &&
+            (frame > (w->refresh_ns + (w->refresh_ns / 2u)))) {
+            s->missed_vblanks += 1u;
+        }
+    }
+    w->last_present_ns = end_ns;
+
+    if ((w->input_ns != 0u) && (w->input_ns <= end_ns)) {
+        latency             = end_ns - w->input_ns;
+        s->latency_ns_last  = latency;
+        s->latency_ns_min   = ((s->latency_samples == 0u) || (latency < s->latency_ns_min)) ? latency
+                                                                                              : s->latency_ns_min;
+        s->latency_ns_max   = (latency > s->latency_ns_max) ? latency : s->latency_ns_max;
+        s->latency_ns_sum  += latency;
+        s->latency_samples += 1u;
+        ce__window_histogram_add(s->latency_histogram, latency);
+    }
+    w->input_ns = 0u;
+}
+
+/* Adaptive on screen: vsync while frames keep up, off as soon as one runs late. */
+static void ce__window_adapt(ce_window* w)
+{
+    ce_bool late;
+
+    if ((w->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) && (w->present_mode == (ce_u32)CE_PRESENT_ADAPTIVE) &&
+        (w->stats.frame_ns_last != 0u)) {
+        late = (w->stats.frame_ns_last > (w->refresh_ns + (w->refresh_ns / 8u))) ? CE_TRUE : CE_FALSE;
+        if ((late == w->vsync) && (ce__window_backend_set_vsync(w, (late == CE_TRUE) ? CE_FALSE : CE_TRUE) != CE_OK)) {
+            /* No runtime vsync control: stay on the creation setting. */
+            w->present_mode = (ce_u32)CE_PRESENT_VSYNC;
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_result ce_window_create(const ce_window_desc* desc, ce_window** out_window)
+{
+    ce_result res;
+    ce_window* w;
+
+    res = CE_OK;
+    w   = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_window == CE_NULL) || (desc->width == 0u) || (desc->height == 0u) ||
+        ((ce_u32)desc->mode > (ce_u32)CE_WINDOW_MODE_OFFSCREEN) ||
+        ((ce_u32)desc->present_mode > (ce_u32)CE_PRESENT_IMMEDIATE)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        w = (ce_window*)ce_mem_calloc(sizeof(ce_window), 0u, CE_MEM_TAG_CORE);
+        if (w == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            w->width             = desc->width;
+            w->height            = desc->height;
+            w->mode              = (ce_u32)desc->mode;
+            w->present_mode      = (ce_u32)desc->present_mode;
+            w->max_queued_frames = desc->max_queued_frames;
+            w->vsync             = (desc->present_mode != CE_PRESENT_IMMEDIATE) ? CE_TRUE : CE_FALSE;
+            w->refresh_ns        = CE_NS_PER_S / ((desc->refresh_hz != 0u) ? desc->refresh_hz : CE__WINDOW_DEFAULT_HZ);
+            if (desc->mode != CE_WINDOW_MODE_OFFSCREEN) {
+                res = ce__window_backend_open(w, desc);
+                if (res != CE_OK) {
+                    ce_window_destroy(w);
+                    w = CE_NULL;
+                }
+            }
+        }
+    }
+
+    if (out_window != CE_NULL) {
+        *out_window = w;
+    }
+
+    return res;
+}
+
+void ce_window_destroy(ce_window* window)
+{
+    if (window != CE_NULL) {
+        if (window->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) {
+            ce__window_backend_close(window);
+        }
+        ce_mem_free(window->pixels);
+        ce_mem_free(window);
+    }
+}
+
+void ce_window_size(const ce_window* window, ce_u32* width, ce_u32* height)
+{
+    if (window->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) {
+        ce__window_backend_size(window, width, height);
+    } else {
+        *width  = window->width;
+        *height = window->height;
+    }
+}
+
+ce_result ce_window_present_pixels(ce_window* window, const ce_color* pixels, ce_u32 width, ce_u32 height,
+                                   ce_u32 stride, const ce_recti* rects, ce_u32 rect_count)
+{
+    ce_result res;
+    ce_recti r;
+    ce_u64 begin;
+    ce_u32 i;
+    ce_bool offscreen;
+
+    res = CE_OK;
+
+    if ((window == CE_NULL) || (pixels == CE_NULL) || (width == 0u) || (height == 0u) || (stride < width)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        begin     = ce_time_now_ns();
+        offscreen = (window->mode == (ce_u32)CE_WINDOW_MODE_OFFSCREEN) ? CE_TRUE : CE_FALSE;
+
+        if ((window->tex_width != width) || (window->tex_height != height)) {
+            res = (offscreen == CE_TRUE) ? ce__window_offscreen_resize(window, width, height)
+                                         : ce__window_backend_resize(window, width, height);
+            window->tex_width  = (res == CE_OK) ? width : 0u;
+            window->tex_height = (res == CE_OK) ? height : 0u;
+            rect_count         = 0u;
+        }
+
+        if (res != CE_OK) {
+            /* No texture: nothing to upload or show. */
+        } else if (rect_count == 0u) {
+            if (offscreen == CE_TRUE) {
+                ce__window_offscreen_upload(window, pixels, stride, CE_NULL);
+            } else {
+                ce__window_backend_upload(window, pixels, stride, CE_NULL);
+            }
+            window->stats.pixels_uploaded += (ce_u64)width * (ce_u64)height;
+        } else {
+            for (i = 0u; i < rect_count; i++) {
+                r.x0 = (rects[i].x0 < 0) ? 0 : rects[i].x0;
+                r.y0 = (rects[i].y0 < 0) ? 0 : rects[i].y0;
+                r.x1 = (rects[i].x1 > (ce_s32)width) ? (ce_s32)width : rects[i].x1;
+                r.y1 = (rects[i].y1 > (ce_s32)height) ? (ce_s32)height : rects[i].y1;
+                if ((r.x1 > r.x0) && (r.y1 > r.y0)) {
+                    if (offscreen == CE_TRUE) {
+                        ce__window_offscreen_upload(window, pixels, stride, &r);
+                    } else {
+                        ce__window_backend_upload(window, pixels, stride, &r);
+                    }
+                    window->stats.pixels_uploaded += (ce_u64)(r.x1 - r.x0) * (ce_u64)(r.y1 - r.y0);
+                }
+            }
+        }
+
+        if (res == CE_OK) {
+            if (offscreen == CE_TRUE) {
+                ce__window_offscreen_present(window);
+            } else {
+                ce__window_backend_present(window);
+            }
+            ce__window_account(window, begin, ce_time_now_ns());
+            ce__window_adapt(window);
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_window_set_present_mode(ce_window* window, ce_present_mode mode)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((window == CE_NULL) || ((ce_u32)mode > (ce_u32)CE_PRESENT_IMMEDIATE)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        if (window->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) {
+            res = ce__window_backend_set_vsync(window, (mode != CE_PRESENT_IMMEDIATE) ? CE_TRUE : CE_FALSE);
+        }
+        if (res == CE_OK) {
+            window->present_mode   = (ce_u32)mode;
+            window->next_vblank_ns = 0u;
+        }
+    }
+
+    return res;
+}
+
+void ce_window_set_input_time(ce_window* window, ce_u64 input_ns)
+{
+    if (window != CE_NULL) {
+        window->input_ns = input_ns;
+    }
+}
+
+ce_result ce_window_read_pixels(const ce_window* window, const ce_color** out_pixels, ce_u32* out_width,
+                                ce_u32* out_height)
+{
+    ce_result res;
+
+    res = CE_OK;
+
+    if ((window == CE_NULL) || (out_pixels == CE_NULL) || (out_width == CE_NULL) || (out_height == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (window->mode != (ce_u32)CE_WINDOW_MODE_OFFSCREEN) {
+        res = CE_ERR_UNSUPPORTED;
+    } else if (window->pixels == CE_NULL) {
+        res = CE_ERR_NOT_FOUND;
+    } else {
+        *out_pixels = window->pixels;
+        *out_width  = window->tex_width;
+        *out_height = window->tex_height;
+    }
+
+    return res;
+}
+
+void ce_window_get_stats(const ce_window* window, ce_window_stats* out_stats)
+{
+    *out_stats = window->stats;
+}
+
+void ce_window_reset_stats(ce_window* window)
+{
+    if (window != CE_NULL) {
+        ce__memset(&window->stats, 0u, sizeof(window->stats));
+        window->last_present_ns = 0u;
+    }
+}
+
+ce_u64 ce_window_histogram_percentile(const ce_u64* histogram, ce_f64 fraction)
+{
+    ce_u64 total;
+    ce_u64 target;
+    ce_u64 seen;
+    ce_u64 edge;
+    ce_u32 i;
+
+    total = 0u;
+    for (i = 0u; i < CE_WINDOW_HISTOGRAM_BUCKETS; i++) {
+        total += histogram[i];
+    }
+
+    edge = 0u;
+    if (total != 0u) {
+        fraction = (fraction < 0.0) ? 0.0 : ((fraction > 1.0) ? 1.0 : fraction);
+        target   = (ce_u64)(fraction * (ce_f64)total);
+        target   = (target == 0u) ? 1u : target;
+        seen     = 0u;
+        for (i = 0u; (i < CE_WINDOW_HISTOGRAM_BUCKETS) && (seen < target); i++) {
+            seen += histogram[i];
+            edge  = (ce_u64)(i + 1u) * CE_WINDOW_HISTOGRAM_BUCKET_NS;
+        }
+    }
+
+    return edge;
+}
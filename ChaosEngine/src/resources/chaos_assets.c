@@ -9,8 +9,1213 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_assets.c
- * @brief Implementation skeleton.
+ * @brief Asynchronous prioritized asset manager.
+ *
+ * One mutex guards the bookkeeping; loader callbacks always run outside it.
+ * Load jobs pull work: each job takes the best loadable request, loads it,
+ * and loops until nothing is loadable, so the FIFO job queue still honours
+ * asset priorities. A queued or cached asset sits on exactly one intrusive
+ * list (a priority queue or the LRU), threaded through `prev` / `next`.
+ *
+ * Hot reload runs in waves. At a frame boundary with no load running, every
+ * asset whose file has been quiet for the debounce time joins the wave, and
+ * so does everything depending on it, transitively. Each member holds an
+ * extra reference until the wave ends, which keeps it off the LRU, so it
+ * can use `prev` / `next` for the reload or staged list. A member is
+ * re-imported once none of its dependencies is still pending, reading
+ * their staged data. When nothing is left running, the next update swaps
+ * every staged result in under the lock and then unloads the old data.
+ * Loads that depend on a member wait for the swap.
  */
 #include "resources/chaos_assets.h"
+#include "core/chaos_containers.h"
+#include "core/chaos_fs.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_time.h"
+#include "platform/chaos_thread.h"
+#include "runtime/chaos_jobs.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#define CE__ASSET_DEFAULT_DEBOUNCE_MS 100u
+#define CE__ASSET_HASH_CHUNK          8192u
+
+typedef enum ce__reload_state_e {
+    CE__RELOAD_NONE = 0,
+    CE__RELOAD_PENDING, /* On the reload list. */
+    CE__RELOAD_RUNNING,
+    CE__RELOAD_STAGED   /* New data waits on the staged list. */
+} ce__reload_state;
+
+typedef struct ce__asset_list_s {
+    ce_u32 head;
+    ce_u32 tail;
+} ce__asset_list;
+
+typedef struct ce__asset_s {
+    ce_char* path;
+    ce_u64   key;
+    void*    data;
+    ce_size  bytes;
+    ce_u32   type;
+    ce_u32   state;
+    ce_u32   priority;
+    ce_u32   refs;
+    ce_u32   deps[CE_ASSET_MAX_DEPS]; /* Slots, each holding one reference. */
+    ce_u32   dep_count;
+    ce_u32   prev;
+    ce_u32   next;
+    ce_bool  cancel;
+
+    /* Hot reload. */
+    void*    staged;
+    ce_size  staged_bytes;
+    ce_u64   content_hash;  /* File hash at the last (re)load; 0 = unknown. */
+    ce_u64   reload_at;     /* Debounce deadline in ns; 0 = not armed. */
+    ce_u32   reload;        /* ce__reload_state */
+    ce_u32   version;
+    ce_bool  reload_self;   /* The file changed (else only a dependency did). */
+} ce__asset;
+
+struct ce_asset_manager_s {
+    ce_mutex               mutex;
+    ce_cond                settled;
+    ce_handle_table        handles;
+    ce__asset*             assets;
+    ce_hashmap             by_key;
+    ce_asset_loader        loaders[CE_ASSET_MAX_TYPES];
+    ce__asset_list         queues[CE_ASSET_PRIORITY_COUNT];
+    ce__asset_list         lru;
+    ce_u32                 queued;
+    ce_u32                 in_flight;
+    ce_u32                 max_in_flight;
+    ce_size                budget;
+    ce_job_counter         jobs;
+    ce_asset_manager_stats stats;
+
+    ce_fs_watcher*         watcher;
+    ce_dynarray            armed;         /* ce_u32 slots with a debounce deadline. */
+    ce__asset_list         reloads;
+    ce__asset_list         staged;
+    ce_u32                 reload_queued; /* PENDING */
+    ce_u32                 reload_active; /* PENDING + RUNNING */
+    ce_u64                 debounce_ns;
+};
+
+/* ************************************************************************** */
+/* LISTS                                                                      */
+/* ************************************************************************** */
+
+static void ce__list_push(ce_asset_manager* m, ce__asset_list* list, ce_u32 slot)
+{
+    ce__asset* a;
+
+    a       = &m->assets[slot];
+    a->prev = list->tail;
+    a->next = CE_HANDLE_INVALID;
+    if (list->tail != CE_HANDLE_INVALID) {
+        m->assets[list->tail].next = slot;
+    } else {
+        list->head = slot;
+    }
+    list->tail = slot;
+}
+
+static void ce__list_remove(ce_asset_manager* m, ce__asset_list* list, ce_u32 slot)
+{
+    ce__asset* a;
+
+    a = &m->assets[slot];
+    if (a->prev != CE_HANDLE_INVALID) {
+        m->assets[a->prev].next = a->next;
+    } else {
+        list->head = a->next;
+    }
+    if (a->next != CE_HANDLE_INVALID) {
+        m->assets[a->next].prev = a->prev;
+    } else {
+        list->tail = a->prev;
+    }
+    a->prev = CE_HANDLE_INVALID;
+    a->next = CE_HANDLE_INVALID;
+}
+
+/* ************************************************************************** */
+/* BOOKKEEPING (LOCKED)                                                       */
+/* ************************************************************************** */
+
+static ce_u64 ce__asset_key(ce_u32 type, const ce_char* path)
+{
+    ce_u64 key;
+
+    key = ce_hash_combine(ce_hash_str(path), (ce_u64)type);
+    return (key != 0u) ? key : 1u;
+}
+
+static void ce__asset_unref(ce_asset_manager* m, ce_u32 slot);
+
+/* Later requests for the same path no longer find this slot. */
+static void ce__asset_unmap(ce_asset_manager* m, ce_u32 slot)
+{
+    ce_u64 owner;
+
+    if ((ce_hashmap_get(&m->by_key, m->assets[slot].key, &owner) == CE_TRUE) && ((ce_u32)owner == slot)) {
+        (void)ce_hashmap_remove(&m->by_key, m->assets[slot].key);
+    }
+}
+
+/* Forgets a slot with no data attached; its handles go stale. */
+static void ce__asset_retire(ce_asset_manager* m, ce_u32 slot)
+{
+    ce__asset* a;
+    ce_u32 i;
+
+    a = &m->assets[slot];
+    ce__asset_unmap(m, slot);
+    ce_mem_free(a->path);
+    a->path      = CE_NULL;
+    a->state     = (ce_u32)CE_ASSET_STATE_INVALID;
+    a->reload_at = 0u;
+    ce_handle_table_free(&m->handles, slot);
+
+    for (i = 0u; i < a->dep_count; i++) {
+        ce__asset_unref(m, a->deps[i]);
+    }
+    a->dep_count = 0u;
+}
+
+static void ce__asset_unref(ce_asset_manager* m, ce_u32 slot)
+{
+    ce__asset* a;
+
+    a = &m->assets[slot];
+    a->refs -= 1u;
+    if (a->refs == 0u) {
+        if (a->state == (ce_u32)CE_ASSET_STATE_QUEUED) {
+            ce__list_remove(m, &m->queues[a->priority], slot);
+            m->queued -= 1u;
+            ce__asset_retire(m, slot);
+        } else if (a->state == (ce_u32)CE_ASSET_STATE_READY) {
+            ce__list_push(m, &m->lru, slot);
+            m->stats.cached += 1u;
+        } else if (a->state == (ce_u32)CE_ASSET_STATE_LOADING) {
+            /* The finishing job decides. */
+        } else {
+            ce__asset_retire(m, slot);
+        }
+    }
+}
+
+/* Raises an asset and, transitively, whatever it waits on. */
+static void ce__asset_raise(ce_asset_manager* m, ce_u32 slot, ce_u32 priority)
+{
+    ce__asset* a;
+    ce_u32 i;
+
+    a = &m->assets[slot];
+    if (a->priority < priority) {
+        if (a->state == (ce_u32)CE_ASSET_STATE_QUEUED) {
+            ce__list_remove(m, &m->queues[a->priority], slot);
+            ce__list_push(m, &m->queues[priority], slot);
+        }
+        a->priority = priority;
+        for (i = 0u; i < a->dep_count; i++) {
+            ce__asset_raise(m, a->deps[i], priority);
+        }
+    }
+}
+
+static void ce__asset_fail(ce_asset_manager* m, ce_u32 slot, ce_asset_state state)
+{
+    m->assets[slot].state = (ce_u32)state;
+    /* A later request for the same path retries. */
+    ce__asset_unmap(m, slot);
+    if (state == CE_ASSET_STATE_CANCELLED) {
+        m->stats.cancellations += 1u;
+    } else {
+        m->stats.failures += 1u;
+    }
+    ce_cond_broadcast(&m->settled);
+}
+
+/**
+ * @brief Takes the best queued asset whose dependencies are all ready.
+ *
+ * Requests behind a failed or cancelled dependency fail on the way.
+ */
+static ce_u32 ce__asset_pick(ce_asset_manager* m)
+{
+    ce__asset* a;
+    ce_u32 picked;
+    ce_u32 slot;
+    ce_u32 next;
+    ce_u32 blocked;
+    ce_u32 broken;
+    ce_u32 dep_state;
+    ce_u32 p;
+    ce_u32 i;
+
+    picked = CE_HANDLE_INVALID;
+    p      = CE_ASSET_PRIORITY_COUNT;
+    while ((picked == CE_HANDLE_INVALID) && (p > 0u)) {
+        p -= 1u;
+        slot = m->queues[p].head;
+        while ((picked == CE_HANDLE_INVALID) && (slot != CE_HANDLE_INVALID)) {
+            a       = &m->assets[slot];
+            next    = a->next;
+            blocked = 0u;
+            broken  = 0u;
+            for (i = 0u; i < a->dep_count; i++) {
+                dep_state = m->assets[a->deps[i]].state;
+                if ((dep_state == (ce_u32)CE_ASSET_STATE_FAILED) || (dep_state == (ce_u32)CE_ASSET_STATE_CANCELLED)) {
+                    broken += 1u;
+                } else if ((dep_state != (ce_u32)CE_ASSET_STATE_READY) ||
+                           (m->assets[a->deps[i]].reload != (ce_u32)CE__RELOAD_NONE)) {
+                    /* Not loaded yet, or about to be swapped. */
+                    blocked += 1u;
+                } else {
+                    /* Ready. */
+                }
+            }
+
+            if ((broken != 0u) || (blocked == 0u)) {
+                ce__list_remove(m, &m->queues[p], slot);
+                m->queued -= 1u;
+                if (broken != 0u) {
+                    ce__asset_fail(m, slot, CE_ASSET_STATE_FAILED);
+                } else {
+                    a->state = (ce_u32)CE_ASSET_STATE_LOADING;
+                    m->stats.loading += 1u;
+                    picked = slot;
+                }
+            }
+            slot = next;
+        }
+    }
+
+    return picked;
+}
+
+/* ************************************************************************** */
+/* HOT RELOAD (LOCKED)                                                        */
+/* ************************************************************************** */
+
+/* Streams the file through ce_hash_bytes; 0 when it cannot be opened. */
+static ce_u64 ce__asset_hash_file(const ce_char* path)
+{
+    ce_u8 chunk[CE__ASSET_HASH_CHUNK];
+    ce_fs_file file;
+    ce_result res;
+    ce_u64 hash;
+    ce_u64 offset;
+    ce_size got;
+
+    hash = 0u;
+    if (ce_fs_open(path, &file) == CE_OK) {
+        offset = 0u;
+        do {
+            got     = 0u;
+            res     = ce_fs_read_at(file, offset, chunk, sizeof(chunk), &got);
+            hash    = ce_hash_combine(hash, ce_hash_bytes(chunk, got));
+            offset += (ce_u64)got;
+        } while (res == CE_OK);
+        ce_fs_close(&file);
+        hash = (hash != 0u) ? hash : 1u;
+    }
+
+    return hash;
+}
+
+/* Enrols an asset and, transitively, everything built from it in the wave. */
+static void ce__asset_reload_mark(ce_asset_manager* m, ce_u32 slot, ce_bool self)
+{
+    ce__asset* a;
+    const ce__asset* other;
+    ce_u32 i;
+    ce_u32 j;
+
+    a = &m->assets[slot];
+    if (self == CE_TRUE) {
+        a->reload_self = CE_TRUE;
+    }
+    if (a->reload == (ce_u32)CE__RELOAD_NONE) {
+        if (a->refs == 0u) {
+            ce__list_remove(m, &m->lru, slot);
+            m->stats.cached -= 1u;
+        }
+        a->refs  += 1u;
+        a->reload = (ce_u32)CE__RELOAD_PENDING;
+        ce__list_push(m, &m->reloads, slot);
+        m->reload_queued += 1u;
+        m->reload_active += 1u;
+
+        /* No reverse edges are kept: reloads are rare, a scan is fine. */
+        for (i = 0u; i < m->handles.alive_count; i++) {
+            other = &m->assets[m->handles.alive[i]];
+            if (other->state == (ce_u32)CE_ASSET_STATE_READY) {
+                for (j = 0u; j < other->dep_count; j++) {
+                    if (other->deps[j] == slot) {
+                        ce__asset_reload_mark(m, m->handles.alive[i], CE_FALSE);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Takes the first pending reload whose dependencies have all settled. */
+static ce_u32 ce__asset_pick_reload(ce_asset_manager* m)
+{
+    ce__asset* a;
+    ce_u32 picked;
+    ce_u32 slot;
+    ce_u32 next;
+    ce_u32 dep_reload;
+    ce_u32 blocked;
+    ce_u32 i;
+
+    picked = CE_HANDLE_INVALID;
+    slot   = m->reloads.head;
+    while ((picked == CE_HANDLE_INVALID) && (slot != CE_HANDLE_INVALID)) {
+        a       = &m->assets[slot];
+        next    = a->next;
+        blocked = 0u;
+        for (i = 0u; i < a->dep_count; i++) {
+            dep_reload = m->assets[a->deps[i]].reload;
+            if ((dep_reload == (ce_u32)CE__RELOAD_PENDING) || (dep_reload == (ce_u32)CE__RELOAD_RUNNING)) {
+                blocked += 1u;
+            }
+        }
+        if (blocked == 0u) {
+            ce__list_remove(m, &m->reloads, slot);
+            m->reload_queued -= 1u;
+            a->reload = (ce_u32)CE__RELOAD_RUNNING;
+            picked    = slot;
+        }
+        slot = next;
+    }
+
+    return picked;
+}
+
+/* ************************************************************************** */
+/* JOBS                                                                       */
+/* ************************************************************************** */
+
+/* Entered and left with the lock held; the loader runs without it. */
+static void ce__asset_run_load(ce_asset_manager* m, ce_u32 slot)
+{
+    ce__asset* a;
+    const ce_asset_loader* loader;
+    const void* deps[CE_ASSET_MAX_DEPS];
+    ce_asset_load_ctx ctx;
+    ce_result res;
+    void* data;
+    ce_size bytes;
+    ce_u64 hash;
+    ce_bool watching;
+    ce_u32 i;
+
+    a      = &m->assets[slot];
+    loader = &m->loaders[a->type];
+    for (i = 0u; i < a->dep_count; i++) {
+        deps[i] = m->assets[a->deps[i]].data;
+    }
+    /* The path and the dependencies outlive the load: the slot is LOADING. */
+    ctx.path      = a->path;
+    ctx.type      = a->type;
+    ctx.deps      = deps;
+    ctx.dep_count = a->dep_count;
+    data          = CE_NULL;
+    bytes         = 0u;
+    watching      = (m->watcher != CE_NULL) ? CE_TRUE : CE_FALSE;
+    ce_mutex_unlock(&m->mutex);
+
+    /* Hashed first: a save landing during the load then still differs. */
+    hash = (watching == CE_TRUE) ? ce__asset_hash_file(ctx.path) : 0u;
+    res  = loader->load(loader->user, &ctx, &data, &bytes);
+
+    ce_mutex_lock(&m->mutex);
+    a = &m->assets[slot];
+    m->stats.loading -= 1u;
+    if ((res == CE_OK) && (a->cancel == CE_FALSE)) {
+        a->state        = (ce_u32)CE_ASSET_STATE_READY;
+        a->data         = data;
+        a->bytes        = bytes;
+        a->content_hash = hash;
+        m->stats.resident       += 1u;
+        m->stats.resident_bytes += bytes;
+        m->stats.loads          += 1u;
+        ce_cond_broadcast(&m->settled);
+        if (a->refs == 0u) {
+            ce__list_push(m, &m->lru, slot);
+            m->stats.cached += 1u;
+        }
+    } else {
+        ce__asset_fail(m, slot, (a->cancel == CE_TRUE) ? CE_ASSET_STATE_CANCELLED : CE_ASSET_STATE_FAILED);
+        if (a->refs == 0u) {
+            ce__asset_retire(m, slot);
+        }
+        if ((res == CE_OK) && (loader->unload != CE_NULL)) {
+            ce_mutex_unlock(&m->mutex);
+            loader->unload(loader->user, data);
+            ce_mutex_lock(&m->mutex);
+        }
+    }
+}
+
+/* Same contract as ce__asset_run_load, for a wave member. */
+static void ce__asset_run_reload(ce_asset_manager* m, ce_u32 slot)
+{
+    ce__asset* a;
+    const ce__asset* dep;
+    const ce_asset_loader* loader;
+    const void* deps[CE_ASSET_MAX_DEPS];
+    ce_asset_load_ctx ctx;
+    ce_result res;
+    void* data;
+    void* discard;
+    ce_size bytes;
+    ce_u64 hash;
+    ce_u64 old_hash;
+    ce_bool self;
+    ce_bool changed;
+    ce_bool skip;
+    ce_u32 i;
+
+    a       = &m->assets[slot];
+    loader  = &m->loaders[a->type];
+    changed = CE_FALSE;
+    for (i = 0u; i < a->dep_count; i++) {
+        dep = &m->assets[a->deps[i]];
+        if (dep->reload == (ce_u32)CE__RELOAD_STAGED) {
+            deps[i] = dep->staged;
+            changed = CE_TRUE;
+        } else {
+            deps[i] = dep->data;
+        }
+    }
+    ctx.path       = a->path;
+    ctx.type       = a->type;
+    ctx.deps       = deps;
+    ctx.dep_count  = a->dep_count;
+    self           = a->reload_self;
+    old_hash       = a->content_hash;
+    a->reload_self = CE_FALSE;
+    data           = CE_NULL;
+    discard        = CE_NULL;
+    bytes          = 0u;
+    hash           = old_hash;
+    res            = CE_OK;
+    skip           = CE_TRUE;
+
+    /* A dependent whose dependencies all kept their data has nothing to redo. */
+    if ((changed == CE_TRUE) || (self == CE_TRUE)) {
+        ce_mutex_unlock(&m->mutex);
+        if (self == CE_TRUE) {
+            hash = ce__asset_hash_file(ctx.path);
+        }
+        skip = ((changed == CE_FALSE) && (hash != 0u) && (hash == old_hash)) ? CE_TRUE : CE_FALSE;
+        if (skip == CE_FALSE) {
+            res = loader->load(loader->user, &ctx, &data, &bytes);
+        }
+        ce_mutex_lock(&m->mutex);
+        a = &m->assets[slot];
+    }
+
+    if ((skip == CE_FALSE) && (res == CE_OK) && (a->cancel == CE_FALSE)) {
+        a->staged       = data;
+        a->staged_bytes = bytes;
+        a->content_hash = hash;
+        a->reload       = (ce_u32)CE__RELOAD_STAGED;
+        ce__list_push(m, &m->staged, slot);
+    } else {
+        if (skip == CE_TRUE) {
+            m->stats.reloads_skipped += (self == CE_TRUE) ? 1u : 0u;
+        } else if (res != CE_OK) {
+            m->stats.reload_failures += 1u;
+        } else {
+            discard = data;
+        }
+        a->reload = (ce_u32)CE__RELOAD_NONE;
+        ce__asset_unref(m, slot);
+    }
+    m->reload_active -= 1u;
+
+    if ((discard != CE_NULL) && (loader->unload != CE_NULL)) {
+        ce_mutex_unlock(&m->mutex);
+        loader->unload(loader->user, discard);
+        ce_mutex_lock(&m->mutex);
+    }
+}
+
+/* Initial loads first: a reload never delays a level. */
+static ce_u32 ce__asset_next_work(ce_asset_manager* m)
+{
+    ce_u32 slot;
+
+    slot = ce__asset_pick(m);
+    if (slot == CE_HANDLE_INVALID) {
+        slot = ce__asset_pick_reload(m);
+    }
+
+    return slot;
+}
+
+static void ce__asset_job(void* user)
+{
+    ce_asset_manager* m;
+    ce_u32 slot;
+
+    m = (ce_asset_manager*)user;
+    ce_mutex_lock(&m->mutex);
+
+    slot = ce__asset_next_work(m);
+    while (slot != CE_HANDLE_INVALID) {
+        if (m->assets[slot].reload == (ce_u32)CE__RELOAD_RUNNING) {
+            ce__asset_run_reload(m, slot);
+        } else {
+            ce__asset_run_load(m, slot);
+        }
+        slot = ce__asset_next_work(m);
+    }
+
+    m->in_flight -= 1u;
+    ce_mutex_unlock(&m->mutex);
+}
+
+/* Tops up the running jobs; called without the lock (jobs may run inline). */
+static void ce__asset_kick(ce_asset_manager* m)
+{
+    ce_u32 n;
+    ce_u32 i;
+
+    ce_mutex_lock(&m->mutex);
+    n = 0u;
+    while ((m->in_flight < m->max_in_flight) && (n < (m->queued + m->reload_queued))) {
+        m->in_flight += 1u;
+        n += 1u;
+    }
+    ce_mutex_unlock(&m->mutex);
+
+    for (i = 0u; i < n; i++) {
+        (void)ce_jobs_submit(ce__asset_job, m, &m->jobs);
+    }
+}
+
+/* ************************************************************************** */
+/* MANAGER                                                                    */
+/* ************************************************************************** */
+
+ce_result ce_asset_manager_create(const ce_asset_manager_desc* desc, ce_asset_manager** out_manager)
+{
+    ce_result res;
+    ce_asset_manager* m;
+    ce_u32 workers;
+    ce_u32 i;
+
+    res = CE_OK;
+    m   = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_manager == CE_NULL) || (desc->max_assets == 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        m = (ce_asset_manager*)ce_mem_calloc(sizeof(ce_asset_manager), 0u, CE_MEM_TAG_ASSETS);
+        if (m == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = ce_handle_table_init(&m->handles, desc->max_assets, CE_MEM_TAG_ASSETS);
+    }
+    if (res == CE_OK) {
+        res = ce_hashmap_init(&m->by_key, desc->max_assets, CE_MEM_TAG_ASSETS);
+    }
+    if (res == CE_OK) {
+        m->assets = (ce__asset*)ce_mem_calloc((ce_size)desc->max_assets * sizeof(ce__asset), 0u, CE_MEM_TAG_ASSETS);
+        res       = (m->assets == CE_NULL) ? CE_ERR_OUT_OF_MEMORY : ce_mutex_init(&m->mutex);
+    }
+    if (res == CE_OK) {
+        res = ce_cond_init(&m->settled);
+        if (res != CE_OK) {
+            ce_mutex_destroy(&m->mutex);
+        }
+    }
+
+    if (res == CE_OK) {
+        workers          = ce_jobs_worker_count();
+        m->max_in_flight = (desc->max_in_flight != 0u) ? desc->max_in_flight : ((workers != 0u) ? workers : 1u);
+        m->budget        = desc->budget_bytes;
+        m->debounce_ns   = (ce_u64)((desc->reload_debounce_ms != 0u) ? desc->reload_debounce_ms
+                                                                     : CE__ASSET_DEFAULT_DEBOUNCE_MS) * CE_NS_PER_MS;
+        m->lru.head      = CE_HANDLE_INVALID;
+        m->lru.tail      = CE_HANDLE_INVALID;
+        m->reloads.head  = CE_HANDLE_INVALID;
+        m->reloads.tail  = CE_HANDLE_INVALID;
+        m->staged.head   = CE_HANDLE_INVALID;
+        m->staged.tail   = CE_HANDLE_INVALID;
+        for (i = 0u; i < CE_ASSET_PRIORITY_COUNT; i++) {
+            m->queues[i].head = CE_HANDLE_INVALID;
+            m->queues[i].tail = CE_HANDLE_INVALID;
+        }
+        *out_manager = m;
+    } else if (m != CE_NULL) {
+        ce_mem_free(m->assets);
+        ce_hashmap_shutdown(&m->by_key);
+        ce_handle_table_shutdown(&m->handles);
+        ce_mem_free(m);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_asset_manager_destroy(ce_asset_manager* manager)
+{
+    const ce_asset_loader* loader;
+    ce__asset* a;
+    ce_u32 slot;
+    ce_u32 p;
+    ce_u32 i;
+
+    if (manager != CE_NULL) {
+        ce_mutex_lock(&manager->mutex);
+        for (p = 0u; p < CE_ASSET_PRIORITY_COUNT; p++) {
+            while (manager->queues[p].head != CE_HANDLE_INVALID) {
+                slot = manager->queues[p].head;
+                ce__list_remove(manager, &manager->queues[p], slot);
+                manager->assets[slot].state = (ce_u32)CE_ASSET_STATE_CANCELLED;
+            }
+        }
+        manager->queued = 0u;
+        while (manager->reloads.head != CE_HANDLE_INVALID) {
+            slot = manager->reloads.head;
+            ce__list_remove(manager, &manager->reloads, slot);
+            manager->assets[slot].reload = (ce_u32)CE__RELOAD_NONE;
+        }
+        manager->reload_queued = 0u;
+        for (i = 0u; i < manager->handles.alive_count; i++) {
+            manager->assets[manager->handles.alive[i]].cancel = CE_TRUE;
+        }
+        ce_mutex_unlock(&manager->mutex);
+
+        ce_jobs_wait(&manager->jobs);
+
+        for (i = 0u; i < manager->handles.alive_count; i++) {
+            a      = &manager->assets[manager->handles.alive[i]];
+            loader = &manager->loaders[a->type];
+            if ((a->state == (ce_u32)CE_ASSET_STATE_READY) && (loader->unload != CE_NULL)) {
+                loader->unload(loader->user, a->data);
+            }
+            if ((a->staged != CE_NULL) && (loader->unload != CE_NULL)) {
+                loader->unload(loader->user, a->staged);
+            }
+            ce_mem_free(a->path);
+        }
+
+        if (manager->watcher != CE_NULL) {
+            ce_fs_watcher_destroy(manager->watcher);
+            ce_dynarray_shutdown(&manager->armed);
+        }
+
+        ce_cond_destroy(&manager->settled);
+        ce_mutex_destroy(&manager->mutex);
+        ce_mem_free(manager->assets);
+        ce_hashmap_shutdown(&manager->by_key);
+        ce_handle_table_shutdown(&manager->handles);
+        ce_mem_free(manager);
+    }
+}
+
+ce_result ce_asset_manager_register(ce_asset_manager* manager, ce_u32 type, const ce_asset_loader* loader)
+{
+    ce_result res;
+
+    res = CE_OK;
+    if ((manager == CE_NULL) || (type >= CE_ASSET_MAX_TYPES) || (loader == CE_NULL) || (loader->load == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_mutex_lock(&manager->mutex);
+        manager->loaders[type] = *loader;
+        ce_mutex_unlock(&manager->mutex);
+    }
+
+    return res;
+}
+
+/* Unloads cached assets, oldest first, until resident bytes reach `target`. */
+static void ce__asset_evict(ce_asset_manager* m, ce_size target)
+{
+    const ce_asset_loader* loader;
+    ce__asset* a;
+    void* data;
+    ce_u32 slot;
+
+    ce_mutex_lock(&m->mutex);
+    while ((m->stats.resident_bytes > target) && (m->lru.head != CE_HANDLE_INVALID)) {
+        slot = m->lru.head;
+        a    = &m->assets[slot];
+        ce__list_remove(m, &m->lru, slot);
+        loader  = &m->loaders[a->type];
+        data    = a->data;
+        a->data = CE_NULL;
+        m->stats.cached         -= 1u;
+        m->stats.resident       -= 1u;
+        m->stats.resident_bytes -= a->bytes;
+        m->stats.evictions      += 1u;
+        /* May push the dependencies onto the LRU in turn. */
+        ce__asset_retire(m, slot);
+
+        if (loader->unload != CE_NULL) {
+            ce_mutex_unlock(&m->mutex);
+            loader->unload(loader->user, data);
+            ce_mutex_lock(&m->mutex);
+        }
+    }
+    ce_mutex_unlock(&m->mutex);
+}
+
+/* Watcher callback: (re)starts the debounce of every asset loaded from `path`. */
+static void ce__asset_on_change(void* user, const ce_char* path)
+{
+    ce_asset_manager* m;
+    ce__asset* a;
+    ce_u64 found;
+    ce_u64 now;
+    ce_u32 slot;
+    ce_u32 type;
+    ce_size len;
+
+    m   = (ce_asset_manager*)user;
+    now = ce_time_now_ns();
+    len = ce__strlen(path);
+    ce_mutex_lock(&m->mutex);
+    for (type = 0u; type < CE_ASSET_MAX_TYPES; type++) {
+        if (ce_hashmap_get(&m->by_key, ce__asset_key(type, path), &found) == CE_TRUE) {
+            slot = (ce_u32)found;
+            a    = &m->assets[slot];
+            if ((a->type == type) && (ce__memcmp(a->path, path, len + 1u) == 0)) {
+                if (a->reload_at == 0u) {
+                    a->reload_at = (ce_dynarray_push(&m->armed, &slot) != CE_NULL) ? 1u : 0u;
+                }
+                if (a->reload_at != 0u) {
+                    a->reload_at = now + m->debounce_ns;
+                }
+            }
+        }
+    }
+    ce_mutex_unlock(&m->mutex);
+}
+
+static void ce__asset_hot_reload(ce_asset_manager* m)
+{
+    const ce_asset_loader* loader;
+    ce__asset* a;
+    void* old;
+    ce_size bytes;
+    ce_size i;
+    ce_u64 now;
+    ce_u32 slot;
+
+    ce_mutex_lock(&m->mutex);
+    if ((m->reload_active == 0u) && (m->staged.head != CE_HANDLE_INVALID)) {
+        /* Every swap of the wave becomes visible at once... */
+        for (slot = m->staged.head; slot != CE_HANDLE_INVALID; slot = a->next) {
+            a               = &m->assets[slot];
+            old             = a->data;
+            bytes           = a->bytes;
+            a->data         = a->staged;
+            a->bytes        = a->staged_bytes;
+            a->staged       = old;
+            a->staged_bytes = bytes;
+            a->version     += 1u;
+            m->stats.resident_bytes = (m->stats.resident_bytes - bytes) + a->bytes;
+            m->stats.reloads       += 1u;
+        }
+        /* ...before any old data goes away. */
+        while (m->staged.head != CE_HANDLE_INVALID) {
+            slot = m->staged.head;
+            a    = &m->assets[slot];
+            ce__list_remove(m, &m->staged, slot);
+            loader    = &m->loaders[a->type];
+            old       = a->staged;
+            a->staged = CE_NULL;
+            a->reload = (ce_u32)CE__RELOAD_NONE;
+            ce__asset_unref(m, slot);
+            if (loader->unload != CE_NULL) {
+                ce_mutex_unlock(&m->mutex);
+                loader->unload(loader->user, old);
+                ce_mutex_lock(&m->mutex);
+            }
+        }
+    }
+    ce_mutex_unlock(&m->mutex);
+
+    (void)ce_fs_watcher_poll(m->watcher, ce__asset_on_change, m);
+
+    /* One wave at a time, and never under a running load (it may be reading a dependency). */
+    ce_mutex_lock(&m->mutex);
+    if ((m->reload_active == 0u) && (m->staged.head == CE_HANDLE_INVALID) && (m->stats.loading == 0u)) {
+        now = ce_time_now_ns();
+        i   = 0u;
+        while (i < m->armed.count) {
+            slot = *(const ce_u32*)ce_dynarray_at(&m->armed, i);
+            a    = &m->assets[slot];
+            if ((a->reload_at != 0u) && (a->reload_at > now)) {
+                i += 1u;
+            } else {
+                /* Due, or retired since it was armed. */
+                if ((a->reload_at != 0u) && (a->state == (ce_u32)CE_ASSET_STATE_READY)) {
+                    ce__asset_reload_mark(m, slot, CE_TRUE);
+                }
+                a->reload_at = 0u;
+                ce_dynarray_remove_swap(&m->armed, i);
+            }
+        }
+    }
+    ce_mutex_unlock(&m->mutex);
+}
+
+void ce_asset_manager_update(ce_asset_manager* manager)
+{
+    if (manager->watcher != CE_NULL) {
+        ce__asset_hot_reload(manager);
+    }
+    ce__asset_kick(manager);
+    if (manager->budget != 0u) {
+        ce__asset_evict(manager, manager->budget);
+    }
+}
+
+void ce_asset_manager_collect(ce_asset_manager* manager)
+{
+    ce__asset_evict(manager, 0u);
+}
+
+void ce_asset_manager_get_stats(ce_asset_manager* manager, ce_asset_manager_stats* out_stats)
+{
+    ce_mutex_lock(&manager->mutex);
+    *out_stats        = manager->stats;
+    out_stats->queued = manager->queued;
+    ce_mutex_unlock(&manager->mutex);
+}
+
+ce_result ce_asset_manager_watch(ce_asset_manager* manager, const ce_char* directory)
+{
+    ce_result res;
+    ce_fs_watcher* watcher;
+
+    res = CE_OK;
+    if ((manager == CE_NULL) || (directory == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_mutex_lock(&manager->mutex);
+        if (manager->watcher == CE_NULL) {
+            res = ce_fs_watcher_create(&watcher);
+            if (res == CE_OK) {
+                res = ce_dynarray_init(&manager->armed, sizeof(ce_u32), 16u, CE_MEM_TAG_ASSETS);
+                if (res == CE_OK) {
+                    manager->watcher = watcher;
+                } else {
+                    ce_fs_watcher_destroy(watcher);
+                }
+            }
+        }
+        if (res == CE_OK) {
+            res = ce_fs_watcher_add(manager->watcher, directory);
+        }
+        ce_mutex_unlock(&manager->mutex);
+    }
+
+    return res;
+}
+
+/* ************************************************************************** */
+/* ASSETS                                                                     */
+/* ************************************************************************** */
+
+ce_asset_id ce_asset_load(ce_asset_manager* manager, const ce_asset_request* request)
+{
+    ce__asset* a;
+    ce_asset_id id;
+    ce_u64 key;
+    ce_u64 found;
+    ce_u32 priority;
+    ce_u32 slot;
+    ce_u32 len;
+    ce_u32 deps[CE_ASSET_MAX_DEPS];
+    ce_u32 i;
+    ce_bool ok;
+
+    id = CE_ASSET_NONE;
+    ok = ((manager != CE_NULL) && (request != CE_NULL) && (request->path != CE_NULL) &&
+          (request->type < CE_ASSET_MAX_TYPES) && (request->dep_count <= CE_ASSET_MAX_DEPS) &&
+          ((request->deps != CE_NULL) || (request->dep_count == 0u)))
+             ? CE_TRUE
+             : CE_FALSE;
+
+    if (ok == CE_TRUE) {
+        priority = ((ce_u32)request->priority < CE_ASSET_PRIORITY_COUNT) ? (ce_u32)request->priority
+                                                                         : (ce_u32)CE_ASSET_PRIORITY_CRITICAL;
+        key      = ce__asset_key(request->type, request->path);
+        ce_mutex_lock(&manager->mutex);
+
+        for (i = 0u; (ok == CE_TRUE) && (i < request->dep_count); i++) {
+            deps[i] = ce_handle_table_resolve(&manager->handles, request->deps[i]);
+            ok      = (deps[i] != CE_HANDLE_INVALID) ? CE_TRUE : CE_FALSE;
+        }
+        ok = ((ok == CE_TRUE) && (manager->loaders[request->type].load != CE_NULL)) ? CE_TRUE : CE_FALSE;
+
+        slot = CE_HANDLE_INVALID;
+        if ((ok == CE_TRUE) && (ce_hashmap_get(&manager->by_key, key, &found) == CE_TRUE)) {
+            a = &manager->assets[(ce_u32)found];
+            len = (ce_u32)ce__strlen(request->path);
+            if ((a->type == request->type) && (ce__memcmp(a->path, request->path, (ce_size)len + 1u) == 0)) {
+                slot = (ce_u32)found;
+                if (a->refs == 0u) {
+                    /* Cached (READY) or orphaned (LOADING): revive it. */
+                    if (a->state == (ce_u32)CE_ASSET_STATE_READY) {
+                        ce__list_remove(manager, &manager->lru, slot);
+                        manager->stats.cached -= 1u;
+                    }
+                }
+                a->refs += 1u;
+                manager->stats.cache_hits += 1u;
+                ce__asset_raise(manager, slot, priority);
+                id = ce_handle_table_handle(&manager->handles, slot);
+            }
+        }
+
+        if ((ok == CE_TRUE) && (slot == CE_HANDLE_INVALID)) {
+            slot = ce_handle_table_alloc(&manager->handles);
+            if (slot != CE_HANDLE_INVALID) {
+                len = (ce_u32)ce__strlen(request->path);
+                a   = &manager->assets[slot];
+                a->path = (ce_char*)ce_mem_alloc((ce_size)len + 1u, 0u, CE_MEM_TAG_ASSETS);
+                if (a->path == CE_NULL) {
+                    ce_handle_table_free(&manager->handles, slot);
+                    slot = CE_HANDLE_INVALID;
+                }
+            }
+            if (slot != CE_HANDLE_INVALID) {
+                (void)ce__memcpy(a->path, request->path, (ce_size)len + 1u);
+                a->key          = key;
+                a->data         = CE_NULL;
+                a->bytes        = 0u;
+                a->type         = request->type;
+                a->state        = (ce_u32)CE_ASSET_STATE_QUEUED;
+                a->priority     = (ce_u32)CE_ASSET_PRIORITY_LOW;
+                a->refs         = 1u;
+                a->dep_count    = request->dep_count;
+                a->cancel       = CE_FALSE;
+                a->staged       = CE_NULL;
+                a->content_hash = 0u;
+                a->reload_at    = 0u;
+                a->reload       = (ce_u32)CE__RELOAD_NONE;
+                a->version      = 0u;
+                a->reload_self  = CE_FALSE;
+                for (i = 0u; i < request->dep_count; i++) {
+                    a->deps[i] = deps[i];
+                    manager->assets[deps[i]].refs += 1u;
+                    if ((manager->assets[deps[i]].refs == 1u) &&
+                        (manager->assets[deps[i]].state == (ce_u32)CE_ASSET_STATE_READY)) {
+                        ce__list_remove(manager, &manager->lru, deps[i]);
+                        manager->stats.cached -= 1u;
+                    }
+                }
+                ce__list_push(manager, &manager->queues[CE_ASSET_PRIORITY_LOW], slot);
+                manager->queued += 1u;
+                ce__asset_raise(manager, slot, priority);
+                (void)ce_hashmap_put(&manager->by_key, key, (ce_u64)slot);
+                id = ce_handle_table_handle(&manager->handles, slot);
+            }
+        }
+        ce_mutex_unlock(&manager->mutex);
+    }
+
+    if (id != CE_ASSET_NONE) {
+        ce__asset_kick(manager);
+    }
+    return id;
+}
+
+ce_result ce_asset_acquire(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_result res;
+    ce__asset* a;
+    ce_u32 slot;
+
+    res = CE_ERR_NOT_FOUND;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if (slot != CE_HANDLE_INVALID) {
+        a = &manager->assets[slot];
+        if ((a->refs == 0u) && (a->state == (ce_u32)CE_ASSET_STATE_READY)) {
+            ce__list_remove(manager, &manager->lru, slot);
+            manager->stats.cached -= 1u;
+        }
+        a->refs += 1u;
+        res = CE_OK;
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return res;
+}
+
+ce_result ce_asset_release(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_result res;
+    ce_u32 slot;
+
+    res = CE_ERR_NOT_FOUND;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if ((slot != CE_HANDLE_INVALID) && (manager->assets[slot].refs != 0u)) {
+        ce__asset_unref(manager, slot);
+        res = CE_OK;
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return res;
+}
+
+ce_result ce_asset_cancel(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_result res;
+    ce__asset* a;
+    ce_u32 slot;
+
+    res = CE_ERR_NOT_FOUND;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if (slot != CE_HANDLE_INVALID) {
+        a   = &manager->assets[slot];
+        res = CE_OK;
+        if (a->state == (ce_u32)CE_ASSET_STATE_QUEUED) {
+            ce__list_remove(manager, &manager->queues[a->priority], slot);
+            manager->queued -= 1u;
+            ce__asset_fail(manager, slot, CE_ASSET_STATE_CANCELLED);
+        } else if (a->state == (ce_u32)CE_ASSET_STATE_LOADING) {
+            a->cancel = CE_TRUE;
+            ce__asset_unmap(manager, slot);
+        } else {
+            res = CE_ERR_INVALID_ARG;
+        }
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return res;
+}
+
+ce_result ce_asset_set_priority(ce_asset_manager* manager, ce_asset_id asset, ce_asset_priority priority)
+{
+    ce_result res;
+    ce__asset* a;
+    ce_u32 slot;
+    ce_u32 i;
+
+    res = CE_ERR_NOT_FOUND;
+    if ((ce_u32)priority >= CE_ASSET_PRIORITY_COUNT) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        ce_mutex_lock(&manager->mutex);
+        slot = ce_handle_table_resolve(&manager->handles, asset);
+        if (slot != CE_HANDLE_INVALID) {
+            a = &manager->assets[slot];
+            if (a->state == (ce_u32)CE_ASSET_STATE_QUEUED) {
+                /* Lowering only affects this asset; raising also lifts its dependencies. */
+                ce__list_remove(manager, &manager->queues[a->priority], slot);
+                ce__list_push(manager, &manager->queues[(ce_u32)priority], slot);
+                a->priority = (ce_u32)priority;
+                for (i = 0u; i < a->dep_count; i++) {
+                    ce__asset_raise(manager, a->deps[i], (ce_u32)priority);
+                }
+            } else {
+                a->priority = (ce_u32)priority;
+            }
+            res = CE_OK;
+        }
+        ce_mutex_unlock(&manager->mutex);
+    }
+
+    return res;
+}
+
+ce_asset_state ce_asset_get_state(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_asset_state state;
+    ce_u32 slot;
+
+    state = CE_ASSET_STATE_INVALID;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if (slot != CE_HANDLE_INVALID) {
+        state = (ce_asset_state)manager->assets[slot].state;
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return state;
+}
+
+void* ce_asset_get(ce_asset_manager* manager, ce_asset_id asset)
+{
+    void* data;
+    ce_u32 slot;
+
+    data = CE_NULL;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if ((slot != CE_HANDLE_INVALID) && (manager->assets[slot].state == (ce_u32)CE_ASSET_STATE_READY)) {
+        data = manager->assets[slot].data;
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return data;
+}
+
+ce_u32 ce_asset_get_version(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_u32 version;
+    ce_u32 slot;
+
+    version = 0u;
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if (slot != CE_HANDLE_INVALID) {
+        version = manager->assets[slot].version;
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return version;
+}
+
+ce_asset_state ce_asset_wait(ce_asset_manager* manager, ce_asset_id asset)
+{
+    ce_asset_state state;
+    ce_u32 slot;
+
+    ce_mutex_lock(&manager->mutex);
+    slot = ce_handle_table_resolve(&manager->handles, asset);
+    if (slot != CE_HANDLE_INVALID) {
+        ce__asset_raise(manager, slot, (ce_u32)CE_ASSET_PRIORITY_CRITICAL);
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    ce__asset_kick(manager);
+
+    ce_mutex_lock(&manager->mutex);
+    state = CE_ASSET_STATE_INVALID;
+    slot  = ce_handle_table_resolve(&manager->handles, asset);
+    while (slot != CE_HANDLE_INVALID) {
+        state = (ce_asset_state)manager->assets[slot].state;
+        if ((state != CE_ASSET_STATE_QUEUED) && (state != CE_ASSET_STATE_LOADING)) {
+            break;
+        }
+        ce_cond_wait(&manager->settled, &manager->mutex);
+        slot = ce_handle_table_resolve(&manager->handles, asset);
+    }
+    ce_mutex_unlock(&manager->mutex);
+
+    return state;
+}
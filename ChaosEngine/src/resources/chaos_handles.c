@@ -9,8 +9,126 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_handles.c
- * @brief Implementation skeleton.
+ * @brief Generational handle tables.
  */
 #include "resources/chaos_handles.h"
 
-/* TODO: implement */
+/* Every slot free, in index order. */
+static void ce__handle_reset_free(ce_handle_table* table)
+{
+    ce_u32 i;
+
+    for (i = 0u; i < table->capacity; i++) {
+        table->alive_pos[i]  = CE_HANDLE_INVALID;
+        table->free_queue[i] = i;
+    }
+    table->free_head  = 0u;
+    table->free_count = table->capacity;
+}
+
+static inline void ce__handle_bump(ce_u32* generation)
+{
+    *generation += 1u;
+    /* Keep the 32-bit encoding of every issued handle non-zero. */
+    if ((*generation & CE_HANDLE_GEN_MASK) == 0u) {
+        *generation += 1u;
+    }
+}
+
+ce_result ce_handle_table_init(ce_handle_table* table, ce_u32 capacity, ce_mem_tag tag)
+{
+    ce_result res;
+    ce_u32* block;
+    ce_u32 i;
+
+    res = CE_OK;
+    if ((table == CE_NULL) || (capacity == 0u) || (capacity > CE_HANDLE_MAX_CAPACITY)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        /* One block, four arrays. */
+        block = (ce_u32*)ce_mem_alloc((ce_size)capacity * 4u * sizeof(ce_u32), (ce_size)64, tag);
+        if (block == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            table->generations = block;
+            table->alive_pos   = block + capacity;
+            table->alive       = block + ((ce_size)capacity * 2u);
+            table->free_queue  = block + ((ce_size)capacity * 3u);
+            table->capacity    = capacity;
+            table->tag         = tag;
+            table->alive_count = 0u;
+            for (i = 0u; i < capacity; i++) {
+                table->generations[i] = 1u;
+            }
+            ce__handle_reset_free(table);
+        }
+    }
+
+    return res;
+}
+
+void ce_handle_table_shutdown(ce_handle_table* table)
+{
+    if (table != CE_NULL) {
+        ce_mem_free(table->generations);
+        table->generations = CE_NULL;
+        table->alive_pos   = CE_NULL;
+        table->alive       = CE_NULL;
+        table->free_queue  = CE_NULL;
+        table->capacity    = 0u;
+        table->alive_count = 0u;
+        table->free_count  = 0u;
+    }
+}
+
+ce_u32 ce_handle_table_alloc(ce_handle_table* table)
+{
+    ce_u32 slot;
+
+    slot = CE_HANDLE_INVALID;
+    if (table->free_count != 0u) {
+        slot               = table->free_queue[table->free_head];
+        table->free_head   = (table->free_head + 1u == table->capacity) ? 0u : (table->free_head + 1u);
+        table->free_count -= 1u;
+
+        table->alive_pos[slot]           = table->alive_count;
+        table->alive[table->alive_count] = slot;
+        table->alive_count += 1u;
+    }
+
+    return slot;
+}
+
+void ce_handle_table_free(ce_handle_table* table, ce_u32 slot)
+{
+    ce_u32 pos;
+    ce_u32 last;
+    ce_u32 tail;
+
+    if ((slot < table->capacity) && (table->alive_pos[slot] != CE_HANDLE_INVALID)) {
+        pos  = table->alive_pos[slot];
+        last = table->alive[table->alive_count - 1u];
+
+        table->alive[pos]      = last;
+        table->alive_pos[last] = pos;
+        table->alive_pos[slot] = CE_HANDLE_INVALID;
+        table->alive_count -= 1u;
+        ce__handle_bump(&table->generations[slot]);
+
+        tail = table->free_head + table->free_count;
+        tail = (tail >= table->capacity) ? (tail - table->capacity) : tail;
+        table->free_queue[tail] = slot;
+        table->free_count += 1u;
+    }
+}
+
+void ce_handle_table_clear(ce_handle_table* table)
+{
+    ce_u32 i;
+
+    for (i = 0u; i < table->alive_count; i++) {
+        ce__handle_bump(&table->generations[table->alive[i]]);
+    }
+    table->alive_count = 0u;
+    ce__handle_reset_free(table);
+}
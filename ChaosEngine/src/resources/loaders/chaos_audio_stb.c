@@ -9,8 +9,443 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_audio_stb.c
- * @brief Implementation skeleton.
+ * @brief WAV / OGG Vorbis decoders.
+ *
+ * WAV (PCM 8/16/24/32-bit, IEEE float, WAVE_FORMAT_EXTENSIBLE) is parsed
+ * here. OGG Vorbis goes through stb_vorbis when third_party/stb provides it
+ * (CE_HAVE_STB_VORBIS); otherwise OGG files report CE_ERR_UNSUPPORTED.
  */
-#include "resources/chaos_assets.h"
+#include "audio/chaos_audio_stream.h"
+#include "core/chaos_memory.h"
+#include "utility/chaos_string.h"
 
-/* TODO: implement */
+#include <stdio.h>
+
+#if defined(CE_HAVE_STB_VORBIS)
+#include "stb_vorbis.c"
+#endif
+
+#define CE_WAV_FORMAT_PCM        0x0001u
+#define CE_WAV_FORMAT_FLOAT      0x0003u
+#define CE_WAV_FORMAT_EXTENSIBLE 0xFFFEu
+/** @brief Frames converted per raw read. */
+#define CE_WAV_SCRATCH_FRAMES    1024u
+
+typedef enum ce_audio_codec_e {
+    CE_AUDIO_CODEC_WAV = 0,
+    CE_AUDIO_CODEC_VORBIS
+} ce_audio_codec;
+
+struct ce_audio_decoder_s {
+    ce_audio_codec codec;
+    ce_audio_info  info;
+
+    /* Source: a file or a caller-owned memory image. */
+    FILE*          file;
+    const ce_u8*   memory;
+    ce_size        memory_size;
+
+    /* WAV. */
+    ce_u64         data_offset;
+    ce_u64         cursor;      /**< Next frame to decode. */
+    ce_u32         block_align;
+    ce_u32         bits;
+    ce_bool        is_float;
+    ce_u8*         scratch;
+
+#if defined(CE_HAVE_STB_VORBIS)
+    stb_vorbis*    vorbis;
+#endif
+};
+
+/* ************************************************************************** */
+/* SOURCE                                                                     */
+/* ************************************************************************** */
+
+static ce_size ce__source_read(ce_audio_decoder* dec, ce_u64 offset, void* dst, ce_size bytes)
+{
+    ce_size got;
+
+    got = (ce_size)0;
+    if (dec->file != CE_NULL) {
+        if (fseek(dec->file, (long)offset, SEEK_SET) == 0) {
+            got = (ce_size)fread(dst, 1u, (size_t)bytes, dec->file);
+        }
+    } else if (offset < (ce_u64)dec->memory_size) {
+        got = ((ce_u64)bytes < ((ce_u64)dec->memory_size - offset)) ? bytes : (ce_size)((ce_u64)dec->memory_size - offset);
+        (void)ce__memcpy(dst, &dec->memory[offset], got);
+    } else {
+        /* Past the end of the memory image. */
+    }
+
+    return got;
+}
+
+static inline ce_u32 ce__le16(const ce_u8* p)
+{
+    return (ce_u32)p[0] | ((ce_u32)p[1] << 8u);
+}
+
+static inline ce_u32 ce__le32(const ce_u8* p)
+{
+    return (ce_u32)p[0] | ((ce_u32)p[1] << 8u) | ((ce_u32)p[2] << 16u) | ((ce_u32)p[3] << 24u);
+}
+
+/* ************************************************************************** */
+/* WAV                                                                        */
+/* ************************************************************************** */
+
+/**
+ * @brief Walks the RIFF chunks for "fmt " and "data".
+ */
+static ce_result ce__wav_parse(ce_audio_decoder* dec)
+{
+    ce_u8 header[12];
+    ce_u8 fmt[40];
+    ce_u64 offset;
+    ce_u64 data_bytes;
+    ce_u32 chunk_size;
+    ce_u32 format;
+    ce_bool have_fmt;
+    ce_bool have_data;
+    ce_result res;
+
+    res       = CE_OK;
+    have_fmt  = CE_FALSE;
+    have_data = CE_FALSE;
+    format    = 0u;
+    data_bytes = 0u;
+
+    if ((ce__source_read(dec, 0u, header, sizeof(header)) != sizeof(header)) ||
+        (ce__memcmp(header, "RIFF", 4u) != 0) || (ce__memcmp(&header[8], "WAVE", 4u) != 0)) {
+        res = CE_ERR_FORMAT;
+    }
+
+    offset = 12u;
+    while ((res == CE_OK) && ((have_fmt == CE_FALSE) || (have_data == CE_FALSE)) &&
+           (ce__source_read(dec, offset, header, 8u) == (ce_size)8)) {
+        chunk_size = ce__le32(&header[4]);
+
+        if (ce__memcmp(header, "fmt ", 4u) == 0) {
+            (void)ce__memset(fmt, 0u, sizeof(fmt));
+            if ((chunk_size < 16u) ||
+                (ce__source_read(dec, offset + 8u, fmt, (chunk_size < sizeof(fmt)) ? chunk_size : sizeof(fmt)) <
+                 (ce_size)16)) {
+                res = CE_ERR_FORMAT;
+            } else {
+                format                  = ce__le16(&fmt[0]);
+                dec->info.channel_count = ce__le16(&fmt[2]);
+                dec->info.sample_rate   = ce__le32(&fmt[4]);
+                dec->block_align        = ce__le16(&fmt[12]);
+                dec->bits               = ce__le16(&fmt[14]);
+                if ((format == CE_WAV_FORMAT_EXTENSIBLE) && (chunk_size >= 26u)) {
+                    /* First two bytes of the sub-format GUID carry the real tag. */
+                    format = ce__le16(&fmt[24]);
+                }
+                have_fmt = CE_TRUE;
+            }
+        } else if (ce__memcmp(header, "data", 4u) == 0) {
+            dec->data_offset = offset + 8u;
+            data_bytes       = chunk_size;
+            have_data        = CE_TRUE;
+        } else {
+            /* LIST, fact, cue... */
+        }
+
+        /* Chunks are word aligned. */
+        offset += 8u + (ce_u64)chunk_size + (ce_u64)(chunk_size & 1u);
+    }
+
+    if ((res == CE_OK) && ((have_fmt == CE_FALSE) || (have_data == CE_FALSE))) {
+        res = CE_ERR_FORMAT;
+    }
+
+    if (res == CE_OK) {
+        dec->is_float = (format == CE_WAV_FORMAT_FLOAT) ? CE_TRUE : CE_FALSE;
+        if ((dec->info.channel_count == 0u) || (dec->info.channel_count > 2u) || (dec->info.sample_rate == 0u) ||
+            ((format != CE_WAV_FORMAT_PCM) && (format != CE_WAV_FORMAT_FLOAT)) ||
+            ((dec->is_float == CE_TRUE) && (dec->bits != 32u)) ||
+            ((dec->is_float == CE_FALSE) && (dec->bits != 8u) && (dec->bits != 16u) && (dec->bits != 24u) &&
+             (dec->bits != 32u)) ||
+            (dec->block_align != ((dec->bits / 8u) * dec->info.channel_count))) {
+            res = CE_ERR_UNSUPPORTED;
+        }
+    }
+
+    if (res == CE_OK) {
+        dec->info.frame_count = data_bytes / dec->block_align;
+        dec->scratch          = (ce_u8*)ce_mem_alloc((ce_size)CE_WAV_SCRATCH_FRAMES * dec->block_align, (ce_size)16,
+                                                     CE_MEM_TAG_AUDIO);
+        if (dec->scratch == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * @brief Converts interleaved integer / float samples to planar float.
+ */
+static void ce__wav_convert(const ce_audio_decoder* dec, const ce_u8* src, ce_f32* const channels[2], ce_u32 frames)
+{
+    const ce_u8* p;
+    ce_u32 bytes;
+    ce_u32 f;
+    ce_u32 c;
+    ce_u32 raw;
+    ce_f32 v;
+
+    bytes = dec->bits / 8u;
+    p     = src;
+
+    for (f = 0u; f < frames; f++) {
+        for (c = 0u; c < dec->info.channel_count; c++) {
+            if (dec->is_float == CE_TRUE) {
+                raw = ce__le32(p);
+                (void)ce__memcpy(&v, &raw, sizeof(v));
+            } else if (bytes == 1u) {
+                v = ((ce_f32)p[0] - 128.0f) * (1.0f / 128.0f);
+            } else if (bytes == 2u) {
+                v = (ce_f32)(ce_s16)ce__le16(p) * (1.0f / 32768.0f);
+            } else if (bytes == 3u) {
+                /* Place the 24 bits at the top of an s32 to sign-extend. */
+                raw = ((ce_u32)p[0] << 8u) | ((ce_u32)p[1] << 16u) | ((ce_u32)p[2] << 24u);
+                v   = (ce_f32)(ce_s32)raw * (1.0f / 2147483648.0f);
+            } else {
+                v = (ce_f32)(ce_s32)ce__le32(p) * (1.0f / 2147483648.0f);
+            }
+            channels[c][f] = v;
+            p             += bytes;
+        }
+    }
+}
+
+static ce_u32 ce__wav_read(ce_audio_decoder* dec, ce_f32* const channels[2], ce_u32 frames)
+{
+    ce_f32* part[2];
+    ce_u64 left;
+    ce_u32 done;
+    ce_u32 want;
+    ce_u32 got;
+
+    done = 0u;
+    left = dec->info.frame_count - dec->cursor;
+    if ((ce_u64)frames > left) {
+        frames = (ce_u32)left;
+    }
+
+    while (done < frames) {
+        want = ((frames - done) < CE_WAV_SCRATCH_FRAMES) ? (frames - done) : CE_WAV_SCRATCH_FRAMES;
+        got  = (ce_u32)(ce__source_read(dec, dec->data_offset + (dec->cursor * dec->block_align), dec->scratch,
+                                        (ce_size)want * dec->block_align) /
+                       dec->block_align);
+        if (got == 0u) {
+            break;
+        }
+
+        part[0] = &channels[0][done];
+        part[1] = (dec->info.channel_count == 2u) ? &channels[1][done] : CE_NULL;
+        ce__wav_convert(dec, dec->scratch, part, got);
+        dec->cursor += got;
+        done        += got;
+    }
+
+    return done;
+}
+
+/* ************************************************************************** */
+/* OPEN / CLOSE                                                               */
+/* ************************************************************************** */
+
+#if defined(CE_HAVE_STB_VORBIS)
+static ce_result ce__vorbis_open(ce_audio_decoder* dec, const ce_char* path)
+{
+    stb_vorbis_info vi;
+    int err;
+    ce_result res;
+
+    res = CE_OK;
+    if (path != CE_NULL) {
+        dec->vorbis = stb_vorbis_open_filename(path, &err, CE_NULL);
+    } else {
+        dec->vorbis = stb_vorbis_open_memory(dec->memory, (int)dec->memory_size, &err, CE_NULL);
+    }
+
+    if (dec->vorbis == CE_NULL) {
+        res = CE_ERR_FORMAT;
+    } else {
+        vi                      = stb_vorbis_get_info(dec->vorbis);
+        dec->codec              = CE_AUDIO_CODEC_VORBIS;
+        dec->info.channel_count = (ce_u32)vi.channels;
+        dec->info.sample_rate   = vi.sample_rate;
+        dec->info.frame_count   = (ce_u64)stb_vorbis_stream_length_in_samples(dec->vorbis);
+        if ((vi.channels < 1) || (vi.channels > 2)) {
+            res = CE_ERR_UNSUPPORTED;
+        }
+    }
+
+    return res;
+}
+#endif
+
+/**
+ * @brief Identifies the container from its magic and opens the codec.
+ */
+static ce_result ce__decoder_open(ce_audio_decoder* dec, const ce_char* path)
+{
+    ce_u8 magic[4];
+    ce_result res;
+
+    if (ce__source_read(dec, 0u, magic, sizeof(magic)) != sizeof(magic)) {
+        res = CE_ERR_FORMAT;
+    } else if (ce__memcmp(magic, "RIFF", 4u) == 0) {
+        dec->codec = CE_AUDIO_CODEC_WAV;
+        res        = ce__wav_parse(dec);
+    } else if (ce__memcmp(magic, "OggS", 4u) == 0) {
+#if defined(CE_HAVE_STB_VORBIS)
+        if (dec->file != CE_NULL) {
+            /* stb_vorbis owns its own FILE*. */
+            (void)fclose(dec->file);
+            dec->file = CE_NULL;
+        }
+        res = ce__vorbis_open(dec, path);
+#else
+        (void)path;
+        res = CE_ERR_UNSUPPORTED;
+#endif
+    } else {
+        res = CE_ERR_FORMAT;
+    }
+
+    return res;
+}
+
+ce_result ce_audio_decoder_open_file(const ce_char* path, ce_audio_decoder** out_decoder)
+{
+    ce_audio_decoder* dec;
+    ce_result res;
+
+    dec = CE_NULL;
+    res = CE_OK;
+
+    if ((path == CE_NULL) || (out_decoder == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        dec = (ce_audio_decoder*)ce_mem_calloc(sizeof(ce_audio_decoder), 0u, CE_MEM_TAG_AUDIO);
+        if (dec == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        dec->file = fopen(path, "rb");
+        res       = (dec->file != CE_NULL) ? ce__decoder_open(dec, path) : CE_ERR_IO;
+    }
+
+    if ((res != CE_OK) && (dec != CE_NULL)) {
+        ce_audio_decoder_close(dec);
+        dec = CE_NULL;
+    }
+    if (out_decoder != CE_NULL) {
+        *out_decoder = dec;
+    }
+
+    return res;
+}
+
+ce_result ce_audio_decoder_open_memory(const void* data, ce_size size, ce_audio_decoder** out_decoder)
+{
+    ce_audio_decoder* dec;
+    ce_result res;
+
+    dec = CE_NULL;
+    res = CE_OK;
+
+    if ((data == CE_NULL) || (size == (ce_size)0) || (out_decoder == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        dec = (ce_audio_decoder*)ce_mem_calloc(sizeof(ce_audio_decoder), 0u, CE_MEM_TAG_AUDIO);
+        if (dec == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        dec->memory      = (const ce_u8*)data;
+        dec->memory_size = size;
+        res              = ce__decoder_open(dec, CE_NULL);
+    }
+
+    if ((res != CE_OK) && (dec != CE_NULL)) {
+        ce_audio_decoder_close(dec);
+        dec = CE_NULL;
+    }
+    if (out_decoder != CE_NULL) {
+        *out_decoder = dec;
+    }
+
+    return res;
+}
+
+void ce_audio_decoder_close(ce_audio_decoder* decoder)
+{
+    if (decoder != CE_NULL) {
+#if defined(CE_HAVE_STB_VORBIS)
+        if (decoder->vorbis != CE_NULL) {
+            stb_vorbis_close(decoder->vorbis);
+        }
+#endif
+        if (decoder->file != CE_NULL) {
+            (void)fclose(decoder->file);
+        }
+        ce_mem_free(decoder->scratch);
+        ce_mem_free(decoder);
+    }
+}
+
+void ce_audio_decoder_get_info(const ce_audio_decoder* decoder, ce_audio_info* out_info)
+{
+    *out_info = decoder->info;
+}
+
+/* ************************************************************************** */
+/* DECODE                                                                     */
+/* ************************************************************************** */
+
+ce_u32 ce_audio_decoder_read(ce_audio_decoder* decoder, ce_f32* const channels[2], ce_u32 frames)
+{
+    ce_u32 done;
+
+#if defined(CE_HAVE_STB_VORBIS)
+    if (decoder->codec == CE_AUDIO_CODEC_VORBIS) {
+        done = (ce_u32)stb_vorbis_get_samples_float(decoder->vorbis, (int)decoder->info.channel_count,
+                                                    (float**)channels, (int)frames);
+    } else
+#endif
+    {
+        done = ce__wav_read(decoder, channels, frames);
+    }
+
+    return done;
+}
+
+ce_result ce_audio_decoder_seek(ce_audio_decoder* decoder, ce_u64 frame)
+{
+    ce_result res;
+
+    res = CE_OK;
+    if ((decoder->info.frame_count != 0u) && (frame > decoder->info.frame_count)) {
+        res = CE_ERR_INVALID_ARG;
+    }
+#if defined(CE_HAVE_STB_VORBIS)
+    else if (decoder->codec == CE_AUDIO_CODEC_VORBIS) {
+        res = (stb_vorbis_seek(decoder->vorbis, (unsigned int)frame) != 0) ? CE_OK : CE_ERR_IO;
+    }
+#endif
+    else {
+        decoder->cursor = frame;
+    }
+
+    return res;
+}
@@ -0,0 +1,1028 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_ecs.c
+ * @brief Archetype storage, chunk iteration and the system scheduler.
+ *
+ * An archetype keeps its entities packed: row r lives in chunk r / capacity
+ * at index r % capacity, and every chunk but the last is full. Removing a
+ * row moves the archetype's last row into the hole, so iteration never
+ * meets a gap. Empty chunks go to a world-wide free list; all chunks share
+ * one size, so any archetype can reuse them.
+ *
+ * Systems form a DAG: each one waits for the earlier systems it conflicts
+ * with. A finishing system job submits the successors it unblocked, so
+ * independent chains never wait on each other at a barrier.
+ */
+#include "runtime/chaos_ecs.h"
+#include "runtime/chaos_jobs.h"
+#include "core/chaos_containers.h"
+#include "core/chaos_memory.h"
+#include "platform/chaos_thread.h"
+#include "utility/chaos_string.h"
+
+/** @brief Chunk alignment: the largest component alignment accepted. */
+#define CE__ECS_CHUNK_ALIGN   64u
+/** @brief Archetype index of "no archetype" (uncached edge). */
+#define CE__ECS_NO_ARCHETYPE  0xFFFFFFFFu
+/** @brief Archetype index of the empty component set. */
+#define CE__ECS_EMPTY         0u
+#define CE__ECS_SYSTEM_WORDS  (CE_ECS_MAX_SYSTEMS / 64u)
+
+/* ************************************************************************** */
+/* STATE                                                                      */
+/* ************************************************************************** */
+
+typedef enum ce__ecs_op_e {
+    CE__ECS_OP_DESTROY = 0,
+    CE__ECS_OP_ADD,
+    CE__ECS_OP_REMOVE
+} ce__ecs_op;
+
+typedef struct ce__ecs_command_s {
+    ce_u32          op;
+    ce_entity       entity;
+    ce_component_id id;
+} ce__ecs_command;
+
+typedef struct ce__ecs_component_s {
+    const ce_char* name;
+    ce_u32         size;
+    ce_u32         align;
+} ce__ecs_component;
+
+typedef struct ce__ecs_archetype_s {
+    ce_ecs_mask mask;
+    ce_u32      offsets[CE_ECS_MAX_COMPONENTS];     /**< Column offsets by component id; entities at 0. */
+    ce_u32      add_edge[CE_ECS_MAX_COMPONENTS];    /**< Archetype with the component added (cached). */
+    ce_u32      remove_edge[CE_ECS_MAX_COMPONENTS]; /**< Archetype with the component removed (cached). */
+    ce_u8       ids[CE_ECS_MAX_COMPONENTS];         /**< Present components, ascending. */
+    ce_u32      id_count;
+    ce_u32      capacity;                           /**< Rows per chunk. */
+    ce_u32      count;                              /**< Rows over all chunks. */
+    ce_dynarray chunks;                             /**< ce_u8*, exactly ceil(count / capacity). */
+} ce__ecs_archetype;
+
+typedef struct ce__ecs_system_s {
+    ce_ecs_world*      world;
+    ce_ecs_system_desc desc;
+    ce_ecs_mask        reads;
+    ce_ecs_mask        writes;
+    ce_dynarray        matched;     /**< ce_u32 archetype indices. */
+    ce_dynarray        first_chunk; /**< ce_u32, running chunk total before matched[i]. */
+    ce_u32             scanned;     /**< Archetypes already tested (archetypes are never removed). */
+    ce_u32             chunk_total;
+    ce_u64             successors[CE__ECS_SYSTEM_WORDS];
+    ce_u32             dep_count;
+    ce_atomic_u32      remaining;
+} ce__ecs_system;
+
+struct ce_ecs_world_s {
+    ce_handle_table   entities;
+    ce_u32*           entity_arch;  /**< Slot -> archetype index. */
+    ce_u32*           entity_row;   /**< Slot -> row in its archetype. */
+    ce__ecs_component components[CE_ECS_MAX_COMPONENTS];
+    ce_u32            component_count;
+    ce_dynarray       archetypes;   /**< ce__ecs_archetype*, stable addresses. */
+    ce_hashmap        by_mask;      /**< Non-empty mask -> archetype index. */
+    ce_dynarray       free_chunks;  /**< ce_u8*. */
+    ce__ecs_system    systems[CE_ECS_MAX_SYSTEMS];
+    ce_u32            system_count;
+    ce_bool           graph_dirty;
+    ce_bool           running;
+    ce_job_counter    jobs;
+    ce_mutex          deferred_lock;
+    ce_dynarray       deferred;     /**< ce__ecs_command. */
+};
+
+/* ************************************************************************** */
+/* CHUNKS                                                                     */
+/* ************************************************************************** */
+
+static ce__ecs_archetype* ce__ecs_arch(const ce_ecs_world* world, ce_u32 index)
+{
+    return CE_DYNARRAY_AT(&world->archetypes, ce__ecs_archetype*, index);
+}
+
+static ce_u8* ce__ecs_chunk_acquire(ce_ecs_world* world)
+{
+    ce_u8* chunk;
+    ce_size count;
+
+    count = world->free_chunks.count;
+    if (count != 0u) {
+        chunk = CE_DYNARRAY_AT(&world->free_chunks, ce_u8*, count - 1u);
+        (void)ce_dynarray_resize(&world->free_chunks, count - 1u);
+    } else {
+        chunk = (ce_u8*)ce_mem_alloc(CE_ECS_CHUNK_BYTES, CE__ECS_CHUNK_ALIGN, CE_MEM_TAG_RUNTIME);
+    }
+
+    return chunk;
+}
+
+static void ce__ecs_chunk_release(ce_ecs_world* world, ce_u8* chunk)
+{
+    if (ce_dynarray_push(&world->free_chunks, &chunk) == CE_NULL) {
+        ce_mem_free(chunk);
+    }
+}
+
+/* Address of `row` in the column at `offset` whose elements are `size` bytes. */
+static ce_u8* ce__ecs_cell(const ce__ecs_archetype* arch, ce_u32 row, ce_u32 offset, ce_u32 size)
+{
+    ce_u8* chunk;
+
+    chunk = CE_DYNARRAY_AT(&arch->chunks, ce_u8*, row / arch->capacity);
+    return chunk + offset + ((ce_size)(row % arch->capacity) * (ce_size)size);
+}
+
+static ce_entity* ce__ecs_entity_cell(const ce__ecs_archetype* arch, ce_u32 row)
+{
+    return (ce_entity*)(void*)ce__ecs_cell(arch, row, 0u, (ce_u32)sizeof(ce_entity));
+}
+
+/* ************************************************************************** */
+/* ARCHETYPES                                                                 */
+/* ************************************************************************** */
+
+/**
+ * @brief Picks the largest row count whose columns fit one chunk and lays
+ *        the columns out back to back.
+ * @return Rows per chunk (0 when a single row does not fit).
+ */
+static ce_u32 ce__ecs_layout(const ce_ecs_world* world, ce__ecs_archetype* arch)
+{
+    const ce__ecs_component* c;
+    ce_size row_bytes;
+    ce_size offset;
+    ce_u32 capacity;
+    ce_bool fits;
+    ce_u32 i;
+
+    row_bytes = sizeof(ce_entity);
+    for (i = 0u; i < arch->id_count; i++) {
+        row_bytes += (ce_size)world->components[arch->ids[i]].size;
+    }
+
+    /* Alignment padding can cost a few rows; shrink until it fits. */
+    capacity = (ce_u32)((ce_size)CE_ECS_CHUNK_BYTES / row_bytes);
+    fits     = CE_FALSE;
+    while ((capacity != 0u) && (fits == CE_FALSE)) {
+        offset = (ce_size)capacity * sizeof(ce_entity);
+        for (i = 0u; i < arch->id_count; i++) {
+            c                           = &world->components[arch->ids[i]];
+            offset                      = CE_ALIGN_UP(offset, (ce_size)c->align);
+            arch->offsets[arch->ids[i]] = (ce_u32)offset;
+            offset                     += (ce_size)capacity * (ce_size)c->size;
+        }
+        if (offset <= (ce_size)CE_ECS_CHUNK_BYTES) {
+            fits = CE_TRUE;
+        } else {
+            capacity -= 1u;
+        }
+    }
+    arch->capacity = capacity;
+
+    return capacity;
+}
+
+static ce_result ce__ecs_archetype_new(ce_ecs_world* world, ce_ecs_mask mask, ce_u32* out_index)
+{
+    ce__ecs_archetype* arch;
+    ce_result res;
+    ce_u32 index;
+    ce_u32 id;
+
+    res  = CE_OK;
+    arch = (ce__ecs_archetype*)ce_mem_calloc(sizeof(ce__ecs_archetype), 0u, CE_MEM_TAG_RUNTIME);
+    if (arch == CE_NULL) {
+        res = CE_ERR_OUT_OF_MEMORY;
+    } else {
+        arch->mask = mask;
+        for (id = 0u; id < CE_ECS_MAX_COMPONENTS; id++) {
+            arch->offsets[id]     = CE_ECS_NO_COLUMN;
+            arch->add_edge[id]    = CE__ECS_NO_ARCHETYPE;
+            arch->remove_edge[id] = CE__ECS_NO_ARCHETYPE;
+            if ((mask & CE_ECS_BIT(id)) != 0u) {
+                arch->ids[arch->id_count] = (ce_u8)id;
+                arch->id_count           += 1u;
+            }
+        }
+        res = (ce__ecs_layout(world, arch) != 0u) ? CE_OK : CE_ERR_INVALID_ARG;
+    }
+
+    if (res == CE_OK) {
+        res = ce_dynarray_init(&arch->chunks, sizeof(ce_u8*), 4u, CE_MEM_TAG_RUNTIME);
+        if (res == CE_OK) {
+            index = (ce_u32)world->archetypes.count;
+            if (ce_dynarray_push(&world->archetypes, &arch) == CE_NULL) {
+                res = CE_ERR_OUT_OF_MEMORY;
+            } else if (mask != 0u) {
+                res = ce_hashmap_put(&world->by_mask, mask, (ce_u64)index);
+                if (res != CE_OK) {
+                    (void)ce_dynarray_resize(&world->archetypes, (ce_size)index);
+                }
+            } else {
+                /* The empty archetype is always index 0 and not hashed. */
+            }
+            if (res != CE_OK) {
+                ce_dynarray_shutdown(&arch->chunks);
+            }
+        }
+    }
+
+    if (res == CE_OK) {
+        *out_index = index;
+    } else {
+        ce_mem_free(arch);
+    }
+
+    return res;
+}
+
+static ce_result ce__ecs_archetype_find(ce_ecs_world* world, ce_ecs_mask mask, ce_u32* out_index)
+{
+    ce_result res;
+    ce_u64 found;
+
+    res = CE_OK;
+    if (mask == 0u) {
+        *out_index = CE__ECS_EMPTY;
+    } else if (ce_hashmap_get(&world->by_mask, mask, &found) == CE_TRUE) {
+        *out_index = (ce_u32)found;
+    } else {
+        res = ce__ecs_archetype_new(world, mask, out_index);
+    }
+
+    return res;
+}
+
+/**
+ * @brief Appends an uninitialized row holding `entity`.
+ */
+static ce_result ce__ecs_row_push(ce_ecs_world* world, ce__ecs_archetype* arch, ce_entity entity, ce_u32* out_row)
+{
+    ce_result res;
+    ce_u8* chunk;
+
+    res = CE_OK;
+    if (arch->count == ((ce_u32)arch->chunks.count * arch->capacity)) {
+        chunk = ce__ecs_chunk_acquire(world);
+        if (chunk == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else if (ce_dynarray_push(&arch->chunks, &chunk) == CE_NULL) {
+            ce__ecs_chunk_release(world, chunk);
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            /* New chunk in place. */
+        }
+    }
+
+    if (res == CE_OK) {
+        *ce__ecs_entity_cell(arch, arch->count) = entity;
+        *out_row                                = arch->count;
+        arch->count                            += 1u;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Fills `row` with the archetype's last row and shrinks it by one.
+ */
+static void ce__ecs_row_remove(ce_ecs_world* world, ce__ecs_archetype* arch, ce_u32 row)
+{
+    ce_entity moved;
+    ce_u8* chunk;
+    ce_u32 last;
+    ce_u32 size;
+    ce_u32 id;
+    ce_u32 i;
+
+    last = arch->count - 1u;
+    if (row != last) {
+        moved                              = *ce__ecs_entity_cell(arch, last);
+        *ce__ecs_entity_cell(arch, row)    = moved;
+        world->entity_row[moved & CE_HANDLE_INDEX_MASK] = row;
+        for (i = 0u; i < arch->id_count; i++) {
+            id   = arch->ids[i];
+            size = world->components[id].size;
+            if (size != 0u) {
+                ce__memcpy(ce__ecs_cell(arch, row, arch->offsets[id], size),
+                           ce__ecs_cell(arch, last, arch->offsets[id], size), (ce_size)size);
+            }
+        }
+    }
+    arch->count = last;
+
+    if (arch->count == (((ce_u32)arch->chunks.count - 1u) * arch->capacity)) {
+        chunk = CE_DYNARRAY_AT(&arch->chunks, ce_u8*, arch->chunks.count - 1u);
+        (void)ce_dynarray_resize(&arch->chunks, arch->chunks.count - 1u);
+        ce__ecs_chunk_release(world, chunk);
+    }
+}
+
+/**
+ * @brief Moves a live entity to archetype `dst_index`, carrying over the
+ *        shared components and zeroing the new ones.
+ */
+static ce_result ce__ecs_move(ce_ecs_world* world, ce_u32 slot, ce_u32 dst_index)
+{
+    ce__ecs_archetype* src;
+    ce__ecs_archetype* dst;
+    ce_result res;
+    ce_u8* cell;
+    ce_u32 src_row;
+    ce_u32 row;
+    ce_u32 size;
+    ce_u32 id;
+    ce_u32 i;
+
+    src     = ce__ecs_arch(world, world->entity_arch[slot]);
+    dst     = ce__ecs_arch(world, dst_index);
+    src_row = world->entity_row[slot];
+    res     = ce__ecs_row_push(world, dst, *ce__ecs_entity_cell(src, src_row), &row);
+
+    if (res == CE_OK) {
+        for (i = 0u; i < dst->id_count; i++) {
+            id   = dst->ids[i];
+            size = world->components[id].size;
+            if (size != 0u) {
+                cell = ce__ecs_cell(dst, row, dst->offsets[id], size);
+                if (src->offsets[id] != CE_ECS_NO_COLUMN) {
+                    ce__memcpy(cell, ce__ecs_cell(src, src_row, src->offsets[id], size), (ce_size)size);
+                } else {
+                    ce__memset(cell, 0u, (ce_size)size);
+                }
+            }
+        }
+        ce__ecs_row_remove(world, src, src_row);
+        world->entity_arch[slot] = dst_index;
+        world->entity_row[slot]  = row;
+    }
+
+    return res;
+}
+
+static ce_bool ce__ecs_matches(ce_ecs_mask mask, const ce_ecs_query* query)
+{
+    ce_ecs_mask required;
+
+    required = query->read | query->write;
+    return (((mask & required) == required) && ((mask & query->exclude) == 0u)) ? CE_TRUE : CE_FALSE;
+}
+
+static void ce__ecs_visit(const ce__ecs_archetype* arch, ce_u32 chunk, ce_ecs_chunk_fn fn, void* user)
+{
+    ce_ecs_view view;
+    ce_u32 rest;
+
+    rest          = arch->count - (chunk * arch->capacity);
+    view.data     = CE_DYNARRAY_AT(&arch->chunks, ce_u8*, chunk);
+    view.entities = (const ce_entity*)(const void*)view.data;
+    view.count    = (rest < arch->capacity) ? rest : arch->capacity;
+    view.offsets  = arch->offsets;
+    fn(user, &view);
+}
+
+/* ************************************************************************** */
+/* SCHEDULER                                                                  */
+/* ************************************************************************** */
+
+static ce_bool ce__ecs_conflict(const ce__ecs_system* a, const ce__ecs_system* b)
+{
+    return (((a->writes & (b->reads | b->writes)) | (b->writes & a->reads)) != 0u) ? CE_TRUE : CE_FALSE;
+}
+
+static void ce__ecs_build_graph(ce_ecs_world* world)
+{
+    ce__ecs_system* sys;
+    ce_u32 i;
+    ce_u32 j;
+
+    for (j = 0u; j < world->system_count; j++) {
+        sys            = &world->systems[j];
+        sys->dep_count = 0u;
+        ce__memset(sys->successors, 0u, sizeof(sys->successors));
+    }
+    /* Redundant transitive edges are harmless: they only count down. */
+    for (j = 0u; j < world->system_count; j++) {
+        for (i = 0u; i < j; i++) {
+            if (ce__ecs_conflict(&world->systems[i], &world->systems[j]) == CE_TRUE) {
+                world->systems[i].successors[j / 64u] |= (1ull << (j % 64u));
+                world->systems[j].dep_count           += 1u;
+            }
+        }
+    }
+    world->graph_dirty = CE_FALSE;
+}
+
+/**
+ * @brief Tests archetypes created since the last run and recounts chunks.
+ *
+ * On allocation failure the scan stops and is retried on the next run.
+ */
+static void ce__ecs_system_prepare(ce_ecs_world* world, ce__ecs_system* sys)
+{
+    ce_u32 index;
+    ce_u32 total;
+    ce_bool ok;
+    ce_u32 i;
+
+    ok = CE_TRUE;
+    while ((ok == CE_TRUE) && (sys->scanned < (ce_u32)world->archetypes.count)) {
+        index = sys->scanned;
+        if (ce__ecs_matches(ce__ecs_arch(world, index)->mask, &sys->desc.query) == CE_TRUE) {
+            if (ce_dynarray_push(&sys->matched, &index) == CE_NULL) {
+                ok = CE_FALSE;
+            } else if (ce_dynarray_push(&sys->first_chunk, &index) == CE_NULL) {
+                (void)ce_dynarray_resize(&sys->matched, sys->matched.count - 1u);
+                ok = CE_FALSE;
+            } else {
+                /* Matched. */
+            }
+        }
+        sys->scanned += (ok == CE_TRUE) ? 1u : 0u;
+    }
+
+    total = 0u;
+    for (i = 0u; i < (ce_u32)sys->matched.count; i++) {
+        CE_DYNARRAY_AT(&sys->first_chunk, ce_u32, i) = total;
+        total += (ce_u32)ce__ecs_arch(world, CE_DYNARRAY_AT(&sys->matched, ce_u32, i))->chunks.count;
+    }
+    sys->chunk_total = total;
+}
+
+/* Chunks [begin, end) of the system's matched archetypes, in order. */
+static void ce__ecs_system_range(void* user, ce_u32 begin, ce_u32 end)
+{
+    const ce__ecs_system* sys;
+    const ce_u32* first;
+    ce_u32 count;
+    ce_u32 lo;
+    ce_u32 hi;
+    ce_u32 mid;
+    ce_u32 k;
+
+    sys   = (const ce__ecs_system*)user;
+    first = (const ce_u32*)sys->first_chunk.data;
+    count = (ce_u32)sys->matched.count;
+
+    /* Last archetype starting at or before `begin`. */
+    lo = 0u;
+    hi = count;
+    while ((hi - lo) > 1u) {
+        mid = lo + ((hi - lo) / 2u);
+        if (first[mid] <= begin) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (k = begin; k < end; k++) {
+        while (((lo + 1u) < count) && (first[lo + 1u] <= k)) {
+            lo += 1u;
+        }
+        ce__ecs_visit(ce__ecs_arch(sys->world, CE_DYNARRAY_AT(&sys->matched, ce_u32, lo)), k - first[lo],
+                      sys->desc.fn, sys->desc.user);
+    }
+}
+
+static void ce__ecs_system_job(void* user)
+{
+    ce__ecs_system* sys;
+    ce__ecs_system* next;
+    ce_ecs_world* world;
+    ce_u32 j;
+
+    sys   = (ce__ecs_system*)user;
+    world = sys->world;
+
+    if (sys->desc.chunk_batch == 0u) {
+        ce__ecs_system_range(sys, 0u, sys->chunk_total);
+    } else {
+        ce_jobs_parallel_for(sys->chunk_total, sys->desc.chunk_batch, ce__ecs_system_range, sys);
+    }
+
+    for (j = 0u; j < world->system_count; j++) {
+        if ((sys->successors[j / 64u] & (1ull << (j % 64u))) != 0u) {
+            next = &world->systems[j];
+            if (ce_atomic_fetch_sub_u32(&next->remaining, 1u) == 1u) {
+                (void)ce_jobs_submit(ce__ecs_system_job, next, &world->jobs);
+            }
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* WORLD                                                                      */
+/* ************************************************************************** */
+
+ce_result ce_ecs_world_create(const ce_ecs_world_desc* desc, ce_ecs_world** out_world)
+{
+    ce_result res;
+    ce_ecs_world* w;
+    ce_u32 empty;
+
+    res = CE_OK;
+    w   = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_world == CE_NULL) || (desc->max_entities == 0u) ||
+        (desc->max_entities > CE_HANDLE_MAX_CAPACITY)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        w = (ce_ecs_world*)ce_mem_calloc(sizeof(ce_ecs_world), 0u, CE_MEM_TAG_RUNTIME);
+        if (w == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = ce_handle_table_init(&w->entities, desc->max_entities, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        w->entity_arch = (ce_u32*)ce_mem_alloc((ce_size)desc->max_entities * sizeof(ce_u32), 0u, CE_MEM_TAG_RUNTIME);
+        w->entity_row  = (ce_u32*)ce_mem_alloc((ce_size)desc->max_entities * sizeof(ce_u32), 0u, CE_MEM_TAG_RUNTIME);
+        res            = ((w->entity_arch == CE_NULL) || (w->entity_row == CE_NULL)) ? CE_ERR_OUT_OF_MEMORY : CE_OK;
+    }
+    if (res == CE_OK) {
+        res = ce_hashmap_init(&w->by_mask, 64u, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        res = ce_dynarray_init(&w->archetypes, sizeof(ce__ecs_archetype*), 64u, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        res = ce_dynarray_init(&w->free_chunks, sizeof(ce_u8*), 16u, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        res = ce_dynarray_init(&w->deferred, sizeof(ce__ecs_command), 64u, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        res = ce__ecs_archetype_new(w, 0u, &empty);
+    }
+    if (res == CE_OK) {
+        res = ce_mutex_init(&w->deferred_lock);
+    }
+
+    if (res == CE_OK) {
+        *out_world = w;
+    } else if (w != CE_NULL) {
+        if (w->archetypes.count != 0u) {
+            ce_dynarray_shutdown(&ce__ecs_arch(w, CE__ECS_EMPTY)->chunks);
+            ce_mem_free(ce__ecs_arch(w, CE__ECS_EMPTY));
+        }
+        ce_dynarray_shutdown(&w->deferred);
+        ce_dynarray_shutdown(&w->free_chunks);
+        ce_dynarray_shutdown(&w->archetypes);
+        ce_hashmap_shutdown(&w->by_mask);
+        ce_mem_free(w->entity_row);
+        ce_mem_free(w->entity_arch);
+        ce_handle_table_shutdown(&w->entities);
+        ce_mem_free(w);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_ecs_world_destroy(ce_ecs_world* world)
+{
+    ce__ecs_archetype* arch;
+    ce_size i;
+    ce_size c;
+
+    if (world != CE_NULL) {
+        for (i = 0u; i < world->archetypes.count; i++) {
+            arch = ce__ecs_arch(world, (ce_u32)i);
+            for (c = 0u; c < arch->chunks.count; c++) {
+                ce_mem_free(CE_DYNARRAY_AT(&arch->chunks, ce_u8*, c));
+            }
+            ce_dynarray_shutdown(&arch->chunks);
+            ce_mem_free(arch);
+        }
+        for (c = 0u; c < world->free_chunks.count; c++) {
+            ce_mem_free(CE_DYNARRAY_AT(&world->free_chunks, ce_u8*, c));
+        }
+        for (i = 0u; i < (ce_size)world->system_count; i++) {
+            ce_dynarray_shutdown(&world->systems[i].matched);
+            ce_dynarray_shutdown(&world->systems[i].first_chunk);
+        }
+        ce_mutex_destroy(&world->deferred_lock);
+        ce_dynarray_shutdown(&world->deferred);
+        ce_dynarray_shutdown(&world->free_chunks);
+        ce_dynarray_shutdown(&world->archetypes);
+        ce_hashmap_shutdown(&world->by_mask);
+        ce_mem_free(world->entity_row);
+        ce_mem_free(world->entity_arch);
+        ce_handle_table_shutdown(&world->entities);
+        ce_mem_free(world);
+    }
+}
+
+ce_result ce_ecs_component_register(ce_ecs_world* world, const ce_char* name, ce_u32 size, ce_u32 align,
+                                    ce_component_id* out_id)
+{
+    ce__ecs_component* c;
+    ce_result res;
+
+    res   = CE_OK;
+    align = (align != 0u) ? align : 1u;
+    if ((world == CE_NULL) || (out_id == CE_NULL) || (world->running == CE_TRUE) ||
+        ((align & (align - 1u)) != 0u) || (align > CE__ECS_CHUNK_ALIGN) ||
+        (size > (CE_ECS_CHUNK_BYTES / 2u))) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (world->component_count == CE_ECS_MAX_COMPONENTS) {
+        res = CE_ERR_FULL;
+    } else {
+        c        = &world->components[world->component_count];
+        c->name  = name;
+        c->size  = size;
+        c->align = align;
+        *out_id  = world->component_count;
+        world->component_count += 1u;
+    }
+
+    return res;
+}
+
+void ce_ecs_get_stats(const ce_ecs_world* world, ce_ecs_stats* out_stats)
+{
+    ce_size i;
+
+    if ((world != CE_NULL) && (out_stats != CE_NULL)) {
+        out_stats->entities    = world->entities.alive_count;
+        out_stats->archetypes  = (ce_u32)world->archetypes.count;
+        out_stats->chunks      = 0u;
+        out_stats->free_chunks = (ce_u32)world->free_chunks.count;
+        for (i = 0u; i < world->archetypes.count; i++) {
+            out_stats->chunks += (ce_u32)ce__ecs_arch(world, (ce_u32)i)->chunks.count;
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* ENTITIES                                                                   */
+/* ************************************************************************** */
+
+static ce_ecs_mask ce__ecs_registered(const ce_ecs_world* world)
+{
+    return (world->component_count == CE_ECS_MAX_COMPONENTS) ? ~(ce_ecs_mask)0u
+                                                             : (CE_ECS_BIT(world->component_count) - 1u);
+}
+
+ce_result ce_ecs_entity_create(ce_ecs_world* world, ce_ecs_mask components, ce_entity* out_entity)
+{
+    ce__ecs_archetype* arch;
+    ce_result res;
+    ce_entity entity;
+    ce_u32 index;
+    ce_u32 slot;
+    ce_u32 row;
+    ce_u32 size;
+    ce_u32 id;
+    ce_u32 i;
+
+    res   = CE_OK;
+    index = CE__ECS_EMPTY;
+    slot  = CE_HANDLE_INVALID;
+    if ((world == CE_NULL) || (out_entity == CE_NULL) || ((components & ~ce__ecs_registered(world)) != 0u)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (world->running == CE_TRUE) {
+        res = CE_ERR_UNSUPPORTED;
+    } else {
+        res = ce__ecs_archetype_find(world, components, &index);
+    }
+
+    if (res == CE_OK) {
+        slot = ce_handle_table_alloc(&world->entities);
+        res  = (slot != CE_HANDLE_INVALID) ? CE_OK : CE_ERR_FULL;
+    }
+    if (res == CE_OK) {
+        arch   = ce__ecs_arch(world, index);
+        entity = ce_handle_table_handle(&world->entities, slot);
+        res    = ce__ecs_row_push(world, arch, entity, &row);
+        if (res == CE_OK) {
+            for (i = 0u; i < arch->id_count; i++) {
+                id   = arch->ids[i];
+                size = world->components[id].size;
+                if (size != 0u) {
+                    ce__memset(ce__ecs_cell(arch, row, arch->offsets[id], size), 0u, (ce_size)size);
+                }
+            }
+            world->entity_arch[slot] = index;
+            world->entity_row[slot]  = row;
+            *out_entity              = entity;
+        } else {
+            ce_handle_table_free(&world->entities, slot);
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_ecs_entity_destroy(ce_ecs_world* world, ce_entity entity)
+{
+    ce_result res;
+    ce_u32 slot;
+
+    res = CE_OK;
+    if (world == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (world->running == CE_TRUE) {
+        res = CE_ERR_UNSUPPORTED;
+    } else {
+        slot = ce_handle_table_resolve(&world->entities, entity);
+        if (slot == CE_HANDLE_INVALID) {
+            res = CE_ERR_NOT_FOUND;
+        } else {
+            ce__ecs_row_remove(world, ce__ecs_arch(world, world->entity_arch[slot]), world->entity_row[slot]);
+            ce_handle_table_free(&world->entities, slot);
+        }
+    }
+
+    return res;
+}
+
+ce_bool ce_ecs_entity_alive(const ce_ecs_world* world, ce_entity entity)
+{
+    return ((world != CE_NULL) && (ce_handle_table_resolve(&world->entities, entity) != CE_HANDLE_INVALID))
+               ? CE_TRUE
+               : CE_FALSE;
+}
+
+/* Shared by add and remove: `adding` selects the edge set. */
+static ce_result ce__ecs_change(ce_ecs_world* world, ce_entity entity, ce_component_id id, ce_bool adding)
+{
+    ce__ecs_archetype* src;
+    ce_result res;
+    ce_ecs_mask bit;
+    ce_bool present;
+    ce_u32* edge;
+    ce_u32 src_index;
+    ce_u32 dst;
+    ce_u32 slot;
+
+    res  = CE_OK;
+    slot = CE_HANDLE_INVALID;
+    if ((world == CE_NULL) || (id >= world->component_count)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (world->running == CE_TRUE) {
+        res = CE_ERR_UNSUPPORTED;
+    } else {
+        slot = ce_handle_table_resolve(&world->entities, entity);
+        res  = (slot != CE_HANDLE_INVALID) ? CE_OK : CE_ERR_NOT_FOUND;
+    }
+
+    if (res == CE_OK) {
+        src_index = world->entity_arch[slot];
+        src       = ce__ecs_arch(world, src_index);
+        bit       = CE_ECS_BIT(id);
+        present   = ((src->mask & bit) != 0u) ? CE_TRUE : CE_FALSE;
+        if (present != adding) {
+            edge = (adding == CE_TRUE) ? &src->add_edge[id] : &src->remove_edge[id];
+            dst  = *edge;
+            if (dst == CE__ECS_NO_ARCHETYPE) {
+                res = ce__ecs_archetype_find(world, (adding == CE_TRUE) ? (src->mask | bit) : (src->mask & ~bit), &dst);
+                if (res == CE_OK) {
+                    /* Both directions: the way back is usually taken too. */
+                    *edge = dst;
+                    if (adding == CE_TRUE) {
+                        ce__ecs_arch(world, dst)->remove_edge[id] = src_index;
+                    } else {
+                        ce__ecs_arch(world, dst)->add_edge[id] = src_index;
+                    }
+                }
+            }
+            if (res == CE_OK) {
+                res = ce__ecs_move(world, slot, dst);
+            }
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_ecs_entity_add(ce_ecs_world* world, ce_entity entity, ce_component_id id)
+{
+    return ce__ecs_change(world, entity, id, CE_TRUE);
+}
+
+ce_result ce_ecs_entity_remove(ce_ecs_world* world, ce_entity entity, ce_component_id id)
+{
+    return ce__ecs_change(world, entity, id, CE_FALSE);
+}
+
+void* ce_ecs_entity_get(const ce_ecs_world* world, ce_entity entity, ce_component_id id)
+{
+    const ce__ecs_archetype* arch;
+    void* ptr;
+    ce_u32 slot;
+
+    ptr  = CE_NULL;
+    slot = (world != CE_NULL) ? ce_handle_table_resolve(&world->entities, entity) : CE_HANDLE_INVALID;
+    if ((slot != CE_HANDLE_INVALID) && (id < CE_ECS_MAX_COMPONENTS)) {
+        arch = ce__ecs_arch(world, world->entity_arch[slot]);
+        if (arch->offsets[id] != CE_ECS_NO_COLUMN) {
+            ptr = ce__ecs_cell(arch, world->entity_row[slot], arch->offsets[id], world->components[id].size);
+        }
+    }
+
+    return ptr;
+}
+
+ce_ecs_mask ce_ecs_entity_mask(const ce_ecs_world* world, ce_entity entity)
+{
+    ce_ecs_mask mask;
+    ce_u32 slot;
+
+    mask = 0u;
+    slot = (world != CE_NULL) ? ce_handle_table_resolve(&world->entities, entity) : CE_HANDLE_INVALID;
+    if (slot != CE_HANDLE_INVALID) {
+        mask = ce__ecs_arch(world, world->entity_arch[slot])->mask;
+    }
+
+    return mask;
+}
+
+/* ************************************************************************** */
+/* DEFERRED CHANGES                                                           */
+/* ************************************************************************** */
+
+static ce_result ce__ecs_defer(ce_ecs_world* world, ce__ecs_op op, ce_entity entity, ce_component_id id)
+{
+    ce__ecs_command cmd;
+    ce_result res;
+
+    res = CE_OK;
+    if (world == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        cmd.op     = (ce_u32)op;
+        cmd.entity = entity;
+        cmd.id     = id;
+        ce_mutex_lock(&world->deferred_lock);
+        res = (ce_dynarray_push(&world->deferred, &cmd) != CE_NULL) ? CE_OK : CE_ERR_OUT_OF_MEMORY;
+        ce_mutex_unlock(&world->deferred_lock);
+    }
+
+    return res;
+}
+
+ce_result ce_ecs_defer_destroy(ce_ecs_world* world, ce_entity entity)
+{
+    return ce__ecs_defer(world, CE__ECS_OP_DESTROY, entity, 0u);
+}
+
+ce_result ce_ecs_defer_add(ce_ecs_world* world, ce_entity entity, ce_component_id id)
+{
+    return ce__ecs_defer(world, CE__ECS_OP_ADD, entity, id);
+}
+
+ce_result ce_ecs_defer_remove(ce_ecs_world* world, ce_entity entity, ce_component_id id)
+{
+    return ce__ecs_defer(world, CE__ECS_OP_REMOVE, entity, id);
+}
+
+void ce_ecs_flush(ce_ecs_world* world)
+{
+    const ce__ecs_command* cmd;
+    ce_size i;
+
+    if ((world != CE_NULL) && (world->running == CE_FALSE)) {
+        ce_mutex_lock(&world->deferred_lock);
+        for (i = 0u; i < world->deferred.count; i++) {
+            cmd = &CE_DYNARRAY_AT(&world->deferred, ce__ecs_command, i);
+            if (cmd->op == (ce_u32)CE__ECS_OP_DESTROY) {
+                (void)ce_ecs_entity_destroy(world, cmd->entity);
+            } else {
+                (void)ce__ecs_change(world, cmd->entity, cmd->id,
+                                     (cmd->op == (ce_u32)CE__ECS_OP_ADD) ? CE_TRUE : CE_FALSE);
+            }
+        }
+        ce_dynarray_clear(&world->deferred);
+        ce_mutex_unlock(&world->deferred_lock);
+    }
+}
+
+/* ************************************************************************** */
+/* QUERIES AND SYSTEMS                                                        */
+/* ************************************************************************** */
+
+void ce_ecs_query_each(ce_ecs_world* world, const ce_ecs_query* query, ce_ecs_chunk_fn fn, void* user)
+{
+    const ce__ecs_archetype* arch;
+    ce_size i;
+    ce_u32 c;
+
+    if ((world != CE_NULL) && (query != CE_NULL) && (fn != CE_NULL)) {
+        for (i = 0u; i < world->archetypes.count; i++) {
+            arch = ce__ecs_arch(world, (ce_u32)i);
+            if (ce__ecs_matches(arch->mask, query) == CE_TRUE) {
+                for (c = 0u; c < (ce_u32)arch->chunks.count; c++) {
+                    ce__ecs_visit(arch, c, fn, user);
+                }
+            }
+        }
+    }
+}
+
+ce_u32 ce_ecs_query_count(ce_ecs_world* world, const ce_ecs_query* query)
+{
+    const ce__ecs_archetype* arch;
+    ce_u32 count;
+    ce_size i;
+
+    count = 0u;
+    if ((world != CE_NULL) && (query != CE_NULL)) {
+        for (i = 0u; i < world->archetypes.count; i++) {
+            arch = ce__ecs_arch(world, (ce_u32)i);
+            if (ce__ecs_matches(arch->mask, query) == CE_TRUE) {
+                count += arch->count;
+            }
+        }
+    }
+
+    return count;
+}
+
+ce_result ce_ecs_system_add(ce_ecs_world* world, const ce_ecs_system_desc* desc, ce_u32* out_index)
+{
+    ce__ecs_system* sys;
+    ce_result res;
+    ce_ecs_mask used;
+
+    res = CE_OK;
+    sys = CE_NULL;
+    if ((world == CE_NULL) || (desc == CE_NULL) || (desc->fn == CE_NULL) || (world->running == CE_TRUE)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (world->system_count == CE_ECS_MAX_SYSTEMS) {
+        res = CE_ERR_FULL;
+    } else {
+        used = desc->query.read | desc->query.write | desc->query.exclude | desc->extra_read | desc->extra_write;
+        res  = ((used & ~ce__ecs_registered(world)) == 0u) ? CE_OK : CE_ERR_INVALID_ARG;
+    }
+
+    if (res == CE_OK) {
+        sys = &world->systems[world->system_count];
+        ce__memset(sys, 0u, sizeof(*sys));
+        res = ce_dynarray_init(&sys->matched, sizeof(ce_u32), 16u, CE_MEM_TAG_RUNTIME);
+        if (res == CE_OK) {
+            res = ce_dynarray_init(&sys->first_chunk, sizeof(ce_u32), 16u, CE_MEM_TAG_RUNTIME);
+            if (res != CE_OK) {
+                ce_dynarray_shutdown(&sys->matched);
+            }
+        }
+    }
+
+    if (res == CE_OK) {
+        sys->world  = world;
+        sys->desc   = *desc;
+        sys->reads  = desc->query.read | desc->extra_read;
+        sys->writes = desc->query.write | desc->extra_write;
+        if (out_index != CE_NULL) {
+            *out_index = world->system_count;
+        }
+        world->system_count += 1u;
+        world->graph_dirty   = CE_TRUE;
+    }
+
+    return res;
+}
+
+void ce_ecs_run(ce_ecs_world* world)
+{
+    ce__ecs_system* sys;
+    ce_u32 i;
+
+    if ((world != CE_NULL) && (world->running == CE_FALSE)) {
+        if (world->graph_dirty == CE_TRUE) {
+            ce__ecs_build_graph(world);
+        }
+        for (i = 0u; i < world->system_count; i++) {
+            sys = &world->systems[i];
+            ce__ecs_system_prepare(world, sys);
+            ce_atomic_store_u32(&sys->remaining, sys->dep_count);
+        }
+
+        /* Every counter is armed before the first job can decrement one. */
+        world->running = CE_TRUE;
+        for (i = 0u; i < world->system_count; i++) {
+            if (world->systems[i].dep_count == 0u) {
+                (void)ce_jobs_submit(ce__ecs_system_job, &world->systems[i], &world->jobs);
+            }
+        }
+        ce_jobs_wait(&world->jobs);
+        world->running = CE_FALSE;
+
+        ce_ecs_flush(world);
+    }
+}
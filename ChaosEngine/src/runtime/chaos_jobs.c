@@ -9,8 +9,299 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_jobs.c
- * @brief Implementation skeleton.
+ * @brief Thread pool with a shared job queue and helping waits.
+ *
+ * Waiting threads pop and execute queued jobs instead of sleeping, so a
+ * parallel_for issued from the main thread also uses the main thread.
  */
 #include "runtime/chaos_jobs.h"
 
-/* TODO: implement */
+/** @brief Queue capacity (power of two). Submits beyond it run inline. */
+#define CE_JOBS_QUEUE_SIZE  4096u
+/** @brief Most batches a single parallel_for is split into. */
+#define CE_JOBS_MAX_BATCHES 256u
+
+/* ************************************************************************** */
+/* STATE                                                                      */
+/* ************************************************************************** */
+
+typedef struct ce_job_s {
+    ce_job_fn       fn;
+    void*           user;
+    ce_job_counter* counter;
+} ce_job;
+
+typedef struct ce_job_range_s {
+    ce_job_range_fn fn;
+    void*           user;
+    ce_u32          begin;
+    ce_u32          end;
+} ce_job_range;
+
+typedef struct ce_jobs_state_s {
+    ce_mutex  lock;
+    ce_cond   wake;
+    ce_job    queue[CE_JOBS_QUEUE_SIZE];
+    ce_u32    head;
+    ce_u32    tail;
+    ce_bool   running;
+    ce_u32    worker_count;
+    ce_thread workers[CE_JOBS_MAX_THREADS];
+    ce_u32    worker_ids[CE_JOBS_MAX_THREADS];
+} ce_jobs_state;
+
+static ce_jobs_state ce__jobs;
+static _Thread_local ce_u32 ce__jobs_thread_index;
+
+/* ************************************************************************** */
+/* QUEUE                                                                      */
+/* ************************************************************************** */
+
+/**
+ * @brief Pops a job under the lock.
+ * @return CE_TRUE when a job was dequeued.
+ */
+static ce_bool ce__jobs_pop_locked(ce_job* out)
+{
+    ce_bool got;
+
+    got = CE_FALSE;
+    if (ce__jobs.head != ce__jobs.tail) {
+        *out = ce__jobs.queue[ce__jobs.head & (CE_JOBS_QUEUE_SIZE - 1u)];
+        ce__jobs.head++;
+        got = CE_TRUE;
+    }
+
+    return got;
+}
+
+/**
+ * @brief Runs a job and signals its counter.
+ */
+static void ce__jobs_execute(const ce_job* job)
+{
+    job->fn(job->user);
+    if (job->counter != CE_NULL) {
+        (void)ce_atomic_fetch_sub_u32(&job->counter->pending, 1u);
+    }
+}
+
+/**
+ * @brief Worker loop: sleep until work arrives, exit once stopped and drained.
+ */
+static void ce__jobs_worker_main(void* user)
+{
+    ce_job job;
+    ce_bool alive;
+    ce_bool got;
+
+    ce__jobs_thread_index = *(const ce_u32*)user;
+    alive = CE_TRUE;
+
+    while (alive == CE_TRUE) {
+        ce_mutex_lock(&ce__jobs.lock);
+        got = ce__jobs_pop_locked(&job);
+        while ((got == CE_FALSE) && (ce__jobs.running == CE_TRUE)) {
+            ce_cond_wait(&ce__jobs.wake, &ce__jobs.lock);
+            got = ce__jobs_pop_locked(&job);
+        }
+        ce_mutex_unlock(&ce__jobs.lock);
+
+        if (got == CE_TRUE) {
+            ce__jobs_execute(&job);
+        } else {
+            alive = CE_FALSE;
+        }
+    }
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_result ce_jobs_init(ce_u32 worker_count)
+{
+    ce_result res;
+    ce_u32 count;
+    ce_u32 i;
+
+    res   = CE_OK;
+    count = worker_count;
+
+    if (ce__jobs.running == CE_TRUE) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        if (count == 0u) {
+            count = ce_thread_hardware_concurrency() - 1u;
+        }
+        if (count > (CE_JOBS_MAX_THREADS - 1u)) {
+            count = CE_JOBS_MAX_THREADS - 1u;
+        }
+
+        ce__jobs.head         = 0u;
+        ce__jobs.tail         = 0u;
+        ce__jobs.worker_count = 0u;
+        res = ce_mutex_init(&ce__jobs.lock);
+        if (res == CE_OK) {
+            res = ce_cond_init(&ce__jobs.wake);
+        }
+        if (res == CE_OK) {
+            ce__jobs.running = CE_TRUE;
+            for (i = 0u; (i < count) && (res == CE_OK); i++) {
+                ce__jobs.worker_ids[i] = i + 1u;
+                res = ce_thread_create(&ce__jobs.workers[i], ce__jobs_worker_main,
+                                       &ce__jobs.worker_ids[i], "ce_worker");
+                if (res == CE_OK) {
+                    ce__jobs.worker_count++;
+                }
+            }
+            if (res != CE_OK) {
+                ce_jobs_shutdown();
+            }
+        }
+    }
+
+    return res;
+}
+
+void ce_jobs_shutdown(void)
+{
+    ce_u32 i;
+
+    if (ce__jobs.running == CE_TRUE) {
+        ce_mutex_lock(&ce__jobs.lock);
+        ce__jobs.running = CE_FALSE;
+        ce_cond_broadcast(&ce__jobs.wake);
+        ce_mutex_unlock(&ce__jobs.lock);
+
+        for (i = 0u; i < ce__jobs.worker_count; i++) {
+            ce_thread_join(&ce__jobs.workers[i]);
+        }
+        ce__jobs.worker_count = 0u;
+        ce_cond_destroy(&ce__jobs.wake);
+        ce_mutex_destroy(&ce__jobs.lock);
+    }
+}
+
+ce_u32 ce_jobs_worker_count(void)
+{
+    return ce__jobs.worker_count;
+}
+
+ce_u32 ce_jobs_thread_index(void)
+{
+    return ce__jobs_thread_index;
+}
+
+ce_result ce_jobs_submit(ce_job_fn fn, void* user, ce_job_counter* counter)
+{
+    ce_result res;
+    ce_job job;
+    ce_bool queued;
+
+    res    = CE_OK;
+    queued = CE_FALSE;
+
+    if (fn == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        job.fn      = fn;
+        job.user    = user;
+        job.counter = counter;
+        if (counter != CE_NULL) {
+            (void)ce_atomic_fetch_add_u32(&counter->pending, 1u);
+        }
+
+        if (ce__jobs.worker_count != 0u) {
+            ce_mutex_lock(&ce__jobs.lock);
+            if ((ce__jobs.tail - ce__jobs.head) < CE_JOBS_QUEUE_SIZE) {
+                ce__jobs.queue[ce__jobs.tail & (CE_JOBS_QUEUE_SIZE - 1u)] = job;
+                ce__jobs.tail++;
+                queued = CE_TRUE;
+                ce_cond_signal(&ce__jobs.wake);
+            }
+            ce_mutex_unlock(&ce__jobs.lock);
+        }
+
+        if (queued == CE_FALSE) {
+            ce__jobs_execute(&job);
+        }
+    }
+
+    return res;
+}
+
+void ce_jobs_wait(ce_job_counter* counter)
+{
+    ce_job job;
+    ce_bool got;
+
+    while (ce_atomic_load_u32(&counter->pending) != 0u) {
+        got = CE_FALSE;
+        if (ce__jobs.worker_count != 0u) {
+            ce_mutex_lock(&ce__jobs.lock);
+            got = ce__jobs_pop_locked(&job);
+            ce_mutex_unlock(&ce__jobs.lock);
+        }
+        if (got == CE_TRUE) {
+            ce__jobs_execute(&job);
+        } else {
+            ce_thread_yield();
+        }
+    }
+}
+
+/**
+ * @brief Job trampoline for one parallel_for batch.
+ */
+static void ce__jobs_range_main(void* user)
+{
+    const ce_job_range* range;
+
+    range = (const ce_job_range*)user;
+    range->fn(range->user, range->begin, range->end);
+}
+
+void ce_jobs_parallel_for(ce_u32 count, ce_u32 min_batch, ce_job_range_fn fn, void* user)
+{
+    ce_job_range ranges[CE_JOBS_MAX_BATCHES];
+    ce_job_counter counter;
+    ce_u32 batch;
+    ce_u32 batches;
+    ce_u32 threads;
+    ce_u32 i;
+
+    batch = (min_batch == 0u) ? 1u : min_batch;
+
+    if ((count != 0u) && (fn != CE_NULL)) {
+        if ((ce__jobs.worker_count == 0u) || (count <= batch)) {
+            fn(user, 0u, count);
+        } else {
+            /* Aim for ~4 batches per thread to absorb uneven batch costs. */
+            threads = ce__jobs.worker_count + 1u;
+            batches = (count + batch - 1u) / batch;
+            if (batches > (threads * 4u)) {
+                batches = threads * 4u;
+            }
+            if (batches > CE_JOBS_MAX_BATCHES) {
+                batches = CE_JOBS_MAX_BATCHES;
+            }
+            batch = (count + batches - 1u) / batches;
+            batches = (count + batch - 1u) / batch;
+
+            ce_atomic_store_u32(&counter.pending, 0u);
+            for (i = 0u; i < batches; i++) {
+                ranges[i].fn    = fn;
+                ranges[i].user  = user;
+                ranges[i].begin = i * batch;
+                ranges[i].end   = ((i + 1u) * batch < count) ? ((i + 1u) * batch) : count;
+                if (i != 0u) {
+                    (void)ce_jobs_submit(ce__jobs_range_main, &ranges[i], &counter);
+                }
+            }
+            /* The caller takes the first batch itself, then helps with the rest. */
+            ce__jobs_range_main(&ranges[0]);
+            ce_jobs_wait(&counter);
+        }
+    }
+}
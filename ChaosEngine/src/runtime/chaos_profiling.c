@@ -9,8 +9,222 @@
  * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
  * 
  * @file chaos_profiling.c
- * @brief Implementation skeleton.
+ * @brief Memory overlay and JSON dump of the allocation tracker.
  */
+#include "runtime/chaos_profiling.h"
+#include "core/chaos_memory.h"
 
+#include <stdio.h>
 
-/* TODO: implement */
+#define CE__PROFILING_RED   CE_RGBA(255u, 80u, 80u, 255u)
+#define CE__PROFILING_WHITE CE_RGBA(230u, 230u, 230u, 255u)
+
+/* ************************************************************************** */
+/* INTERNAL HELPERS                                                           */
+/* ************************************************************************** */
+
+/* Path component after the last separator, for compact overlay lines. */
+static const ce_char* ce__profiling_basename(const ce_char* path)
+{
+    const ce_char* base;
+    const ce_char* p;
+
+    base = path;
+    for (p = path; *p != '\0'; p++) {
+        if ((*p == '/') || (*p == '\\')) {
+            base = p + 1;
+        }
+    }
+
+    return base;
+}
+
+/* Human-readable byte count ("512 B", "3.2 KB", "14.0 MB"). */
+static void ce__profiling_bytes(ce_char* out, ce_size cap, ce_u64 bytes)
+{
+    if (bytes < 1024u) {
+        (void)snprintf(out, cap, "%llu B", (unsigned long long)bytes);
+    } else if (bytes < (1024u * 1024u)) {
+        (void)snprintf(out, cap, "%.1f KB", (ce_f64)bytes / 1024.0);
+    } else {
+        (void)snprintf(out, cap, "%.1f MB", (ce_f64)bytes / (1024.0 * 1024.0));
+    }
+}
+
+/* JSON string body: only '"' and '\' can occur in a __FILE__ path. */
+static void ce__profiling_json_string(FILE* f, const ce_char* s)
+{
+    const ce_char* p;
+
+    (void)fputc('"', f);
+    for (p = s; *p != '\0'; p++) {
+        if ((*p == '"') || (*p == '\\')) {
+            (void)fputc('\\', f);
+        }
+        (void)fputc(*p, f);
+    }
+    (void)fputc('"', f);
+}
+
+/* ************************************************************************** */
+/* PUBLIC API                                                                 */
+/* ************************************************************************** */
+
+ce_result ce_profiling_memory_json(const ce_char* path, ce_u32 max_sites)
+{
+    ce_result res;
+    FILE* f;
+    ce_mem_tag_stats ts;
+    ce_mem_site_stats* sites;
+    ce_u32 site_count;
+    ce_u32 i;
+    ce_u32 j;
+
+    res        = CE_OK;
+    sites      = CE_NULL;
+    site_count = 0u;
+
+    if (path == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        /* Gathered before the file opens so the dump does not list itself. */
+        if (max_sites > 0u) {
+            sites = (ce_mem_site_stats*)ce_mem_alloc((ce_size)max_sites * sizeof(*sites), 0u, CE_MEM_TAG_RUNTIME);
+            if (sites == CE_NULL) {
+                res = CE_ERR_OUT_OF_MEMORY;
+            } else {
+                site_count = ce_mem_get_top_sites(sites, max_sites);
+            }
+        }
+        f = (res == CE_OK) ? fopen(path, "wb") : CE_NULL;
+        if (f == CE_NULL) {
+            res = (res == CE_OK) ? CE_ERR_IO : res;
+        } else {
+            (void)fprintf(f, "{\n  \"tracking\": %s,\n  \"tags\": [\n",
+                          (ce_mem_tracking_enabled() == CE_TRUE) ? "true" : "false");
+            for (i = 0u; i < (ce_u32)CE_MEM_TAG_COUNT; i++) {
+                ce_mem_get_tag_stats((ce_mem_tag)i, &ts);
+                (void)fprintf(f,
+                              "    { \"name\": \"%s\", \"live_bytes\": %llu, \"peak_bytes\": %llu, "
+                              "\"live_blocks\": %llu, \"allocs\": %llu, \"frees\": %llu, \"frame_allocs\": %llu, "
+                              "\"frame_bytes\": %llu, \"arena_bytes\": %llu, \"pool_bytes\": %llu, "
+                              "\"budget_bytes\": %llu, \"size_histogram\": [",
+                              ce_mem_tag_name((ce_mem_tag)i), (unsigned long long)ts.live_bytes,
+                              (unsigned long long)ts.peak_bytes, (unsigned long long)ts.live_blocks,
+                              (unsigned long long)ts.allocs, (unsigned long long)ts.frees,
+                              (unsigned long long)ts.frame_allocs, (unsigned long long)ts.frame_bytes,
+                              (unsigned long long)ts.arena_bytes, (unsigned long long)ts.pool_bytes,
+                              (unsigned long long)ts.budget_bytes);
+                for (j = 0u; j < CE_MEM_SIZE_CLASSES; j++) {
+                    (void)fprintf(f, "%s%llu", (j == 0u) ? "" : ", ", (unsigned long long)ts.size_histogram[j]);
+                }
+                (void)fprintf(f, "] }%s\n", ((i + 1u) < (ce_u32)CE_MEM_TAG_COUNT) ? "," : "");
+            }
+            (void)fprintf(f, "  ],\n  \"sites\": [\n");
+            for (i = 0u; i < site_count; i++) {
+                (void)fprintf(f, "    { \"file\": ");
+                if (sites[i].file != CE_NULL) {
+                    ce__profiling_json_string(f, sites[i].file);
+                } else {
+                    (void)fprintf(f, "null");
+                }
+                (void)fprintf(f,
+                              ", \"line\": %u, \"tag\": \"%s\", \"live_bytes\": %llu, \"peak_bytes\": %llu, "
+                              "\"live_blocks\": %llu, \"allocs\": %llu, \"total_bytes\": %llu }%s\n",
+                              sites[i].line, ce_mem_tag_name(sites[i].tag), (unsigned long long)sites[i].live_bytes,
+                              (unsigned long long)sites[i].peak_bytes, (unsigned long long)sites[i].live_blocks,
+                              (unsigned long long)sites[i].allocs, (unsigned long long)sites[i].total_bytes,
+                              ((i + 1u) < site_count) ? "," : "");
+            }
+            (void)fprintf(f, "  ]\n}\n");
+            if (fclose(f) != 0) {
+                res = CE_ERR_IO;
+            }
+        }
+        ce_mem_free(sites);
+    }
+
+    return res;
+}
+
+ce_bool ce_profiling_memory_line(ce_u32 index, ce_char* out, ce_size cap, ce_bool* out_over)
+{
+    ce_bool ret;
+    ce_bool over;
+    ce_mem_tag_stats ts;
+    ce_mem_site_stats sites[CE_PROFILING_OVERLAY_SITES];
+    ce_char live[24];
+    ce_char peak[24];
+    ce_char budget[24];
+    ce_u32 site_count;
+    ce_u32 site;
+
+    ret  = CE_TRUE;
+    over = CE_FALSE;
+
+    if ((out == CE_NULL) || (cap == (ce_size)0)) {
+        ret = CE_FALSE;
+    } else if (index == 0u) {
+        (void)snprintf(out, cap, "%s", (ce_mem_tracking_enabled() == CE_TRUE)
+                                           ? "memory          live      peak    budget  allocs/frame"
+                                           : "memory (built without CE_MEM_TRACKING)");
+    } else if (index <= (ce_u32)CE_MEM_TAG_COUNT) {
+        ce_mem_get_tag_stats((ce_mem_tag)(index - 1u), &ts);
+        ce__profiling_bytes(live, sizeof(live), ts.live_bytes);
+        ce__profiling_bytes(peak, sizeof(peak), ts.peak_bytes);
+        if (ts.budget_bytes != 0u) {
+            ce__profiling_bytes(budget, sizeof(budget), ts.budget_bytes);
+        } else {
+            (void)snprintf(budget, sizeof(budget), "-");
+        }
+        over = ((ts.budget_bytes != 0u) && (ts.live_bytes > ts.budget_bytes)) ? CE_TRUE : CE_FALSE;
+        (void)snprintf(out, cap, "%-8s %9s %9s %9s  %llu", ce_mem_tag_name((ce_mem_tag)(index - 1u)), live, peak,
+                       budget, (unsigned long long)ts.frame_allocs);
+    } else {
+        site       = index - (ce_u32)CE_MEM_TAG_COUNT - 1u;
+        site_count = (site < CE_PROFILING_OVERLAY_SITES) ? ce_mem_get_top_sites(sites, site + 1u) : 0u;
+        if (site >= site_count) {
+            ret = CE_FALSE;
+        } else {
+            ce__profiling_bytes(live, sizeof(live), sites[site].live_bytes);
+            if (sites[site].file != CE_NULL) {
+                (void)snprintf(out, cap, "  %s:%u %s %s (%llu blocks)", ce__profiling_basename(sites[site].file),
+                               sites[site].line, ce_mem_tag_name(sites[site].tag), live,
+                               (unsigned long long)sites[site].live_blocks);
+            } else {
+                (void)snprintf(out, cap, "  (untracked) %s (%llu blocks)", live,
+                               (unsigned long long)sites[site].live_blocks);
+            }
+        }
+    }
+
+    if (out_over != CE_NULL) {
+        *out_over = over;
+    }
+
+    return ret;
+}
+
+ce_result ce_profiling_draw_memory(ce_sprite_batch* batch, ce_text_cache* cache, ce_f32 x, ce_f32 y,
+                                   ce_f32 size_px, ce_u16 layer)
+{
+    ce_result res;
+    ce_char line[CE_PROFILING_LINE_MAX];
+    ce_bool over;
+    ce_u32 i;
+
+    res = CE_OK;
+    i   = 0u;
+
+    if ((batch == CE_NULL) || (cache == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        while ((res == CE_OK) && (ce_profiling_memory_line(i, line, sizeof(line), &over) == CE_TRUE)) {
+            res = ce_draw_text(batch, cache, line, x, y + ((ce_f32)i * size_px), size_px,
+                               (over == CE_TRUE) ? CE__PROFILING_RED : CE__PROFILING_WHITE, layer);
+            i  += 1u;
+        }
+    }
+
+    return res;
+}
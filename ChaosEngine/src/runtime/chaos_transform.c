@@ -0,0 +1,776 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file chaos_transform.c
+ * @brief Level-ordered SoA transform storage and the SIMD update kernel.
+ *
+ * Positions [level_start[d], level_start[d + 1]) hold the nodes of depth d.
+ * Moving a node from one level to another rotates it through the levels in
+ * between: one swap per boundary crossed, each level keeping its extent.
+ * level_start[CE_TRANSFORM_MAX_DEPTH] == count; the (normally empty)
+ * segment from there is where nodes enter and leave.
+ *
+ * Topology (parent, children, depth) is slot-indexed and never moves; only
+ * the per-position data is swapped, with `dense` mapping slots back.
+ *
+ * Dirtiness is pushed down: a recomputed node flags its children and their
+ * 8-position groups, so the update touches one flag per clean group and
+ * does matrix work only where something moved.
+ */
+#include "runtime/chaos_transform.h"
+#include "runtime/chaos_jobs.h"
+#include "core/chaos_memory.h"
+#include "core/chaos_simd.h"
+#include "platform/chaos_thread.h"
+#include "utility/chaos_string.h"
+
+/** @brief SIMD groups per job when a level is split across the pool. */
+#define CE__XF_GROUPS_PER_JOB 32u
+/** @brief Staging level: where nodes enter and leave the ordering. */
+#define CE__XF_STAGING        CE_TRANSFORM_MAX_DEPTH
+
+/* ************************************************************************** */
+/* STATE                                                                      */
+/* ************************************************************************** */
+
+/* Per-position local TRS streams, read 8 lanes at a time by the kernel. */
+typedef enum ce__xf_stream_e {
+    CE__XF_TX = 0,
+    CE__XF_TY,
+    CE__XF_TZ,
+    CE__XF_QX,
+    CE__XF_QY,
+    CE__XF_QZ,
+    CE__XF_QW,
+    CE__XF_SX,
+    CE__XF_SY,
+    CE__XF_SZ,
+    CE__XF_STREAMS
+} ce__xf_stream;
+
+/** @brief Floats per world row: 3x3 column-major basis, then translation. */
+#define CE__XF_WORLD 12u
+
+struct ce_transform_hierarchy_s {
+    ce_handle_table nodes;
+    ce_u32*         index_block;   /**< Backing store of every ce_u32 array below. */
+    /* Slot-indexed topology. */
+    ce_u32*         dense;         /**< Slot -> position. */
+    ce_u32*         parent;        /**< Slot -> parent slot, CE_HANDLE_INVALID for roots. */
+    ce_u32*         first_child;
+    ce_u32*         next_sibling;
+    ce_u32*         prev_sibling;
+    ce_u32*         depth;
+    /* Position-indexed (breadth-first) data. */
+    ce_u32*         slot_of;       /**< Position -> slot. */
+    ce_u32*         parent_slot;   /**< Position -> parent slot, for the kernel. */
+    ce_u8*          dirty;
+    ce_atomic_u32*  group_dirty;   /**< Per aligned group of CE_SIMD_WIDTH positions. */
+    ce_f32*         streams[CE__XF_STREAMS];
+    ce_f32*         stream_block;
+    ce_f32*         world;         /**< CE__XF_WORLD floats per position: a parent gather is one row. */
+    ce_u32          level_start[CE_TRANSFORM_MAX_DEPTH + 1u];
+    ce_u32          count;
+    ce_u32          min_dirty;     /**< Shallowest level holding a dirty node, CE__XF_STAGING when clean. */
+    ce_atomic_u32   recomputed;
+};
+
+typedef struct ce__xf_level_s {
+    ce_transform_hierarchy* h;
+    ce_u32                  begin;
+    ce_u32                  end;
+} ce__xf_level;
+
+static const ce_f32 ce__xf_identity[CE__XF_WORLD] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+
+/* ************************************************************************** */
+/* ORDERING                                                                   */
+/* ************************************************************************** */
+
+static void ce__xf_swap(ce_transform_hierarchy* h, ce_u32 p, ce_u32 q)
+{
+    ce_f32 f;
+    ce_u32 u;
+    ce_u8 d;
+    ce_u32 s;
+
+    if (p != q) {
+        for (s = 0u; s < (ce_u32)CE__XF_STREAMS; s++) {
+            f                = h->streams[s][p];
+            h->streams[s][p] = h->streams[s][q];
+            h->streams[s][q] = f;
+        }
+        for (s = 0u; s < CE__XF_WORLD; s++) {
+            f                                = h->world[(p * CE__XF_WORLD) + s];
+            h->world[(p * CE__XF_WORLD) + s] = h->world[(q * CE__XF_WORLD) + s];
+            h->world[(q * CE__XF_WORLD) + s] = f;
+        }
+        u                 = h->slot_of[p];
+        h->slot_of[p]     = h->slot_of[q];
+        h->slot_of[q]     = u;
+        u                 = h->parent_slot[p];
+        h->parent_slot[p] = h->parent_slot[q];
+        h->parent_slot[q] = u;
+        d                 = h->dirty[p];
+        h->dirty[p]       = h->dirty[q];
+        h->dirty[q]       = d;
+
+        h->dense[h->slot_of[p]] = p;
+        h->dense[h->slot_of[q]] = q;
+        if (h->dirty[p] != 0u) {
+            ce_atomic_store_relaxed_u32(&h->group_dirty[p / CE_SIMD_WIDTH], 1u);
+        }
+        if (h->dirty[q] != 0u) {
+            ce_atomic_store_relaxed_u32(&h->group_dirty[q / CE_SIMD_WIDTH], 1u);
+        }
+    }
+}
+
+/**
+ * @brief Moves the node at `pos` from level `from` to level `to`, one swap
+ *        per level boundary crossed.
+ */
+static void ce__xf_move_level(ce_transform_hierarchy* h, ce_u32 pos, ce_u32 from, ce_u32 to)
+{
+    ce_u32 l;
+
+    if (to > from) {
+        /* To the end of its level, then over each boundary: the next level
+           gives up its first slot and moves that node to its own end. */
+        ce__xf_swap(h, pos, h->level_start[from + 1u] - 1u);
+        for (l = from + 1u; l <= to; l++) {
+            h->level_start[l] -= 1u;
+            if (l < to) {
+                ce__xf_swap(h, h->level_start[l], h->level_start[l + 1u] - 1u);
+            }
+        }
+    } else if (to < from) {
+        ce__xf_swap(h, pos, h->level_start[from]);
+        for (l = from; l > to; l--) {
+            h->level_start[l] += 1u;
+            if ((l - 1u) > to) {
+                ce__xf_swap(h, h->level_start[l] - 1u, h->level_start[l - 1u]);
+            }
+        }
+    } else {
+        /* Already there. */
+    }
+}
+
+static void ce__xf_mark(ce_transform_hierarchy* h, ce_u32 slot)
+{
+    h->dirty[h->dense[slot]] = 1u;
+    ce_atomic_store_relaxed_u32(&h->group_dirty[h->dense[slot] / CE_SIMD_WIDTH], 1u);
+    if (h->depth[slot] < h->min_dirty) {
+        h->min_dirty = h->depth[slot];
+    }
+}
+
+static void ce__xf_link(ce_transform_hierarchy* h, ce_u32 slot, ce_u32 parent)
+{
+    h->parent[slot]       = parent;
+    h->prev_sibling[slot] = CE_HANDLE_INVALID;
+    h->next_sibling[slot] = CE_HANDLE_INVALID;
+    if (parent != CE_HANDLE_INVALID) {
+        h->next_sibling[slot] = h->first_child[parent];
+        if (h->first_child[parent] != CE_HANDLE_INVALID) {
+            h->prev_sibling[h->first_child[parent]] = slot;
+        }
+        h->first_child[parent] = slot;
+    }
+}
+
+static void ce__xf_unlink(ce_transform_hierarchy* h, ce_u32 slot)
+{
+    ce_u32 prev;
+    ce_u32 next;
+
+    prev = h->prev_sibling[slot];
+    next = h->next_sibling[slot];
+    if (prev != CE_HANDLE_INVALID) {
+        h->next_sibling[prev] = next;
+    } else if (h->parent[slot] != CE_HANDLE_INVALID) {
+        h->first_child[h->parent[slot]] = next;
+    } else {
+        /* Roots are not chained. */
+    }
+    if (next != CE_HANDLE_INVALID) {
+        h->prev_sibling[next] = prev;
+    }
+    h->parent[slot] = CE_HANDLE_INVALID;
+}
+
+/* Pre-order successor of `cur` within the subtree of `root`. */
+static ce_u32 ce__xf_next(const ce_transform_hierarchy* h, ce_u32 root, ce_u32 cur)
+{
+    ce_u32 next;
+
+    next = h->first_child[cur];
+    while ((next == CE_HANDLE_INVALID) && (cur != root)) {
+        next = h->next_sibling[cur];
+        cur  = h->parent[cur];
+    }
+
+    return next;
+}
+
+/* Leaf removal: the node must have no children left. */
+static void ce__xf_remove(ce_transform_hierarchy* h, ce_u32 slot)
+{
+    ce__xf_unlink(h, slot);
+    ce__xf_move_level(h, h->dense[slot], h->depth[slot], CE__XF_STAGING);
+    h->count                          -= 1u;
+    h->level_start[CE__XF_STAGING]     = h->count;
+    ce_handle_table_free(&h->nodes, slot);
+}
+
+/* ************************************************************************** */
+/* UPDATE KERNEL                                                              */
+/* ************************************************************************** */
+
+/**
+ * @brief world = parent * local(T, R, S) for the group at `pos`, storing
+ *        lanes [lo, hi) only.
+ *
+ * The other lanes belong to a neighbouring level or to the padding.
+ */
+static void ce__xf_compose(ce_transform_hierarchy* h, ce_u32 pos, ce_u32 lo, ce_u32 hi,
+                           ce_f32 parent[CE__XF_WORLD][CE_SIMD_WIDTH])
+{
+    _Alignas(16) ce_f32 out[CE__XF_WORLD][CE_SIMD_WIDTH];
+    ce_f32* dst;
+    ce_f32x8 l[CE__XF_WORLD];
+    ce_f32x8 p[CE__XF_WORLD];
+    ce_f32x8 w;
+    ce_f32x8 one;
+    ce_f32x8 two;
+    ce_f32x8 qx;
+    ce_f32x8 qy;
+    ce_f32x8 qz;
+    ce_f32x8 qw;
+    ce_f32x8 sx;
+    ce_f32x8 sy;
+    ce_f32x8 sz;
+    ce_f32x8 xx;
+    ce_f32x8 yy;
+    ce_f32x8 zz;
+    ce_f32x8 xy;
+    ce_f32x8 xz;
+    ce_f32x8 yz;
+    ce_f32x8 wx;
+    ce_f32x8 wy;
+    ce_f32x8 wz;
+    ce_u32 col;
+    ce_u32 row;
+    ce_u32 i;
+    ce_u32 k;
+
+    one = ce_f32x8_set1(1.0f);
+    two = ce_f32x8_set1(2.0f);
+    qx  = ce_f32x8_load(&h->streams[CE__XF_QX][pos]);
+    qy  = ce_f32x8_load(&h->streams[CE__XF_QY][pos]);
+    qz  = ce_f32x8_load(&h->streams[CE__XF_QZ][pos]);
+    qw  = ce_f32x8_load(&h->streams[CE__XF_QW][pos]);
+    sx  = ce_f32x8_load(&h->streams[CE__XF_SX][pos]);
+    sy  = ce_f32x8_load(&h->streams[CE__XF_SY][pos]);
+    sz  = ce_f32x8_load(&h->streams[CE__XF_SZ][pos]);
+    xx  = ce_f32x8_mul(qx, qx);
+    yy  = ce_f32x8_mul(qy, qy);
+    zz  = ce_f32x8_mul(qz, qz);
+    xy  = ce_f32x8_mul(qx, qy);
+    xz  = ce_f32x8_mul(qx, qz);
+    yz  = ce_f32x8_mul(qy, qz);
+    wx  = ce_f32x8_mul(qw, qx);
+    wy  = ce_f32x8_mul(qw, qy);
+    wz  = ce_f32x8_mul(qw, qz);
+
+    /* Local basis as in ce_mat4f_from_trs. */
+    l[0]  = ce_f32x8_mul(ce_f32x8_sub(one, ce_f32x8_mul(two, ce_f32x8_add(yy, zz))), sx);
+    l[1]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_add(xy, wz)), sx);
+    l[2]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_sub(xz, wy)), sx);
+    l[3]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_sub(xy, wz)), sy);
+    l[4]  = ce_f32x8_mul(ce_f32x8_sub(one, ce_f32x8_mul(two, ce_f32x8_add(xx, zz))), sy);
+    l[5]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_add(yz, wx)), sy);
+    l[6]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_add(xz, wy)), sz);
+    l[7]  = ce_f32x8_mul(ce_f32x8_mul(two, ce_f32x8_sub(yz, wx)), sz);
+    l[8]  = ce_f32x8_mul(ce_f32x8_sub(one, ce_f32x8_mul(two, ce_f32x8_add(xx, yy))), sz);
+    l[9]  = ce_f32x8_load(&h->streams[CE__XF_TX][pos]);
+    l[10] = ce_f32x8_load(&h->streams[CE__XF_TY][pos]);
+    l[11] = ce_f32x8_load(&h->streams[CE__XF_TZ][pos]);
+    for (k = 0u; k < CE__XF_WORLD; k++) {
+        p[k] = ce_f32x8_load(parent[k]);
+    }
+
+    /* Affine product: basis columns ignore the parent translation. */
+    for (col = 0u; col < 4u; col++) {
+        for (row = 0u; row < 3u; row++) {
+            w = ce_f32x8_add(ce_f32x8_add(ce_f32x8_mul(p[row], l[col * 3u]),
+                                          ce_f32x8_mul(p[3u + row], l[(col * 3u) + 1u])),
+                             ce_f32x8_mul(p[6u + row], l[(col * 3u) + 2u]));
+            if (col == 3u) {
+                w = ce_f32x8_add(w, p[9u + row]);
+            }
+            ce_f32x8_store(out[(col * 3u) + row], w);
+        }
+    }
+
+    /* Transpose into the rows; stays in L1. */
+    for (i = lo; i < hi; i++) {
+        dst = &h->world[(pos + i) * CE__XF_WORLD];
+        for (k = 0u; k < CE__XF_WORLD; k++) {
+            dst[k] = out[k][i];
+        }
+    }
+}
+
+/* Flags the children of a recomputed node for the next level. */
+static void ce__xf_push_dirty(ce_transform_hierarchy* h, ce_u32 slot)
+{
+    ce_u32 child;
+    ce_u32 pos;
+
+    child = h->first_child[slot];
+    while (child != CE_HANDLE_INVALID) {
+        /* One parent per child: the byte has a single writer. Groups are shared. */
+        pos           = h->dense[child];
+        h->dirty[pos] = 1u;
+        ce_atomic_store_relaxed_u32(&h->group_dirty[pos / CE_SIMD_WIDTH], 1u);
+        child = h->next_sibling[child];
+    }
+}
+
+/* Aligned groups [begin, end) of one level; `begin` is relative to the level's first group. */
+static void ce__xf_update_range(void* user, ce_u32 begin, ce_u32 end)
+{
+    _Alignas(16) ce_f32 parent[CE__XF_WORLD][CE_SIMD_WIDTH];
+    const ce_f32* row;
+    const ce__xf_level* level;
+    ce_transform_hierarchy* h;
+    ce_u32 first;
+    ce_u32 pos;
+    ce_u32 lo;
+    ce_u32 hi;
+    ce_u32 pslot;
+    ce_u32 done;
+    ce_u8 any;
+    ce_u32 g;
+    ce_u32 i;
+    ce_u32 k;
+
+    level = (const ce__xf_level*)user;
+    h     = level->h;
+    first = level->begin / CE_SIMD_WIDTH;
+    done  = 0u;
+    for (g = first + begin; g < (first + end); g++) {
+        if (ce_atomic_load_relaxed_u32(&h->group_dirty[g]) != 0u) {
+            /* A group straddling two levels is visited once per level. */
+            pos = g * CE_SIMD_WIDTH;
+            lo  = (level->begin > pos) ? (level->begin - pos) : 0u;
+            hi  = ((level->end - pos) < CE_SIMD_WIDTH) ? (level->end - pos) : CE_SIMD_WIDTH;
+            any = 0u;
+            for (i = lo; i < hi; i++) {
+                any = (ce_u8)(any | h->dirty[pos + i]);
+            }
+
+            /* A clean lane recomputes to the same matrix: the whole group goes. */
+            if (any != 0u) {
+                for (i = 0u; i < CE_SIMD_WIDTH; i++) {
+                    pslot = ((i >= lo) && (i < hi)) ? h->parent_slot[pos + i] : CE_HANDLE_INVALID;
+                    row   = (pslot != CE_HANDLE_INVALID) ? &h->world[h->dense[pslot] * CE__XF_WORLD] : ce__xf_identity;
+                    for (k = 0u; k < CE__XF_WORLD; k++) {
+                        parent[k][i] = row[k];
+                    }
+                }
+                ce__xf_compose(h, pos, lo, hi, parent);
+                for (i = lo; i < hi; i++) {
+                    if (h->dirty[pos + i] != 0u) {
+                        ce__xf_push_dirty(h, h->slot_of[pos + i]);
+                    }
+                }
+                done += hi - lo;
+            }
+        }
+    }
+    (void)ce_atomic_fetch_add_u32(&h->recomputed, done);
+}
+
+/* ************************************************************************** */
+/* HIERARCHY                                                                  */
+/* ************************************************************************** */
+
+ce_result ce_transform_hierarchy_create(const ce_transform_hierarchy_desc* desc, ce_transform_hierarchy** out_hierarchy)
+{
+    ce_result res;
+    ce_transform_hierarchy* h;
+    ce_size padded;
+    ce_size cap;
+    ce_u32 s;
+
+    res = CE_OK;
+    h   = CE_NULL;
+
+    if ((desc == CE_NULL) || (out_hierarchy == CE_NULL) || (desc->max_nodes == 0u) ||
+        (desc->max_nodes > CE_HANDLE_MAX_CAPACITY)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        h = (ce_transform_hierarchy*)ce_mem_calloc(sizeof(ce_transform_hierarchy), 0u, CE_MEM_TAG_RUNTIME);
+        if (h == CE_NULL) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (res == CE_OK) {
+        res = ce_handle_table_init(&h->nodes, desc->max_nodes, CE_MEM_TAG_RUNTIME);
+    }
+    if (res == CE_OK) {
+        /* The kernel reads whole groups: pad every stream past the last one. */
+        cap             = (ce_size)desc->max_nodes;
+        padded          = CE_ALIGN_UP(cap, (ce_size)CE_SIMD_WIDTH) + (ce_size)CE_SIMD_WIDTH;
+        h->index_block  = (ce_u32*)ce_mem_alloc(cap * 8u * sizeof(ce_u32), 0u, CE_MEM_TAG_RUNTIME);
+        h->dirty        = (ce_u8*)ce_mem_calloc(padded, 0u, CE_MEM_TAG_RUNTIME);
+        h->group_dirty  = (ce_atomic_u32*)ce_mem_calloc((padded / CE_SIMD_WIDTH) * sizeof(ce_atomic_u32), 0u,
+                                                        CE_MEM_TAG_RUNTIME);
+        h->stream_block = (ce_f32*)ce_mem_calloc(padded * (ce_size)CE__XF_STREAMS * sizeof(ce_f32), 16u,
+                                                 CE_MEM_TAG_RUNTIME);
+        h->world        = (ce_f32*)ce_mem_alloc(cap * CE__XF_WORLD * sizeof(ce_f32), 16u, CE_MEM_TAG_RUNTIME);
+        if ((h->index_block == CE_NULL) || (h->dirty == CE_NULL) || (h->group_dirty == CE_NULL) ||
+            (h->stream_block == CE_NULL) || (h->world == CE_NULL)) {
+            res = CE_ERR_OUT_OF_MEMORY;
+        } else {
+            h->dense        = h->index_block;
+            h->parent       = h->index_block + cap;
+            h->first_child  = h->index_block + (cap * 2u);
+            h->next_sibling = h->index_block + (cap * 3u);
+            h->prev_sibling = h->index_block + (cap * 4u);
+            h->depth        = h->index_block + (cap * 5u);
+            h->slot_of      = h->index_block + (cap * 6u);
+            h->parent_slot  = h->index_block + (cap * 7u);
+            for (s = 0u; s < (ce_u32)CE__XF_STREAMS; s++) {
+                h->streams[s] = h->stream_block + (padded * (ce_size)s);
+            }
+            h->min_dirty = CE__XF_STAGING;
+        }
+    }
+
+    if (res == CE_OK) {
+        *out_hierarchy = h;
+    } else if (h != CE_NULL) {
+        ce_mem_free(h->world);
+        ce_mem_free(h->stream_block);
+        ce_mem_free(h->group_dirty);
+        ce_mem_free(h->dirty);
+        ce_mem_free(h->index_block);
+        ce_handle_table_shutdown(&h->nodes);
+        ce_mem_free(h);
+    } else {
+        /* Nothing allocated. */
+    }
+
+    return res;
+}
+
+void ce_transform_hierarchy_destroy(ce_transform_hierarchy* hierarchy)
+{
+    if (hierarchy != CE_NULL) {
+        ce_mem_free(hierarchy->world);
+        ce_mem_free(hierarchy->stream_block);
+        ce_mem_free(hierarchy->group_dirty);
+        ce_mem_free(hierarchy->dirty);
+        ce_mem_free(hierarchy->index_block);
+        ce_handle_table_shutdown(&hierarchy->nodes);
+        ce_mem_free(hierarchy);
+    }
+}
+
+void ce_transform_update(ce_transform_hierarchy* hierarchy)
+{
+    ce__xf_level level;
+    ce_u32 first;
+    ce_u32 groups;
+    ce_u32 l;
+
+    if ((hierarchy != CE_NULL) && (hierarchy->min_dirty < CE__XF_STAGING)) {
+        ce_atomic_store_u32(&hierarchy->recomputed, 0u);
+        first   = hierarchy->level_start[hierarchy->min_dirty];
+        level.h = hierarchy;
+
+        /* Levels are contiguous: the first empty one ends the tree. */
+        l = hierarchy->min_dirty;
+        while ((l < CE_TRANSFORM_MAX_DEPTH) && (hierarchy->level_start[l] < hierarchy->level_start[l + 1u])) {
+            level.begin = hierarchy->level_start[l];
+            level.end   = hierarchy->level_start[l + 1u];
+            groups      = (((level.end - 1u) / CE_SIMD_WIDTH) - (level.begin / CE_SIMD_WIDTH)) + 1u;
+            ce_jobs_parallel_for(groups, CE__XF_GROUPS_PER_JOB, ce__xf_update_range, &level);
+            l += 1u;
+        }
+
+        ce__memset(&hierarchy->dirty[first], 0u, (ce_size)(hierarchy->count - first));
+        ce__memset(&hierarchy->group_dirty[first / CE_SIMD_WIDTH], 0u,
+                   (ce_size)(((hierarchy->count + CE_SIMD_WIDTH - 1u) / CE_SIMD_WIDTH) - (first / CE_SIMD_WIDTH)) *
+                       sizeof(ce_atomic_u32));
+        hierarchy->min_dirty = CE__XF_STAGING;
+    }
+}
+
+void ce_transform_get_stats(const ce_transform_hierarchy* hierarchy, ce_transform_stats* out_stats)
+{
+    ce_u32 l;
+
+    if ((hierarchy != CE_NULL) && (out_stats != CE_NULL)) {
+        l = 0u;
+        while ((l < CE_TRANSFORM_MAX_DEPTH) && (hierarchy->level_start[l] < hierarchy->level_start[l + 1u])) {
+            l += 1u;
+        }
+        out_stats->nodes      = hierarchy->count;
+        out_stats->levels     = l;
+        out_stats->recomputed = ce_atomic_load_u32(&hierarchy->recomputed);
+    }
+}
+
+/* ************************************************************************** */
+/* NODES                                                                      */
+/* ************************************************************************** */
+
+ce_result ce_transform_create(ce_transform_hierarchy* hierarchy, ce_transform_id parent, ce_transform_id* out_id)
+{
+    ce_transform_hierarchy* h;
+    ce_result res;
+    ce_u32 parent_slot;
+    ce_u32 depth;
+    ce_u32 slot;
+    ce_u32 pos;
+    ce_u32 s;
+
+    h           = hierarchy;
+    res         = CE_OK;
+    parent_slot = CE_HANDLE_INVALID;
+    depth       = 0u;
+    slot        = CE_HANDLE_INVALID;
+
+    if ((h == CE_NULL) || (out_id == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else if (parent != CE_HANDLE_NONE) {
+        parent_slot = ce_handle_table_resolve(&h->nodes, parent);
+        if (parent_slot == CE_HANDLE_INVALID) {
+            res = CE_ERR_NOT_FOUND;
+        } else {
+            depth = h->depth[parent_slot] + 1u;
+            res   = (depth < CE_TRANSFORM_MAX_DEPTH) ? CE_OK : CE_ERR_FULL;
+        }
+    } else {
+        /* New root. */
+    }
+
+    if (res == CE_OK) {
+        slot = ce_handle_table_alloc(&h->nodes);
+        res  = (slot != CE_HANDLE_INVALID) ? CE_OK : CE_ERR_FULL;
+    }
+
+    if (res == CE_OK) {
+        /* Enter through the staging level, then rotate into place. */
+        pos       = h->count;
+        h->count += 1u;
+        for (s = 0u; s < (ce_u32)CE__XF_STREAMS; s++) {
+            h->streams[s][pos] = 0.0f;
+        }
+        ce__memcpy(&h->world[pos * CE__XF_WORLD], ce__xf_identity, sizeof(ce__xf_identity));
+        h->streams[CE__XF_QW][pos] = 1.0f;
+        h->streams[CE__XF_SX][pos] = 1.0f;
+        h->streams[CE__XF_SY][pos] = 1.0f;
+        h->streams[CE__XF_SZ][pos] = 1.0f;
+        h->slot_of[pos]            = slot;
+        h->parent_slot[pos]        = parent_slot;
+        h->dirty[pos]              = 0u;
+        h->dense[slot]             = pos;
+        h->depth[slot]             = depth;
+        h->first_child[slot]       = CE_HANDLE_INVALID;
+        ce__xf_link(h, slot, parent_slot);
+        ce__xf_move_level(h, pos, CE__XF_STAGING, depth);
+        ce__xf_mark(h, slot);
+        *out_id = ce_handle_table_handle(&h->nodes, slot);
+    }
+
+    return res;
+}
+
+ce_result ce_transform_destroy(ce_transform_hierarchy* hierarchy, ce_transform_id id)
+{
+    ce_result res;
+    ce_u32 slot;
+    ce_u32 leaf;
+
+    res = CE_OK;
+    if (hierarchy == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        slot = ce_handle_table_resolve(&hierarchy->nodes, id);
+        if (slot == CE_HANDLE_INVALID) {
+            res = CE_ERR_NOT_FOUND;
+        } else {
+            /* Leaves first, so every removal is of a childless node. */
+            while (hierarchy->first_child[slot] != CE_HANDLE_INVALID) {
+                leaf = hierarchy->first_child[slot];
+                while (hierarchy->first_child[leaf] != CE_HANDLE_INVALID) {
+                    leaf = hierarchy->first_child[leaf];
+                }
+                ce__xf_remove(hierarchy, leaf);
+            }
+            ce__xf_remove(hierarchy, slot);
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_transform_set_parent(ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_transform_id parent)
+{
+    ce_transform_hierarchy* h;
+    ce_result res;
+    ce_u32 slot;
+    ce_u32 parent_slot;
+    ce_u32 new_depth;
+    ce_u32 deepest;
+    ce_u32 node;
+    ce_u32 up;
+
+    h           = hierarchy;
+    res         = CE_OK;
+    slot        = CE_HANDLE_INVALID;
+    parent_slot = CE_HANDLE_INVALID;
+    new_depth   = 0u;
+
+    if (h == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        slot = ce_handle_table_resolve(&h->nodes, id);
+        if (parent != CE_HANDLE_NONE) {
+            parent_slot = ce_handle_table_resolve(&h->nodes, parent);
+            res         = (parent_slot != CE_HANDLE_INVALID) ? CE_OK : CE_ERR_NOT_FOUND;
+        }
+        res = (slot != CE_HANDLE_INVALID) ? res : CE_ERR_NOT_FOUND;
+    }
+
+    if ((res == CE_OK) && (parent_slot != CE_HANDLE_INVALID)) {
+        up = parent_slot;
+        while ((up != CE_HANDLE_INVALID) && (up != slot)) {
+            up = h->parent[up];
+        }
+        res       = (up == slot) ? CE_ERR_INVALID_ARG : CE_OK;
+        new_depth = h->depth[parent_slot] + 1u;
+    }
+
+    if ((res == CE_OK) && (parent_slot != h->parent[slot])) {
+        deepest = h->depth[slot];
+        node    = slot;
+        while (node != CE_HANDLE_INVALID) {
+            deepest = (h->depth[node] > deepest) ? h->depth[node] : deepest;
+            node    = ce__xf_next(h, slot, node);
+        }
+        if (((deepest - h->depth[slot]) + new_depth) >= CE_TRANSFORM_MAX_DEPTH) {
+            res = CE_ERR_FULL;
+        }
+
+        if (res == CE_OK) {
+            ce__xf_unlink(h, slot);
+            ce__xf_link(h, slot, parent_slot);
+            h->parent_slot[h->dense[slot]] = parent_slot;
+            if (new_depth != h->depth[slot]) {
+                /* Every depth shifts by the same amount; each node rotates on its own. */
+                deepest = h->depth[slot];
+                node    = slot;
+                while (node != CE_HANDLE_INVALID) {
+                    up = (h->depth[node] - deepest) + new_depth;
+                    ce__xf_move_level(h, h->dense[node], h->depth[node], up);
+                    h->depth[node] = up;
+                    node           = ce__xf_next(h, slot, node);
+                }
+            }
+            ce__xf_mark(h, slot);
+        }
+    }
+
+    return res;
+}
+
+ce_transform_id ce_transform_get_parent(const ce_transform_hierarchy* hierarchy, ce_transform_id id)
+{
+    ce_transform_id parent;
+    ce_u32 slot;
+
+    parent = CE_HANDLE_NONE;
+    slot   = (hierarchy != CE_NULL) ? ce_handle_table_resolve(&hierarchy->nodes, id) : CE_HANDLE_INVALID;
+    if ((slot != CE_HANDLE_INVALID) && (hierarchy->parent[slot] != CE_HANDLE_INVALID)) {
+        parent = ce_handle_table_handle(&hierarchy->nodes, hierarchy->parent[slot]);
+    }
+
+    return parent;
+}
+
+ce_result ce_transform_set_local(ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_vec3f t, ce_quatf r,
+                                 ce_vec3f s)
+{
+    ce_result res;
+    ce_u32 slot;
+    ce_u32 pos;
+
+    res = CE_OK;
+    if (hierarchy == CE_NULL) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        slot = ce_handle_table_resolve(&hierarchy->nodes, id);
+        if (slot == CE_HANDLE_INVALID) {
+            res = CE_ERR_NOT_FOUND;
+        } else {
+            pos                                = hierarchy->dense[slot];
+            hierarchy->streams[CE__XF_TX][pos] = t.x;
+            hierarchy->streams[CE__XF_TY][pos] = t.y;
+            hierarchy->streams[CE__XF_TZ][pos] = t.z;
+            hierarchy->streams[CE__XF_QX][pos] = r.x;
+            hierarchy->streams[CE__XF_QY][pos] = r.y;
+            hierarchy->streams[CE__XF_QZ][pos] = r.z;
+            hierarchy->streams[CE__XF_QW][pos] = r.w;
+            hierarchy->streams[CE__XF_SX][pos] = s.x;
+            hierarchy->streams[CE__XF_SY][pos] = s.y;
+            hierarchy->streams[CE__XF_SZ][pos] = s.z;
+            ce__xf_mark(hierarchy, slot);
+        }
+    }
+
+    return res;
+}
+
+ce_result ce_transform_get_world(const ce_transform_hierarchy* hierarchy, ce_transform_id id, ce_mat4f* out_world)
+{
+    ce_result res;
+    ce_u32 slot;
+    ce_u32 pos;
+    ce_u32 col;
+    ce_u32 row;
+
+    res = CE_OK;
+    if ((hierarchy == CE_NULL) || (out_world == CE_NULL)) {
+        res = CE_ERR_INVALID_ARG;
+    } else {
+        slot = ce_handle_table_resolve(&hierarchy->nodes, id);
+        if (slot == CE_HANDLE_INVALID) {
+            res = CE_ERR_NOT_FOUND;
+        } else {
+            pos = hierarchy->dense[slot];
+            for (col = 0u; col < 4u; col++) {
+                for (row = 0u; row < 3u; row++) {
+                    out_world->m[(col * 4u) + row] = hierarchy->world[(pos * CE__XF_WORLD) + (col * 3u) + row];
+                }
+                out_world->m[(col * 4u) + 3u] = (col == 3u) ? 1.0f : 0.0f;
+            }
+        }
+    }
+
+    return res;
+}
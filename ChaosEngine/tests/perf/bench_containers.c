@@ -0,0 +1,128 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_containers.c
+ * @brief Dynamic array, hash map, SPSC ring and hashing.
+ */
+#include "perf.h"
+#include "core/chaos_containers.h"
+
+#define BENCH_ITEMS     65536u
+#define BENCH_MAP_KEYS  16384u
+#define BENCH_RING_SIZE 1024u
+#define BENCH_HASH_SIZE 65536u
+
+typedef struct bench_containers_s {
+    ce_dynarray  array;
+    ce_hashmap   map;
+    ce_spsc_ring ring;
+    ce_u8        bytes[BENCH_HASH_SIZE];
+} bench_containers;
+
+/* Keys spread like handles: no two share low bits by accident. */
+static ce_u64 bench_key(ce_u32 i)
+{
+    return ((ce_u64)i * 0x9E3779B97F4A7C15ull) | 1u;
+}
+
+static void bench_dynarray_push(void* user)
+{
+    bench_containers* b;
+    ce_u32 i;
+
+    b = (bench_containers*)user;
+    ce_dynarray_clear(&b->array);
+    for (i = 0u; i < BENCH_ITEMS; i++) {
+        (void)ce_dynarray_push(&b->array, &i);
+    }
+    perf_sink += b->array.count;
+}
+
+static void bench_hashmap_put(void* user)
+{
+    bench_containers* b;
+    ce_u32 i;
+
+    b = (bench_containers*)user;
+    ce_hashmap_clear(&b->map);
+    for (i = 0u; i < BENCH_MAP_KEYS; i++) {
+        (void)ce_hashmap_put(&b->map, bench_key(i), i);
+    }
+}
+
+static void bench_hashmap_get(void* user)
+{
+    bench_containers* b;
+    ce_u64 value;
+    ce_u64 sum;
+    ce_u32 i;
+
+    b   = (bench_containers*)user;
+    sum = 0u;
+    for (i = 0u; i < BENCH_MAP_KEYS; i++) {
+        if (ce_hashmap_get(&b->map, bench_key(i), &value) == CE_TRUE) {
+            sum += value;
+        }
+    }
+    perf_sink += sum;
+}
+
+static void bench_ring(void* user)
+{
+    bench_containers* b;
+    ce_u32 value;
+    ce_u32 sum;
+    ce_u32 i;
+    ce_u32 j;
+
+    b   = (bench_containers*)user;
+    sum = 0u;
+    for (i = 0u; i < BENCH_ITEMS; i += BENCH_RING_SIZE / 2u) {
+        for (j = 0u; j < BENCH_RING_SIZE / 2u; j++) {
+            value = i + j;
+            (void)ce_spsc_ring_push(&b->ring, &value);
+        }
+        while (ce_spsc_ring_pop(&b->ring, &value) == CE_TRUE) {
+            sum += value;
+        }
+    }
+    perf_sink += sum;
+}
+
+static void bench_hash_bytes(void* user)
+{
+    bench_containers* b;
+
+    b          = (bench_containers*)user;
+    perf_sink += ce_hash_bytes(b->bytes, sizeof(b->bytes));
+}
+
+void perf_suite_containers(perf_ctx* ctx)
+{
+    static bench_containers b;
+    ce_u32 i;
+
+    for (i = 0u; i < BENCH_HASH_SIZE; i++) {
+        b.bytes[i] = (ce_u8)(i * 31u);
+    }
+    if ((ce_dynarray_init(&b.array, sizeof(ce_u32), 16u, CE_MEM_TAG_GENERAL) == CE_OK) &&
+        (ce_hashmap_init(&b.map, 16u, CE_MEM_TAG_GENERAL) == CE_OK) &&
+        (ce_spsc_ring_init(&b.ring, sizeof(ce_u32), BENCH_RING_SIZE, CE_MEM_TAG_GENERAL) == CE_OK)) {
+        perf_run(ctx, "containers", "dynarray_push_64k", BENCH_ITEMS, bench_dynarray_push, &b);
+        perf_run(ctx, "containers", "hashmap_put_16k", BENCH_MAP_KEYS, bench_hashmap_put, &b);
+        bench_hashmap_put(&b);
+        perf_run(ctx, "containers", "hashmap_get_16k", BENCH_MAP_KEYS, bench_hashmap_get, &b);
+        perf_run(ctx, "containers", "spsc_ring_64k", BENCH_ITEMS, bench_ring, &b);
+        perf_run(ctx, "containers", "hash_bytes_64k", BENCH_HASH_SIZE, bench_hash_bytes, &b);
+    }
+    ce_spsc_ring_shutdown(&b.ring);
+    ce_hashmap_shutdown(&b.map);
+    ce_dynarray_shutdown(&b.array);
+}
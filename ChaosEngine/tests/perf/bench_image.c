@@ -0,0 +1,378 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_image.c
+ * @brief Decoding 1000 images one by one vs ce_image_decode_batch() on the job pool.
+ *
+ * The images are encoded here, so nothing is read from disk: 64x64 RGBA PNGs
+ * (Sub filter, fixed-Huffman deflate with distance-4 matches) and RLE TGAs,
+ * each with its own gradient and noise. PNG needs stb_image; a build
+ * without it skips those cases and still times the TGA ones.
+ */
+#include "perf.h"
+#include "resources/chaos_image.h"
+#include "runtime/chaos_jobs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_IMAGES   1000u
+#define BENCH_SIZE     64u
+#define BENCH_PIXELS   (BENCH_SIZE * BENCH_SIZE)
+#define BENCH_RAW      (BENCH_SIZE * ((BENCH_SIZE * 4u) + 1u)) /* Filtered PNG scanlines. */
+#define BENCH_FILE_MAX ((BENCH_RAW * 2u) + 256u)                /* Worst case, every byte a 9-bit literal. */
+
+typedef struct bench_image_s {
+    ce_image_load loads[BENCH_IMAGES];
+    ce_u8*        files;  /* BENCH_IMAGES slots of BENCH_FILE_MAX bytes. */
+    ce_u8*        pixels; /* BENCH_IMAGES decoded images. */
+    ce_u32        crc[256];
+} bench_image;
+
+typedef struct bench_bits_s {
+    ce_u8* out;
+    ce_u32 pos;
+    ce_u32 acc;
+    ce_u32 count;
+} bench_bits;
+
+/* ************************************************************************** */
+/* ENCODERS                                                                   */
+/* ************************************************************************** */
+
+static ce_u8 bench_texel(ce_u32 seed, ce_u32 x, ce_u32 y, ce_u32 c)
+{
+    ce_u32 h;
+
+    h = ((x * 73856093u) ^ (y * 19349663u) ^ (seed * 83492791u) ^ (c * 2654435761u)) >> 13u;
+
+    return (ce_u8)(((x * (c + 1u) * 3u) + (y * (seed % 7u + 1u)) + (h & 7u)) & 0xFFu);
+}
+
+static void bench_put_be32(ce_u8* p, ce_u32 v)
+{
+    p[0] = (ce_u8)(v >> 24u);
+    p[1] = (ce_u8)(v >> 16u);
+    p[2] = (ce_u8)(v >> 8u);
+    p[3] = (ce_u8)v;
+}
+
+static ce_u32 bench_crc(const ce_u32* table, const ce_u8* p, ce_u32 n)
+{
+    ce_u32 crc;
+    ce_u32 i;
+
+    crc = ~0u;
+    for (i = 0u; i < n; i++) {
+        crc = table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8u);
+    }
+
+    return ~crc;
+}
+
+/* Deflate codes are sent most significant bit first into an LSB-first stream. */
+static void bench_put_code(bench_bits* b, ce_u32 code, ce_u32 len)
+{
+    ce_u32 i;
+
+    for (i = 0u; i < len; i++) {
+        b->acc |= ((code >> (len - 1u - i)) & 1u) << b->count;
+        b->count++;
+        if (b->count == 8u) {
+            b->out[b->pos++] = (ce_u8)b->acc;
+            b->acc           = 0u;
+            b->count         = 0u;
+        }
+    }
+}
+
+static void bench_put_bits(bench_bits* b, ce_u32 value, ce_u32 len)
+{
+    ce_u32 i;
+
+    for (i = 0u; i < len; i++) {
+        bench_put_code(b, (value >> i) & 1u, 1u);
+    }
+}
+
+/* Fixed-Huffman literal / length symbol. */
+static void bench_put_symbol(bench_bits* b, ce_u32 sym)
+{
+    if (sym < 144u) {
+        bench_put_code(b, 0x30u + sym, 8u);
+    } else if (sym < 256u) {
+        bench_put_code(b, 0x190u + (sym - 144u), 9u);
+    } else if (sym < 280u) {
+        bench_put_code(b, sym - 256u, 7u);
+    } else {
+        bench_put_code(b, 0xC0u + (sym - 280u), 8u);
+    }
+}
+
+static void bench_put_length(bench_bits* b, ce_u32 len)
+{
+    static const ce_u16 base[29] = { 3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                     31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    static const ce_u8 extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    ce_u32 i;
+
+    i = 28u;
+    while (base[i] > len) {
+        i--;
+    }
+    bench_put_symbol(b, 257u + i);
+    bench_put_bits(b, len - base[i], extra[i]);
+}
+
+/* Greedy distance-4 matches: a Sub-filtered gradient repeats its residual every texel. */
+static ce_u32 bench_deflate(const ce_u8* raw, ce_u32 n, ce_u8* out)
+{
+    bench_bits b;
+    ce_u32 i;
+    ce_u32 len;
+    ce_u32 s1;
+    ce_u32 s2;
+
+    b.out   = out;
+    b.pos   = 0u;
+    b.acc   = 0u;
+    b.count = 0u;
+    out[b.pos++] = 0x78u;
+    out[b.pos++] = 0x01u;
+    bench_put_bits(&b, 1u, 1u); /* BFINAL */
+    bench_put_bits(&b, 1u, 2u); /* Fixed Huffman. */
+
+    i = 0u;
+    while (i < n) {
+        len = 0u;
+        while ((i >= 4u) && ((i + len) < n) && (len < 258u) && (raw[i + len] == raw[i + len - 4u])) {
+            len++;
+        }
+        if (len >= 3u) {
+            bench_put_length(&b, len);
+            bench_put_code(&b, 3u, 5u); /* Distance 4. */
+            i += len;
+        } else {
+            bench_put_symbol(&b, raw[i]);
+            i++;
+        }
+    }
+    bench_put_symbol(&b, 256u);
+    if (b.count != 0u) {
+        out[b.pos++] = (ce_u8)b.acc;
+    }
+
+    s1 = 1u;
+    s2 = 0u;
+    for (i = 0u; i < n; i++) {
+        s1 = (s1 + raw[i]) % 65521u;
+        s2 = (s2 + s1) % 65521u;
+    }
+    bench_put_be32(&out[b.pos], (s2 << 16u) | s1);
+
+    return b.pos + 4u;
+}
+
+/* Appends a chunk whose payload is already at p + 8. */
+static ce_u32 bench_png_chunk(const bench_image* bench, ce_u8* p, const char* type, ce_u32 len)
+{
+    bench_put_be32(p, len);
+    (void)memcpy(p + 4, type, 4u);
+    bench_put_be32(p + 8u + len, bench_crc(bench->crc, p + 4, len + 4u));
+
+    return len + 12u;
+}
+
+static ce_size bench_png(const bench_image* bench, ce_u32 seed, ce_u8* raw, ce_u8* out)
+{
+    static const ce_u8 signature[8] = { 0x89u, 'P', 'N', 'G', 0x0Du, 0x0Au, 0x1Au, 0x0Au };
+    ce_u8* row;
+    ce_u32 pos;
+    ce_u32 x;
+    ce_u32 y;
+    ce_u32 c;
+
+    for (y = 0u; y < BENCH_SIZE; y++) {
+        row    = &raw[y * ((BENCH_SIZE * 4u) + 1u)];
+        row[0] = 1u; /* Sub */
+        for (x = 0u; x < BENCH_SIZE; x++) {
+            for (c = 0u; c < 4u; c++) {
+                row[1u + (x * 4u) + c] = (ce_u8)(bench_texel(seed, x, y, c) -
+                                                 ((x != 0u) ? bench_texel(seed, x - 1u, y, c) : 0u));
+            }
+        }
+    }
+
+    (void)memcpy(out, signature, sizeof(signature));
+    pos = sizeof(signature);
+    bench_put_be32(&out[pos + 8u], BENCH_SIZE);
+    bench_put_be32(&out[pos + 12u], BENCH_SIZE);
+    out[pos + 16u] = 8u; /* Bit depth. */
+    out[pos + 17u] = 6u; /* RGBA */
+    out[pos + 18u] = 0u;
+    out[pos + 19u] = 0u;
+    out[pos + 20u] = 0u;
+    pos += bench_png_chunk(bench, &out[pos], "IHDR", 13u);
+    pos += bench_png_chunk(bench, &out[pos], "IDAT", bench_deflate(raw, BENCH_RAW, &out[pos + 8u]));
+    pos += bench_png_chunk(bench, &out[pos], "IEND", 0u);
+
+    return (ce_size)pos;
+}
+
+/* 32-bit BGRA, RLE, top-left origin; runs of equal texels, raw packets otherwise. */
+static ce_size bench_tga(ce_u32 seed, ce_u8* out)
+{
+    ce_u8 texels[BENCH_PIXELS][4];
+    ce_u32 pos;
+    ce_u32 i;
+    ce_u32 n;
+
+    for (i = 0u; i < BENCH_PIXELS; i++) {
+        /* Coarser gradient than the PNG so runs appear. */
+        texels[i][0] = bench_texel(seed, (i % BENCH_SIZE) / 4u, i / BENCH_SIZE, 2u) & 0xF8u;
+        texels[i][1] = bench_texel(seed, (i % BENCH_SIZE) / 4u, i / BENCH_SIZE, 1u) & 0xF8u;
+        texels[i][2] = bench_texel(seed, (i % BENCH_SIZE) / 4u, i / BENCH_SIZE, 0u) & 0xF8u;
+        texels[i][3] = 0xFFu;
+    }
+
+    (void)memset(out, 0, 18u);
+    out[2]  = 10u; /* RLE true-colour. */
+    out[12] = (ce_u8)BENCH_SIZE;
+    out[13] = (ce_u8)(BENCH_SIZE >> 8u);
+    out[14] = (ce_u8)BENCH_SIZE;
+    out[15] = (ce_u8)(BENCH_SIZE >> 8u);
+    out[16] = 32u;
+    out[17] = 0x28u; /* 8 alpha bits, top-left origin. */
+    pos     = 18u;
+
+    i = 0u;
+    while (i < BENCH_PIXELS) {
+        n = 1u;
+        while (((i + n) < BENCH_PIXELS) && (n < 128u) && (memcmp(texels[i + n], texels[i], 4u) == 0)) {
+            n++;
+        }
+        if (n > 1u) {
+            out[pos++] = (ce_u8)(0x80u | (n - 1u));
+            (void)memcpy(&out[pos], texels[i], 4u);
+            pos += 4u;
+        } else {
+            while (((i + n) < BENCH_PIXELS) && (n < 128u) &&
+                   (memcmp(texels[i + n], texels[i + n - 1u], 4u) != 0)) {
+                n++;
+            }
+            out[pos++] = (ce_u8)(n - 1u);
+            (void)memcpy(&out[pos], texels[i], (size_t)n * 4u);
+            pos += n * 4u;
+        }
+        i += n;
+    }
+
+    return (ce_size)pos;
+}
+
+/* ************************************************************************** */
+/* CASES                                                                      */
+/* ************************************************************************** */
+
+static void bench_decode_inline(void* user)
+{
+    bench_image* b;
+    ce_image_load* l;
+    ce_u32 i;
+
+    b = (bench_image*)user;
+    for (i = 0u; i < BENCH_IMAGES; i++) {
+        l         = &b->loads[i];
+        l->result = ce_image_decode(l->data, l->size, l->layout, l->flags, l->dst, l->dst_size, &l->info);
+    }
+    perf_sink += b->pixels[(BENCH_IMAGES / 2u) * BENCH_PIXELS * 4u];
+}
+
+static void bench_decode_batch(void* user)
+{
+    bench_image* b;
+
+    b = (bench_image*)user;
+    (void)ce_image_decode_batch(b->loads, BENCH_IMAGES);
+    perf_sink += b->pixels[(BENCH_IMAGES / 2u) * BENCH_PIXELS * 4u];
+}
+
+/* Encodes every image as a TGA (`tga` != 0) or a PNG; CE_FALSE when this build cannot decode them. */
+static ce_bool bench_image_prepare(bench_image* b, ce_u32 tga)
+{
+    ce_image_info info;
+    ce_u8* raw;
+    ce_bool ok;
+    ce_u32 i;
+
+    raw = (ce_u8*)malloc(BENCH_RAW);
+    ok  = (raw != NULL) ? CE_TRUE : CE_FALSE;
+    for (i = 0u; (ok == CE_TRUE) && (i < BENCH_IMAGES); i++) {
+        b->loads[i].data     = &b->files[(size_t)i * BENCH_FILE_MAX];
+        b->loads[i].size     = (tga != 0u) ? bench_tga(i, &b->files[(size_t)i * BENCH_FILE_MAX])
+                                           : bench_png(b, i, raw, &b->files[(size_t)i * BENCH_FILE_MAX]);
+        b->loads[i].dst      = &b->pixels[(size_t)i * BENCH_PIXELS * 4u];
+        b->loads[i].dst_size = (ce_size)BENCH_PIXELS * 4u;
+        b->loads[i].layout   = CE_IMAGE_LAYOUT_BGRA8;
+        b->loads[i].flags    = 0u;
+    }
+    free(raw);
+
+    if ((ok == CE_TRUE) && (ce_image_probe(b->loads[0].data, b->loads[0].size, 0u, &info) != CE_OK)) {
+        ok = CE_FALSE;
+    }
+
+    return ok;
+}
+
+void perf_suite_image(perf_ctx* ctx)
+{
+    bench_image* b;
+    ce_u32 y;
+    ce_u32 x;
+
+    b = (bench_image*)calloc(1u, sizeof(bench_image));
+    if (b != NULL) {
+        b->files  = (ce_u8*)malloc((size_t)BENCH_IMAGES * BENCH_FILE_MAX);
+        b->pixels = (ce_u8*)malloc((size_t)BENCH_IMAGES * BENCH_PIXELS * 4u);
+    }
+    if ((b != NULL) && (b->files != NULL) && (b->pixels != NULL)) {
+        for (y = 0u; y < 256u; y++) {
+            b->crc[y] = y;
+            for (x = 0u; x < 8u; x++) {
+                b->crc[y] = ((b->crc[y] & 1u) != 0u) ? (0xEDB88320u ^ (b->crc[y] >> 1u)) : (b->crc[y] >> 1u);
+            }
+        }
+        /* Without a pool the batch would run inline and compare nothing. */
+        (void)ce_jobs_init(0u);
+
+        if (bench_image_prepare(b, 0u) == CE_TRUE) {
+            perf_run(ctx, "image", "png_1000_inline", (ce_u64)BENCH_IMAGES * BENCH_PIXELS, bench_decode_inline, b);
+            perf_run(ctx, "image", "png_1000_batch", (ce_u64)BENCH_IMAGES * BENCH_PIXELS, bench_decode_batch, b);
+        } else if ((ctx->filter == NULL) || (strstr("image/png_1000_inline", ctx->filter) != NULL) ||
+                   (strstr("image/png_1000_batch", ctx->filter) != NULL)) {
+            printf("%-40s skipped (built without stb_image)\n", "image/png_1000_*");
+        } else {
+            /* Filtered out. */
+        }
+        if (bench_image_prepare(b, 1u) == CE_TRUE) {
+            perf_run(ctx, "image", "tga_1000_inline", (ce_u64)BENCH_IMAGES * BENCH_PIXELS, bench_decode_inline, b);
+            perf_run(ctx, "image", "tga_1000_batch", (ce_u64)BENCH_IMAGES * BENCH_PIXELS, bench_decode_batch, b);
+        }
+
+        ce_jobs_shutdown();
+    }
+    if (b != NULL) {
+        free(b->files);
+        free(b->pixels);
+    }
+    free(b);
+}
@@ -0,0 +1,69 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_memory.c
+ * @brief Heap and arena allocators.
+ */
+#include "perf.h"
+#include "core/chaos_memory.h"
+
+#define BENCH_ALLOCS 4096u
+
+typedef struct bench_memory_s {
+    void*    ptrs[BENCH_ALLOCS];
+    ce_arena arena;
+} bench_memory;
+
+/* 16 B .. 4 KiB, mixed so size classes and alignment paths all get hit. */
+static ce_size bench_size(ce_u32 i)
+{
+    return (ce_size)16u << ((i * 7u) % 9u);
+}
+
+static void bench_heap(void* user)
+{
+    bench_memory* b;
+    ce_u32 i;
+
+    b = (bench_memory*)user;
+    for (i = 0u; i < BENCH_ALLOCS; i++) {
+        b->ptrs[i] = ce_mem_alloc(bench_size(i), ((i & 3u) == 0u) ? 64u : 0u, CE_MEM_TAG_GENERAL);
+    }
+    /* Free in a different order than allocation, as real workloads do. */
+    for (i = 0u; i < BENCH_ALLOCS; i++) {
+        ce_mem_free(b->ptrs[(i * 2053u) % BENCH_ALLOCS]);
+    }
+}
+
+static void bench_arena(void* user)
+{
+    bench_memory* b;
+    ce_uptr sum;
+    ce_u32 i;
+
+    b   = (bench_memory*)user;
+    sum = 0u;
+    ce_arena_reset(&b->arena);
+    for (i = 0u; i < BENCH_ALLOCS * 16u; i++) {
+        sum += (ce_uptr)ce_arena_alloc(&b->arena, 32u, 16u);
+    }
+    perf_sink += sum;
+}
+
+void perf_suite_memory(perf_ctx* ctx)
+{
+    static bench_memory b;
+
+    perf_run(ctx, "memory", "heap_alloc_free_4k", BENCH_ALLOCS, bench_heap, &b);
+    if (ce_arena_init(&b.arena, (ce_size)BENCH_ALLOCS * 16u * 32u, CE_MEM_TAG_GENERAL) == CE_OK) {
+        perf_run(ctx, "memory", "arena_alloc_64k", BENCH_ALLOCS * 16u, bench_arena, &b);
+        ce_arena_shutdown(&b.arena);
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_mixer.c
+ * @brief Audio mixer render blocks at native rate and through both resamplers.
+ */
+#include "perf.h"
+#include "audio/chaos_mixer.h"
+
+#include <stdlib.h>
+
+#define BENCH_RATE   48000u
+#define BENCH_FRAMES 1024u
+#define BENCH_VOICES 64u
+
+typedef struct bench_mixer_s {
+    ce_mixer* mixer;
+    ce_f32    out[BENCH_FRAMES * 2u];
+} bench_mixer;
+
+static void bench_render(void* user)
+{
+    bench_mixer* b;
+
+    b = (bench_mixer*)user;
+    ce_mixer_render(b->mixer, b->out, BENCH_FRAMES);
+    perf_sink += (ce_u64)(b->out[BENCH_FRAMES] * 1000.0f);
+}
+
+/* BENCH_VOICES looping copies of `sound`, spread across the stereo field. */
+static void bench_mixer_case(perf_ctx* ctx, const char* name, const ce_sound* sound, ce_resample_quality quality)
+{
+    static bench_mixer b;
+    ce_mixer_desc desc;
+    ce_voice_params params;
+    ce_u32 i;
+
+    desc.sample_rate      = BENCH_RATE;
+    desc.max_voices       = BENCH_VOICES;
+    desc.command_capacity = 0u;
+    desc.real_voice_limit = 0u;
+    if (ce_mixer_create(&desc, &b.mixer) == CE_OK) {
+        for (i = 0u; i < BENCH_VOICES; i++) {
+            params.volume         = 0.5f / (ce_f32)BENCH_VOICES;
+            params.pan            = ((ce_f32)i / (ce_f32)(BENCH_VOICES - 1u)) * 2.0f - 1.0f;
+            params.loop           = CE_TRUE;
+            params.fade_in_frames = 0u;
+            params.quality        = quality;
+            (void)ce_mixer_play(b.mixer, sound, &params);
+        }
+        /* Apply the play commands before timing. */
+        bench_render(&b);
+        perf_run(ctx, "mixer", name, (ce_u64)BENCH_FRAMES * BENCH_VOICES, bench_render, &b);
+        ce_mixer_destroy(b.mixer);
+    }
+}
+
+void perf_suite_mixer(perf_ctx* ctx)
+{
+    ce_f32* samples;
+    ce_sound sound;
+    ce_u32 i;
+
+    samples = (ce_f32*)malloc((size_t)BENCH_RATE * 2u * sizeof(ce_f32));
+    if (samples != NULL) {
+        /* One second of a 440 Hz / 660 Hz saw pair, synthesized so nothing is read from disk. */
+        for (i = 0u; i < BENCH_RATE; i++) {
+            samples[i]              = ((ce_f32)((i * 440u) % BENCH_RATE) / (ce_f32)BENCH_RATE) - 0.5f;
+            samples[BENCH_RATE + i] = ((ce_f32)((i * 660u) % BENCH_RATE) / (ce_f32)BENCH_RATE) - 0.5f;
+        }
+        sound.channels[0]   = samples;
+        sound.channels[1]   = samples + BENCH_RATE;
+        sound.channel_count = 2u;
+        sound.frame_count   = BENCH_RATE;
+
+        sound.sample_rate = BENCH_RATE;
+        bench_mixer_case(ctx, "64_voices_native", &sound, CE_RESAMPLE_LINEAR);
+        sound.sample_rate = 44100u;
+        bench_mixer_case(ctx, "64_voices_linear", &sound, CE_RESAMPLE_LINEAR);
+        bench_mixer_case(ctx, "64_voices_polyphase", &sound, CE_RESAMPLE_POLYPHASE);
+    }
+    free(samples);
+}
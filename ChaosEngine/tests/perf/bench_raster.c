@@ -0,0 +1,115 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_raster.c
+ * @brief Software rasterizer: target clear and a perspective grid mesh.
+ */
+#include "perf.h"
+#include "gfx/chaos_sw_raster.h"
+
+#include <stdlib.h>
+
+#define BENCH_WIDTH  640u
+#define BENCH_HEIGHT 360u
+#define BENCH_GRID_X 64u
+#define BENCH_GRID_Y 36u
+#define BENCH_VERTS  ((BENCH_GRID_X + 1u) * (BENCH_GRID_Y + 1u))
+#define BENCH_TRIS   (BENCH_GRID_X * BENCH_GRID_Y * 2u)
+
+typedef struct bench_raster_s {
+    ce_sw_target target;
+    ce_sw_mesh   mesh;
+    ce_mat4f     mvp;
+    ce_f32       x[BENCH_VERTS];
+    ce_f32       y[BENCH_VERTS];
+    ce_f32       z[BENCH_VERTS];
+    ce_color     colors[BENCH_VERTS];
+    ce_u32       indices[BENCH_TRIS * 3u];
+} bench_raster;
+
+static void bench_clear(void* user)
+{
+    bench_raster* b;
+
+    b = (bench_raster*)user;
+    ce_sw_target_clear(&b->target, CE_COLOR_BLACK, 1.0f);
+    perf_sink += b->target.color[0];
+}
+
+static void bench_draw_grid(void* user)
+{
+    bench_raster* b;
+
+    b = (bench_raster*)user;
+    ce_sw_target_clear(&b->target, CE_COLOR_BLACK, 1.0f);
+    (void)ce_sw_draw_mesh(&b->target, &b->mesh, &b->mvp, CE_COLOR_WHITE, CE_SW_CULL_NONE);
+    perf_sink += b->target.color[(BENCH_HEIGHT / 2u) * b->target.stride + (BENCH_WIDTH / 2u)];
+}
+
+/* A floor stretching to the horizon: small far triangles, large near ones. */
+static void bench_raster_mesh(bench_raster* b)
+{
+    ce_mat4f proj;
+    ce_mat4f view;
+    ce_u32 gx;
+    ce_u32 gy;
+    ce_u32 v;
+    ce_u32* idx;
+
+    for (gy = 0u; gy <= BENCH_GRID_Y; gy++) {
+        for (gx = 0u; gx <= BENCH_GRID_X; gx++) {
+            v            = (gy * (BENCH_GRID_X + 1u)) + gx;
+            b->x[v]      = ((ce_f32)gx - ((ce_f32)BENCH_GRID_X * 0.5f)) * 0.5f;
+            b->y[v]      = 0.0f;
+            b->z[v]      = -(ce_f32)gy * 0.5f;
+            b->colors[v] = CE_RGBA((ce_u8)(gx * 4u), (ce_u8)(gy * 7u), 128, 255);
+        }
+    }
+    idx = b->indices;
+    for (gy = 0u; gy < BENCH_GRID_Y; gy++) {
+        for (gx = 0u; gx < BENCH_GRID_X; gx++) {
+            v      = (gy * (BENCH_GRID_X + 1u)) + gx;
+            idx[0] = v;
+            idx[1] = v + 1u;
+            idx[2] = v + BENCH_GRID_X + 1u;
+            idx[3] = v + 1u;
+            idx[4] = v + BENCH_GRID_X + 2u;
+            idx[5] = v + BENCH_GRID_X + 1u;
+            idx   += 6;
+        }
+    }
+
+    b->mesh.x            = b->x;
+    b->mesh.y            = b->y;
+    b->mesh.z            = b->z;
+    b->mesh.colors       = b->colors;
+    b->mesh.indices      = b->indices;
+    b->mesh.vertex_count = BENCH_VERTS;
+    b->mesh.index_count  = BENCH_TRIS * 3u;
+
+    ce_mat4f_perspective(&proj, 1.0f, (ce_f32)BENCH_WIDTH / (ce_f32)BENCH_HEIGHT, 0.1f, 100.0f);
+    ce_mat4f_look_at(&view, ce_vec3f_make(0.0f, 3.0f, 2.0f), ce_vec3f_make(0.0f, 0.0f, -6.0f),
+                     ce_vec3f_make(0.0f, 1.0f, 0.0f));
+    ce_mat4f_mul(&b->mvp, &proj, &view);
+}
+
+void perf_suite_raster(perf_ctx* ctx)
+{
+    bench_raster* b;
+
+    b = (bench_raster*)calloc(1u, sizeof(bench_raster));
+    if ((b != NULL) && (ce_sw_target_init(&b->target, BENCH_WIDTH, BENCH_HEIGHT) == CE_OK)) {
+        bench_raster_mesh(b);
+        perf_run(ctx, "raster", "clear_640x360", BENCH_WIDTH * BENCH_HEIGHT, bench_clear, b);
+        perf_run(ctx, "raster", "grid_4608_tris", BENCH_TRIS, bench_draw_grid, b);
+        ce_sw_target_shutdown(&b->target);
+    }
+    free(b);
+}
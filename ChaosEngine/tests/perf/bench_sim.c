@@ -0,0 +1,153 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_sim.c
+ * @brief Per-frame simulation work: ECS iteration and transform propagation.
+ *
+ * Runs without a job pool so the numbers measure the kernels, not the
+ * machine's core count.
+ */
+#include "perf.h"
+#include "runtime/chaos_ecs.h"
+#include "runtime/chaos_transform.h"
+
+#define BENCH_ENTITIES 100000u
+#define BENCH_NODES    16384u
+#define BENCH_FANOUT   4u
+#define BENCH_SPARSE   64u
+
+typedef struct bench_vec_s {
+    ce_f32 x;
+    ce_f32 y;
+    ce_f32 z;
+} bench_vec;
+
+typedef struct bench_sim_s {
+    ce_ecs_world*           world;
+    ce_component_id         position;
+    ce_component_id         velocity;
+    ce_transform_hierarchy* hierarchy;
+    ce_transform_id         nodes[BENCH_NODES];
+    ce_u32                  frame;
+} bench_sim;
+
+static void bench_integrate_chunk(void* user, const ce_ecs_view* view)
+{
+    const bench_sim* b;
+    bench_vec* pos;
+    const bench_vec* vel;
+    ce_u32 i;
+
+    b   = (const bench_sim*)user;
+    pos = (bench_vec*)ce_ecs_column(view, b->position);
+    vel = (const bench_vec*)ce_ecs_column(view, b->velocity);
+    for (i = 0u; i < view->count; i++) {
+        pos[i].x += vel[i].x * (1.0f / 60.0f);
+        pos[i].y += vel[i].y * (1.0f / 60.0f);
+        pos[i].z += vel[i].z * (1.0f / 60.0f);
+    }
+}
+
+static void bench_ecs_query(void* user)
+{
+    bench_sim* b;
+    ce_ecs_query query;
+
+    b             = (bench_sim*)user;
+    query.read    = CE_ECS_BIT(b->velocity);
+    query.write   = CE_ECS_BIT(b->position);
+    query.exclude = 0u;
+    ce_ecs_query_each(b->world, &query, bench_integrate_chunk, b);
+}
+
+static void bench_transform_full(void* user)
+{
+    bench_sim* b;
+
+    b = (bench_sim*)user;
+    b->frame++;
+    (void)ce_transform_set_local(b->hierarchy, b->nodes[0], ce_vec3f_make((ce_f32)(b->frame & 7u), 0.0f, 0.0f),
+                                 ce_quatf_identity(), ce_vec3f_make(1.0f, 1.0f, 1.0f));
+    ce_transform_update(b->hierarchy);
+}
+
+static void bench_transform_sparse(void* user)
+{
+    bench_sim* b;
+    ce_u32 i;
+
+    b = (bench_sim*)user;
+    b->frame++;
+    for (i = 0u; i < BENCH_SPARSE; i++) {
+        (void)ce_transform_set_local(b->hierarchy, b->nodes[BENCH_NODES - 1u - ((i * 251u) % (BENCH_NODES / 2u))],
+                                     ce_vec3f_make(0.0f, (ce_f32)(b->frame & 7u), 0.0f), ce_quatf_identity(),
+                                     ce_vec3f_make(1.0f, 1.0f, 1.0f));
+    }
+    ce_transform_update(b->hierarchy);
+}
+
+static ce_result bench_sim_setup(bench_sim* b)
+{
+    ce_ecs_world_desc world_desc;
+    ce_transform_hierarchy_desc hierarchy_desc;
+    ce_entity entity;
+    bench_vec* v;
+    ce_result res;
+    ce_u32 i;
+
+    world_desc.max_entities = BENCH_ENTITIES;
+    res = ce_ecs_world_create(&world_desc, &b->world);
+    if (res == CE_OK) {
+        res = ce_ecs_component_register(b->world, "position", sizeof(bench_vec), 4u, &b->position);
+    }
+    if (res == CE_OK) {
+        res = ce_ecs_component_register(b->world, "velocity", sizeof(bench_vec), 4u, &b->velocity);
+    }
+    for (i = 0u; (res == CE_OK) && (i < BENCH_ENTITIES); i++) {
+        res = ce_ecs_entity_create(b->world, CE_ECS_BIT(b->position) | CE_ECS_BIT(b->velocity), &entity);
+        if (res == CE_OK) {
+            v    = (bench_vec*)ce_ecs_entity_get(b->world, entity, b->velocity);
+            v->x = (ce_f32)(i % 7u);
+            v->y = 1.0f;
+            v->z = -(ce_f32)(i % 3u);
+        }
+    }
+
+    hierarchy_desc.max_nodes = BENCH_NODES;
+    if (res == CE_OK) {
+        res = ce_transform_hierarchy_create(&hierarchy_desc, &b->hierarchy);
+    }
+    for (i = 0u; (res == CE_OK) && (i < BENCH_NODES); i++) {
+        res = ce_transform_create(b->hierarchy, (i == 0u) ? CE_HANDLE_NONE : b->nodes[(i - 1u) / BENCH_FANOUT],
+                                  &b->nodes[i]);
+        if (res == CE_OK) {
+            res = ce_transform_set_local(b->hierarchy, b->nodes[i], ce_vec3f_make(1.0f, 0.0f, 0.0f),
+                                         ce_quatf_identity(), ce_vec3f_make(1.0f, 1.0f, 1.0f));
+        }
+    }
+    if (res == CE_OK) {
+        ce_transform_update(b->hierarchy);
+    }
+
+    return res;
+}
+
+void perf_suite_sim(perf_ctx* ctx)
+{
+    static bench_sim b;
+
+    if (bench_sim_setup(&b) == CE_OK) {
+        perf_run(ctx, "sim", "ecs_integrate_100k", BENCH_ENTITIES, bench_ecs_query, &b);
+        perf_run(ctx, "sim", "transform_full_16k", BENCH_NODES, bench_transform_full, &b);
+        perf_run(ctx, "sim", "transform_sparse_64", BENCH_SPARSE, bench_transform_sparse, &b);
+    }
+    ce_transform_hierarchy_destroy(b.hierarchy);
+    ce_ecs_world_destroy(b.world);
+}
@@ -0,0 +1,149 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file bench_string.c
+ * @brief Memory/string kernels and number conversion.
+ */
+#include "perf.h"
+#include "utility/chaos_string.h"
+#include "utility/chaos_conv.h"
+
+#define BENCH_BYTES   (1u << 20)
+#define BENCH_NUMBERS 4096u
+
+typedef struct bench_string_s {
+    ce_u8   src[BENCH_BYTES];
+    ce_u8   dst[BENCH_BYTES];
+    ce_char text[BENCH_NUMBERS * 24u];
+    ce_size text_len;
+} bench_string;
+
+static void bench_memcpy(void* user)
+{
+    bench_string* b;
+
+    b = (bench_string*)user;
+    (void)ce__memcpy(b->dst, b->src, BENCH_BYTES);
+    perf_sink += b->dst[BENCH_BYTES / 2u];
+}
+
+static void bench_memset(void* user)
+{
+    bench_string* b;
+
+    b = (bench_string*)user;
+    (void)ce__memset(b->dst, (ce_u8)perf_sink, BENCH_BYTES);
+    perf_sink += b->dst[BENCH_BYTES / 3u];
+}
+
+static void bench_memcmp(void* user)
+{
+    bench_string* b;
+
+    b          = (bench_string*)user;
+    perf_sink += (ce_u64)(ce_s64)ce__memcmp(b->src, b->dst, BENCH_BYTES);
+}
+
+static void bench_memmove(void* user)
+{
+    bench_string* b;
+
+    b = (bench_string*)user;
+    (void)ce__memmove(b->dst + 1, b->dst, BENCH_BYTES - 1u);
+    perf_sink += b->dst[BENCH_BYTES - 1u];
+}
+
+static void bench_strlen(void* user)
+{
+    bench_string* b;
+
+    b          = (bench_string*)user;
+    perf_sink += ce__strlen((const ce_char*)b->src);
+}
+
+static void bench_u64_to_str(void* user)
+{
+    ce_char buf[32];
+    ce_u64 sum;
+    ce_u32 i;
+
+    (void)user;
+    sum = 0u;
+    for (i = 0u; i < BENCH_NUMBERS; i++) {
+        sum += ce_u64_to_str((ce_u64)i * 0x9E3779B97F4Aull, buf, sizeof(buf));
+    }
+    perf_sink += sum;
+}
+
+static void bench_f64_to_str(void* user)
+{
+    ce_char buf[32];
+    ce_u64 sum;
+    ce_u32 i;
+
+    (void)user;
+    sum = 0u;
+    for (i = 0u; i < BENCH_NUMBERS; i++) {
+        sum += ce_f64_to_str((ce_f64)i * 1.618033988749, buf, sizeof(buf));
+    }
+    perf_sink += sum;
+}
+
+static void bench_str_to_f64(void* user)
+{
+    bench_string* b;
+    ce_f64 value;
+    ce_f64 sum;
+    ce_size pos;
+    ce_size used;
+
+    b   = (bench_string*)user;
+    sum = 0.0;
+    pos = 0u;
+    while (pos < b->text_len) {
+        used = 0u;
+        if (ce_str_to_f64(&b->text[pos], b->text_len - pos, &value, &used) == CE_OK) {
+            sum += value;
+        }
+        pos += used + 1u;
+    }
+    perf_sink += (ce_u64)sum;
+}
+
+void perf_suite_string(perf_ctx* ctx)
+{
+    static bench_string b;
+    ce_size len;
+    ce_u32 i;
+
+    /* Non-zero bytes so strlen walks the whole buffer. */
+    for (i = 0u; i < BENCH_BYTES; i++) {
+        b.src[i] = (ce_u8)(1u + (i % 251u));
+        b.dst[i] = b.src[i];
+    }
+    b.src[BENCH_BYTES - 1u] = 0u;
+    b.dst[BENCH_BYTES - 1u] = 0u;
+
+    b.text_len = 0u;
+    for (i = 0u; i < BENCH_NUMBERS; i++) {
+        len                      = ce_f64_to_str((ce_f64)i * 1.618033988749, &b.text[b.text_len], 23u);
+        b.text[b.text_len + len] = ' ';
+        b.text_len              += len + 1u;
+    }
+
+    perf_run(ctx, "string", "memcmp_1m", BENCH_BYTES, bench_memcmp, &b);
+    perf_run(ctx, "string", "strlen_1m", BENCH_BYTES, bench_strlen, &b);
+    perf_run(ctx, "string", "memcpy_1m", BENCH_BYTES, bench_memcpy, &b);
+    perf_run(ctx, "string", "memset_1m", BENCH_BYTES, bench_memset, &b);
+    perf_run(ctx, "string", "memmove_1m", BENCH_BYTES, bench_memmove, &b);
+    perf_run(ctx, "string", "u64_to_str_4k", BENCH_NUMBERS, bench_u64_to_str, &b);
+    perf_run(ctx, "string", "f64_to_str_4k", BENCH_NUMBERS, bench_f64_to_str, &b);
+    perf_run(ctx, "string", "str_to_f64_4k", BENCH_NUMBERS, bench_str_to_f64, &b);
+}
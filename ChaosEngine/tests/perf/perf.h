@@ -0,0 +1,77 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file perf.h
+ * @brief Benchmark harness shared by the perf suites.
+ *
+ * A case is a function doing a fixed amount of work per call. The harness
+ * calls it a few times to warm caches and branch predictors, then times
+ * repeated calls with the engine clock and keeps the median (what the
+ * regression check compares), the 99th percentile and the minimum.
+ */
+#ifndef PERF_H
+#define PERF_H
+
+#include "core/chaos_types.h"
+
+#define PERF_NAME_MAX    64
+#define PERF_MAX_SAMPLES 4096
+#define PERF_MAX_RESULTS 256
+
+typedef void (*perf_fn)(void* user);
+
+typedef struct perf_result_s {
+    char   name[PERF_NAME_MAX]; /* "suite/case". */
+    ce_u64 items;               /* Work units per call, for the throughput column. */
+    ce_u32 reps;
+    ce_u64 median_ns;
+    ce_u64 p99_ns;
+    ce_u64 min_ns;
+} perf_result;
+
+typedef struct perf_ctx_s {
+    const char* filter;      /* Substring of "suite/case"; NULL runs everything. */
+    ce_u32      warmup;
+    ce_u32      min_reps;
+    ce_u64      min_time_ns; /* Keep repeating until both this and min_reps are reached. */
+    perf_result results[PERF_MAX_RESULTS];
+    ce_u32      count;
+} perf_ctx;
+
+/* Results fold into this so the compiler cannot drop the measured work. */
+extern volatile ce_u64 perf_sink;
+
+/**
+ * Times `fn` and appends a result; does nothing when filtered out.
+ */
+void perf_run(perf_ctx* ctx, const char* suite, const char* name, ce_u64 items, perf_fn fn, void* user);
+
+/**
+ * Writes every result as {"benchmarks": [...]}; returns 0 on success.
+ */
+int perf_write_json(const perf_ctx* ctx, const char* path);
+
+/**
+ * Compares medians with a baseline written by perf_write_json and prints a
+ * verdict per case. Returns the number of cases slower than
+ * baseline * (1 + tolerance), or -1 when the baseline cannot be read.
+ */
+int perf_compare(const perf_ctx* ctx, const char* baseline_path, double tolerance);
+
+/* Suites (one file each). */
+void perf_suite_containers(perf_ctx* ctx);
+void perf_suite_memory(perf_ctx* ctx);
+void perf_suite_string(perf_ctx* ctx);
+void perf_suite_sim(perf_ctx* ctx);
+void perf_suite_raster(perf_ctx* ctx);
+void perf_suite_mixer(perf_ctx* ctx);
+void perf_suite_image(perf_ctx* ctx);
+
+#endif /* PERF_H */
@@ -0,0 +1,194 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file perf_harness.c
+ * @brief Timing, statistics, JSON output and baseline comparison.
+ */
+#include "perf.h"
+#include "core/chaos_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+volatile ce_u64 perf_sink;
+
+static ce_u64 perf_samples[PERF_MAX_SAMPLES];
+
+/* ************************************************************************** */
+/* TIMING                                                                     */
+/* ************************************************************************** */
+
+static int perf_cmp_u64(const void* a, const void* b)
+{
+    ce_u64 x;
+    ce_u64 y;
+
+    x = *(const ce_u64*)a;
+    y = *(const ce_u64*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void perf_print_ns(char* out, size_t cap, ce_u64 ns)
+{
+    if (ns >= 10000000ull) {
+        snprintf(out, cap, "%.2f ms", (double)ns / 1e6);
+    } else if (ns >= 10000ull) {
+        snprintf(out, cap, "%.2f us", (double)ns / 1e3);
+    } else {
+        snprintf(out, cap, "%llu ns", ns);
+    }
+}
+
+void perf_run(perf_ctx* ctx, const char* suite, const char* name, ce_u64 items, perf_fn fn, void* user)
+{
+    perf_result* r;
+    char full[PERF_NAME_MAX];
+    char median[32];
+    char p99[32];
+    ce_u64 start;
+    ce_u64 begin;
+    ce_u32 n;
+    ce_u32 i;
+
+    snprintf(full, sizeof(full), "%s/%s", suite, name);
+    if (((ctx->filter == NULL) || (strstr(full, ctx->filter) != NULL)) && (ctx->count < PERF_MAX_RESULTS)) {
+        for (i = 0u; i < ctx->warmup; i++) {
+            fn(user);
+        }
+
+        n     = 0u;
+        begin = ce_time_now_ns();
+        while ((n < PERF_MAX_SAMPLES) && ((n < ctx->min_reps) || ((ce_time_now_ns() - begin) < ctx->min_time_ns))) {
+            start           = ce_time_now_ns();
+            fn(user);
+            perf_samples[n] = ce_time_now_ns() - start;
+            n++;
+        }
+        qsort(perf_samples, n, sizeof(perf_samples[0]), perf_cmp_u64);
+
+        r = &ctx->results[ctx->count];
+        ctx->count++;
+        memcpy(r->name, full, sizeof(full));
+        r->items     = items;
+        r->reps      = n;
+        r->median_ns = perf_samples[n / 2u];
+        r->p99_ns    = perf_samples[((n * 99u) + 99u) / 100u - 1u];
+        r->min_ns    = perf_samples[0];
+
+        perf_print_ns(median, sizeof(median), r->median_ns);
+        perf_print_ns(p99, sizeof(p99), r->p99_ns);
+        printf("%-40s %12s %12s %10.1f M/s  (%u reps)\n", r->name, median, p99,
+               (r->median_ns != 0u) ? ((double)items * 1e3) / (double)r->median_ns : 0.0, n);
+        fflush(stdout);
+    }
+}
+
+/* ************************************************************************** */
+/* JSON                                                                       */
+/* ************************************************************************** */
+
+int perf_write_json(const perf_ctx* ctx, const char* path)
+{
+    FILE* f;
+    const perf_result* r;
+    ce_u32 i;
+    int ok;
+
+    f  = fopen(path, "w");
+    ok = (f != NULL) ? 0 : -1;
+    if (f != NULL) {
+        fprintf(f, "{\n  \"benchmarks\": [\n");
+        for (i = 0u; i < ctx->count; i++) {
+            r = &ctx->results[i];
+            fprintf(f,
+                    "    {\"name\": \"%s\", \"items\": %llu, \"reps\": %u, \"median_ns\": %llu, \"p99_ns\": %llu, "
+                    "\"min_ns\": %llu}%s\n",
+                    r->name, r->items, r->reps, r->median_ns, r->p99_ns, r->min_ns,
+                    (i + 1u < ctx->count) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+        ok = (fclose(f) == 0) ? 0 : -1;
+    }
+
+    return ok;
+}
+
+/* Reads back only what perf_write_json writes: one object per line. */
+static int perf_baseline_median(const char* json, const char* name, ce_u64* out_median)
+{
+    char key[PERF_NAME_MAX + 16];
+    const char* at;
+    const char* median;
+    const char* eol;
+    int found;
+
+    snprintf(key, sizeof(key), "\"name\": \"%s\"", name);
+    found = 0;
+    at    = strstr(json, key);
+    if (at != NULL) {
+        eol    = strchr(at, '\n');
+        median = strstr(at, "\"median_ns\": ");
+        if ((median != NULL) && ((eol == NULL) || (median < eol))) {
+            *out_median = strtoull(median + strlen("\"median_ns\": "), NULL, 10);
+            found       = 1;
+        }
+    }
+
+    return found;
+}
+
+int perf_compare(const perf_ctx* ctx, const char* baseline_path, double tolerance)
+{
+    FILE* f;
+    char* json;
+    const perf_result* r;
+    ce_u64 base;
+    long size;
+    double ratio;
+    ce_u32 i;
+    int regressions;
+
+    json        = NULL;
+    regressions = -1;
+    f           = fopen(baseline_path, "rb");
+    if ((f != NULL) && (fseek(f, 0, SEEK_END) == 0) && ((size = ftell(f)) >= 0) && (fseek(f, 0, SEEK_SET) == 0)) {
+        json = (char*)malloc((size_t)size + 1u);
+        if ((json != NULL) && (fread(json, 1u, (size_t)size, f) == (size_t)size)) {
+            json[size]  = '\0';
+            regressions = 0;
+        }
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+
+    if (regressions == 0) {
+        printf("\nbaseline %s (tolerance %.0f%%)\n", baseline_path, tolerance * 100.0);
+        for (i = 0u; i < ctx->count; i++) {
+            r = &ctx->results[i];
+            if (perf_baseline_median(json, r->name, &base) == 0) {
+                printf("  %-40s new\n", r->name);
+            } else {
+                ratio = (base != 0u) ? (double)r->median_ns / (double)base : 1.0;
+                if (ratio > (1.0 + tolerance)) {
+                    regressions++;
+                }
+                printf("  %-40s %+7.1f%%  %s\n", r->name, (ratio - 1.0) * 100.0,
+                       (ratio > (1.0 + tolerance)) ? "REGRESSION"
+                                                   : ((ratio < (1.0 - tolerance)) ? "faster" : "ok"));
+            }
+        }
+    }
+    free(json);
+
+    return regressions;
+}
@@ -0,0 +1,119 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file perf_main.c
+ * @brief Runs the perf suites.
+ *
+ * Usage: perf_runner [--filter text] [--json out.json] [--baseline in.json]
+ *                    [--tolerance 0.15] [--warmup n] [--reps n] [--min-ms n]
+ *
+ * Exits with 1 when a case's median is slower than the baseline by more
+ * than the tolerance, so `make perf` can gate a build.
+ */
+#include "perf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct perf_options_s {
+    const char* json_path;
+    const char* baseline_path;
+    double      tolerance;
+} perf_options;
+
+static void perf_usage(void)
+{
+    fprintf(stderr, "usage: perf_runner [--filter text] [--json out.json] [--baseline in.json]\n"
+                    "                   [--tolerance 0.15] [--warmup n] [--reps n] [--min-ms n]\n");
+}
+
+static int perf_parse(int argc, char** argv, perf_ctx* ctx, perf_options* opt)
+{
+    int ok;
+    int i;
+
+    ok                 = 1;
+    ctx->filter        = NULL;
+    ctx->warmup        = 3u;
+    ctx->min_reps      = 31u;
+    ctx->min_time_ns   = 200000000ull;
+    ctx->count         = 0u;
+    opt->json_path     = NULL;
+    opt->baseline_path = NULL;
+    opt->tolerance     = 0.15;
+
+    for (i = 1; (ok != 0) && (i < argc); i++) {
+        if (i + 1 >= argc) {
+            ok = 0;
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            ctx->filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0) {
+            opt->json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0) {
+            opt->baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0) {
+            opt->tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            ctx->warmup = (ce_u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reps") == 0) {
+            ctx->min_reps = (ce_u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-ms") == 0) {
+            ctx->min_time_ns = (ce_u64)atoi(argv[++i]) * 1000000ull;
+        } else {
+            ok = 0;
+        }
+    }
+    ctx->min_reps = (ctx->min_reps == 0u) ? 1u : ctx->min_reps;
+
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    static perf_ctx ctx;
+    perf_options opt;
+    int regressions;
+    int status;
+
+    status = 0;
+    if (perf_parse(argc, argv, &ctx, &opt) == 0) {
+        perf_usage();
+        status = 2;
+    } else {
+        printf("%-40s %12s %12s %14s\n", "case", "median", "p99", "throughput");
+        perf_suite_containers(&ctx);
+        perf_suite_memory(&ctx);
+        perf_suite_string(&ctx);
+        perf_suite_sim(&ctx);
+        perf_suite_raster(&ctx);
+        perf_suite_mixer(&ctx);
+        perf_suite_image(&ctx);
+
+        if ((opt.json_path != NULL) && (perf_write_json(&ctx, opt.json_path) != 0)) {
+            fprintf(stderr, "cannot write %s\n", opt.json_path);
+            status = 2;
+        }
+        if (opt.baseline_path != NULL) {
+            regressions = perf_compare(&ctx, opt.baseline_path, opt.tolerance);
+            if (regressions < 0) {
+                fprintf(stderr, "cannot read baseline %s\n", opt.baseline_path);
+                status = 2;
+            } else if (regressions > 0) {
+                printf("%d regression(s)\n", regressions);
+                status = (status != 0) ? status : 1;
+            } else {
+                /* Within tolerance. */
+            }
+        }
+    }
+
+    return status;
+}
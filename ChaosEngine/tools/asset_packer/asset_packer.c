@@ -0,0 +1,389 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file asset_packer.c
+ * @brief Packs a directory tree into a .cpak archive.
+ *
+ * Usage: asset_packer <root dir> <out.cpak> [--lz4] [--align bytes]
+ *
+ * Entries are named by their '/'-separated path relative to the root. With
+ * --lz4, an entry is stored compressed only when that saves at least 1/8 of
+ * its size; everything else stays in place-usable raw form.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "core/chaos_fs.h"
+#include "core/chaos_compress.h"
+#include "core/chaos_containers.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* ************************************************************************** */
+/* OPTIONS                                                                    */
+/* ************************************************************************** */
+
+typedef struct packer_options_s {
+    const char* root;
+    const char* out_path;
+    int         lz4;
+    long        align;
+} packer_options;
+
+typedef struct packer_file_s {
+    char*          name;   /* Relative to the root. */
+    unsigned char* data;   /* Stored bytes (compressed or raw). */
+    ce_pak_entry   entry;
+} packer_file;
+
+typedef struct packer_list_s {
+    packer_file* files;
+    size_t       count;
+    size_t       capacity;
+} packer_list;
+
+static void packer_usage(void)
+{
+    fprintf(stderr, "usage: asset_packer <root dir> <out.cpak> [--lz4] [--align bytes]\n");
+}
+
+static int packer_parse(int argc, char** argv, packer_options* opt)
+{
+    int ok;
+    int i;
+
+    ok         = 1;
+    opt->lz4   = 0;
+    opt->align = 4096;
+
+    if (argc < 3) {
+        ok = 0;
+    } else {
+        opt->root     = argv[1];
+        opt->out_path = argv[2];
+        for (i = 3; (ok != 0) && (i < argc); i++) {
+            if (strcmp(argv[i], "--lz4") == 0) {
+                opt->lz4 = 1;
+            } else if ((strcmp(argv[i], "--align") == 0) && (i + 1 < argc)) {
+                opt->align = atol(argv[i + 1]);
+                i++;
+            } else {
+                ok = 0;
+            }
+        }
+        /* At least 8 keeps every TOC field naturally aligned in the mapping. */
+        if ((opt->align < 8) || ((opt->align & (opt->align - 1)) != 0) || (opt->align > (1L << 24))) {
+            ok = 0;
+        }
+    }
+
+    return ok;
+}
+
+static unsigned char* packer_read_file(const char* path, long* out_size)
+{
+    unsigned char* data;
+    FILE* f;
+    long size;
+
+    data      = NULL;
+    *out_size = -1;
+    f         = fopen(path, "rb");
+    if (f != NULL) {
+        if ((fseek(f, 0, SEEK_END) == 0) && ((size = ftell(f)) >= 0) && (fseek(f, 0, SEEK_SET) == 0)) {
+            data = (unsigned char*)malloc((size_t)size + 1u);
+            if ((data != NULL) && (fread(data, 1, (size_t)size, f) != (size_t)size)) {
+                free(data);
+                data = NULL;
+            }
+            *out_size = size;
+        }
+        fclose(f);
+    }
+
+    return data;
+}
+
+/* ************************************************************************** */
+/* COLLECTION                                                                 */
+/* ************************************************************************** */
+
+static int packer_add(packer_list* list, const char* name, unsigned char* data, long size, int lz4)
+{
+    packer_file* f;
+    packer_file* grown;
+    unsigned char* packed;
+    size_t cap;
+    ce_size n;
+
+    if (list->count == list->capacity) {
+        cap   = (list->capacity != 0u) ? (list->capacity * 2u) : 64u;
+        grown = (packer_file*)realloc(list->files, cap * sizeof(packer_file));
+        if (grown == NULL) {
+            return 0;
+        }
+        list->files    = grown;
+        list->capacity = cap;
+    }
+
+    f = &list->files[list->count];
+    memset(f, 0, sizeof(*f));
+    f->name = (char*)malloc(strlen(name) + 1u);
+    if (f->name == NULL) {
+        return 0;
+    }
+    strcpy(f->name, name);
+    f->data           = data;
+    f->entry.hash     = ce_hash_str(name);
+    f->entry.size     = (ce_u64)size;
+    f->entry.raw_size = (ce_u64)size;
+
+    if ((lz4 != 0) && (size >= 64)) {
+        cap    = (size_t)ce_lz4_compress_bound((ce_size)size);
+        packed = (unsigned char*)malloc(cap);
+        if (packed != NULL) {
+            n = ce_lz4_compress(data, (ce_size)size, packed, (ce_size)(size - (size / 8)));
+            if (n != 0u) {
+                free(data);
+                f->data        = packed;
+                f->entry.size  = (ce_u64)n;
+                f->entry.flags = CE_PAK_FLAG_LZ4;
+            } else {
+                free(packed);
+            }
+        }
+    }
+    list->count++;
+
+    return 1;
+}
+
+static int packer_walk(packer_list* list, const char* root, const char* rel, int lz4)
+{
+    DIR* dir;
+    struct dirent* de;
+    struct stat st;
+    unsigned char* data;
+    char path[4096];
+    char name[4096];
+    long size;
+    int ok;
+
+    ok = 1;
+    dir = NULL;
+    if (snprintf(path, sizeof(path), "%s%s%s", root, (rel[0] != '\0') ? "/" : "", rel) < (int)sizeof(path)) {
+        dir = opendir(path);
+    }
+    if (dir == NULL) {
+        fprintf(stderr, "asset_packer: cannot open directory '%s'\n", path);
+        return 0;
+    }
+
+    while ((ok != 0) && ((de = readdir(dir)) != NULL)) {
+        if (de->d_name[0] == '.') {
+            continue; /* ".", ".." and hidden files. */
+        }
+        if ((snprintf(name, sizeof(name), "%s%s%s", rel, (rel[0] != '\0') ? "/" : "", de->d_name) >=
+             (int)sizeof(name)) ||
+            (snprintf(path, sizeof(path), "%s/%s", root, name) >= (int)sizeof(path))) {
+            fprintf(stderr, "asset_packer: path too long under '%s'\n", root);
+            ok = 0;
+        } else if (stat(path, &st) != 0) {
+            fprintf(stderr, "asset_packer: cannot stat '%s'\n", path);
+            ok = 0;
+        } else if (S_ISDIR(st.st_mode)) {
+            ok = packer_walk(list, root, name, lz4);
+        } else if (S_ISREG(st.st_mode)) {
+            data = packer_read_file(path, &size);
+            if (data == NULL) {
+                fprintf(stderr, "asset_packer: cannot read '%s'\n", path);
+                ok = 0;
+            } else {
+                ok = packer_add(list, name, data, size, lz4);
+            }
+        } else {
+            /* Sockets, fifos...: skipped. */
+        }
+    }
+    closedir(dir);
+
+    return ok;
+}
+
+static int packer_cmp_hash(const void* a, const void* b)
+{
+    const packer_file* fa;
+    const packer_file* fb;
+    int r;
+
+    fa = (const packer_file*)a;
+    fb = (const packer_file*)b;
+    if (fa->entry.hash != fb->entry.hash) {
+        r = (fa->entry.hash < fb->entry.hash) ? -1 : 1;
+    } else {
+        r = strcmp(fa->name, fb->name);
+    }
+
+    return r;
+}
+
+/* ************************************************************************** */
+/* OUTPUT                                                                     */
+/* ************************************************************************** */
+
+static ce_u64 packer_align(ce_u64 v, ce_u64 a)
+{
+    return (v + a - 1u) & ~(a - 1u);
+}
+
+static int packer_pad(FILE* out, ce_u64 from, ce_u64 to)
+{
+    static const unsigned char zeros[256];
+    ce_u64 n;
+    int ok;
+
+    ok = 1;
+    while ((ok != 0) && (from < to)) {
+        n    = ((to - from) < sizeof(zeros)) ? (to - from) : sizeof(zeros);
+        ok   = (fwrite(zeros, 1, (size_t)n, out) == (size_t)n) ? 1 : 0;
+        from += n;
+    }
+
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    packer_options opt;
+    packer_list list;
+    ce_pak_header hdr;
+    ce_u32* buckets;
+    FILE* out;
+    ce_u64 names_size;
+    ce_u64 pos;
+    ce_u64 raw_total;
+    ce_u64 stored_total;
+    size_t bucket_count;
+    size_t i;
+    size_t b;
+    size_t e;
+    int status;
+    int ok;
+
+    status  = 1;
+    buckets = NULL;
+    out     = NULL;
+    memset(&list, 0, sizeof(list));
+
+    if (packer_parse(argc, argv, &opt) == 0) {
+        packer_usage();
+        return 1;
+    }
+    if (packer_walk(&list, opt.root, "", opt.lz4) == 0) {
+        goto cleanup;
+    }
+    qsort(list.files, list.count, sizeof(packer_file), packer_cmp_hash);
+
+    /* About one entry per bucket. */
+    memset(&hdr, 0, sizeof(hdr));
+    while (((size_t)1 << hdr.bucket_bits) < list.count) {
+        hdr.bucket_bits++;
+    }
+    bucket_count = ((size_t)1 << hdr.bucket_bits) + 1u;
+    buckets      = (ce_u32*)calloc(bucket_count, sizeof(ce_u32));
+    if (buckets == NULL) {
+        fprintf(stderr, "asset_packer: out of memory\n");
+        goto cleanup;
+    }
+    e = 0u;
+    for (b = 0u; b + 1u < bucket_count; b++) {
+        buckets[b] = (ce_u32)e;
+        while ((e < list.count) &&
+               (((hdr.bucket_bits != 0u) ? (size_t)(list.files[e].entry.hash >> (64u - hdr.bucket_bits)) : 0u) == b)) {
+            e++;
+        }
+    }
+    buckets[bucket_count - 1u] = (ce_u32)list.count;
+
+    names_size = 0u;
+    for (i = 0u; i < list.count; i++) {
+        list.files[i].entry.name_offset = (ce_u32)names_size;
+        names_size += (ce_u64)strlen(list.files[i].name) + 1u;
+    }
+    if (names_size == 0u) {
+        names_size = 1u; /* A lone terminator keeps the block non-empty. */
+    }
+
+    hdr.magic          = CE_PAK_MAGIC;
+    hdr.version        = CE_PAK_VERSION;
+    hdr.entry_count    = (ce_u32)list.count;
+    hdr.alignment      = (ce_u32)opt.align;
+    hdr.toc_offset     = sizeof(ce_pak_header);
+    hdr.buckets_offset = hdr.toc_offset + ((ce_u64)list.count * sizeof(ce_pak_entry));
+    hdr.names_offset   = hdr.buckets_offset + ((ce_u64)bucket_count * sizeof(ce_u32));
+    hdr.names_size     = names_size;
+    hdr.data_offset    = packer_align(hdr.names_offset + names_size, (ce_u64)opt.align);
+
+    raw_total    = 0u;
+    stored_total = 0u;
+    pos          = hdr.data_offset;
+    for (i = 0u; i < list.count; i++) {
+        list.files[i].entry.offset = pos;
+        pos = packer_align(pos + list.files[i].entry.size, (ce_u64)opt.align);
+        raw_total    += list.files[i].entry.raw_size;
+        stored_total += list.files[i].entry.size;
+    }
+
+    out = fopen(opt.out_path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "asset_packer: cannot write '%s'\n", opt.out_path);
+        goto cleanup;
+    }
+    ok = (fwrite(&hdr, sizeof(hdr), 1, out) == 1u) ? 1 : 0;
+    for (i = 0u; (ok != 0) && (i < list.count); i++) {
+        ok = (fwrite(&list.files[i].entry, sizeof(ce_pak_entry), 1, out) == 1u) ? 1 : 0;
+    }
+    ok = ((ok != 0) && (fwrite(buckets, sizeof(ce_u32), bucket_count, out) == bucket_count)) ? 1 : 0;
+    for (i = 0u; (ok != 0) && (i < list.count); i++) {
+        ok = (fwrite(list.files[i].name, 1, strlen(list.files[i].name) + 1u, out) > 0u) ? 1 : 0;
+    }
+    if ((ok != 0) && (list.count == 0u)) {
+        ok = (fputc(0, out) != EOF) ? 1 : 0;
+    }
+    pos = hdr.names_offset + names_size;
+    for (i = 0u; (ok != 0) && (i < list.count); i++) {
+        ok  = packer_pad(out, pos, list.files[i].entry.offset);
+        ok  = ((ok != 0) && (fwrite(list.files[i].data, 1, (size_t)list.files[i].entry.size, out) ==
+                             (size_t)list.files[i].entry.size)) ? 1 : 0;
+        pos = list.files[i].entry.offset + list.files[i].entry.size;
+    }
+
+    if ((fclose(out) == 0) && (ok != 0)) {
+        printf("asset_packer: %u entries, %llu -> %llu bytes of data, %u buckets -> %s\n",
+               hdr.entry_count, (unsigned long long)raw_total, (unsigned long long)stored_total,
+               (unsigned)(bucket_count - 1u), opt.out_path);
+        status = 0;
+    } else {
+        fprintf(stderr, "asset_packer: write to '%s' failed\n", opt.out_path);
+    }
+
+cleanup:
+    for (i = 0u; i < list.count; i++) {
+        free(list.files[i].name);
+        free(list.files[i].data);
+    }
+    free(list.files);
+    free(buckets);
+
+    return status;
+}
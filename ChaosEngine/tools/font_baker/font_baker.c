@@ -0,0 +1,347 @@
+/**
+ * 
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░ ░▒▓██████▓▒░ ░▒▓███████▓▒  ▒▓████████▓▒░▒▓███████▓▒░ ░▒▓██████▓▒░░▒▓█▓▒░▒▓███████▓▒░░▒▓████████▓▒░ 
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░      ░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░      ░▒▓████████▓▒░▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░  ▒▓██████▓▒░ ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒▒▓███▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓██████▓▒░   
+ * ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒  ▒▓█▓▒░      ░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░        
+ * ░▒▓██████▓▒░░▒▓█▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓███████▓▒░  ▒▓████████▓▒░▒▓█▓▒░░▒▓█▓▒░░▒▓██████▓▒░░▒▓█▓▒░▒▓█▓▒░░▒▓█▓▒░▒▓████████▓▒░ 
+ * 
+ * @file font_baker.c
+ * @brief Bakes a TrueType font into a .cfnt SDF atlas with kerning pairs.
+ *
+ * Usage:
+ *   font_baker <font.ttf> <out.cfnt> [--size px] [--spread px] [--atlas px]
+ *              [--first codepoint] [--last codepoint]
+ *
+ * Glyphs are rasterized once as signed distance fields (stb_truetype), so the
+ * runtime can draw any size from a single R8 atlas texture.
+ */
+#include "gfx/chaos_draw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+/* ************************************************************************** */
+/* OPTIONS                                                                    */
+/* ************************************************************************** */
+
+typedef struct baker_options_s {
+    const char* in_path;
+    const char* out_path;
+    float       size;
+    float       spread;
+    int         atlas;
+    int         first;
+    int         last;
+} baker_options;
+
+typedef struct baker_glyph_s {
+    ce_font_glyph  rec;
+    unsigned char* sdf;
+} baker_glyph;
+
+static void baker_usage(void)
+{
+    fprintf(stderr,
+            "usage: font_baker <font.ttf> <out.cfnt> [--size px] [--spread px]\n"
+            "                  [--atlas px] [--first cp] [--last cp]\n");
+}
+
+static int baker_parse(int argc, char** argv, baker_options* opt)
+{
+    int ok;
+    int i;
+
+    ok          = 1;
+    opt->size   = 48.0f;
+    opt->spread = 6.0f;
+    opt->atlas  = 512;
+    opt->first  = 32;
+    opt->last   = 126;
+
+    if (argc < 3) {
+        ok = 0;
+    } else {
+        opt->in_path  = argv[1];
+        opt->out_path = argv[2];
+        for (i = 3; (ok != 0) && (i < argc); i += 2) {
+            if (i + 1 >= argc) {
+                ok = 0;
+            } else if (strcmp(argv[i], "--size") == 0) {
+                opt->size = (float)atof(argv[i + 1]);
+            } else if (strcmp(argv[i], "--spread") == 0) {
+                opt->spread = (float)atof(argv[i + 1]);
+            } else if (strcmp(argv[i], "--atlas") == 0) {
+                opt->atlas = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--first") == 0) {
+                opt->first = atoi(argv[i + 1]);
+            } else if (strcmp(argv[i], "--last") == 0) {
+                opt->last = atoi(argv[i + 1]);
+            } else {
+                ok = 0;
+            }
+        }
+        if ((opt->size <= 0.0f) || (opt->spread <= 0.0f) || (opt->atlas <= 0) ||
+            (opt->atlas > 65535) || (opt->first > opt->last)) {
+            ok = 0;
+        }
+    }
+
+    return ok;
+}
+
+static unsigned char* baker_read_file(const char* path, long* out_size)
+{
+    unsigned char* data;
+    FILE* f;
+    long size;
+
+    data = NULL;
+    f    = fopen(path, "rb");
+    if (f != NULL) {
+        if ((fseek(f, 0, SEEK_END) == 0) && ((size = ftell(f)) > 0) && (fseek(f, 0, SEEK_SET) == 0)) {
+            data = (unsigned char*)malloc((size_t)size);
+            if ((data != NULL) && (fread(data, 1, (size_t)size, f) != (size_t)size)) {
+                free(data);
+                data = NULL;
+            }
+            *out_size = size;
+        }
+        fclose(f);
+    }
+
+    return data;
+}
+
+/* ************************************************************************** */
+/* ATLAS PACKING                                                              */
+/* ************************************************************************** */
+
+static int baker_cmp_height(const void* a, const void* b)
+{
+    const baker_glyph* ga;
+    const baker_glyph* gb;
+
+    ga = *(const baker_glyph* const*)a;
+    gb = *(const baker_glyph* const*)b;
+
+    return (int)gb->rec.h - (int)ga->rec.h;
+}
+
+/**
+ * @brief Shelf packer: tallest glyphs first, 1px gutter between cells.
+ * @return 1 when every glyph fits.
+ */
+static int baker_pack(baker_glyph* glyphs, int count, int atlas, unsigned char* pixels)
+{
+    baker_glyph** order;
+    int ok;
+    int i;
+    int row;
+    int x;
+    int y;
+    int shelf_h;
+    int w;
+    int h;
+
+    ok    = 1;
+    order = (baker_glyph**)malloc(sizeof(baker_glyph*) * (size_t)(count > 0 ? count : 1));
+    if (order == NULL) {
+        ok = 0;
+    } else {
+        for (i = 0; i < count; i++) {
+            order[i] = &glyphs[i];
+        }
+        qsort(order, (size_t)count, sizeof(baker_glyph*), baker_cmp_height);
+
+        x       = 1;
+        y       = 1;
+        shelf_h = 0;
+        for (i = 0; (ok != 0) && (i < count); i++) {
+            w = (int)order[i]->rec.w;
+            h = (int)order[i]->rec.h;
+            if ((w == 0) || (h == 0)) {
+                continue;
+            }
+            if (x + w + 1 > atlas) {
+                x        = 1;
+                y       += shelf_h + 1;
+                shelf_h  = 0;
+            }
+            if ((x + w + 1 > atlas) || (y + h + 1 > atlas)) {
+                ok = 0;
+            } else {
+                order[i]->rec.x = (ce_u16)x;
+                order[i]->rec.y = (ce_u16)y;
+                for (row = 0; row < h; row++) {
+                    memcpy(&pixels[(size_t)(y + row) * (size_t)atlas + (size_t)x],
+                           &order[i]->sdf[(size_t)row * (size_t)w], (size_t)w);
+                }
+                x += w + 1;
+                if (h > shelf_h) {
+                    shelf_h = h;
+                }
+            }
+        }
+        free(order);
+    }
+
+    return ok;
+}
+
+/* ************************************************************************** */
+/* MAIN                                                                       */
+/* ************************************************************************** */
+
+int main(int argc, char** argv)
+{
+    baker_options opt;
+    stbtt_fontinfo info;
+    ce_font_file_header hdr;
+    baker_glyph* glyphs;
+    ce_font_kern* kerns;
+    unsigned char* ttf;
+    unsigned char* pixels;
+    FILE* out;
+    long ttf_size;
+    float scale;
+    int ascent;
+    int descent;
+    int line_gap;
+    int advance;
+    int lsb;
+    int w;
+    int h;
+    int xoff;
+    int yoff;
+    int count;
+    int kern_count;
+    int cp;
+    int a;
+    int b;
+    int kern;
+    int status;
+
+    status     = 1;
+    ttf        = NULL;
+    glyphs     = NULL;
+    kerns      = NULL;
+    pixels     = NULL;
+    count      = 0;
+    kern_count = 0;
+
+    if (baker_parse(argc, argv, &opt) == 0) {
+        baker_usage();
+        status = 2;
+        goto cleanup;
+    }
+
+    ttf = baker_read_file(opt.in_path, &ttf_size);
+    if ((ttf == NULL) || (stbtt_InitFont(&info, ttf, stbtt_GetFontOffsetForIndex(ttf, 0)) == 0)) {
+        fprintf(stderr, "font_baker: cannot load '%s'\n", opt.in_path);
+        goto cleanup;
+    }
+
+    scale = stbtt_ScaleForPixelHeight(&info, opt.size);
+    stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+
+    glyphs = (baker_glyph*)calloc((size_t)(opt.last - opt.first + 1), sizeof(baker_glyph));
+    pixels = (unsigned char*)calloc((size_t)opt.atlas * (size_t)opt.atlas, 1);
+    if ((glyphs == NULL) || (pixels == NULL)) {
+        fprintf(stderr, "font_baker: out of memory\n");
+        goto cleanup;
+    }
+
+    /* Rasterize every available glyph as an SDF (128 = on the outline). */
+    for (cp = opt.first; cp <= opt.last; cp++) {
+        if ((stbtt_FindGlyphIndex(&info, cp) == 0) && (cp != ' ')) {
+            continue;
+        }
+        stbtt_GetCodepointHMetrics(&info, cp, &advance, &lsb);
+        w    = 0;
+        h    = 0;
+        xoff = 0;
+        yoff = 0;
+        glyphs[count].sdf = stbtt_GetCodepointSDF(&info, scale, cp, (int)(opt.spread + 0.5f), 128,
+                                                  128.0f / opt.spread, &w, &h, &xoff, &yoff);
+        glyphs[count].rec.codepoint = (ce_u32)cp;
+        glyphs[count].rec.w         = (ce_u16)((glyphs[count].sdf != NULL) ? w : 0);
+        glyphs[count].rec.h         = (ce_u16)((glyphs[count].sdf != NULL) ? h : 0);
+        glyphs[count].rec.xoff      = (float)xoff;
+        glyphs[count].rec.yoff      = (float)yoff;
+        glyphs[count].rec.advance   = (float)advance * scale;
+        count++;
+    }
+
+    if (baker_pack(glyphs, count, opt.atlas, pixels) == 0) {
+        fprintf(stderr, "font_baker: glyphs do not fit in a %dx%d atlas (try --atlas)\n", opt.atlas, opt.atlas);
+        goto cleanup;
+    }
+
+    /* Kerning pairs, emitted in (left, right) order for binary search. */
+    kerns = (ce_font_kern*)malloc(sizeof(ce_font_kern) * (size_t)(count > 0 ? count * count : 1));
+    if (kerns == NULL) {
+        fprintf(stderr, "font_baker: out of memory\n");
+        goto cleanup;
+    }
+    for (a = 0; a < count; a++) {
+        for (b = 0; b < count; b++) {
+            kern = stbtt_GetCodepointKernAdvance(&info, (int)glyphs[a].rec.codepoint, (int)glyphs[b].rec.codepoint);
+            if (kern != 0) {
+                kerns[kern_count].left   = glyphs[a].rec.codepoint;
+                kerns[kern_count].right  = glyphs[b].rec.codepoint;
+                kerns[kern_count].adjust = (float)kern * scale;
+                kern_count++;
+            }
+        }
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic        = CE_FONT_MAGIC;
+    hdr.version      = CE_FONT_VERSION;
+    hdr.glyph_count  = (ce_u32)count;
+    hdr.kern_count   = (ce_u32)kern_count;
+    hdr.atlas_width  = (ce_u16)opt.atlas;
+    hdr.atlas_height = (ce_u16)opt.atlas;
+    hdr.bake_size    = opt.size;
+    hdr.sdf_spread   = opt.spread;
+    hdr.ascent       = (float)ascent * scale;
+    hdr.descent      = (float)descent * scale;
+    hdr.line_gap     = (float)line_gap * scale;
+
+    out = fopen(opt.out_path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "font_baker: cannot write '%s'\n", opt.out_path);
+        goto cleanup;
+    }
+    fwrite(&hdr, sizeof(hdr), 1, out);
+    for (a = 0; a < count; a++) {
+        fwrite(&glyphs[a].rec, sizeof(ce_font_glyph), 1, out);
+    }
+    fwrite(kerns, sizeof(ce_font_kern), (size_t)kern_count, out);
+    fwrite(pixels, 1, (size_t)opt.atlas * (size_t)opt.atlas, out);
+    if (fclose(out) == 0) {
+        printf("font_baker: %d glyphs, %d kerning pairs, %dx%d atlas -> %s\n",
+               count, kern_count, opt.atlas, opt.atlas, opt.out_path);
+        status = 0;
+    }
+
+cleanup:
+    if (glyphs != NULL) {
+        for (a = 0; a < count; a++) {
+            stbtt_FreeSDF(glyphs[a].sdf, NULL);
+        }
+    }
+    free(glyphs);
+    free(kerns);
+    free(pixels);
+    free(ttf);
+
+    return status;
+}